@@ -0,0 +1,92 @@
+// AnimationClip.cpp
+#include "AnimationClip.hpp"
+#include "../Math/Simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/**
+ * @brief Konstruktor AnimationClip - pusty klip
+ * @param name Nazwa
+ * @param boneCount Liczba kości szkieletu
+ * @param frameRate Klatki na sekundę
+ * @param looping Czy klip się zapętla (ostatnia klatka powinna wtedy równać się pierwszej)
+ */
+AnimationClip::AnimationClip(const std::string& name, int boneCount, float frameRate, bool looping)
+    : m_name(name), m_boneCount(boneCount), m_frameCount(0), m_frameRate(std::max(frameRate, 1e-3f)),
+      m_looping(looping) {}
+
+/**
+ * @brief Dodaje klatkę na końcu klipu
+ * @param pose Poza (liczba kości zgodna z klipem)
+ *
+ * @details Kwaternion przeciwny opisuje ten sam obrót, więc obrót kości
+ * jest zamieniany na przeciwny, gdy jego iloczyn skalarny z poprzednią
+ * klatką jest ujemny.
+ */
+void AnimationClip::addFrame(const SkeletonPose& pose) {
+    if (static_cast<int>(pose.getBoneCount()) != m_boneCount) {
+        std::cerr << "Blad: Klatka klipu " << m_name << " ma " << pose.getBoneCount() << " kosci zamiast "
+                  << m_boneCount << std::endl;
+        return;
+    }
+    for (int c = 0; c < SkeletonPose::CHANNEL_COUNT; ++c) {
+        m_channels[c].insert(m_channels[c].end(), pose.channels[c].begin(), pose.channels[c].end());
+    }
+    if (m_frameCount > 0) {
+        size_t current = static_cast<size_t>(m_frameCount) * m_boneCount;
+        size_t previous = current - m_boneCount;
+        for (int bone = 0; bone < m_boneCount; ++bone) {
+            float dot = 0.0f;
+            for (int c = SkeletonPose::ROTATION_X; c <= SkeletonPose::ROTATION_W; ++c) {
+                dot += m_channels[c][previous + bone] * m_channels[c][current + bone];
+            }
+            if (dot >= 0.0f) continue;
+            for (int c = SkeletonPose::ROTATION_X; c <= SkeletonPose::ROTATION_W; ++c) {
+                m_channels[c][current + bone] = -m_channels[c][current + bone];
+            }
+        }
+    }
+    m_frameCount++;
+}
+
+/**
+ * @brief Zwraca długość klipu
+ * @return Czas od pierwszej do ostatniej klatki [s]
+ */
+float AnimationClip::getDuration() const {
+    return static_cast<float>(std::max(m_frameCount - 1, 0)) / m_frameRate;
+}
+
+/**
+ * @brief Próbkuje klip
+ * @param time Czas [s] (dla klipu zapętlonego dowolny, inaczej przycinany)
+ * @param out Wynik (rozmiar ustawiany na liczbę kości)
+ *
+ * @details Cała poza to dziesięć wywołań lerpArrays na sąsiednich wierszach
+ * klatek i jedna normalizacja obrotów, niezależnie od liczby kości.
+ */
+void AnimationClip::sample(float time, SkeletonPose& out) const {
+    out.resize(m_boneCount);
+    if (m_frameCount == 0) return;
+
+    float duration = getDuration();
+    if (m_looping && duration > 0.0f) {
+        time = std::fmod(time, duration);
+        if (time < 0.0f) time += duration;
+    }
+    float frame = std::clamp(time * m_frameRate, 0.0f, static_cast<float>(m_frameCount - 1));
+    int frame0 = std::min(static_cast<int>(frame), m_frameCount - 1);
+    int frame1 = std::min(frame0 + 1, m_frameCount - 1);
+    float factor = frame - static_cast<float>(frame0);
+
+    size_t offset0 = static_cast<size_t>(frame0) * m_boneCount;
+    size_t offset1 = static_cast<size_t>(frame1) * m_boneCount;
+    for (int c = 0; c < SkeletonPose::CHANNEL_COUNT; ++c) {
+        Simd::lerpArrays(m_channels[c].data() + offset0, m_channels[c].data() + offset1, factor,
+                         out.channels[c].data(), m_boneCount);
+    }
+    Simd::normalizeQuaternions(out.channels[SkeletonPose::ROTATION_X].data(), out.channels[SkeletonPose::ROTATION_Y].data(),
+                               out.channels[SkeletonPose::ROTATION_Z].data(), out.channels[SkeletonPose::ROTATION_W].data(),
+                               m_boneCount);
+}
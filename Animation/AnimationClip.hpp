@@ -0,0 +1,83 @@
+// AnimationClip.hpp
+#ifndef ANIMATION_CLIP_HPP
+#define ANIMATION_CLIP_HPP
+
+#include <string>
+#include <vector>
+#include "Skeleton.hpp"
+
+/**
+ * @class AnimationClip
+ * @brief Animacja szkieletu próbkowana ze stałą częstotliwością klatek
+ *
+ * Klatki przechowywane są kanałami: dla każdej składowej pozy jedna
+ * tablica klatka po klatce, w klatce kość po kości. Próbka to interpolacja
+ * liniowa dwóch sąsiednich klatek wykonywana na całych wierszach kości
+ * (Simd::lerpArrays), a dla obrotów dodatkowo normalizacja (nlerp).
+ * Przy dodawaniu klatki kwaterniony są odwracane do półsfery poprzedniej
+ * klatki, więc nlerp zawsze wybiera krótszą drogę.
+ */
+class AnimationClip {
+private:
+    std::string m_name;             /**< Nazwa klipu */
+    int m_boneCount;                /**< Liczba kości w klatce */
+    int m_frameCount;               /**< Liczba klatek */
+    float m_frameRate;              /**< Klatki na sekundę */
+    bool m_looping;                 /**< Czy klip się zapętla */
+    std::vector<float> m_channels[SkeletonPose::CHANNEL_COUNT];    /**< Składowe klatek */
+
+public:
+    /**
+     * @brief Konstruktor AnimationClip - pusty klip
+     * @param name Nazwa
+     * @param boneCount Liczba kości szkieletu
+     * @param frameRate Klatki na sekundę
+     * @param looping Czy klip się zapętla (ostatnia klatka powinna wtedy równać się pierwszej)
+     */
+    AnimationClip(const std::string& name, int boneCount, float frameRate, bool looping = true);
+
+    /**
+     * @brief Dodaje klatkę na końcu klipu
+     * @param pose Poza (liczba kości zgodna z klipem)
+     */
+    void addFrame(const SkeletonPose& pose);
+
+    /**
+     * @brief Próbkuje klip
+     * @param time Czas [s] (dla klipu zapętlonego dowolny, inaczej przycinany)
+     * @param out Wynik (rozmiar ustawiany na liczbę kości)
+     */
+    void sample(float time, SkeletonPose& out) const;
+
+    /**
+     * @brief Zwraca nazwę klipu
+     * @return Nazwa
+     */
+    const std::string& getName() const { return m_name; }
+
+    /**
+     * @brief Zwraca liczbę kości w klatce
+     * @return Liczba kości
+     */
+    int getBoneCount() const { return m_boneCount; }
+
+    /**
+     * @brief Zwraca liczbę klatek
+     * @return Liczba klatek
+     */
+    int getFrameCount() const { return m_frameCount; }
+
+    /**
+     * @brief Zwraca długość klipu
+     * @return Czas od pierwszej do ostatniej klatki [s]
+     */
+    float getDuration() const;
+
+    /**
+     * @brief Sprawdza, czy klip się zapętla
+     * @return true dla klipu zapętlonego
+     */
+    bool isLooping() const { return m_looping; }
+};
+
+#endif // ANIMATION_CLIP_HPP
@@ -0,0 +1,129 @@
+// Crowd.cpp
+#include "Crowd.hpp"
+#include "../Math/Simd.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+/**
+ * @brief Konstruktor Crowd
+ * @param skeleton Szkielet wspólny dla wszystkich postaci (po finalize())
+ */
+Crowd::Crowd(std::shared_ptr<const Skeleton> skeleton)
+    : m_skeleton(std::move(skeleton)), m_localBounds{glm::vec3(0.0f, 1.0f, 0.0f), 1.0f} {}
+
+/**
+ * @brief Dodaje klip
+ * @param clip Klip dla liczby kości szkieletu
+ * @return Indeks klipu albo -1 przy błędzie
+ */
+int Crowd::addClip(std::shared_ptr<const AnimationClip> clip) {
+    if (!clip || clip->getBoneCount() != m_skeleton->getBoneCount()) {
+        std::cerr << "Blad: Klip nie pasuje do szkieletu tlumu" << std::endl;
+        return -1;
+    }
+    m_clips.push_back(std::move(clip));
+    return static_cast<int>(m_clips.size()) - 1;
+}
+
+/**
+ * @brief Dodaje postać
+ * @param character Stan początkowy
+ * @return Indeks postaci
+ */
+int Crowd::addCharacter(const CrowdCharacter& character) {
+    m_characters.push_back(character);
+    return static_cast<int>(m_characters.size()) - 1;
+}
+
+/**
+ * @brief Usuwa wszystkie postacie
+ */
+void Crowd::clear() {
+    m_characters.clear();
+    m_skinMatrices.clear();
+}
+
+/**
+ * @brief Przesuwa czas postaci i liczy ich macierze skinningu
+ * @param deltaTime Krok czasu [s]
+ *
+ * @details Każde zadanie ma własną pozę i bufor macierzy, a postać zapisuje
+ * tylko swój fragment tablicy, więc wątki nie synchronizują się. Postać
+ * z klipem spoza zakresu dostaje pozę spoczynkową.
+ */
+void Crowd::update(float deltaTime) {
+    auto start = std::chrono::high_resolution_clock::now();
+    const int boneCount = m_skeleton->getBoneCount();
+    const size_t floatsPerCharacter = static_cast<size_t>(boneCount) * Skeleton::SKIN_MATRIX_FLOATS;
+    m_skinMatrices.resize(m_characters.size() * floatsPerCharacter);
+
+    ThreadPool::instance().parallelFor(m_characters.size(), MIN_BATCH, [&](size_t begin, size_t end) {
+        SkeletonPose pose;
+        std::vector<glm::mat4> scratch(boneCount);
+        for (size_t i = begin; i < end; ++i) {
+            CrowdCharacter& character = m_characters[i];
+            character.time += deltaTime * character.speed;
+            const SkeletonPose* sampled = &m_skeleton->getBindPose();
+            if (character.clip >= 0 && character.clip < static_cast<int>(m_clips.size())) {
+                m_clips[character.clip]->sample(character.time, pose);
+                sampled = &pose;
+            }
+            glm::mat4 world = glm::rotate(glm::translate(glm::mat4(1.0f), character.position), character.yaw,
+                                          glm::vec3(0.0f, 1.0f, 0.0f));
+            m_skeleton->computeSkinMatrices(*sampled, world, scratch.data(), m_skinMatrices.data() + i * floatsPerCharacter);
+        }
+    });
+
+    m_stats.characters = static_cast<int>(m_characters.size());
+    m_stats.bones = boneCount;
+    m_stats.animationMs =
+        std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+ * @brief Przekształca siatkę wybranych postaci na CPU
+ * @param mesh Siatka w pozie spoczynkowej
+ * @param characters Indeksy postaci
+ * @param count Liczba postaci
+ * @param output Wynik: mesh.vertices.size() wierzchołków na postać, w kolejności indeksów
+ *
+ * @details Postacie dzielone są między wątki ThreadPool; każda zapisuje
+ * rozłączny fragment wyniku, więc output może być zmapowanym buforem GPU.
+ */
+void Crowd::skinVertices(const SkinnedMeshData& mesh, const uint32_t* characters, size_t count, Vertex* output) {
+    auto start = std::chrono::high_resolution_clock::now();
+    const size_t vertexCount = mesh.vertices.size();
+    if (vertexCount > 0) {
+        ThreadPool::instance().parallelFor(count, 4, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                Simd::skinVertices(getSkinMatrices(characters[k]), &mesh.vertices[0].position.x,
+                                   sizeof(SkinnedVertex) / sizeof(float), &output[k * vertexCount].position.x,
+                                   sizeof(Vertex) / sizeof(float), vertexCount);
+            }
+        });
+    }
+    m_stats.skinnedCharacters = static_cast<int>(count);
+    m_stats.skinnedVertices = count * vertexCount;
+    m_stats.skinningMs =
+        std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+ * @brief Zwraca sferę otaczającą postać w przestrzeni świata
+ * @param character Indeks postaci
+ * @return Sfera
+ *
+ * @details Postać obracana jest tylko wokół osi Y, więc obracany jest
+ * tylko poziomy odsunięty środek sfery.
+ */
+BoundingSphere Crowd::getBounds(size_t character) const {
+    const CrowdCharacter& state = m_characters[character];
+    float c = std::cos(state.yaw);
+    float s = std::sin(state.yaw);
+    const glm::vec3& local = m_localBounds.center;
+    glm::vec3 offset(c * local.x + s * local.z, local.y, -s * local.x + c * local.z);
+    return {state.position + offset, m_localBounds.radius};
+}
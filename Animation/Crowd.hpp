@@ -0,0 +1,155 @@
+// Crowd.hpp
+#ifndef CROWD_HPP
+#define CROWD_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "AnimationClip.hpp"
+#include "Skeleton.hpp"
+#include "SkinnedMesh.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @struct CrowdCharacter
+ * @brief Stan jednej postaci tłumu
+ */
+struct CrowdCharacter {
+    glm::vec3 position = glm::vec3(0.0f);  /**< Pozycja stóp w przestrzeni świata */
+    float yaw = 0.0f;                      /**< Obrót wokół osi Y [rad] */
+    int clip = 0;                          /**< Indeks klipu (spoza zakresu: poza spoczynkowa) */
+    float time = 0.0f;                     /**< Czas w klipie [s] */
+    float speed = 1.0f;                    /**< Mnożnik tempa animacji */
+};
+
+/**
+ * @struct CrowdStats
+ * @brief Koszt ostatniej aktualizacji tłumu
+ */
+struct CrowdStats {
+    int characters = 0;             /**< Animowane postacie */
+    int bones = 0;                  /**< Kości na postać */
+    double animationMs = 0.0;       /**< Próbkowanie klipów i macierze kości [ms] */
+    int skinnedCharacters = 0;      /**< Postacie ostatniego skinningu na CPU */
+    size_t skinnedVertices = 0;     /**< Wierzchołki ostatniego skinningu na CPU */
+    double skinningMs = 0.0;        /**< Ostatni skinning na CPU [ms] */
+};
+
+/**
+ * @class Crowd
+ * @brief Wiele postaci o wspólnym szkielecie animowanych równolegle
+ *
+ * Każda postać ma własny czas klipu i przekształcenie świata. update()
+ * dzieli postacie między wątki ThreadPool; wątek próbkuje klip postaci
+ * do własnej pozy SoA i liczy macierze skinningu w przestrzeni świata do
+ * wspólnej tablicy (SKIN_MATRIX_FLOATS floatów na kość, postać za
+ * postacią). Tablica trafia bez zmian do bufora tekstury przy skinningu
+ * na GPU albo do skinVertices(), które na CPU przekształca siatkę
+ * wybranych postaci, także równolegle.
+ *
+ * Klasa nie używa OpenGL, więc te same obliczenia wykonuje program
+ * pomiarowy SkinningBenchmark.
+ */
+class Crowd {
+public:
+    static const size_t MIN_BATCH = 16;    /**< Najmniej postaci na zadanie ThreadPool */
+
+private:
+    std::shared_ptr<const Skeleton> m_skeleton;                     /**< Wspólny szkielet */
+    std::vector<std::shared_ptr<const AnimationClip>> m_clips;      /**< Klipy */
+    std::vector<CrowdCharacter> m_characters;                       /**< Postacie */
+    std::vector<float> m_skinMatrices;                              /**< Macierze skinningu wszystkich postaci */
+    BoundingSphere m_localBounds;                                   /**< Sfera postaci w jej przestrzeni */
+    CrowdStats m_stats;                                             /**< Koszt ostatnich obliczeń */
+
+public:
+    /**
+     * @brief Konstruktor Crowd
+     * @param skeleton Szkielet wspólny dla wszystkich postaci (po finalize())
+     */
+    explicit Crowd(std::shared_ptr<const Skeleton> skeleton);
+
+    /**
+     * @brief Dodaje klip
+     * @param clip Klip dla liczby kości szkieletu
+     * @return Indeks klipu albo -1 przy błędzie
+     */
+    int addClip(std::shared_ptr<const AnimationClip> clip);
+
+    /**
+     * @brief Dodaje postać
+     * @param character Stan początkowy
+     * @return Indeks postaci
+     */
+    int addCharacter(const CrowdCharacter& character);
+
+    /**
+     * @brief Usuwa wszystkie postacie
+     */
+    void clear();
+
+    /**
+     * @brief Przesuwa czas postaci i liczy ich macierze skinningu
+     * @param deltaTime Krok czasu [s]
+     */
+    void update(float deltaTime);
+
+    /**
+     * @brief Przekształca siatkę wybranych postaci na CPU
+     * @param mesh Siatka w pozie spoczynkowej
+     * @param characters Indeksy postaci
+     * @param count Liczba postaci
+     * @param output Wynik: mesh.vertices.size() wierzchołków na postać, w kolejności indeksów
+     */
+    void skinVertices(const SkinnedMeshData& mesh, const uint32_t* characters, size_t count, Vertex* output);
+
+    /**
+     * @brief Ustawia sferę otaczającą postać w jej przestrzeni
+     * @param bounds Sfera obejmująca wszystkie pozy klipów
+     */
+    void setLocalBounds(const BoundingSphere& bounds) { m_localBounds = bounds; }
+
+    /**
+     * @brief Zwraca sferę otaczającą postać w przestrzeni świata
+     * @param character Indeks postaci
+     * @return Sfera
+     */
+    BoundingSphere getBounds(size_t character) const;
+
+    /**
+     * @brief Zwraca szkielet
+     * @return Szkielet
+     */
+    const Skeleton& getSkeleton() const { return *m_skeleton; }
+
+    /**
+     * @brief Zwraca postacie do zmiany
+     * @return Postacie
+     */
+    std::vector<CrowdCharacter>& getCharacters() { return m_characters; }
+
+    /**
+     * @brief Zwraca postacie
+     * @return Postacie
+     */
+    const std::vector<CrowdCharacter>& getCharacters() const { return m_characters; }
+
+    /**
+     * @brief Zwraca macierze skinningu postaci z ostatniego update()
+     * @param character Indeks postaci
+     * @return Skeleton::SKIN_MATRIX_FLOATS floatów na kość
+     */
+    const float* getSkinMatrices(size_t character) const {
+        return m_skinMatrices.data() + character * m_skeleton->getBoneCount() * Skeleton::SKIN_MATRIX_FLOATS;
+    }
+
+    /**
+     * @brief Zwraca koszt ostatnich obliczeń
+     * @return Statystyki
+     */
+    const CrowdStats& getStats() const { return m_stats; }
+};
+
+#endif // CROWD_HPP
@@ -0,0 +1,121 @@
+// KeyframeAnimator.cpp
+#include "KeyframeAnimator.hpp"
+#include "../Math/Simd.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+/**
+ * @brief Konstruktor KeyframeAnimator
+ * @param transformCount Liczba animowanych przekształceń
+ */
+KeyframeAnimator::KeyframeAnimator(size_t transformCount) : m_transformCount(transformCount) {}
+
+/**
+ * @brief Dodaje warstwę
+ * @param clip Klip o liczbie ścieżek równej liczbie przekształceń
+ * @param weight Waga w mieszaniu
+ * @param speed Mnożnik tempa
+ * @return Indeks warstwy albo -1 przy błędzie
+ */
+int KeyframeAnimator::addLayer(std::shared_ptr<const KeyframeClip> clip, float weight, float speed) {
+    if (!clip || clip->getTrackCount() != m_transformCount) {
+        std::cerr << "Blad: Klip " << (clip ? clip->getName() : std::string("(brak)")) << " ma "
+                  << (clip ? clip->getTrackCount() : 0) << " sciezek zamiast " << m_transformCount << std::endl;
+        return -1;
+    }
+    Layer layer;
+    layer.clip = std::move(clip);
+    layer.time = 0.0f;
+    layer.speed = speed;
+    layer.weight = std::max(weight, 0.0f);
+    layer.clip->resetCursor(layer.cursor);
+    m_layers.push_back(std::move(layer));
+    return static_cast<int>(m_layers.size()) - 1;
+}
+
+/**
+ * @brief Ustawia wagę warstwy
+ * @param layer Indeks warstwy
+ * @param weight Waga (0: warstwa pomijana)
+ */
+void KeyframeAnimator::setWeight(int layer, float weight) {
+    m_layers[layer].weight = std::max(weight, 0.0f);
+}
+
+/**
+ * @brief Ustawia czas warstwy
+ * @param layer Indeks warstwy
+ * @param time Czas [s]
+ */
+void KeyframeAnimator::setTime(int layer, float time) {
+    m_layers[layer].time = time;
+}
+
+/**
+ * @brief Ustawia tempo warstwy
+ * @param layer Indeks warstwy
+ * @param speed Mnożnik tempa
+ */
+void KeyframeAnimator::setSpeed(int layer, float speed) {
+    m_layers[layer].speed = speed;
+}
+
+/**
+ * @brief Przesuwa czas wszystkich warstw
+ * @param deltaTime Czas od ostatniej klatki [s]
+ *
+ * @details Czas zapętlonego klipu sprowadzany jest do jego długości, żeby
+ * nie tracił precyzji przy długim odtwarzaniu.
+ */
+void KeyframeAnimator::update(float deltaTime) {
+    for (Layer& layer : m_layers) {
+        layer.time += deltaTime * layer.speed;
+        if (layer.clip->isLooping()) layer.time = layer.clip->wrapTime(layer.time);
+    }
+}
+
+/**
+ * @brief Wylicza przekształcenia z warstw
+ * @param out Poza (rozmiar ustawiany na liczbę przekształceń)
+ *
+ * @details Wagi dzielone są przez sumę wag aktywnych warstw, więc
+ * przesunięcia i skale są średnią ważoną, a obroty nlerp-em ważonym.
+ * Porcja przechodzi przez wszystkie warstwy po kolei, więc jej wiersze
+ * pozy zostają w pamięci podręcznej między warstwami.
+ */
+void KeyframeAnimator::evaluate(SkeletonPose& out) {
+    auto start = std::chrono::high_resolution_clock::now();
+    out.resize(m_transformCount);
+
+    std::vector<Layer*> active;
+    float totalWeight = 0.0f;
+    for (Layer& layer : m_layers) {
+        if (layer.weight <= 0.0f) continue;
+        active.push_back(&layer);
+        totalWeight += layer.weight;
+    }
+
+    if (active.empty()) {
+        for (size_t i = 0; i < m_transformCount; ++i) {
+            out.setBone(static_cast<int>(i), glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+        }
+    } else {
+        ThreadPool::instance().parallelFor(m_transformCount, MIN_BATCH, [&](size_t begin, size_t end) {
+            for (size_t l = 0; l < active.size(); ++l) {
+                Layer& layer = *active[l];
+                layer.clip->sample(layer.time, &layer.cursor, begin, end - begin, layer.weight / totalWeight, l > 0, out);
+            }
+            Simd::normalizeQuaternions(out.channels[SkeletonPose::ROTATION_X].data() + begin,
+                                       out.channels[SkeletonPose::ROTATION_Y].data() + begin,
+                                       out.channels[SkeletonPose::ROTATION_Z].data() + begin,
+                                       out.channels[SkeletonPose::ROTATION_W].data() + begin, end - begin);
+        });
+    }
+
+    m_stats.transforms = m_transformCount;
+    m_stats.activeLayers = static_cast<int>(active.size());
+    m_stats.milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
@@ -0,0 +1,139 @@
+// KeyframeAnimator.hpp
+#ifndef KEYFRAME_ANIMATOR_HPP
+#define KEYFRAME_ANIMATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "KeyframeClip.hpp"
+#include "Skeleton.hpp"
+
+/**
+ * @struct KeyframeAnimatorStats
+ * @brief Koszt ostatniego wyliczenia przekształceń
+ */
+struct KeyframeAnimatorStats {
+    size_t transforms = 0;          /**< Animowane przekształcenia */
+    int activeLayers = 0;           /**< Warstwy o dodatniej wadze */
+    double milliseconds = 0.0;      /**< Czas evaluate() [ms] */
+};
+
+/**
+ * @class KeyframeAnimator
+ * @brief Odtwarzanie i mieszanie klipów kluczowych dla tablicy przekształceń
+ *
+ * Warstwa to klip z własnym czasem, tempem, wagą i kursorem. evaluate()
+ * dzieli przekształcenia między wątki ThreadPool; każda porcja próbkuje
+ * kolejne warstwy o dodatniej wadze (pierwsza zastępuje, następne dodają
+ * się z wagą względną do sumy wag) i na końcu normalizuje obroty. Wynik
+ * to tablice SoA pozy, gotowe dla Simd::composeTransforms albo dla
+ * Skeleton, gdy ścieżki odpowiadają kościom.
+ *
+ * Wszystkie klipy muszą mieć tyle ścieżek, ile przekształceń animatora.
+ */
+class KeyframeAnimator {
+public:
+    static const size_t MIN_BATCH = 1024;    /**< Najmniej przekształceń na zadanie ThreadPool */
+
+private:
+    /**
+     * @struct Layer
+     * @brief Odtwarzany klip
+     */
+    struct Layer {
+        std::shared_ptr<const KeyframeClip> clip;   /**< Klip */
+        float time;                                 /**< Czas odtwarzania [s] */
+        float speed;                                /**< Mnożnik tempa */
+        float weight;                               /**< Waga w mieszaniu */
+        KeyframeCursor cursor;                      /**< Klucze ostatniej próbki */
+    };
+
+    size_t m_transformCount;            /**< Liczba przekształceń */
+    std::vector<Layer> m_layers;        /**< Warstwy */
+    KeyframeAnimatorStats m_stats;      /**< Koszt ostatniego wyliczenia */
+
+public:
+    /**
+     * @brief Konstruktor KeyframeAnimator
+     * @param transformCount Liczba animowanych przekształceń
+     */
+    explicit KeyframeAnimator(size_t transformCount);
+
+    /**
+     * @brief Dodaje warstwę
+     * @param clip Klip o liczbie ścieżek równej liczbie przekształceń
+     * @param weight Waga w mieszaniu
+     * @param speed Mnożnik tempa
+     * @return Indeks warstwy albo -1 przy błędzie
+     */
+    int addLayer(std::shared_ptr<const KeyframeClip> clip, float weight = 1.0f, float speed = 1.0f);
+
+    /**
+     * @brief Ustawia wagę warstwy
+     * @param layer Indeks warstwy
+     * @param weight Waga (0: warstwa pomijana)
+     */
+    void setWeight(int layer, float weight);
+
+    /**
+     * @brief Zwraca wagę warstwy
+     * @param layer Indeks warstwy
+     * @return Waga
+     */
+    float getWeight(int layer) const { return m_layers[layer].weight; }
+
+    /**
+     * @brief Ustawia czas warstwy
+     * @param layer Indeks warstwy
+     * @param time Czas [s]
+     */
+    void setTime(int layer, float time);
+
+    /**
+     * @brief Zwraca czas warstwy
+     * @param layer Indeks warstwy
+     * @return Czas [s]
+     */
+    float getTime(int layer) const { return m_layers[layer].time; }
+
+    /**
+     * @brief Ustawia tempo warstwy
+     * @param layer Indeks warstwy
+     * @param speed Mnożnik tempa
+     */
+    void setSpeed(int layer, float speed);
+
+    /**
+     * @brief Zwraca liczbę warstw
+     * @return Liczba warstw
+     */
+    size_t getLayerCount() const { return m_layers.size(); }
+
+    /**
+     * @brief Zwraca liczbę przekształceń
+     * @return Liczba przekształceń
+     */
+    size_t getTransformCount() const { return m_transformCount; }
+
+    /**
+     * @brief Przesuwa czas wszystkich warstw
+     * @param deltaTime Czas od ostatniej klatki [s]
+     */
+    void update(float deltaTime);
+
+    /**
+     * @brief Wylicza przekształcenia z warstw
+     * @param out Poza (rozmiar ustawiany na liczbę przekształceń)
+     *
+     * Bez warstw o dodatniej wadze wynik to przekształcenia jednostkowe.
+     */
+    void evaluate(SkeletonPose& out);
+
+    /**
+     * @brief Zwraca koszt ostatniego wyliczenia
+     * @return Statystyki
+     */
+    const KeyframeAnimatorStats& getStats() const { return m_stats; }
+};
+
+#endif // KEYFRAME_ANIMATOR_HPP
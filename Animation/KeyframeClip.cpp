@@ -0,0 +1,342 @@
+// KeyframeClip.cpp
+#include "KeyframeClip.hpp"
+#include "../Math/Simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/**
+ * @brief Sprawdza, czy czasy kluczy pasują do wartości i nie maleją
+ * @param times Czasy kluczy
+ * @param valueCount Liczba wartości
+ * @return true jeśli składowa jest poprawna
+ */
+static bool validTimes(const std::vector<float>& times, size_t valueCount) {
+    if (times.size() != valueCount) return false;
+    for (size_t i = 1; i < times.size(); ++i) {
+        if (!(times[i] >= times[i - 1])) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Wybiera klucze, których interpolacja liniowa odtwarza pozostałe
+ * @param times Czasy kluczy
+ * @param count Liczba kluczy
+ * @param error Błąd interpolacji (klucz początkowy, końcowy, pośredni, współczynnik)
+ * @param tolerance Dopuszczalny błąd
+ * @return Indeksy zachowanych kluczy (pierwszy i ostatni zawsze)
+ *
+ * Odcinek od ostatniego zachowanego klucza wydłużany jest, dopóki
+ * wszystkie klucze pośrednie mieszczą się w tolerancji; klucz przed
+ * pierwszym niepasującym końcem zostaje zachowany.
+ */
+template <typename ErrorFunction>
+static std::vector<size_t> reduceKeys(const std::vector<float>& times, size_t count, ErrorFunction error,
+                                      float tolerance) {
+    std::vector<size_t> kept = {0};
+    size_t anchor = 0;
+    for (size_t end = anchor + 2; end < count; ++end) {
+        float span = times[end] - times[anchor];
+        bool fits = true;
+        for (size_t i = anchor + 1; i < end && fits; ++i) {
+            float factor = span > 0.0f ? (times[i] - times[anchor]) / span : 0.0f;
+            fits = error(anchor, end, i, factor) <= tolerance;
+        }
+        if (!fits) {
+            anchor = end - 1;
+            kept.push_back(anchor);
+        }
+    }
+    if (count > 1) kept.push_back(count - 1);
+    return kept;
+}
+
+/**
+ * @brief Konstruktor KeyframeClip - pusty klip
+ * @param name Nazwa
+ * @param looping Czy klip się zapętla
+ */
+KeyframeClip::KeyframeClip(const std::string& name, bool looping)
+    : m_name(name), m_looping(looping), m_duration(0.0f), m_sourceKeyCount(0) {}
+
+/**
+ * @brief Dodaje ścieżkę
+ * @param track Klucze przekształcenia
+ * @param tolerance Dopuszczalny błąd usuniętych kluczy (0: tylko klucze identyczne)
+ * @return Indeks ścieżki albo -1 przy błędzie
+ */
+int KeyframeClip::addTrack(const KeyframeTrack& track, float tolerance) {
+    if (!validTimes(track.translationTimes, track.translations.size()) ||
+        !validTimes(track.rotationTimes, track.rotations.size()) || !validTimes(track.scaleTimes, track.scales.size())) {
+        std::cerr << "Blad: Sciezka klipu " << m_name << " ma niezgodne albo malejace czasy kluczy" << std::endl;
+        return -1;
+    }
+    tolerance = std::max(tolerance, 0.0f);
+    addVectorCurve(TRANSLATION, track.translationTimes, track.translations, glm::vec3(0.0f), tolerance);
+    addRotationCurve(track.rotationTimes, track.rotations, tolerance);
+    addVectorCurve(SCALE, track.scaleTimes, track.scales, glm::vec3(1.0f), tolerance);
+    m_sourceKeyCount += track.translations.size() + track.rotations.size() + track.scales.size();
+    return static_cast<int>(getTrackCount()) - 1;
+}
+
+/**
+ * @brief Dodaje klucze wektorowej składowej ścieżki
+ * @param component TRANSLATION albo SCALE
+ * @param times Czasy kluczy
+ * @param values Wartości kluczy
+ * @param defaultValue Wartość składowej bez kluczy
+ * @param tolerance Dopuszczalny błąd usuniętych kluczy
+ *
+ * @details Błąd to największa różnica składowych między kluczem
+ * a interpolacją sąsiednich zachowanych kluczy.
+ */
+void KeyframeClip::addVectorCurve(int component, const std::vector<float>& times, const std::vector<glm::vec3>& values,
+                                  const glm::vec3& defaultValue, float tolerance) {
+    std::vector<float>* keys = component == TRANSLATION ? m_translationKeys : m_scaleKeys;
+    auto difference = [](const glm::vec3& a, const glm::vec3& b) {
+        glm::vec3 d = glm::abs(a - b);
+        return std::max(d.x, std::max(d.y, d.z));
+    };
+
+    std::vector<size_t> kept;
+    bool constant = true;
+    for (size_t i = 1; i < values.size() && constant; ++i) {
+        constant = difference(values[i], values[0]) <= tolerance;
+    }
+    if (!constant) {
+        kept = reduceKeys(times, values.size(), [&](size_t from, size_t to, size_t i, float factor) {
+            return difference(glm::mix(values[from], values[to], factor), values[i]);
+        }, tolerance);
+    }
+
+    Curve curve = {static_cast<uint32_t>(m_times[component].size()), 0};
+    if (kept.empty()) {
+        glm::vec3 value = values.empty() ? defaultValue : values[0];
+        m_times[component].push_back(values.empty() ? 0.0f : times[0]);
+        for (int c = 0; c < 3; ++c) keys[c].push_back(value[c]);
+        curve.count = 1;
+    }
+    for (size_t i : kept) {
+        m_times[component].push_back(times[i]);
+        for (int c = 0; c < 3; ++c) keys[c].push_back(values[i][c]);
+        curve.count++;
+    }
+    m_curves[component].push_back(curve);
+    if (!times.empty()) m_duration = std::max(m_duration, times.back());
+}
+
+/**
+ * @brief Dodaje klucze obrotu ścieżki
+ * @param times Czasy kluczy
+ * @param values Obroty kluczy
+ * @param tolerance Dopuszczalny błąd usuniętych kluczy
+ *
+ * @details Kwaterniony są normalizowane i odwracane do półsfery
+ * poprzedniego klucza, a błąd usuwania liczony dla nlerp, tak jak
+ * przy próbkowaniu. Zapis kompresji nie zachowuje znaku kwaternionu,
+ * więc półsfera wybierana jest ponownie w Simd::blendKeyQuaternions.
+ */
+void KeyframeClip::addRotationCurve(const std::vector<float>& times, const std::vector<glm::quat>& values,
+                                    float tolerance) {
+    std::vector<glm::vec4> rotations(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        glm::quat q = glm::normalize(values[i]);
+        rotations[i] = glm::vec4(q.x, q.y, q.z, q.w);
+        if (i > 0 && glm::dot(rotations[i], rotations[i - 1]) < 0.0f) rotations[i] = -rotations[i];
+    }
+    auto difference = [](const glm::vec4& a, const glm::vec4& b) {
+        glm::vec4 d = glm::abs(a - b);
+        return std::max(std::max(d.x, d.y), std::max(d.z, d.w));
+    };
+
+    std::vector<size_t> kept;
+    bool constant = true;
+    for (size_t i = 1; i < rotations.size() && constant; ++i) {
+        constant = difference(rotations[i], rotations[0]) <= tolerance;
+    }
+    if (!constant) {
+        kept = reduceKeys(times, rotations.size(), [&](size_t from, size_t to, size_t i, float factor) {
+            return difference(glm::normalize(glm::mix(rotations[from], rotations[to], factor)), rotations[i]);
+        }, tolerance);
+    }
+    if (kept.empty()) kept.push_back(0);
+
+    Curve curve = {static_cast<uint32_t>(m_times[ROTATION].size()), 0};
+    for (size_t i : kept) {
+        glm::vec4 q = rotations.empty() ? glm::vec4(0.0f, 0.0f, 0.0f, 1.0f) : rotations[i];
+        uint16_t packed[3];
+        Simd::encodeQuaternion(q.x, q.y, q.z, q.w, packed);
+        m_times[ROTATION].push_back(rotations.empty() ? 0.0f : times[i]);
+        for (int word = 0; word < 3; ++word) m_rotationKeys[word].push_back(packed[word]);
+        curve.count++;
+    }
+    m_curves[ROTATION].push_back(curve);
+    if (!times.empty()) m_duration = std::max(m_duration, times.back());
+}
+
+/**
+ * @brief Ustawia kursor na początek klipu
+ * @param cursor Kursor (rozmiar ustawiany na liczbę ścieżek)
+ */
+void KeyframeClip::resetCursor(KeyframeCursor& cursor) const {
+    for (std::vector<uint32_t>& keys : cursor.keys) {
+        keys.assign(getTrackCount(), 0);
+    }
+}
+
+/**
+ * @brief Sprowadza czas do zakresu klipu
+ * @param time Czas [s]
+ * @return Czas zapętlony (klip zapętlony) albo przycięty do [0, długość]
+ */
+float KeyframeClip::wrapTime(float time) const {
+    if (m_duration <= 0.0f) return 0.0f;
+    if (!m_looping) return std::clamp(time, 0.0f, m_duration);
+    float wrapped = std::fmod(time, m_duration);
+    return wrapped < 0.0f ? wrapped + m_duration : wrapped;
+}
+
+/**
+ * @brief Wybiera klucze porcji ścieżek
+ * @param component Składowa
+ * @param time Czas w klipie [s]
+ * @param cursor Kursor (nullptr: wyszukiwanie binarne)
+ * @param start Pierwsza ścieżka porcji
+ * @param count Liczba ścieżek porcji
+ * @param factors Wynik: współczynniki interpolacji
+ * @param from Wynik: indeksy kluczy początkowych
+ * @param to Wynik: indeksy kluczy końcowych
+ *
+ * @details Klucz z kursora jest przesuwany do przodu, dopóki następny
+ * klucz nie jest późniejszy niż czas. Gdy klucz z kursora leży już za
+ * czasem (zapętlenie albo przewinięcie wstecz), klucz wyszukiwany jest
+ * binarnie.
+ */
+void KeyframeClip::findKeys(int component, float time, KeyframeCursor* cursor, size_t start, size_t count,
+                            float* factors, uint32_t* from, uint32_t* to) const {
+    const float* times = m_times[component].data();
+    const Curve* curves = m_curves[component].data() + start;
+    uint32_t* cached = cursor ? cursor->keys[component].data() + start : nullptr;
+    for (size_t j = 0; j < count; ++j) {
+        const Curve& curve = curves[j];
+        if (curve.count < 2) {
+            from[j] = to[j] = curve.first;
+            factors[j] = 0.0f;
+            continue;
+        }
+        const float* keyTimes = times + curve.first;
+        const uint32_t last = curve.count - 2;
+        uint32_t key = cached ? cached[j] : 0;
+        if (!cached || key > last || keyTimes[key] > time) {
+            key = static_cast<uint32_t>(std::upper_bound(keyTimes, keyTimes + curve.count, time) - keyTimes);
+            key = std::min(key > 0 ? key - 1 : 0, last);
+        } else {
+            while (key < last && keyTimes[key + 1] <= time) ++key;
+        }
+        if (cached) cached[j] = key;
+
+        float span = keyTimes[key + 1] - keyTimes[key];
+        float factor = span > 0.0f ? (time - keyTimes[key]) / span : 1.0f;
+        factors[j] = std::clamp(factor, 0.0f, 1.0f);
+        from[j] = curve.first + key;
+        to[j] = from[j] + 1;
+    }
+}
+
+/**
+ * @brief Próbkuje zakres ścieżek i miesza wynik z pozą
+ * @param time Czas [s] (zapętlany albo przycinany)
+ * @param cursor Kursor z resetCursor() albo nullptr (wyszukiwanie binarne)
+ * @param first Pierwsza ścieżka
+ * @param count Liczba ścieżek
+ * @param weight Waga próbki
+ * @param accumulate false: próbka zastępuje pozę, true: jest do niej dodawana
+ * @param out Poza (co najmniej first + count przekształceń); ścieżka i zapisuje przekształcenie i
+ *
+ * @details Klucze porcji zbierane są do tablic roboczych na stosie (kilka
+ * kilobajtów, w pamięci podręcznej L1), z których jądra Simd czytają
+ * po cztery ścieżki naraz.
+ */
+void KeyframeClip::sample(float time, KeyframeCursor* cursor, size_t first, size_t count, float weight,
+                          bool accumulate, SkeletonPose& out) const {
+    count = std::min(count, getTrackCount() > first ? getTrackCount() - first : 0);
+    if (count == 0) return;
+    const float clipTime = wrapTime(time);
+
+    float factors[SAMPLE_BATCH];
+    uint32_t from[SAMPLE_BATCH], to[SAMPLE_BATCH];
+    float fromValues[4][SAMPLE_BATCH], toValues[4][SAMPLE_BATCH];
+    uint16_t fromPacked[3][SAMPLE_BATCH], toPacked[3][SAMPLE_BATCH];
+    const float* const fromRows[4] = {fromValues[0], fromValues[1], fromValues[2], fromValues[3]};
+    const float* const toRows[4] = {toValues[0], toValues[1], toValues[2], toValues[3]};
+    float* const fromOutput[4] = {fromValues[0], fromValues[1], fromValues[2], fromValues[3]};
+    float* const toOutput[4] = {toValues[0], toValues[1], toValues[2], toValues[3]};
+    const uint16_t* const fromWords[3] = {fromPacked[0], fromPacked[1], fromPacked[2]};
+    const uint16_t* const toWords[3] = {toPacked[0], toPacked[1], toPacked[2]};
+
+    for (size_t start = first; start < first + count; start += SAMPLE_BATCH) {
+        const size_t n = std::min(SAMPLE_BATCH, first + count - start);
+
+        for (int component = TRANSLATION; component < COMPONENT_COUNT; ++component) {
+            findKeys(component, clipTime, cursor, start, n, factors, from, to);
+            if (component == ROTATION) {
+                for (int word = 0; word < 3; ++word) {
+                    const uint16_t* keys = m_rotationKeys[word].data();
+                    for (size_t j = 0; j < n; ++j) {
+                        fromPacked[word][j] = keys[from[j]];
+                        toPacked[word][j] = keys[to[j]];
+                    }
+                }
+                Simd::decodeQuaternions(fromWords, n, fromOutput);
+                Simd::decodeQuaternions(toWords, n, toOutput);
+                float* const rotations[4] = {out.channels[SkeletonPose::ROTATION_X].data() + start,
+                                             out.channels[SkeletonPose::ROTATION_Y].data() + start,
+                                             out.channels[SkeletonPose::ROTATION_Z].data() + start,
+                                             out.channels[SkeletonPose::ROTATION_W].data() + start};
+                Simd::blendKeyQuaternions(fromRows, toRows, factors, weight, accumulate, rotations, n);
+                continue;
+            }
+
+            const std::vector<float>* keys = component == TRANSLATION ? m_translationKeys : m_scaleKeys;
+            for (int c = 0; c < 3; ++c) {
+                const float* values = keys[c].data();
+                for (size_t j = 0; j < n; ++j) {
+                    fromValues[c][j] = values[from[j]];
+                    toValues[c][j] = values[to[j]];
+                }
+            }
+            const int channel = component == TRANSLATION ? SkeletonPose::TRANSLATION_X : SkeletonPose::SCALE_X;
+            float* const vectors[3] = {out.channels[channel].data() + start, out.channels[channel + 1].data() + start,
+                                       out.channels[channel + 2].data() + start};
+            Simd::blendKeyVectors(fromRows, toRows, factors, weight, accumulate, vectors, n);
+        }
+    }
+}
+
+/**
+ * @brief Zwraca liczbę zapisanych kluczy
+ * @return Klucze wszystkich składowych po kompresji
+ */
+size_t KeyframeClip::getKeyCount() const {
+    return m_times[TRANSLATION].size() + m_times[ROTATION].size() + m_times[SCALE].size();
+}
+
+/**
+ * @brief Zwraca zajmowaną pamięć
+ * @return Liczba bajtów kluczy i zakresów
+ *
+ * @details Klucz przesunięcia i skali zajmuje 16 bajtów (czas i trzy
+ * składowe), klucz obrotu 10 bajtów (czas i trzy słowa).
+ */
+size_t KeyframeClip::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (int component = 0; component < COMPONENT_COUNT; ++component) {
+        bytes += m_times[component].size() * sizeof(float) + m_curves[component].size() * sizeof(Curve);
+    }
+    for (int c = 0; c < 3; ++c) {
+        bytes += (m_translationKeys[c].size() + m_scaleKeys[c].size()) * sizeof(float) +
+                 m_rotationKeys[c].size() * sizeof(uint16_t);
+    }
+    return bytes;
+}
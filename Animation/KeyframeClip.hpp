@@ -0,0 +1,212 @@
+// KeyframeClip.hpp
+#ifndef KEYFRAME_CLIP_HPP
+#define KEYFRAME_CLIP_HPP
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Skeleton.hpp"
+
+/**
+ * @struct KeyframeTrack
+ * @brief Klucze jednego przekształcenia przed kompresją
+ *
+ * Każda składowa ma własne, rosnące czasy kluczy [s]. Składowa bez
+ * kluczy ma stałą wartość domyślną (zerowe przesunięcie, obrót
+ * jednostkowy, skala 1).
+ */
+struct KeyframeTrack {
+    std::vector<float> translationTimes;    /**< Czasy kluczy przesunięcia */
+    std::vector<glm::vec3> translations;    /**< Przesunięcia */
+    std::vector<float> rotationTimes;       /**< Czasy kluczy obrotu */
+    std::vector<glm::quat> rotations;       /**< Obroty */
+    std::vector<float> scaleTimes;          /**< Czasy kluczy skali */
+    std::vector<glm::vec3> scales;          /**< Skale */
+};
+
+/**
+ * @struct KeyframeCursor
+ * @brief Zapamiętane klucze odtwarzania klipu
+ *
+ * Dla każdej składowej każdej ścieżki indeks klucza użytego w ostatniej
+ * próbce. Przy odtwarzaniu do przodu kolejna próbka zaczyna szukanie od
+ * tego klucza i zwykle przesuwa się najwyżej o jeden.
+ */
+struct KeyframeCursor {
+    std::vector<uint32_t> keys[3];     /**< Klucze przesunięć, obrotów i skal */
+};
+
+/**
+ * @class KeyframeClip
+ * @brief Animacja wielu przekształceń z kluczami w nieregularnych odstępach
+ *
+ * Ścieżka i animuje przekształcenie i. Klucze wszystkich ścieżek leżą
+ * w płaskich tablicach SoA (osobno czasy, każda składowa wektorów i słowa
+ * kwaternionów), a ścieżka pamięta tylko zakres swoich kluczy. Przy
+ * dodawaniu ścieżki klucze odtwarzane interpolacją liniową sąsiadów
+ * z dokładnością tolerancji są usuwane (składowa stała zostaje z jednym
+ * kluczem), a obroty zapisywane w 6 bajtach (Simd::encodeQuaternion).
+ *
+ * sample() przetwarza ścieżki porcjami SAMPLE_BATCH: skalarnie wyszukuje
+ * klucze (od pozycji kursora) i zbiera je do tablic roboczych, a dekodowanie
+ * kwaternionów i interpolacja z mieszaniem wykonywane są po cztery ścieżki
+ * naraz (Simd::decodeQuaternions, blendKeyVectors, blendKeyQuaternions).
+ * Wynik trafia bezpośrednio do tablic SoA pozy.
+ */
+class KeyframeClip {
+public:
+    /**
+     * @enum Component
+     * @brief Składowe ścieżki
+     */
+    enum Component { TRANSLATION, ROTATION, SCALE, COMPONENT_COUNT };
+
+    static const size_t SAMPLE_BATCH = 64;          /**< Ścieżki w jednej porcji próbkowania */
+    static constexpr float DEFAULT_TOLERANCE = 1e-4f;  /**< Domyślny błąd usuwania kluczy (jednostki, składowe kwaternionu) */
+
+private:
+    /**
+     * @struct Curve
+     * @brief Zakres kluczy składowej ścieżki
+     */
+    struct Curve {
+        uint32_t first;     /**< Pierwszy klucz */
+        uint32_t count;     /**< Liczba kluczy (co najmniej 1) */
+    };
+
+    std::string m_name;                                 /**< Nazwa klipu */
+    bool m_looping;                                     /**< Czy klip się zapętla */
+    float m_duration;                                   /**< Czas ostatniego klucza [s] */
+    std::vector<Curve> m_curves[COMPONENT_COUNT];       /**< Zakresy kluczy ścieżek */
+    std::vector<float> m_times[COMPONENT_COUNT];        /**< Czasy kluczy */
+    std::vector<float> m_translationKeys[3];            /**< Przesunięcia kluczy (X, Y, Z) */
+    std::vector<uint16_t> m_rotationKeys[3];            /**< Skompresowane obroty kluczy (słowa A, B, C) */
+    std::vector<float> m_scaleKeys[3];                  /**< Skale kluczy (X, Y, Z) */
+    size_t m_sourceKeyCount;                            /**< Klucze przed kompresją */
+
+    /**
+     * @brief Wybiera klucze porcji ścieżek
+     * @param component Składowa
+     * @param time Czas w klipie [s]
+     * @param cursor Kursor (nullptr: wyszukiwanie binarne)
+     * @param start Pierwsza ścieżka porcji
+     * @param count Liczba ścieżek porcji
+     * @param factors Wynik: współczynniki interpolacji
+     * @param from Wynik: indeksy kluczy początkowych
+     * @param to Wynik: indeksy kluczy końcowych
+     */
+    void findKeys(int component, float time, KeyframeCursor* cursor, size_t start, size_t count, float* factors,
+                  uint32_t* from, uint32_t* to) const;
+
+    /**
+     * @brief Dodaje klucze wektorowej składowej ścieżki
+     * @param component TRANSLATION albo SCALE
+     * @param times Czasy kluczy
+     * @param values Wartości kluczy
+     * @param defaultValue Wartość składowej bez kluczy
+     * @param tolerance Dopuszczalny błąd usuniętych kluczy
+     */
+    void addVectorCurve(int component, const std::vector<float>& times, const std::vector<glm::vec3>& values,
+                        const glm::vec3& defaultValue, float tolerance);
+
+    /**
+     * @brief Dodaje klucze obrotu ścieżki
+     * @param times Czasy kluczy
+     * @param values Obroty kluczy
+     * @param tolerance Dopuszczalny błąd usuniętych kluczy
+     */
+    void addRotationCurve(const std::vector<float>& times, const std::vector<glm::quat>& values, float tolerance);
+
+public:
+    /**
+     * @brief Konstruktor KeyframeClip - pusty klip
+     * @param name Nazwa
+     * @param looping Czy klip się zapętla
+     */
+    explicit KeyframeClip(const std::string& name, bool looping = true);
+
+    /**
+     * @brief Dodaje ścieżkę
+     * @param track Klucze przekształcenia
+     * @param tolerance Dopuszczalny błąd usuniętych kluczy (0: tylko klucze identyczne)
+     * @return Indeks ścieżki albo -1 przy błędzie
+     */
+    int addTrack(const KeyframeTrack& track, float tolerance = DEFAULT_TOLERANCE);
+
+    /**
+     * @brief Ustawia kursor na początek klipu
+     * @param cursor Kursor (rozmiar ustawiany na liczbę ścieżek)
+     */
+    void resetCursor(KeyframeCursor& cursor) const;
+
+    /**
+     * @brief Sprowadza czas do zakresu klipu
+     * @param time Czas [s]
+     * @return Czas zapętlony (klip zapętlony) albo przycięty do [0, długość]
+     */
+    float wrapTime(float time) const;
+
+    /**
+     * @brief Próbkuje zakres ścieżek i miesza wynik z pozą
+     * @param time Czas [s] (zapętlany albo przycinany)
+     * @param cursor Kursor z resetCursor() albo nullptr (wyszukiwanie binarne)
+     * @param first Pierwsza ścieżka
+     * @param count Liczba ścieżek
+     * @param weight Waga próbki
+     * @param accumulate false: próbka zastępuje pozę, true: jest do niej dodawana
+     * @param out Poza (co najmniej first + count przekształceń); ścieżka i zapisuje przekształcenie i
+     *
+     * Obroty nie są normalizowane; po ostatniej warstwie należy wywołać
+     * Simd::normalizeQuaternions. Różne zakresy ścieżek można próbkować
+     * równolegle z tym samym kursorem.
+     */
+    void sample(float time, KeyframeCursor* cursor, size_t first, size_t count, float weight, bool accumulate,
+                SkeletonPose& out) const;
+
+    /**
+     * @brief Zwraca nazwę klipu
+     * @return Nazwa
+     */
+    const std::string& getName() const { return m_name; }
+
+    /**
+     * @brief Sprawdza, czy klip się zapętla
+     * @return true dla klipu zapętlonego
+     */
+    bool isLooping() const { return m_looping; }
+
+    /**
+     * @brief Zwraca długość klipu
+     * @return Czas ostatniego klucza [s]
+     */
+    float getDuration() const { return m_duration; }
+
+    /**
+     * @brief Zwraca liczbę ścieżek
+     * @return Liczba ścieżek
+     */
+    size_t getTrackCount() const { return m_curves[TRANSLATION].size(); }
+
+    /**
+     * @brief Zwraca liczbę zapisanych kluczy
+     * @return Klucze wszystkich składowych po kompresji
+     */
+    size_t getKeyCount() const;
+
+    /**
+     * @brief Zwraca liczbę kluczy przed kompresją
+     * @return Klucze wszystkich składowych podane w addTrack()
+     */
+    size_t getSourceKeyCount() const { return m_sourceKeyCount; }
+
+    /**
+     * @brief Zwraca zajmowaną pamięć
+     * @return Liczba bajtów kluczy i zakresów
+     */
+    size_t getMemoryUsage() const;
+};
+
+#endif // KEYFRAME_CLIP_HPP
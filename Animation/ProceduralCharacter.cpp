@@ -0,0 +1,242 @@
+// ProceduralCharacter.cpp
+#include "ProceduralCharacter.hpp"
+#include "../Mesh/MeshBuilder.hpp"
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+/**
+ * @struct BoneShape
+ * @brief Kość postaci testowej i jej cylinder
+ */
+struct BoneShape {
+    const char* name;       /**< Nazwa kości */
+    int parent;             /**< Indeks rodzica */
+    glm::vec3 offset;       /**< Przesunięcie względem rodzica */
+    glm::vec3 tip;          /**< Koniec cylindra względem stawu */
+    float radius;           /**< Promień cylindra */
+};
+
+const BoneShape BONES[] = {
+    {"miednica", -1, glm::vec3(0.0f, 0.95f, 0.0f), glm::vec3(0.0f, 0.15f, 0.0f), 0.14f},
+    {"kregoslup", 0, glm::vec3(0.0f, 0.15f, 0.0f), glm::vec3(0.0f, 0.25f, 0.0f), 0.13f},
+    {"klatka", 1, glm::vec3(0.0f, 0.25f, 0.0f), glm::vec3(0.0f, 0.22f, 0.0f), 0.17f},
+    {"szyja", 2, glm::vec3(0.0f, 0.22f, 0.0f), glm::vec3(0.0f, 0.08f, 0.0f), 0.05f},
+    {"glowa", 3, glm::vec3(0.0f, 0.08f, 0.0f), glm::vec3(0.0f, 0.24f, 0.0f), 0.11f},
+    {"ramie_l", 2, glm::vec3(0.23f, 0.18f, 0.0f), glm::vec3(0.0f, -0.3f, 0.0f), 0.055f},
+    {"przedramie_l", 5, glm::vec3(0.0f, -0.3f, 0.0f), glm::vec3(0.0f, -0.3f, 0.0f), 0.045f},
+    {"ramie_p", 2, glm::vec3(-0.23f, 0.18f, 0.0f), glm::vec3(0.0f, -0.3f, 0.0f), 0.055f},
+    {"przedramie_p", 7, glm::vec3(0.0f, -0.3f, 0.0f), glm::vec3(0.0f, -0.3f, 0.0f), 0.045f},
+    {"udo_l", 0, glm::vec3(0.1f, -0.02f, 0.0f), glm::vec3(0.0f, -0.45f, 0.0f), 0.075f},
+    {"lydka_l", 9, glm::vec3(0.0f, -0.45f, 0.0f), glm::vec3(0.0f, -0.46f, 0.0f), 0.06f},
+    {"udo_p", 0, glm::vec3(-0.1f, -0.02f, 0.0f), glm::vec3(0.0f, -0.45f, 0.0f), 0.075f},
+    {"lydka_p", 11, glm::vec3(0.0f, -0.45f, 0.0f), glm::vec3(0.0f, -0.46f, 0.0f), 0.06f},
+};
+
+const int BONE_COUNT = static_cast<int>(sizeof(BONES) / sizeof(BONES[0]));
+const float JOINT_BLEND = 0.3f;     /**< Część cylindra przy stawie dzieląca wagę z sąsiadem */
+
+/**
+ * @brief Tworzy klip z funkcji pozy
+ * @param skeleton Szkielet
+ * @param name Nazwa klipu
+ * @param duration Długość klipu [s]
+ * @param setPose Ustawia pozę (zaczynając od spoczynkowej) dla fazy 0..1
+ * @return Klip
+ */
+std::shared_ptr<AnimationClip> buildClip(const Skeleton& skeleton, const std::string& name, float duration,
+                                         const std::function<void(float phase, SkeletonPose& pose)>& setPose) {
+    auto clip = std::make_shared<AnimationClip>(name, skeleton.getBoneCount(), ProceduralCharacter::FRAME_RATE);
+    int frames = static_cast<int>(std::lround(duration * ProceduralCharacter::FRAME_RATE));
+    SkeletonPose pose;
+    for (int frame = 0; frame <= frames; ++frame) {
+        pose = skeleton.getBindPose();
+        setPose(static_cast<float>(frame) / static_cast<float>(frames), pose);
+        clip->addFrame(pose);
+    }
+    return clip;
+}
+
+/**
+ * @brief Ustawia obrót kości pozy
+ * @param pose Poza
+ * @param bone Indeks kości
+ * @param angle Kąt [rad]
+ * @param axis Oś obrotu
+ */
+void rotateBone(SkeletonPose& pose, int bone, float angle, const glm::vec3& axis) {
+    pose.setBone(bone, pose.getTranslation(bone), glm::angleAxis(angle, axis), pose.getScale(bone));
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy szkielet
+ * @return Szkielet po finalize()
+ */
+std::shared_ptr<Skeleton> ProceduralCharacter::createSkeleton() {
+    auto skeleton = std::make_shared<Skeleton>();
+    for (const BoneShape& bone : BONES) {
+        skeleton->addBone(bone.name, bone.parent, bone.offset);
+    }
+    skeleton->finalize();
+    return skeleton;
+}
+
+/**
+ * @brief Tworzy siatkę dopasowaną do szkieletu z createSkeleton()
+ * @param skeleton Szkielet
+ * @param sectors Sektory cylindrów
+ * @return Siatka z wagami kości
+ *
+ * @details Waga wierzchołka zależy od jego rzutu na oś cylindra: przy
+ * stawie rodzica połowę wagi ma rodzic, przy końcu połowę ma kość, która
+ * kontynuuje cylinder (dziecko zaczynające się w jego końcu); pomiędzy
+ * wagi zmieniają się liniowo na odcinku JOINT_BLEND długości.
+ */
+SkinnedMeshData ProceduralCharacter::createMesh(const Skeleton& skeleton, int sectors) {
+    SkinnedMeshData result;
+    if (skeleton.getBoneCount() != BONE_COUNT) return result;
+
+    // Stawy w pozie spoczynkowej (obroty spoczynkowe są jednostkowe)
+    glm::vec3 joints[BONE_COUNT];
+    int continuation[BONE_COUNT];
+    for (int i = 0; i < BONE_COUNT; ++i) {
+        joints[i] = BONES[i].offset + (BONES[i].parent >= 0 ? joints[BONES[i].parent] : glm::vec3(0.0f));
+        continuation[i] = -1;
+        int parent = BONES[i].parent;
+        if (parent >= 0 && glm::length(BONES[i].offset - BONES[parent].tip) < 1e-4f) continuation[parent] = i;
+    }
+
+    MeshBuilder builder;
+    const MeshCounts counts = MeshBuilder::cylinderCounts(sectors);
+    builder.reserve(counts * BONE_COUNT);
+    for (int i = 0; i < BONE_COUNT; ++i) {
+        const BoneShape& bone = BONES[i];
+        float length = glm::length(bone.tip);
+        glm::vec3 direction = bone.tip / length;
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), joints[i] + bone.tip * 0.5f);
+        glm::vec3 axis = glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), direction);
+        if (glm::length(axis) > 1e-4f) {
+            transform = glm::rotate(transform, std::acos(std::clamp(direction.y, -1.0f, 1.0f)), glm::normalize(axis));
+        }
+        builder.pushTransform(glm::scale(transform, glm::vec3(bone.radius, length, bone.radius)));
+        builder.addCylinder(sectors);
+        builder.popTransform();
+    }
+    MeshData mesh = builder.takeMeshData();
+
+    result.indices = std::move(mesh.indices);
+    result.vertices.resize(mesh.vertices.size());
+    for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+        const Vertex& source = mesh.vertices[v];
+        int i = static_cast<int>(v / counts.vertices);
+        const BoneShape& bone = BONES[i];
+        float length = glm::length(bone.tip);
+        float s = std::clamp(glm::dot(source.position - joints[i], bone.tip / length) / length, 0.0f, 1.0f);
+
+        int neighbor = -1;
+        float neighborWeight = 0.0f;
+        if (bone.parent >= 0 && s < JOINT_BLEND) {
+            neighbor = bone.parent;
+            neighborWeight = 0.5f * (1.0f - s / JOINT_BLEND);
+        } else if (continuation[i] >= 0 && s > 1.0f - JOINT_BLEND) {
+            neighbor = continuation[i];
+            neighborWeight = 0.5f * (s - (1.0f - JOINT_BLEND)) / JOINT_BLEND;
+        }
+
+        SkinnedVertex& out = result.vertices[v];
+        out.position = source.position;
+        out.normal = source.normal;
+        out.texCoord = source.texCoord;
+        uint8_t shared = static_cast<uint8_t>(std::lround(neighborWeight * 255.0f));
+        out.bones[0] = static_cast<uint8_t>(i);
+        out.bones[1] = static_cast<uint8_t>(std::max(neighbor, 0));
+        out.bones[2] = 0;
+        out.bones[3] = 0;
+        out.weights[0] = static_cast<uint8_t>(255 - shared);
+        out.weights[1] = shared;
+        out.weights[2] = 0;
+        out.weights[3] = 0;
+    }
+    return result;
+}
+
+/**
+ * @brief Tworzy zapętlony klip chodu (1 s)
+ * @param skeleton Szkielet
+ * @return Klip
+ *
+ * @details Nogi i ręce wahają się w przeciwfazie, kolano zgina się przy
+ * wymachu do tyłu, a miednica unosi dwa razy na cykl.
+ */
+std::shared_ptr<AnimationClip> ProceduralCharacter::createWalkClip(const Skeleton& skeleton) {
+    const glm::vec3 axisX(1.0f, 0.0f, 0.0f);
+    const glm::vec3 axisY(0.0f, 1.0f, 0.0f);
+    const int pelvis = skeleton.findBone("miednica"), chest = skeleton.findBone("klatka");
+    const int head = skeleton.findBone("glowa");
+    const int armL = skeleton.findBone("ramie_l"), forearmL = skeleton.findBone("przedramie_l");
+    const int armR = skeleton.findBone("ramie_p"), forearmR = skeleton.findBone("przedramie_p");
+    const int thighL = skeleton.findBone("udo_l"), shinL = skeleton.findBone("lydka_l");
+    const int thighR = skeleton.findBone("udo_p"), shinR = skeleton.findBone("lydka_p");
+
+    return buildClip(skeleton, "chod", 1.0f, [=](float phase, SkeletonPose& pose) {
+        float angle = phase * glm::two_pi<float>();
+        float swing = std::sin(angle);
+        glm::vec3 hips = pose.getTranslation(pelvis);
+        pose.setBone(pelvis, hips + glm::vec3(0.0f, 0.025f * std::cos(2.0f * angle), 0.0f),
+                     glm::angleAxis(0.08f * swing, axisY), glm::vec3(1.0f));
+        rotateBone(pose, chest, -0.12f * swing, axisY);
+        rotateBone(pose, head, 0.04f * std::sin(2.0f * angle), axisX);
+        rotateBone(pose, thighL, 0.45f * swing, axisX);
+        rotateBone(pose, thighR, -0.45f * swing, axisX);
+        rotateBone(pose, shinL, 0.6f * std::max(swing, 0.0f), axisX);
+        rotateBone(pose, shinR, 0.6f * std::max(-swing, 0.0f), axisX);
+        rotateBone(pose, armL, -0.4f * swing, axisX);
+        rotateBone(pose, armR, 0.4f * swing, axisX);
+        rotateBone(pose, forearmL, -0.3f - 0.15f * std::max(-swing, 0.0f), axisX);
+        rotateBone(pose, forearmR, -0.3f - 0.15f * std::max(swing, 0.0f), axisX);
+    });
+}
+
+/**
+ * @brief Tworzy zapętlony klip machania prawą ręką (2 s)
+ * @param skeleton Szkielet
+ * @return Klip
+ *
+ * @details Prawa ręka uniesiona w bok, przedramię macha trzy razy na
+ * klip; reszta ciała lekko oddycha i rozgląda się.
+ */
+std::shared_ptr<AnimationClip> ProceduralCharacter::createWaveClip(const Skeleton& skeleton) {
+    const glm::vec3 axisX(1.0f, 0.0f, 0.0f);
+    const glm::vec3 axisY(0.0f, 1.0f, 0.0f);
+    const glm::vec3 axisZ(0.0f, 0.0f, 1.0f);
+    const int pelvis = skeleton.findBone("miednica"), spine = skeleton.findBone("kregoslup");
+    const int head = skeleton.findBone("glowa");
+    const int forearmL = skeleton.findBone("przedramie_l");
+    const int armR = skeleton.findBone("ramie_p"), forearmR = skeleton.findBone("przedramie_p");
+
+    return buildClip(skeleton, "machanie", 2.0f, [=](float phase, SkeletonPose& pose) {
+        float angle = phase * glm::two_pi<float>();
+        glm::vec3 hips = pose.getTranslation(pelvis);
+        pose.setBone(pelvis, hips + glm::vec3(0.0f, 0.01f * std::sin(2.0f * angle), 0.0f),
+                     glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+        rotateBone(pose, spine, 0.03f * std::sin(2.0f * angle), axisX);
+        rotateBone(pose, head, 0.3f * std::sin(angle), axisY);
+        rotateBone(pose, forearmL, -0.2f, axisX);
+        rotateBone(pose, armR, -2.4f + 0.1f * std::sin(angle), axisZ);
+        rotateBone(pose, forearmR, 0.5f * std::sin(3.0f * angle), axisZ);
+    });
+}
+
+/**
+ * @brief Zwraca sferę obejmującą postać we wszystkich pozach klipów
+ * @return Sfera w przestrzeni postaci
+ */
+BoundingSphere ProceduralCharacter::getBounds() {
+    return {glm::vec3(0.0f, 1.0f, 0.0f), 1.3f};
+}
@@ -0,0 +1,62 @@
+// ProceduralCharacter.hpp
+#ifndef PROCEDURAL_CHARACTER_HPP
+#define PROCEDURAL_CHARACTER_HPP
+
+#include <memory>
+#include "AnimationClip.hpp"
+#include "Skeleton.hpp"
+#include "SkinnedMesh.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @class ProceduralCharacter
+ * @brief Postać testowa: szkielet dwunożny, siatka z cylindrów i dwa klipy
+ *
+ * Szkielet ma 13 kości (miednica, kręgosłup, klatka, szyja, głowa, ręce
+ * i nogi po dwie kości), stopy w y = 0 i przód w +Z. Każda kość dostaje
+ * cylinder od swojego stawu do następnego; wierzchołki przy stawach
+ * dzielą wagę z sąsiednią kością, więc zgięcia są gładkie. Klipy (chód
+ * i machanie ręką) generowane są z funkcji okresowych, dzięki czemu
+ * ostatnia klatka równa się pierwszej.
+ */
+class ProceduralCharacter {
+public:
+    static const int DEFAULT_SECTORS = 8;   /**< Sektory cylindrów siatki */
+    static constexpr float FRAME_RATE = 30.0f;  /**< Klatki na sekundę klipów */
+
+    /**
+     * @brief Tworzy szkielet
+     * @return Szkielet po finalize()
+     */
+    static std::shared_ptr<Skeleton> createSkeleton();
+
+    /**
+     * @brief Tworzy siatkę dopasowaną do szkieletu z createSkeleton()
+     * @param skeleton Szkielet
+     * @param sectors Sektory cylindrów
+     * @return Siatka z wagami kości
+     */
+    static SkinnedMeshData createMesh(const Skeleton& skeleton, int sectors = DEFAULT_SECTORS);
+
+    /**
+     * @brief Tworzy zapętlony klip chodu (1 s)
+     * @param skeleton Szkielet
+     * @return Klip
+     */
+    static std::shared_ptr<AnimationClip> createWalkClip(const Skeleton& skeleton);
+
+    /**
+     * @brief Tworzy zapętlony klip machania prawą ręką (2 s)
+     * @param skeleton Szkielet
+     * @return Klip
+     */
+    static std::shared_ptr<AnimationClip> createWaveClip(const Skeleton& skeleton);
+
+    /**
+     * @brief Zwraca sferę obejmującą postać we wszystkich pozach klipów
+     * @return Sfera w przestrzeni postaci
+     */
+    static BoundingSphere getBounds();
+};
+
+#endif // PROCEDURAL_CHARACTER_HPP
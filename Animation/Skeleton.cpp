@@ -0,0 +1,178 @@
+// Skeleton.cpp
+#include "Skeleton.hpp"
+#include "../Math/Simd.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+
+/**
+ * @brief Zmienia liczbę kości
+ * @param boneCount Liczba kości
+ */
+void SkeletonPose::resize(size_t boneCount) {
+    for (std::vector<float>& channel : channels) {
+        channel.resize(boneCount, 0.0f);
+    }
+}
+
+/**
+ * @brief Ustawia przekształcenie kości
+ * @param bone Indeks kości
+ * @param translation Przesunięcie względem rodzica
+ * @param rotation Obrót względem rodzica
+ * @param scale Skala
+ */
+void SkeletonPose::setBone(int bone, const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale) {
+    channels[TRANSLATION_X][bone] = translation.x;
+    channels[TRANSLATION_Y][bone] = translation.y;
+    channels[TRANSLATION_Z][bone] = translation.z;
+    channels[ROTATION_X][bone] = rotation.x;
+    channels[ROTATION_Y][bone] = rotation.y;
+    channels[ROTATION_Z][bone] = rotation.z;
+    channels[ROTATION_W][bone] = rotation.w;
+    channels[SCALE_X][bone] = scale.x;
+    channels[SCALE_Y][bone] = scale.y;
+    channels[SCALE_Z][bone] = scale.z;
+}
+
+/**
+ * @brief Zwraca przesunięcie kości
+ * @param bone Indeks kości
+ * @return Przesunięcie względem rodzica
+ */
+glm::vec3 SkeletonPose::getTranslation(int bone) const {
+    return glm::vec3(channels[TRANSLATION_X][bone], channels[TRANSLATION_Y][bone], channels[TRANSLATION_Z][bone]);
+}
+
+/**
+ * @brief Zwraca obrót kości
+ * @param bone Indeks kości
+ * @return Obrót względem rodzica
+ */
+glm::quat SkeletonPose::getRotation(int bone) const {
+    return glm::quat(channels[ROTATION_W][bone], channels[ROTATION_X][bone], channels[ROTATION_Y][bone],
+                     channels[ROTATION_Z][bone]);
+}
+
+/**
+ * @brief Zwraca skalę kości
+ * @param bone Indeks kości
+ * @return Skala
+ */
+glm::vec3 SkeletonPose::getScale(int bone) const {
+    return glm::vec3(channels[SCALE_X][bone], channels[SCALE_Y][bone], channels[SCALE_Z][bone]);
+}
+
+/**
+ * @brief Dodaje kość
+ * @param name Nazwa
+ * @param parent Indeks rodzica (-1 dla korzenia, inaczej wcześniej dodana kość)
+ * @param translation Przesunięcie względem rodzica w pozie spoczynkowej
+ * @param rotation Obrót względem rodzica w pozie spoczynkowej
+ * @param scale Skala w pozie spoczynkowej
+ * @return Indeks kości albo -1 przy błędzie
+ *
+ * @details Wymaganie, by rodzic był dodany wcześniej, gwarantuje kolejność
+ * tablic zgodną z hierarchią.
+ */
+int Skeleton::addBone(const std::string& name, int parent, const glm::vec3& translation, const glm::quat& rotation,
+                      const glm::vec3& scale) {
+    int bone = getBoneCount();
+    if (bone >= MAX_BONES) {
+        std::cerr << "Blad: Przekroczono limit " << MAX_BONES << " kosci szkieletu" << std::endl;
+        return -1;
+    }
+    if (parent < -1 || parent >= bone) {
+        std::cerr << "Blad: Kosc " << name << " ma nieprawidlowego rodzica " << parent << std::endl;
+        return -1;
+    }
+    m_parents.push_back(parent);
+    m_names.push_back(name);
+    m_bindPose.resize(m_parents.size());
+    m_bindPose.setBone(bone, translation, rotation, scale);
+    return bone;
+}
+
+/**
+ * @brief Liczy odwrotne macierze pozy spoczynkowej
+ */
+void Skeleton::finalize() {
+    m_inverseBind.resize(m_parents.size());
+    computeLocalMatrices(m_bindPose, m_inverseBind.data());
+    computeModelMatrices(glm::mat4(1.0f), m_inverseBind.data());
+    for (glm::mat4& matrix : m_inverseBind) {
+        matrix = glm::inverse(matrix);
+    }
+}
+
+/**
+ * @brief Wyszukuje kość po nazwie
+ * @param name Nazwa
+ * @return Indeks kości albo -1
+ */
+int Skeleton::findBone(const std::string& name) const {
+    for (size_t i = 0; i < m_names.size(); ++i) {
+        if (m_names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+/**
+ * @brief Liczy macierze lokalne kości
+ * @param pose Poza
+ * @param local Wynik (macierz na kość)
+ */
+void Skeleton::computeLocalMatrices(const SkeletonPose& pose, glm::mat4* local) const {
+    if (m_parents.empty()) return;
+    const float* translations[3] = {pose.channels[SkeletonPose::TRANSLATION_X].data(),
+                                    pose.channels[SkeletonPose::TRANSLATION_Y].data(),
+                                    pose.channels[SkeletonPose::TRANSLATION_Z].data()};
+    const float* rotations[4] = {pose.channels[SkeletonPose::ROTATION_X].data(),
+                                 pose.channels[SkeletonPose::ROTATION_Y].data(),
+                                 pose.channels[SkeletonPose::ROTATION_Z].data(),
+                                 pose.channels[SkeletonPose::ROTATION_W].data()};
+    const float* scales[3] = {pose.channels[SkeletonPose::SCALE_X].data(), pose.channels[SkeletonPose::SCALE_Y].data(),
+                              pose.channels[SkeletonPose::SCALE_Z].data()};
+    Simd::composeTransforms(translations, rotations, scales, m_parents.size(), glm::value_ptr(local[0]));
+}
+
+/**
+ * @brief Zamienia macierze lokalne na macierze świata
+ * @param world Macierz świata postaci (rodzic korzeni)
+ * @param matrices Macierze lokalne, zastępowane macierzami świata
+ *
+ * @details Rodzic ma mniejszy indeks, więc jego macierz świata jest już
+ * policzona, gdy przetwarzane są jego dzieci.
+ */
+void Skeleton::computeModelMatrices(const glm::mat4& world, glm::mat4* matrices) const {
+    for (size_t i = 0; i < m_parents.size(); ++i) {
+        const glm::mat4& parent = m_parents[i] < 0 ? world : matrices[m_parents[i]];
+        Simd::multiplyMatrices(glm::value_ptr(parent), glm::value_ptr(matrices[i]), glm::value_ptr(matrices[i]));
+    }
+}
+
+/**
+ * @brief Liczy macierze skinningu
+ * @param model Macierze świata kości
+ * @param skinRows Wynik: SKIN_MATRIX_FLOATS floatów na kość (trzy wiersze)
+ */
+void Skeleton::computeSkinMatrices(const glm::mat4* model, float* skinRows) const {
+    glm::mat4 skin;
+    for (size_t i = 0; i < m_parents.size(); ++i) {
+        Simd::multiplyMatrices(glm::value_ptr(model[i]), glm::value_ptr(m_inverseBind[i]), glm::value_ptr(skin));
+        Simd::storeAffineRows(glm::value_ptr(skin), skinRows + i * SKIN_MATRIX_FLOATS);
+    }
+}
+
+/**
+ * @brief Liczy macierze skinningu z pozy
+ * @param pose Poza
+ * @param world Macierz świata postaci
+ * @param scratch Bufor roboczy (macierz na kość)
+ * @param skinRows Wynik: SKIN_MATRIX_FLOATS floatów na kość
+ */
+void Skeleton::computeSkinMatrices(const SkeletonPose& pose, const glm::mat4& world, glm::mat4* scratch,
+                                   float* skinRows) const {
+    computeLocalMatrices(pose, scratch);
+    computeModelMatrices(world, scratch);
+    computeSkinMatrices(scratch, skinRows);
+}
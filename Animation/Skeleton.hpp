@@ -0,0 +1,189 @@
+// Skeleton.hpp
+#ifndef SKELETON_HPP
+#define SKELETON_HPP
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @struct SkeletonPose
+ * @brief Lokalne przekształcenia wszystkich kości w układzie SoA
+ *
+ * Każda składowa przesunięcia, obrotu (kwaternion) i skali to osobna
+ * tablica o długości równej liczbie kości, więc próbkowanie klipów
+ * i składanie macierzy przetwarzają po cztery kości naraz.
+ */
+struct SkeletonPose {
+    /**
+     * @enum Channel
+     * @brief Składowe przekształcenia kości
+     */
+    enum Channel {
+        TRANSLATION_X, TRANSLATION_Y, TRANSLATION_Z,
+        ROTATION_X, ROTATION_Y, ROTATION_Z, ROTATION_W,
+        SCALE_X, SCALE_Y, SCALE_Z,
+        CHANNEL_COUNT
+    };
+
+    std::vector<float> channels[CHANNEL_COUNT];     /**< Tablice składowych */
+
+    /**
+     * @brief Zmienia liczbę kości
+     * @param boneCount Liczba kości
+     */
+    void resize(size_t boneCount);
+
+    /**
+     * @brief Zwraca liczbę kości
+     * @return Liczba kości
+     */
+    size_t getBoneCount() const { return channels[0].size(); }
+
+    /**
+     * @brief Ustawia przekształcenie kości
+     * @param bone Indeks kości
+     * @param translation Przesunięcie względem rodzica
+     * @param rotation Obrót względem rodzica
+     * @param scale Skala
+     */
+    void setBone(int bone, const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale);
+
+    /**
+     * @brief Zwraca przesunięcie kości
+     * @param bone Indeks kości
+     * @return Przesunięcie względem rodzica
+     */
+    glm::vec3 getTranslation(int bone) const;
+
+    /**
+     * @brief Zwraca obrót kości
+     * @param bone Indeks kości
+     * @return Obrót względem rodzica
+     */
+    glm::quat getRotation(int bone) const;
+
+    /**
+     * @brief Zwraca skalę kości
+     * @param bone Indeks kości
+     * @return Skala
+     */
+    glm::vec3 getScale(int bone) const;
+};
+
+/**
+ * @class Skeleton
+ * @brief Hierarchia kości zapisana w płaskich tablicach
+ *
+ * Kość i ma rodzica o indeksie mniejszym niż i (albo -1 dla korzenia),
+ * więc macierze modelu liczone są jednym przejściem od początku tablicy,
+ * bez rekurencji i wskaźników między kośćmi. Po dodaniu wszystkich kości
+ * finalize() zapamiętuje odwrotne macierze pozy spoczynkowej.
+ *
+ * Obliczenie pozy postaci przebiega w trzech krokach: macierze lokalne
+ * z pozy SoA (po cztery kości naraz), macierze świata przez mnożenie
+ * z macierzą rodzica oraz macierze skinningu (świat * odwrotność pozy
+ * spoczynkowej) zapisywane jako trzy wiersze na kość - w tym układzie
+ * trafiają zarówno do bufora tekstury GPU, jak i do skinningu na CPU.
+ */
+class Skeleton {
+public:
+    static const int MAX_BONES = 256;           /**< Indeks kości mieści się w bajcie */
+    static const int SKIN_MATRIX_FLOATS = 12;   /**< Floaty macierzy skinningu (3 wiersze) */
+
+private:
+    std::vector<int> m_parents;                 /**< Indeks rodzica kości (-1 dla korzenia) */
+    std::vector<std::string> m_names;           /**< Nazwy kości */
+    SkeletonPose m_bindPose;                    /**< Poza spoczynkowa */
+    std::vector<glm::mat4> m_inverseBind;       /**< Odwrotne macierze modelu pozy spoczynkowej */
+
+public:
+    /**
+     * @brief Dodaje kość
+     * @param name Nazwa
+     * @param parent Indeks rodzica (-1 dla korzenia, inaczej wcześniej dodana kość)
+     * @param translation Przesunięcie względem rodzica w pozie spoczynkowej
+     * @param rotation Obrót względem rodzica w pozie spoczynkowej
+     * @param scale Skala w pozie spoczynkowej
+     * @return Indeks kości albo -1 przy błędzie
+     */
+    int addBone(const std::string& name, int parent, const glm::vec3& translation,
+                const glm::quat& rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f), const glm::vec3& scale = glm::vec3(1.0f));
+
+    /**
+     * @brief Liczy odwrotne macierze pozy spoczynkowej
+     */
+    void finalize();
+
+    /**
+     * @brief Zwraca liczbę kości
+     * @return Liczba kości
+     */
+    int getBoneCount() const { return static_cast<int>(m_parents.size()); }
+
+    /**
+     * @brief Zwraca rodziców kości
+     * @return Indeks rodzica każdej kości
+     */
+    const std::vector<int>& getParents() const { return m_parents; }
+
+    /**
+     * @brief Zwraca nazwę kości
+     * @param bone Indeks kości
+     * @return Nazwa
+     */
+    const std::string& getName(int bone) const { return m_names[bone]; }
+
+    /**
+     * @brief Wyszukuje kość po nazwie
+     * @param name Nazwa
+     * @return Indeks kości albo -1
+     */
+    int findBone(const std::string& name) const;
+
+    /**
+     * @brief Zwraca pozę spoczynkową
+     * @return Poza spoczynkowa
+     */
+    const SkeletonPose& getBindPose() const { return m_bindPose; }
+
+    /**
+     * @brief Zwraca odwrotne macierze pozy spoczynkowej
+     * @return Macierz na kość
+     */
+    const std::vector<glm::mat4>& getInverseBindMatrices() const { return m_inverseBind; }
+
+    /**
+     * @brief Liczy macierze lokalne kości
+     * @param pose Poza
+     * @param local Wynik (macierz na kość)
+     */
+    void computeLocalMatrices(const SkeletonPose& pose, glm::mat4* local) const;
+
+    /**
+     * @brief Zamienia macierze lokalne na macierze świata
+     * @param world Macierz świata postaci (rodzic korzeni)
+     * @param matrices Macierze lokalne, zastępowane macierzami świata
+     */
+    void computeModelMatrices(const glm::mat4& world, glm::mat4* matrices) const;
+
+    /**
+     * @brief Liczy macierze skinningu
+     * @param model Macierze świata kości
+     * @param skinRows Wynik: SKIN_MATRIX_FLOATS floatów na kość (trzy wiersze)
+     */
+    void computeSkinMatrices(const glm::mat4* model, float* skinRows) const;
+
+    /**
+     * @brief Liczy macierze skinningu z pozy
+     * @param pose Poza
+     * @param world Macierz świata postaci
+     * @param scratch Bufor roboczy (macierz na kość)
+     * @param skinRows Wynik: SKIN_MATRIX_FLOATS floatów na kość
+     */
+    void computeSkinMatrices(const SkeletonPose& pose, const glm::mat4& world, glm::mat4* scratch, float* skinRows) const;
+};
+
+#endif // SKELETON_HPP
@@ -0,0 +1,40 @@
+// SkinnedMesh.hpp
+#ifndef SKINNED_MESH_HPP
+#define SKINNED_MESH_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+
+/**
+ * @struct SkinnedVertex
+ * @brief Wierzchołek siatki ze szkieletem
+ *
+ * Początek układu jest zgodny z Vertex; po nim cztery indeksy kości
+ * i cztery wagi zapisane w bajtach (wagi sumują się do 255), razem
+ * 40 bajtów. Ten sam układ czyta shader GPU (wagi jako znormalizowane
+ * bajty) i Simd::skinVertices.
+ */
+struct SkinnedVertex {
+    glm::vec3 position;     /**< Pozycja w pozie spoczynkowej */
+    glm::vec3 normal;       /**< Normalna w pozie spoczynkowej */
+    glm::vec2 texCoord;     /**< Współrzędne tekstury */
+    uint8_t bones[4];       /**< Indeksy kości */
+    uint8_t weights[4];     /**< Wagi kości (suma 255) */
+};
+
+static_assert(sizeof(SkinnedVertex) == 10 * sizeof(float), "SkinnedVertex musi miec 10 floatow dla Simd::skinVertices");
+static_assert(offsetof(SkinnedVertex, bones) == 8 * sizeof(float), "Indeksy kosci musza lezec za Vertex");
+
+/**
+ * @struct SkinnedMeshData
+ * @brief Dane siatki ze szkieletem
+ */
+struct SkinnedMeshData {
+    std::vector<SkinnedVertex> vertices;    /**< Wierzchołki */
+    std::vector<unsigned int> indices;      /**< Indeksy trójkątów */
+};
+
+#endif // SKINNED_MESH_HPP
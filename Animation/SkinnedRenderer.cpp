@@ -0,0 +1,426 @@
+// SkinnedRenderer.cpp
+#include "SkinnedRenderer.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Vertex shader postaci: skinning z bufora tekstury albo gotowe wierzchołki
+ *
+ * Kość to trzy teksele - wiersze macierzy 3x4 (Skeleton::SKIN_MATRIX_FLOATS);
+ * wiersze czterech kości sumowane są z wagami, a pozycja i normalna
+ * przekształcane iloczynami skalarnymi. W trybie CPU wierzchołki są już
+ * w przestrzeni świata.
+ */
+static const char* skinnedVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 3) in uvec4 aBones;
+layout (location = 4) in vec4 aWeights;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+uniform samplerBuffer boneMatrices;
+uniform int boneCount;
+uniform bool gpuSkinning;
+
+out vec3 FragPos;
+out vec3 Normal;
+
+void main()
+{
+    vec3 position = aPos;
+    vec3 normal = aNormal;
+    if (gpuSkinning) {
+        int base = gl_InstanceID * boneCount;
+        vec4 row0 = vec4(0.0);
+        vec4 row1 = vec4(0.0);
+        vec4 row2 = vec4(0.0);
+        for (int k = 0; k < 4; k++) {
+            float weight = aWeights[k];
+            if (weight == 0.0) continue;
+            int texel = (base + int(aBones[k])) * 3;
+            row0 += texelFetch(boneMatrices, texel) * weight;
+            row1 += texelFetch(boneMatrices, texel + 1) * weight;
+            row2 += texelFetch(boneMatrices, texel + 2) * weight;
+        }
+        vec4 local = vec4(aPos, 1.0);
+        position = vec3(dot(row0, local), dot(row1, local), dot(row2, local));
+        normal = vec3(dot(row0.xyz, aNormal), dot(row1.xyz, aNormal), dot(row2.xyz, aNormal));
+    }
+    FragPos = position;
+    Normal = normal;
+    gl_Position = projection * view * vec4(position, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader postaci
+ *
+ * Oświetlenie jak w shaderze sceny (ta sama tabela materiałów i lista
+ * świateł); wszystkie postacie mają jeden materiał. Poprzedza go kod
+ * z LightCuller::getShaderSource().
+ */
+static const char* skinnedFragmentSource = R"(
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+
+uniform ivec2 lightList;
+uniform int materialIndex;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+void main()
+{
+    vec3 normal = normalize(Normal);
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
+    PackedMaterial material = materialData[materialIndex];
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < lightList.y; i++) {
+        int lightIndex = texelFetch(lightIndices, lightList.x + i).r;
+        result += calculatePhongLight(lightData[lightIndex], material, normal, FragPos, viewDir);
+    }
+    FragColor = vec4(result, 1.0);
+}
+)";
+
+/**
+ * @brief Konstruktor SkinnedRenderer
+ */
+SkinnedRenderer::SkinnedRenderer()
+    : m_material(MaterialTable::DEFAULT_MATERIAL), m_mode(SkinningMode::GPU), m_program(0), m_meshVAO(0),
+      m_meshVBO(0), m_meshEBO(0), m_streamVAO(0), m_streamVBO(0), m_boneBuffer(0), m_boneTexture(0),
+      m_gpuSkinningLoc(-1), m_boneCountLoc(-1), m_materialIndexLoc(-1), m_lightListLoc(-1), m_streamCapacity(0),
+      m_boneCapacity(0), m_prepared(false), m_initialized(false) {}
+
+/**
+ * @brief Destruktor SkinnedRenderer
+ */
+SkinnedRenderer::~SkinnedRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery i tworzy bufory
+ * @return true jeśli inicjalizacja się powiodła
+ *
+ * @details Bufor indeksów jest podpięty do obu VAO, więc oba tryby
+ * korzystają z tej samej kopii indeksów siatki.
+ */
+bool SkinnedRenderer::initialize() {
+    if (m_initialized) return true;
+
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, skinnedVertexSource, "postaci");
+    const char* fragmentSources[] = {"#version 330 core\n", LightCuller::getShaderSource(), skinnedFragmentSource};
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSources, 3, "postaci");
+    m_program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "postaci");
+    if (!m_program) return false;
+
+    MultiViewRenderer::setupProgram(m_program);
+    LightCuller::setupProgram(m_program);
+    MaterialTable::setupProgram(m_program);
+    m_gpuSkinningLoc = glGetUniformLocation(m_program, "gpuSkinning");
+    m_boneCountLoc = glGetUniformLocation(m_program, "boneCount");
+    m_materialIndexLoc = glGetUniformLocation(m_program, "materialIndex");
+    m_lightListLoc = glGetUniformLocation(m_program, "lightList");
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform1i(glGetUniformLocation(m_program, "boneMatrices"), BONE_TEXTURE_UNIT);
+    glUseProgram(previousProgram);
+
+    glGenVertexArrays(1, &m_meshVAO);
+    glGenBuffers(1, &m_meshVBO);
+    glGenBuffers(1, &m_meshEBO);
+    glGenVertexArrays(1, &m_streamVAO);
+    glGenBuffers(1, &m_streamVBO);
+    glGenBuffers(1, &m_boneBuffer);
+    glGenTextures(1, &m_boneTexture);
+    if (!m_meshVAO || !m_meshVBO || !m_meshEBO || !m_streamVAO || !m_streamVBO || !m_boneBuffer || !m_boneTexture) {
+        std::cerr << "Blad: Nie udalo sie utworzyc buforow postaci" << std::endl;
+        release();
+        return false;
+    }
+
+    glBindVertexArray(m_meshVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_meshVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_meshEBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void*)offsetof(SkinnedVertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void*)offsetof(SkinnedVertex, texCoord));
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3, 4, GL_UNSIGNED_BYTE, sizeof(SkinnedVertex), (void*)offsetof(SkinnedVertex, bones));
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SkinnedVertex), (void*)offsetof(SkinnedVertex, weights));
+
+    glBindVertexArray(m_streamVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_streamVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_meshEBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_initialized = true;
+    if (m_crowd) setCrowd(m_crowd, m_mesh, m_material);
+    return true;
+}
+
+/**
+ * @brief Zwalnia obiekty OpenGL
+ */
+void SkinnedRenderer::release() {
+    if (m_program) glDeleteProgram(m_program);
+    if (m_meshVAO) glDeleteVertexArrays(1, &m_meshVAO);
+    if (m_meshVBO) glDeleteBuffers(1, &m_meshVBO);
+    if (m_meshEBO) glDeleteBuffers(1, &m_meshEBO);
+    if (m_streamVAO) glDeleteVertexArrays(1, &m_streamVAO);
+    if (m_streamVBO) glDeleteBuffers(1, &m_streamVBO);
+    if (m_boneBuffer) glDeleteBuffers(1, &m_boneBuffer);
+    if (m_boneTexture) glDeleteTextures(1, &m_boneTexture);
+    m_program = 0;
+    m_meshVAO = 0;
+    m_meshVBO = 0;
+    m_meshEBO = 0;
+    m_streamVAO = 0;
+    m_streamVBO = 0;
+    m_boneBuffer = 0;
+    m_boneTexture = 0;
+    m_streamCapacity = 0;
+    m_boneCapacity = 0;
+    m_prepared = false;
+    m_initialized = false;
+}
+
+/**
+ * @brief Ustawia rysowany tłum i siatkę jego postaci
+ * @param crowd Tłum (aktualizowany przez wywołującego)
+ * @param mesh Siatka postaci dla szkieletu tłumu
+ * @param material Materiał postaci
+ *
+ * @details Siatka spoczynkowa wysyłana jest raz; kopia na CPU służy
+ * ścieżce CPU.
+ */
+void SkinnedRenderer::setCrowd(std::shared_ptr<Crowd> crowd, const SkinnedMeshData& mesh, MaterialId material) {
+    m_crowd = std::move(crowd);
+    if (&mesh != &m_mesh) m_mesh = mesh;
+    m_material = material;
+    m_prepared = false;
+    if (!m_initialized) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_mesh.vertices.size() * sizeof(SkinnedVertex)),
+                 m_mesh.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(m_meshVAO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_mesh.indices.size() * sizeof(unsigned int)),
+                 m_mesh.indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Przestaje rysować tłum
+ */
+void SkinnedRenderer::clearCrowd() {
+    m_crowd.reset();
+    m_mesh = SkinnedMeshData();
+    m_visible.clear();
+    m_prepared = false;
+}
+
+/**
+ * @brief Wysyła macierze kości widocznych postaci
+ * @return true jeśli bufor został wypełniony
+ *
+ * @details Bufor jest unieważniany przy mapowaniu, więc sterownik nie
+ * czeka na rysowanie poprzedniej klatki; macierze postaci kopiowane są
+ * w kolejności m_visible, zgodnie z numerami instancji.
+ */
+bool SkinnedRenderer::uploadBoneMatrices() {
+    const size_t characterBytes =
+        static_cast<size_t>(m_crowd->getSkeleton().getBoneCount()) * Skeleton::SKIN_MATRIX_FLOATS * sizeof(float);
+    size_t bytes = m_visible.size() * characterBytes;
+    glBindBuffer(GL_TEXTURE_BUFFER, m_boneBuffer);
+    if (bytes > m_boneCapacity) {
+        m_boneCapacity = bytes + bytes / 2;
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(m_boneCapacity), nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_boneTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_boneBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+    void* mapped = glMapBufferRange(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!mapped) {
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        return false;
+    }
+    unsigned char* out = static_cast<unsigned char*>(mapped);
+    for (size_t k = 0; k < m_visible.size(); ++k) {
+        std::memcpy(out + k * characterBytes, m_crowd->getSkinMatrices(m_visible[k]), characterBytes);
+    }
+    bool valid = glUnmapBuffer(GL_TEXTURE_BUFFER) == GL_TRUE;
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    RenderStats::instance().setValue("Animacja/Wysylane dane [MB]", bytes / (1024.0 * 1024.0));
+    return valid;
+}
+
+/**
+ * @brief Przekształca widoczne postacie na CPU do bufora strumieniowego
+ * @return true jeśli bufor został wypełniony
+ *
+ * @details Wątki ThreadPool piszą wprost do zmapowanego bufora, bez
+ * pośredniej kopii; postać k zajmuje wierzchołki od k * liczba
+ * wierzchołków siatki, co trafia do tablicy pierwszych wierzchołków
+ * glMultiDrawElementsBaseVertex.
+ */
+bool SkinnedRenderer::uploadSkinnedVertices() {
+    const size_t vertexCount = m_mesh.vertices.size();
+    size_t bytes = m_visible.size() * vertexCount * sizeof(Vertex);
+    glBindBuffer(GL_ARRAY_BUFFER, m_streamVBO);
+    if (bytes > m_streamCapacity) {
+        m_streamCapacity = bytes + bytes / 2;
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_streamCapacity), nullptr, GL_STREAM_DRAW);
+    }
+    void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return false;
+    }
+    m_crowd->skinVertices(m_mesh, m_visible.data(), m_visible.size(), static_cast<Vertex*>(mapped));
+    bool valid = glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_drawCounts.assign(m_visible.size(), static_cast<GLsizei>(m_mesh.indices.size()));
+    m_drawOffsets.assign(m_visible.size(), nullptr);
+    m_drawBaseVertices.resize(m_visible.size());
+    for (size_t k = 0; k < m_visible.size(); ++k) {
+        m_drawBaseVertices[k] = static_cast<GLint>(k * vertexCount);
+    }
+    RenderStats::instance().setValue("Animacja/Wysylane dane [MB]", bytes / (1024.0 * 1024.0));
+    return valid;
+}
+
+/**
+ * @brief Odrzuca niewidoczne postacie i przygotowuje dane klatki
+ * @param frustums Ostrosłupy wszystkich widoków
+ * @param lightList Globalna lista świateł
+ *
+ * @details Koszt animacji pochodzi z ostatniego Crowd::update(), koszt
+ * skinningu na CPU mierzy Crowd::skinVertices(); czas wysyłania obejmuje
+ * skinning w trybie CPU.
+ */
+void SkinnedRenderer::prepare(const std::vector<Frustum>& frustums, const glm::ivec2& lightList) {
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Animacja/Wywolania rysowania", 0.0);
+    stats.setValue("Animacja/Trojkaty", 0.0);
+    m_prepared = false;
+    m_visible.clear();
+    if (!m_initialized || !m_crowd || m_mesh.indices.empty()) return;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t count = m_crowd->getCharacters().size();
+    for (size_t i = 0; i < count; ++i) {
+        BoundingSphere sphere = m_crowd->getBounds(i);
+        for (const Frustum& frustum : frustums) {
+            if (frustum.intersects(sphere)) {
+                m_visible.push_back(static_cast<uint32_t>(i));
+                break;
+            }
+        }
+    }
+
+    stats.setValue("Animacja/Skinning CPU [ms]", 0.0);
+    stats.setValue("Animacja/Skinning CPU na postac [us]", 0.0);
+    if (!m_visible.empty()) {
+        m_prepared = m_mode == SkinningMode::GPU ? uploadBoneMatrices() : uploadSkinnedVertices();
+        if (!m_prepared) std::cerr << "Blad: Nie udalo sie zmapowac bufora postaci" << std::endl;
+    }
+    if (m_mode == SkinningMode::CPU && !m_visible.empty()) {
+        const CrowdStats& crowdStats = m_crowd->getStats();
+        stats.setValue("Animacja/Skinning CPU [ms]", crowdStats.skinningMs);
+        stats.setValue("Animacja/Skinning CPU na postac [us]", crowdStats.skinningMs * 1000.0 / m_visible.size());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform2i(m_lightListLoc, lightList.x, lightList.y);
+    glUseProgram(previousProgram);
+
+    const CrowdStats& crowdStats = m_crowd->getStats();
+    stats.setValue("Animacja/Postacie", static_cast<double>(count));
+    stats.setValue("Animacja/Widoczne postacie", static_cast<double>(m_visible.size()));
+    stats.setValue("Animacja/Kosci na postac", static_cast<double>(crowdStats.bones));
+    stats.setValue("Animacja/Tryb (0 = GPU, 1 = CPU)", static_cast<double>(m_mode));
+    stats.setValue("Animacja/Animacja [ms]", crowdStats.animationMs);
+    stats.setValue("Animacja/Animacja na postac [us]",
+                   crowdStats.characters > 0 ? crowdStats.animationMs * 1000.0 / crowdStats.characters : 0.0);
+    stats.setValue("Animacja/Przygotowanie klatki [ms]", std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+/**
+ * @brief Rysuje przygotowane postacie w aktywnym widoku
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(); poprzedni program jest przywracany.
+ */
+int SkinnedRenderer::draw() {
+    if (!m_prepared || m_visible.empty()) return 0;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform1i(m_materialIndexLoc, m_material);
+
+    GLsizei indexCount = static_cast<GLsizei>(m_mesh.indices.size());
+    GLsizei instances = static_cast<GLsizei>(m_visible.size());
+    if (m_mode == SkinningMode::GPU) {
+        glUniform1i(m_gpuSkinningLoc, 1);
+        glUniform1i(m_boneCountLoc, m_crowd->getSkeleton().getBoneCount());
+        glActiveTexture(GL_TEXTURE0 + BONE_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, m_boneTexture);
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(m_meshVAO);
+        glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instances);
+        glActiveTexture(GL_TEXTURE0 + BONE_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glActiveTexture(GL_TEXTURE0);
+    } else {
+        glUniform1i(m_gpuSkinningLoc, 0);
+        glBindVertexArray(m_streamVAO);
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_drawCounts.data(), GL_UNSIGNED_INT, m_drawOffsets.data(),
+                                      instances, m_drawBaseVertices.data());
+    }
+    glBindVertexArray(0);
+    glUseProgram(previousProgram);
+
+    RenderStats& stats = RenderStats::instance();
+    stats.addValue("Animacja/Wywolania rysowania", 1.0);
+    stats.addValue("Animacja/Trojkaty", static_cast<double>(indexCount / 3) * instances);
+    return 1;
+}
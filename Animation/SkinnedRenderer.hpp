@@ -0,0 +1,149 @@
+// SkinnedRenderer.hpp
+#ifndef SKINNED_RENDERER_HPP
+#define SKINNED_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Crowd.hpp"
+#include "../Material/MaterialTable.hpp"
+
+/**
+ * @enum SkinningMode
+ * @brief Miejsce przekształcania wierzchołków przez kości
+ */
+enum class SkinningMode {
+    GPU,    /**< Vertex shader z macierzami kości w buforze tekstury */
+    CPU     /**< Simd::skinVertices w ThreadPool, wynik w buforze strumieniowym */
+};
+
+/**
+ * @class SkinnedRenderer
+ * @brief Rysowanie tłumu postaci ze szkieletem z skinningiem na GPU albo CPU
+ *
+ * prepare() odrzuca postacie sferą otaczającą (postać widoczna w którymś
+ * widoku rysowana jest we wszystkich) i przygotowuje dane klatki:
+ *
+ * - GPU: macierze skinningu widocznych postaci (3 teksele RGBA32F na
+ *   kość) trafiają po kolei do bufora tekstury; siatka w pozie
+ *   spoczynkowej leży na GPU raz, a cały tłum to jedno
+ *   glDrawElementsInstanced, w którym instancja gl_InstanceID czyta
+ *   kości od tekselu 3 * gl_InstanceID * liczba kości,
+ * - CPU: Crowd::skinVertices() zapisuje przekształcone wierzchołki
+ *   wszystkich widocznych postaci wprost do zmapowanego bufora
+ *   strumieniowego, a tłum rysowany jest jednym
+ *   glMultiDrawElementsBaseVertex ze wspólnymi indeksami.
+ *
+ * Ścieżka CPU przesyła kilkadziesiąt razy więcej danych, ale nie wymaga
+ * odczytu z tekstury w vertex shaderze i pozwala użyć przekształconych
+ * wierzchołków poza rysowaniem. Oba tryby mają ten sam shader (Phong
+ * z tabelą materiałów i listą świateł), a koszt animacji, skinningu
+ * i wysyłania raportowany jest w grupie "Animacja" RenderStats.
+ */
+class SkinnedRenderer {
+public:
+    static const int BONE_TEXTURE_UNIT = 9;     /**< Jednostka teksturująca macierzy kości */
+
+private:
+    std::shared_ptr<Crowd> m_crowd;             /**< Rysowany tłum (nullptr = brak) */
+    SkinnedMeshData m_mesh;                     /**< Siatka postaci w pozie spoczynkowej */
+    MaterialId m_material;                      /**< Materiał postaci */
+    SkinningMode m_mode;                        /**< Tryb skinningu */
+    GLuint m_program;                           /**< Program rysowania postaci */
+    GLuint m_meshVAO;                           /**< VAO siatki spoczynkowej (tryb GPU) */
+    GLuint m_meshVBO;                           /**< Wierzchołki SkinnedVertex */
+    GLuint m_meshEBO;                           /**< Indeksy siatki (wspólne dla obu trybów) */
+    GLuint m_streamVAO;                         /**< VAO wierzchołków po skinningu (tryb CPU) */
+    GLuint m_streamVBO;                         /**< Strumieniowy bufor wierzchołków Vertex */
+    GLuint m_boneBuffer;                        /**< Bufor macierzy kości widocznych postaci */
+    GLuint m_boneTexture;                       /**< Tekstura bufora macierzy kości */
+    GLint m_gpuSkinningLoc;                     /**< Lokalizacja uniformu wyboru trybu */
+    GLint m_boneCountLoc;                       /**< Lokalizacja uniformu liczby kości */
+    GLint m_materialIndexLoc;                   /**< Lokalizacja uniformu materiału */
+    GLint m_lightListLoc;                       /**< Lokalizacja uniformu listy świateł */
+    size_t m_streamCapacity;                    /**< Pojemność bufora strumieniowego [B] */
+    size_t m_boneCapacity;                      /**< Pojemność bufora kości [B] */
+    std::vector<uint32_t> m_visible;            /**< Postacie widoczne w którymś widoku */
+    std::vector<GLsizei> m_drawCounts;          /**< Liczby indeksów glMultiDrawElementsBaseVertex */
+    std::vector<const void*> m_drawOffsets;     /**< Przesunięcia indeksów (zera) */
+    std::vector<GLint> m_drawBaseVertices;      /**< Pierwsze wierzchołki postaci w buforze */
+    bool m_prepared;                            /**< Czy dane klatki są gotowe */
+    bool m_initialized;                         /**< Czy obiekty OpenGL zostały utworzone */
+
+    /**
+     * @brief Wysyła macierze kości widocznych postaci
+     * @return true jeśli bufor został wypełniony
+     */
+    bool uploadBoneMatrices();
+
+    /**
+     * @brief Przekształca widoczne postacie na CPU do bufora strumieniowego
+     * @return true jeśli bufor został wypełniony
+     */
+    bool uploadSkinnedVertices();
+
+public:
+    /**
+     * @brief Konstruktor SkinnedRenderer
+     */
+    SkinnedRenderer();
+
+    /**
+     * @brief Destruktor SkinnedRenderer
+     */
+    ~SkinnedRenderer();
+
+    /**
+     * @brief Kompiluje shadery i tworzy bufory
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia obiekty OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Ustawia rysowany tłum i siatkę jego postaci
+     * @param crowd Tłum (aktualizowany przez wywołującego)
+     * @param mesh Siatka postaci dla szkieletu tłumu
+     * @param material Materiał postaci
+     */
+    void setCrowd(std::shared_ptr<Crowd> crowd, const SkinnedMeshData& mesh, MaterialId material);
+
+    /**
+     * @brief Przestaje rysować tłum
+     */
+    void clearCrowd();
+
+    /**
+     * @brief Zmienia tryb skinningu
+     * @param mode Tryb
+     */
+    void setMode(SkinningMode mode) { m_mode = mode; }
+
+    /**
+     * @brief Zwraca tryb skinningu
+     * @return Tryb
+     */
+    SkinningMode getMode() const { return m_mode; }
+
+    /**
+     * @brief Odrzuca niewidoczne postacie i przygotowuje dane klatki
+     * @param frustums Ostrosłupy wszystkich widoków
+     * @param lightList Globalna lista świateł
+     */
+    void prepare(const std::vector<Frustum>& frustums, const glm::ivec2& lightList);
+
+    /**
+     * @brief Rysuje przygotowane postacie w aktywnym widoku
+     * @return Liczba wywołań rysowania
+     */
+    int draw();
+};
+
+#endif // SKINNED_RENDERER_HPP
@@ -0,0 +1,436 @@
+// VertexAnimation.cpp
+#include "VertexAnimation.hpp"
+#include "../Math/Simd.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/** @brief Znacznik pliku ("SVAT") */
+static const uint32_t VERTEX_ANIMATION_MAGIC = 0x54415653u;
+
+/** @brief Wersja układu pliku */
+static const uint32_t VERTEX_ANIMATION_VERSION = 1;
+
+/** @brief Długość nazwy klipu w pliku (z kończącym zerem) */
+static const size_t VERTEX_ANIMATION_NAME_LENGTH = 32;
+
+/**
+ * @struct VertexAnimationFileHeader
+ * @brief Nagłówek pliku animacji wierzchołków
+ */
+struct VertexAnimationFileHeader {
+    uint32_t magic;         /**< VERTEX_ANIMATION_MAGIC */
+    uint32_t version;       /**< VERTEX_ANIMATION_VERSION */
+    uint32_t vertexCount;   /**< Wierzchołki klatki */
+    uint32_t frameCount;    /**< Klatki wszystkich klipów */
+    uint32_t lodCount;      /**< Poziomy szczegółów */
+    uint32_t clipCount;     /**< Klipy */
+    uint32_t indexCount;    /**< Indeksy trójkątów */
+    uint32_t textureRows;   /**< Wiersze tekstury */
+    float boundsMin[3];     /**< Narożnik prostopadłościanu kwantyzacji */
+    float boundsSize[3];    /**< Rozmiar prostopadłościanu kwantyzacji */
+};
+
+/**
+ * @struct VertexAnimationClipRecord
+ * @brief Opis klipu w pliku
+ */
+struct VertexAnimationClipRecord {
+    char name[VERTEX_ANIMATION_NAME_LENGTH];    /**< Nazwa (przycięta, zakończona zerem) */
+    uint32_t firstFrame;                        /**< Pierwsza klatka */
+    uint32_t frameCount;                        /**< Liczba klatek */
+    float frameRate;                            /**< Klatki na sekundę */
+    uint32_t looping;                           /**< 1 dla klipu zapętlonego */
+};
+
+static_assert(sizeof(VertexAnimationFileHeader) == 56, "Nieoczekiwany rozmiar naglowka animacji wierzcholkow");
+static_assert(sizeof(VertexAnimationLod) == 16, "Nieoczekiwany rozmiar poziomu szczegolow");
+static_assert(sizeof(VertexAnimationClipRecord) == 48, "Nieoczekiwany rozmiar rekordu klipu");
+
+/**
+ * @brief Koduje normalną w 16 bitach (rzut oktaedryczny, 8 bitów na współrzędną)
+ * @param normal Normalna (nie musi być jednostkowa)
+ * @return Współrzędna u w starszym bajcie, v w młodszym
+ */
+static uint16_t encodeNormal(const glm::vec3& normal) {
+    float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    glm::vec3 n = length > 0.0f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+    float u = n.x;
+    float v = n.y;
+    if (n.z < 0.0f) {
+        u = (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        v = (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    unsigned int qu = static_cast<unsigned int>(std::lround(std::clamp(u * 0.5f + 0.5f, 0.0f, 1.0f) * 255.0f));
+    unsigned int qv = static_cast<unsigned int>(std::lround(std::clamp(v * 0.5f + 0.5f, 0.0f, 1.0f) * 255.0f));
+    return static_cast<uint16_t>((qu << 8) | qv);
+}
+
+/**
+ * @brief Dekoduje normalną zapisaną przez encodeNormal
+ * @param packed Słowo normalnej
+ * @return Normalna jednostkowa
+ */
+static glm::vec3 decodeNormal(uint16_t packed) {
+    float u = static_cast<float>(packed >> 8) / 255.0f * 2.0f - 1.0f;
+    float v = static_cast<float>(packed & 0xFF) / 255.0f * 2.0f - 1.0f;
+    glm::vec3 n(u, v, 1.0f - std::abs(u) - std::abs(v));
+    float fold = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -fold : fold;
+    n.y += n.y >= 0.0f ? -fold : fold;
+    return glm::normalize(n);
+}
+
+/**
+ * @brief Konstruktor VertexAnimation - brak danych
+ */
+VertexAnimation::VertexAnimation()
+    : m_vertexCount(0), m_frameCount(0), m_boundsMin(0.0f), m_boundsSize(1.0f) {}
+
+/**
+ * @brief Wypala klipy do tekstury
+ * @param skeleton Szkielet (po finalize())
+ * @param lods Siatki poziomów szczegółów (od najdokładniejszej) dla szkieletu
+ * @param clips Klipy dla liczby kości szkieletu
+ * @param frameRate Klatki na sekundę wypalanej animacji
+ * @return true jeśli dane zostały wypalone
+ *
+ * @details Klip o długości d dostaje round(d * frameRate) + 1 klatek, a jego
+ * częstotliwość jest dopasowywana tak, by ostatnia klatka wypadła dokładnie
+ * na końcu klipu (w klipie zapętlonym równa się wtedy pierwszej). Klatki
+ * są niezależne, więc dzielone są między wątki ThreadPool: każda próbkuje
+ * klip, liczy macierze skinningu i przekształca wierzchołki wszystkich
+ * poziomów jednym Simd::skinVertices. Drugi przebieg, po wyznaczeniu
+ * prostopadłościanu wszystkich klatek, kwantyzuje wynik do tekseli.
+ */
+bool VertexAnimation::bake(const Skeleton& skeleton, const std::vector<SkinnedMeshData>& lods,
+                           const std::vector<std::shared_ptr<const AnimationClip>>& clips, float frameRate) {
+    const int boneCount = skeleton.getBoneCount();
+    if (lods.empty() || clips.empty() || frameRate <= 0.0f) {
+        std::cerr << "Blad: Brak siatek albo klipow do wypalenia animacji wierzcholkow" << std::endl;
+        return false;
+    }
+
+    std::vector<VertexAnimationLod> lodRanges;
+    std::vector<SkinnedVertex> vertices;
+    std::vector<unsigned int> indices;
+    for (const SkinnedMeshData& mesh : lods) {
+        for (const SkinnedVertex& vertex : mesh.vertices) {
+            for (int k = 0; k < 4; ++k) {
+                if (vertex.weights[k] > 0 && vertex.bones[k] >= boneCount) {
+                    std::cerr << "Blad: Siatka odwoluje sie do kosci spoza szkieletu" << std::endl;
+                    return false;
+                }
+            }
+        }
+        VertexAnimationLod range;
+        range.firstVertex = static_cast<uint32_t>(vertices.size());
+        range.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        range.firstIndex = static_cast<uint32_t>(indices.size());
+        range.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        for (unsigned int index : mesh.indices) indices.push_back(range.firstVertex + index);
+        vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        lodRanges.push_back(range);
+    }
+    const size_t vertexCount = vertices.size();
+    if (vertexCount == 0) {
+        std::cerr << "Blad: Siatki do wypalenia animacji wierzcholkow sa puste" << std::endl;
+        return false;
+    }
+
+    std::vector<VertexAnimationClip> clipRanges;
+    std::vector<uint32_t> frameClips;
+    for (const std::shared_ptr<const AnimationClip>& clip : clips) {
+        if (!clip || clip->getBoneCount() != boneCount) {
+            std::cerr << "Blad: Klip nie pasuje do szkieletu wypalanej animacji" << std::endl;
+            return false;
+        }
+        float duration = clip->getDuration();
+        VertexAnimationClip range;
+        range.name = clip->getName();
+        range.firstFrame = static_cast<uint32_t>(frameClips.size());
+        range.frameCount = 1;
+        range.frameRate = frameRate;
+        range.looping = clip->isLooping();
+        if (duration > 0.0f) {
+            range.frameCount = static_cast<uint32_t>(std::max(std::lround(duration * frameRate), 1L)) + 1;
+            range.frameRate = static_cast<float>(range.frameCount - 1) / duration;
+        }
+        frameClips.insert(frameClips.end(), range.frameCount, static_cast<uint32_t>(clipRanges.size()));
+        clipRanges.push_back(range);
+    }
+    const size_t frameCount = frameClips.size();
+
+    std::vector<Vertex> skinned(frameCount * vertexCount);
+    ThreadPool::instance().parallelFor(frameCount, 1, [&](size_t begin, size_t end) {
+        SkeletonPose pose;
+        std::vector<glm::mat4> scratch(boneCount);
+        std::vector<float> skinRows(static_cast<size_t>(boneCount) * Skeleton::SKIN_MATRIX_FLOATS);
+        for (size_t frame = begin; frame < end; ++frame) {
+            const VertexAnimationClip& range = clipRanges[frameClips[frame]];
+            float time = static_cast<float>(frame - range.firstFrame) / range.frameRate;
+            clips[frameClips[frame]]->sample(time, pose);
+            skeleton.computeSkinMatrices(pose, glm::mat4(1.0f), scratch.data(), skinRows.data());
+            Simd::skinVertices(skinRows.data(), &vertices[0].position.x, sizeof(SkinnedVertex) / sizeof(float),
+                               &skinned[frame * vertexCount].position.x, sizeof(Vertex) / sizeof(float), vertexCount);
+        }
+    });
+
+    glm::vec3 boundsMin = skinned[0].position;
+    glm::vec3 boundsMax = skinned[0].position;
+    for (const Vertex& vertex : skinned) {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+    glm::vec3 boundsSize = glm::max(boundsMax - boundsMin, glm::vec3(1e-6f));
+
+    const size_t texelCount = frameCount * vertexCount;
+    const size_t rows = (texelCount + TEXTURE_WIDTH - 1) / TEXTURE_WIDTH;
+    std::vector<uint16_t> texels(rows * TEXTURE_WIDTH * TEXEL_COMPONENTS, 0);
+    const glm::vec3 scale = 65535.0f / boundsSize;
+    ThreadPool::instance().parallelFor(frameCount, 4, [&](size_t begin, size_t end) {
+        for (size_t texel = begin * vertexCount; texel < end * vertexCount; ++texel) {
+            const Vertex& vertex = skinned[texel];
+            glm::vec3 quantized = glm::clamp((vertex.position - boundsMin) * scale + 0.5f, glm::vec3(0.0f),
+                                             glm::vec3(65535.0f));
+            uint16_t* out = &texels[texel * TEXEL_COMPONENTS];
+            out[0] = static_cast<uint16_t>(quantized.x);
+            out[1] = static_cast<uint16_t>(quantized.y);
+            out[2] = static_cast<uint16_t>(quantized.z);
+            out[3] = encodeNormal(vertex.normal);
+        }
+    });
+
+    m_vertexCount = static_cast<uint32_t>(vertexCount);
+    m_frameCount = static_cast<uint32_t>(frameCount);
+    m_lods = std::move(lodRanges);
+    m_clips = std::move(clipRanges);
+    m_indices = std::move(indices);
+    m_texels = std::move(texels);
+    m_boundsMin = boundsMin;
+    m_boundsSize = boundsSize;
+    return true;
+}
+
+/**
+ * @brief Zapisuje dane do pliku
+ * @param path Ścieżka pliku
+ * @return true jeśli zapis się powiódł
+ *
+ * @details Układ pliku:
+ *
+ *     VertexAnimationFileHeader
+ *     VertexAnimationLod[lodCount]
+ *     VertexAnimationClipRecord[clipCount]
+ *     uint32_t[indexCount]
+ *     uint16_t[textureRows * TEXTURE_WIDTH * 4]   (teksele jak w getTexels())
+ *
+ * Teksele zapisane są w układzie tekstury, więc load() wczytuje je jednym
+ * odczytem, gotowe do glTexImage2D.
+ */
+bool VertexAnimation::save(const std::string& path) const {
+    if (isEmpty()) {
+        std::cerr << "Blad: Brak animacji wierzcholkow do zapisania" << std::endl;
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Blad: Nie udalo sie utworzyc pliku animacji wierzcholkow " << path << std::endl;
+        return false;
+    }
+
+    VertexAnimationFileHeader header = {};
+    header.magic = VERTEX_ANIMATION_MAGIC;
+    header.version = VERTEX_ANIMATION_VERSION;
+    header.vertexCount = m_vertexCount;
+    header.frameCount = m_frameCount;
+    header.lodCount = static_cast<uint32_t>(m_lods.size());
+    header.clipCount = static_cast<uint32_t>(m_clips.size());
+    header.indexCount = static_cast<uint32_t>(m_indices.size());
+    header.textureRows = static_cast<uint32_t>(getTextureSize().y);
+    for (int i = 0; i < 3; ++i) {
+        header.boundsMin[i] = m_boundsMin[i];
+        header.boundsSize[i] = m_boundsSize[i];
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_lods.data()),
+               static_cast<std::streamsize>(m_lods.size() * sizeof(VertexAnimationLod)));
+    for (const VertexAnimationClip& clip : m_clips) {
+        VertexAnimationClipRecord record = {};
+        std::strncpy(record.name, clip.name.c_str(), VERTEX_ANIMATION_NAME_LENGTH - 1);
+        record.firstFrame = clip.firstFrame;
+        record.frameCount = clip.frameCount;
+        record.frameRate = clip.frameRate;
+        record.looping = clip.looping ? 1u : 0u;
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    file.write(reinterpret_cast<const char*>(m_indices.data()),
+               static_cast<std::streamsize>(m_indices.size() * sizeof(unsigned int)));
+    file.write(reinterpret_cast<const char*>(m_texels.data()),
+               static_cast<std::streamsize>(m_texels.size() * sizeof(uint16_t)));
+    if (!file) {
+        std::cerr << "Blad: Nie udalo sie zapisac animacji wierzcholkow " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Wczytuje dane z pliku
+ * @param path Ścieżka pliku zapisanego przez save()
+ * @return true jeśli odczyt się powiódł (przy błędzie dane się nie zmieniają)
+ *
+ * @details Zakresy poziomów, klipów i indeksów są sprawdzane, więc
+ * uszkodzony plik nie prowadzi do odczytu poza teksturą w shaderze.
+ */
+bool VertexAnimation::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Blad: Nie udalo sie otworzyc animacji wierzcholkow " << path << std::endl;
+        return false;
+    }
+    VertexAnimationFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    const uint64_t texelCount = static_cast<uint64_t>(header.frameCount) * header.vertexCount;
+    if (!file || header.magic != VERTEX_ANIMATION_MAGIC || header.version != VERTEX_ANIMATION_VERSION ||
+        texelCount == 0 || header.lodCount == 0 || header.clipCount == 0 ||
+        header.textureRows != (texelCount + TEXTURE_WIDTH - 1) / TEXTURE_WIDTH) {
+        std::cerr << "Blad: Plik " << path << " nie jest animacja wierzcholkow w obslugiwanej wersji" << std::endl;
+        return false;
+    }
+
+    std::vector<VertexAnimationLod> lods(header.lodCount);
+    std::vector<VertexAnimationClipRecord> records(header.clipCount);
+    std::vector<unsigned int> indices(header.indexCount);
+    std::vector<uint16_t> texels(static_cast<size_t>(header.textureRows) * TEXTURE_WIDTH * TEXEL_COMPONENTS);
+    file.read(reinterpret_cast<char*>(lods.data()), static_cast<std::streamsize>(lods.size() * sizeof(VertexAnimationLod)));
+    file.read(reinterpret_cast<char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(VertexAnimationClipRecord)));
+    file.read(reinterpret_cast<char*>(indices.data()), static_cast<std::streamsize>(indices.size() * sizeof(unsigned int)));
+    file.read(reinterpret_cast<char*>(texels.data()), static_cast<std::streamsize>(texels.size() * sizeof(uint16_t)));
+    if (!file) {
+        std::cerr << "Blad: Nie udalo sie odczytac animacji wierzcholkow " << path << std::endl;
+        return false;
+    }
+
+    bool valid = true;
+    for (const VertexAnimationLod& lod : lods) {
+        valid = valid && static_cast<uint64_t>(lod.firstVertex) + lod.vertexCount <= header.vertexCount &&
+                static_cast<uint64_t>(lod.firstIndex) + lod.indexCount <= header.indexCount;
+    }
+    std::vector<VertexAnimationClip> clips(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        const VertexAnimationClipRecord& record = records[i];
+        valid = valid && record.frameCount > 0 && record.frameRate > 0.0f &&
+                static_cast<uint64_t>(record.firstFrame) + record.frameCount <= header.frameCount;
+        clips[i].name.assign(record.name, std::find(record.name, record.name + VERTEX_ANIMATION_NAME_LENGTH, '\0'));
+        clips[i].firstFrame = record.firstFrame;
+        clips[i].frameCount = record.frameCount;
+        clips[i].frameRate = record.frameRate;
+        clips[i].looping = record.looping != 0;
+    }
+    for (unsigned int index : indices) valid = valid && index < header.vertexCount;
+    if (!valid) {
+        std::cerr << "Blad: Plik " << path << " zawiera niespojne zakresy animacji wierzcholkow" << std::endl;
+        return false;
+    }
+
+    m_vertexCount = header.vertexCount;
+    m_frameCount = header.frameCount;
+    m_lods = std::move(lods);
+    m_clips = std::move(clips);
+    m_indices = std::move(indices);
+    m_texels = std::move(texels);
+    m_boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    m_boundsSize = glm::vec3(header.boundsSize[0], header.boundsSize[1], header.boundsSize[2]);
+    return true;
+}
+
+/**
+ * @brief Zwraca rozmiar tekstury
+ * @return Szerokość (TEXTURE_WIDTH) i liczba wierszy
+ */
+glm::ivec2 VertexAnimation::getTextureSize() const {
+    return glm::ivec2(TEXTURE_WIDTH, static_cast<int>(m_texels.size() / (TEXTURE_WIDTH * TEXEL_COMPONENTS)));
+}
+
+/**
+ * @brief Zwraca sferę otaczającą wszystkie klatki
+ * @return Sfera w przestrzeni postaci
+ */
+BoundingSphere VertexAnimation::getBounds() const {
+    return {m_boundsMin + m_boundsSize * 0.5f, glm::length(m_boundsSize) * 0.5f};
+}
+
+/**
+ * @brief Zwraca pozycję wierzchołka w klatce
+ * @param frame Klatka
+ * @param vertex Wierzchołek
+ * @return Pozycja po dekwantyzacji
+ */
+glm::vec3 VertexAnimation::getPosition(uint32_t frame, uint32_t vertex) const {
+    const uint16_t* texel = &m_texels[(static_cast<size_t>(frame) * m_vertexCount + vertex) * TEXEL_COMPONENTS];
+    return m_boundsMin + glm::vec3(texel[0], texel[1], texel[2]) / 65535.0f * m_boundsSize;
+}
+
+/**
+ * @brief Zwraca normalną wierzchołka w klatce
+ * @param frame Klatka
+ * @param vertex Wierzchołek
+ * @return Normalna jednostkowa po dekodowaniu
+ */
+glm::vec3 VertexAnimation::getNormal(uint32_t frame, uint32_t vertex) const {
+    return decodeNormal(m_texels[(static_cast<size_t>(frame) * m_vertexCount + vertex) * TEXEL_COMPONENTS + 3]);
+}
+
+/**
+ * @brief Wybiera klatki i współczynnik interpolacji jak vertex shader
+ * @param clip Indeks klipu
+ * @param time Czas [s]
+ * @param frame0 Wynik: pierwsza klatka
+ * @param frame1 Wynik: druga klatka
+ * @return Współczynnik interpolacji między klatkami
+ *
+ * @details Klip zapętlony zawija numer klatki modulo liczba klatek - 1
+ * (ostatnia klatka równa się pierwszej), pozostałe są przycinane.
+ */
+float VertexAnimation::findFrames(int clip, float time, uint32_t& frame0, uint32_t& frame1) const {
+    const VertexAnimationClip& range = m_clips[std::clamp(clip, 0, static_cast<int>(m_clips.size()) - 1)];
+    float last = static_cast<float>(range.frameCount - 1);
+    float frame = time * range.frameRate;
+    if (range.looping) {
+        float period = std::max(last, 1.0f);
+        frame -= period * std::floor(frame / period);
+    } else {
+        frame = std::clamp(frame, 0.0f, last);
+    }
+    float whole = std::floor(frame);
+    frame0 = range.firstFrame + static_cast<uint32_t>(whole);
+    frame1 = range.firstFrame + static_cast<uint32_t>(std::min(whole + 1.0f, last));
+    return frame - whole;
+}
+
+/**
+ * @brief Odtwarza pozycję wierzchołka tak jak vertex shader
+ * @param clip Indeks klipu
+ * @param time Czas [s] (zapętlany albo przycinany)
+ * @param vertex Wierzchołek
+ * @return Pozycja interpolowana między klatkami
+ */
+glm::vec3 VertexAnimation::samplePosition(int clip, float time, uint32_t vertex) const {
+    uint32_t frame0 = 0;
+    uint32_t frame1 = 0;
+    float blend = findFrames(clip, time, frame0, frame1);
+    return glm::mix(getPosition(frame0, vertex), getPosition(frame1, vertex), blend);
+}
+
+/**
+ * @brief Zwraca zajmowaną pamięć
+ * @return Liczba bajtów tekseli i indeksów
+ */
+size_t VertexAnimation::getMemoryUsage() const {
+    return m_texels.size() * sizeof(uint16_t) + m_indices.size() * sizeof(unsigned int);
+}
@@ -0,0 +1,213 @@
+// VertexAnimation.hpp
+#ifndef VERTEX_ANIMATION_HPP
+#define VERTEX_ANIMATION_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AnimationClip.hpp"
+#include "Skeleton.hpp"
+#include "SkinnedMesh.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @struct VertexAnimationClip
+ * @brief Zakres klatek jednego klipu w teksturze animacji
+ */
+struct VertexAnimationClip {
+    std::string name;           /**< Nazwa klipu źródłowego */
+    uint32_t firstFrame;        /**< Pierwsza klatka */
+    uint32_t frameCount;        /**< Liczba klatek (zapętlony: ostatnia równa pierwszej) */
+    float frameRate;            /**< Klatki na sekundę (dopasowane do długości klipu) */
+    bool looping;               /**< Czy klip się zapętla */
+};
+
+/**
+ * @struct VertexAnimationLod
+ * @brief Poziom szczegółów siatki w teksturze animacji
+ *
+ * Wierzchołki wszystkich poziomów leżą kolejno w każdej klatce, a indeksy
+ * wskazują wierzchołki w całej klatce (nie względem poziomu).
+ */
+struct VertexAnimationLod {
+    uint32_t firstVertex;       /**< Pierwszy wierzchołek poziomu */
+    uint32_t vertexCount;       /**< Liczba wierzchołków poziomu */
+    uint32_t firstIndex;        /**< Pierwszy indeks poziomu */
+    uint32_t indexCount;        /**< Liczba indeksów poziomu */
+};
+
+/**
+ * @class VertexAnimation
+ * @brief Animacje siatki ze szkieletem wypalone do tekstury wierzchołków
+ *
+ * bake() odtwarza klipy z zadaną częstotliwością i zapisuje wynik skinningu
+ * każdego wierzchołka każdej klatki jako teksel RGBA16 (4 x uint16):
+ *
+ * - xyz: pozycja skwantowana w prostopadłościanie wszystkich klatek
+ *   (boundsMin + xyz / 65535 * boundsSize, błąd poniżej 0.1 mm dla postaci),
+ * - w: normalna w kodowaniu oktaedrycznym, po 8 bitów na współrzędną.
+ *
+ * Teksel wierzchołka v w klatce f ma numer f * getVertexCount() + v
+ * i leży w wierszu numer / TEXTURE_WIDTH, więc vertex shader pobiera pozę
+ * jednym texelFetch na klatkę, bez kości i bez danych od CPU. Dane nie
+ * zależą od OpenGL: można je wypalić przy starcie albo narzędziem
+ * i zapisać do pliku (save()/load()).
+ */
+class VertexAnimation {
+public:
+    static const int TEXTURE_WIDTH = 1024;      /**< Szerokość tekstury (minimum GL_MAX_TEXTURE_SIZE w OpenGL 3.3) */
+    static const int TEXEL_COMPONENTS = 4;      /**< Słowa uint16 na teksel */
+
+private:
+    uint32_t m_vertexCount;                     /**< Wierzchołki jednej klatki (wszystkie poziomy) */
+    uint32_t m_frameCount;                      /**< Klatki wszystkich klipów */
+    std::vector<VertexAnimationLod> m_lods;     /**< Poziomy szczegółów */
+    std::vector<VertexAnimationClip> m_clips;   /**< Klipy */
+    std::vector<unsigned int> m_indices;        /**< Indeksy trójkątów wszystkich poziomów */
+    std::vector<uint16_t> m_texels;             /**< Teksele RGBA16 (klatka po klatce) */
+    glm::vec3 m_boundsMin;                      /**< Narożnik prostopadłościanu kwantyzacji */
+    glm::vec3 m_boundsSize;                     /**< Rozmiar prostopadłościanu kwantyzacji */
+
+    /**
+     * @brief Wybiera klatki i współczynnik interpolacji jak vertex shader
+     * @param clip Indeks klipu
+     * @param time Czas [s]
+     * @param frame0 Wynik: pierwsza klatka
+     * @param frame1 Wynik: druga klatka
+     * @return Współczynnik interpolacji między klatkami
+     */
+    float findFrames(int clip, float time, uint32_t& frame0, uint32_t& frame1) const;
+
+public:
+    /**
+     * @brief Konstruktor VertexAnimation - brak danych
+     */
+    VertexAnimation();
+
+    /**
+     * @brief Wypala klipy do tekstury
+     * @param skeleton Szkielet (po finalize())
+     * @param lods Siatki poziomów szczegółów (od najdokładniejszej) dla szkieletu
+     * @param clips Klipy dla liczby kości szkieletu
+     * @param frameRate Klatki na sekundę wypalanej animacji
+     * @return true jeśli dane zostały wypalone
+     */
+    bool bake(const Skeleton& skeleton, const std::vector<SkinnedMeshData>& lods,
+              const std::vector<std::shared_ptr<const AnimationClip>>& clips, float frameRate);
+
+    /**
+     * @brief Zapisuje dane do pliku
+     * @param path Ścieżka pliku
+     * @return true jeśli zapis się powiódł
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Wczytuje dane z pliku
+     * @param path Ścieżka pliku zapisanego przez save()
+     * @return true jeśli odczyt się powiódł (przy błędzie dane się nie zmieniają)
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Sprawdza, czy są dane
+     * @return true po udanym bake() albo load()
+     */
+    bool isEmpty() const { return m_texels.empty(); }
+
+    /**
+     * @brief Zwraca liczbę wierzchołków klatki
+     * @return Wierzchołki wszystkich poziomów
+     */
+    uint32_t getVertexCount() const { return m_vertexCount; }
+
+    /**
+     * @brief Zwraca liczbę klatek
+     * @return Klatki wszystkich klipów
+     */
+    uint32_t getFrameCount() const { return m_frameCount; }
+
+    /**
+     * @brief Zwraca poziomy szczegółów
+     * @return Poziomy (od najdokładniejszego)
+     */
+    const std::vector<VertexAnimationLod>& getLods() const { return m_lods; }
+
+    /**
+     * @brief Zwraca klipy
+     * @return Klipy w kolejności bake()
+     */
+    const std::vector<VertexAnimationClip>& getClips() const { return m_clips; }
+
+    /**
+     * @brief Zwraca indeksy trójkątów
+     * @return Indeksy wszystkich poziomów
+     */
+    const std::vector<unsigned int>& getIndices() const { return m_indices; }
+
+    /**
+     * @brief Zwraca teksele
+     * @return TEXEL_COMPONENTS słów na teksel, dopełnione do pełnych wierszy
+     */
+    const std::vector<uint16_t>& getTexels() const { return m_texels; }
+
+    /**
+     * @brief Zwraca rozmiar tekstury
+     * @return Szerokość (TEXTURE_WIDTH) i liczba wierszy
+     */
+    glm::ivec2 getTextureSize() const;
+
+    /**
+     * @brief Zwraca narożnik prostopadłościanu kwantyzacji
+     * @return Minimalny narożnik w przestrzeni postaci
+     */
+    const glm::vec3& getBoundsMin() const { return m_boundsMin; }
+
+    /**
+     * @brief Zwraca rozmiar prostopadłościanu kwantyzacji
+     * @return Rozmiar w przestrzeni postaci
+     */
+    const glm::vec3& getBoundsSize() const { return m_boundsSize; }
+
+    /**
+     * @brief Zwraca sferę otaczającą wszystkie klatki
+     * @return Sfera w przestrzeni postaci
+     */
+    BoundingSphere getBounds() const;
+
+    /**
+     * @brief Zwraca pozycję wierzchołka w klatce
+     * @param frame Klatka
+     * @param vertex Wierzchołek
+     * @return Pozycja po dekwantyzacji
+     */
+    glm::vec3 getPosition(uint32_t frame, uint32_t vertex) const;
+
+    /**
+     * @brief Zwraca normalną wierzchołka w klatce
+     * @param frame Klatka
+     * @param vertex Wierzchołek
+     * @return Normalna jednostkowa po dekodowaniu
+     */
+    glm::vec3 getNormal(uint32_t frame, uint32_t vertex) const;
+
+    /**
+     * @brief Odtwarza pozycję wierzchołka tak jak vertex shader
+     * @param clip Indeks klipu
+     * @param time Czas [s] (zapętlany albo przycinany)
+     * @param vertex Wierzchołek
+     * @return Pozycja interpolowana między klatkami
+     */
+    glm::vec3 samplePosition(int clip, float time, uint32_t vertex) const;
+
+    /**
+     * @brief Zwraca zajmowaną pamięć
+     * @return Liczba bajtów tekseli i indeksów
+     */
+    size_t getMemoryUsage() const;
+};
+
+#endif // VERTEX_ANIMATION_HPP
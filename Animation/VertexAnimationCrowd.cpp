@@ -0,0 +1,122 @@
+// VertexAnimationCrowd.cpp
+#include "VertexAnimationCrowd.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Konstruktor VertexAnimationCrowd
+ * @param animation Wypalona animacja postaci
+ */
+VertexAnimationCrowd::VertexAnimationCrowd(std::shared_ptr<const VertexAnimation> animation)
+    : m_animation(std::move(animation)), m_built(true) {}
+
+/**
+ * @brief Dodaje instancję
+ * @param instance Postać (klip spoza zakresu używa ostatniego klipu)
+ */
+void VertexAnimationCrowd::addInstance(const VertexAnimationInstance& instance) {
+    m_instances.push_back(instance);
+    m_built = false;
+}
+
+/**
+ * @brief Usuwa wszystkie instancje
+ */
+void VertexAnimationCrowd::clear() {
+    m_instances.clear();
+    m_cells.clear();
+    m_built = true;
+}
+
+/**
+ * @brief Sortuje instancje według komórek i liczy sfery komórek
+ *
+ * @details Sfera instancji to sfera wszystkich klatek animacji z poziomo
+ * odsuniętym środkiem powiększona o to odsunięcie (obrót wokół Y jej nie
+ * zmienia); komórka dostaje sferę opisaną na prostopadłościanie sfer
+ * swoich instancji. Sortowanie jest stabilne, więc kolejność postaci
+ * w komórce nie zależy od implementacji.
+ */
+void VertexAnimationCrowd::build() {
+    m_cells.clear();
+    m_built = true;
+    if (m_instances.empty()) return;
+
+    struct Key {
+        int64_t cell;
+        uint32_t instance;
+    };
+    std::vector<Key> keys(m_instances.size());
+    for (size_t i = 0; i < m_instances.size(); ++i) {
+        const glm::vec3& position = m_instances[i].position;
+        int64_t x = static_cast<int64_t>(std::floor(position.x / CELL_SIZE));
+        int64_t z = static_cast<int64_t>(std::floor(position.z / CELL_SIZE));
+        keys[i] = {(z << 32) + x, static_cast<uint32_t>(i)};
+    }
+    std::stable_sort(keys.begin(), keys.end(), [](const Key& a, const Key& b) { return a.cell < b.cell; });
+
+    std::vector<VertexAnimationInstance> sorted(m_instances.size());
+    for (size_t i = 0; i < keys.size(); ++i) sorted[i] = m_instances[keys[i].instance];
+    m_instances.swap(sorted);
+
+    BoundingSphere local = m_animation ? m_animation->getBounds() : BoundingSphere{glm::vec3(0.0f, 1.0f, 0.0f), 1.0f};
+    float horizontal = std::sqrt(local.center.x * local.center.x + local.center.z * local.center.z);
+    size_t first = 0;
+    while (first < keys.size()) {
+        size_t end = first;
+        glm::vec3 minimum(0.0f);
+        glm::vec3 maximum(0.0f);
+        while (end < keys.size() && keys[end].cell == keys[first].cell) {
+            const VertexAnimationInstance& instance = m_instances[end];
+            glm::vec3 center = instance.position + glm::vec3(0.0f, local.center.y * instance.scale, 0.0f);
+            glm::vec3 extent((local.radius + horizontal) * instance.scale);
+            minimum = end == first ? center - extent : glm::min(minimum, center - extent);
+            maximum = end == first ? center + extent : glm::max(maximum, center + extent);
+            ++end;
+        }
+        VertexAnimationCell cell;
+        cell.bounds = {(minimum + maximum) * 0.5f, glm::length(maximum - minimum) * 0.5f};
+        cell.firstInstance = static_cast<uint32_t>(first);
+        cell.instanceCount = static_cast<uint32_t>(end - first);
+        m_cells.push_back(cell);
+        first = end;
+    }
+}
+
+/**
+ * @brief Wybiera widoczne komórki
+ * @param frustums Ostrosłupy wszystkich widoków
+ * @param viewPosition Pozycja kamery głównej (wybór poziomu szczegółów)
+ * @param draws Wynik: widoczne komórki (zastępowany)
+ * @return Liczba instancji w widocznych komórkach
+ *
+ * @details Komórka widoczna w którymś widoku rysowana jest we wszystkich.
+ * Poziom szczegółów zależy od odległości kamery od sfery komórki, więc
+ * cała komórka ma jeden poziom i jest jednym wywołaniem rysowania.
+ */
+size_t VertexAnimationCrowd::cull(const std::vector<Frustum>& frustums, const glm::vec3& viewPosition,
+                                  std::vector<VertexAnimationDraw>& draws) const {
+    draws.clear();
+    if (!m_animation || m_animation->isEmpty()) return 0;
+
+    const int lodCount = static_cast<int>(m_animation->getLods().size());
+    size_t instances = 0;
+    for (size_t i = 0; i < m_cells.size(); ++i) {
+        const VertexAnimationCell& cell = m_cells[i];
+        bool visible = false;
+        for (const Frustum& frustum : frustums) {
+            if (frustum.intersects(cell.bounds)) {
+                visible = true;
+                break;
+            }
+        }
+        if (!visible) continue;
+
+        float distance = std::max(glm::length(cell.bounds.center - viewPosition) - cell.bounds.radius, 0.0f);
+        int lod = 0;
+        while (lod < static_cast<int>(m_lodDistances.size()) && distance >= m_lodDistances[lod]) ++lod;
+        draws.push_back({static_cast<uint32_t>(i), std::min(lod, lodCount - 1)});
+        instances += cell.instanceCount;
+    }
+    return instances;
+}
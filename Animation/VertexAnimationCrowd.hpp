@@ -0,0 +1,136 @@
+// VertexAnimationCrowd.hpp
+#ifndef VERTEX_ANIMATION_CROWD_HPP
+#define VERTEX_ANIMATION_CROWD_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "VertexAnimation.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @struct VertexAnimationInstance
+ * @brief Postać tłumu z wypaloną animacją
+ *
+ * Układ jest zgodny z atrybutami instancji VertexAnimationRenderer
+ * (32 bajty): stan animacji to tylko numer klipu, przesunięcie czasu
+ * i tempo, a bieżącą klatkę wylicza vertex shader z czasu globalnego.
+ */
+struct VertexAnimationInstance {
+    glm::vec3 position = glm::vec3(0.0f);   /**< Pozycja stóp w przestrzeni świata */
+    float yaw = 0.0f;                       /**< Obrót wokół osi Y [rad] */
+    float timeOffset = 0.0f;                /**< Przesunięcie czasu klipu [s] */
+    float speed = 1.0f;                     /**< Mnożnik tempa */
+    float scale = 1.0f;                     /**< Skala postaci */
+    uint32_t clip = 0;                      /**< Indeks klipu VertexAnimation */
+};
+
+static_assert(sizeof(VertexAnimationInstance) == 8 * sizeof(float), "VertexAnimationInstance musi miec 32 bajty");
+
+/**
+ * @struct VertexAnimationCell
+ * @brief Komórka siatki tłumu - ciągły zakres instancji
+ */
+struct VertexAnimationCell {
+    BoundingSphere bounds;      /**< Sfera otaczająca wszystkie klatki wszystkich instancji */
+    uint32_t firstInstance;     /**< Pierwsza instancja (w kolejności getInstances()) */
+    uint32_t instanceCount;     /**< Liczba instancji */
+};
+
+/**
+ * @struct VertexAnimationDraw
+ * @brief Widoczna komórka z wybranym poziomem szczegółów
+ */
+struct VertexAnimationDraw {
+    uint32_t cell;      /**< Indeks komórki */
+    int lod;            /**< Poziom szczegółów */
+};
+
+/**
+ * @class VertexAnimationCrowd
+ * @brief Statyczne rozmieszczenie tłumu z wypaloną animacją
+ *
+ * build() sortuje instancje według komórek poziomej siatki o boku
+ * CELL_SIZE, więc komórka to ciągły zakres bufora instancji, który
+ * VertexAnimationRenderer wysyła na GPU raz. Na klatkę przypada tylko
+ * cull(): test sfer komórek z ostrosłupami i wybór poziomu szczegółów
+ * z odległości - koszt CPU zależy od liczby komórek, nie postaci.
+ */
+class VertexAnimationCrowd {
+public:
+    static constexpr float CELL_SIZE = 16.0f;   /**< Bok komórki siatki [m] */
+
+private:
+    std::shared_ptr<const VertexAnimation> m_animation;     /**< Wypalona animacja */
+    std::vector<VertexAnimationInstance> m_instances;       /**< Instancje (po build() według komórek) */
+    std::vector<VertexAnimationCell> m_cells;               /**< Komórki z build() */
+    std::vector<float> m_lodDistances;                      /**< Odległość przejścia na poziom i + 1 [m] */
+    bool m_built;                                           /**< Czy komórki odpowiadają instancjom */
+
+public:
+    /**
+     * @brief Konstruktor VertexAnimationCrowd
+     * @param animation Wypalona animacja postaci
+     */
+    explicit VertexAnimationCrowd(std::shared_ptr<const VertexAnimation> animation);
+
+    /**
+     * @brief Dodaje instancję
+     * @param instance Postać (klip spoza zakresu używa ostatniego klipu)
+     */
+    void addInstance(const VertexAnimationInstance& instance);
+
+    /**
+     * @brief Usuwa wszystkie instancje
+     */
+    void clear();
+
+    /**
+     * @brief Sortuje instancje według komórek i liczy sfery komórek
+     */
+    void build();
+
+    /**
+     * @brief Ustawia odległości przełączania poziomów szczegółów
+     * @param distances Rosnące odległości [m]; element i włącza poziom i + 1
+     */
+    void setLodDistances(const std::vector<float>& distances) { m_lodDistances = distances; }
+
+    /**
+     * @brief Wybiera widoczne komórki
+     * @param frustums Ostrosłupy wszystkich widoków
+     * @param viewPosition Pozycja kamery głównej (wybór poziomu szczegółów)
+     * @param draws Wynik: widoczne komórki (zastępowany)
+     * @return Liczba instancji w widocznych komórkach
+     */
+    size_t cull(const std::vector<Frustum>& frustums, const glm::vec3& viewPosition,
+                std::vector<VertexAnimationDraw>& draws) const;
+
+    /**
+     * @brief Zwraca wypaloną animację
+     * @return Animacja
+     */
+    const std::shared_ptr<const VertexAnimation>& getAnimation() const { return m_animation; }
+
+    /**
+     * @brief Zwraca instancje
+     * @return Instancje (po build() w kolejności komórek)
+     */
+    const std::vector<VertexAnimationInstance>& getInstances() const { return m_instances; }
+
+    /**
+     * @brief Zwraca komórki
+     * @return Komórki z ostatniego build()
+     */
+    const std::vector<VertexAnimationCell>& getCells() const { return m_cells; }
+
+    /**
+     * @brief Sprawdza, czy komórki są aktualne
+     * @return false po zmianie instancji bez build()
+     */
+    bool isBuilt() const { return m_built; }
+};
+
+#endif // VERTEX_ANIMATION_CROWD_HPP
@@ -0,0 +1,415 @@
+// VertexAnimationRenderer.cpp
+#include "VertexAnimationRenderer.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+
+/**
+ * @brief Vertex shader postaci: poza z tekstury animacji
+ *
+ * Klip to wektor (pierwsza klatka, liczba klatek, klatki na sekundę,
+ * zapętlenie); wybór klatek odpowiada VertexAnimation::samplePosition.
+ * Teksel to pozycja skwantowana w prostopadłościanie klatek i normalna
+ * oktaedryczna w 16 bitach składowej w.
+ */
+static const char* vertexAnimationVertexSource = R"(
+#version 330 core
+layout (location = 0) in uint aVertex;
+layout (location = 1) in vec4 aPlacement;   // xyz = pozycja, w = obrót wokół Y
+layout (location = 2) in vec3 aPlayback;    // przesunięcie czasu, tempo, skala
+layout (location = 3) in uint aClip;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+#define MAX_CLIPS 16
+uniform sampler2D animationTexture;
+uniform vec4 clips[MAX_CLIPS];
+uniform int clipCount;
+uniform int vertexCount;
+uniform float animationTime;
+uniform vec3 boundsMin;
+uniform vec3 boundsSize;
+
+out vec3 FragPos;
+out vec3 Normal;
+
+vec4 fetchFrame(int frame) {
+    int texel = frame * vertexCount + int(aVertex);
+    int width = textureSize(animationTexture, 0).x;
+    return texelFetch(animationTexture, ivec2(texel % width, texel / width), 0);
+}
+
+vec3 decodeNormal(float packed) {
+    float word = floor(packed * 65535.0 + 0.5);
+    vec2 e = vec2(floor(word / 256.0), mod(word, 256.0)) / 255.0 * 2.0 - 1.0;
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float fold = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -fold : fold;
+    n.y += n.y >= 0.0 ? -fold : fold;
+    return normalize(n);
+}
+
+void main()
+{
+    vec4 clip = clips[min(int(aClip), clipCount - 1)];
+    float last = clip.y - 1.0;
+    float frame = (animationTime * aPlayback.y + aPlayback.x) * clip.z;
+    frame = clip.w > 0.5 ? mod(frame, max(last, 1.0)) : clamp(frame, 0.0, last);
+    float whole = floor(frame);
+    vec4 texel0 = fetchFrame(int(clip.x + whole));
+    vec4 texel1 = fetchFrame(int(clip.x + min(whole + 1.0, last)));
+    float blend = frame - whole;
+
+    vec3 local = (boundsMin + mix(texel0.xyz, texel1.xyz, blend) * boundsSize) * aPlayback.z;
+    vec3 normal = mix(decodeNormal(texel0.w), decodeNormal(texel1.w), blend);
+    float c = cos(aPlacement.w);
+    float s = sin(aPlacement.w);
+    vec3 position = aPlacement.xyz + vec3(c * local.x + s * local.z, local.y, -s * local.x + c * local.z);
+    FragPos = position;
+    Normal = vec3(c * normal.x + s * normal.z, normal.y, -s * normal.x + c * normal.z);
+    gl_Position = projection * view * vec4(position, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader postaci
+ *
+ * Oświetlenie jak w shaderze sceny (ta sama tabela materiałów i lista
+ * świateł); wszystkie postacie mają jeden materiał. Poprzedza go kod
+ * z LightCuller::getShaderSource().
+ */
+static const char* vertexAnimationFragmentSource = R"(
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+
+uniform ivec2 lightList;
+uniform int materialIndex;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+void main()
+{
+    vec3 normal = normalize(Normal);
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
+    PackedMaterial material = materialData[materialIndex];
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < lightList.y; i++) {
+        int lightIndex = texelFetch(lightIndices, lightList.x + i).r;
+        result += calculatePhongLight(lightData[lightIndex], material, normal, FragPos, viewDir);
+    }
+    FragColor = vec4(result, 1.0);
+}
+)";
+
+/**
+ * @brief Konstruktor VertexAnimationRenderer
+ */
+VertexAnimationRenderer::VertexAnimationRenderer()
+    : m_material(MaterialTable::DEFAULT_MATERIAL), m_program(0), m_vao(0), m_vertexBuffer(0), m_indexBuffer(0),
+      m_instanceBuffer(0), m_animationTexture(0), m_animationTimeLoc(-1), m_materialIndexLoc(-1), m_lightListLoc(-1),
+      m_textureBytes(0), m_time(0.0f), m_uploaded(false), m_initialized(false) {}
+
+/**
+ * @brief Destruktor VertexAnimationRenderer
+ */
+VertexAnimationRenderer::~VertexAnimationRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery i tworzy bufory
+ * @return true jeśli inicjalizacja się powiodła
+ *
+ * @details Atrybuty instancji mają dzielnik 1; ich wskaźniki ustawia
+ * draw() osobno dla każdej komórki.
+ */
+bool VertexAnimationRenderer::initialize() {
+    if (m_initialized) return true;
+
+    const char* label = "animacji wierzcholkow";
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, vertexAnimationVertexSource, label);
+    const char* fragmentSources[] = {"#version 330 core\n", LightCuller::getShaderSource(), vertexAnimationFragmentSource};
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSources, 3, label);
+    m_program = ShaderUtils::linkProgram(vertexShader, fragmentShader, label);
+    if (!m_program) return false;
+
+    MultiViewRenderer::setupProgram(m_program);
+    LightCuller::setupProgram(m_program);
+    MaterialTable::setupProgram(m_program);
+    m_animationTimeLoc = glGetUniformLocation(m_program, "animationTime");
+    m_materialIndexLoc = glGetUniformLocation(m_program, "materialIndex");
+    m_lightListLoc = glGetUniformLocation(m_program, "lightList");
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform1i(glGetUniformLocation(m_program, "animationTexture"), ANIMATION_TEXTURE_UNIT);
+    glUseProgram(previousProgram);
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vertexBuffer);
+    glGenBuffers(1, &m_indexBuffer);
+    glGenBuffers(1, &m_instanceBuffer);
+    glGenTextures(1, &m_animationTexture);
+    if (!m_vao || !m_vertexBuffer || !m_indexBuffer || !m_instanceBuffer || !m_animationTexture) {
+        std::cerr << "Blad: Nie udalo sie utworzyc buforow animacji wierzcholkow" << std::endl;
+        release();
+        return false;
+    }
+
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_2D, m_animationTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    m_initialized = true;
+    if (m_crowd) setCrowd(m_crowd, m_material);
+    return true;
+}
+
+/**
+ * @brief Zwalnia obiekty OpenGL
+ */
+void VertexAnimationRenderer::release() {
+    if (m_program) glDeleteProgram(m_program);
+    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    if (m_vertexBuffer) glDeleteBuffers(1, &m_vertexBuffer);
+    if (m_indexBuffer) glDeleteBuffers(1, &m_indexBuffer);
+    if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+    if (m_animationTexture) glDeleteTextures(1, &m_animationTexture);
+    m_program = 0;
+    m_vao = 0;
+    m_vertexBuffer = 0;
+    m_indexBuffer = 0;
+    m_instanceBuffer = 0;
+    m_animationTexture = 0;
+    m_textureBytes = 0;
+    m_draws.clear();
+    m_uploaded = false;
+    m_initialized = false;
+}
+
+/**
+ * @brief Ustawia rysowany tłum
+ * @param crowd Tłum (po zmianie instancji należy wywołać setCrowd ponownie)
+ * @param material Materiał postaci
+ *
+ * @details Nieposortowany tłum jest najpierw dzielony na komórki
+ * (VertexAnimationCrowd::build()).
+ */
+void VertexAnimationRenderer::setCrowd(std::shared_ptr<VertexAnimationCrowd> crowd, MaterialId material) {
+    m_crowd = std::move(crowd);
+    m_material = material;
+    m_draws.clear();
+    m_uploaded = false;
+    if (!m_crowd) return;
+    if (!m_crowd->isBuilt()) m_crowd->build();
+    if (!m_initialized) return;
+    m_uploaded = upload();
+}
+
+/**
+ * @brief Przestaje rysować tłum
+ */
+void VertexAnimationRenderer::clearCrowd() {
+    m_crowd.reset();
+    m_draws.clear();
+    m_uploaded = false;
+}
+
+/**
+ * @brief Wysyła teksturę, siatkę, instancje i tablicę klipów
+ * @return true jeśli dane zmieściły się w limitach OpenGL
+ *
+ * @details Numery wierzchołków to 0..liczba wierzchołków klatki - 1, bo
+ * indeksy VertexAnimation wskazują wierzchołki całej klatki; numer jest
+ * atrybutem zamiast gl_VertexID, więc profil zgodności ma włączoną
+ * tablicę atrybutu 0.
+ */
+bool VertexAnimationRenderer::upload() {
+    const VertexAnimation* animation = m_crowd->getAnimation().get();
+    if (!animation || animation->isEmpty()) {
+        std::cerr << "Blad: Tlum nie ma wypalonej animacji wierzcholkow" << std::endl;
+        return false;
+    }
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    glm::ivec2 size = animation->getTextureSize();
+    if (size.x > maxTextureSize || size.y > maxTextureSize) {
+        std::cerr << "Blad: Tekstura animacji wierzcholkow " << size.x << " x " << size.y
+                  << " przekracza GL_MAX_TEXTURE_SIZE (" << maxTextureSize << ")" << std::endl;
+        return false;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, m_animationTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_SHORT,
+                 animation->getTexels().data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_textureBytes = animation->getTexels().size() * sizeof(uint16_t);
+
+    std::vector<uint32_t> vertexIds(animation->getVertexCount());
+    std::iota(vertexIds.begin(), vertexIds.end(), 0u);
+    const std::vector<VertexAnimationInstance>& instances = m_crowd->getInstances();
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexIds.size() * sizeof(uint32_t)), vertexIds.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instances.size() * sizeof(VertexAnimationInstance)),
+                 instances.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(m_vao);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(animation->getIndices().size() * sizeof(unsigned int)),
+                 animation->getIndices().data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+
+    const std::vector<VertexAnimationClip>& clips = animation->getClips();
+    if (clips.size() > static_cast<size_t>(MAX_CLIPS)) {
+        std::cerr << "Ostrzezenie: Animacja ma " << clips.size() << " klipow, shader uzyje pierwszych " << MAX_CLIPS
+                  << std::endl;
+    }
+    int clipCount = static_cast<int>(std::min(clips.size(), static_cast<size_t>(MAX_CLIPS)));
+    std::vector<glm::vec4> clipTable(clipCount);
+    for (int i = 0; i < clipCount; ++i) {
+        clipTable[i] = glm::vec4(static_cast<float>(clips[i].firstFrame), static_cast<float>(clips[i].frameCount),
+                                 clips[i].frameRate, clips[i].looping ? 1.0f : 0.0f);
+    }
+    const glm::vec3& boundsMin = animation->getBoundsMin();
+    const glm::vec3& boundsSize = animation->getBoundsSize();
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform4fv(glGetUniformLocation(m_program, "clips"), clipCount, &clipTable[0].x);
+    glUniform1i(glGetUniformLocation(m_program, "clipCount"), clipCount);
+    glUniform1i(glGetUniformLocation(m_program, "vertexCount"), static_cast<GLint>(animation->getVertexCount()));
+    glUniform3f(glGetUniformLocation(m_program, "boundsMin"), boundsMin.x, boundsMin.y, boundsMin.z);
+    glUniform3f(glGetUniformLocation(m_program, "boundsSize"), boundsSize.x, boundsSize.y, boundsSize.z);
+    glUseProgram(previousProgram);
+    return true;
+}
+
+/**
+ * @brief Wybiera widoczne komórki i ustawia czas klatki
+ * @param frustums Ostrosłupy wszystkich widoków
+ * @param viewPosition Pozycja kamery głównej (wybór poziomu szczegółów)
+ * @param lightList Globalna lista świateł
+ * @param time Czas globalny animacji [s]
+ *
+ * @details Jedyna praca CPU na klatkę to test sfer komórek, więc czas
+ * przygotowania na instancję spada wraz z liczbą postaci w komórce.
+ */
+void VertexAnimationRenderer::prepare(const std::vector<Frustum>& frustums, const glm::vec3& viewPosition,
+                                      const glm::ivec2& lightList, float time) {
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Animacja VAT/Wywolania rysowania", 0.0);
+    stats.setValue("Animacja VAT/Trojkaty", 0.0);
+    m_draws.clear();
+    if (!m_initialized || !m_crowd || !m_uploaded) return;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t visible = m_crowd->cull(frustums, viewPosition, m_draws);
+    auto end = std::chrono::high_resolution_clock::now();
+    m_time = time;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform2i(m_lightListLoc, lightList.x, lightList.y);
+    glUniform1f(m_animationTimeLoc, m_time);
+    glUseProgram(previousProgram);
+
+    double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+    size_t instances = m_crowd->getInstances().size();
+    stats.setValue("Animacja VAT/Postacie", static_cast<double>(instances));
+    stats.setValue("Animacja VAT/Widoczne postacie", static_cast<double>(visible));
+    stats.setValue("Animacja VAT/Komorki", static_cast<double>(m_crowd->getCells().size()));
+    stats.setValue("Animacja VAT/Widoczne komorki", static_cast<double>(m_draws.size()));
+    stats.setValue("Animacja VAT/Tekstura [MB]", m_textureBytes / (1024.0 * 1024.0));
+    stats.setValue("Animacja VAT/Przygotowanie klatki [ms]", milliseconds);
+    stats.setValue("Animacja VAT/Przygotowanie na postac [ns]",
+                   instances > 0 ? milliseconds * 1e6 / static_cast<double>(instances) : 0.0);
+}
+
+/**
+ * @brief Rysuje widoczne komórki w aktywnym widoku
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(); poprzedni program jest przywracany.
+ */
+int VertexAnimationRenderer::draw() {
+    if (m_draws.empty()) return 0;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform1i(m_materialIndexLoc, m_material);
+    glActiveTexture(GL_TEXTURE0 + ANIMATION_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, m_animationTexture);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+    const std::vector<VertexAnimationLod>& lods = m_crowd->getAnimation()->getLods();
+    const std::vector<VertexAnimationCell>& cells = m_crowd->getCells();
+    const GLsizei stride = sizeof(VertexAnimationInstance);
+    double triangles = 0.0;
+    for (const VertexAnimationDraw& draw : m_draws) {
+        const VertexAnimationCell& cell = cells[draw.cell];
+        const VertexAnimationLod& lod = lods[draw.lod];
+        size_t base = static_cast<size_t>(cell.firstInstance) * sizeof(VertexAnimationInstance);
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)base);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(VertexAnimationInstance, timeOffset)));
+        glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, stride, (void*)(base + offsetof(VertexAnimationInstance, clip)));
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(lod.indexCount), GL_UNSIGNED_INT,
+                                (void*)(static_cast<size_t>(lod.firstIndex) * sizeof(unsigned int)),
+                                static_cast<GLsizei>(cell.instanceCount));
+        triangles += static_cast<double>(lod.indexCount / 3) * cell.instanceCount;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0 + ANIMATION_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glUseProgram(previousProgram);
+
+    RenderStats& stats = RenderStats::instance();
+    stats.addValue("Animacja VAT/Wywolania rysowania", static_cast<double>(m_draws.size()));
+    stats.addValue("Animacja VAT/Trojkaty", triangles);
+    return static_cast<int>(m_draws.size());
+}
@@ -0,0 +1,111 @@
+// VertexAnimationRenderer.hpp
+#ifndef VERTEX_ANIMATION_RENDERER_HPP
+#define VERTEX_ANIMATION_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include "VertexAnimationCrowd.hpp"
+#include "../Material/MaterialTable.hpp"
+
+/**
+ * @class VertexAnimationRenderer
+ * @brief Rysowanie tłumu z animacją wypaloną do tekstury wierzchołków
+ *
+ * setCrowd() wysyła na GPU raz: teksturę VertexAnimation (RGBA16), indeksy
+ * wszystkich poziomów szczegółów i bufor instancji w kolejności komórek.
+ * Wierzchołek siatki to tylko jego numer; vertex shader wylicza klatkę
+ * klipu instancji z czasu globalnego, jej przesunięcia i tempa, pobiera
+ * dwie sąsiednie klatki z tekstury, interpoluje je i obraca o yaw
+ * instancji. Kości, próbkowanie klipów i dane na postać po stronie CPU
+ * nie istnieją.
+ *
+ * prepare() wybiera widoczne komórki (VertexAnimationCrowd::cull), a draw()
+ * rysuje każdą jednym glDrawElementsInstanced. OpenGL 3.3 nie ma
+ * pierwszej instancji w wywołaniu rysowania, więc przed każdą komórką
+ * atrybuty instancji są przepinane na jej zakres bufora. Shader oświetla
+ * postacie jak SkinnedRenderer, a koszty trafiają do grupy "Animacja VAT"
+ * RenderStats.
+ */
+class VertexAnimationRenderer {
+public:
+    static const int ANIMATION_TEXTURE_UNIT = 10;   /**< Jednostka teksturująca tekstury animacji */
+    static const int MAX_CLIPS = 16;                /**< Najwięcej klipów w tablicy uniformów shadera */
+
+private:
+    std::shared_ptr<VertexAnimationCrowd> m_crowd;  /**< Rysowany tłum (nullptr = brak) */
+    MaterialId m_material;                          /**< Materiał postaci */
+    GLuint m_program;                               /**< Program rysowania postaci */
+    GLuint m_vao;                                   /**< VAO numerów wierzchołków i instancji */
+    GLuint m_vertexBuffer;                          /**< Numery wierzchołków klatki */
+    GLuint m_indexBuffer;                           /**< Indeksy wszystkich poziomów szczegółów */
+    GLuint m_instanceBuffer;                        /**< Instancje w kolejności komórek */
+    GLuint m_animationTexture;                      /**< Tekstura animacji RGBA16 */
+    GLint m_animationTimeLoc;                       /**< Lokalizacja uniformu czasu */
+    GLint m_materialIndexLoc;                       /**< Lokalizacja uniformu materiału */
+    GLint m_lightListLoc;                           /**< Lokalizacja uniformu listy świateł */
+    std::vector<VertexAnimationDraw> m_draws;       /**< Widoczne komórki */
+    size_t m_textureBytes;                          /**< Rozmiar tekstury animacji [B] */
+    float m_time;                                   /**< Czas klatki [s] */
+    bool m_uploaded;                                /**< Czy dane tłumu są na GPU */
+    bool m_initialized;                             /**< Czy obiekty OpenGL zostały utworzone */
+
+    /**
+     * @brief Wysyła teksturę, siatkę, instancje i tablicę klipów
+     * @return true jeśli dane zmieściły się w limitach OpenGL
+     */
+    bool upload();
+
+public:
+    /**
+     * @brief Konstruktor VertexAnimationRenderer
+     */
+    VertexAnimationRenderer();
+
+    /**
+     * @brief Destruktor VertexAnimationRenderer
+     */
+    ~VertexAnimationRenderer();
+
+    /**
+     * @brief Kompiluje shadery i tworzy bufory
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia obiekty OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Ustawia rysowany tłum
+     * @param crowd Tłum (po zmianie instancji należy wywołać setCrowd ponownie)
+     * @param material Materiał postaci
+     */
+    void setCrowd(std::shared_ptr<VertexAnimationCrowd> crowd, MaterialId material);
+
+    /**
+     * @brief Przestaje rysować tłum
+     */
+    void clearCrowd();
+
+    /**
+     * @brief Wybiera widoczne komórki i ustawia czas klatki
+     * @param frustums Ostrosłupy wszystkich widoków
+     * @param viewPosition Pozycja kamery głównej (wybór poziomu szczegółów)
+     * @param lightList Globalna lista świateł
+     * @param time Czas globalny animacji [s]
+     */
+    void prepare(const std::vector<Frustum>& frustums, const glm::vec3& viewPosition, const glm::ivec2& lightList,
+                 float time);
+
+    /**
+     * @brief Rysuje widoczne komórki w aktywnym widoku
+     * @return Liczba wywołań rysowania
+     */
+    int draw();
+};
+
+#endif // VERTEX_ANIMATION_RENDERER_HPP
@@ -0,0 +1,459 @@
+// DynamicBatcher.cpp
+#include "DynamicBatcher.hpp"
+#include "../Transform/TransformableObject.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include "../Math/Simd.hpp"
+#include "../Stats/RenderStats.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+static_assert(sizeof(Vertex) == 8 * sizeof(float), "Simd::transformVertices wymaga wierzcholka z 8 floatow");
+
+/**
+ * @brief Konstruktor DynamicBatcher
+ */
+DynamicBatcher::DynamicBatcher()
+    : m_streamVAO(0), m_streamVBO(0), m_streamEBO(0), m_vertexCapacity(0), m_indexCapacity(0),
+      m_instanceBuffer(0), m_instanceTexture(0), m_instanceCapacity(0), m_initialized(false),
+      m_vertexThreshold(DEFAULT_VERTEX_THRESHOLD), m_autoSelect(true),
+      m_preferredMode(DynamicBatchMode::BATCHING), m_frameMode(DynamicBatchMode::BATCHING),
+      m_costPerObject{0.0, 0.0}, m_hasCost{false, false}, m_frameCostMs(0.0),
+      m_frameObjectCount(0), m_frameCounter(0) {
+}
+
+/**
+ * @brief Destruktor DynamicBatcher
+ */
+DynamicBatcher::~DynamicBatcher() {
+    release();
+}
+
+/**
+ * @brief Tworzy bufory strumieniowe
+ * @return true jeśli się powiodło
+ */
+bool DynamicBatcher::initialize() {
+    if (m_initialized) return true;
+
+    glGenVertexArrays(1, &m_streamVAO);
+    glGenBuffers(1, &m_streamVBO);
+    glGenBuffers(1, &m_streamEBO);
+    glGenBuffers(1, &m_instanceBuffer);
+    glGenTextures(1, &m_instanceTexture);
+
+    if (m_streamVAO == 0 || m_streamVBO == 0 || m_streamEBO == 0 ||
+        m_instanceBuffer == 0 || m_instanceTexture == 0) {
+        std::cerr << "Blad: Nie udalo sie utworzyc buforow dynamicznych paczek" << std::endl;
+        release();
+        return false;
+    }
+
+    glBindVertexArray(m_streamVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_streamVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_streamEBO);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    glBindVertexArray(0);
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zwalnia bufory, siatki i wpisy materiałów
+ */
+void DynamicBatcher::release() {
+    if (m_streamVAO) glDeleteVertexArrays(1, &m_streamVAO);
+    if (m_streamVBO) glDeleteBuffers(1, &m_streamVBO);
+    if (m_streamEBO) glDeleteBuffers(1, &m_streamEBO);
+    if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+    if (m_instanceTexture) glDeleteTextures(1, &m_instanceTexture);
+    m_streamVAO = 0;
+    m_streamVBO = 0;
+    m_streamEBO = 0;
+    m_instanceBuffer = 0;
+    m_instanceTexture = 0;
+    m_vertexCapacity = 0;
+    m_indexCapacity = 0;
+    m_instanceCapacity = 0;
+
+    for (auto& entry : m_meshCache) {
+        glDeleteVertexArrays(1, &entry.second.VAO);
+        glDeleteBuffers(1, &entry.second.VBO);
+        glDeleteBuffers(1, &entry.second.EBO);
+    }
+    m_meshCache.clear();
+
+    for (MaterialId id : m_materialIds) {
+        MaterialTable::instance().releaseMaterial(id);
+    }
+    m_materialIds.clear();
+    m_slotMaterials.clear();
+    m_groups.clear();
+    m_initialized = false;
+}
+
+/**
+ * @brief Wymusza tryb lub przywraca wybór automatyczny
+ * @param autoSelect true aby wybierać tryb na podstawie pomiarów
+ * @param mode Tryb używany gdy autoSelect == false
+ */
+void DynamicBatcher::setMode(bool autoSelect, DynamicBatchMode mode) {
+    m_autoSelect = autoSelect;
+    if (!autoSelect) m_preferredMode = mode;
+}
+
+/**
+ * @brief Wybiera małe obiekty ruchome
+ * @param objects Obiekty sceny do narysowania
+ * @param outRemaining Obiekty, które należy narysować zwykłą ścieżką
+ *
+ * @details Obiekty statyczne pomijane są tak samo jak duże siatki - te
+ * pierwsze, jeśli tu trafiły, zostały właśnie wyjęte ze statycznej paczki.
+ */
+void DynamicBatcher::collect(const std::vector<TransformableObject*>& objects,
+                             std::vector<TransformableObject*>& outRemaining) {
+    m_candidates.clear();
+    for (TransformableObject* object : objects) {
+        if (!object) continue;
+        const MeshData* data = m_initialized && !object->isStatic() ? object->getMeshData() : nullptr;
+        if (data && !data->indices.empty() &&
+            static_cast<int>(data->vertices.size()) <= m_vertexThreshold) {
+            m_candidates.push_back(object);
+        } else {
+            outRemaining.push_back(object);
+        }
+    }
+}
+
+/**
+ * @brief Zalicza koszt poprzedniej klatki i wybiera tryb bieżącej
+ *
+ * @details Tryb o niższym wygładzonym koszcie na obiekt staje się
+ * preferowanym. Dopóki któryś tryb nie ma pomiaru, jest wybierany jako
+ * następny; później co PROBE_INTERVAL klatek używany jest tryb przeciwny.
+ */
+void DynamicBatcher::selectFrameMode() {
+    const double smoothing = 0.1;
+    if (m_frameObjectCount > 0) {
+        int mode = static_cast<int>(m_frameMode);
+        double cost = m_frameCostMs / static_cast<double>(m_frameObjectCount);
+        m_costPerObject[mode] = m_hasCost[mode] ? m_costPerObject[mode] + smoothing * (cost - m_costPerObject[mode]) : cost;
+        m_hasCost[mode] = true;
+    }
+    m_frameCostMs = 0.0;
+    m_frameCounter++;
+
+    if (!m_autoSelect) {
+        m_frameMode = m_preferredMode;
+        return;
+    }
+
+    if (!m_hasCost[0] || !m_hasCost[1]) {
+        m_frameMode = m_hasCost[0] ? DynamicBatchMode::INSTANCING : DynamicBatchMode::BATCHING;
+        return;
+    }
+
+    m_preferredMode = m_costPerObject[1] < m_costPerObject[0] ? DynamicBatchMode::INSTANCING : DynamicBatchMode::BATCHING;
+    m_frameMode = m_preferredMode;
+    if (m_frameCounter % PROBE_INTERVAL == 0) {
+        m_frameMode = m_preferredMode == DynamicBatchMode::BATCHING ? DynamicBatchMode::INSTANCING : DynamicBatchMode::BATCHING;
+    }
+}
+
+/**
+ * @brief Przekształca wierzchołki widocznych obiektów i wysyła je do bufora strumieniowego
+ *
+ * @details Obiekty sortowane są według wartości materiału, a przesunięcia
+ * ich wierzchołków i indeksów liczone z góry, dzięki czemu wątki puli
+ * zapisują rozłączne fragmenty buforów bez synchronizacji. Macierze modelu
+ * pobierane są wcześniej w wątku głównym (macierz świata zależy od rodziców).
+ * Bufory są osierocane przed zapisem, aby nie czekać na GPU.
+ */
+void DynamicBatcher::prepareBatches() {
+    std::vector<Material> frameMaterials;
+    std::vector<size_t> objectGroup(m_visible.size());
+    for (size_t i = 0; i < m_visible.size(); ++i) {
+        const Material& material = m_visible[i]->getMaterial();
+        size_t group = 0;
+        while (group < frameMaterials.size() && !MaterialTable::isSameMaterial(frameMaterials[group], material)) {
+            group++;
+        }
+        if (group == frameMaterials.size()) frameMaterials.push_back(material);
+        objectGroup[i] = group;
+    }
+
+    // Kolejność obiektów pogrupowana według materiału i przesunięcia w buforach
+    std::vector<size_t> order;
+    order.reserve(m_visible.size());
+    for (size_t group = 0; group < frameMaterials.size(); ++group) {
+        for (size_t i = 0; i < m_visible.size(); ++i) {
+            if (objectGroup[i] == group) order.push_back(i);
+        }
+    }
+
+    std::vector<size_t> vertexOffsets(order.size());
+    std::vector<size_t> indexOffsets(order.size());
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    size_t groupStart = 0;
+    for (size_t k = 0; k < order.size(); ++k) {
+        const MeshData* data = m_visible[order[k]]->getMeshData();
+        vertexOffsets[k] = vertexCount;
+        indexOffsets[k] = indexCount;
+        vertexCount += data->vertices.size();
+        indexCount += data->indices.size();
+
+        bool lastInGroup = k + 1 == order.size() || objectGroup[order[k + 1]] != objectGroup[order[k]];
+        if (lastInGroup) {
+            size_t group = objectGroup[order[k]];
+            if (group >= m_materialIds.size()) {
+                m_materialIds.push_back(MaterialTable::instance().createMaterial(frameMaterials[group]));
+                m_slotMaterials.push_back(frameMaterials[group]);
+            } else if (!MaterialTable::isSameMaterial(m_slotMaterials[group], frameMaterials[group])) {
+                m_materialIds[group] = MaterialTable::instance().updateMaterial(m_materialIds[group], frameMaterials[group]);
+                m_slotMaterials[group] = frameMaterials[group];
+            }
+            m_groups.push_back({nullptr, m_materialIds[group], static_cast<GLsizei>(groupStart),
+                                static_cast<GLsizei>(indexCount - groupStart)});
+            groupStart = indexCount;
+        }
+    }
+
+    m_models.resize(order.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+        m_models[k] = m_visible[order[k]]->getModelMatrix();
+    }
+
+    m_vertices.resize(vertexCount);
+    m_indices.resize(indexCount);
+    ThreadPool::instance().parallelFor(order.size(), 4, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const MeshData* data = m_visible[order[k]]->getMeshData();
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(m_models[k])));
+            Simd::transformVertices(glm::value_ptr(m_models[k]), glm::value_ptr(normalMatrix),
+                                    &data->vertices[0].position.x, &m_vertices[vertexOffsets[k]].position.x,
+                                    data->vertices.size(), sizeof(Vertex) / sizeof(float));
+
+            unsigned int baseVertex = static_cast<unsigned int>(vertexOffsets[k]);
+            unsigned int* indices = &m_indices[indexOffsets[k]];
+            for (size_t i = 0; i < data->indices.size(); ++i) {
+                indices[i] = baseVertex + data->indices[i];
+            }
+        }
+    });
+
+    GLsizeiptr vertexBytes = static_cast<GLsizeiptr>(vertexCount * sizeof(Vertex));
+    GLsizeiptr indexBytes = static_cast<GLsizeiptr>(indexCount * sizeof(unsigned int));
+    if (vertexBytes > m_vertexCapacity) m_vertexCapacity = vertexBytes * 2;
+    if (indexBytes > m_indexCapacity) m_indexCapacity = indexBytes * 2;
+
+    glBindVertexArray(m_streamVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_streamVBO);
+    glBufferData(GL_ARRAY_BUFFER, m_vertexCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBytes, m_vertices.data());
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexBytes, m_indices.data());
+    glBindVertexArray(0);
+
+    RenderStats::instance().setValue("DynamicBatch/Wierzcholki", static_cast<double>(vertexCount));
+}
+
+/**
+ * @brief Zwraca bufory GPU siatki, wysyłając ją przy pierwszym użyciu
+ * @param mesh Dane siatki
+ * @return Bufory siatki
+ *
+ * @details Gdy liczba indeksów nie zgadza się z zapamiętaną (pod tym samym
+ * adresem powstała inna siatka), siatka wysyłana jest ponownie.
+ */
+const Mesh& DynamicBatcher::getCachedMesh(const MeshData* mesh) {
+    Mesh& cached = m_meshCache[mesh];
+    if (cached.VAO != 0 && cached.indexCount == static_cast<int>(mesh->indices.size())) {
+        return cached;
+    }
+
+    if (cached.VAO == 0) {
+        glGenVertexArrays(1, &cached.VAO);
+        glGenBuffers(1, &cached.VBO);
+        glGenBuffers(1, &cached.EBO);
+    }
+    cached.indexCount = static_cast<int>(mesh->indices.size());
+
+    glBindVertexArray(cached.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, cached.VBO);
+    glBufferData(GL_ARRAY_BUFFER, mesh->vertices.size() * sizeof(Vertex), mesh->vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cached.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh->indices.size() * sizeof(unsigned int), mesh->indices.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    glBindVertexArray(0);
+    return cached;
+}
+
+/**
+ * @brief Grupuje widoczne obiekty według siatki i wysyła dane instancji
+ * @param lightList Globalna lista świateł
+ *
+ * @details Dane instancji mają ten sam układ co dane obiektów
+ * MultiViewRenderer, więc shader czyta je tym samym kodem: instancja
+ * gl_InstanceID grupy zaczynającej się od objectIndex zajmuje teksele
+ * od (objectIndex + gl_InstanceID) * OBJECT_DATA_TEXELS.
+ */
+void DynamicBatcher::prepareInstances(const glm::ivec2& lightList) {
+    std::unordered_map<const MeshData*, size_t> groupByMesh;
+    std::vector<std::vector<size_t>> groups;
+    for (size_t i = 0; i < m_visible.size(); ++i) {
+        const MeshData* data = m_visible[i]->getMeshData();
+        auto it = groupByMesh.find(data);
+        if (it == groupByMesh.end()) {
+            it = groupByMesh.emplace(data, groups.size()).first;
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(i);
+    }
+
+    const int texels = MultiViewRenderer::OBJECT_DATA_TEXELS;
+    m_instanceData.resize(m_visible.size() * texels);
+    size_t instance = 0;
+    for (const auto& members : groups) {
+        const MeshData* data = m_visible[members.front()]->getMeshData();
+        getCachedMesh(data);
+        m_groups.push_back({data, INVALID_MATERIAL, static_cast<GLsizei>(instance), static_cast<GLsizei>(members.size())});
+
+        for (size_t i : members) {
+            glm::mat4 model = m_visible[i]->getModelMatrix();
+            glm::vec4* out = &m_instanceData[instance * texels];
+            out[0] = model[0];
+            out[1] = model[1];
+            out[2] = model[2];
+            out[3] = model[3];
+            out[4] = glm::vec4(static_cast<float>(lightList.x), static_cast<float>(lightList.y),
+                               static_cast<float>(m_visible[i]->getMaterialId()), 0.0f);
+            instance++;
+        }
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_instanceData.size() * sizeof(glm::vec4));
+    glBindBuffer(GL_TEXTURE_BUFFER, m_instanceBuffer);
+    if (size > m_instanceCapacity) {
+        m_instanceCapacity = size * 2;
+        glBufferData(GL_TEXTURE_BUFFER, m_instanceCapacity, nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_instanceTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_instanceBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    } else {
+        glBufferData(GL_TEXTURE_BUFFER, m_instanceCapacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, m_instanceData.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+/**
+ * @brief Odrzuca niewidoczne obiekty i przygotowuje dane klatki
+ * @param frustums Ostrosłupy wszystkich widoków
+ * @param lightList Globalna lista świateł
+ *
+ * @details Obiekt widoczny w którymkolwiek widoku rysowany jest we
+ * wszystkich - dane przygotowywane są raz na klatkę, a nadmiarowe trójkąty
+ * odrzuca GPU.
+ */
+void DynamicBatcher::prepare(const std::vector<Frustum>& frustums, const glm::ivec2& lightList) {
+    auto start = std::chrono::high_resolution_clock::now();
+    selectFrameMode();
+    m_groups.clear();
+    m_visible.clear();
+
+    for (TransformableObject* object : m_candidates) {
+        BoundingSphere sphere = object->getWorldBounds();
+        for (const Frustum& frustum : frustums) {
+            if (frustum.intersects(sphere)) {
+                m_visible.push_back(object);
+                break;
+            }
+        }
+    }
+    m_frameObjectCount = m_visible.size();
+
+    if (!m_visible.empty()) {
+        if (m_frameMode == DynamicBatchMode::BATCHING) {
+            prepareBatches();
+        } else {
+            prepareInstances(lightList);
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_frameCostMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("DynamicBatch/Kandydaci", static_cast<double>(m_candidates.size()));
+    stats.setValue("DynamicBatch/Obiekty", static_cast<double>(m_visible.size()));
+    stats.setValue("DynamicBatch/Tryb (0 = scalanie, 1 = instancje)", static_cast<double>(m_frameMode));
+    stats.setValue("DynamicBatch/Koszt scalania na obiekt [us]", m_costPerObject[0] * 1000.0);
+    stats.setValue("DynamicBatch/Koszt instancji na obiekt [us]", m_costPerObject[1] * 1000.0);
+    stats.setValue("DynamicBatch/Wywolania rysowania", 0.0);
+}
+
+/**
+ * @brief Rysuje przygotowane grupy
+ * @param program Aktywny program shaderowy
+ * @return Liczba wywołań rysowania
+ */
+int DynamicBatcher::draw(GLuint program) {
+    if (m_groups.empty()) return 0;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    GLint materialIndexLoc = glGetUniformLocation(program, "materialIndex");
+    if (m_frameMode == DynamicBatchMode::BATCHING) {
+        glm::mat4 identity(1.0f);
+        glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, glm::value_ptr(identity));
+        glUniform3f(glGetUniformLocation(program, "objectColor"), 1.0f, 1.0f, 1.0f);
+
+        glBindVertexArray(m_streamVAO);
+        for (const DrawGroup& group : m_groups) {
+            glUniform1i(materialIndexLoc, group.materialId);
+            glDrawElements(GL_TRIANGLES, group.count, GL_UNSIGNED_INT,
+                           (void*)(static_cast<size_t>(group.first) * sizeof(unsigned int)));
+        }
+        glUniform1i(materialIndexLoc, MaterialTable::DEFAULT_MATERIAL);
+    } else {
+        GLint useObjectDataLoc = glGetUniformLocation(program, "useObjectData");
+        GLint objectIndexLoc = glGetUniformLocation(program, "objectIndex");
+
+        glActiveTexture(GL_TEXTURE0 + MultiViewRenderer::OBJECT_DATA_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, m_instanceTexture);
+        glActiveTexture(GL_TEXTURE0);
+        glUniform1i(useObjectDataLoc, 1);
+
+        for (const DrawGroup& group : m_groups) {
+            const Mesh& mesh = m_meshCache[group.mesh];
+            glUniform1i(objectIndexLoc, group.first);
+            glBindVertexArray(mesh.VAO);
+            glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0, group.count);
+        }
+        glUniform1i(objectIndexLoc, 0);
+        glUniform1i(useObjectDataLoc, 0);
+    }
+    glBindVertexArray(0);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_frameCostMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+    int draws = static_cast<int>(m_groups.size());
+    RenderStats::instance().addValue("DynamicBatch/Wywolania rysowania", draws);
+    return draws;
+}
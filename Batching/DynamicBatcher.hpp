@@ -0,0 +1,181 @@
+// DynamicBatcher.hpp
+#ifndef DYNAMIC_BATCHER_HPP
+#define DYNAMIC_BATCHER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Math/Bounds.hpp"
+
+class TransformableObject;
+
+/**
+ * @enum DynamicBatchMode
+ * @brief Sposób rysowania małych ruchomych obiektów
+ */
+enum class DynamicBatchMode {
+    BATCHING,   /**< Wierzchołki przekształcane na CPU i scalane w bufor strumieniowy */
+    INSTANCING  /**< Jedna siatka rysowana wiele razy z danymi obiektów w buforze tekstury */
+};
+
+/**
+ * @class DynamicBatcher
+ * @brief Łączenie małych ruchomych obiektów w kilka wywołań rysowania
+ *
+ * Dla obiektów o niewielkiej liczbie wierzchołków koszt wywołania rysowania
+ * przewyższa koszt samej geometrii. Co klatkę:
+ * - collect() wybiera obiekty niestatyczne o siatce nie większej niż próg,
+ * - prepare() odrzuca obiekty niewidoczne w żadnym widoku i przygotowuje
+ *   dane w jednym z dwóch trybów:
+ *   - BATCHING: wierzchołki przekształcane są na CPU (SIMD, na wątkach puli)
+ *     do bufora strumieniowego, a każda grupa o wspólnym materiale rysowana
+ *     jest jednym glDrawElements z własnym odwołaniem do MaterialTable,
+ *   - INSTANCING: dla każdej siatki jedno glDrawElementsInstanced, macierz
+ *     modelu i materiał z bufora tekstury "objectData",
+ * - draw() rysuje przygotowane grupy w aktywnym widoku.
+ *
+ * Tryb wybierany jest automatycznie na podstawie zmierzonego czasu CPU
+ * (przygotowanie + wysłanie poleceń) na obiekt, wygładzonego średnią
+ * wykładniczą. Co PROBE_INTERVAL klatek przez jedną klatkę używany jest
+ * tryb przeciwny, aby jego pomiar nie przedawnił się.
+ *
+ * Obiekty z paczek oświetlane są globalną listą świateł.
+ */
+class DynamicBatcher {
+public:
+    static const int DEFAULT_VERTEX_THRESHOLD = 300;    /**< Domyślny próg liczby wierzchołków siatki */
+    static const int PROBE_INTERVAL = 120;              /**< Co ile klatek mierzony jest tryb nieaktywny */
+
+private:
+    /**
+     * @struct DrawGroup
+     * @brief Zakres danych rysowany jednym wywołaniem
+     */
+    struct DrawGroup {
+        const MeshData* mesh;   /**< Siatka (tylko INSTANCING) */
+        MaterialId materialId;  /**< Wpis materiału grupy (tylko BATCHING) */
+        GLsizei first;          /**< Pierwszy indeks (BATCHING) lub pierwsza instancja (INSTANCING) */
+        GLsizei count;          /**< Liczba indeksów (BATCHING) lub instancji (INSTANCING) */
+    };
+
+    std::vector<TransformableObject*> m_candidates;     /**< Obiekty wybrane w collect() */
+    std::vector<TransformableObject*> m_visible;        /**< Kandydaci widoczni w którymś widoku */
+    std::vector<DrawGroup> m_groups;                    /**< Grupy bieżącej klatki */
+    std::vector<Material> m_slotMaterials;              /**< Materiały zapisane we wpisach m_materialIds */
+    std::vector<MaterialId> m_materialIds;              /**< Wpisy MaterialTable używane przez grupy trybu BATCHING */
+    std::vector<Vertex> m_vertices;                     /**< Przekształcone wierzchołki */
+    std::vector<unsigned int> m_indices;                /**< Indeksy scalonych siatek */
+    std::vector<glm::vec4> m_instanceData;              /**< Dane instancji (układ jak w MultiViewRenderer) */
+    std::unordered_map<const MeshData*, Mesh> m_meshCache; /**< Siatki wysłane do GPU dla instancjonowania */
+    std::vector<glm::mat4> m_models;                    /**< Macierze modelu widocznych obiektów */
+
+    GLuint m_streamVAO;             /**< VAO bufora strumieniowego */
+    GLuint m_streamVBO;             /**< Bufor strumieniowy wierzchołków */
+    GLuint m_streamEBO;             /**< Bufor strumieniowy indeksów */
+    GLsizeiptr m_vertexCapacity;    /**< Pojemność bufora wierzchołków w bajtach */
+    GLsizeiptr m_indexCapacity;     /**< Pojemność bufora indeksów w bajtach */
+    GLuint m_instanceBuffer;        /**< Bufor danych instancji */
+    GLuint m_instanceTexture;       /**< Tekstura buforowa nad m_instanceBuffer */
+    GLsizeiptr m_instanceCapacity;  /**< Pojemność bufora instancji w bajtach */
+    bool m_initialized;             /**< Czy obiekty OpenGL zostały utworzone */
+
+    int m_vertexThreshold;          /**< Maksymalna liczba wierzchołków siatki kandydata */
+    bool m_autoSelect;              /**< Czy tryb wybierany jest automatycznie */
+    DynamicBatchMode m_preferredMode;   /**< Tryb o niższym zmierzonym koszcie (lub wymuszony) */
+    DynamicBatchMode m_frameMode;   /**< Tryb użyty w bieżącej klatce */
+    double m_costPerObject[2];      /**< Wygładzony koszt CPU na obiekt [ms] dla każdego trybu */
+    bool m_hasCost[2];              /**< Czy tryb ma już pomiar */
+    double m_frameCostMs;           /**< Koszt bieżącej klatki [ms] */
+    size_t m_frameObjectCount;      /**< Liczba obiektów w bieżącej klatce */
+    int m_frameCounter;             /**< Licznik klatek do próbkowania */
+
+    /**
+     * @brief Przekształca wierzchołki widocznych obiektów i wysyła je do bufora strumieniowego
+     */
+    void prepareBatches();
+
+    /**
+     * @brief Grupuje widoczne obiekty według siatki i wysyła dane instancji
+     * @param lightList Globalna lista świateł
+     */
+    void prepareInstances(const glm::ivec2& lightList);
+
+    /**
+     * @brief Zwraca bufory GPU siatki, wysyłając ją przy pierwszym użyciu
+     * @param mesh Dane siatki
+     * @return Bufory siatki
+     */
+    const Mesh& getCachedMesh(const MeshData* mesh);
+
+    /**
+     * @brief Zalicza koszt poprzedniej klatki i wybiera tryb bieżącej
+     */
+    void selectFrameMode();
+
+public:
+    /**
+     * @brief Konstruktor DynamicBatcher
+     */
+    DynamicBatcher();
+
+    /**
+     * @brief Destruktor DynamicBatcher
+     */
+    ~DynamicBatcher();
+
+    /**
+     * @brief Tworzy bufory strumieniowe
+     * @return true jeśli się powiodło
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia bufory, siatki i wpisy materiałów
+     */
+    void release();
+
+    /**
+     * @brief Ustawia próg liczby wierzchołków
+     * @param vertices Maksymalna liczba wierzchołków siatki łączonego obiektu
+     */
+    void setVertexThreshold(int vertices) { m_vertexThreshold = vertices; }
+
+    /**
+     * @brief Wymusza tryb lub przywraca wybór automatyczny
+     * @param autoSelect true aby wybierać tryb na podstawie pomiarów
+     * @param mode Tryb używany gdy autoSelect == false
+     */
+    void setMode(bool autoSelect, DynamicBatchMode mode = DynamicBatchMode::BATCHING);
+
+    /**
+     * @brief Wybiera małe obiekty ruchome
+     * @param objects Obiekty sceny do narysowania
+     * @param outRemaining Obiekty, które należy narysować zwykłą ścieżką
+     */
+    void collect(const std::vector<TransformableObject*>& objects, std::vector<TransformableObject*>& outRemaining);
+
+    /**
+     * @brief Odrzuca niewidoczne obiekty i przygotowuje dane klatki
+     * @param frustums Ostrosłupy wszystkich widoków
+     * @param lightList Globalna lista świateł
+     */
+    void prepare(const std::vector<Frustum>& frustums, const glm::ivec2& lightList);
+
+    /**
+     * @brief Rysuje przygotowane grupy
+     * @param program Aktywny program shaderowy
+     * @return Liczba wywołań rysowania
+     */
+    int draw(GLuint program);
+
+    /**
+     * @brief Zwraca tryb użyty w bieżącej klatce
+     * @return Tryb
+     */
+    DynamicBatchMode getFrameMode() const { return m_frameMode; }
+};
+
+#endif // DYNAMIC_BATCHER_HPP
@@ -0,0 +1,387 @@
+// HlodTree.cpp
+#include "HlodTree.hpp"
+#include "../Mesh/LodChain.hpp"
+#include "../Mesh/MeshSimplifier.hpp"
+#include "../Stats/RenderStats.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+/**
+ * @brief Zwraca komórkę poziomu wyższego zawierającą daną komórkę
+ * @param cell Komórka
+ * @return Komórka rodzica (dzielenie przez 2 z zaokrągleniem w dół)
+ */
+static glm::ivec3 parentCell(const glm::ivec3& cell) {
+    return glm::ivec3(cell.x >> 1, cell.y >> 1, cell.z >> 1);
+}
+
+/**
+ * @brief Dołącza siatkę do siatki scalonej
+ * @param target Siatka scalona
+ * @param source Dołączana siatka
+ * @param paletteCoord Współrzędna palety wpisywana wierzchołkom (ujemna = bez zmian)
+ */
+static void appendMesh(MeshData& target, const MeshData& source, float paletteCoord) {
+    unsigned int baseVertex = static_cast<unsigned int>(target.vertices.size());
+    for (Vertex vertex : source.vertices) {
+        if (paletteCoord >= 0.0f) vertex.texCoord = glm::vec2(paletteCoord, 0.5f);
+        target.vertices.push_back(vertex);
+    }
+    for (unsigned int index : source.indices) {
+        target.indices.push_back(baseVertex + index);
+    }
+}
+
+/**
+ * @brief Wysyła siatkę do nowych buforów GPU
+ * @param mesh Bufory do utworzenia
+ * @param data Dane siatki
+ */
+static void uploadProxy(Mesh& mesh, const MeshData& data) {
+    mesh.indexCount = static_cast<int>(data.indices.size());
+    glGenVertexArrays(1, &mesh.VAO);
+    glGenBuffers(1, &mesh.VBO);
+    glGenBuffers(1, &mesh.EBO);
+
+    glBindVertexArray(mesh.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(Vertex), data.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(unsigned int), data.indices.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Konstruktor HlodTree
+ */
+HlodTree::HlodTree()
+    : m_paletteMaterial(INVALID_MATERIAL), m_paletteTexture(0), m_proxyTriangles(0), m_buildMs(0.0) {
+}
+
+/**
+ * @brief Destruktor HlodTree
+ */
+HlodTree::~HlodTree() {
+    release();
+}
+
+/**
+ * @brief Usuwa węzły, paletę i materiały drzewa
+ */
+void HlodTree::release() {
+    for (Node& node : m_nodes) {
+        if (node.proxy.VAO) {
+            glDeleteVertexArrays(1, &node.proxy.VAO);
+            glDeleteBuffers(1, &node.proxy.VBO);
+            glDeleteBuffers(1, &node.proxy.EBO);
+        }
+    }
+    m_nodes.clear();
+    m_roots.clear();
+    m_nodeByCell.clear();
+
+    MaterialTable& table = MaterialTable::instance();
+    for (MaterialId id : m_materialIds) {
+        table.releaseMaterial(id);
+    }
+    if (m_paletteMaterial != INVALID_MATERIAL) table.releaseMaterial(m_paletteMaterial);
+    m_materials.clear();
+    m_materialIds.clear();
+    m_paletteMaterial = INVALID_MATERIAL;
+
+    if (m_paletteTexture) glDeleteTextures(1, &m_paletteTexture);
+    m_paletteTexture = 0;
+    m_proxyTriangles = 0;
+}
+
+/**
+ * @brief Buduje drzewo i siatki zastępcze (usuwa poprzednie)
+ * @param sources Paczki statyczne
+ *
+ * @details Budowa przebiega poziomami od liści. Siatka zastępcza węzła
+ * upraszczana jest do PROXY_REDUCTION trójkątów źródła, z błędem kroku
+ * względnym do rozmiaru komórki - wyższe poziomy mogą więc gubić coraz
+ * większe szczegóły. Rodzic budowany jest z siatek zastępczych dzieci,
+ * dzięki czemu koszt każdego poziomu maleje geometrycznie. Budowa kończy
+ * się, gdy poziom ma jeden węzeł albo osiągnięto MAX_LEVELS.
+ *
+ * Materiał palety (dla węzłów z kilkoma materiałami) ma rozproszenie równe
+ * 1 (kolor pochodzi z palety), a stosunek otoczenia do rozproszenia,
+ * odbicie i połysk uśrednione po materiałach drzewa.
+ */
+void HlodTree::build(const std::vector<HlodSource>& sources) {
+    release();
+    if (sources.empty()) return;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Materiały drzewa i ich położenie w palecie
+    std::vector<size_t> sourceMaterial(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        size_t index = 0;
+        while (index < m_materials.size() && !MaterialTable::isSameMaterial(m_materials[index], sources[i].material)) {
+            index++;
+        }
+        if (index == m_materials.size()) m_materials.push_back(sources[i].material);
+        sourceMaterial[i] = index;
+    }
+
+    MaterialTable& table = MaterialTable::instance();
+    for (const Material& material : m_materials) {
+        m_materialIds.push_back(table.createMaterial(material));
+    }
+
+    if (m_materials.size() > 1) {
+        Material palette = {glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(0.0f), 0.0f};
+        std::vector<glm::vec3> colors;
+        for (const Material& material : m_materials) {
+            palette.ambient += glm::min(material.ambient / glm::max(material.diffuse, glm::vec3(0.001f)), glm::vec3(4.0f));
+            palette.specular += material.specular;
+            palette.shininess += material.shininess;
+            colors.push_back(material.diffuse);
+        }
+        float count = static_cast<float>(m_materials.size());
+        palette.ambient /= count;
+        palette.specular /= count;
+        palette.shininess /= count;
+        m_paletteMaterial = table.createMaterial(palette);
+
+        glGenTextures(1, &m_paletteTexture);
+        glBindTexture(GL_TEXTURE_2D, m_paletteTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, static_cast<GLsizei>(colors.size()), 1, 0, GL_RGB, GL_FLOAT, colors.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    // Dane CPU węzłów potrzebne tylko w trakcie budowy
+    std::vector<MeshData> proxyData;
+    std::vector<int> nodeMaterial;  // indeks materiału lub -1 gdy węzeł ma kilka materiałów
+
+    auto addNode = [&](int level, const glm::ivec3& cell) {
+        Node node;
+        node.level = level;
+        node.cell = cell;
+        node.bounds = {glm::vec3(0.0f), 0.0f};
+        node.proxy = {0, 0, 0, 0};
+        node.materialId = INVALID_MATERIAL;
+        node.usesPalette = false;
+        node.errors = {0.0f, 0.0f};
+        node.objectCount = 0;
+        node.valid = true;
+        m_nodeByCell[std::make_tuple(level, cell.x, cell.y, cell.z)] = m_nodes.size();
+        m_nodes.push_back(node);
+        proxyData.emplace_back();
+        nodeMaterial.push_back(-2);
+        return m_nodes.size() - 1;
+    };
+
+    auto mergeMaterial = [&](size_t node, int material) {
+        if (nodeMaterial[node] == -2) nodeMaterial[node] = material;
+        else if (nodeMaterial[node] != material) nodeMaterial[node] = -1;
+    };
+
+    // Upraszcza scaloną siatkę węzła i zapisuje błąd
+    auto simplifyNode = [&](size_t index, float sourceError) {
+        MeshData& data = proxyData[index];
+        size_t triangles = data.indices.size() / 3;
+        float stepError = 0.0f;
+        if (triangles > MIN_PROXY_TRIANGLES) {
+            SimplifyOptions options;
+            options.targetTriangleCount = std::max(MIN_PROXY_TRIANGLES, static_cast<size_t>(triangles * PROXY_REDUCTION));
+            options.targetError = MAX_STEP_ERROR;
+            float extent = MeshSimplifier::computeExtent(data);
+            MeshData simplified = MeshSimplifier::simplify(data, options, &stepError);
+            if (!simplified.indices.empty()) {
+                data = std::move(simplified);
+                stepError *= extent;
+            } else {
+                stepError = 0.0f;
+            }
+        }
+        m_nodes[index].errors[1] = sourceError + stepError;
+    };
+
+    // Liście: komórki StaticBatcher
+    std::vector<size_t> levelNodes;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const HlodSource& source = sources[i];
+        auto it = m_nodeByCell.find(std::make_tuple(0, source.chunk.x, source.chunk.y, source.chunk.z));
+        size_t index = it != m_nodeByCell.end() ? it->second : addNode(0, source.chunk);
+        if (it == m_nodeByCell.end()) levelNodes.push_back(index);
+
+        Node& node = m_nodes[index];
+        node.batches.push_back(source.batch);
+        node.objectCount += source.objectCount;
+        float paletteCoord = (static_cast<float>(sourceMaterial[i]) + 0.5f) / static_cast<float>(m_materials.size());
+        if (source.mesh) appendMesh(proxyData[index], *source.mesh, paletteCoord);
+        mergeMaterial(index, static_cast<int>(sourceMaterial[i]));
+    }
+    for (size_t index : levelNodes) {
+        simplifyNode(index, 0.0f);
+    }
+
+    // Kolejne poziomy: 2 x 2 x 2 komórki poziomu niższego
+    for (int level = 1; level < MAX_LEVELS && levelNodes.size() > 1; ++level) {
+        std::vector<size_t> parents;
+        for (size_t child : levelNodes) {
+            glm::ivec3 cell = parentCell(m_nodes[child].cell);
+            auto it = m_nodeByCell.find(std::make_tuple(level, cell.x, cell.y, cell.z));
+            size_t index = it != m_nodeByCell.end() ? it->second : addNode(level, cell);
+            if (it == m_nodeByCell.end()) parents.push_back(index);
+
+            m_nodes[index].children.push_back(child);
+            m_nodes[index].objectCount += m_nodes[child].objectCount;
+            appendMesh(proxyData[index], proxyData[child], -1.0f);
+            mergeMaterial(index, nodeMaterial[child]);
+        }
+        for (size_t index : parents) {
+            float childError = 0.0f;
+            for (size_t child : m_nodes[index].children) {
+                childError = std::max(childError, m_nodes[child].errors[1]);
+            }
+            simplifyNode(index, childError);
+        }
+        levelNodes.swap(parents);
+    }
+    m_roots = levelNodes;
+
+    // Bufory GPU siatek zastępczych
+    for (size_t index = 0; index < m_nodes.size(); ++index) {
+        Node& node = m_nodes[index];
+        const MeshData& data = proxyData[index];
+        BoundingBox box = BoundingBox::empty();
+        for (const Vertex& vertex : data.vertices) {
+            box.expand(vertex.position);
+        }
+        node.bounds = {box.getCenter(), box.isEmpty() ? 0.0f : glm::length(box.getExtents())};
+        node.usesPalette = nodeMaterial[index] < 0;
+        node.materialId = node.usesPalette ? m_paletteMaterial : m_materialIds[nodeMaterial[index]];
+        if (!data.indices.empty()) uploadProxy(node.proxy, data);
+        m_proxyTriangles += data.indices.size() / 3;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_buildMs = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << "HLOD: " << sources.size() << " paczek -> " << m_nodes.size() << " wezlow, "
+              << m_roots.size() << " korzeni, " << m_buildMs << " ms" << std::endl;
+}
+
+/**
+ * @brief Wyłącza siatki zastępcze komórki i jej przodków
+ * @param chunk Komórka paczki, która się zmieniła
+ *
+ * @details Komórka rysowana jest dalej paczkami (także z daleka) aż do
+ * ponownego zbudowania drzewa.
+ */
+void HlodTree::invalidate(const glm::ivec3& chunk) {
+    glm::ivec3 cell = chunk;
+    for (int level = 0; level < MAX_LEVELS; ++level) {
+        auto it = m_nodeByCell.find(std::make_tuple(level, cell.x, cell.y, cell.z));
+        if (it == m_nodeByCell.end()) break;
+        m_nodes[it->second].valid = false;
+        cell = parentCell(cell);
+    }
+}
+
+/**
+ * @brief Uwzględnia usunięcie paczek w StaticBatcher
+ * @param newIndex Nowy indeks każdej paczki (SIZE_MAX = usunięta)
+ */
+void HlodTree::remapBatches(const std::vector<size_t>& newIndex) {
+    for (Node& node : m_nodes) {
+        size_t kept = 0;
+        for (size_t batch : node.batches) {
+            if (batch < newIndex.size() && newIndex[batch] != SIZE_MAX) node.batches[kept++] = newIndex[batch];
+        }
+        node.batches.resize(kept);
+    }
+}
+
+/**
+ * @brief Przechodzi węzeł i rysuje siatki zastępcze lub zbiera paczki
+ * @param index Indeks węzła
+ * @param frustum Ostrosłup widoku
+ * @param materialIndexLoc Lokalizacja uniformu materiału
+ * @param useTextureLoc Lokalizacja uniformu tekstury
+ * @param outBatches Paczki do narysowania osobno
+ * @param proxyObjects Licznik obiektów zastąpionych siatkami zastępczymi
+ * @return Liczba wywołań rysowania
+ */
+int HlodTree::drawNode(size_t index, const Frustum& frustum, GLint materialIndexLoc, GLint useTextureLoc,
+                       std::vector<size_t>& outBatches, size_t& proxyObjects) const {
+    const Node& node = m_nodes[index];
+    if (!frustum.intersects(node.bounds)) return 0;
+
+    if (node.valid && node.proxy.indexCount > 0 && LodSelector::instance().select(node.errors, node.bounds, 1.0f) == 1) {
+        glUniform1i(materialIndexLoc, node.materialId);
+        glUniform1i(useTextureLoc, node.usesPalette ? 1 : 0);
+        glBindVertexArray(node.proxy.VAO);
+        glDrawElements(GL_TRIANGLES, node.proxy.indexCount, GL_UNSIGNED_INT, 0);
+        proxyObjects += node.objectCount;
+        return 1;
+    }
+
+    outBatches.insert(outBatches.end(), node.batches.begin(), node.batches.end());
+    int draws = 0;
+    for (size_t child : node.children) {
+        draws += drawNode(child, frustum, materialIndexLoc, useTextureLoc, outBatches, proxyObjects);
+    }
+    return draws;
+}
+
+/**
+ * @brief Rysuje widoczne siatki zastępcze i wybiera paczki do narysowania osobno
+ * @param frustum Ostrosłup widoku
+ * @param program Aktywny program shaderowy
+ * @param outBatches Paczki komórek, których siatki zastępcze są zbyt mało dokładne
+ * @param outProxyObjects Liczba obiektów zastąpionych siatkami zastępczymi
+ * @return Liczba wywołań rysowania
+ *
+ * @details Wybór korzysta z widoku ustawionego w LodSelector, więc musi
+ * nastąpić po LodSelector::setView() bieżącego widoku. Macierz modelu
+ * i kolor obiektu ustawia wywołujący (jak dla paczek); uniform "useTexture"
+ * jest przywracany.
+ */
+int HlodTree::draw(const Frustum& frustum, GLuint program, std::vector<size_t>& outBatches, size_t& outProxyObjects) const {
+    outProxyObjects = 0;
+    if (m_nodes.empty()) return 0;
+
+    GLint materialIndexLoc = glGetUniformLocation(program, "materialIndex");
+    GLint useTextureLoc = glGetUniformLocation(program, "useTexture");
+    GLint previousUseTexture = 0;
+    if (useTextureLoc >= 0) glGetUniformiv(program, useTextureLoc, &previousUseTexture);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_paletteTexture);
+
+    int draws = 0;
+    for (size_t root : m_roots) {
+        draws += drawNode(root, frustum, materialIndexLoc, useTextureLoc, outBatches, outProxyObjects);
+    }
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUniform1i(useTextureLoc, previousUseTexture);
+    glUniform1i(materialIndexLoc, MaterialTable::DEFAULT_MATERIAL);
+
+    RenderStats& stats = RenderStats::instance();
+    stats.addValue("HLOD/Siatki zastepcze", draws);
+    stats.addValue("HLOD/Obiekty zastapione", static_cast<double>(outProxyObjects));
+    stats.setValue("HLOD/Wezly", static_cast<double>(m_nodes.size()));
+    stats.setValue("HLOD/Trojkaty siatek zastepczych", static_cast<double>(m_proxyTriangles));
+    stats.setValue("HLOD/Budowa [ms]", m_buildMs);
+    return draws;
+}
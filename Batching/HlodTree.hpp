@@ -0,0 +1,153 @@
+// HlodTree.hpp
+#ifndef HLOD_TREE_HPP
+#define HLOD_TREE_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <map>
+#include <tuple>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @struct HlodSource
+ * @brief Paczka statyczna przekazywana do budowy drzewa HLOD
+ */
+struct HlodSource {
+    size_t batch;               /**< Indeks paczki w StaticBatcher */
+    glm::ivec3 chunk;           /**< Komórka przestrzeni paczki */
+    const MeshData* mesh;       /**< Scalona siatka paczki w przestrzeni świata */
+    Material material;          /**< Materiał paczki */
+    size_t objectCount;         /**< Liczba obiektów w paczce */
+};
+
+/**
+ * @class HlodTree
+ * @brief Hierarchiczne poziomy szczegółowości grup obiektów statycznych
+ *
+ * Liście drzewa to komórki StaticBatcher; każdy wyższy poziom łączy
+ * 2 x 2 x 2 komórki poprzedniego. Każdy węzeł ma siatkę zastępczą:
+ * scalone siatki całej komórki uproszczone QEM (liść z paczek, rodzic
+ * z siatek zastępczych dzieci), z błędem będącym sumą błędów kroków.
+ *
+ * Materiał jest wypalany: węzeł z jednym materiałem używa go bez zmian,
+ * a w węźle z kilkoma materiałami współrzędne tekstury wierzchołków
+ * wskazują kolor rozproszenia w palecie (tekstura 1D wszystkich
+ * materiałów drzewa), więc całą komórkę rysuje jedno wywołanie.
+ *
+ * Przy rysowaniu drzewo przechodzone jest od korzeni: węzeł poza
+ * ostrosłupem jest pomijany, węzeł, którego błąd rzutowany na ekran
+ * (LodSelector) mieści się w progu, rysowany jest siatką zastępczą,
+ * a pozostałe schodzą do dzieci - w liściu do paczek. Liczba wywołań
+ * zależy więc od rozdzielczości ekranu, a nie od liczby obiektów.
+ */
+class HlodTree {
+public:
+    static const int MAX_LEVELS = 6;                /**< Największa liczba poziomów (łącznie z liśćmi) */
+    static constexpr float PROXY_REDUCTION = 0.25f; /**< Docelowy stosunek trójkątów siatki zastępczej do źródła */
+    static const size_t MIN_PROXY_TRIANGLES = 64;   /**< Poniżej tej liczby trójkątów siatka nie jest upraszczana */
+    static constexpr float MAX_STEP_ERROR = 0.05f;  /**< Największy błąd względny jednego kroku upraszczania */
+
+private:
+    /**
+     * @struct Node
+     * @brief Komórka jednego poziomu drzewa z siatką zastępczą
+     */
+    struct Node {
+        int level;                      /**< Poziom (0 = liść) */
+        glm::ivec3 cell;                /**< Komórka na swoim poziomie */
+        std::vector<size_t> children;   /**< Węzły poziomu niższego */
+        std::vector<size_t> batches;    /**< Paczki liścia */
+        BoundingSphere bounds;          /**< Sfera otaczająca komórkę */
+        Mesh proxy;                     /**< Bufory GPU siatki zastępczej */
+        MaterialId materialId;          /**< Materiał siatki zastępczej */
+        bool usesPalette;               /**< Czy kolor pochodzi z palety */
+        std::vector<float> errors;      /**< Błędy dla LodSelector: {0, błąd siatki zastępczej} */
+        size_t objectCount;             /**< Liczba obiektów w komórce */
+        bool valid;                     /**< Czy siatka zastępcza odpowiada paczkom */
+    };
+
+    std::vector<Node> m_nodes;                                      /**< Węzły wszystkich poziomów */
+    std::vector<size_t> m_roots;                                    /**< Węzły najwyższego poziomu */
+    std::map<std::tuple<int, int, int, int>, size_t> m_nodeByCell;  /**< (poziom, komórka) -> węzeł */
+    std::vector<Material> m_materials;                              /**< Materiały drzewa (kolejność palety) */
+    std::vector<MaterialId> m_materialIds;                          /**< Wpisy materiałów drzewa */
+    MaterialId m_paletteMaterial;                                   /**< Materiał siatek z paletą */
+    GLuint m_paletteTexture;                                        /**< Paleta kolorów rozproszenia */
+    size_t m_proxyTriangles;                                        /**< Łączna liczba trójkątów siatek zastępczych */
+    double m_buildMs;                                               /**< Czas budowy drzewa [ms] */
+
+    /**
+     * @brief Przechodzi węzeł i rysuje siatki zastępcze lub zbiera paczki
+     * @param index Indeks węzła
+     * @param frustum Ostrosłup widoku
+     * @param materialIndexLoc Lokalizacja uniformu materiału
+     * @param useTextureLoc Lokalizacja uniformu tekstury
+     * @param outBatches Paczki do narysowania osobno
+     * @param proxyObjects Licznik obiektów zastąpionych siatkami zastępczymi
+     * @return Liczba wywołań rysowania
+     */
+    int drawNode(size_t index, const Frustum& frustum, GLint materialIndexLoc, GLint useTextureLoc,
+                 std::vector<size_t>& outBatches, size_t& proxyObjects) const;
+
+public:
+    /**
+     * @brief Konstruktor HlodTree
+     */
+    HlodTree();
+
+    /**
+     * @brief Destruktor HlodTree
+     */
+    ~HlodTree();
+
+    /**
+     * @brief Buduje drzewo i siatki zastępcze (usuwa poprzednie)
+     * @param sources Paczki statyczne
+     */
+    void build(const std::vector<HlodSource>& sources);
+
+    /**
+     * @brief Usuwa węzły, paletę i materiały drzewa
+     */
+    void release();
+
+    /**
+     * @brief Wyłącza siatki zastępcze komórki i jej przodków
+     * @param chunk Komórka paczki, która się zmieniła
+     */
+    void invalidate(const glm::ivec3& chunk);
+
+    /**
+     * @brief Uwzględnia usunięcie paczek w StaticBatcher
+     * @param newIndex Nowy indeks każdej paczki (SIZE_MAX = usunięta)
+     */
+    void remapBatches(const std::vector<size_t>& newIndex);
+
+    /**
+     * @brief Rysuje widoczne siatki zastępcze i wybiera paczki do narysowania osobno
+     * @param frustum Ostrosłup widoku
+     * @param program Aktywny program shaderowy
+     * @param outBatches Paczki komórek, których siatki zastępcze są zbyt mało dokładne
+     * @param outProxyObjects Liczba obiektów zastąpionych siatkami zastępczymi
+     * @return Liczba wywołań rysowania
+     */
+    int draw(const Frustum& frustum, GLuint program, std::vector<size_t>& outBatches, size_t& outProxyObjects) const;
+
+    /**
+     * @brief Sprawdza, czy drzewo jest zbudowane
+     * @return true jeśli drzewo ma węzły
+     */
+    bool isEmpty() const { return m_nodes.empty(); }
+
+    /**
+     * @brief Zwraca liczbę węzłów
+     * @return Liczba węzłów wszystkich poziomów
+     */
+    int getNodeCount() const { return static_cast<int>(m_nodes.size()); }
+};
+
+#endif // HLOD_TREE_HPP
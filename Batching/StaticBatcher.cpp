@@ -0,0 +1,334 @@
+// StaticBatcher.cpp
+#include "StaticBatcher.hpp"
+#include "../Transform/TransformableObject.hpp"
+#include "../Stats/RenderStats.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <unordered_set>
+
+/**
+ * @brief Konstruktor StaticBatcher
+ */
+StaticBatcher::StaticBatcher() : m_unbatchedCount(0) {
+}
+
+/**
+ * @brief Destruktor StaticBatcher
+ */
+StaticBatcher::~StaticBatcher() {
+    release();
+}
+
+/**
+ * @brief Zwalnia bufory GPU i materiał paczki
+ * @param batch Paczka
+ */
+void StaticBatcher::releaseBatch(StaticBatch& batch) {
+    if (batch.mesh.VAO) {
+        glDeleteVertexArrays(1, &batch.mesh.VAO);
+        glDeleteBuffers(1, &batch.mesh.VBO);
+        glDeleteBuffers(1, &batch.mesh.EBO);
+    }
+    batch.mesh = {0, 0, 0, 0};
+    MaterialTable::instance().releaseMaterial(batch.materialId);
+    batch.materialId = INVALID_MATERIAL;
+}
+
+/**
+ * @brief Usuwa wszystkie paczki i zwalnia bufory
+ */
+void StaticBatcher::release() {
+    for (auto& batch : m_batches) {
+        releaseBatch(batch);
+    }
+    m_batches.clear();
+    m_memberBatch.clear();
+    m_hlod.release();
+}
+
+/**
+ * @brief Odtwarza mapę obiekt -> paczka po usunięciu paczek
+ */
+void StaticBatcher::rebuildMemberMap() {
+    m_memberBatch.clear();
+    for (size_t i = 0; i < m_batches.size(); ++i) {
+        for (const auto& member : m_batches[i].members) {
+            m_memberBatch[member.object] = i;
+        }
+    }
+}
+
+/**
+ * @brief Scala siatki członków paczki w przestrzeni świata
+ * @param batch Paczka
+ * @return Scalona siatka
+ *
+ * @details Pozycje przekształcane są macierzą modelu, a normalne macierzą
+ * odwrotną transponowaną (poprawną także dla skali niejednorodnej).
+ * Indeksy każdej siatki przesuwane są o liczbę wierzchołków już scalonych.
+ */
+MeshData StaticBatcher::mergeBatch(const StaticBatch& batch) const {
+    MeshData merged;
+    std::vector<Vertex>& vertices = merged.vertices;
+    std::vector<unsigned int>& indices = merged.indices;
+
+    for (const auto& member : batch.members) {
+        const MeshData* data = member.object->getMeshData();
+        if (!data) continue;
+
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(member.model)));
+        unsigned int baseVertex = static_cast<unsigned int>(vertices.size());
+
+        for (const Vertex& vertex : data->vertices) {
+            Vertex transformed;
+            transformed.position = glm::vec3(member.model * glm::vec4(vertex.position, 1.0f));
+            transformed.normal = glm::normalize(normalMatrix * vertex.normal);
+            transformed.texCoord = vertex.texCoord;
+            vertices.push_back(transformed);
+        }
+        for (unsigned int index : data->indices) {
+            indices.push_back(baseVertex + index);
+        }
+    }
+    return merged;
+}
+
+/**
+ * @brief Wysyła scaloną siatkę paczki do GPU
+ * @param batch Paczka
+ * @param merged Scalona siatka paczki
+ */
+void StaticBatcher::uploadBatch(StaticBatch& batch, const MeshData& merged) {
+    const std::vector<Vertex>& vertices = merged.vertices;
+    const std::vector<unsigned int>& indices = merged.indices;
+    BoundingBox box = BoundingBox::empty();
+    for (const Vertex& vertex : vertices) {
+        box.expand(vertex.position);
+    }
+
+    batch.dirty = false;
+    batch.bounds = {box.getCenter(), box.isEmpty() ? 0.0f : glm::length(box.getExtents())};
+    batch.mesh.indexCount = static_cast<int>(indices.size());
+    if (indices.empty()) return;
+
+    if (batch.mesh.VAO == 0) {
+        glGenVertexArrays(1, &batch.mesh.VAO);
+        glGenBuffers(1, &batch.mesh.VBO);
+        glGenBuffers(1, &batch.mesh.EBO);
+
+        glBindVertexArray(batch.mesh.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, batch.mesh.VBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.mesh.EBO);
+
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    } else {
+        glBindVertexArray(batch.mesh.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, batch.mesh.VBO);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Scala siatki członków paczki i wysyła je do GPU
+ * @param batch Paczka
+ */
+void StaticBatcher::rebuildBatch(StaticBatch& batch) {
+    uploadBatch(batch, mergeBatch(batch));
+}
+
+/**
+ * @brief Scala wszystkie statyczne obiekty sceny (usuwa poprzednie paczki)
+ * @param objects Obiekty sceny
+ *
+ * @details Obiekty grupowane są według wartości materiału oraz komórki,
+ * w której leży środek ich sfery otaczającej. Każda paczka trzyma własne
+ * odwołanie do MaterialTable, więc nie zależy od czasu życia obiektów. Scalone siatki paczek są
+ * następnie źródłem drzewa HLOD.
+ */
+void StaticBatcher::build(const std::vector<TransformableObject*>& objects) {
+    release();
+    m_unbatchedCount = 0;
+
+    std::vector<Material> materials;
+    std::map<std::tuple<size_t, int, int, int>, size_t> batchByKey;
+
+    for (TransformableObject* object : objects) {
+        if (!object || !object->isStatic()) continue;
+        const MeshData* data = object->getMeshData();
+        if (!data || data->indices.empty()) continue;
+
+        const Material& material = object->getMaterial();
+        size_t materialIndex = 0;
+        while (materialIndex < materials.size() && !MaterialTable::isSameMaterial(materials[materialIndex], material)) {
+            materialIndex++;
+        }
+        if (materialIndex == materials.size()) materials.push_back(material);
+
+        glm::ivec3 chunk = glm::ivec3(glm::floor(object->getWorldBounds().center / CHUNK_SIZE));
+        auto key = std::make_tuple(materialIndex, chunk.x, chunk.y, chunk.z);
+        auto it = batchByKey.find(key);
+        if (it == batchByKey.end()) {
+            StaticBatch batch;
+            batch.material = material;
+            batch.materialId = INVALID_MATERIAL;
+            batch.chunk = chunk;
+            batch.mesh = {0, 0, 0, 0};
+            batch.bounds = {glm::vec3(0.0f), 0.0f};
+            batch.dirty = true;
+            it = batchByKey.emplace(key, m_batches.size()).first;
+            m_batches.push_back(batch);
+        }
+        m_batches[it->second].members.push_back({object, object->getModelMatrix(), material});
+    }
+
+    std::vector<MeshData> merged(m_batches.size());
+    std::vector<HlodSource> sources;
+    for (size_t i = 0; i < m_batches.size(); ++i) {
+        StaticBatch& batch = m_batches[i];
+        batch.materialId = MaterialTable::instance().createMaterial(batch.material);
+        merged[i] = mergeBatch(batch);
+        uploadBatch(batch, merged[i]);
+        sources.push_back({i, batch.chunk, &merged[i], batch.material, batch.members.size()});
+    }
+    rebuildMemberMap();
+    m_hlod.build(sources);
+
+    std::cout << "Statyczne paczki: " << m_memberBatch.size() << " obiektow -> "
+              << m_batches.size() << " wywolan rysowania" << std::endl;
+}
+
+/**
+ * @brief Wyjmuje z paczek obiekty, które się zmieniły lub zniknęły ze sceny
+ * @param objects Obiekty sceny w bieżącej klatce
+ * @param outUnbatched Obiekty do narysowania osobno (nie należące do paczek)
+ *
+ * @details Koszt sprawdzenia to porównanie macierzy i materiału każdego
+ * scalonego obiektu. Przebudowywane są tylko paczki, z których coś wyjęto;
+ * puste paczki są usuwane.
+ */
+void StaticBatcher::update(const std::vector<TransformableObject*>& objects,
+                           std::vector<TransformableObject*>& outUnbatched) {
+    outUnbatched.clear();
+
+    if (!m_batches.empty()) {
+        std::unordered_set<const TransformableObject*> present(objects.begin(), objects.end());
+        bool removedBatch = false;
+
+        for (auto& batch : m_batches) {
+            for (size_t i = 0; i < batch.members.size();) {
+                const BatchMember& member = batch.members[i];
+                bool alive = present.count(member.object) != 0;
+                if (alive && member.object->getModelMatrix() == member.model &&
+                    MaterialTable::isSameMaterial(member.object->getMaterial(), member.material)) {
+                    ++i;
+                    continue;
+                }
+                m_memberBatch.erase(member.object);
+                batch.members[i] = batch.members.back();
+                batch.members.pop_back();
+                batch.dirty = true;
+                m_unbatchedCount++;
+            }
+            if (batch.dirty) {
+                m_hlod.invalidate(batch.chunk);
+                if (batch.members.empty()) {
+                    releaseBatch(batch);
+                    removedBatch = true;
+                } else {
+                    rebuildBatch(batch);
+                }
+            }
+        }
+
+        if (removedBatch) {
+            std::vector<StaticBatch> remaining;
+            std::vector<size_t> newIndex(m_batches.size(), SIZE_MAX);
+            for (size_t i = 0; i < m_batches.size(); ++i) {
+                if (m_batches[i].members.empty()) continue;
+                newIndex[i] = remaining.size();
+                remaining.push_back(m_batches[i]);
+            }
+            m_hlod.remapBatches(newIndex);
+            m_batches.swap(remaining);
+            rebuildMemberMap();
+        }
+    }
+
+    for (TransformableObject* object : objects) {
+        if (object && !isBatched(object)) outUnbatched.push_back(object);
+    }
+
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("StaticBatch/Paczki", static_cast<double>(m_batches.size()));
+    stats.setValue("StaticBatch/Obiekty scalone", static_cast<double>(m_memberBatch.size()));
+    stats.setValue("StaticBatch/Obiekty wyjete z paczek", static_cast<double>(m_unbatchedCount));
+    stats.setValue("StaticBatch/Wywolania przed scaleniem", 0.0);
+    stats.setValue("StaticBatch/Wywolania po scaleniu", 0.0);
+    stats.setValue("HLOD/Siatki zastepcze", 0.0);
+    stats.setValue("HLOD/Obiekty zastapione", 0.0);
+}
+
+/**
+ * @brief Rysuje paczki i siatki zastępcze przecinające ostrosłup
+ * @param frustum Ostrosłup widoku
+ * @param program Aktywny program shaderowy
+ * @return Liczba wywołań rysowania
+ *
+ * @details Najpierw drzewo HLOD rysuje siatki zastępcze dalekich grup
+ * komórek i zwraca paczki komórek wymagających pełnej dokładności.
+ * Statystyki "przed" i "po" porównują liczbę wywołań, które wykonałyby
+ * widoczne obiekty rysowane osobno, z liczbą narysowanych paczek i siatek
+ * zastępczych.
+ */
+int StaticBatcher::draw(const Frustum& frustum, GLuint program) const {
+    if (m_batches.empty()) return 0;
+
+    GLint modelLoc = glGetUniformLocation(program, "model");
+    GLint objectColorLoc = glGetUniformLocation(program, "objectColor");
+    GLint materialIndexLoc = glGetUniformLocation(program, "materialIndex");
+
+    glm::mat4 identity(1.0f);
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(identity));
+    glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
+
+    std::vector<size_t> batches;
+    size_t proxyObjects = 0;
+    int draws = 0;
+    if (m_hlod.isEmpty()) {
+        for (size_t i = 0; i < m_batches.size(); ++i) batches.push_back(i);
+    } else {
+        draws = m_hlod.draw(frustum, program, batches, proxyObjects);
+    }
+
+    int objectsDrawn = static_cast<int>(proxyObjects);
+    for (size_t index : batches) {
+        const StaticBatch& batch = m_batches[index];
+        if (batch.mesh.indexCount == 0 || !frustum.intersects(batch.bounds)) continue;
+
+        glUniform1i(materialIndexLoc, batch.materialId);
+        glBindVertexArray(batch.mesh.VAO);
+        glDrawElements(GL_TRIANGLES, batch.mesh.indexCount, GL_UNSIGNED_INT, 0);
+        draws++;
+        objectsDrawn += static_cast<int>(batch.members.size());
+    }
+    glBindVertexArray(0);
+    glUniform1i(materialIndexLoc, MaterialTable::DEFAULT_MATERIAL);
+
+    RenderStats& stats = RenderStats::instance();
+    stats.addValue("StaticBatch/Wywolania przed scaleniem", objectsDrawn);
+    stats.addValue("StaticBatch/Wywolania po scaleniu", draws);
+    return draws;
+}
@@ -0,0 +1,159 @@
+// StaticBatcher.hpp
+#ifndef STATIC_BATCHER_HPP
+#define STATIC_BATCHER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Math/Bounds.hpp"
+#include "HlodTree.hpp"
+
+class TransformableObject;
+
+/**
+ * @class StaticBatcher
+ * @brief Scalanie nieruchomych obiektów w paczki rysowane jednym wywołaniem
+ *
+ * build() przekształca siatki obiektów oznaczonych jako statyczne do
+ * przestrzeni świata i scala je w jeden bufor wierzchołków i indeksów
+ * dla każdej pary (materiał, komórka przestrzeni). Podział na komórki
+ * o boku CHUNK_SIZE pozwala odrzucać paczki poza ostrosłupem widzenia.
+ *
+ * update() wywoływane co klatkę porównuje macierz modelu i materiał
+ * każdego scalonego obiektu z zapamiętanymi - obiekt, który się poruszył
+ * lub zmienił materiał, jest wyjmowany z paczki (paczka jest przebudowywana)
+ * i od tej chwili rysowany osobno. Ponowne scalenie następuje przy
+ * kolejnym build().
+ *
+ * Paczki rysowane są bez danych obiektów: macierz modelu jest jednostkowa,
+ * materiał wybiera uniform "materialIndex", a światła - lista globalna.
+ *
+ * Nad komórkami budowane jest drzewo HLOD (HlodTree): z daleka całe grupy
+ * komórek rysowane są jedną uproszczoną siatką zastępczą zamiast paczek.
+ */
+class StaticBatcher {
+public:
+    static constexpr float CHUNK_SIZE = 16.0f;  /**< Bok komórki przestrzeni w jednostkach świata */
+
+private:
+    /**
+     * @struct BatchMember
+     * @brief Obiekt scalony w paczce wraz ze stanem z chwili scalenia
+     */
+    struct BatchMember {
+        TransformableObject* object;    /**< Obiekt sceny */
+        glm::mat4 model;                /**< Macierz modelu użyta do przekształcenia */
+        Material material;              /**< Materiał w chwili scalenia */
+    };
+
+    /**
+     * @struct StaticBatch
+     * @brief Scalona siatka obiektów o wspólnym materiale w jednej komórce
+     */
+    struct StaticBatch {
+        Material material;                  /**< Wspólny materiał */
+        MaterialId materialId;              /**< Wpis paczki w MaterialTable */
+        glm::ivec3 chunk;                   /**< Komórka przestrzeni */
+        std::vector<BatchMember> members;   /**< Scalone obiekty */
+        Mesh mesh;                          /**< Bufory GPU scalonej siatki */
+        BoundingSphere bounds;              /**< Sfera otaczająca paczkę */
+        bool dirty;                         /**< Czy paczkę trzeba przebudować */
+    };
+
+    std::vector<StaticBatch> m_batches;                                     /**< Paczki */
+    std::unordered_map<const TransformableObject*, size_t> m_memberBatch;   /**< Obiekt -> indeks paczki */
+    int m_unbatchedCount;                                                   /**< Obiekty wyjęte od ostatniego build() */
+    HlodTree m_hlod;                                                        /**< Siatki zastępcze grup komórek */
+
+    /**
+     * @brief Scala siatki członków paczki w przestrzeni świata
+     * @param batch Paczka
+     * @return Scalona siatka
+     */
+    MeshData mergeBatch(const StaticBatch& batch) const;
+
+    /**
+     * @brief Wysyła scaloną siatkę paczki do GPU
+     * @param batch Paczka
+     * @param merged Scalona siatka paczki
+     */
+    void uploadBatch(StaticBatch& batch, const MeshData& merged);
+
+    /**
+     * @brief Scala siatki członków paczki i wysyła je do GPU
+     * @param batch Paczka
+     */
+    void rebuildBatch(StaticBatch& batch);
+
+    /**
+     * @brief Zwalnia bufory GPU i materiał paczki
+     * @param batch Paczka
+     */
+    void releaseBatch(StaticBatch& batch);
+
+    /**
+     * @brief Odtwarza mapę obiekt -> paczka po usunięciu paczek
+     */
+    void rebuildMemberMap();
+
+public:
+    /**
+     * @brief Konstruktor StaticBatcher
+     */
+    StaticBatcher();
+
+    /**
+     * @brief Destruktor StaticBatcher
+     */
+    ~StaticBatcher();
+
+    /**
+     * @brief Scala wszystkie statyczne obiekty sceny (usuwa poprzednie paczki)
+     * @param objects Obiekty sceny
+     */
+    void build(const std::vector<TransformableObject*>& objects);
+
+    /**
+     * @brief Usuwa wszystkie paczki i zwalnia bufory
+     */
+    void release();
+
+    /**
+     * @brief Wyjmuje z paczek obiekty, które się zmieniły lub zniknęły ze sceny
+     * @param objects Obiekty sceny w bieżącej klatce
+     * @param outUnbatched Obiekty do narysowania osobno (nie należące do paczek)
+     */
+    void update(const std::vector<TransformableObject*>& objects, std::vector<TransformableObject*>& outUnbatched);
+
+    /**
+     * @brief Rysuje paczki i siatki zastępcze przecinające ostrosłup
+     * @param frustum Ostrosłup widoku
+     * @param program Aktywny program shaderowy
+     * @return Liczba wywołań rysowania
+     */
+    int draw(const Frustum& frustum, GLuint program) const;
+
+    /**
+     * @brief Sprawdza, czy obiekt jest scalony w paczce
+     * @param object Obiekt
+     * @return true jeśli obiekt należy do paczki
+     */
+    bool isBatched(const TransformableObject* object) const { return m_memberBatch.count(object) != 0; }
+
+    /**
+     * @brief Zwraca liczbę paczek
+     * @return Liczba paczek
+     */
+    int getBatchCount() const { return static_cast<int>(m_batches.size()); }
+
+    /**
+     * @brief Zwraca liczbę scalonych obiektów
+     * @return Liczba obiektów w paczkach
+     */
+    int getBatchedObjectCount() const { return static_cast<int>(m_memberBatch.size()); }
+};
+
+#endif // STATIC_BATCHER_HPP
@@ -0,0 +1,43 @@
+// BenchmarkUtils.hpp
+#ifndef BENCHMARK_UTILS_HPP
+#define BENCHMARK_UTILS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @namespace BenchmarkUtils
+ * @brief Pomiar czasu i wypisywanie wyników wspólne dla programów z Benchmarks/
+ */
+namespace BenchmarkUtils {
+
+/**
+ * @brief Zwraca czas od punktu startowego
+ * @param start Punkt startowy
+ * @return Czas w milisekundach
+ */
+inline double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+ * @brief Wypisuje wiersz pomiaru z czasem całkowitym i czasem na element
+ * @param label Opis
+ * @param milliseconds Czas całkowity [ms]
+ * @param count Liczba elementów
+ * @param unit Jednostka czasu na element (np. "us/postac")
+ * @param unitsPerMs Liczba jednostek w milisekundzie (1e3 dla us, 1e6 dla ns)
+ */
+inline void printTiming(const char* label, double milliseconds, size_t count, const char* unit, double unitsPerMs) {
+    std::cout << std::left << std::setw(46) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << milliseconds << " ms  " << std::setw(9) << std::setprecision(2)
+              << milliseconds * unitsPerMs / static_cast<double>(std::max<size_t>(count, 1)) << " " << unit
+              << std::endl;
+}
+
+} // namespace BenchmarkUtils
+
+#endif // BENCHMARK_UTILS_HPP
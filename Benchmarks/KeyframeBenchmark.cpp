@@ -0,0 +1,287 @@
+// KeyframeBenchmark.cpp
+// Pomiar próbkowania klipów kluczowych dla wielu przekształceń (domyślnie
+// 100 000): kompresja kluczy, zgodność z próbkowaniem nieskompresowanych
+// kluczy, próbkowanie SoA z kursorem i bez, mieszanie dwóch klipów,
+// jednowątkowo i przez KeyframeAnimator.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+// Użycie: KeyframeBenchmark [liczba przekształceń]
+#include "BenchmarkUtils.hpp"
+#include "../Animation/KeyframeAnimator.hpp"
+#include "../Animation/KeyframeClip.hpp"
+#include "../Math/Simd.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+static const float CLIP_DURATION = 4.0f;    /**< Długość klipów testowych [s] */
+static const int FRAMES = 30;               /**< Klatki odtwarzania w pomiarach */
+static const float FRAME_TIME = 1.0f / 60.0f;
+
+/**
+ * @brief Zwraca rosnące czasy kluczy o nieregularnych odstępach od 0 do CLIP_DURATION
+ * @param count Liczba kluczy (co najmniej 2)
+ * @param random Generator
+ * @return Czasy kluczy
+ */
+static std::vector<float> makeTimes(int count, std::minstd_rand& random) {
+    std::uniform_real_distribution<float> jitter(-0.35f, 0.35f);
+    std::vector<float> times(count);
+    float step = CLIP_DURATION / static_cast<float>(count - 1);
+    for (int k = 0; k < count; ++k) {
+        times[k] = (k == 0 || k == count - 1) ? step * k : step * (k + jitter(random));
+    }
+    return times;
+}
+
+/**
+ * @brief Tworzy ścieżkę testową
+ * @param index Indeks ścieżki
+ * @param variant Wariant klipu (inne tempo i amplitudy)
+ * @return Klucze ścieżki
+ *
+ * Klucze zapisane są co około 1/15 s, jak po wypaleniu animacji
+ * z edytora: przesunięcie to ruch jednostajny zakończony postojem, obrót
+ * wahanie przechodzące w bezruch, a skala jest stała. Kompresja usuwa
+ * klucze odcinków liniowych i postojów.
+ */
+static KeyframeTrack makeTrack(size_t index, int variant) {
+    std::minstd_rand random(static_cast<unsigned>(index * 2 + variant + 1));
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    KeyframeTrack track;
+    glm::vec3 base(unit(random) * 50.0f, unit(random) * 5.0f, unit(random) * 50.0f);
+    glm::vec3 velocity = glm::vec3(unit(random), 0.0f, unit(random)) * (1.0f + variant);
+    float stopTime = CLIP_DURATION * (0.5f + 0.25f * unit(random));
+    float holdTime = CLIP_DURATION * (0.6f + 0.3f * unit(random));
+
+    track.translationTimes = makeTimes(61, random);
+    for (float time : track.translationTimes) {
+        track.translations.push_back(base + velocity * std::min(time, stopTime));
+    }
+
+    glm::vec3 axis = glm::normalize(glm::vec3(unit(random), unit(random) + 2.0f, unit(random)));
+    float frequency = (1.0f + variant) * 6.2831853f / CLIP_DURATION;
+    float amplitude = 0.6f + 0.4f * unit(random);
+    track.rotationTimes = makeTimes(61, random);
+    for (float time : track.rotationTimes) {
+        float angle = amplitude * std::sin(frequency * std::min(time, holdTime));
+        track.rotations.push_back(glm::angleAxis(angle, axis));
+    }
+
+    float scale = 1.0f + 0.25f * unit(random);
+    track.scaleTimes = {0.0f, CLIP_DURATION};
+    track.scales = {glm::vec3(scale), glm::vec3(scale)};
+    return track;
+}
+
+/**
+ * @brief Wyszukuje klucze i współczynnik interpolacji w nieskompresowanej składowej
+ * @param times Czasy kluczy
+ * @param time Czas [s]
+ * @param from Wynik: klucz początkowy
+ * @param to Wynik: klucz końcowy
+ * @return Współczynnik interpolacji
+ */
+static float findReferenceKeys(const std::vector<float>& times, float time, size_t& from, size_t& to) {
+    size_t key = static_cast<size_t>(std::upper_bound(times.begin(), times.end(), time) - times.begin());
+    to = std::min(key, times.size() - 1);
+    from = key > 0 ? std::min(key - 1, times.size() - 1) : 0;
+    float span = times[to] - times[from];
+    return span > 0.0f ? std::clamp((time - times[from]) / span, 0.0f, 1.0f) : 0.0f;
+}
+
+/**
+ * @brief Próbkuje nieskompresowaną ścieżkę po jednym przekształceniu (układ AoS, glm)
+ * @param track Klucze
+ * @param time Czas w klipie [s]
+ * @param translation Wynik: przesunięcie
+ * @param rotation Wynik: obrót (nlerp w krótszą stronę)
+ * @param scale Wynik: skala
+ */
+static void sampleReference(const KeyframeTrack& track, float time, glm::vec3& translation, glm::quat& rotation,
+                            glm::vec3& scale) {
+    size_t from, to;
+    float factor = findReferenceKeys(track.translationTimes, time, from, to);
+    translation = glm::mix(track.translations[from], track.translations[to], factor);
+    factor = findReferenceKeys(track.rotationTimes, time, from, to);
+    glm::quat a = track.rotations[from];
+    glm::quat b = track.rotations[to];
+    if (glm::dot(a, b) < 0.0f) b = -b;
+    rotation = glm::normalize(glm::quat(a.w + (b.w - a.w) * factor, a.x + (b.x - a.x) * factor,
+                                        a.y + (b.y - a.y) * factor, a.z + (b.z - a.z) * factor));
+    factor = findReferenceKeys(track.scaleTimes, time, from, to);
+    scale = glm::mix(track.scales[from], track.scales[to], factor);
+}
+
+/**
+ * @brief Porównuje próbkowanie skompresowanego klipu z kluczami źródłowymi
+ * @param tracks Klucze źródłowe
+ * @param clip Klip z tych kluczy
+ * @return true jeśli błąd mieści się w tolerancji kompresji
+ *
+ * Sprawdza też, że próbki z kursorem (odtwarzanie do przodu z zapętleniem)
+ * są identyczne z próbkami z wyszukiwaniem binarnym.
+ */
+static bool checkAgainstReference(const std::vector<KeyframeTrack>& tracks, const KeyframeClip& clip) {
+    const size_t count = std::min<size_t>(tracks.size(), 4000);
+    SkeletonPose pose, searched;
+    pose.resize(clip.getTrackCount());
+    searched.resize(clip.getTrackCount());
+    KeyframeCursor cursor;
+    clip.resetCursor(cursor);
+    float positionError = 0.0f;
+    float angleError = 0.0f;
+    bool cursorMatches = true;
+
+    for (float time = 0.0f; time < 2.5f * CLIP_DURATION; time += 0.0917f) {
+        clip.sample(time, &cursor, 0, count, 1.0f, false, pose);
+        clip.sample(time, nullptr, 0, count, 1.0f, false, searched);
+        for (int c = 0; c < SkeletonPose::CHANNEL_COUNT; ++c) {
+            cursorMatches = cursorMatches && std::equal(pose.channels[c].begin(), pose.channels[c].begin() + count,
+                                                        searched.channels[c].begin());
+        }
+        Simd::normalizeQuaternions(pose.channels[SkeletonPose::ROTATION_X].data(),
+                                   pose.channels[SkeletonPose::ROTATION_Y].data(),
+                                   pose.channels[SkeletonPose::ROTATION_Z].data(),
+                                   pose.channels[SkeletonPose::ROTATION_W].data(), count);
+        float clipTime = clip.wrapTime(time);
+        for (size_t i = 0; i < count; ++i) {
+            glm::vec3 translation, scale;
+            glm::quat rotation;
+            sampleReference(tracks[i], clipTime, translation, rotation, scale);
+            positionError = std::max(positionError, glm::length(pose.getTranslation(static_cast<int>(i)) - translation));
+            positionError = std::max(positionError, glm::length(pose.getScale(static_cast<int>(i)) - scale));
+            // Kąt z długości cięciwy: acos iloczynu skalarnego bliskiego 1 traci precyzję floata
+            glm::quat sampled = pose.getRotation(static_cast<int>(i));
+            glm::vec4 a(sampled.x, sampled.y, sampled.z, sampled.w);
+            glm::vec4 b(rotation.x, rotation.y, rotation.z, rotation.w);
+            float chord = std::min(glm::length(a - b), glm::length(a + b));
+            angleError = std::max(angleError, 4.0f * std::asin(std::min(chord * 0.5f, 1.0f)) * 57.29578f);
+        }
+    }
+
+    bool valid = cursorMatches && positionError < 1e-3f && angleError < 0.05f;
+    std::cout << std::left << std::setw(46) << "Zgodnosc z kluczami zrodlowymi" << (valid ? " zgodne" : " NIEZGODNE")
+              << std::scientific << std::setprecision(1) << "  przesuniecie: " << positionError << ", obrot: "
+              << angleError << " st., kursor: " << (cursorMatches ? "identyczny" : "ROZNY") << std::defaultfloat
+              << std::endl;
+    return valid;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::max(std::atoi(argv[1]), 1)) : 100000;
+    const unsigned threads = ThreadPool::instance().getThreadCount() + 1;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<KeyframeTrack> sources(count);
+    auto walkClip = std::make_shared<KeyframeClip>("chod");
+    auto runClip = std::make_shared<KeyframeClip>("bieg");
+    size_t sourceBytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sources[i] = makeTrack(i, 0);
+        walkClip->addTrack(sources[i]);
+        runClip->addTrack(makeTrack(i, 1));
+        sourceBytes += (sources[i].translations.size() + sources[i].scales.size()) * (sizeof(float) + sizeof(glm::vec3)) +
+                       sources[i].rotations.size() * (sizeof(float) + sizeof(glm::quat));
+    }
+    std::cout << std::fixed << std::setprecision(0) << "Tworzenie i kompresja " << count << " sciezek (2 klipy): "
+              << BenchmarkUtils::elapsedMs(start) << " ms" << std::endl;
+    std::cout << "Klucze: " << walkClip->getSourceKeyCount() << " -> " << walkClip->getKeyCount() << ", pamiec "
+              << std::setprecision(1) << sourceBytes / (1024.0 * 1024.0) << " MB -> "
+              << walkClip->getMemoryUsage() / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    std::cout << std::endl << "Poprawnosc" << std::endl;
+    if (!checkAgainstReference(sources, *walkClip)) {
+        std::cerr << "Blad: Probkowanie klipu rozni sie od kluczy zrodlowych" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::endl << "Odtwarzanie " << count << " przeksztalcen, " << FRAMES << " klatek po "
+              << std::setprecision(1) << FRAME_TIME * 1000.0f << " ms (" << threads << " watkow)" << std::endl;
+    SkeletonPose pose;
+    pose.resize(count);
+
+    // Punkt odniesienia: każde przekształcenie osobno z nieskompresowanych kluczy AoS
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        float time = frame * FRAME_TIME;
+        for (size_t i = 0; i < count; ++i) {
+            glm::vec3 translation, scale;
+            glm::quat rotation;
+            sampleReference(sources[i], time, translation, rotation, scale);
+            pose.setBone(static_cast<int>(i), translation, rotation, scale);
+        }
+    }
+    BenchmarkUtils::printTiming("AoS glm, wyszukiwanie binarne (1 watek)", BenchmarkUtils::elapsedMs(start) / FRAMES, count, "ns/przeksztalcenie", 1e6);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        walkClip->sample(frame * FRAME_TIME, nullptr, 0, count, 1.0f, false, pose);
+    }
+    BenchmarkUtils::printTiming("SoA SIMD, wyszukiwanie binarne (1 watek)", BenchmarkUtils::elapsedMs(start) / FRAMES, count, "ns/przeksztalcenie", 1e6);
+
+    KeyframeCursor cursor, runCursor;
+    walkClip->resetCursor(cursor);
+    runClip->resetCursor(runCursor);
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        walkClip->sample(frame * FRAME_TIME, &cursor, 0, count, 1.0f, false, pose);
+    }
+    BenchmarkUtils::printTiming("SoA SIMD z kursorem (1 watek)", BenchmarkUtils::elapsedMs(start) / FRAMES, count, "ns/przeksztalcenie", 1e6);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        walkClip->sample(frame * FRAME_TIME, &cursor, 0, count, 0.7f, false, pose);
+        runClip->sample(frame * FRAME_TIME, &runCursor, 0, count, 0.3f, true, pose);
+        Simd::normalizeQuaternions(pose.channels[SkeletonPose::ROTATION_X].data(),
+                                   pose.channels[SkeletonPose::ROTATION_Y].data(),
+                                   pose.channels[SkeletonPose::ROTATION_Z].data(),
+                                   pose.channels[SkeletonPose::ROTATION_W].data(), count);
+    }
+    BenchmarkUtils::printTiming("Mieszanie 2 klipow z kursorem (1 watek)", BenchmarkUtils::elapsedMs(start) / FRAMES, count, "ns/przeksztalcenie", 1e6);
+
+    std::vector<float> matrices(count * 16);
+    const float* const translations[3] = {pose.channels[SkeletonPose::TRANSLATION_X].data(),
+                                          pose.channels[SkeletonPose::TRANSLATION_Y].data(),
+                                          pose.channels[SkeletonPose::TRANSLATION_Z].data()};
+    const float* const rotations[4] = {pose.channels[SkeletonPose::ROTATION_X].data(),
+                                       pose.channels[SkeletonPose::ROTATION_Y].data(),
+                                       pose.channels[SkeletonPose::ROTATION_Z].data(),
+                                       pose.channels[SkeletonPose::ROTATION_W].data()};
+    const float* const scales[3] = {pose.channels[SkeletonPose::SCALE_X].data(),
+                                    pose.channels[SkeletonPose::SCALE_Y].data(),
+                                    pose.channels[SkeletonPose::SCALE_Z].data()};
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        Simd::composeTransforms(translations, rotations, scales, count, matrices.data());
+    }
+    BenchmarkUtils::printTiming("Macierze 4x4 z pozy SoA (1 watek)", BenchmarkUtils::elapsedMs(start) / FRAMES, count, "ns/przeksztalcenie", 1e6);
+
+    // Pełne wyliczenie przez ThreadPool
+    KeyframeAnimator animator(count);
+    int walkLayer = animator.addLayer(walkClip);
+    int runLayer = animator.addLayer(runClip, 0.0f);
+    double evaluateMs = 0.0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        animator.update(FRAME_TIME);
+        animator.evaluate(pose);
+        evaluateMs += animator.getStats().milliseconds;
+    }
+    BenchmarkUtils::printTiming("KeyframeAnimator, 1 klip (ThreadPool)", evaluateMs / FRAMES, count, "ns/przeksztalcenie", 1e6);
+    animator.setWeight(walkLayer, 0.6f);
+    animator.setWeight(runLayer, 0.4f);
+    evaluateMs = 0.0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        animator.update(FRAME_TIME);
+        animator.evaluate(pose);
+        evaluateMs += animator.getStats().milliseconds;
+    }
+    BenchmarkUtils::printTiming("KeyframeAnimator, 2 klipy (ThreadPool)", evaluateMs / FRAMES, count, "ns/przeksztalcenie", 1e6);
+    return 0;
+}
@@ -0,0 +1,118 @@
+// MarchingCubesBenchmark.cpp
+// Pomiar ekstrakcji izopowierzchni (domyślnie siatka 512^3) dla kilku
+// izowartości oraz sprawdzenie szczelności i orientacji siatki.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+// Użycie: MarchingCubesBenchmark [liczba próbek w osi]
+#include "BenchmarkUtils.hpp"
+#include "../Volume/MarchingCubes.hpp"
+#include "../Volume/ScalarVolume.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Pole testowe: kula z zaburzeniem żyroidy (jak wynik symulacji z wieloma warstwami)
+ * @param p Punkt w [-1, 1]^3
+ * @return Wartość (około 0 na brzegu kuli)
+ */
+static float sampleField(const glm::vec3& p) {
+    const float k = 14.0f;
+    float gyroid = std::sin(p.x * k) * std::cos(p.y * k) + std::sin(p.y * k) * std::cos(p.z * k) +
+                   std::sin(p.z * k) * std::cos(p.x * k);
+    return 0.8f - glm::length(p) + 0.12f * gyroid;
+}
+
+/**
+ * @brief Sprawdza, czy siatka kuli jest zamknięta i zgodnie zorientowana
+ * @return true jeśli każda krawędź (po scaleniu wierzchołków z granic bloków)
+ *         występuje raz w każdym kierunku, a trójkąty są zgodne z normalnymi
+ */
+static bool checkClosedSurface() {
+    ScalarVolume volume(glm::ivec3(70, 53, 41), glm::vec3(-1.0f), glm::vec3(2.0f / 69.0f, 2.0f / 52.0f, 2.0f / 40.0f));
+    volume.generate([](const glm::vec3& p) { return 1.0f - glm::length(p * glm::vec3(1.2f, 1.0f, 0.9f)); });
+    MarchingCubes extractor;
+    MeshData mesh;
+    extractor.extract(volume, 0.3f, mesh);
+
+    // Wierzchołki z granic bloków są powtórzone; te same krawędzie dają identyczne pozycje
+    std::map<std::tuple<float, float, float>, int> welded;
+    std::vector<int> ids(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        const glm::vec3& p = mesh.vertices[i].position;
+        auto inserted = welded.emplace(std::make_tuple(p.x, p.y, p.z), static_cast<int>(welded.size()));
+        ids[i] = inserted.first->second;
+    }
+
+    std::map<std::pair<int, int>, int> directedEdges;
+    size_t misoriented = 0;
+    for (size_t t = 0; t < mesh.indices.size(); t += 3) {
+        const Vertex& a = mesh.vertices[mesh.indices[t]];
+        const Vertex& b = mesh.vertices[mesh.indices[t + 1]];
+        const Vertex& c = mesh.vertices[mesh.indices[t + 2]];
+        glm::vec3 faceNormal = glm::cross(b.position - a.position, c.position - a.position);
+        if (glm::dot(faceNormal, a.normal + b.normal + c.normal) < 0.0f) misoriented++;
+        for (int k = 0; k < 3; ++k) {
+            directedEdges[{ids[mesh.indices[t + k]], ids[mesh.indices[t + (k + 1) % 3]]}]++;
+        }
+    }
+    size_t openEdges = 0;
+    for (const auto& [edge, count] : directedEdges) {
+        if (count != 1 || !directedEdges.count({edge.second, edge.first})) openEdges++;
+    }
+    bool closed = openEdges == 0 && misoriented == 0 && !mesh.indices.empty();
+    std::cout << std::left << std::setw(44) << "Szczelnosc i orientacja (kula 70x53x41)"
+              << (closed ? " zgodne" : " NIEZGODNE") << "  trojkaty: " << mesh.indices.size() / 3
+              << ", otwarte krawedzie: " << openEdges << ", odwrocone: " << misoriented << std::endl;
+    return closed;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "Poprawnosc siatki" << std::endl;
+    if (!checkClosedSurface()) {
+        std::cerr << "Blad: Izopowierzchnia nie jest zamknieta" << std::endl;
+        return 1;
+    }
+
+    int size = argc > 1 ? std::atoi(argv[1]) : 512;
+    size = std::max(size, 2);
+    const unsigned threads = ThreadPool::instance().getThreadCount() + 1;
+    std::cout << std::endl << "Siatka " << size << "^3 (" << threads << " watkow)" << std::endl;
+
+    float spacing = 2.0f / static_cast<float>(size - 1);
+    ScalarVolume volume(glm::ivec3(size), glm::vec3(-1.0f), glm::vec3(spacing));
+    auto start = std::chrono::high_resolution_clock::now();
+    volume.generate(sampleField);
+    double generateMs = BenchmarkUtils::elapsedMs(start);
+    start = std::chrono::high_resolution_clock::now();
+    volume.updateBrickRanges();
+    double rangesMs = BenchmarkUtils::elapsedMs(start);
+    std::cout << std::fixed << std::setprecision(1) << "Generowanie z zakresami blokow: " << generateMs
+              << " ms, same zakresy: " << rangesMs << " ms, pamiec " << volume.getMemoryUsage() / (1024.0 * 1024.0) << " MB, bloki: "
+              << volume.getBrickCount() << std::endl;
+
+    // Pierwszy przebieg przydziela bufory bloków; drugi pokazuje ponowną ekstrakcję
+    const float isoValues[] = {-0.1f, 0.0f, 0.05f, 0.15f};
+    MarchingCubes extractor;
+    MeshData mesh;
+    for (int pass = 0; pass < 2; ++pass) {
+        std::cout << std::endl << (pass == 0 ? "Pierwsza ekstrakcja" : "Ponowna ekstrakcja (zmiana izowartosci)") << std::endl;
+        for (float isoValue : isoValues) {
+            extractor.extract(volume, isoValue, mesh);
+            const MarchingCubesStats& stats = extractor.getStats();
+            std::cout << std::right << "izowartosc " << std::setw(6) << std::setprecision(2) << isoValue << "  " << std::setw(8)
+                      << std::setprecision(1) << stats.milliseconds << " ms  bloki: " << stats.activeBricks << "/"
+                      << stats.bricks << "  trojkaty: " << stats.triangles << ", wierzcholki: " << stats.vertices
+                      << " (" << std::setprecision(2) << static_cast<double>(stats.triangles * 3) / std::max<size_t>(stats.vertices, 1)
+                      << " uzyc na wierzcholek)" << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,335 @@
+// MeshBuilderBenchmark.cpp
+// Pomiar czasu generowania siatek o dużej gęstości.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+#include "../Mesh/MeshBuilder.hpp"
+#include "../Mesh/PrimitiveData.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define PI 3.14159265358979323846f
+
+/**
+ * @brief Generuje sferę dawną metodą (push_back bez rezerwacji)
+ * @param sectors Liczba sektorów
+ * @param stacks Liczba warstw
+ * @return Dane siatki
+ *
+ * Odpowiada implementacji GeometryRenderer::createSphere sprzed MeshBuilder
+ * i służy jako punkt odniesienia.
+ */
+static MeshData generateSpherePushBack(int sectors, int stacks) {
+    MeshData data;
+    float sectorStep = 2 * PI / sectors;
+    float stackStep = PI / stacks;
+
+    for (int i = 0; i <= stacks; ++i) {
+        float stackAngle = PI / 2 - i * stackStep;
+        float xy = cosf(stackAngle);
+        float z = sinf(stackAngle);
+        for (int j = 0; j <= sectors; ++j) {
+            float sectorAngle = j * sectorStep;
+            Vertex vertex;
+            vertex.position = glm::vec3(xy * cosf(sectorAngle), xy * sinf(sectorAngle), z);
+            vertex.normal = vertex.position;
+            vertex.texCoord = glm::vec2((float)j / sectors, (float)i / stacks);
+            data.vertices.push_back(vertex);
+        }
+    }
+
+    for (int i = 0; i < stacks; ++i) {
+        int k1 = i * (sectors + 1);
+        int k2 = k1 + sectors + 1;
+        for (int j = 0; j < sectors; ++j, ++k1, ++k2) {
+            if (i != 0) {
+                data.indices.push_back(k1);
+                data.indices.push_back(k2);
+                data.indices.push_back(k1 + 1);
+            }
+            if (i != (stacks - 1)) {
+                data.indices.push_back(k1 + 1);
+                data.indices.push_back(k2);
+                data.indices.push_back(k2 + 1);
+            }
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Generuje torus dawną metodą (skalarnie, sin/cos dla każdego wierzchołka)
+ * @param radius Główny promień
+ * @param tubeRadius Promień rury
+ * @param sectors Liczba sektorów rury
+ * @param rings Liczba pierścieni
+ * @return Dane siatki
+ */
+static MeshData generateTorusScalar(float radius, float tubeRadius, int sectors, int rings) {
+    MeshData data;
+    data.vertices.reserve(static_cast<size_t>(sectors + 1) * (rings + 1));
+    float sectorStep = 2 * PI / sectors;
+    float ringStep = 2 * PI / rings;
+
+    for (int i = 0; i <= rings; ++i) {
+        float ringAngle = i * ringStep;
+        float cosRing = cosf(ringAngle);
+        float sinRing = sinf(ringAngle);
+        for (int j = 0; j <= sectors; ++j) {
+            float sectorAngle = j * sectorStep;
+            float cosSector = cosf(sectorAngle);
+            float sinSector = sinf(sectorAngle);
+            Vertex vertex;
+            vertex.position = glm::vec3((radius + tubeRadius * cosSector) * cosRing,
+                                        (radius + tubeRadius * cosSector) * sinRing,
+                                        tubeRadius * sinSector);
+            vertex.normal = glm::vec3(cosRing * cosSector, sinRing * cosSector, sinSector);
+            vertex.texCoord = glm::vec2(static_cast<float>(j) / sectors, static_cast<float>(i) / rings);
+            data.vertices.push_back(vertex);
+        }
+    }
+
+    for (int i = 0; i < rings; ++i) {
+        for (int j = 0; j < sectors; ++j) {
+            unsigned int first = i * (sectors + 1) + j;
+            unsigned int second = first + sectors + 1;
+            data.indices.insert(data.indices.end(), {first, second, first + 1, second, second + 1, first + 1});
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Porównuje siatkę z wersją wzorcową
+ * @param name Nazwa porównania
+ * @param reference Siatka wzorcowa (skalarna)
+ * @param tested Siatka sprawdzana
+ * @param epsilon Dopuszczalna różnica atrybutu
+ * @return true jeśli indeksy są identyczne, a atrybuty różnią się nie więcej niż epsilon
+ */
+static bool compareMeshes(const std::string& name, const MeshData& reference, const MeshData& tested, float epsilon) {
+    bool same = reference.vertices.size() == tested.vertices.size() && reference.indices == tested.indices;
+    float maxDifference = 0.0f;
+    for (size_t i = 0; same && i < reference.vertices.size(); ++i) {
+        const float* a = &reference.vertices[i].position.x;
+        const float* b = &tested.vertices[i].position.x;
+        for (size_t k = 0; k < sizeof(Vertex) / sizeof(float); ++k) {
+            maxDifference = std::max(maxDifference, std::fabs(a[k] - b[k]));
+        }
+    }
+    same = same && maxDifference <= epsilon;
+    std::cout << std::left << std::setw(44) << name << (same ? " zgodne" : " NIEZGODNE")
+              << "  maks. roznica: " << std::scientific << maxDifference << std::defaultfloat << std::endl;
+    return same;
+}
+
+/**
+ * @brief Kopiuje siatkę czasu kompilacji do MeshData
+ * @param primitive Siatka z Primitives
+ * @return Dane siatki
+ *
+ * Odpowiada pracy GeometryRenderer::setupStaticMesh po stronie CPU.
+ */
+template <size_t V, size_t I>
+static MeshData copyPrimitive(const Primitives::PrimitiveArrays<V, I>& primitive) {
+    MeshData data;
+    data.vertices.resize(V);
+    std::memcpy(static_cast<void*>(data.vertices.data()), primitive.vertices.data(), V * sizeof(Vertex));
+    data.indices.assign(primitive.indices.begin(), primitive.indices.end());
+    return data;
+}
+
+/**
+ * @brief Mierzy czas wykonania funkcji
+ * @param name Nazwa pomiaru
+ * @param iterations Liczba powtórzeń
+ * @param func Mierzona funkcja (zwraca liczbę wierzchołków, aby wynik nie został pominięty)
+ */
+static void measure(const std::string& name, int iterations, const std::function<size_t()>& func) {
+    double best = 1e30;
+    double total = 0.0;
+    size_t vertices = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        vertices = func();
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best = std::min(best, ms);
+        total += ms;
+    }
+    std::cout << std::left << std::setw(44) << name
+              << " najlepszy: " << std::fixed << std::setprecision(3) << best << " ms"
+              << "  sredni: " << total / iterations << " ms"
+              << "  wierzcholki: " << vertices << std::endl;
+}
+
+int main() {
+    const int iterations = 10;
+    const int sectors = 1024;
+    const int stacks = 1024;
+    const int cylinders = 2000;
+    const float epsilon = 1e-6f;
+    MeshArena arena(64 << 20);
+
+    // Zgodność generatorów SIMD (jedno- i wielowątkowo) z wersją skalarną,
+    // także dla wierszy o długości niepodzielnej przez 4
+    std::cout << "Zgodnosc z wersja skalarna" << std::endl;
+    bool allSame = true;
+    const int tessellations[][2] = {{3, 2}, {7, 5}, {32, 32}, {33, 17}, {512, 300}};
+    for (const auto& tessellation : tessellations) {
+        int s = tessellation[0];
+        int t = tessellation[1];
+        std::string suffix = " " + std::to_string(s) + "x" + std::to_string(t);
+        for (size_t threshold : {SIZE_MAX, size_t(0)}) {
+            std::string mode = threshold == 0 ? " (watki)" : "";
+            MeshBuilder builder;
+            builder.setParallelThreshold(threshold);
+            builder.addSphere(s, t);
+            allSame &= compareMeshes("Sfera" + suffix + mode, generateSpherePushBack(s, t), builder.takeMeshData(), epsilon);
+            builder.addTorus(0.5f, 0.2f, s, t);
+            allSame &= compareMeshes("Torus" + suffix + mode, generateTorusScalar(0.5f, 0.2f, s, t), builder.takeMeshData(), epsilon);
+        }
+    }
+    if (!allSame) {
+        std::cerr << "Blad: Generatory SIMD daja inny wynik niz wersja skalarna" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::endl << "Generowanie parametryczne wg tesselacji" << std::endl;
+    for (int level : {64, 256, 1024, 2048}) {
+        std::string suffix = " " + std::to_string(level) + "x" + std::to_string(level);
+        measure("Sfera skalarnie" + suffix, iterations, [&]() {
+            return generateSpherePushBack(level, level).vertices.size();
+        });
+        measure("Sfera SIMD" + suffix, iterations, [&]() {
+            MeshBuilder builder;
+            builder.setParallelThreshold(SIZE_MAX);
+            builder.reserve(MeshBuilder::sphereCounts(level, level));
+            builder.addSphere(level, level);
+            return builder.getVertexCount();
+        });
+        measure("Sfera SIMD + watki" + suffix, iterations, [&]() {
+            MeshBuilder builder;
+            builder.reserve(MeshBuilder::sphereCounts(level, level));
+            builder.addSphere(level, level);
+            return builder.getVertexCount();
+        });
+        measure("Torus skalarnie" + suffix, iterations, [&]() {
+            return generateTorusScalar(0.5f, 0.2f, level, level).vertices.size();
+        });
+        measure("Torus SIMD" + suffix, iterations, [&]() {
+            MeshBuilder builder;
+            builder.setParallelThreshold(SIZE_MAX);
+            builder.reserve(MeshBuilder::torusCounts(level, level));
+            builder.addTorus(0.5f, 0.2f, level, level);
+            return builder.getVertexCount();
+        });
+        measure("Torus SIMD + watki" + suffix, iterations, [&]() {
+            MeshBuilder builder;
+            builder.reserve(MeshBuilder::torusCounts(level, level));
+            builder.addTorus(0.5f, 0.2f, level, level);
+            return builder.getVertexCount();
+        });
+    }
+
+    std::cout << std::endl;
+
+    std::cout << "Sfera " << sectors << "x" << stacks << std::endl;
+    measure("push_back (dawna metoda)", iterations, [&]() {
+        return generateSpherePushBack(sectors, stacks).vertices.size();
+    });
+    measure("MeshBuilder bez reserve()", iterations, [&]() {
+        MeshBuilder builder;
+        builder.addSphere(sectors, stacks);
+        return builder.getVertexCount();
+    });
+    measure("MeshBuilder z reserve()", iterations, [&]() {
+        MeshBuilder builder;
+        builder.reserve(MeshBuilder::sphereCounts(sectors, stacks));
+        builder.addSphere(sectors, stacks);
+        return builder.getVertexCount();
+    });
+    measure("MeshBuilder z arena", iterations, [&]() {
+        arena.reset();
+        MeshBuilder builder(arena);
+        builder.reserve(MeshBuilder::sphereCounts(sectors, stacks));
+        builder.addSphere(sectors, stacks);
+        return builder.getVertexCount();
+    });
+
+    std::cout << std::endl << "Torus " << sectors << "x" << stacks << std::endl;
+    measure("MeshBuilder z reserve()", iterations, [&]() {
+        MeshBuilder builder;
+        builder.reserve(MeshBuilder::torusCounts(sectors, stacks));
+        builder.addTorus(0.5f, 0.2f, sectors, stacks);
+        return builder.getVertexCount();
+    });
+    measure("MeshBuilder z arena", iterations, [&]() {
+        arena.reset();
+        MeshBuilder builder(arena);
+        builder.reserve(MeshBuilder::torusCounts(sectors, stacks));
+        builder.addTorus(0.5f, 0.2f, sectors, stacks);
+        return builder.getVertexCount();
+    });
+
+    std::cout << std::endl << "Model zlozony: " << cylinders << " cylindrow z transformacja" << std::endl;
+    auto buildComposite = [&](MeshBuilder& builder) {
+        for (int i = 0; i < cylinders; ++i) {
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i % 50), 0.0f, static_cast<float>(i / 50)));
+            transform = glm::rotate(transform, glm::radians(static_cast<float>(i)), glm::vec3(0.0f, 0.0f, 1.0f));
+            transform = glm::scale(transform, glm::vec3(0.1f, 1.0f, 0.1f));
+            builder.pushTransform(transform);
+            builder.addCylinder(32);
+            builder.popTransform();
+        }
+        return builder.getVertexCount();
+    };
+    measure("MeshBuilder bez reserve()", iterations, [&]() {
+        MeshBuilder builder;
+        return buildComposite(builder);
+    });
+    measure("MeshBuilder z reserve()", iterations, [&]() {
+        MeshBuilder builder;
+        builder.reserve(MeshBuilder::cylinderCounts(32) * cylinders);
+        return buildComposite(builder);
+    });
+    measure("MeshBuilder z arena", iterations, [&]() {
+        arena.reset();
+        MeshBuilder builder(arena);
+        builder.reserve(MeshBuilder::cylinderCounts(32) * cylinders);
+        return buildComposite(builder);
+    });
+
+    std::cout << std::endl << "Prymitywy przy starcie (szescian, sfera, cylinder, torus)" << std::endl;
+    measure("MeshBuilder (czas dzialania)", iterations, [&]() {
+        size_t vertices = 0;
+        MeshBuilder builder;
+        builder.addCuboid();
+        vertices += builder.takeMeshData().vertices.size();
+        builder.reserve(MeshBuilder::sphereCounts(Primitives::SPHERE_SECTORS, Primitives::SPHERE_STACKS));
+        builder.addSphere(Primitives::SPHERE_SECTORS, Primitives::SPHERE_STACKS);
+        vertices += builder.takeMeshData().vertices.size();
+        builder.reserve(MeshBuilder::cylinderCounts(Primitives::CYLINDER_SECTORS));
+        builder.addCylinder(Primitives::CYLINDER_SECTORS);
+        vertices += builder.takeMeshData().vertices.size();
+        builder.reserve(MeshBuilder::torusCounts(Primitives::TORUS_SECTORS, Primitives::TORUS_RINGS));
+        builder.addTorus(Primitives::TORUS_RADIUS, Primitives::TORUS_TUBE_RADIUS, Primitives::TORUS_SECTORS, Primitives::TORUS_RINGS);
+        vertices += builder.takeMeshData().vertices.size();
+        return vertices;
+    });
+    measure("Primitives (czas kompilacji, kopia CPU)", iterations, [&]() {
+        return copyPrimitive(Primitives::CUBE).vertices.size() +
+               copyPrimitive(Primitives::SPHERE).vertices.size() +
+               copyPrimitive(Primitives::CYLINDER).vertices.size() +
+               copyPrimitive(Primitives::TORUS).vertices.size();
+    });
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+// MeshSimplifierBenchmark.cpp
+// Pomiar czasu upraszczania siatek i budowy łańcuchów LOD.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+#include "../Mesh/LodChain.hpp"
+#include "../Mesh/MeshBuilder.hpp"
+#include "../Mesh/MeshSimplifier.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Sprawdza poprawność uproszczonej siatki
+ * @param name Nazwa przypadku
+ * @param mesh Siatka
+ * @return true jeśli indeksy mieszczą się w zakresie i brak zdegenerowanych trójkątów
+ */
+static bool validate(const std::string& name, const MeshData& mesh) {
+    if (mesh.indices.size() % 3 != 0) {
+        std::cerr << "Blad: " << name << " - liczba indeksow niepodzielna przez 3" << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+        unsigned a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+        if (a >= mesh.vertices.size() || b >= mesh.vertices.size() || c >= mesh.vertices.size()) {
+            std::cerr << "Blad: " << name << " - indeks poza zakresem" << std::endl;
+            return false;
+        }
+        if (a == b || b == c || a == c) {
+            std::cerr << "Blad: " << name << " - zdegenerowany trojkat" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Upraszcza siatkę, mierzy czas i wypisuje wynik
+ * @param name Nazwa przypadku
+ * @param mesh Siatka wejściowa
+ * @param options Parametry upraszczania
+ * @return true jeśli wynik jest poprawny
+ */
+static bool measure(const std::string& name, const MeshData& mesh, const SimplifyOptions& options) {
+    float error = 0.0f;
+    auto start = std::chrono::high_resolution_clock::now();
+    MeshData result = MeshSimplifier::simplify(mesh, options, &error);
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << std::left << std::setw(44) << name
+              << std::right << std::setw(9) << mesh.indices.size() / 3 << " -> "
+              << std::setw(8) << result.indices.size() / 3 << " trojkatow, blad "
+              << std::fixed << std::setprecision(4) << error << ", "
+              << std::setprecision(1) << std::setw(8) << ms << " ms" << std::endl;
+    return validate(name, result);
+}
+
+int main() {
+    bool valid = true;
+    std::cout << "Watki sprzetowe: " << std::thread::hardware_concurrency() << std::endl;
+
+    MeshBuilder builder;
+    builder.reserve(MeshBuilder::sphereCounts(64, 64));
+    builder.addSphere(64, 64);
+    MeshData sphere = builder.takeMeshData();
+    builder.reserve(MeshBuilder::torusCounts(64, 64));
+    builder.addTorus(0.5f, 0.2f, 64, 64);
+    MeshData torus = builder.takeMeshData();
+    builder.reserve(MeshBuilder::cylinderCounts(64));
+    builder.addCylinder(64);
+    MeshData cylinder = builder.takeMeshData();
+
+    // Około miliona trójkątów
+    builder.reserve(MeshBuilder::sphereCounts(724, 724));
+    builder.addSphere(724, 724);
+    MeshData dense = builder.takeMeshData();
+
+    std::cout << std::endl << "Upraszczanie do bledu" << std::endl;
+    for (float targetError : {0.001f, 0.01f, 0.05f}) {
+        SimplifyOptions options;
+        options.targetError = targetError;
+        std::string suffix = " (blad " + std::to_string(targetError).substr(0, 5) + ")";
+        valid &= measure("Sfera 64x64" + suffix, sphere, options);
+        valid &= measure("Torus 64x64" + suffix, torus, options);
+        valid &= measure("Cylinder 64" + suffix, cylinder, options);
+        valid &= measure("Sfera 724x724" + suffix, dense, options);
+    }
+
+    std::cout << std::endl << "Upraszczanie do liczby trojkatow" << std::endl;
+    for (size_t divisor : {4, 16, 64}) {
+        SimplifyOptions options;
+        options.targetError = 1.0f;
+        options.targetTriangleCount = dense.indices.size() / 3 / divisor;
+        valid &= measure("Sfera 724x724 (1/" + std::to_string(divisor) + ")", dense, options);
+    }
+
+    std::cout << std::endl << "Lancuch LOD sfery 724x724" << std::endl;
+    auto start = std::chrono::high_resolution_clock::now();
+    LodChainSettings settings;
+    settings.maxLevels = 8;
+    std::vector<LodLevel> levels = LodChain::build(dense, settings);
+    auto end = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < levels.size(); ++i) {
+        std::cout << "  Poziom " << i + 1 << ": " << std::setw(8) << levels[i].data.indices.size() / 3
+                  << " trojkatow, blad " << std::fixed << std::setprecision(4) << levels[i].error << std::endl;
+        valid &= validate("Poziom " + std::to_string(i + 1), levels[i].data);
+    }
+    std::cout << "  Czas: " << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    if (!valid) {
+        std::cerr << "Blad: Upraszczanie dalo niepoprawna siatke" << std::endl;
+        return 1;
+    }
+    return 0;
+}
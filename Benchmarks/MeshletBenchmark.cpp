@@ -0,0 +1,175 @@
+// MeshletBenchmark.cpp
+// Podział siatek na meshlety i udział odrzuconych meshletów na typowych ścieżkach kamery.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+#include "../Mesh/MeshBuilder.hpp"
+#include "../Mesh/Meshlet.hpp"
+#include "../Mesh/MeshletCuller.hpp"
+#include "../Stats/RenderStats.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @struct CameraPose
+ * @brief Położenie kamery w jednej klatce ścieżki
+ */
+struct CameraPose {
+    glm::vec3 position;     /**< Pozycja kamery */
+    glm::vec3 target;       /**< Punkt, na który patrzy kamera */
+};
+
+/**
+ * @brief Sprawdza, że odrzucone meshlety nie zawierały widocznych trójkątów
+ * @param mesh Siatka (indeksy w kolejności meshletów)
+ * @param meshlets Meshlety
+ * @param drawList Zakresy uznane za widoczne
+ * @param model Macierz modelu
+ * @param frustum Ostrosłup widzenia
+ * @param eye Pozycja kamery
+ * @return true jeśli każdy trójkąt zwrócony przodem i widoczny jest rysowany
+ */
+static bool validateCulling(const MeshData& mesh, const MeshletDrawList& drawList, const glm::mat4& model,
+                            const Frustum& frustum, const glm::vec3& eye) {
+    std::vector<unsigned char> drawn(mesh.indices.size() / 3, 0);
+    for (size_t r = 0; r < drawList.counts.size(); ++r) {
+        size_t first = reinterpret_cast<size_t>(drawList.offsets[r]) / sizeof(unsigned int) / 3;
+        for (size_t t = 0; t < static_cast<size_t>(drawList.counts[r]) / 3; ++t) drawn[first + t] = 1;
+    }
+
+    for (size_t t = 0; t < drawn.size(); ++t) {
+        if (drawn[t]) continue;
+        glm::vec3 p[3];
+        for (int k = 0; k < 3; ++k) {
+            p[k] = glm::vec3(model * glm::vec4(mesh.vertices[mesh.indices[t * 3 + k]].position, 1.0f));
+        }
+        glm::vec3 normal = glm::cross(p[1] - p[0], p[2] - p[0]);
+        bool frontFacing = glm::dot(p[0] - eye, normal) < 0.0f;
+        bool inside = frustum.intersects(BoundingSphere{(p[0] + p[1] + p[2]) / 3.0f, 0.0f});
+        if (frontFacing && inside) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Odtwarza ścieżkę kamery i wypisuje udział odrzuconych meshletów
+ * @param name Nazwa ścieżki
+ * @param mesh Siatka
+ * @param meshlets Meshlety siatki
+ * @param frames Liczba klatek
+ * @param path Położenie kamery w klatce (0..1)
+ * @return true jeśli odrzucanie było zachowawcze we wszystkich klatkach
+ */
+static bool runPath(const std::string& name, const MeshData& mesh, const std::vector<Meshlet>& meshlets, int frames,
+                    const std::function<CameraPose(float)>& path) {
+    MeshletCuller& culler = MeshletCuller::instance();
+    MeshletDrawList drawList;
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 model(1.0f);
+
+    double frustumCulled = 0.0, coneCulled = 0.0, ranges = 0.0, cullMs = 0.0;
+    size_t drawnTriangles = 0;
+    bool valid = true;
+    for (int frame = 0; frame < frames; ++frame) {
+        CameraPose pose = path(static_cast<float>(frame) / frames);
+        glm::mat4 viewProjection = projection * glm::lookAt(pose.position, pose.target, glm::vec3(0.0f, 1.0f, 0.0f));
+        culler.setView(pose.position, viewProjection);
+
+        culler.beginFrame();
+        auto start = std::chrono::high_resolution_clock::now();
+        culler.cull(meshlets, model, drawList);
+        auto end = std::chrono::high_resolution_clock::now();
+        cullMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+        // Liczniki klatki odczytywane przez RenderStats
+        culler.publishStats();
+        RenderStats& stats = RenderStats::instance();
+        frustumCulled += stats.getValue("Meshlety/Odrzucone ostroslupem");
+        coneCulled += stats.getValue("Meshlety/Odrzucone stozkiem");
+        ranges += stats.getValue("Meshlety/Zakresy rysowania");
+        for (GLsizei count : drawList.counts) drawnTriangles += count / 3;
+
+        if (frame % 8 == 0) {
+            valid &= validateCulling(mesh, drawList, model, Frustum::fromMatrix(viewProjection), pose.position);
+        }
+    }
+
+    double total = static_cast<double>(meshlets.size()) * frames;
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << " ostroslup " << std::setw(5) << 100.0 * frustumCulled / total << "%"
+              << "  stozek " << std::setw(5) << 100.0 * coneCulled / total << "%"
+              << "  razem " << std::setw(5) << 100.0 * (frustumCulled + coneCulled) / total << "%"
+              << "  trojkaty " << std::setw(5) << 100.0 * drawnTriangles / (static_cast<double>(mesh.indices.size() / 3) * frames) << "%"
+              << "  zakresy " << std::setw(6) << ranges / frames
+              << "  " << std::setprecision(3) << cullMs / frames << " ms/klatke"
+              << (valid ? "" : "  BLAD") << std::endl;
+    return valid;
+}
+
+/**
+ * @brief Dzieli siatkę na meshlety i odtwarza na niej ścieżki kamery
+ * @param name Nazwa siatki
+ * @param mesh Siatka
+ * @param size Promień obiektu (skala ścieżek)
+ * @return true jeśli odrzucanie było zachowawcze
+ */
+static bool measureMesh(const std::string& name, MeshData mesh, float size) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<Meshlet> meshlets = MeshletBuilder::build(mesh);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    size_t vertices = 0, usableCones = 0;
+    for (const Meshlet& meshlet : meshlets) {
+        vertices += meshlet.vertexCount;
+        if (meshlet.coneCutoff < 1.0f) usableCones++;
+    }
+    std::cout << std::endl << name << ": " << mesh.indices.size() / 3 << " trojkatow, " << meshlets.size()
+              << " meshletow (srednio " << std::setprecision(1) << std::fixed
+              << static_cast<double>(mesh.indices.size() / 3) / meshlets.size() << " trojkatow, "
+              << static_cast<double>(vertices) / meshlets.size() << " wierzcholkow, stozek w "
+              << 100.0 * usableCones / meshlets.size() << "%), podzial "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    const float pi = 3.14159265f;
+    const int frames = 240;
+    bool valid = true;
+    valid &= runPath("Orbita", mesh, meshlets, frames, [&](float t) {
+        float angle = t * 2.0f * pi;
+        return CameraPose{glm::vec3(std::cos(angle), 0.3f, std::sin(angle)) * (size * 4.0f), glm::vec3(0.0f)};
+    });
+    valid &= runPath("Zblizenie", mesh, meshlets, frames, [&](float t) {
+        float angle = t * 2.0f * pi;
+        return CameraPose{glm::vec3(std::cos(angle), 0.2f, std::sin(angle)) * (size * 1.6f), glm::vec3(0.0f)};
+    });
+    valid &= runPath("Przelot obok", mesh, meshlets, frames, [&](float t) {
+        glm::vec3 position(size * (-6.0f + 12.0f * t), size * 0.5f, size * 2.5f);
+        return CameraPose{position, position + glm::vec3(1.0f, 0.0f, -0.3f)};
+    });
+    return valid;
+}
+
+int main() {
+    bool valid = true;
+    MeshBuilder builder;
+
+    builder.reserve(MeshBuilder::sphereCounts(256, 256));
+    builder.addSphere(256, 256);
+    valid &= measureMesh("Sfera 256x256", builder.takeMeshData(), 1.0f);
+
+    builder.reserve(MeshBuilder::torusCounts(256, 256));
+    builder.addTorus(0.5f, 0.2f, 256, 256);
+    valid &= measureMesh("Torus 256x256", builder.takeMeshData(), 0.7f);
+
+    builder.reserve(MeshBuilder::cylinderCounts(1024));
+    builder.addCylinder(1024);
+    valid &= measureMesh("Cylinder 1024", builder.takeMeshData(), 1.2f);
+
+    if (!valid) {
+        std::cerr << "Blad: Odrzucono meshlet z widocznymi trojkatami" << std::endl;
+        return 1;
+    }
+    return 0;
+}
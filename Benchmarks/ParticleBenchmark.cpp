@@ -0,0 +1,213 @@
+// ParticleBenchmark.cpp
+// Pomiar czasu symulacji miliona cząsteczek: układ SoA z SIMD i wątkami
+// a tablica struktur przetwarzana skalarnie.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+#include "../Math/Simd.hpp"
+#include "../Particles/ParticleSystem.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * @struct ScalarParticle
+ * @brief Cząsteczka w układzie AoS (punkt odniesienia)
+ */
+struct ScalarParticle {
+    glm::vec3 position;     /**< Pozycja */
+    glm::vec3 velocity;     /**< Prędkość */
+    float age;              /**< Wiek [s] */
+    float lifetime;         /**< Czas życia [s] */
+};
+
+/**
+ * @brief Symulacja cząsteczek w tablicy struktur, jednym wątkiem
+ *
+ * Martwa cząsteczka zastępowana jest ostatnią (bez zachowania kolejności),
+ * jak w typowej prostej implementacji.
+ */
+class ScalarParticles {
+private:
+    ParticleEmitterSettings m_settings;         /**< Parametry emitera */
+    std::vector<ScalarParticle> m_particles;    /**< Żywe cząsteczki */
+    std::mt19937 m_random;                      /**< Generator liczb losowych */
+    size_t m_capacity;                          /**< Największa liczba cząsteczek */
+    float m_emitAccumulator;                    /**< Ułamek cząsteczki przeniesiony do następnego kroku */
+
+public:
+    ScalarParticles(const ParticleEmitterSettings& settings, size_t capacity)
+        : m_settings(settings), m_random(1234), m_capacity(capacity), m_emitAccumulator(0.0f) {
+        m_particles.reserve(capacity);
+    }
+
+    size_t getCount() const { return m_particles.size(); }
+
+    void update(float dt) {
+        const float damping = std::max(0.0f, 1.0f - m_settings.drag * dt);
+        for (size_t i = 0; i < m_particles.size();) {
+            ScalarParticle& particle = m_particles[i];
+            particle.velocity = particle.velocity * damping + m_settings.gravity * dt;
+            particle.position += particle.velocity * dt;
+            if (particle.position.y < m_settings.floorHeight) {
+                particle.position.y = m_settings.floorHeight;
+                particle.velocity.y *= -m_settings.restitution;
+            }
+            particle.age += dt;
+            if (particle.age >= particle.lifetime) {
+                particle = m_particles.back();
+                m_particles.pop_back();
+            } else {
+                ++i;
+            }
+        }
+
+        m_emitAccumulator += m_settings.rate * dt;
+        size_t requested = static_cast<size_t>(m_emitAccumulator);
+        m_emitAccumulator -= static_cast<float>(requested);
+        size_t emitted = std::min(requested, m_capacity - m_particles.size());
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (size_t i = 0; i < emitted; ++i) {
+            ScalarParticle particle;
+            particle.position = m_settings.position + m_settings.positionSpread *
+                                glm::vec3(unit(m_random), unit(m_random), unit(m_random));
+            particle.velocity = m_settings.velocity + m_settings.velocitySpread *
+                                glm::vec3(unit(m_random), unit(m_random), unit(m_random));
+            particle.age = 0.0f;
+            particle.lifetime = m_settings.minLifetime +
+                                (m_settings.maxLifetime - m_settings.minLifetime) * (unit(m_random) * 0.5f + 0.5f);
+            m_particles.push_back(particle);
+        }
+    }
+};
+
+/**
+ * @brief Sprawdza zgodność przejść SIMD z pętlą skalarną
+ * @param count Liczba cząsteczek (także niepodzielna przez 4)
+ * @return true jeśli wyniki są zgodne
+ */
+static bool checkKernels(size_t count) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<float> arrays[8];
+    for (std::vector<float>& array : arrays) {
+        array.resize(count);
+        for (float& value : array) value = unit(random) * 2.0f;
+    }
+    std::vector<float> reference[8];
+    for (int k = 0; k < 8; ++k) reference[k] = arrays[k];
+
+    const float dt = 1.0f / 60.0f, gy = -9.81f, damping = 0.99f, floorHeight = -1.0f, restitution = 0.5f;
+    Simd::integrateParticles(arrays[0].data(), arrays[1].data(), arrays[2].data(), arrays[3].data(),
+                             arrays[4].data(), arrays[5].data(), arrays[6].data(), count, dt, 0.0f, gy, 0.0f,
+                             damping, floorHeight, restitution);
+    std::vector<uint32_t> expired(count);
+    size_t expiredCount = Simd::findExpiredParticles(arrays[6].data(), arrays[7].data(), count, expired.data());
+    std::vector<float> instances(count * 4);
+    Simd::storeParticleInstances(arrays[0].data(), arrays[1].data(), arrays[2].data(), arrays[6].data(),
+                                 arrays[7].data(), count, instances.data());
+
+    float maxDifference = 0.0f;
+    size_t expectedExpired = 0;
+    bool sameExpired = true;
+    for (size_t i = 0; i < count; ++i) {
+        float* r[8];
+        for (int k = 0; k < 8; ++k) r[k] = &reference[k][i];
+        *r[3] = *r[3] * damping;
+        *r[4] = *r[4] * damping + gy * dt;
+        *r[5] = *r[5] * damping;
+        *r[0] += *r[3] * dt;
+        *r[1] += *r[4] * dt;
+        *r[2] += *r[5] * dt;
+        if (*r[1] < floorHeight) {
+            *r[1] = floorHeight;
+            *r[4] *= -restitution;
+        }
+        *r[6] += dt;
+        for (int k = 0; k < 7; ++k) maxDifference = std::max(maxDifference, std::fabs(*r[k] - arrays[k][i]));
+        const float instance[4] = {*r[0], *r[1], *r[2], *r[6] / *r[7]};
+        for (int k = 0; k < 4; ++k) {
+            maxDifference = std::max(maxDifference, std::fabs(instance[k] - instances[i * 4 + k]));
+        }
+        if (*r[6] >= *r[7]) {
+            sameExpired &= expectedExpired < expiredCount && expired[expectedExpired] == i;
+            ++expectedExpired;
+        }
+    }
+    bool same = sameExpired && expectedExpired == expiredCount && maxDifference <= 1e-5f;
+    std::cout << std::left << std::setw(44) << ("Calkowanie, instancje i martwe, " + std::to_string(count))
+              << (same ? " zgodne" : " NIEZGODNE") << "  maks. roznica: " << maxDifference << std::endl;
+    return same;
+}
+
+/**
+ * @brief Mierzy średni czas kroku symulacji po dojściu do stanu ustalonego
+ * @param name Nazwa pomiaru
+ * @param warmupSteps Kroki przed pomiarem
+ * @param steps Mierzone kroki
+ * @param step Funkcja wykonująca krok (zwraca liczbę żywych cząsteczek)
+ */
+template <typename Step>
+static void measure(const char* name, int warmupSteps, int steps, Step step) {
+    for (int i = 0; i < warmupSteps; ++i) step();
+    double best = 1e30;
+    double total = 0.0;
+    size_t count = 0;
+    for (int i = 0; i < steps; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        count = step();
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best = std::min(best, ms);
+        total += ms;
+    }
+    std::cout << std::left << std::setw(44) << name
+              << " najlepszy: " << std::fixed << std::setprecision(3) << best << " ms"
+              << "  sredni: " << total / steps << " ms"
+              << "  zywe: " << count << std::endl;
+}
+
+int main() {
+    std::cout << "Zgodnosc z wersja skalarna" << std::endl;
+    bool allSame = true;
+    for (size_t count : {1, 3, 4, 1001, 65536}) allSame &= checkKernels(count);
+    if (!allSame) {
+        std::cerr << "Blad: Przejscia SIMD daja inny wynik niz wersja skalarna" << std::endl;
+        return 1;
+    }
+
+    // Fontanna jak w main.cpp: 250 tys. nowych cząsteczek na sekundę, życie 3-5 s
+    ParticleEmitterSettings settings;
+    settings.velocity = glm::vec3(0.0f, 9.0f, 0.0f);
+    settings.velocitySpread = glm::vec3(2.0f, 1.5f, 2.0f);
+    settings.rate = 250000.0f;
+    settings.minLifetime = 3.0f;
+    settings.maxLifetime = 5.0f;
+    settings.drag = 0.2f;
+    settings.floorHeight = -2.0f;
+    const float dt = 1.0f / 60.0f;
+    const int warmupSteps = 300;
+    const int steps = 120;
+
+    std::cout << std::endl << "Krok symulacji (60 Hz, stan ustalony okolo 1 mln czasteczek, "
+              << ThreadPool::instance().getThreadCount() + 1 << " watkow)" << std::endl;
+    ScalarParticles scalar(settings, ParticleSystem::DEFAULT_CAPACITY);
+    measure("AoS skalarnie, jeden watek", warmupSteps, steps, [&]() {
+        scalar.update(dt);
+        return scalar.getCount();
+    });
+
+    ParticleSystem system;
+    system.setSettings(settings);
+    system.setEmitting(true);
+    measure("SoA SIMD + watki (ParticleSystem)", warmupSteps, steps, [&]() {
+        system.update(dt);
+        return system.getCount();
+    });
+
+    return 0;
+}
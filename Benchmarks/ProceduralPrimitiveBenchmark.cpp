@@ -0,0 +1,395 @@
+// ProceduralPrimitiveBenchmark.cpp
+// Bryły generowane z gl_VertexID w porównaniu z siatkami z buforów wierzchołków.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS. Zgodność z MeshBuilder sprawdzana
+// jest na CPU; pomiar GPU wymaga kontekstu OpenGL (ukryte okno GLFW).
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include "../Mesh/MeshBuilder.hpp"
+#include "../Procedural/ProceduralPrimitives.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Wspólna część vertex shaderów pomiaru: dane instancji i kamera
+ *
+ * Obie ścieżki czytają te same 6 tekseli instancji co ProceduralRenderer,
+ * więc różnią się wyłącznie źródłem wierzchołków.
+ */
+static const char* benchmarkCommonSource = R"(
+uniform samplerBuffer instanceData;
+uniform int instanceOffset;
+uniform mat4 viewProjection;
+out vec3 Normal;
+
+mat4 instanceModel(out vec4 shape) {
+    int base = (instanceOffset + gl_InstanceID) * 6;
+    shape = texelFetch(instanceData, base + 5);
+    return mat4(texelFetch(instanceData, base), texelFetch(instanceData, base + 1),
+                texelFetch(instanceData, base + 2), texelFetch(instanceData, base + 3));
+}
+)";
+
+static const char* bufferedVertexSource = R"(
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+
+void main() {
+    vec4 shape;
+    mat4 model = instanceModel(shape);
+    Normal = mat3(model) * aNormal;
+    gl_Position = viewProjection * model * vec4(aPos, 1.0);
+}
+)";
+
+static const char* proceduralVertexSource = R"(
+void main() {
+    vec4 shape;
+    mat4 model = instanceModel(shape);
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+    proceduralVertex(int(shape.x), ivec2(shape.yz), shape.w, gl_VertexID, position, normal, uv);
+    Normal = mat3(model) * normal;
+    gl_Position = viewProjection * model * vec4(position, 1.0);
+}
+)";
+
+static const char* benchmarkFragmentSource = R"(
+#version 330 core
+in vec3 Normal;
+out vec4 FragColor;
+
+void main() {
+    float diffuse = max(dot(normalize(Normal), normalize(vec3(0.3, 1.0, 0.5))), 0.0);
+    FragColor = vec4(vec3(0.1 + 0.9 * diffuse), 1.0);
+}
+)";
+
+/**
+ * @struct Variant
+ * @brief Kształt z podziałem (jedna siatka ścieżki buforowanej)
+ */
+struct Variant {
+    PrimitiveType shape;    /**< Kształt */
+    int sectors;            /**< Liczba sektorów */
+    float parameter;        /**< Parametr kształtu */
+};
+
+/**
+ * @struct BufferedMesh
+ * @brief Siatka wariantu w buforach GPU
+ */
+struct BufferedMesh {
+    GLuint vao;             /**< VAO */
+    GLuint vbo;             /**< Bufor wierzchołków */
+    GLuint ebo;             /**< Bufor indeksów */
+    GLsizei indexCount;     /**< Liczba indeksów */
+    size_t bytes;           /**< Rozmiar buforów w bajtach */
+};
+
+/**
+ * @brief Buduje siatkę wariantu w MeshBuilder (ten sam układ co bryła proceduralna)
+ * @param variant Kształt i podział
+ * @return Siatka indeksowana
+ */
+static MeshData buildReference(const Variant& variant) {
+    MeshBuilder builder;
+    int rows = ProceduralPrimitives::getRows(variant.shape, variant.sectors);
+    if (variant.shape == PrimitiveType::SPHERE) {
+        builder.addSphere(variant.sectors, rows);
+    } else if (variant.shape == PrimitiveType::CYLINDER) {
+        builder.addCylinder(variant.sectors);
+    } else {
+        builder.addTorus(1.0f, variant.parameter, variant.sectors, rows);
+    }
+    return builder.takeMeshData();
+}
+
+/**
+ * @brief Zamienia trójkąt na klucz niezależny od wierzchołka początkowego
+ * @param p Wierzchołki trójkąta (obracane tak, by najmniejszy był pierwszy)
+ * @return Zaokrąglone współrzędne w kolejności obiegu
+ */
+static std::array<long long, 9> triangleKey(std::array<Vertex, 3>& p) {
+    auto quantize = [](float value) { return static_cast<long long>(std::lround(value * 1.0e4f)); };
+    auto pointKey = [&](const glm::vec3& v) { return std::array<long long, 3>{quantize(v.x), quantize(v.y), quantize(v.z)}; };
+    int first = 0;
+    for (int k = 1; k < 3; ++k) {
+        if (pointKey(p[k].position) < pointKey(p[first].position)) first = k;
+    }
+    std::rotate(p.begin(), p.begin() + first, p.end());
+    std::array<long long, 9> key{};
+    for (int k = 0; k < 3; ++k) {
+        std::array<long long, 3> point = pointKey(p[k].position);
+        std::copy(point.begin(), point.end(), key.begin() + k * 3);
+    }
+    return key;
+}
+
+/**
+ * @brief Sprawdza, że generateVertex() odtwarza siatkę MeshBuilder
+ * @param variant Kształt i podział
+ * @return true jeśli zbiory trójkątów (z kolejnością obiegu), normalne i UV są zgodne
+ *
+ * @details Trójkąty zdegenerowane (bieguny, środki podstaw) są pomijane.
+ */
+static bool validateVariant(const Variant& variant) {
+    MeshData reference = buildReference(variant);
+    std::map<std::array<long long, 9>, std::array<Vertex, 3>> expected;
+    for (size_t t = 0; t + 2 < reference.indices.size(); t += 3) {
+        std::array<Vertex, 3> triangle = {reference.vertices[reference.indices[t]],
+                                          reference.vertices[reference.indices[t + 1]],
+                                          reference.vertices[reference.indices[t + 2]]};
+        expected[triangleKey(triangle)] = triangle;
+    }
+
+    int rows = ProceduralPrimitives::getRows(variant.shape, variant.sectors);
+    int vertexCount = ProceduralPrimitives::getVertexCount(variant.sectors, rows);
+    size_t matched = 0;
+    for (int id = 0; id < vertexCount; id += 3) {
+        std::array<Vertex, 3> triangle;
+        for (int k = 0; k < 3; ++k) {
+            triangle[k] = ProceduralPrimitives::generateVertex(variant.shape, variant.sectors, rows, variant.parameter, id + k);
+        }
+        glm::vec3 area = glm::cross(triangle[1].position - triangle[0].position, triangle[2].position - triangle[0].position);
+        if (glm::length(area) < 1.0e-6f) continue;
+
+        auto found = expected.find(triangleKey(triangle));
+        if (found == expected.end()) return false;
+        for (int k = 0; k < 3; ++k) {
+            if (glm::length(found->second[k].normal - triangle[k].normal) > 1.0e-3f) return false;
+            if (glm::length(found->second[k].texCoord - triangle[k].texCoord) > 1.0e-3f) return false;
+        }
+        matched++;
+    }
+    return matched == expected.size();
+}
+
+/**
+ * @brief Kompiluje program z fragmentów kodu
+ * @param vertexSources Fragmenty vertex shadera
+ * @return ID programu lub 0 w przypadku błędu
+ */
+static GLuint linkProgram(const std::vector<const char*>& vertexSources) {
+    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, static_cast<GLsizei>(vertexSources.size()), vertexSources.data(), NULL);
+    glCompileShader(vertexShader);
+    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &benchmarkFragmentSource, NULL);
+    glCompileShader(fragmentShader);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Blad linkowania shadera pomiaru:\n" << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+/**
+ * @brief Wysyła siatkę wariantu do buforów GPU
+ * @param variant Kształt i podział
+ * @return Siatka w buforach
+ */
+static BufferedMesh uploadVariant(const Variant& variant) {
+    MeshData data = buildReference(variant);
+    BufferedMesh mesh;
+    glGenVertexArrays(1, &mesh.vao);
+    glGenBuffers(1, &mesh.vbo);
+    glGenBuffers(1, &mesh.ebo);
+    glBindVertexArray(mesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(Vertex), data.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(unsigned int), data.indices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    glEnableVertexAttribArray(2);
+    glBindVertexArray(0);
+    mesh.indexCount = static_cast<GLsizei>(data.indices.size());
+    mesh.bytes = data.vertices.size() * sizeof(Vertex) + data.indices.size() * sizeof(unsigned int);
+    return mesh;
+}
+
+/**
+ * @brief Mierzy czas GPU rysowania tych samych instancji obiema ścieżkami
+ * @param name Nazwa przypadku
+ * @param instanceCount Liczba instancji
+ * @param variants Warianty (instancja i używa wariantu i % variants.size())
+ */
+static void measureGpu(const std::string& name, int instanceCount, const std::vector<Variant>& variants) {
+    // Instancje na siatce przed kamerą, posortowane według wariantu (jedna grupa na wariant)
+    std::vector<glm::vec4> instanceData;
+    std::vector<GLsizei> groupFirst, groupCount;
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(instanceCount))));
+    float spacing = 40.0f / side;
+    for (size_t v = 0; v < variants.size(); ++v) {
+        groupFirst.push_back(static_cast<GLsizei>(instanceData.size() / 6));
+        for (int i = static_cast<int>(v); i < instanceCount; i += static_cast<int>(variants.size())) {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3((i % side - side * 0.5f) * spacing,
+                                                                        (i / side - side * 0.5f) * spacing, -50.0f));
+            model = glm::scale(model, glm::vec3(spacing * 0.4f));
+            int rows = ProceduralPrimitives::getRows(variants[v].shape, variants[v].sectors);
+            for (int c = 0; c < 4; ++c) instanceData.push_back(model[c]);
+            instanceData.push_back(glm::vec4(0.0f));
+            instanceData.push_back(glm::vec4(static_cast<float>(variants[v].shape), static_cast<float>(variants[v].sectors),
+                                             static_cast<float>(rows), variants[v].parameter));
+        }
+        groupCount.push_back(static_cast<GLsizei>(instanceData.size() / 6) - groupFirst.back());
+    }
+
+    GLuint instanceBuffer, instanceTexture;
+    glGenBuffers(1, &instanceBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, instanceBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, instanceData.size() * sizeof(glm::vec4), instanceData.data(), GL_STATIC_DRAW);
+    glGenTextures(1, &instanceTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, instanceTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, instanceBuffer);
+
+    GLuint buffered = linkProgram({"#version 330 core\n", benchmarkCommonSource, bufferedVertexSource});
+    GLuint procedural = linkProgram({"#version 330 core\n", ProceduralPrimitives::getShaderSource(),
+                                     benchmarkCommonSource, proceduralVertexSource});
+    std::vector<BufferedMesh> meshes;
+    size_t bufferedBytes = 0;
+    for (const Variant& variant : variants) {
+        meshes.push_back(uploadVariant(variant));
+        bufferedBytes += meshes.back().bytes;
+    }
+    GLuint emptyVAO;
+    glGenVertexArrays(1, &emptyVAO);
+
+    glm::mat4 viewProjection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+    const int frames = 20;
+    GLuint query;
+    glGenQueries(1, &query);
+    double times[2] = {0.0, 0.0};
+    for (int path = 0; path < 2; ++path) {
+        GLuint program = path == 0 ? buffered : procedural;
+        glUseProgram(program);
+        glUniformMatrix4fv(glGetUniformLocation(program, "viewProjection"), 1, GL_FALSE, glm::value_ptr(viewProjection));
+        glUniform1i(glGetUniformLocation(program, "instanceData"), 0);
+        GLint offsetLoc = glGetUniformLocation(program, "instanceOffset");
+
+        for (int frame = -2; frame < frames; ++frame) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            if (frame >= 0) glBeginQuery(GL_TIME_ELAPSED, query);
+            for (size_t v = 0; v < variants.size(); ++v) {
+                glUniform1i(offsetLoc, groupFirst[v]);
+                if (path == 0) {
+                    glBindVertexArray(meshes[v].vao);
+                    glDrawElementsInstanced(GL_TRIANGLES, meshes[v].indexCount, GL_UNSIGNED_INT, 0, groupCount[v]);
+                } else {
+                    int rows = ProceduralPrimitives::getRows(variants[v].shape, variants[v].sectors);
+                    glBindVertexArray(emptyVAO);
+                    glDrawArraysInstanced(GL_TRIANGLES, 0, ProceduralPrimitives::getVertexCount(variants[v].sectors, rows),
+                                          groupCount[v]);
+                }
+            }
+            if (frame >= 0) {
+                glEndQuery(GL_TIME_ELAPSED);
+                GLuint64 elapsed = 0;
+                glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+                times[path] += elapsed / 1.0e6;
+            }
+        }
+    }
+
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(3)
+              << " bufory " << std::setw(8) << times[0] / frames << " ms"
+              << "  proceduralnie " << std::setw(8) << times[1] / frames << " ms"
+              << "  pamiec wierzcholkow " << std::setprecision(1) << bufferedBytes / 1024.0 << " KB -> 0 KB" << std::endl;
+
+    glDeleteQueries(1, &query);
+    glDeleteVertexArrays(1, &emptyVAO);
+    for (BufferedMesh& mesh : meshes) {
+        glDeleteVertexArrays(1, &mesh.vao);
+        glDeleteBuffers(1, &mesh.vbo);
+        glDeleteBuffers(1, &mesh.ebo);
+    }
+    glDeleteProgram(buffered);
+    glDeleteProgram(procedural);
+    glDeleteTextures(1, &instanceTexture);
+    glDeleteBuffers(1, &instanceBuffer);
+}
+
+int main() {
+    bool valid = true;
+    for (int sectors : {8, 16, 32, 64, 128}) {
+        valid &= validateVariant({PrimitiveType::SPHERE, sectors, 0.0f});
+        valid &= validateVariant({PrimitiveType::CYLINDER, sectors, 0.0f});
+        valid &= validateVariant({PrimitiveType::TORUS, sectors, 0.4f});
+    }
+    std::cout << "Zgodnosc z MeshBuilder (sfera, cylinder, torus; 8..128 sektorow): "
+              << (valid ? "OK" : "BLAD") << std::endl;
+    if (!valid) return 1;
+
+    if (!glfwInit()) {
+        std::cerr << "Blad: Nie udalo sie zainicjalizowac GLFW - pomiar GPU pominiety" << std::endl;
+        return 0;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    GLFWwindow* window = glfwCreateWindow(1280, 720, "ProceduralPrimitiveBenchmark", NULL, NULL);
+    if (!window) {
+        std::cerr << "Blad: Nie udalo sie utworzyc kontekstu OpenGL - pomiar GPU pominiety" << std::endl;
+        glfwTerminate();
+        return 0;
+    }
+    glfwMakeContextCurrent(window);
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        std::cerr << "Blad: Nie udalo sie zainicjalizowac GLEW - pomiar GPU pominiety" << std::endl;
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return 0;
+    }
+
+    glViewport(0, 0, 1280, 720);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    std::vector<Variant> mixed;
+    for (int sectors = ProceduralPrimitives::MIN_SECTORS; sectors <= 64; sectors *= 2) {
+        mixed.push_back({PrimitiveType::SPHERE, sectors, 0.0f});
+        mixed.push_back({PrimitiveType::CYLINDER, sectors, 0.0f});
+        mixed.push_back({PrimitiveType::TORUS, sectors, 0.3f});
+    }
+    for (int count : {1000, 10000, 50000}) {
+        std::string suffix = " x" + std::to_string(count);
+        measureGpu("Sfera 32" + suffix, count, {{PrimitiveType::SPHERE, 32, 0.0f}});
+        measureGpu("Torus 32" + suffix, count, {{PrimitiveType::TORUS, 32, 0.3f}});
+        measureGpu("Mieszane (12 wariantow)" + suffix, count, mixed);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,285 @@
+// QualityGovernorBenchmark.cpp
+// Sprawdzenie regulatora jakości na symulowanych czasach CPU i GPU:
+// kolejność obniżania przy ograniczeniu GPU i CPU, brak oscylacji
+// (histereza i karencja), powrót do pełnej jakości po spadku obciążenia
+// oraz koszt jednego wywołania QualityGovernor::update.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+// Użycie: QualityGovernorBenchmark
+#include "BenchmarkUtils.hpp"
+#include "../Quality/QualityGovernor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+/**
+ * @struct FrameCost
+ * @brief Symulowane czasy klatki
+ */
+struct FrameCost {
+    double cpuMs;   /**< Czas CPU [ms] */
+    double gpuMs;   /**< Czas GPU [ms] */
+};
+
+/** @brief Model sceny: czasy klatki przy danych ustawieniach jakości */
+using Workload = std::function<FrameCost(const QualitySettings&)>;
+
+/**
+ * @struct Decision
+ * @brief Zmiana ustawień zapisana podczas symulacji
+ */
+struct Decision {
+    int frame;                  /**< Numer klatki */
+    QualityDecision decision;   /**< Podjęta decyzja */
+};
+
+/**
+ * @class Simulation
+ * @brief Pętla klatek z opóźnieniem pomiaru GPU i szumem
+ *
+ * Czas GPU klatki znany jest dopiero po GPU_LATENCY klatkach (jak wyniki
+ * GpuTimer), a oba czasy mają ±3% deterministycznego szumu.
+ */
+class Simulation {
+public:
+    static const int GPU_LATENCY = 3;   /**< Opóźnienie pomiaru GPU w klatkach */
+
+private:
+    QualityGovernor& m_governor;        /**< Sprawdzany regulator */
+    std::deque<double> m_pendingGpu;    /**< Czasy GPU czekające na odczyt */
+    std::mt19937 m_random;              /**< Generator szumu */
+    std::vector<Decision> m_decisions;  /**< Wszystkie zmiany */
+    int m_frame;                        /**< Numer bieżącej klatki */
+
+public:
+    /**
+     * @brief Konstruktor Simulation
+     * @param governor Sprawdzany regulator
+     */
+    explicit Simulation(QualityGovernor& governor) : m_governor(governor), m_random(1234), m_frame(0) {}
+
+    /**
+     * @brief Symuluje klatki
+     * @param workload Model sceny
+     * @param frames Liczba klatek
+     * @return Czas ostatniej klatki przy końcowych ustawieniach (bez szumu)
+     */
+    double run(const Workload& workload, int frames) {
+        std::uniform_real_distribution<double> noise(0.97, 1.03);
+        for (int i = 0; i < frames; ++i, ++m_frame) {
+            FrameCost cost = workload(m_governor.getSettings());
+            m_pendingGpu.push_back(cost.gpuMs * noise(m_random));
+            double gpuMs = m_pendingGpu.front();
+            if (m_pendingGpu.size() > GPU_LATENCY) m_pendingGpu.pop_front();
+
+            QualitySettings before = m_governor.getSettings();
+            const QualitySettings& after = m_governor.update(cost.cpuMs * noise(m_random), gpuMs);
+            if (after.resolutionScale != before.resolutionScale || after.lodBias != before.lodBias ||
+                after.maxLights != before.maxLights) {
+                m_decisions.push_back({m_frame, m_governor.getLastDecision()});
+            }
+        }
+        FrameCost cost = workload(m_governor.getSettings());
+        return std::max(cost.cpuMs, cost.gpuMs);
+    }
+
+    /**
+     * @brief Zwraca zmiany od podanej pozycji
+     * @param first Indeks pierwszej zmiany
+     * @return Zmiany
+     */
+    std::vector<Decision> decisionsFrom(size_t first) const {
+        return std::vector<Decision>(m_decisions.begin() + std::min(first, m_decisions.size()), m_decisions.end());
+    }
+
+    /**
+     * @brief Zwraca liczbę wszystkich zmian
+     * @return Liczba zmian
+     */
+    size_t getDecisionCount() const { return m_decisions.size(); }
+
+    /**
+     * @brief Zwraca numer następnej klatki
+     * @return Liczba dotychczas symulowanych klatek
+     */
+    int getFrame() const { return m_frame; }
+};
+
+/**
+ * @brief Zwraca najmniejszy odstęp między kolejnymi zmianami
+ * @param decisions Zmiany
+ * @return Odstęp w klatkach (INT_MAX przy mniej niż dwóch zmianach)
+ */
+static int minimumGap(const std::vector<Decision>& decisions) {
+    int gap = std::numeric_limits<int>::max();
+    for (size_t i = 1; i < decisions.size(); ++i) gap = std::min(gap, decisions[i].frame - decisions[i - 1].frame);
+    return gap;
+}
+
+/**
+ * @brief Sprawdza, czy decyzja obniża jakość
+ * @param decision Decyzja
+ * @return true dla obniżenia
+ */
+static bool isDegrade(QualityDecision decision) {
+    return decision == QualityDecision::LOWER_RESOLUTION || decision == QualityDecision::RAISE_LOD_BIAS ||
+           decision == QualityDecision::FEWER_LIGHTS;
+}
+
+/**
+ * @brief Liczy zmiany kierunku regulacji (obniżenie po podniesieniu i odwrotnie)
+ * @param decisions Zmiany
+ * @return Liczba zmian kierunku
+ */
+static int countReversals(const std::vector<Decision>& decisions) {
+    int reversals = 0;
+    for (size_t i = 1; i < decisions.size(); ++i) {
+        if (isDegrade(decisions[i].decision) != isDegrade(decisions[i - 1].decision)) reversals++;
+    }
+    return reversals;
+}
+
+/**
+ * @brief Wypisuje ustawienia i wynik jednego scenariusza
+ * @param label Opis
+ * @param passed Czy scenariusz spełnił warunki
+ * @param settings Końcowe ustawienia
+ * @param frameMs Końcowy czas klatki [ms]
+ * @param changes Liczba zmian w scenariuszu
+ */
+static void printScenario(const char* label, bool passed, const QualitySettings& settings, double frameMs,
+                          size_t changes) {
+    std::cout << std::left << std::setw(40) << label << (passed ? " zgodne" : " NIEZGODNE") << std::right
+              << std::fixed << std::setprecision(2) << "  skala: " << settings.resolutionScale
+              << ", LOD: " << std::setprecision(1) << settings.lodBias << ", swiatla: " << settings.maxLights
+              << ", klatka: " << std::setprecision(2) << frameMs << " ms, zmian: " << changes << std::endl;
+}
+
+int main() {
+    const double target = 1000.0 / 60.0;
+    const int cooldown = 15;
+    bool valid = true;
+
+    // Wypełnianie rośnie z kwadratem skali rozdzielczości
+    Workload gpuBound = [](const QualitySettings& s) {
+        return FrameCost{8.0, 30.0 * s.resolutionScale * s.resolutionScale};
+    };
+    // Koszt CPU zależy od liczby świateł i szczegółowości geometrii, nie od rozdzielczości
+    Workload cpuBound = [](const QualitySettings& s) {
+        return FrameCost{6.0 + 1.5 * s.maxLights + 2.0 * (QualityGovernor::MAX_LOD_BIAS - s.lodBias), 5.0};
+    };
+    Workload inBand = [](const QualitySettings&) { return FrameCost{5.0, 15.0}; };
+    Workload light = [](const QualitySettings&) { return FrameCost{4.0, 4.0}; };
+
+    std::cout << "Regulator jakosci (cel " << std::fixed << std::setprecision(2) << target << " ms, karencja "
+              << cooldown << " klatek, opoznienie GPU " << Simulation::GPU_LATENCY << " klatki)" << std::endl;
+
+    // Ograniczenie GPU: najpierw rozdzielczość, reszta bez zmian
+    {
+        QualityGovernor governor(target, 8);
+        governor.setCooldown(cooldown);
+        Simulation simulation(governor);
+        double frameMs = simulation.run(gpuBound, 600);
+        size_t settled = simulation.getDecisionCount();
+        simulation.run(gpuBound, 1200);
+        std::vector<Decision> decisions = simulation.decisionsFrom(0);
+        const QualitySettings& s = governor.getSettings();
+        bool passed = !decisions.empty() && decisions.front().decision == QualityDecision::LOWER_RESOLUTION &&
+                      s.resolutionScale < 1.0f && s.lodBias == 0.0f && s.maxLights == 8 &&
+                      frameMs <= target * 1.05 && simulation.getDecisionCount() == settled &&
+                      minimumGap(decisions) >= cooldown;
+        printScenario("Ograniczenie GPU", passed, s, frameMs, decisions.size());
+        valid = valid && passed;
+    }
+
+    // Ograniczenie CPU: przesunięcie LOD do maksimum, potem światła; rozdzielczość bez zmian
+    QualityGovernor governor(target, 8);
+    governor.setCooldown(cooldown);
+    Simulation simulation(governor);
+    {
+        double frameMs = simulation.run(cpuBound, 600);
+        size_t settled = simulation.getDecisionCount();
+        simulation.run(cpuBound, 1200);
+        std::vector<Decision> decisions = simulation.decisionsFrom(0);
+        const QualitySettings& s = governor.getSettings();
+        bool ordered = decisions.size() > 4;
+        for (size_t i = 0; ordered && i < decisions.size(); ++i) {
+            QualityDecision expected = i < 4 ? QualityDecision::RAISE_LOD_BIAS : QualityDecision::FEWER_LIGHTS;
+            ordered = decisions[i].decision == expected;
+        }
+        bool passed = ordered && s.resolutionScale == 1.0f && s.lodBias == QualityGovernor::MAX_LOD_BIAS &&
+                      s.maxLights < 8 && frameMs <= target * 1.05 && simulation.getDecisionCount() == settled &&
+                      minimumGap(decisions) >= cooldown;
+        printScenario("Ograniczenie CPU", passed, s, frameMs, decisions.size());
+        valid = valid && passed;
+    }
+
+    // Histereza: czasy w paśmie między progami nie zmieniają ustawień
+    {
+        size_t first = simulation.getDecisionCount();
+        double frameMs = simulation.run(inBand, 1200);
+        std::vector<Decision> decisions = simulation.decisionsFrom(first);
+        bool passed = decisions.empty();
+        printScenario("Histereza (czasy w pasmie)", passed, governor.getSettings(), frameMs, decisions.size());
+        valid = valid && passed;
+    }
+
+    // Powrót: po spadku obciążenia jakość wraca do pełnej, bez obniżeń po drodze
+    {
+        size_t first = simulation.getDecisionCount();
+        int startFrame = simulation.getFrame();
+        double frameMs = simulation.run(light, 3000);
+        std::vector<Decision> decisions = simulation.decisionsFrom(first);
+        const QualitySettings& s = governor.getSettings();
+        bool passed = s.resolutionScale == 1.0f && s.lodBias == 0.0f && s.maxLights == 8 &&
+                      countReversals(decisions) == 0 && minimumGap(decisions) >= 2 * cooldown;
+        printScenario("Powrot do pelnej jakosci", passed, s, frameMs, decisions.size());
+        if (!decisions.empty()) {
+            std::cout << "  Pelna jakosc po " << decisions.back().frame - startFrame + 1
+                      << " klatkach, najmniejszy odstep zmian: " << minimumGap(decisions) << std::endl;
+        }
+        valid = valid && passed;
+    }
+
+    // Obciążenie na granicy progu z szumem: mało zmian i brak oscylacji
+    {
+        QualityGovernor edge(target, 8);
+        edge.setCooldown(cooldown);
+        Simulation edgeSimulation(edge);
+        Workload boundary = [](const QualitySettings& s) {
+            return FrameCost{8.0, 17.3 * s.resolutionScale * s.resolutionScale};
+        };
+        double frameMs = edgeSimulation.run(boundary, 3000);
+        std::vector<Decision> decisions = edgeSimulation.decisionsFrom(0);
+        bool passed = countReversals(decisions) == 0 && decisions.size() <= 2 &&
+                      minimumGap(decisions) >= cooldown;
+        printScenario("Obciazenie na progu (szum 3%)", passed, edge.getSettings(), frameMs, decisions.size());
+        valid = valid && passed;
+    }
+
+    if (!valid) {
+        std::cerr << "Blad: Regulator jakosci nie spelnia oczekiwanej kolejnosci lub oscyluje" << std::endl;
+        return 1;
+    }
+
+    // Koszt regulatora na klatkę
+    const int updates = 10000000;
+    QualityGovernor timed(target, 8);
+    timed.setCooldown(cooldown);
+    double sink = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < updates; ++i) {
+        sink += timed.update(12.0 + (i & 15), 10.0 + (i & 7)).resolutionScale;
+    }
+    double updateMs = BenchmarkUtils::elapsedMs(start);
+    std::cout << std::endl;
+    BenchmarkUtils::printTiming("QualityGovernor::update", updateMs, updates, "ns/klatka", 1e6);
+    if (sink < 0.0) std::cout << sink << std::endl;
+    return 0;
+}
@@ -0,0 +1,254 @@
+// RayCastImpostorBenchmark.cpp
+// Sfery śledzone promieniem (RayCastRenderer) w porównaniu z instancjonowaną siatką sfery.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS; wymaga kontekstu OpenGL (ukryte okno GLFW).
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include "../Impostor/RayCastRenderer.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Mesh/MeshBuilder.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Stats/RenderStats.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Vertex shader ścieżki siatkowej: siatka sfery jednostkowej na instancję
+ *
+ * Środek i promień instancji pobierane są z tekstury buforowej, tak jak
+ * w RayCastRenderer, więc ścieżki różnią się tylko geometrią.
+ */
+static const char* meshVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+uniform samplerBuffer spheres;
+out vec3 Normal;
+
+void main() {
+    vec4 sphere = texelFetch(spheres, gl_InstanceID);
+    Normal = aNormal;
+    gl_Position = projection * view * vec4(sphere.xyz + aPos * sphere.w, 1.0);
+}
+)";
+
+static const char* meshFragmentSource = R"(
+#version 330 core
+in vec3 Normal;
+out vec4 FragColor;
+
+void main() {
+    float diffuse = max(dot(normalize(Normal), normalize(vec3(0.3, 1.0, 0.5))), 0.0);
+    FragColor = vec4(vec3(0.1 + 0.9 * diffuse), 1.0);
+}
+)";
+
+/**
+ * @brief Kompiluje program ścieżki siatkowej
+ * @return ID programu lub 0 w przypadku błędu
+ */
+static GLuint linkMeshProgram() {
+    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &meshVertexSource, NULL);
+    glCompileShader(vertexShader);
+    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &meshFragmentSource, NULL);
+    glCompileShader(fragmentShader);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    MultiViewRenderer::setupProgram(program);
+    return program;
+}
+
+/**
+ * @brief Mierzy średni czas GPU klatki
+ * @param frames Liczba mierzonych klatek (po dwóch rozgrzewających)
+ * @param drawFrame Rysowanie jednej klatki
+ * @return Czas w milisekundach
+ */
+template <typename DrawFrame>
+static double measureFrames(int frames, DrawFrame drawFrame) {
+    GLuint query;
+    glGenQueries(1, &query);
+    double total = 0.0;
+    for (int frame = -2; frame < frames; ++frame) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        if (frame >= 0) glBeginQuery(GL_TIME_ELAPSED, query);
+        drawFrame();
+        if (frame >= 0) {
+            glEndQuery(GL_TIME_ELAPSED);
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+            total += elapsed / 1.0e6;
+        }
+    }
+    glDeleteQueries(1, &query);
+    return total / frames;
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Blad: Nie udalo sie zainicjalizowac GLFW" << std::endl;
+        return 1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    const int width = 1920, height = 1080;
+    GLFWwindow* window = glfwCreateWindow(width, height, "RayCastImpostorBenchmark", NULL, NULL);
+    if (!window) {
+        std::cerr << "Blad: Nie udalo sie utworzyc kontekstu OpenGL" << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        std::cerr << "Blad: Nie udalo sie zainicjalizowac GLEW" << std::endl;
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return 1;
+    }
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    // Kamera, światło kierunkowe i materiały jak w scenie
+    MultiViewRenderer multiView;
+    LightCuller lightCuller;
+    RayCastRenderer rayCast;
+    GLuint meshProgram = 0;
+    if (!multiView.initialize() || !lightCuller.initialize() || !MaterialTable::instance().initialize() ||
+        !rayCast.initialize() || (meshProgram = linkMeshProgram()) == 0) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow pomiaru" << std::endl;
+        return 1;
+    }
+    glm::vec3 eye(0.0f, 30.0f, 120.0f);
+    glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), static_cast<float>(width) / height, 0.5f, 500.0f);
+    multiView.addView({"Pomiar", 0, 0, width, height, view, projection, eye, false});
+
+    Light sun{};
+    sun.direction = glm::vec3(-0.3f, -1.0f, -0.5f);
+    sun.color = glm::vec3(1.0f);
+    sun.ambientIntensity = 0.1f;
+    sun.diffuseIntensity = 0.8f;
+    sun.specularIntensity = 0.5f;
+    sun.constant = 1.0f;
+    sun.type = 1;
+    lightCuller.update({sun}, {}, 1);
+    lightCuller.bind();
+    MaterialTable::instance().bind();
+    multiView.beginFrame({}, &lightCuller);
+    multiView.bindView(0);
+    Frustum frustum = Frustum::fromMatrix(projection * view);
+
+    MeshBuilder builder;
+    builder.addSphere(16, 8);
+    MeshData lowSphere = builder.takeMeshData();
+    GLuint vao, vbo, ebo;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, lowSphere.vertices.size() * sizeof(Vertex), lowSphere.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, lowSphere.indices.size() * sizeof(unsigned int), lowSphere.indices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+
+    std::cout << "Siatka sfery 16x8: " << lowSphere.indices.size() / 3 << " trojkatow na instancje" << std::endl;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int count : {1000000, 4000000, 10000000}) {
+        // Sfery w sześcianie o boku proporcjonalnym do pierwiastka sześciennego liczby
+        float side = 0.35f * std::cbrt(static_cast<float>(count));
+        std::vector<glm::vec4> spheres(count);
+        rayCast.clear();
+        for (glm::vec4& sphere : spheres) {
+            sphere = glm::vec4(unit(random) * side, unit(random) * side * 0.5f, unit(random) * side, 0.15f);
+            rayCast.addSphere(glm::vec3(sphere), sphere.w, glm::vec3(0.8f));
+        }
+        rayCast.prepare(lightCuller.getGlobalList());
+
+        GLuint sphereBuffer, sphereTexture;
+        glGenBuffers(1, &sphereBuffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, sphereBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, spheres.size() * sizeof(glm::vec4), spheres.data(), GL_STATIC_DRAW);
+        glGenTextures(1, &sphereTexture);
+        glActiveTexture(GL_TEXTURE0 + RayCastRenderer::PRIMITIVE_DATA_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, sphereTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, sphereBuffer);
+        glActiveTexture(GL_TEXTURE0);
+        glUseProgram(meshProgram);
+        glUniform1i(glGetUniformLocation(meshProgram, "spheres"), RayCastRenderer::PRIMITIVE_DATA_TEXTURE_UNIT);
+
+        const int frames = 5;
+        double meshMs = measureFrames(frames, [&]() {
+            glUseProgram(meshProgram);
+            glActiveTexture(GL_TEXTURE0 + RayCastRenderer::PRIMITIVE_DATA_TEXTURE_UNIT);
+            glBindTexture(GL_TEXTURE_BUFFER, sphereTexture);
+            glActiveTexture(GL_TEXTURE0);
+            glBindVertexArray(vao);
+            glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(lowSphere.indices.size()), GL_UNSIGNED_INT, 0, count);
+            glBindVertexArray(0);
+        });
+        double rayCastMs = measureFrames(frames, [&]() { rayCast.draw(frustum); });
+        double uploadMs = RenderStats::instance().getValue("Sfery i cylindry/Wysylanie danych [ms]");
+
+        std::cout << std::setw(9) << count << " sfer:" << std::fixed << std::setprecision(2)
+                  << "  siatka " << std::setw(8) << meshMs << " ms"
+                  << "  promien " << std::setw(8) << rayCastMs << " ms"
+                  << "  (x" << std::setprecision(1) << meshMs / std::max(rayCastMs, 1.0e-3) << ")"
+                  << "  sortowanie i wysylanie " << std::setprecision(0) << uploadMs << " ms" << std::endl;
+
+        glDeleteTextures(1, &sphereTexture);
+        glDeleteBuffers(1, &sphereBuffer);
+    }
+
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    glDeleteBuffers(1, &ebo);
+    glDeleteProgram(meshProgram);
+    rayCast.release();
+    lightCuller.release();
+    multiView.release();
+    MaterialTable::instance().release();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,172 @@
+// SkinningBenchmark.cpp
+// Pomiar animacji szkieletowej tłumu (domyślnie 4000 postaci): próbkowanie
+// klipów, macierze kości i skinning na CPU, jednowątkowo i przez ThreadPool,
+// oraz porównanie ścieżek SIMD z obliczeniami glm.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+// Użycie: SkinningBenchmark [liczba postaci]
+#include "BenchmarkUtils.hpp"
+#include "../Animation/Crowd.hpp"
+#include "../Animation/ProceduralCharacter.hpp"
+#include "../Math/Simd.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Porównuje macierze i wierzchołki SIMD z obliczeniami glm
+ * @param skeleton Szkielet
+ * @param mesh Siatka postaci
+ * @param clip Klip
+ * @return true jeśli największy błąd jest pomijalny
+ */
+static bool checkAgainstReference(const Skeleton& skeleton, const SkinnedMeshData& mesh, const AnimationClip& clip) {
+    const int boneCount = skeleton.getBoneCount();
+    glm::mat4 world = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, 0.5f, -2.0f)), 0.7f,
+                                  glm::vec3(0.0f, 1.0f, 0.0f));
+    SkeletonPose pose;
+    std::vector<glm::mat4> scratch(boneCount);
+    std::vector<float> skinRows(boneCount * Skeleton::SKIN_MATRIX_FLOATS);
+    std::vector<Vertex> skinned(mesh.vertices.size());
+    float matrixError = 0.0f;
+    float vertexError = 0.0f;
+
+    for (float time : {0.0f, 0.13f, 0.52f, 0.97f}) {
+        clip.sample(time, pose);
+        skeleton.computeSkinMatrices(pose, world, scratch.data(), skinRows.data());
+
+        std::vector<glm::mat4> reference(boneCount);
+        for (int i = 0; i < boneCount; ++i) {
+            glm::mat4 local = glm::translate(glm::mat4(1.0f), pose.getTranslation(i)) *
+                              glm::mat4_cast(pose.getRotation(i)) * glm::scale(glm::mat4(1.0f), pose.getScale(i));
+            int parent = skeleton.getParents()[i];
+            reference[i] = (parent < 0 ? world : reference[parent]) * local;
+        }
+        for (int i = 0; i < boneCount; ++i) {
+            glm::mat4 skin = reference[i] * skeleton.getInverseBindMatrices()[i];
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 4; ++c) {
+                    matrixError = std::max(matrixError, std::abs(skin[c][r] - skinRows[i * 12 + r * 4 + c]));
+                }
+            }
+        }
+
+        Simd::skinVertices(skinRows.data(), &mesh.vertices[0].position.x, sizeof(SkinnedVertex) / sizeof(float),
+                           &skinned[0].position.x, sizeof(Vertex) / sizeof(float), mesh.vertices.size());
+        for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+            const SkinnedVertex& in = mesh.vertices[v];
+            glm::vec4 position(0.0f);
+            for (int k = 0; k < 4; ++k) {
+                glm::mat4 skin = reference[in.bones[k]] * skeleton.getInverseBindMatrices()[in.bones[k]];
+                position += skin * glm::vec4(in.position, 1.0f) * (in.weights[k] / 255.0f);
+            }
+            vertexError = std::max(vertexError, glm::length(glm::vec3(position) - skinned[v].position));
+        }
+    }
+
+    bool valid = matrixError < 1e-4f && vertexError < 1e-4f;
+    std::cout << std::left << std::setw(42) << "Zgodnosc SIMD z glm" << (valid ? " zgodne" : " NIEZGODNE")
+              << std::scientific << std::setprecision(1) << "  macierze: " << matrixError << ", wierzcholki: "
+              << vertexError << std::defaultfloat << std::endl;
+    return valid;
+}
+
+int main(int argc, char** argv) {
+    std::shared_ptr<Skeleton> skeleton = ProceduralCharacter::createSkeleton();
+    SkinnedMeshData mesh = ProceduralCharacter::createMesh(*skeleton);
+    std::shared_ptr<AnimationClip> clips[] = {ProceduralCharacter::createWalkClip(*skeleton),
+                                              ProceduralCharacter::createWaveClip(*skeleton)};
+
+    std::cout << "Poprawnosc" << std::endl;
+    if (!checkAgainstReference(*skeleton, mesh, *clips[0])) {
+        std::cerr << "Blad: Wyniki SIMD roznia sie od obliczen glm" << std::endl;
+        return 1;
+    }
+
+    size_t count = argc > 1 ? static_cast<size_t>(std::max(std::atoi(argv[1]), 1)) : 4000;
+    const int boneCount = skeleton->getBoneCount();
+    const unsigned threads = ThreadPool::instance().getThreadCount() + 1;
+    Crowd crowd(skeleton);
+    crowd.addClip(clips[0]);
+    crowd.addClip(clips[1]);
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    for (size_t i = 0; i < count; ++i) {
+        CrowdCharacter character;
+        character.position = glm::vec3(static_cast<float>(i % side), 0.0f, static_cast<float>(i / side)) * 1.5f;
+        character.yaw = unit(random) * 6.2831853f;
+        character.clip = unit(random) < 0.7f ? 0 : 1;
+        character.time = unit(random) * 2.0f;
+        character.speed = 0.8f + 0.4f * unit(random);
+        crowd.addCharacter(character);
+    }
+
+    std::cout << std::endl << "Tlum: " << count << " postaci, " << boneCount << " kosci, " << mesh.vertices.size()
+              << " wierzcholkow, " << mesh.indices.size() / 3 << " trojkatow (" << threads << " watkow)" << std::endl;
+
+    // Etapy jednowątkowo, każdy dla całego tłumu
+    std::vector<SkeletonPose> poses(count);
+    std::vector<glm::mat4> matrices(count * boneCount);
+    std::vector<float> skinRows(count * boneCount * Skeleton::SKIN_MATRIX_FLOATS);
+    const std::vector<CrowdCharacter>& characters = crowd.getCharacters();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) clips[characters[i].clip]->sample(characters[i].time, poses[i]);
+    BenchmarkUtils::printTiming("Probkowanie klipow (1 watek)", BenchmarkUtils::elapsedMs(start), count, "us/postac", 1e3);
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) skeleton->computeLocalMatrices(poses[i], &matrices[i * boneCount]);
+    BenchmarkUtils::printTiming("Macierze lokalne SoA (1 watek)", BenchmarkUtils::elapsedMs(start), count, "us/postac", 1e3);
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        glm::mat4 world = glm::translate(glm::mat4(1.0f), characters[i].position);
+        skeleton->computeModelMatrices(world, &matrices[i * boneCount]);
+    }
+    BenchmarkUtils::printTiming("Macierze swiata - hierarchia (1 watek)", BenchmarkUtils::elapsedMs(start), count, "us/postac", 1e3);
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        skeleton->computeSkinMatrices(&matrices[i * boneCount], &skinRows[i * boneCount * Skeleton::SKIN_MATRIX_FLOATS]);
+    }
+    BenchmarkUtils::printTiming("Macierze skinningu (1 watek)", BenchmarkUtils::elapsedMs(start), count, "us/postac", 1e3);
+
+    // Pełna aktualizacja tłumu przez ThreadPool
+    const int frames = 20;
+    double animationMs = 0.0;
+    for (int frame = 0; frame < frames; ++frame) {
+        crowd.update(1.0f / 60.0f);
+        animationMs += crowd.getStats().animationMs;
+    }
+    BenchmarkUtils::printTiming("Crowd::update (ThreadPool, srednia)", animationMs / frames, count, "us/postac", 1e3);
+
+    // Skinning na CPU
+    std::vector<uint32_t> all(count);
+    std::iota(all.begin(), all.end(), 0u);
+    std::vector<Vertex> skinned(count * mesh.vertices.size());
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        Simd::skinVertices(crowd.getSkinMatrices(i), &mesh.vertices[0].position.x, sizeof(SkinnedVertex) / sizeof(float),
+                           &skinned[i * mesh.vertices.size()].position.x, sizeof(Vertex) / sizeof(float),
+                           mesh.vertices.size());
+    }
+    BenchmarkUtils::printTiming("Skinning CPU SIMD (1 watek)", BenchmarkUtils::elapsedMs(start), count, "us/postac", 1e3);
+    double skinningMs = 0.0;
+    for (int frame = 0; frame < frames; ++frame) {
+        crowd.skinVertices(mesh, all.data(), all.size(), skinned.data());
+        skinningMs += crowd.getStats().skinningMs;
+    }
+    BenchmarkUtils::printTiming("Crowd::skinVertices (ThreadPool, srednia)", skinningMs / frames, count, "us/postac", 1e3);
+    std::cout << std::fixed << std::setprecision(1) << "Wierzcholki na sekunde: "
+              << crowd.getStats().skinnedVertices / (skinningMs / frames) / 1000.0 << " mln" << std::endl;
+
+    std::cout << std::endl << "Dane wysylane na GPU w klatce: macierze kosci "
+              << count * boneCount * Skeleton::SKIN_MATRIX_FLOATS * sizeof(float) / (1024.0 * 1024.0)
+              << " MB, wierzcholki po skinningu CPU " << skinned.size() * sizeof(Vertex) / (1024.0 * 1024.0) << " MB"
+              << std::endl;
+    return 0;
+}
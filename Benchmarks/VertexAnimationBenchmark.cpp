@@ -0,0 +1,224 @@
+// VertexAnimationBenchmark.cpp
+// Pomiar animacji wypalonej do tekstury wierzchołków: czas wypalania
+// i rozmiar tekstury, błąd względem skinningu (kwantyzacja i interpolacja
+// klatek), zapis i odczyt pliku oraz koszt CPU na klatkę dla dużego tłumu
+// (domyślnie 250000 postaci) w porównaniu z Crowd::update.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+// Użycie: VertexAnimationBenchmark [liczba postaci]
+#include "BenchmarkUtils.hpp"
+#include "../Animation/Crowd.hpp"
+#include "../Animation/ProceduralCharacter.hpp"
+#include "../Animation/VertexAnimation.hpp"
+#include "../Animation/VertexAnimationCrowd.hpp"
+#include "../Math/Simd.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Porównuje wypaloną animację ze skinningiem najdokładniejszej siatki
+ * @param animation Wypalona animacja
+ * @param skeleton Szkielet
+ * @param mesh Siatka poziomu 0
+ * @param clips Klipy w kolejności wypalania
+ * @param betweenFrames false: czasy klatek (błąd kwantyzacji), true: połowy odstępów (błąd interpolacji)
+ * @return Największy błąd pozycji [m]
+ */
+static float measureError(const VertexAnimation& animation, const Skeleton& skeleton, const SkinnedMeshData& mesh,
+                          const std::vector<std::shared_ptr<const AnimationClip>>& clips, bool betweenFrames) {
+    const int boneCount = skeleton.getBoneCount();
+    SkeletonPose pose;
+    std::vector<glm::mat4> scratch(boneCount);
+    std::vector<float> skinRows(boneCount * Skeleton::SKIN_MATRIX_FLOATS);
+    std::vector<Vertex> skinned(mesh.vertices.size());
+    float error = 0.0f;
+    for (size_t c = 0; c < clips.size(); ++c) {
+        const VertexAnimationClip& range = animation.getClips()[c];
+        for (uint32_t frame = 0; frame + 1 < range.frameCount; ++frame) {
+            float time = (static_cast<float>(frame) + (betweenFrames ? 0.5f : 0.0f)) / range.frameRate;
+            clips[c]->sample(time, pose);
+            skeleton.computeSkinMatrices(pose, glm::mat4(1.0f), scratch.data(), skinRows.data());
+            Simd::skinVertices(skinRows.data(), &mesh.vertices[0].position.x, sizeof(SkinnedVertex) / sizeof(float),
+                               &skinned[0].position.x, sizeof(Vertex) / sizeof(float), mesh.vertices.size());
+            for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+                glm::vec3 baked = animation.samplePosition(static_cast<int>(c), time, static_cast<uint32_t>(v));
+                error = std::max(error, glm::length(baked - skinned[v].position));
+            }
+        }
+    }
+    return error;
+}
+
+/**
+ * @brief Mierzy największy kąt między normalną wypaloną a normalną skinningu
+ * @param animation Wypalona animacja
+ * @param skeleton Szkielet
+ * @param mesh Siatka poziomu 0
+ * @param clip Klip 0
+ * @return Największy błąd normalnej [stopnie]
+ */
+static float measureNormalError(const VertexAnimation& animation, const Skeleton& skeleton, const SkinnedMeshData& mesh,
+                                const AnimationClip& clip) {
+    const int boneCount = skeleton.getBoneCount();
+    const VertexAnimationClip& range = animation.getClips()[0];
+    SkeletonPose pose;
+    std::vector<glm::mat4> scratch(boneCount);
+    std::vector<float> skinRows(boneCount * Skeleton::SKIN_MATRIX_FLOATS);
+    std::vector<Vertex> skinned(mesh.vertices.size());
+    float error = 0.0f;
+    for (uint32_t frame = 0; frame < range.frameCount; ++frame) {
+        clip.sample(static_cast<float>(frame) / range.frameRate, pose);
+        skeleton.computeSkinMatrices(pose, glm::mat4(1.0f), scratch.data(), skinRows.data());
+        Simd::skinVertices(skinRows.data(), &mesh.vertices[0].position.x, sizeof(SkinnedVertex) / sizeof(float),
+                           &skinned[0].position.x, sizeof(Vertex) / sizeof(float), mesh.vertices.size());
+        for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+            glm::vec3 reference = glm::normalize(skinned[v].normal);
+            glm::vec3 baked = animation.getNormal(range.firstFrame + frame, static_cast<uint32_t>(v));
+            float chord = glm::length(baked - reference);
+            error = std::max(error, 2.0f * std::asin(std::min(chord * 0.5f, 1.0f)));
+        }
+    }
+    return error * 57.29578f;
+}
+
+int main(int argc, char** argv) {
+    std::shared_ptr<Skeleton> skeleton = ProceduralCharacter::createSkeleton();
+    std::vector<SkinnedMeshData> lods = {ProceduralCharacter::createMesh(*skeleton, 8),
+                                         ProceduralCharacter::createMesh(*skeleton, 5),
+                                         ProceduralCharacter::createMesh(*skeleton, 3)};
+    std::vector<std::shared_ptr<const AnimationClip>> clips = {ProceduralCharacter::createWalkClip(*skeleton),
+                                                               ProceduralCharacter::createWaveClip(*skeleton)};
+    const unsigned threads = ThreadPool::instance().getThreadCount() + 1;
+
+    // Wypalanie
+    auto animation = std::make_shared<VertexAnimation>();
+    auto start = std::chrono::high_resolution_clock::now();
+    if (!animation->bake(*skeleton, lods, clips, ProceduralCharacter::FRAME_RATE)) return 1;
+    double bakeMs = BenchmarkUtils::elapsedMs(start);
+    glm::ivec2 textureSize = animation->getTextureSize();
+    std::cout << "Wypalanie (" << threads << " watkow)" << std::endl;
+    for (size_t i = 0; i < animation->getLods().size(); ++i) {
+        const VertexAnimationLod& lod = animation->getLods()[i];
+        std::cout << "  Poziom " << i << ": " << lod.vertexCount << " wierzcholkow, " << lod.indexCount / 3
+                  << " trojkatow" << std::endl;
+    }
+    for (const VertexAnimationClip& clip : animation->getClips()) {
+        std::cout << "  Klip " << clip.name << ": " << clip.frameCount << " klatek, " << std::fixed
+                  << std::setprecision(2) << clip.frameRate << " klatek/s" << std::endl;
+    }
+    std::cout << "  Tekstura " << textureSize.x << " x " << textureSize.y << " RGBA16: " << std::setprecision(2)
+              << animation->getMemoryUsage() / (1024.0 * 1024.0) << " MB, wypalanie " << bakeMs << " ms" << std::endl;
+
+    // Dokładność względem skinningu
+    float frameError = measureError(*animation, *skeleton, lods[0], clips, false);
+    float interpolationError = measureError(*animation, *skeleton, lods[0], clips, true);
+    float normalError = measureNormalError(*animation, *skeleton, lods[0], *clips[0]);
+    std::cout << std::endl << "Poprawnosc (poziom 0 wzgledem Simd::skinVertices)" << std::endl;
+    std::cout << "  Blad w klatkach:          " << std::setprecision(4) << frameError * 1000.0f << " mm" << std::endl;
+    std::cout << "  Blad miedzy klatkami:     " << interpolationError * 1000.0f << " mm" << std::endl;
+    std::cout << "  Blad normalnych:          " << std::setprecision(2) << normalError << " stopni" << std::endl;
+    BoundingSphere bounds = animation->getBounds();
+    if (frameError > 1e-3f * bounds.radius || normalError > 2.0f) {
+        std::cerr << "Blad: Wypalona animacja odbiega od skinningu" << std::endl;
+        return 1;
+    }
+
+    // Zapis i odczyt
+    const char* path = "VertexAnimationBenchmark.vat";
+    start = std::chrono::high_resolution_clock::now();
+    bool saved = animation->save(path);
+    double saveMs = BenchmarkUtils::elapsedMs(start);
+    VertexAnimation loaded;
+    start = std::chrono::high_resolution_clock::now();
+    bool valid = saved && loaded.load(path);
+    double loadMs = BenchmarkUtils::elapsedMs(start);
+    std::remove(path);
+    valid = valid && loaded.getTexels() == animation->getTexels() && loaded.getIndices() == animation->getIndices() &&
+            loaded.getClips().size() == animation->getClips().size() &&
+            loaded.getClips()[1].name == animation->getClips()[1].name &&
+            loaded.getLods().size() == animation->getLods().size();
+    if (!valid) {
+        std::cerr << "Blad: Odczytana animacja rozni sie od zapisanej" << std::endl;
+        return 1;
+    }
+    std::cout << "  Plik: zapis " << saveMs << " ms, odczyt " << loadMs << " ms" << std::endl;
+
+    // Tłum: rozmieszczenie i koszt CPU na klatkę
+    size_t count = argc > 1 ? static_cast<size_t>(std::max(std::atoi(argv[1]), 1)) : 250000;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    VertexAnimationCrowd crowd(animation);
+    crowd.setLodDistances({20.0f, 50.0f});
+    for (size_t i = 0; i < count; ++i) {
+        VertexAnimationInstance instance;
+        instance.position = glm::vec3(static_cast<float>(i % side), 0.0f, -static_cast<float>(i / side)) * 1.2f;
+        instance.yaw = unit(random) * 6.2831853f;
+        instance.clip = unit(random) < 0.7f ? 0 : 1;
+        instance.timeOffset = unit(random) * 2.0f;
+        instance.speed = 0.8f + 0.4f * unit(random);
+        crowd.addInstance(instance);
+    }
+    start = std::chrono::high_resolution_clock::now();
+    crowd.build();
+    double buildMs = BenchmarkUtils::elapsedMs(start);
+
+    float extent = side * 1.2f;
+    glm::vec3 eye(extent * 0.5f, 1.7f, 5.0f);
+    glm::mat4 viewProjection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+                               glm::lookAt(eye, eye + glm::vec3(0.0f, -0.1f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    std::vector<Frustum> frustums = {Frustum::fromMatrix(viewProjection)};
+    std::vector<VertexAnimationDraw> draws;
+    const int repeats = 100;
+    size_t visible = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeats; ++r) visible = crowd.cull(frustums, eye, draws);
+    double cullMs = BenchmarkUtils::elapsedMs(start) / repeats;
+    size_t triangles = 0;
+    int lodDraws[3] = {0, 0, 0};
+    for (const VertexAnimationDraw& draw : draws) {
+        triangles += animation->getLods()[draw.lod].indexCount / 3 * crowd.getCells()[draw.cell].instanceCount;
+        lodDraws[std::min(draw.lod, 2)]++;
+    }
+
+    std::cout << std::endl << "Tlum: " << count << " postaci, " << crowd.getCells().size() << " komorek "
+              << VertexAnimationCrowd::CELL_SIZE << " m" << std::endl;
+    BenchmarkUtils::printTiming("Podzial na komorki (raz)", buildMs, count, "ns/postac", 1e6);
+    BenchmarkUtils::printTiming("Odrzucanie komorek i poziomy (na klatke)", cullMs, count, "ns/postac", 1e6);
+    std::cout << "  Widoczne: " << visible << " postaci w " << draws.size() << " wywolaniach rysowania (poziomy "
+              << lodDraws[0] << "/" << lodDraws[1] << "/" << lodDraws[2] << "), " << triangles / 1000000.0
+              << " mln trojkatow" << std::endl;
+    std::cout << "  Dane instancji na GPU: " << count * sizeof(VertexAnimationInstance) / (1024.0 * 1024.0)
+              << " MB (wysylane raz)" << std::endl;
+
+    // Dla porównania: animacja szkieletowa części tłumu
+    const size_t skinnedCount = std::min<size_t>(count, 4000);
+    Crowd skinnedCrowd(skeleton);
+    skinnedCrowd.addClip(clips[0]);
+    skinnedCrowd.addClip(clips[1]);
+    for (size_t i = 0; i < skinnedCount; ++i) {
+        CrowdCharacter character;
+        character.position = crowd.getInstances()[i].position;
+        character.clip = static_cast<int>(crowd.getInstances()[i].clip);
+        character.time = crowd.getInstances()[i].timeOffset;
+        skinnedCrowd.addCharacter(character);
+    }
+    skinnedCrowd.update(0.0f);
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < 10; ++r) skinnedCrowd.update(1.0f / 60.0f);
+    double skinnedMs = BenchmarkUtils::elapsedMs(start) / 10.0;
+    BenchmarkUtils::printTiming("Crowd::update (kosci, porownanie)", skinnedMs, skinnedCount, "ns/postac", 1e6);
+    std::cout << "  Szacunek dla " << count << " postaci ze szkieletem: " << std::setprecision(1)
+              << skinnedMs * count / skinnedCount << " ms CPU i "
+              << count * skeleton->getBoneCount() * Skeleton::SKIN_MATRIX_FLOATS * sizeof(float) / (1024.0 * 1024.0)
+              << " MB macierzy na klatke" << std::endl;
+    return 0;
+}
@@ -0,0 +1,259 @@
+// VoxelMeshingBenchmark.cpp
+// Pomiar siatkowania zachłannego świata wokseli (domyślnie 1024^3) jednym
+// wątkiem i pulą wątków oraz przebudowy po edycji jednego woksela.
+// Budowany tylko z opcją SILNIK_BUILD_BENCHMARKS (nie wymaga kontekstu OpenGL).
+// Użycie: VoxelMeshingBenchmark [bok świata w wokselach, wielokrotność 32]
+#include "BenchmarkUtils.hpp"
+#include "../Voxel/VoxelMesher.hpp"
+#include "../Voxel/VoxelWorld.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+static const uint8_t GRASS = 1;     /**< Trawa (wierzchnia warstwa) */
+static const uint8_t DIRT = 2;      /**< Ziemia pod trawą */
+static const uint8_t STONE = 3;     /**< Skała */
+static const uint8_t ORE = 4;       /**< Rozproszona ruda (fragmenty wnętrza nie są jednorodne) */
+
+/**
+ * @brief Wypełnia fragment terenem z warstwami i rozproszoną rudą
+ * @param worldSize Bok świata w wokselach
+ * @param origin Narożnik fragmentu
+ * @param voxels Woksele fragmentu
+ */
+static void generateTerrainChunk(int worldSize, const glm::ivec3& origin, uint8_t* voxels) {
+    const int S = VoxelChunk::SIZE;
+    const float size = static_cast<float>(worldSize);
+    for (int z = 0; z < S; ++z) {
+        for (int x = 0; x < S; ++x) {
+            float wx = static_cast<float>(origin.x + x), wz = static_cast<float>(origin.z + z);
+            float height = size * 0.35f + size * 0.08f * (std::sin(wx * 0.011f) + std::cos(wz * 0.013f)) +
+                           size * 0.03f * std::sin((wx + wz) * 0.037f) + 6.0f * std::sin(wx * 0.11f) * std::cos(wz * 0.09f);
+            int surface = static_cast<int>(height);
+            for (int y = 0; y < S; ++y) {
+                int wy = origin.y + y;
+                uint8_t value = 0;
+                if (wy <= surface - 4) {
+                    uint32_t hash = static_cast<uint32_t>(origin.x + x) * 73856093u ^
+                                    static_cast<uint32_t>(wy) * 19349663u ^ static_cast<uint32_t>(origin.z + z) * 83492791u;
+                    value = (hash % 97u) == 0 ? ORE : STONE;
+                } else if (wy < surface) {
+                    value = DIRT;
+                } else if (wy == surface) {
+                    value = GRASS;
+                }
+                voxels[VoxelChunk::index(x, y, z)] = value;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Zbiera wskaźniki do fragmentu i sąsiadów
+ * @param world Świat
+ * @param index Indeks fragmentu
+ * @param chunk Fragment
+ * @param neighbors Sąsiedzi w kolejności VoxelMesher::FACE_*
+ */
+static void collectChunks(const VoxelWorld& world, int index, const VoxelChunk*& chunk, const VoxelChunk* neighbors[6]) {
+    glm::ivec3 coord = world.chunkCoord(index);
+    chunk = world.getChunk(index).get();
+    for (int face = 0; face < 6; ++face) {
+        glm::ivec3 neighbor = coord;
+        neighbor[face / 2] += (face & 1) ? 1 : -1;
+        int neighborIndex = world.chunkIndex(neighbor);
+        neighbors[face] = neighborIndex >= 0 ? world.getChunk(neighborIndex).get() : nullptr;
+    }
+}
+
+/**
+ * @struct MeshTotals
+ * @brief Podsumowanie siatkowania świata
+ */
+struct MeshTotals {
+    size_t meshedChunks = 0;    /**< Fragmenty z niepustą siatką */
+    size_t quads = 0;           /**< Czworokąty */
+    size_t faces = 0;           /**< Ścianki przed scaleniem */
+};
+
+/**
+ * @brief Siatkuje wybrane fragmenty świata
+ * @param world Świat
+ * @param chunks Indeksy fragmentów
+ * @param parallel Czy użyć puli wątków
+ * @return Podsumowanie
+ */
+static MeshTotals meshChunks(const VoxelWorld& world, const std::vector<int>& chunks, bool parallel) {
+    std::atomic<size_t> meshedChunks{0}, quads{0}, faces{0};
+    auto work = [&](size_t begin, size_t end) {
+        VoxelMesher mesher;
+        VoxelMeshData mesh;
+        size_t localMeshed = 0, localQuads = 0, localFaces = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const VoxelChunk* chunk;
+            const VoxelChunk* neighbors[6];
+            collectChunks(world, chunks[i], chunk, neighbors);
+            mesher.mesh(chunk, neighbors, mesh);
+            localMeshed += mesh.vertices.empty() ? 0 : 1;
+            localQuads += mesh.getQuadCount();
+            localFaces += mesh.faceCount;
+        }
+        meshedChunks += localMeshed;
+        quads += localQuads;
+        faces += localFaces;
+    };
+    if (parallel) {
+        ThreadPool::instance().parallelFor(chunks.size(), 4, work);
+    } else {
+        work(0, chunks.size());
+    }
+    return MeshTotals{meshedChunks.load(), quads.load(), faces.load()};
+}
+
+/**
+ * @brief Sprawdza, czy czworokąty siatek pokrywają dokładnie ścianki wyznaczone wprost
+ * @param world Świat
+ * @return true jeśli zbiory ścianek są równe
+ */
+static bool checkCoverage(const VoxelWorld& world) {
+    typedef std::tuple<int, int, int, int, int> Face;   // kierunek, x, y, z, wartość
+    std::set<Face> expected, produced;
+    glm::ivec3 size = world.getSize();
+    for (int y = 0; y < size.y; ++y) {
+        for (int z = 0; z < size.z; ++z) {
+            for (int x = 0; x < size.x; ++x) {
+                uint8_t value = world.getVoxel(glm::ivec3(x, y, z));
+                if (value == 0) continue;
+                for (int face = 0; face < 6; ++face) {
+                    glm::ivec3 neighbor(x, y, z);
+                    neighbor[face / 2] += (face & 1) ? 1 : -1;
+                    if (world.getVoxel(neighbor) == 0) expected.insert(Face{face, x, y, z, value});
+                }
+            }
+        }
+    }
+
+    VoxelMesher mesher;
+    VoxelMeshData mesh;
+    for (int index = 0; index < world.getChunkCount(); ++index) {
+        const VoxelChunk* chunk;
+        const VoxelChunk* neighbors[6];
+        collectChunks(world, index, chunk, neighbors);
+        mesher.mesh(chunk, neighbors, mesh);
+        glm::ivec3 origin = world.chunkCoord(index) * VoxelChunk::SIZE;
+        for (size_t quad = 0; quad < mesh.getQuadCount(); ++quad) {
+            // Wierzchołki 0 i 2 czworokąta to jego najmniejszy i największy narożnik
+            uint32_t first = mesh.vertices[quad * 4], opposite = mesh.vertices[quad * 4 + 2];
+            glm::ivec3 lo(first & 63u, (first >> 6) & 63u, (first >> 12) & 63u);
+            glm::ivec3 hi(opposite & 63u, (opposite >> 6) & 63u, (opposite >> 12) & 63u);
+            int face = static_cast<int>((first >> 18) & 7u);
+            int value = static_cast<int>((first >> 21) & 255u);
+            int d = face / 2;
+            lo[d] -= (face & 1) ? 1 : 0;
+            hi[d] = lo[d] + 1;
+            for (int y = lo.y; y < hi.y; ++y) {
+                for (int z = lo.z; z < hi.z; ++z) {
+                    for (int x = lo.x; x < hi.x; ++x) {
+                        produced.insert(Face{face, origin.x + x, origin.y + y, origin.z + z, value});
+                    }
+                }
+            }
+        }
+    }
+    bool same = expected == produced;
+    std::cout << std::left << std::setw(44) << "Pokrycie scianek (swiat 96x64x64)"
+              << (same ? " zgodne" : " NIEZGODNE") << "  scianki: " << expected.size() << std::endl;
+    return same;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "Zgodnosc z wyznaczeniem scianek wprost" << std::endl;
+    {
+        // Losowe woksele z kilkoma wartościami, także na granicach fragmentów
+        VoxelWorld world(glm::ivec3(3, 2, 2));
+        world.generate([](const glm::ivec3& origin, uint8_t* voxels) {
+            std::mt19937 local(static_cast<uint32_t>(origin.x * 7 + origin.y * 13 + origin.z * 31 + 1));
+            for (int i = 0; i < VoxelChunk::VOLUME; ++i) voxels[i] = local() % 3 == 0 ? 0 : 1 + local() % 3;
+        });
+        world.fillSphere(glm::vec3(40.0f, 30.0f, 30.0f), 14.0f, 0);
+        world.fillBox(glm::ivec3(64, 0, 0), glm::ivec3(96, 32, 32), STONE);
+        if (!checkCoverage(world)) {
+            std::cerr << "Blad: Siatka zachlanna nie pokrywa scianek wokseli" << std::endl;
+            return 1;
+        }
+    }
+
+    int worldSize = argc > 1 ? std::atoi(argv[1]) : 1024;
+    worldSize = std::max(VoxelChunk::SIZE, worldSize / VoxelChunk::SIZE * VoxelChunk::SIZE);
+    const int chunksPerAxis = worldSize / VoxelChunk::SIZE;
+    const unsigned threads = ThreadPool::instance().getThreadCount() + 1;
+
+    std::cout << std::endl << "Swiat " << worldSize << "^3 (" << chunksPerAxis * chunksPerAxis * chunksPerAxis
+              << " fragmentow, " << threads << " watkow)" << std::endl;
+    VoxelWorld world(glm::ivec3(chunksPerAxis, chunksPerAxis, chunksPerAxis));
+    auto start = std::chrono::high_resolution_clock::now();
+    world.generate([worldSize](const glm::ivec3& origin, uint8_t* voxels) { generateTerrainChunk(worldSize, origin, voxels); });
+    double generateMs = BenchmarkUtils::elapsedMs(start);
+
+    size_t bitCounts[9] = {0};
+    size_t airChunks = 0;
+    for (int index = 0; index < world.getChunkCount(); ++index) {
+        std::shared_ptr<const VoxelChunk> chunk = world.getChunk(index);
+        if (chunk) bitCounts[chunk->getBitsPerVoxel()]++;
+        else airChunks++;
+    }
+    double denseMb = static_cast<double>(worldSize) * worldSize * worldSize / (1024.0 * 1024.0);
+    std::cout << std::fixed << std::setprecision(1) << "Generowanie: " << generateMs << " ms, pamiec "
+              << world.getMemoryUsage() / (1024.0 * 1024.0) << " MB (tablica bajtow: " << denseMb << " MB)" << std::endl;
+    std::cout << "Fragmenty: powietrze " << airChunks << ", jednorodne " << bitCounts[0] << ", 1 bit " << bitCounts[1]
+              << ", 2 bity " << bitCounts[2] << ", 4 bity " << bitCounts[4] << ", 8 bitow " << bitCounts[8] << std::endl;
+
+    std::vector<int> allChunks(world.getChunkCount());
+    for (int index = 0; index < world.getChunkCount(); ++index) allChunks[index] = index;
+    std::vector<int> dirty;
+    world.takeDirtyChunks(dirty);
+
+    std::cout << std::endl << "Siatkowanie calego swiata" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    MeshTotals serial = meshChunks(world, allChunks, false);
+    double serialMs = BenchmarkUtils::elapsedMs(start);
+    start = std::chrono::high_resolution_clock::now();
+    MeshTotals parallel = meshChunks(world, allChunks, true);
+    double parallelMs = BenchmarkUtils::elapsedMs(start);
+
+    std::cout << std::left << std::setw(44) << "Jeden watek" << " " << std::setprecision(1) << serialMs << " ms" << std::endl;
+    std::cout << std::left << std::setw(44) << "Pula watkow (ThreadPool::parallelFor)" << " " << parallelMs
+              << " ms  przyspieszenie: " << std::setprecision(2) << serialMs / parallelMs << "x" << std::endl;
+    if (serial.quads != parallel.quads) {
+        std::cerr << "Blad: Wynik rownolegly rozni sie od jednowatkowego" << std::endl;
+        return 1;
+    }
+    std::cout << "Fragmenty z siatka: " << parallel.meshedChunks << ", scianki: " << parallel.faces
+              << ", czworokaty: " << parallel.quads << " (" << std::setprecision(1)
+              << static_cast<double>(parallel.faces) / std::max<size_t>(parallel.quads, 1) << " scianki na czworokat, "
+              << parallel.quads * 16 / (1024.0 * 1024.0) << " MB wierzcholkow)" << std::endl;
+
+    // Edycja woksela w narożniku fragmentu przy powierzchni: przebudowa tylko zależnych fragmentów
+    std::cout << std::endl << "Edycja jednego woksela" << std::endl;
+    glm::ivec3 corner(VoxelChunk::SIZE * (chunksPerAxis / 2), 0, VoxelChunk::SIZE * (chunksPerAxis / 2));
+    while (corner.y + 1 < worldSize && world.getVoxel(corner + glm::ivec3(0, 1, 0)) != 0) corner.y++;
+    start = std::chrono::high_resolution_clock::now();
+    world.setVoxel(corner, 0);
+    dirty.clear();
+    world.takeDirtyChunks(dirty);
+    MeshTotals edited = meshChunks(world, dirty, false);
+    double editMs = BenchmarkUtils::elapsedMs(start);
+    std::cout << std::left << std::setw(44) << "Zmiana i przebudowa" << " " << std::setprecision(3) << editMs
+              << " ms  fragmenty: " << dirty.size() << ", czworokaty: " << edited.quads << std::endl;
+    return 0;
+}
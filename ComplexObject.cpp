@@ -1,29 +1,64 @@
 // ComplexObject.cpp
 #include "ComplexObject.hpp"
+#include "Mesh/LodChain.hpp"
+#include "Mesh/MeshletCuller.hpp"
 #include <GL/glew.h>
 #include <iostream>
 #include <cmath>
+#include <map>
+#include <utility>
+
+/**
+ * @struct ComplexObject::SharedMesh
+ * @brief Siatka na GPU wraz z poziomami szczegółowości i meshletami
+ *
+ * Wspólna dla obiektów o tym samym kształcie; bufory OpenGL usuwane są
+ * razem z ostatnim obiektem, który jej używa.
+ */
+struct ComplexObject::SharedMesh {
+    Mesh mesh{};                  /**< Pełna siatka (VAO, VBO, EBO) */
+    MeshData meshData;            /**< Kopia CPU siatki (do scalania w paczki) */
+    std::vector<Mesh> lodMeshes;  /**< Uproszczone poziomy szczegółowości (poziomy 1..n) */
+    std::vector<float> lodErrors; /**< Błędy poziomów (indeks 0 = siatka pełna) */
+    std::vector<Meshlet> meshlets;/**< Meshlety pełnej siatki */
+
+    /**
+     * @brief Usuwa bufory siatki i poziomów szczegółowości
+     */
+    ~SharedMesh();
+};
+
+/**
+ * @brief Usuwa bufory siatki i poziomów szczegółowości
+ */
+ComplexObject::SharedMesh::~SharedMesh() {
+    if (mesh.VAO) {
+        glDeleteVertexArrays(1, &mesh.VAO);
+        glDeleteBuffers(1, &mesh.VBO);
+        glDeleteBuffers(1, &mesh.EBO);
+    }
+    for (Mesh& lod : lodMeshes) {
+        glDeleteVertexArrays(1, &lod.VAO);
+        glDeleteBuffers(1, &lod.VBO);
+        glDeleteBuffers(1, &lod.EBO);
+    }
+}
 
 /**
  * @brief Konstruktor domyślny ComplexObject
  *
- * Inicjalizuje pozycję, skalę, rotację i liczniki, zeruje identyfikatory OpenGL
+ * Inicjalizuje pozycję, skalę, rotację i liczniki; siatka powstaje w createLetterH()
  */
 ComplexObject::ComplexObject()
     : position(0.0f), scale(1.0f), rotation(0.0f), vertexCount(0), triangleCount(0) {
-    mesh.VAO = 0;
-    mesh.VBO = 0;
-    mesh.EBO = 0;
-    mesh.indexCount = 0;
 }
 
 /**
  * @brief Destruktor ComplexObject
  *
- * Zwalnia zasoby graficzne (VAO, VBO, EBO) poprzez wywołanie deleteMesh()
+ * Zwalnia odwołanie do wspólnej siatki (ostatnie usuwa VAO, VBO i EBO)
  */
 ComplexObject::~ComplexObject() {
-    deleteMesh();
 }
 
 /**
@@ -33,181 +68,150 @@ ComplexObject::~ComplexObject() {
  * @param depth Głębokość litery H
  * @param color Kolor litery H
  *
+ * @details Kształt zależy tylko od szerokości i wysokości, więc siatka,
+ * upraszczanie QEM i podział na meshlety wykonywane są raz dla każdej pary
+ * wymiarów. Pamięć podręczna trzyma słabe odwołania, więc siatka znika
+ * z GPU razem z ostatnią literą o tych wymiarach.
+ */
+void ComplexObject::createLetterH(float width, float height, float depth, const glm::vec3& color) {
+    static std::map<std::pair<float, float>, std::weak_ptr<const SharedMesh>> cache;
+
+    std::weak_ptr<const SharedMesh>& entry = cache[std::make_pair(width, height)];
+    std::shared_ptr<const SharedMesh> shared = entry.lock();
+    if (!shared) {
+        shared = buildLetterH(width, height);
+        entry = shared;
+    }
+
+    sharedMesh = std::move(shared);
+    vertexCount = static_cast<int>(sharedMesh->meshData.vertices.size());
+    triangleCount = static_cast<int>(sharedMesh->meshData.indices.size() / 3);
+}
+
+/**
+ * @brief Buduje siatkę litery H wraz z poziomami szczegółowości
+ * @param width Szerokość litery H
+ * @param height Wysokość litery H
+ * @return Nowa wspólna siatka
+ *
  * @details Tworzy literę H składającą się z trzech cylindrów:
  * 1. Lewy pionowy cylinder
  * 2. Poziomy cylinder środkowy (obrócony o 90 stopni)
  * 3. Prawy pionowy cylinder
+ * Pamięć na wszystkie trzy cylindry przydzielana jest raz, z góry.
  */
-void ComplexObject::createLetterH(float width, float height, float depth, const glm::vec3& color) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-
-    vertexCount = 0;
-    triangleCount = 0;
-
+std::shared_ptr<const ComplexObject::SharedMesh> ComplexObject::buildLetterH(float width, float height) {
     // Parametry litery H
     float strokeWidth = width * 0.2f;
     float halfWidth = width / 2.0f;
     float cylinderRadius = strokeWidth / 2.0f;
-    int sectors = 12;
+    int sectors = 32;
+
+    MeshBuilder builder;
+    builder.reserve(MeshBuilder::cylinderCounts(sectors) * 3);
 
     // Puszka 1 (lewo)
     glm::vec3 leftPos(-halfWidth + cylinderRadius, 0.0f, 0.0f);
-    addCylinder(vertices, indices, leftPos, height, cylinderRadius, color, 0.0f, sectors);
+    addCylinder(builder, leftPos, height, cylinderRadius, 0.0f, sectors);
 
     // Puszka 2 (środek)
     glm::vec3 centerPos(0.0f, 0.0f, 0.0f);
-    addCylinder(vertices, indices, centerPos, width * 0.7, cylinderRadius, color, 90.0f, sectors);
+    addCylinder(builder, centerPos, width * 0.7, cylinderRadius, 90.0f, sectors);
     //to 0.7 to skala, żeby H ładniej wyglądało >///<
 
     // Puszka 3 (prawo)
     glm::vec3 rightPos(halfWidth - cylinderRadius, 0.0f, 0.0f);
-    addCylinder(vertices, indices, rightPos, height, cylinderRadius, color, 0.0f, sectors);
+    addCylinder(builder, rightPos, height, cylinderRadius, 0.0f, sectors);
 
-    // Ustawienie siatki
-    setupMesh(vertices, indices);
-    vertexCount = vertices.size();
-    triangleCount = indices.size() / 3;
+    return createSharedMesh(builder.takeMeshData());
+}
 
+/**
+ * @brief Dodaje prostopadłościan do obiektu
+ * @param builder Budowniczy siatki obiektu
+ * @param position Pozycja środka prostopadłościanu
+ * @param size Rozmiar prostopadłościanu
+ */
+void ComplexObject::addCuboid(MeshBuilder& builder, const glm::vec3& position, const glm::vec3& size) {
+    builder.pushTransform(glm::translate(glm::mat4(1.0f), position));
+    builder.addCuboid(size);
+    builder.popTransform();
 }
 
 /**
  * @brief Dodaje cylinder do obiektu
- * @param vertices Referencja do wektora wierzchołków (będzie modyfikowany)
- * @param indices Referencja do wektora indeksów (będzie modyfikowany)
+ * @param builder Budowniczy siatki obiektu
  * @param position Pozycja cylindra
  * @param height Wysokość cylindra
  * @param radius Promień cylindra
- * @param color Kolor cylindra
  * @param rotationAngle Kąt obrotu cylindra wokół osi Z (w stopniach)
  * @param sectors Liczba sektorów (dokładność przybliżenia cylindra)
  *
- * @details Generuje wierzchołki i indeksy dla cylindra składającego się z:
- * - Dwóch podstaw (górnej i dolnej)
- * - Bocznej ściany
- * Każdy cylinder jest transformowany zgodnie z podaną pozycją, rotacją i skalą
+ * @details Cylinder jednostkowy jest skalowany, obracany i przesuwany
+ * transformacją budowniczego w chwili zapisu wierzchołków, bez tymczasowych
+ * tablic pozycji, normalnych i współrzędnych tekstury.
  */
-void ComplexObject::addCylinder(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
-                               const glm::vec3& position, float height, float radius,
-                               const glm::vec3& color, float rotationAngle, int sectors) {
-    const float PI = 3.14159265358979323846f;
-    int baseIndex = vertices.size();
-
-    float sectorStep = 2.0f * PI / sectors;
-
-    // Transformacja cylindra
+void ComplexObject::addCylinder(MeshBuilder& builder, const glm::vec3& position, float height, float radius,
+                               float rotationAngle, int sectors) {
     glm::mat4 transform = glm::mat4(1.0f);
     transform = glm::translate(transform, position);
     transform = glm::rotate(transform, glm::radians(rotationAngle), glm::vec3(0.0f, 0.0f, 1.0f));
     transform = glm::scale(transform, glm::vec3(radius, height, radius));
 
-    // Transformacja normalnych (bez skalowania)
-    glm::mat3 normalTransform = glm::mat3(glm::rotate(glm::mat4(1.0f),
-                                                      glm::radians(rotationAngle),
-                                                      glm::vec3(0.0f, 0.0f, 1.0f)));
-
-    // Generowanie wierzchołków puszki
-    std::vector<glm::vec3> localPositions;
-    std::vector<glm::vec3> localNormals;
-    std::vector<glm::vec2> texCoords;
-
-    // Centra podstaw
-    localPositions.push_back(glm::vec3(0.0f, 0.5f, 0.0f));   // górny środek
-    localNormals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
-    texCoords.push_back(glm::vec2(0.5f, 0.5f));
-
-    localPositions.push_back(glm::vec3(0.0f, -0.5f, 0.0f));  // dolny środek
-    localNormals.push_back(glm::vec3(0.0f, -1.0f, 0.0f));
-    texCoords.push_back(glm::vec2(0.5f, 0.5f));
-
-    // Wierzchołki obwodu
-    for (int i = 0; i <= sectors; ++i) {
-        float angle = i * sectorStep;
-        float x = cosf(angle);
-        float z = sinf(angle);
-
-        glm::vec3 sideNormal = glm::normalize(glm::vec3(x, 0.0f, z));
-
-        // górna podstawa
-        localPositions.push_back(glm::vec3(x, 0.5f, z));
-        localNormals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
-        texCoords.push_back(glm::vec2(x * 0.5f + 0.5f, z * 0.5f + 0.5f));
-
-        // dolna podstawa
-        localPositions.push_back(glm::vec3(x, -0.5f, z));
-        localNormals.push_back(glm::vec3(0.0f, -1.0f, 0.0f));
-        texCoords.push_back(glm::vec2(x * 0.5f + 0.5f, z * 0.5f + 0.5f));
-
-        // ściana górna
-        localPositions.push_back(glm::vec3(x, 0.5f, z));
-        localNormals.push_back(sideNormal);
-        texCoords.push_back(glm::vec2(static_cast<float>(i) / sectors, 1.0f));
-
-        // ściana dolna
-        localPositions.push_back(glm::vec3(x, -0.5f, z));
-        localNormals.push_back(sideNormal);
-        texCoords.push_back(glm::vec2(static_cast<float>(i) / sectors, 0.0f));
-    }
-
-    for (size_t i = 0; i < localPositions.size(); ++i) {
-        Vertex v;
-        glm::vec4 pos(localPositions[i], 1.0f);
-        pos = transform * pos;
-        v.position = glm::vec3(pos);
-
-        v.normal = glm::normalize(normalTransform * localNormals[i]);
-        v.texCoord = texCoords[i];
-
-        vertices.push_back(v);
-    }
-
-    for (int i = 0; i < sectors; ++i) {
-        indices.push_back(baseIndex + 0);
-        indices.push_back(baseIndex + 2 + (i + 1) * 4);
-        indices.push_back(baseIndex + 2 + i * 4);
-    }
+    builder.pushTransform(transform);
+    builder.addCylinder(sectors);
+    builder.popTransform();
+}
 
-    for (int i = 0; i < sectors; ++i) {
-        indices.push_back(baseIndex + 1);
-        indices.push_back(baseIndex + 3 + i * 4);
-        indices.push_back(baseIndex + 3 + (i + 1) * 4);
+/**
+ * @brief Dzieli siatkę na meshlety, buduje poziomy szczegółowości i wysyła wszystko na GPU
+ * @param data Wierzchołki i indeksy (zachowywane jako kopia CPU)
+ * @return Nowa wspólna siatka
+ *
+ * @details Poziomy tworzy LodChain (upraszczanie QEM); wybór poziomu
+ * w trakcie rysowania należy do LodSelector.
+ */
+std::shared_ptr<const ComplexObject::SharedMesh> ComplexObject::createSharedMesh(MeshData data) {
+    auto shared = std::make_shared<SharedMesh>();
+
+    // Podział na meshlety przestawia trójkąty, więc musi poprzedzać wysłanie na GPU
+    shared->meshlets = MeshletBuilder::build(data);
+    uploadMesh(shared->mesh, data);
+
+    shared->lodErrors.assign(1, 0.0f);
+    std::vector<LodLevel> levels = LodChain::build(data);
+    shared->lodMeshes.resize(levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        uploadMesh(shared->lodMeshes[i], levels[i].data);
+        shared->lodErrors.push_back(levels[i].error);
     }
 
-    for (int i = 0; i < sectors; ++i) {
-        int base = baseIndex + 2 + i * 4;
-        int next = baseIndex + 2 + (i + 1) * 4;
-
-        indices.push_back(base + 2);
-        indices.push_back(next + 2);
-        indices.push_back(base + 3);
-
-        indices.push_back(base + 3);
-        indices.push_back(next + 2);
-        indices.push_back(next + 3);
-    }
+    shared->meshData = std::move(data);
+    return shared;
 }
 
 /**
- * @brief Konfiguruje siatkę 3D z podanych wierzchołków i indeksów
- * @param vertices Wektor wierzchołków
- * @param indices Wektor indeksów
+ * @brief Tworzy bufory OpenGL siatki i konfiguruje atrybuty wierzchołków
+ * @param target Siatka do utworzenia
+ * @param data Wierzchołki i indeksy
  *
  * @details Tworzy VAO, VBO i EBO w OpenGL, przesyła dane do GPU
  * i konfiguruje atrybuty wierzchołków (pozycja, normalna, UV)
  */
-void ComplexObject::setupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-    deleteMesh();
+void ComplexObject::uploadMesh(Mesh& target, const MeshData& data) {
+    const std::vector<Vertex>& vertices = data.vertices;
+    const std::vector<unsigned int>& indices = data.indices;
 
-    glGenVertexArrays(1, &mesh.VAO);
-    glGenBuffers(1, &mesh.VBO);
-    glGenBuffers(1, &mesh.EBO);
+    glGenVertexArrays(1, &target.VAO);
+    glGenBuffers(1, &target.VBO);
+    glGenBuffers(1, &target.EBO);
 
-    glBindVertexArray(mesh.VAO);
+    glBindVertexArray(target.VAO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, target.VBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, target.EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
 
     // Atrybuty wierzchołków
@@ -224,36 +228,59 @@ void ComplexObject::setupMesh(const std::vector<Vertex>& vertices, const std::ve
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
 
     glBindVertexArray(0);
-    mesh.indexCount = static_cast<int>(indices.size());
+    target.indexCount = static_cast<int>(indices.size());
 }
 
 /**
- * @brief Usuwa zasoby siatki 3D (VAO, VBO, EBO)
+ * @brief Zwraca kopię CPU siatki obiektu
+ * @return Wierzchołki i indeksy w przestrzeni lokalnej (puste przed createLetterH())
  */
-void ComplexObject::deleteMesh() {
-    if (mesh.VAO) {
-        glDeleteVertexArrays(1, &mesh.VAO);
-        glDeleteBuffers(1, &mesh.VBO);
-        glDeleteBuffers(1, &mesh.EBO);
-        mesh.VAO = mesh.VBO = mesh.EBO = 0;
-        mesh.indexCount = 0;
-    }
+const MeshData& ComplexObject::getMeshData() const {
+    static const MeshData empty;
+    return sharedMesh ? sharedMesh->meshData : empty;
+}
+
+/**
+ * @brief Zwraca błędy poziomów szczegółowości
+ * @return Błędy w przestrzeni lokalnej (indeks 0 = siatka pełna)
+ */
+const std::vector<float>& ComplexObject::getLodErrors() const {
+    static const std::vector<float> fullOnly(1, 0.0f);
+    return sharedMesh ? sharedMesh->lodErrors : fullOnly;
 }
 
 /**
  * @brief Rysuje złożony obiekt
+ * @param lod Poziom szczegółowości (0 = siatka pełna, poza zakresem też)
  *
  * @details Używa VAO i EBO do narysowania obiektu za pomocą glDrawElements
  * Jeśli siatka nie jest zainicjalizowana, wypisuje błąd
  */
-void ComplexObject::draw() const {
-    if (mesh.VAO == 0 || mesh.indexCount == 0) {
+void ComplexObject::draw(int lod) const {
+    if (!sharedMesh || sharedMesh->mesh.indexCount == 0) {
+        std::cerr << "Błąd: Jeśli to czytasz to zainicjalizuj litere H w main.cpp" << std::endl;
+        return;
+    }
+
+    const std::vector<Mesh>& lodMeshes = sharedMesh->lodMeshes;
+    const Mesh& selected = lod > 0 && lod <= static_cast<int>(lodMeshes.size()) ? lodMeshes[lod - 1] : sharedMesh->mesh;
+    glBindVertexArray(selected.VAO);
+    glDrawElements(GL_TRIANGLES, selected.indexCount, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Rysuje pełną siatkę z odrzucaniem meshletów (MeshletCuller)
+ * @param model Macierz modelu używana przez shader
+ */
+void ComplexObject::drawMeshlets(const glm::mat4& model) const {
+    if (!sharedMesh || sharedMesh->mesh.indexCount == 0) {
         std::cerr << "Błąd: Jeśli to czytasz to zainicjalizuj litere H w main.cpp" << std::endl;
         return;
     }
 
-    glBindVertexArray(mesh.VAO);
-    glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(sharedMesh->mesh.VAO);
+    MeshletCuller::instance().draw(sharedMesh->meshlets, model);
     glBindVertexArray(0);
 }
 
@@ -1,9 +1,11 @@
 #ifndef COMPLEX_OBJECT_HPP
 #define COMPLEX_OBJECT_HPP
 #include <glm/gtc/matrix_transform.hpp>
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 #include "GeometryRenderer.hpp"
+#include "Mesh/MeshBuilder.hpp"
 
 /**
  * @class ComplexObject
@@ -11,6 +13,9 @@
  *
  * Obsługuje tworzenie i renderowanie złożonych kształtów 3D, takich jak litery.
  * Aktualnie implementuje tworzenie litery H z cylindrów.
+ *
+ * Siatka, jej poziomy szczegółowości i meshlety budowane są raz dla każdego
+ * kształtu i współdzielone przez wszystkie obiekty o tych samych wymiarach.
  */
 class ComplexObject {
 public:
@@ -22,7 +27,7 @@ public:
     /**
      * @brief Destruktor ComplexObject
      *
-     * Zwalnia zasoby graficzne (VAO, VBO, EBO)
+     * Zwalnia odwołanie do wspólnej siatki (ostatnie usuwa VAO, VBO i EBO)
      */
     ~ComplexObject();
 
@@ -37,8 +42,15 @@ public:
 
     /**
      * @brief Rysuje złożony obiekt
+     * @param lod Poziom szczegółowości (0 = siatka pełna)
+     */
+    void draw(int lod = 0) const;
+
+    /**
+     * @brief Rysuje pełną siatkę z odrzucaniem meshletów (MeshletCuller)
+     * @param model Macierz modelu używana przez shader
      */
-    void draw() const;
+    void drawMeshlets(const glm::mat4& model) const;
 
     // Transformacje
 
@@ -96,8 +108,22 @@ public:
      */
     int getTriangleCount() const { return triangleCount; }
 
+    /**
+     * @brief Zwraca kopię CPU siatki obiektu
+     * @return Wierzchołki i indeksy w przestrzeni lokalnej (wspólne dla obiektów o tym samym kształcie)
+     */
+    const MeshData& getMeshData() const;
+
+    /**
+     * @brief Zwraca błędy poziomów szczegółowości
+     * @return Błędy w przestrzeni lokalnej (indeks 0 = siatka pełna)
+     */
+    const std::vector<float>& getLodErrors() const;
+
 private:
-    Mesh mesh;                    /**< Struktura siatki 3D (VAO, VBO, EBO) */
+    struct SharedMesh;
+
+    std::shared_ptr<const SharedMesh> sharedMesh; /**< Siatka z poziomami i meshletami (nullptr = brak) */
     glm::vec3 position;          /**< Pozycja obiektu w przestrzeni świata */
     glm::vec3 scale;             /**< Skala obiektu */
     glm::vec3 rotation;          /**< Rotacja obiektu (kąty Eulera w stopniach) */
@@ -105,44 +131,46 @@ private:
     int triangleCount;           /**< Liczba trójkątów w obiekcie */
 
     /**
-     * @brief Konfiguruje siatkę 3D z podanych wierzchołków i indeksów
-     * @param vertices Wektor wierzchołków
-     * @param indices Wektor indeksów
+     * @brief Buduje siatkę litery H wraz z poziomami szczegółowości
+     * @param width Szerokość litery H
+     * @param height Wysokość litery H
+     * @return Nowa wspólna siatka
+     */
+    static std::shared_ptr<const SharedMesh> buildLetterH(float width, float height);
+
+    /**
+     * @brief Dzieli siatkę na meshlety, buduje poziomy szczegółowości i wysyła wszystko na GPU
+     * @param data Wierzchołki i indeksy (zachowywane jako kopia CPU)
+     * @return Nowa wspólna siatka
      */
-    void setupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    static std::shared_ptr<const SharedMesh> createSharedMesh(MeshData data);
 
     /**
-     * @brief Usuwa zasoby siatki 3D (VAO, VBO, EBO)
+     * @brief Tworzy bufory OpenGL siatki i konfiguruje atrybuty wierzchołków
+     * @param target Siatka do utworzenia
+     * @param data Wierzchołki i indeksy
      */
-    void deleteMesh();
+    static void uploadMesh(Mesh& target, const MeshData& data);
 
     /**
      * @brief Dodaje prostopadłościan do obiektu
-     * @param vertices Referencja do wektora wierzchołków (będzie modyfikowany)
-     * @param indices Referencja do wektora indeksów (będzie modyfikowany)
-     * @param position Pozycja prostopadłościanu
+     * @param builder Budowniczy siatki obiektu
+     * @param position Pozycja środka prostopadłościanu
      * @param size Rozmiar prostopadłościanu
-     * @param color Kolor prostopadłościanu
-     * @param uvScale Skala współrzędnych tekstury (domyślnie 1.0)
      */
-    void addCuboid(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
-                  const glm::vec3& position, const glm::vec3& size, const glm::vec3& color,
-                  const glm::vec2& uvScale = glm::vec2(1.0f));
+    static void addCuboid(MeshBuilder& builder, const glm::vec3& position, const glm::vec3& size);
 
     /**
      * @brief Dodaje cylinder do obiektu
-     * @param vertices Referencja do wektora wierzchołków (będzie modyfikowany)
-     * @param indices Referencja do wektora indeksów (będzie modyfikowany)
+     * @param builder Budowniczy siatki obiektu
      * @param position Pozycja cylindra
      * @param height Wysokość cylindra
      * @param radius Promień cylindra
-     * @param color Kolor cylindra
      * @param rotationAngle Kąt obrotu cylindra wokół osi Z (w stopniach)
      * @param sectors Liczba sektorów (dokładność przybliżenia cylindra)
      */
-    void addCylinder(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
-                    const glm::vec3& position, float height, float radius,
-                    const glm::vec3& color, float rotationAngle, int sectors);
+    static void addCylinder(MeshBuilder& builder, const glm::vec3& position, float height, float radius,
+                            float rotationAngle, int sectors);
 };
 
 #endif
\ No newline at end of file
@@ -379,6 +379,12 @@ public:
      * @return Czas delta w sekundach
      */
     double getDeltaTime() const { return m_deltaTime; }
+
+    /**
+     * @brief Zwraca docelową liczbę klatek na sekundę
+     * @return Docelowe FPS
+     */
+    int getFPS() const { return m_targetFPS; }
 };
 
 #endif // ENGINE_HPP
\ No newline at end of file
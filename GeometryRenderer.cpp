@@ -1,6 +1,14 @@
 #define GLEW_STATIC
 #include <GL/glew.h>
 #include "GeometryRenderer.hpp"
+#include "Material/MaterialTable.hpp"
+#include "Mesh/LodChain.hpp"
+#include "Mesh/MeshBuilder.hpp"
+#include "Mesh/MeshletCuller.hpp"
+#include "Mesh/PrimitiveData.hpp"
+#include "Stats/RenderStats.hpp"
+#include <chrono>
+#include <cstring>
 #include <cmath>
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
@@ -13,7 +21,7 @@
  *
  * Inicjalizuje tryb rysowania i domyślne właściwości materiału
  */
-GeometryRenderer::GeometryRenderer() : m_drawMode(GL_TRIANGLES) {
+GeometryRenderer::GeometryRenderer() : m_drawMode(GL_TRIANGLES), m_materialId(INVALID_MATERIAL) {
     m_currentMaterial.ambient = glm::vec3(0.2f, 0.2f, 0.2f);
     m_currentMaterial.diffuse = glm::vec3(0.8f, 0.8f, 0.8f);
     m_currentMaterial.specular = glm::vec3(0.5f, 0.5f, 0.5f);
@@ -26,6 +34,8 @@ GeometryRenderer::GeometryRenderer() : m_drawMode(GL_TRIANGLES) {
  * Zwalnia wszystkie zasoby OpenGL (VAO, VBO, EBO)
  */
 GeometryRenderer::~GeometryRenderer() {
+    MaterialTable::instance().releaseMaterial(m_materialId);
+
     deleteMesh(m_cubeMesh);
     deleteMesh(m_sphereMesh);
     deleteMesh(m_cylinderMesh);
@@ -34,6 +44,9 @@ GeometryRenderer::~GeometryRenderer() {
     deleteMesh(m_torusMesh);
     deleteMesh(m_pyramidMesh);
     deleteMesh(m_gridMesh);
+    for (Mesh& lod : m_sphereLods) {
+        deleteMesh(lod);
+    }
 
     glDeleteVertexArrays(1, &m_lineVAO);
     glDeleteBuffers(1, &m_lineVBO);
@@ -58,6 +71,7 @@ bool GeometryRenderer::initialize() {
     }
 
     // Utworzenie podstawowych kształtów
+    auto primitivesStart = std::chrono::high_resolution_clock::now();
     createCube();
     createSphere();
     createCylinder();
@@ -66,6 +80,16 @@ bool GeometryRenderer::initialize() {
     createTorus();
     createPyramid();
     createGrid();
+    auto primitivesEnd = std::chrono::high_resolution_clock::now();
+    RenderStats::instance().setValue("Start/Tworzenie prymitywow [ms]",
+        std::chrono::duration<double, std::milli>(primitivesEnd - primitivesStart).count());
+
+    auto lodStart = std::chrono::high_resolution_clock::now();
+    createSphereLods();
+    createSphereMeshlets();
+    auto lodEnd = std::chrono::high_resolution_clock::now();
+    RenderStats::instance().setValue("Start/Generowanie LOD [ms]",
+        std::chrono::duration<double, std::milli>(lodEnd - lodStart).count());
 
     // Inicjalizacja buforów dla linii i punktów
     glGenVertexArrays(1, &m_lineVAO);
@@ -88,6 +112,21 @@ bool GeometryRenderer::initialize() {
  * i konfiguruje atrybuty wierzchołków (pozycja, normalna, UV).
  */
 void GeometryRenderer::setupMesh(Mesh& mesh, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    setupMesh(mesh, vertices.data(), vertices.size(), indices.data(), indices.size());
+}
+
+/**
+ * @brief Konfiguruje siatkę 3D z tablic wierzchołków i indeksów
+ * @param mesh Referencja do struktury Mesh
+ * @param vertices Wierzchołki (układ Vertex)
+ * @param vertexCount Liczba wierzchołków
+ * @param indices Indeksy
+ * @param indexCount Liczba indeksów
+ *
+ * @details Tablice mogą leżeć w danych tylko do odczytu programu
+ * (Primitives::PackedVertex ma układ Vertex).
+ */
+void GeometryRenderer::setupMesh(Mesh& mesh, const void* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount) {
     glGenVertexArrays(1, &mesh.VAO);
     glGenBuffers(1, &mesh.VBO);
     glGenBuffers(1, &mesh.EBO);
@@ -96,11 +135,11 @@ void GeometryRenderer::setupMesh(Mesh& mesh, const std::vector<Vertex>& vertices
 
     // Wierzchołki
     glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), vertices, GL_STATIC_DRAW);
 
     // Indeksy
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), indices, GL_STATIC_DRAW);
 
     // Atrybuty wierzchołków
     // Pozycja
@@ -116,7 +155,29 @@ void GeometryRenderer::setupMesh(Mesh& mesh, const std::vector<Vertex>& vertices
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
 
     glBindVertexArray(0);
-    mesh.indexCount = static_cast<int>(indices.size());
+    mesh.indexCount = static_cast<int>(indexCount);
+}
+
+/**
+ * @brief Tworzy kształt z danych wygenerowanych w czasie kompilacji
+ * @param type Rodzaj kształtu (wpis w m_meshData)
+ * @param mesh Siatka do utworzenia
+ * @param vertices Wierzchołki (układ Vertex)
+ * @param vertexCount Liczba wierzchołków
+ * @param indices Indeksy
+ * @param indexCount Liczba indeksów
+ *
+ * @details Dane wysyłane są do GPU bez przetwarzania, a kopia CPU
+ * (dla paczek statycznych i dynamicznych) powstaje jednym memcpy.
+ */
+void GeometryRenderer::setupStaticMesh(PrimitiveType type, Mesh& mesh, const void* vertices, size_t vertexCount,
+                                       const unsigned int* indices, size_t indexCount) {
+    setupMesh(mesh, vertices, vertexCount, indices, indexCount);
+
+    MeshData& data = m_meshData[static_cast<int>(type)];
+    data.vertices.resize(vertexCount);
+    std::memcpy(static_cast<void*>(data.vertices.data()), vertices, vertexCount * sizeof(Vertex));
+    data.indices.assign(indices, indices + indexCount);
 }
 
 /**
@@ -134,56 +195,12 @@ void GeometryRenderer::deleteMesh(Mesh& mesh) {
  *
  * @details Tworzy sześcian o rozmiarze 1x1x1 ze środkiem w (0,0,0).
  * Każda ściana ma normalną skierowaną na zewnątrz i współrzędne UV.
+ * Dane pochodzą z Primitives::CUBE (czas kompilacji).
  */
 void GeometryRenderer::createCube() {
-    std::vector<Vertex> vertices = {
-        // Front
-        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
-        {{ 0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
-        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
-        {{-0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
-
-        // Back
-        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f}},
-        {{-0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 1.0f}},
-        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f}},
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
-
-        // Top
-        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}},
-        {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
-        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},
-
-        // Bottom
-        {{-0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 1.0f}},
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
-        {{ 0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
-        {{-0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
-
-        // Right
-        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
-        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
-        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
-
-        // Left
-        {{-0.5f, -0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
-        {{-0.5f, -0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
-        {{-0.5f,  0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-        {{-0.5f,  0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}}
-    };
-
-    std::vector<unsigned int> indices = {
-        0, 1, 2, 2, 3, 0,    // Front
-        4, 5, 6, 6, 7, 4,    // Back
-        8, 9, 10, 10, 11, 8, // Top
-        12, 13, 14, 14, 15, 12, // Bottom
-        16, 17, 18, 18, 19, 16, // Right
-        20, 21, 22, 22, 23, 20  // Left
-    };
-
-    setupMesh(m_cubeMesh, vertices, indices);
+    const auto& cube = Primitives::CUBE;
+    setupStaticMesh(PrimitiveType::CUBE, m_cubeMesh, cube.vertices.data(), cube.vertices.size(),
+                    cube.indices.data(), cube.indices.size());
 }
 
 /**
@@ -192,55 +209,24 @@ void GeometryRenderer::createCube() {
  * @param stacks Liczba warstw (dokładność wzdłuż osi Y)
  *
  * @details Tworzy sferę o promieniu 1 metodą parametryczną (phi i theta).
- * Wykorzystuje parametryczne równania sfery.
+ * Wykorzystuje parametryczne równania sfery. Dla domyślnej tesselacji
+ * dane pochodzą z Primitives::SPHERE (czas kompilacji).
  */
 void GeometryRenderer::createSphere(int sectors, int stacks) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-
-    float sectorStep = 2 * PI / sectors;
-    float stackStep = PI / stacks;
-
-    for (int i = 0; i <= stacks; ++i) {
-        float stackAngle = PI / 2 - i * stackStep;
-        float xy = cosf(stackAngle);
-        float z = sinf(stackAngle);
-
-        for (int j = 0; j <= sectors; ++j) {
-            float sectorAngle = j * sectorStep;
-
-            float x = xy * cosf(sectorAngle);
-            float y = xy * sinf(sectorAngle);
-
-            Vertex vertex;
-            vertex.position = glm::vec3(x, y, z);
-            vertex.normal = glm::vec3(x, y, z);
-            vertex.texCoord = glm::vec2((float)j / sectors, (float)i / stacks);
-
-            vertices.push_back(vertex);
-        }
+    if (sectors == Primitives::SPHERE_SECTORS && stacks == Primitives::SPHERE_STACKS) {
+        const auto& sphere = Primitives::SPHERE;
+        setupStaticMesh(PrimitiveType::SPHERE, m_sphereMesh, sphere.vertices.data(), sphere.vertices.size(),
+                        sphere.indices.data(), sphere.indices.size());
+        return;
     }
 
-    for (int i = 0; i < stacks; ++i) {
-        int k1 = i * (sectors + 1);
-        int k2 = k1 + sectors + 1;
-
-        for (int j = 0; j < sectors; ++j, ++k1, ++k2) {
-            if (i != 0) {
-                indices.push_back(k1);
-                indices.push_back(k2);
-                indices.push_back(k1 + 1);
-            }
-
-            if (i != (stacks - 1)) {
-                indices.push_back(k1 + 1);
-                indices.push_back(k2);
-                indices.push_back(k2 + 1);
-            }
-        }
-    }
+    MeshBuilder builder;
+    builder.reserve(MeshBuilder::sphereCounts(sectors, stacks));
+    builder.addSphere(sectors, stacks);
+    MeshData data = builder.takeMeshData();
 
-    setupMesh(m_sphereMesh, vertices, indices);
+    setupMesh(m_sphereMesh, data.vertices, data.indices);
+    m_meshData[static_cast<int>(PrimitiveType::SPHERE)] = std::move(data);
 }
 
 /**
@@ -250,66 +236,23 @@ void GeometryRenderer::createSphere(int sectors, int stacks) {
  * @details Tworzy cylinder o wysokości 1 i promieniu 1.
  * Składa się z dwóch podstaw (górnej i dolnej) i ściany bocznej.
  * Wykorzystuje poprawny winding order (CCW) dla wszystkich trójkątów.
+ * Dla domyślnej tesselacji dane pochodzą z Primitives::CYLINDER.
  */
 void GeometryRenderer::createCylinder(int sectors) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-
-    float sectorStep = 2.0f * PI / sectors;
-
-    // Centra podstaw
-    vertices.push_back({{0.0f, 0.5f, 0.0f},  {0.0f, 1.0f, 0.0f}, {0.5f, 0.5f}});   // 0
-    vertices.push_back({{0.0f, -0.5f, 0.0f}, {0.0f,-1.0f, 0.0f}, {0.5f, 0.5f}});   // 1
-
-    // Wierzchołki obwodu
-    for (int i = 0; i <= sectors; ++i) {
-        float angle = i * sectorStep;
-        float x = cosf(angle);
-        float z = sinf(angle);
-
-        glm::vec3 sideNormal = glm::normalize(glm::vec3(x, 0.0f, z));
-
-        // top
-        vertices.push_back({{x,  0.5f, z}, {0,1,0}, {x*0.5f+0.5f, z*0.5f+0.5f}});
-        // bottom
-        vertices.push_back({{x, -0.5f, z}, {0,-1,0},{x*0.5f+0.5f, z*0.5f+0.5f}});
-        // side top
-        vertices.push_back({{x,  0.5f, z}, sideNormal, {(float)i/sectors, 1.0f}});
-        // side bottom
-        vertices.push_back({{x, -0.5f, z}, sideNormal, {(float)i/sectors, 0.0f}});
+    if (sectors == Primitives::CYLINDER_SECTORS) {
+        const auto& cylinder = Primitives::CYLINDER;
+        setupStaticMesh(PrimitiveType::CYLINDER, m_cylinderMesh, cylinder.vertices.data(), cylinder.vertices.size(),
+                        cylinder.indices.data(), cylinder.indices.size());
+        return;
     }
 
-    // GÓRNA PODSTAWA (CCW)
-    for (int i = 0; i < sectors; ++i) {
-        indices.push_back(0);
-        indices.push_back(2 + (i+1)*4);
-        indices.push_back(2 + i*4);
-    }
+    MeshBuilder builder;
+    builder.reserve(MeshBuilder::cylinderCounts(sectors));
+    builder.addCylinder(sectors);
+    MeshData data = builder.takeMeshData();
 
-    // DOLNA PODSTAWA (CCW)
-    for (int i = 0; i < sectors; ++i) {
-        indices.push_back(1);
-        indices.push_back(3 + i*4);
-        indices.push_back(3 + (i+1)*4);
-    }
-
-    // ŚCIANY BOCZNE – 🔥 POPRAWIONY WINDING (ale dospermiona emotka)
-    for (int i = 0; i < sectors; ++i) {
-        int base = 2 + i * 4;
-        int next = 2 + (i + 1) * 4;
-
-        // triangle 1
-        indices.push_back(base + 2);
-        indices.push_back(next + 2);
-        indices.push_back(base + 3);
-
-        // triangle 2
-        indices.push_back(base + 3);
-        indices.push_back(next + 2);
-        indices.push_back(next + 3);
-    }
-
-    setupMesh(m_cylinderMesh, vertices, indices);
+    setupMesh(m_cylinderMesh, data.vertices, data.indices);
+    m_meshData[static_cast<int>(PrimitiveType::CYLINDER)] = std::move(data);
 }
 
 /**
@@ -318,8 +261,16 @@ void GeometryRenderer::createCylinder(int sectors) {
  *
  * @details Tworzy stożek o wysokości 1 i promieniu podstawy 1.
  * Składa się z podstawy i ściany bocznej zbiegającej się w wierzchołku.
+ * Dla domyślnej tesselacji dane pochodzą z Primitives::CONE.
  */
 void GeometryRenderer::createCone(int sectors) {
+    if (sectors == Primitives::CONE_SECTORS) {
+        const auto& cone = Primitives::CONE;
+        setupStaticMesh(PrimitiveType::CONE, m_coneMesh, cone.vertices.data(), cone.vertices.size(),
+                        cone.indices.data(), cone.indices.size());
+        return;
+    }
+
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
 
@@ -359,27 +310,20 @@ void GeometryRenderer::createCone(int sectors) {
     }
 
     setupMesh(m_coneMesh, vertices, indices);
+    m_meshData[static_cast<int>(PrimitiveType::CONE)] = {vertices, indices};
 }
 
 /**
  * @brief Tworzy siatkę płaszczyzny jednostkowej
  *
  * @details Tworzy kwadratową płaszczyznę o rozmiarze 1x1 w płaszczyźnie XZ.
- * Normalna skierowana jest w górę (wzdłuż osi Y).
+ * Normalna skierowana jest w górę (wzdłuż osi Y). Dane pochodzą
+ * z Primitives::PLANE (czas kompilacji).
  */
 void GeometryRenderer::createPlane() {
-    std::vector<Vertex> vertices = {
-        {{-0.5f, 0.0f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
-        {{ 0.5f, 0.0f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-        {{ 0.5f, 0.0f,  0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},
-        {{-0.5f, 0.0f,  0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}}
-    };
-
-    std::vector<unsigned int> indices = {
-        0, 1, 2, 2, 3, 0
-    };
-
-    setupMesh(m_planeMesh, vertices, indices);
+    const auto& plane = Primitives::PLANE;
+    setupStaticMesh(PrimitiveType::PLANE, m_planeMesh, plane.vertices.data(), plane.vertices.size(),
+                    plane.indices.data(), plane.indices.size());
 }
 
 /**
@@ -390,111 +334,76 @@ void GeometryRenderer::createPlane() {
  * @param rings Liczba pierścieni
  *
  * @details Tworzy torus metodą parametryczną (dwa kąty).
- * Torus jest podobny do obwarzanka lub dętki.
+ * Torus jest podobny do obwarzanka lub dętki. Dla domyślnych parametrów
+ * dane pochodzą z Primitives::TORUS.
  */
 void GeometryRenderer::createTorus(float radius, float tubeRadius, int sectors, int rings) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-
-    float sectorStep = 2 * PI / sectors;
-    float ringStep = 2 * PI / rings;
-
-    for (int i = 0; i <= rings; ++i) {
-        float ringAngle = i * ringStep;
-        float cosRing = cosf(ringAngle);
-        float sinRing = sinf(ringAngle);
-
-        for (int j = 0; j <= sectors; ++j) {
-            float sectorAngle = j * sectorStep;
-            float cosSector = cosf(sectorAngle);
-            float sinSector = sinf(sectorAngle);
-
-            Vertex vertex;
-            vertex.position.x = (radius + tubeRadius * cosSector) * cosRing;
-            vertex.position.y = (radius + tubeRadius * cosSector) * sinRing;
-            vertex.position.z = tubeRadius * sinSector;
-
-            vertex.normal.x = cosRing * cosSector;
-            vertex.normal.y = sinRing * cosSector;
-            vertex.normal.z = sinSector;
-
-            vertex.texCoord.x = static_cast<float>(j) / sectors;
-            vertex.texCoord.y = static_cast<float>(i) / rings;
-
-            vertices.push_back(vertex);
-        }
+    if (radius == Primitives::TORUS_RADIUS && tubeRadius == Primitives::TORUS_TUBE_RADIUS &&
+        sectors == Primitives::TORUS_SECTORS && rings == Primitives::TORUS_RINGS) {
+        const auto& torus = Primitives::TORUS;
+        setupStaticMesh(PrimitiveType::TORUS, m_torusMesh, torus.vertices.data(), torus.vertices.size(),
+                        torus.indices.data(), torus.indices.size());
+        return;
     }
 
-    for (int i = 0; i < rings; ++i) {
-        for (int j = 0; j < sectors; ++j) {
-            int first = i * (sectors + 1) + j;
-            int second = first + sectors + 1;
-
-            indices.push_back(first);
-            indices.push_back(second);
-            indices.push_back(first + 1);
-
-            indices.push_back(second);
-            indices.push_back(second + 1);
-            indices.push_back(first + 1);
-        }
-    }
+    MeshBuilder builder;
+    builder.reserve(MeshBuilder::torusCounts(sectors, rings));
+    builder.addTorus(radius, tubeRadius, sectors, rings);
+    MeshData data = builder.takeMeshData();
 
-    setupMesh(m_torusMesh, vertices, indices);
+    setupMesh(m_torusMesh, data.vertices, data.indices);
+    m_meshData[static_cast<int>(PrimitiveType::TORUS)] = std::move(data);
 }
 
 /**
  * @brief Tworzy siatkę piramidy (ostrosłupa kwadratowego)
  *
  * @details Tworzy piramidę o podstawie kwadratowej i wysokości 1.
- * Każda ściana boczna jest osobno triangulowana z poprawnymi normalnymi.
+ * Każda ściana boczna jest osobno triangulowana z poprawnymi normalnymi
+ * (obliczonymi w czasie kompilacji, Primitives::PYRAMID).
  */
 void GeometryRenderer::createPyramid() {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-
-    glm::vec3 base[4] = {
-        {-0.5f, -0.5f, -0.5f},
-        { 0.5f, -0.5f, -0.5f},
-        { 0.5f, -0.5f,  0.5f},
-        {-0.5f, -0.5f,  0.5f}
-    };
-
-    glm::vec3 apex = {0.0f, 0.5f, 0.0f};
+    const auto& pyramid = Primitives::PYRAMID;
+    setupStaticMesh(PrimitiveType::PYRAMID, m_pyramidMesh, pyramid.vertices.data(), pyramid.vertices.size(),
+                    pyramid.indices.data(), pyramid.indices.size());
+}
 
-    /* ===== PODSTAWA ===== */
-    int baseStart = 0;
-    for (int i = 0; i < 4; ++i) {
-        vertices.push_back({
-            base[i],
-            {0.0f, -1.0f, 0.0f},
-            {0.0f, 0.0f}
-        });
+/**
+ * @brief Buduje uproszczone poziomy szczegółowości sfery
+ *
+ * @details Poziomy powstają z kopii CPU sfery przez upraszczanie QEM
+ * (MeshSimplifier); szew UV i bieguny zostają zachowane. Błędy poziomów
+ * trafiają do m_sphereLodErrors, z których korzysta LodSelector.
+ */
+void GeometryRenderer::createSphereLods() {
+    for (Mesh& lod : m_sphereLods) {
+        deleteMesh(lod);
     }
-
-    /* ===== ŚCIANY BOCZNE ===== */
-    for (int i = 0; i < 4; ++i) {
-        int next = (i + 1) % 4;
-
-        // UWAGA: KOLEJNOŚĆ MA ZNACZENIE
-        glm::vec3 edge1 = apex - base[i];
-        glm::vec3 edge2 = base[next] - base[i];
-        glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
-
-        int start = vertices.size();
-
-        // osobne wierzchołki
-        vertices.push_back({ base[i],    normal, {0.0f, 0.0f} });
-        vertices.push_back({ apex,       normal, {0.5f, 1.0f} });
-        vertices.push_back({ base[next], normal, {1.0f, 0.0f} });
-
-
-        indices.push_back(start + 0); // base[i]
-        indices.push_back(start + 1); // apex
-        indices.push_back(start + 2); // base[next]
+    m_sphereLods.clear();
+    m_sphereLodErrors.assign(1, 0.0f);
+
+    std::vector<LodLevel> levels = LodChain::build(m_meshData[static_cast<int>(PrimitiveType::SPHERE)]);
+    m_sphereLods.resize(levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        setupMesh(m_sphereLods[i], levels[i].data.vertices, levels[i].data.indices);
+        m_sphereLodErrors.push_back(levels[i].error);
     }
+}
 
-    setupMesh(m_pyramidMesh, vertices, indices);
+/**
+ * @brief Dzieli pełną siatkę sfery na meshlety
+ *
+ * @details Podział przestawia trójkąty w buforze indeksów; nowa kolejność
+ * trafia do EBO sfery i do kopii CPU (ten sam zbiór trójkątów, więc
+ * statyczne paczki i LOD pozostają poprawne).
+ */
+void GeometryRenderer::createSphereMeshlets() {
+    MeshData& data = m_meshData[static_cast<int>(PrimitiveType::SPHERE)];
+    m_sphereMeshlets = MeshletBuilder::build(data);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_sphereMesh.EBO);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, data.indices.size() * sizeof(unsigned int), data.indices.data());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 /**
@@ -559,8 +468,9 @@ void GeometryRenderer::drawCube(const glm::vec3& position, const glm::vec3& scal
  * @brief Rysuje sferę
  * @param position Pozycja środka sfery
  * @param radius Promień sfery
+ * @param lod Poziom szczegółowości (0 = siatka pełna, poza zakresem też)
  */
-void GeometryRenderer::drawSphere(const glm::vec3& position, float radius) {
+void GeometryRenderer::drawSphere(const glm::vec3& position, float radius, int lod) {
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, position);
     model = glm::scale(model, glm::vec3(radius));
@@ -568,8 +478,19 @@ void GeometryRenderer::drawSphere(const glm::vec3& position, float radius) {
     // Ustaw macierz modelu w shaderze
     // glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
 
+    const Mesh& mesh = lod > 0 && lod <= static_cast<int>(m_sphereLods.size()) ? m_sphereLods[lod - 1] : m_sphereMesh;
+    glBindVertexArray(mesh.VAO);
+    glDrawElements(m_drawMode, mesh.indexCount, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Rysuje pełną sferę z odrzucaniem meshletów (MeshletCuller)
+ * @param model Macierz modelu sfery jednostkowej
+ */
+void GeometryRenderer::drawSphereMeshlets(const glm::mat4& model) {
     glBindVertexArray(m_sphereMesh.VAO);
-    glDrawElements(m_drawMode, m_sphereMesh.indexCount, GL_UNSIGNED_INT, 0);
+    MeshletCuller::instance().draw(m_sphereMeshlets, model, m_drawMode);
     glBindVertexArray(0);
 }
 
@@ -976,7 +897,11 @@ void GeometryRenderer::drawHarnas(const glm::vec3& position, float height, float
  * @param specular Składowa odbicia
  * @param shininess Współczynnik połysku
  *
- * @note Wymaga implementacji uniformów w shaderze
+ * @details Renderer trzyma jedno odwołanie w MaterialTable. Identyczne
+ * materiały współdzielą wpis, więc identyfikator może się zmienić i
+ * wywołujący odczytuje getMaterialId() po każdym setMaterial(). Zapis do
+ * bufora jest uporządkowany względem wcześniejszych wywołań rysowania, więc
+ * kolejne setMaterial() pomiędzy rysowaniem działają poprawnie.
  */
 void GeometryRenderer::setMaterial(const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular, float shininess) {
     m_currentMaterial.ambient = ambient;
@@ -984,11 +909,15 @@ void GeometryRenderer::setMaterial(const glm::vec3& ambient, const glm::vec3& di
     m_currentMaterial.specular = specular;
     m_currentMaterial.shininess = shininess;
 
-    // Ustaw materiały w shaderze
-    // glUniform3fv(ambientLoc, 1, glm::value_ptr(ambient));
-    // glUniform3fv(diffuseLoc, 1, glm::value_ptr(diffuse));
-    // glUniform3fv(specularLoc, 1, glm::value_ptr(specular));
-    // glUniform1f(shininessLoc, shininess);
+    m_materialId = MaterialTable::instance().updateMaterial(m_materialId, m_currentMaterial);
+}
+
+/**
+ * @brief Zwraca wpis materiału renderera
+ * @return Identyfikator w MaterialTable (materiał neutralny przed pierwszym setMaterial())
+ */
+int GeometryRenderer::getMaterialId() const {
+    return m_materialId == INVALID_MATERIAL ? MaterialTable::DEFAULT_MATERIAL : m_materialId;
 }
 
 /**
@@ -998,8 +927,8 @@ void GeometryRenderer::setMaterial(const glm::vec3& ambient, const glm::vec3& di
  * @details Ambient = 20% koloru, Diffuse = 100% koloru, Specular = 50% koloru
  */
 void GeometryRenderer::setColor(const glm::vec3& color) {
-    // Dla prostoty ustawiamy ten sam kolor dla wszystkich składników
-    setMaterial(color * 0.2f, color, color * 0.5f, 32.0f);
+    Material material = MaterialTable::fromColor(color);
+    setMaterial(material.ambient, material.diffuse, material.specular, material.shininess);
 }
 
 /**
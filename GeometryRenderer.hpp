@@ -4,6 +4,7 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include <GL/glew.h>
+#include "Mesh/Meshlet.hpp"
 
 /**
  * @struct Vertex
@@ -43,6 +44,33 @@ struct Mesh {
     int indexCount;        /**< Liczba indeksów w siatce */
 };
 
+/**
+ * @struct MeshData
+ * @brief Kopia danych siatki w pamięci CPU
+ *
+ * Przechowywana obok buforów GPU, aby siatkę można było przekształcić
+ * i scalić z innymi (np. w statycznych paczkach).
+ */
+struct MeshData {
+    std::vector<Vertex> vertices;       /**< Wierzchołki */
+    std::vector<unsigned int> indices;  /**< Indeksy trójkątów */
+};
+
+/**
+ * @enum PrimitiveType
+ * @brief Podstawowe kształty buforowane przez GeometryRenderer
+ */
+enum class PrimitiveType {
+    CUBE,       /**< Sześcian jednostkowy */
+    SPHERE,     /**< Sfera o promieniu 1 */
+    CYLINDER,   /**< Cylinder o promieniu 1 i wysokości 1 */
+    CONE,       /**< Stożek */
+    PLANE,      /**< Płaszczyzna 1x1 w XZ */
+    TORUS,      /**< Torus */
+    PYRAMID,    /**< Piramida */
+    COUNT       /**< Liczba kształtów */
+};
+
 /**
  * @class GeometryRenderer
  * @brief Klasa renderująca geometryczne kształty 3D
@@ -55,6 +83,7 @@ class GeometryRenderer {
 private:
     GLenum m_drawMode;             /**< Aktualny tryb rysowania OpenGL (GL_TRIANGLES, GL_LINES itp.) */
     Material m_currentMaterial;    /**< Aktualne właściwości materiału */
+    int m_materialId;              /**< Wpis w MaterialTable dla rysowania bez danych obiektu (-1 = brak) */
 
     // Buforowane kształty geometryczne
     Mesh m_cubeMesh;               /**< Siatka sześcianu */
@@ -65,6 +94,10 @@ private:
     Mesh m_torusMesh;              /**< Siatka torusa */
     Mesh m_pyramidMesh;            /**< Siatka piramidy */
     Mesh m_gridMesh;               /**< Siatka siatki pomocniczej */
+    MeshData m_meshData[static_cast<int>(PrimitiveType::COUNT)]; /**< Kopie CPU podstawowych kształtów */
+    std::vector<Mesh> m_sphereLods;        /**< Uproszczone poziomy sfery (poziomy 1..n) */
+    std::vector<float> m_sphereLodErrors;  /**< Błędy poziomów sfery (indeks 0 = siatka pełna) */
+    std::vector<Meshlet> m_sphereMeshlets; /**< Meshlety pełnej siatki sfery */
 
     unsigned int m_lineVAO;        /**< VAO dla linii */
     unsigned int m_lineVBO;        /**< VBO dla linii */
@@ -72,18 +105,26 @@ private:
     unsigned int m_pointVBO;       /**< VBO dla punktów */
 
     /**
-     * @brief Konfiguruje siatkę 3D z podanych wierzchołków i indeksów
+     * @brief Konfiguruje siatkę 3D z tablic wierzchołków i indeksów
      * @param mesh Referencja do struktury Mesh
-     * @param vertices Wektor wierzchołków
-     * @param indices Wektor indeksów
+     * @param vertices Wierzchołki (układ Vertex)
+     * @param vertexCount Liczba wierzchołków
+     * @param indices Indeksy
+     * @param indexCount Liczba indeksów
      */
-    void setupMesh(Mesh& mesh, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    void setupMesh(Mesh& mesh, const void* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount);
 
     /**
-     * @brief Usuwa zasoby siatki 3D
-     * @param mesh Referencja do struktury Mesh
+     * @brief Tworzy kształt z danych wygenerowanych w czasie kompilacji
+     * @param type Rodzaj kształtu (wpis w m_meshData)
+     * @param mesh Siatka do utworzenia
+     * @param vertices Wierzchołki (układ Vertex)
+     * @param vertexCount Liczba wierzchołków
+     * @param indices Indeksy
+     * @param indexCount Liczba indeksów
      */
-    void deleteMesh(Mesh& mesh);
+    void setupStaticMesh(PrimitiveType type, Mesh& mesh, const void* vertices, size_t vertexCount,
+                         const unsigned int* indices, size_t indexCount);
 
     /**
      * @brief Tworzy siatkę sześcianu jednostkowego
@@ -134,6 +175,16 @@ private:
      */
     void createGrid(int size = 10);
 
+    /**
+     * @brief Buduje uproszczone poziomy szczegółowości sfery
+     */
+    void createSphereLods();
+
+    /**
+     * @brief Dzieli pełną siatkę sfery na meshlety
+     */
+    void createSphereMeshlets();
+
 public:
     /**
      * @brief Konstruktor GeometryRenderer
@@ -167,8 +218,15 @@ public:
      * @brief Rysuje sferę
      * @param position Pozycja środka sfery
      * @param radius Promień sfery
+     * @param lod Poziom szczegółowości (0 = siatka pełna)
+     */
+    void drawSphere(const glm::vec3& position, float radius, int lod = 0);
+
+    /**
+     * @brief Rysuje pełną sferę z odrzucaniem meshletów (MeshletCuller)
+     * @param model Macierz modelu sfery jednostkowej
      */
-    void drawSphere(const glm::vec3& position, float radius);
+    void drawSphereMeshlets(const glm::mat4& model);
 
     /**
      * @brief Rysuje cylinder
@@ -312,9 +370,18 @@ public:
      * @param diffuse Składowa rozproszenia
      * @param specular Składowa odbicia
      * @param shininess Współczynnik połysku
+     *
+     * Materiał trafia do MaterialTable; wywołujący wybiera go uniformem
+     * "materialIndex" równym getMaterialId() odczytanym po tym wywołaniu.
      */
     void setMaterial(const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular, float shininess);
 
+    /**
+     * @brief Zwraca wpis materiału renderera
+     * @return Identyfikator w MaterialTable (materiał neutralny przed pierwszym setMaterial())
+     */
+    int getMaterialId() const;
+
     /**
      * @brief Ustawia kolor dla wszystkich składowych materiału
      * @param color Kolor bazowy
@@ -345,11 +412,38 @@ public:
      */
     void setProjectionMatrix(const glm::mat4& projection);
 
+    /**
+     * @brief Konfiguruje siatkę 3D z podanych wierzchołków i indeksów
+     * @param mesh Referencja do struktury Mesh
+     * @param vertices Wektor wierzchołków
+     * @param indices Wektor indeksów
+     */
+    void setupMesh(Mesh& mesh, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+    /**
+     * @brief Usuwa zasoby siatki 3D
+     * @param mesh Referencja do struktury Mesh
+     */
+    void deleteMesh(Mesh& mesh);
+
     /**
      * @brief Rysuje dowolną siatkę Mesh
      * @param mesh Referencja do siatki Mesh
      */
     void drawMesh(const Mesh& mesh);
+
+    /**
+     * @brief Zwraca kopię CPU podstawowego kształtu
+     * @param type Rodzaj kształtu
+     * @return Wierzchołki i indeksy w przestrzeni lokalnej
+     */
+    const MeshData& getMeshData(PrimitiveType type) const { return m_meshData[static_cast<int>(type)]; }
+
+    /**
+     * @brief Zwraca błędy poziomów szczegółowości sfery jednostkowej
+     * @return Błędy w przestrzeni lokalnej (indeks 0 = siatka pełna)
+     */
+    const std::vector<float>& getSphereLodErrors() const { return m_sphereLodErrors; }
 };
 
 #endif // GEOMETRY_RENDERER_HPP
\ No newline at end of file
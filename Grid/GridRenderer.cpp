@@ -0,0 +1,215 @@
+// GridRenderer.cpp
+#include "GridRenderer.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <iostream>
+
+/**
+ * @brief Vertex shader siatki: trójkąt pokrywający ekran z promieniami kamery
+ *
+ * Punkty płaszczyzn bliskiej i dalekiej odpowiadające narożnikowi zależą
+ * liniowo od położenia na ekranie, więc można je interpolować.
+ */
+static const char* gridVertexSource = R"(
+#version 330 core
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+out vec3 NearPoint;
+out vec3 FarPoint;
+
+vec3 unproject(mat4 inverseViewProjection, vec2 ndc, float depth) {
+    vec4 position = inverseViewProjection * vec4(ndc, depth, 1.0);
+    return position.xyz / position.w;
+}
+
+void main()
+{
+    vec2 corner = vec2(float((gl_VertexID & 1) << 2), float((gl_VertexID & 2) << 1)) - 1.0;
+    mat4 inverseViewProjection = inverse(projection * view);
+    NearPoint = unproject(inverseViewProjection, corner, -1.0);
+    FarPoint = unproject(inverseViewProjection, corner, 1.0);
+    gl_Position = vec4(corner, 0.0, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader siatki: linie z odległości w pikselach
+ *
+ * Pochodne liczone są przed odrzuceniem fragmentu, bo po discard w
+ * niejednolitym przepływie sterowania są nieokreślone.
+ */
+static const char* gridFragmentSource = R"(
+#version 330 core
+in vec3 NearPoint;
+in vec3 FarPoint;
+
+out vec4 FragColor;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+uniform float gridHeight;
+uniform vec2 gridSpacing;       // x = linie drobne, y = linie główne
+uniform vec2 lineWidth;         // x = linie drobne, y = linie główne i osie [px]
+uniform float fadeDistance;
+uniform vec4 minorColor;
+uniform vec4 majorColor;
+uniform vec4 xAxisColor;
+uniform vec4 zAxisColor;
+
+// Pokrycie piksela przez linię o grubości width [px] odległą o pixels [px]
+float lineCoverage(float pixels, float width) {
+    return clamp(width * 0.5 + 0.5 - pixels, 0.0, 1.0);
+}
+
+// Pokrycie przez linie co spacing; linie gęstsze niż kilka pikseli są wygaszane
+float gridCoverage(vec2 position, float spacing, float width) {
+    vec2 cell = position / spacing;
+    vec2 cellsPerPixel = max(fwidth(cell), vec2(1e-6));
+    vec2 pixels = abs(fract(cell - 0.5) - 0.5) / cellsPerPixel;
+    vec2 coverage = vec2(lineCoverage(pixels.x, width), lineCoverage(pixels.y, width));
+    coverage *= 1.0 - smoothstep(0.1, 0.3, cellsPerPixel);
+    return max(coverage.x, coverage.y);
+}
+
+void main()
+{
+    vec3 ray = FarPoint - NearPoint;
+    float t = (gridHeight - NearPoint.y) / (abs(ray.y) > 1e-6 ? ray.y : 1e-6);
+    vec3 position = NearPoint + ray * t;
+
+    float minor = gridCoverage(position.xz, gridSpacing.x, lineWidth.x);
+    float major = gridCoverage(position.xz, gridSpacing.y, lineWidth.y);
+    vec2 axisDistance = abs(position.zx) / max(fwidth(position.zx), vec2(1e-6));
+    if (t <= 0.0 || t > 1.0) discard;
+
+    vec4 color = vec4(minorColor.rgb, minorColor.a * minor);
+    color = mix(color, majorColor, major);
+    color = mix(color, xAxisColor, lineCoverage(axisDistance.x, lineWidth.y));
+    color = mix(color, zAxisColor, lineCoverage(axisDistance.y, lineWidth.y));
+    color.a *= 1.0 - smoothstep(fadeDistance * 0.5, fadeDistance, distance(position, cameraPosition.xyz));
+    if (color.a <= 0.002) discard;
+
+    vec4 clipPosition = projection * view * vec4(position, 1.0);
+    gl_FragDepth = clipPosition.z / clipPosition.w * 0.5 + 0.5;
+    FragColor = color;
+}
+)";
+
+/**
+ * @brief Konstruktor GridRenderer
+ */
+GridRenderer::GridRenderer()
+    : m_program(0), m_emptyVAO(0), m_heightLoc(-1), m_spacingLoc(-1), m_lineWidthLoc(-1), m_fadeDistanceLoc(-1),
+      m_minorColorLoc(-1), m_majorColorLoc(-1), m_xAxisColorLoc(-1), m_zAxisColorLoc(-1), m_enabled(true),
+      m_initialized(false) {}
+
+/**
+ * @brief Destruktor GridRenderer
+ */
+GridRenderer::~GridRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery
+ * @return true jeśli inicjalizacja się powiodła
+ */
+bool GridRenderer::initialize() {
+    if (m_initialized) return true;
+
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, gridVertexSource, "siatki");
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, gridFragmentSource, "siatki");
+    m_program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "siatki");
+    if (!m_program) return false;
+
+    MultiViewRenderer::setupProgram(m_program);
+    m_heightLoc = glGetUniformLocation(m_program, "gridHeight");
+    m_spacingLoc = glGetUniformLocation(m_program, "gridSpacing");
+    m_lineWidthLoc = glGetUniformLocation(m_program, "lineWidth");
+    m_fadeDistanceLoc = glGetUniformLocation(m_program, "fadeDistance");
+    m_minorColorLoc = glGetUniformLocation(m_program, "minorColor");
+    m_majorColorLoc = glGetUniformLocation(m_program, "majorColor");
+    m_xAxisColorLoc = glGetUniformLocation(m_program, "xAxisColor");
+    m_zAxisColorLoc = glGetUniformLocation(m_program, "zAxisColor");
+
+    glGenVertexArrays(1, &m_emptyVAO);
+    if (!m_emptyVAO) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow siatki" << std::endl;
+        release();
+        return false;
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zwalnia obiekty OpenGL
+ */
+void GridRenderer::release() {
+    if (m_program) glDeleteProgram(m_program);
+    if (m_emptyVAO) glDeleteVertexArrays(1, &m_emptyVAO);
+    m_program = 0;
+    m_emptyVAO = 0;
+    m_initialized = false;
+}
+
+/**
+ * @brief Rysuje siatkę w aktywnym widoku
+ * @return Liczba wywołań rysowania
+ *
+ * @details Siatka mieszana jest alfą bez zapisu głębokości (test
+ * głębokości działa z gl_FragDepth), więc należy ją rysować po obiektach
+ * nieprzezroczystych. Poprzedni program, mieszanie i maska głębokości są
+ * przywracane.
+ */
+int GridRenderer::draw() {
+    if (!m_initialized || !m_enabled) return 0;
+
+    GLint previousProgram = 0;
+    GLint blendSrcRgb = GL_ONE, blendDstRgb = GL_ZERO, blendSrcAlpha = GL_ONE, blendDstAlpha = GL_ZERO;
+    GLboolean depthMask = GL_TRUE;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &blendSrcRgb);
+    glGetIntegerv(GL_BLEND_DST_RGB, &blendDstRgb);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcAlpha);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstAlpha);
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+
+    const GridSettings& s = m_settings;
+    glUseProgram(m_program);
+    glUniform1f(m_heightLoc, s.height);
+    glUniform2f(m_spacingLoc, s.spacing, s.spacing * static_cast<float>(s.majorEvery > 0 ? s.majorEvery : 1));
+    glUniform2f(m_lineWidthLoc, s.lineWidth, s.majorLineWidth);
+    glUniform1f(m_fadeDistanceLoc, s.fadeDistance);
+    glUniform4f(m_minorColorLoc, s.minorColor.r, s.minorColor.g, s.minorColor.b, s.minorColor.a);
+    glUniform4f(m_majorColorLoc, s.majorColor.r, s.majorColor.g, s.majorColor.b, s.majorColor.a);
+    glUniform4f(m_xAxisColorLoc, s.xAxisColor.r, s.xAxisColor.g, s.xAxisColor.b, s.xAxisColor.a);
+    glUniform4f(m_zAxisColorLoc, s.zAxisColor.r, s.zAxisColor.g, s.zAxisColor.b, s.zAxisColor.a);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+    glBindVertexArray(m_emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+
+    glDepthMask(depthMask);
+    glBlendFuncSeparate(blendSrcRgb, blendDstRgb, blendSrcAlpha, blendDstAlpha);
+    if (!blend) glDisable(GL_BLEND);
+    glUseProgram(previousProgram);
+
+    RenderStats::instance().addValue("Siatka/Wywolania rysowania", 1.0);
+    return 1;
+}
@@ -0,0 +1,110 @@
+// GridRenderer.hpp
+#ifndef GRID_RENDERER_HPP
+#define GRID_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/**
+ * @struct GridSettings
+ * @brief Wygląd nieskończonej siatki pomocniczej
+ */
+struct GridSettings {
+    float height = 0.0f;                                /**< Wysokość płaszczyzny siatki */
+    float spacing = 1.0f;                               /**< Odstęp linii drobnych */
+    int majorEvery = 10;                                /**< Co która linia jest główna */
+    float lineWidth = 1.0f;                             /**< Grubość linii drobnych [px] */
+    float majorLineWidth = 1.5f;                        /**< Grubość linii głównych i osi [px] */
+    float fadeDistance = 60.0f;                         /**< Odległość, w której siatka całkiem zanika */
+    glm::vec4 minorColor = glm::vec4(0.5f, 0.5f, 0.5f, 0.5f);  /**< Kolor linii drobnych */
+    glm::vec4 majorColor = glm::vec4(0.7f, 0.7f, 0.7f, 0.8f);  /**< Kolor linii głównych */
+    glm::vec4 xAxisColor = glm::vec4(0.9f, 0.2f, 0.2f, 1.0f);  /**< Kolor osi X (linia z = 0) */
+    glm::vec4 zAxisColor = glm::vec4(0.2f, 0.3f, 0.9f, 1.0f);  /**< Kolor osi Z (linia x = 0) */
+};
+
+/**
+ * @class GridRenderer
+ * @brief Nieskończona siatka pomocnicza liczona analitycznie w jednym przejściu
+ *
+ * Zamiast siatki linii (GeometryRenderer::drawGrid, draw3DGrid) rysowany
+ * jest jeden trójkąt pokrywający ekran. Vertex shader odtwarza z bloku
+ * Camera promień kamery przez każdy narożnik, a fragment shader przecina
+ * go z płaszczyzną y = height, zapisuje głębokość trafionego punktu
+ * i liczy odległość do najbliższej linii w pikselach z pochodnych
+ * ekranowych (fwidth), co daje wygładzone linie o stałej grubości.
+ * Linie, których odstęp na ekranie spada do kilku pikseli, wygaszane są
+ * płynnie (bez migotania), a cała siatka zanika z odległością.
+ *
+ * Koszt to jeden glDrawArrays i praca na piksel ekranu, niezależnie od
+ * zasięgu i gęstości siatki.
+ */
+class GridRenderer {
+private:
+    GridSettings m_settings;    /**< Wygląd siatki */
+    GLuint m_program;           /**< Program siatki */
+    GLuint m_emptyVAO;          /**< Pusty VAO (wierzchołki z gl_VertexID) */
+    GLint m_heightLoc;          /**< Lokalizacja uniformu wysokości płaszczyzny */
+    GLint m_spacingLoc;         /**< Lokalizacja uniformu odstępów linii drobnych i głównych */
+    GLint m_lineWidthLoc;       /**< Lokalizacja uniformu grubości linii */
+    GLint m_fadeDistanceLoc;    /**< Lokalizacja uniformu odległości zaniku */
+    GLint m_minorColorLoc;      /**< Lokalizacja uniformu koloru linii drobnych */
+    GLint m_majorColorLoc;      /**< Lokalizacja uniformu koloru linii głównych */
+    GLint m_xAxisColorLoc;      /**< Lokalizacja uniformu koloru osi X */
+    GLint m_zAxisColorLoc;      /**< Lokalizacja uniformu koloru osi Z */
+    bool m_enabled;             /**< Czy siatka jest rysowana */
+    bool m_initialized;         /**< Czy obiekty OpenGL zostały utworzone */
+
+public:
+    /**
+     * @brief Konstruktor GridRenderer
+     */
+    GridRenderer();
+
+    /**
+     * @brief Destruktor GridRenderer
+     */
+    ~GridRenderer();
+
+    /**
+     * @brief Kompiluje shadery
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia obiekty OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Ustawia wygląd siatki
+     * @param settings Parametry
+     */
+    void setSettings(const GridSettings& settings) { m_settings = settings; }
+
+    /**
+     * @brief Zwraca wygląd siatki
+     * @return Parametry
+     */
+    const GridSettings& getSettings() const { return m_settings; }
+
+    /**
+     * @brief Włącza lub wyłącza rysowanie siatki
+     * @param enabled Czy rysować
+     */
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+
+    /**
+     * @brief Sprawdza, czy siatka jest rysowana
+     * @return true jeśli siatka jest włączona
+     */
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Rysuje siatkę w aktywnym widoku
+     * @return Liczba wywołań rysowania
+     */
+    int draw();
+};
+
+#endif // GRID_RENDERER_HPP
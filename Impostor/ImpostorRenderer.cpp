@@ -0,0 +1,780 @@
+// ImpostorRenderer.cpp
+#include "ImpostorRenderer.hpp"
+#include "../Transform/TransformableObject.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+/**
+ * @brief Vertex shader impostorów
+ *
+ * Kwadrat zwrócony do kamery powstaje z gl_VertexID (pasek 4 wierzchołków).
+ * Dla każdego z trzech najbliższych ujęć wierzchołek rzutowany jest wzdłuż
+ * promienia widzenia na płaszczyznę ujęcia; rzut jest afiniczny, więc
+ * współrzędne atlasu można interpolować liniowo.
+ */
+static const char* impostorVertexSource = R"(
+#version 330 core
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+// Dane instancji w układzie danych obiektów MultiViewRenderer (w = udział impostora)
+uniform samplerBuffer objectData;
+uniform int objectIndex;
+uniform vec4 boundsSphere; // sfera otaczająca siatki: xyz = środek, w = promień
+uniform int gridSize;
+
+out vec2 FrameUV[3];
+flat out vec2 FrameCell[3];
+flat out vec3 FrameWeights;
+out vec3 QuadPos;
+flat out vec3 ViewForward;
+flat out float Radius;
+flat out mat3 NormalMatrix;
+flat out ivec2 LightList;
+flat out int MaterialIndex;
+flat out float Fade;
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Kierunek -> punkt kwadratu [-1, 1]^2 (oktaedr, biegun +Y w środku)
+vec2 octahedralEncode(vec3 direction) {
+    vec3 d = direction / (abs(direction.x) + abs(direction.y) + abs(direction.z));
+    vec2 e = d.xz;
+    if (d.y < 0.0) e = (1.0 - abs(e.yx)) * signNotZero(e);
+    return e;
+}
+
+vec3 octahedralDecode(vec2 e) {
+    vec3 d = vec3(e.x, 1.0 - abs(e.x) - abs(e.y), e.y);
+    if (d.y < 0.0) d.xz = (1.0 - abs(d.zx)) * signNotZero(d.xz);
+    return normalize(d);
+}
+
+// Osie ekranu kamery patrzącej z kierunku direction (jak glm::lookAt)
+void frameBasis(vec3 direction, out vec3 right, out vec3 up) {
+    vec3 reference = abs(direction.y) < 0.999 ? vec3(0.0, 1.0, 0.0) : vec3(0.0, 0.0, -1.0);
+    right = normalize(cross(reference, direction));
+    up = cross(direction, right);
+}
+
+void main()
+{
+    int base = (objectIndex + gl_InstanceID) * 5;
+    mat4 model = mat4(texelFetch(objectData, base),
+                      texelFetch(objectData, base + 1),
+                      texelFetch(objectData, base + 2),
+                      texelFetch(objectData, base + 3));
+    vec4 lightsAndMaterial = texelFetch(objectData, base + 4);
+    LightList = ivec2(lightsAndMaterial.xy);
+    MaterialIndex = int(lightsAndMaterial.z);
+    Fade = lightsAndMaterial.w;
+
+    mat3 linear = mat3(model);
+    mat3 inverseLinear = inverse(linear);
+    NormalMatrix = transpose(inverseLinear);
+    vec3 center = vec3(model * vec4(boundsSphere.xyz, 1.0));
+    Radius = boundsSphere.w * max(length(linear[0]), max(length(linear[1]), length(linear[2])));
+
+    // Kwadrat zwrócony do kamery, pokrywający sferę otaczającą
+    vec3 forward = normalize(cameraPosition.xyz - center);
+    vec3 right, up;
+    frameBasis(forward, right, up);
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+    QuadPos = center + (right * corner.x + up * corner.y) * Radius;
+    ViewForward = forward;
+
+    // Trzy najbliższe ujęcia: trójkąt siatki ujęć zawierający kierunek kamery
+    vec3 localView = normalize(inverseLinear * forward);
+    vec2 grid = (octahedralEncode(localView) * 0.5 + 0.5) * float(gridSize - 1);
+    vec2 cell = clamp(floor(grid), vec2(0.0), vec2(float(gridSize - 2)));
+    vec2 f = grid - cell;
+    vec2 cells[3];
+    if (f.x + f.y <= 1.0) {
+        cells = vec2[3](cell, cell + vec2(1.0, 0.0), cell + vec2(0.0, 1.0));
+        FrameWeights = vec3(1.0 - f.x - f.y, f.x, f.y);
+    } else {
+        cells = vec2[3](cell + vec2(1.0), cell + vec2(1.0, 0.0), cell + vec2(0.0, 1.0));
+        FrameWeights = vec3(f.x + f.y - 1.0, 1.0 - f.y, 1.0 - f.x);
+    }
+
+    // Wierzchołek w przestrzeni siatki (w promieniach sfery otaczającej)
+    vec3 local = (inverseLinear * (QuadPos - model[3].xyz) - boundsSphere.xyz) / boundsSphere.w;
+    for (int i = 0; i < 3; ++i) {
+        vec3 frameDirection = octahedralDecode(cells[i] / float(gridSize - 1) * 2.0 - 1.0);
+        vec3 frameRight, frameUp;
+        frameBasis(frameDirection, frameRight, frameUp);
+        vec3 projected = local - localView * (dot(local, frameDirection) / max(dot(localView, frameDirection), 0.1));
+        FrameUV[i] = vec2(dot(projected, frameRight), dot(projected, frameUp)) * 0.5 + 0.5;
+        FrameCell[i] = cells[i];
+    }
+
+    gl_Position = projection * view * vec4(QuadPos, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader impostorów
+ *
+ * Oświetlenie liczone jest tak jak w shaderze sceny (ta sama tabela
+ * materiałów i lista świateł), z normalną i położeniem odtworzonymi z atlasu.
+ * Poprzedza go kod z LightCuller::getShaderSource().
+ */
+static const char* impostorFragmentSource = R"(
+out vec4 FragColor;
+
+in vec2 FrameUV[3];
+flat in vec2 FrameCell[3];
+flat in vec3 FrameWeights;
+in vec3 QuadPos;
+flat in vec3 ViewForward;
+flat in float Radius;
+flat in mat3 NormalMatrix;
+flat in ivec2 LightList;
+flat in int MaterialIndex;
+flat in float Fade;
+
+uniform sampler2D atlasColor;
+uniform sampler2D atlasNormalDepth;
+uniform int gridSize;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+// Próg z macierzy Bayera 4x4 (ten sam wzór w shaderze sceny)
+float ditherThreshold() {
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,
+                                      3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+    return (bayer[pixel.y * 4 + pixel.x] + 0.5) / 16.0;
+}
+
+void main()
+{
+    // Przenikanie z siatką: impostor zajmuje piksele o progu poniżej Fade
+    if (Fade < 1.0 && ditherThreshold() >= Fade) discard;
+
+    // Atlas ma wartości przemnożone przez pokrycie (tło wyczyszczone zerami)
+    float weights[3] = float[3](FrameWeights.x, FrameWeights.y, FrameWeights.z);
+    vec4 color = vec4(0.0);
+    vec4 normalDepth = vec4(0.0);
+    for (int i = 0; i < 3; ++i) {
+        if (weights[i] <= 0.0) continue;
+        vec2 uv = (FrameCell[i] + clamp(FrameUV[i], 0.0, 1.0)) / float(gridSize);
+        color += texture(atlasColor, uv) * weights[i];
+        normalDepth += texture(atlasNormalDepth, uv) * weights[i];
+    }
+    if (color.a < 0.5) discard;
+    color.rgb /= color.a;
+    normalDepth /= color.a;
+
+    // Punkt powierzchni przesunięty od kwadratu w stronę kamery o głębokość z atlasu
+    vec3 fragPos = QuadPos + ViewForward * (normalDepth.w * Radius);
+    vec4 clipPos = projection * view * vec4(fragPos, 1.0);
+    gl_FragDepth = clipPos.z / clipPos.w * 0.5 + 0.5;
+
+    vec3 normal = normalize(NormalMatrix * (normalDepth.xyz * 2.0 - 1.0));
+    vec3 viewDir = normalize(cameraPosition.xyz - fragPos);
+    PackedMaterial material = materialData[MaterialIndex];
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < LightList.y; i++) {
+        int lightIndex = texelFetch(lightIndices, LightList.x + i).r;
+        result += calculatePhongLight(lightData[lightIndex], material, normal, fragPos, viewDir);
+    }
+
+    FragColor = vec4(result * color.rgb, 1.0);
+}
+)";
+
+/**
+ * @brief Vertex shader renderowania ujęć
+ */
+static const char* bakeVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+
+uniform mat4 viewProjection;
+
+out vec3 LocalPos;
+out vec3 Normal;
+
+void main()
+{
+    LocalPos = aPos;
+    Normal = aNormal;
+    gl_Position = viewProjection * vec4(aPos, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader renderowania ujęć
+ *
+ * Głębokość to odległość punktu od płaszczyzny przez środek sfery
+ * otaczającej, mierzona w stronę kamery ujęcia w promieniach sfery.
+ */
+static const char* bakeFragmentSource = R"(
+layout (location = 0) out vec4 Color;
+layout (location = 1) out vec4 NormalDepth;
+
+in vec3 LocalPos;
+in vec3 Normal;
+
+uniform vec4 boundsSphere;
+uniform vec3 frameDirection;
+
+void main()
+{
+    // Barwę nadaje materiał instancji, atlas przechowuje pokrycie
+    Color = vec4(1.0);
+    NormalDepth = vec4(normalize(Normal) * 0.5 + 0.5,
+                       dot(LocalPos - boundsSphere.xyz, frameDirection) / boundsSphere.w);
+}
+)";
+
+/**
+ * @brief Kompiluje i linkuje program shaderowy
+ * @param vertexSource Kod vertex shadera
+ * @param fragmentSource Kod fragment shadera (bez wiersza #version)
+ * @param lit Czy przed kodem fragment shadera wstawić LightCuller::getShaderSource()
+ * @return ID programu lub 0 w przypadku błędu
+ */
+static GLuint linkImpostorProgram(const char* vertexSource, const char* fragmentSource, bool lit) {
+    const char* fragmentSources[] = {"#version 330 core\n", lit ? LightCuller::getShaderSource() : "", fragmentSource};
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, vertexSource, "impostorow");
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSources, 3, "impostorow");
+    return ShaderUtils::linkProgram(vertexShader, fragmentShader, "impostorow");
+}
+
+/**
+ * @brief Liczy skrót zawartości siatki (FNV-1a)
+ * @param mesh Dane siatki
+ * @return Skrót wierzchołków i indeksów
+ */
+static uint64_t hashMeshData(const MeshData& mesh) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    mix(mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+    mix(mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+    return hash;
+}
+
+/**
+ * @brief Konstruktor ImpostorRenderer
+ */
+ImpostorRenderer::ImpostorRenderer()
+    : m_program(0), m_bakeProgram(0), m_emptyVAO(0), m_instanceBuffer(0), m_instanceTexture(0),
+      m_instanceCapacity(0), m_objectIndexLoc(-1), m_boundsLoc(-1), m_bakeViewProjectionLoc(-1),
+      m_bakeBoundsLoc(-1), m_bakeDirectionLoc(-1), m_initialized(false), m_enabled(true),
+      m_startDistance(30.0f), m_fadeDistance(6.0f), m_fadingCount(0), m_bakeMs(0.0) {
+}
+
+/**
+ * @brief Destruktor ImpostorRenderer
+ */
+ImpostorRenderer::~ImpostorRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery i tworzy bufory
+ * @return true jeśli inicjalizacja się powiodła
+ *
+ * @details Program impostorów korzysta z tych samych bloków Camera, Lights
+ * i Materials co shader sceny, więc wiązany jest z tymi samymi punktami.
+ */
+bool ImpostorRenderer::initialize() {
+    if (m_initialized) return true;
+
+    m_program = linkImpostorProgram(impostorVertexSource, impostorFragmentSource, true);
+    m_bakeProgram = linkImpostorProgram(bakeVertexSource, bakeFragmentSource, false);
+    glGenVertexArrays(1, &m_emptyVAO);
+    glGenBuffers(1, &m_instanceBuffer);
+    glGenTextures(1, &m_instanceTexture);
+
+    if (m_program == 0 || m_bakeProgram == 0 || m_emptyVAO == 0 ||
+        m_instanceBuffer == 0 || m_instanceTexture == 0) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow impostorow" << std::endl;
+        release();
+        return false;
+    }
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+
+    MultiViewRenderer::setupProgram(m_program);
+    LightCuller::setupProgram(m_program);
+    MaterialTable::setupProgram(m_program);
+    glUseProgram(m_program);
+    glUniform1i(glGetUniformLocation(m_program, "atlasColor"), ATLAS_COLOR_TEXTURE_UNIT);
+    glUniform1i(glGetUniformLocation(m_program, "atlasNormalDepth"), ATLAS_NORMAL_DEPTH_TEXTURE_UNIT);
+    glUniform1i(glGetUniformLocation(m_program, "gridSize"), GRID_SIZE);
+    m_objectIndexLoc = glGetUniformLocation(m_program, "objectIndex");
+    m_boundsLoc = glGetUniformLocation(m_program, "boundsSphere");
+
+    m_bakeViewProjectionLoc = glGetUniformLocation(m_bakeProgram, "viewProjection");
+    m_bakeBoundsLoc = glGetUniformLocation(m_bakeProgram, "boundsSphere");
+    m_bakeDirectionLoc = glGetUniformLocation(m_bakeProgram, "frameDirection");
+    glUseProgram(previousProgram);
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zwalnia programy, bufory i atlasy
+ */
+void ImpostorRenderer::release() {
+    if (m_program) glDeleteProgram(m_program);
+    if (m_bakeProgram) glDeleteProgram(m_bakeProgram);
+    if (m_emptyVAO) glDeleteVertexArrays(1, &m_emptyVAO);
+    if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+    if (m_instanceTexture) glDeleteTextures(1, &m_instanceTexture);
+    m_program = 0;
+    m_bakeProgram = 0;
+    m_emptyVAO = 0;
+    m_instanceBuffer = 0;
+    m_instanceTexture = 0;
+    m_instanceCapacity = 0;
+
+    for (Atlas& atlas : m_atlases) {
+        glDeleteTextures(1, &atlas.colorTexture);
+        glDeleteTextures(1, &atlas.normalDepthTexture);
+    }
+    m_atlases.clear();
+    m_meshAtlas.clear();
+    m_candidates.clear();
+    m_visible.clear();
+    m_groups.clear();
+    m_initialized = false;
+}
+
+/**
+ * @brief Ustawia odległości przejścia
+ * @param start Początek przejścia (w promieniach sfery otaczającej)
+ * @param fade Szerokość pasa przenikania (w promieniach)
+ */
+void ImpostorRenderer::setDistances(float start, float fade) {
+    m_startDistance = std::max(start, 0.0f);
+    m_fadeDistance = std::max(fade, 0.0f);
+}
+
+/**
+ * @brief Zamienia punkt siatki ujęć na kierunek
+ * @param grid Współrzędne ujęcia z przedziału [0, GRID_SIZE - 1]
+ * @return Znormalizowany kierunek
+ *
+ * @details Kwadrat [-1, 1]^2 odwzorowany jest na oktaedr |x| + |y| + |z| = 1:
+ * górna półsfera zajmuje romb w środku, dolna jest "rozłożona" w narożnikach.
+ */
+glm::vec3 ImpostorRenderer::gridToDirection(const glm::vec2& grid) {
+    glm::vec2 e = grid / static_cast<float>(GRID_SIZE - 1) * 2.0f - 1.0f;
+    glm::vec3 d(e.x, 1.0f - std::abs(e.x) - std::abs(e.y), e.y);
+    if (d.y < 0.0f) {
+        float x = (1.0f - std::abs(d.z)) * (d.x >= 0.0f ? 1.0f : -1.0f);
+        float z = (1.0f - std::abs(d.x)) * (d.z >= 0.0f ? 1.0f : -1.0f);
+        d.x = x;
+        d.z = z;
+    }
+    return glm::normalize(d);
+}
+
+/**
+ * @brief Zamienia kierunek na punkt siatki ujęć
+ * @param direction Kierunek od środka obiektu do kamery
+ * @return Współrzędne z przedziału [0, GRID_SIZE - 1]
+ */
+glm::vec2 ImpostorRenderer::directionToGrid(const glm::vec3& direction) {
+    glm::vec3 d = direction / (std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z));
+    glm::vec2 e(d.x, d.z);
+    if (d.y < 0.0f) {
+        e = glm::vec2((1.0f - std::abs(d.z)) * (d.x >= 0.0f ? 1.0f : -1.0f),
+                      (1.0f - std::abs(d.x)) * (d.z >= 0.0f ? 1.0f : -1.0f));
+    }
+    return (e * 0.5f + 0.5f) * static_cast<float>(GRID_SIZE - 1);
+}
+
+/**
+ * @brief Wyznacza osie ekranu ujęcia
+ * @param direction Kierunek od środka obiektu do kamery
+ * @param right Wynikowa oś pozioma
+ * @param up Wynikowa oś pionowa
+ *
+ * @details Osie są takie same jak w glm::lookAt z wektorem "do góry" +Y
+ * (przy biegunach -Z), więc ujęcie i shader rysujący zgadzają się co do
+ * orientacji.
+ */
+void ImpostorRenderer::frameBasis(const glm::vec3& direction, glm::vec3& right, glm::vec3& up) {
+    glm::vec3 reference = std::abs(direction.y) < 0.999f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, -1.0f);
+    right = glm::normalize(glm::cross(reference, direction));
+    up = glm::cross(direction, right);
+}
+
+/**
+ * @brief Renderuje ujęcia siatki do nowego atlasu
+ * @param mesh Dane siatki
+ * @param atlas Atlas do uzupełnienia
+ * @return true jeśli się powiodło
+ *
+ * @details Każde ujęcie to rzut ortogonalny sfery otaczającej na kwadrat
+ * FRAME_RESOLUTION x FRAME_RESOLUTION. Bufor ramki, obszar okna, program,
+ * tryb wielokątów i test głębokości są przywracane, bo atlas może powstawać
+ * w trakcie rysowania sceny.
+ */
+bool ImpostorRenderer::bakeAtlas(const MeshData& mesh, Atlas& atlas) {
+    BoundingBox box = BoundingBox::empty();
+    for (const Vertex& vertex : mesh.vertices) {
+        box.expand(vertex.position);
+    }
+    glm::vec3 center = box.getCenter();
+    float radius = 0.0f;
+    for (const Vertex& vertex : mesh.vertices) {
+        radius = std::max(radius, glm::length(vertex.position - center));
+    }
+    if (radius <= 0.0f) return false;
+    atlas.bounds = {center, radius};
+    atlas.triangleCount = mesh.indices.size() / 3;
+
+    GLint previousFramebuffer = 0;
+    GLint previousProgram = 0;
+    GLint viewport[4] = {0, 0, 0, 0};
+    GLint polygonMode[2] = {GL_FILL, GL_FILL};
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+
+    // Tymczasowe bufory siatki
+    GLuint vao = 0, vbo = 0, ebo = 0;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(Vertex), mesh.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(unsigned int), mesh.indices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+
+    // Tekstury atlasu (kilka poziomów mipmap - dalej niż o 8 tekseli ujęcia nie przenikają)
+    const int size = GRID_SIZE * FRAME_RESOLUTION;
+    GLuint textures[2] = {0, 0};
+    const GLint formats[2] = {GL_RGBA8, GL_RGBA16F};
+    glGenTextures(2, textures);
+    for (int i = 0; i < 2; ++i) {
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, formats[i], size, size, 0, GL_RGBA, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 3);
+    }
+    atlas.colorTexture = textures[0];
+    atlas.normalDepthTexture = textures[1];
+
+    GLuint depthBuffer = 0, framebuffer = 0;
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, atlas.colorTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, atlas.normalDepthTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    const GLenum drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (complete) {
+        const GLfloat zero[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        const GLfloat farDepth = 1.0f;
+        glViewport(0, 0, size, size);
+        glClearBufferfv(GL_COLOR, 0, zero);
+        glClearBufferfv(GL_COLOR, 1, zero);
+        glClearBufferfv(GL_DEPTH, 0, &farDepth);
+
+        glEnable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        glUseProgram(m_bakeProgram);
+        glUniform4f(m_bakeBoundsLoc, center.x, center.y, center.z, radius);
+
+        glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, 0.0f, radius * 4.0f);
+        for (int y = 0; y < GRID_SIZE; ++y) {
+            for (int x = 0; x < GRID_SIZE; ++x) {
+                glm::vec3 direction = gridToDirection(glm::vec2(static_cast<float>(x), static_cast<float>(y)));
+                glm::vec3 right, up;
+                frameBasis(direction, right, up);
+                glm::mat4 viewProjection = projection * glm::lookAt(center + direction * (radius * 2.0f), center, up);
+
+                glViewport(x * FRAME_RESOLUTION, y * FRAME_RESOLUTION, FRAME_RESOLUTION, FRAME_RESOLUTION);
+                glUniformMatrix4fv(m_bakeViewProjectionLoc, 1, GL_FALSE, glm::value_ptr(viewProjection));
+                glUniform3f(m_bakeDirectionLoc, direction.x, direction.y, direction.z);
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.indices.size()), GL_UNSIGNED_INT, 0);
+            }
+        }
+
+        for (GLuint texture : textures) {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+    } else {
+        std::cerr << "Blad: Bufor ramki atlasu impostorow jest niekompletny" << std::endl;
+        glDeleteTextures(2, textures);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(1, &depthBuffer);
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    glDeleteBuffers(1, &ebo);
+
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glPolygonMode(GL_FRONT_AND_BACK, polygonMode[0]);
+    if (!depthTest) glDisable(GL_DEPTH_TEST);
+    if (blend) glEnable(GL_BLEND);
+    glUseProgram(previousProgram);
+    return complete;
+}
+
+/**
+ * @brief Zwraca atlas siatki, renderując go przy pierwszym użyciu
+ * @param mesh Dane siatki
+ * @return Indeks atlasu lub m_atlases.size() gdy atlasu nie udało się utworzyć
+ *
+ * @details Siatka o nieznanym adresie porównywana jest skrótem zawartości
+ * z istniejącymi atlasami - tłum obiektów z osobnymi kopiami tej samej
+ * siatki korzysta z jednego atlasu. Gdy liczba indeksów nie zgadza się
+ * z zapamiętaną (pod tym samym adresem powstała inna siatka), przypisanie
+ * jest wyznaczane ponownie.
+ */
+size_t ImpostorRenderer::getAtlas(const MeshData* mesh) {
+    auto cached = m_meshAtlas.find(mesh);
+    if (cached != m_meshAtlas.end() && cached->second.indexCount == mesh->indices.size()) {
+        return cached->second.atlas;
+    }
+
+    uint64_t hash = hashMeshData(*mesh);
+    size_t index = 0;
+    while (index < m_atlases.size() && m_atlases[index].contentHash != hash) {
+        index++;
+    }
+
+    if (index == m_atlases.size()) {
+        auto start = std::chrono::high_resolution_clock::now();
+        Atlas atlas = {};
+        atlas.contentHash = hash;
+        if (!bakeAtlas(*mesh, atlas)) return m_atlases.size();
+        m_atlases.push_back(atlas);
+        auto end = std::chrono::high_resolution_clock::now();
+        m_bakeMs += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    m_meshAtlas[mesh] = {index, mesh->indices.size()};
+    return index;
+}
+
+/**
+ * @brief Wybiera obiekty zastępowane impostorami
+ * @param objects Obiekty sceny do narysowania
+ * @param viewPosition Pozycja kamery głównej
+ * @param outRemaining Obiekty, które należy narysować siatką
+ *
+ * @details Odległość mierzona jest w promieniach sfery otaczającej, więc
+ * duże obiekty przechodzą w impostor później. Udział impostora rośnie
+ * liniowo w pasie przejścia; ten sam udział ustawiany jest obiektowi jako
+ * stopień przenikania, dzięki czemu siatka i impostor pokrywają się
+ * pikselami dokładnie raz. Decyzja zapada dla kamery głównej i obowiązuje
+ * we wszystkich widokach.
+ */
+void ImpostorRenderer::collect(const std::vector<TransformableObject*>& objects, const glm::vec3& viewPosition,
+                               std::vector<TransformableObject*>& outRemaining) {
+    m_candidates.clear();
+    m_fadingCount = 0;
+    for (TransformableObject* object : objects) {
+        if (!object) continue;
+        object->setDissolve(0.0f);
+
+        const MeshData* data = m_initialized && m_enabled ? object->getMeshData() : nullptr;
+        BoundingSphere bounds = object->getWorldBounds();
+        if (!data || data->indices.size() / 3 < static_cast<size_t>(MIN_TRIANGLES) || bounds.radius <= 0.0f) {
+            outRemaining.push_back(object);
+            continue;
+        }
+
+        float distance = glm::length(bounds.center - viewPosition) / bounds.radius;
+        float fade = m_fadeDistance > 0.0f ? (distance - m_startDistance) / m_fadeDistance
+                                           : (distance >= m_startDistance ? 1.0f : 0.0f);
+        fade = std::min(fade, 1.0f);
+        size_t atlas = fade > 0.0f ? getAtlas(data) : m_atlases.size();
+        if (atlas == m_atlases.size()) {
+            outRemaining.push_back(object);
+            continue;
+        }
+
+        m_candidates.push_back({object, atlas, fade});
+        if (fade < 1.0f) {
+            object->setDissolve(fade);
+            outRemaining.push_back(object);
+            m_fadingCount++;
+        }
+    }
+}
+
+/**
+ * @brief Grupuje widoczne impostory według atlasu i wysyła dane instancji
+ * @param lightList Globalna lista świateł
+ *
+ * @details Dane instancji mają układ danych obiektów MultiViewRenderer;
+ * ostatnia składowa zawiera udział impostora zamiast przenikania siatki.
+ * Bufor jest osierocany przed zapisem, aby nie czekać na GPU.
+ */
+void ImpostorRenderer::prepareInstances(const glm::ivec2& lightList) {
+    std::stable_sort(m_visible.begin(), m_visible.end(),
+                     [](const Candidate& a, const Candidate& b) { return a.atlas < b.atlas; });
+
+    const int texels = MultiViewRenderer::OBJECT_DATA_TEXELS;
+    m_instanceData.resize(m_visible.size() * texels);
+    for (size_t i = 0; i < m_visible.size(); ++i) {
+        const Candidate& candidate = m_visible[i];
+        if (m_groups.empty() || m_groups.back().atlas != candidate.atlas) {
+            m_groups.push_back({candidate.atlas, static_cast<GLsizei>(i), 0});
+        }
+        m_groups.back().count++;
+
+        glm::mat4 model = candidate.object->getModelMatrix();
+        glm::vec4* out = &m_instanceData[i * texels];
+        out[0] = model[0];
+        out[1] = model[1];
+        out[2] = model[2];
+        out[3] = model[3];
+        out[4] = glm::vec4(static_cast<float>(lightList.x), static_cast<float>(lightList.y),
+                           static_cast<float>(candidate.object->getMaterialId()), candidate.fade);
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_instanceData.size() * sizeof(glm::vec4));
+    glBindBuffer(GL_TEXTURE_BUFFER, m_instanceBuffer);
+    if (size > m_instanceCapacity) {
+        m_instanceCapacity = size * 2;
+        glBufferData(GL_TEXTURE_BUFFER, m_instanceCapacity, nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_instanceTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_instanceBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    } else {
+        glBufferData(GL_TEXTURE_BUFFER, m_instanceCapacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, m_instanceData.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+/**
+ * @brief Odrzuca niewidoczne impostory i wysyła dane klatki
+ * @param frustums Ostrosłupy wszystkich widoków
+ * @param lightList Globalna lista świateł
+ */
+void ImpostorRenderer::prepare(const std::vector<Frustum>& frustums, const glm::ivec2& lightList) {
+    m_groups.clear();
+    m_visible.clear();
+
+    size_t savedTriangles = 0;
+    for (const Candidate& candidate : m_candidates) {
+        BoundingSphere sphere = candidate.object->getWorldBounds();
+        for (const Frustum& frustum : frustums) {
+            if (frustum.intersects(sphere)) {
+                m_visible.push_back(candidate);
+                if (candidate.fade >= 1.0f) savedTriangles += m_atlases[candidate.atlas].triangleCount - 2;
+                break;
+            }
+        }
+    }
+
+    if (!m_visible.empty()) {
+        prepareInstances(lightList);
+    }
+
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Impostory/Obiekty", static_cast<double>(m_visible.size()));
+    stats.setValue("Impostory/W pasie przejscia", static_cast<double>(m_fadingCount));
+    stats.setValue("Impostory/Atlasy", static_cast<double>(m_atlases.size()));
+    stats.setValue("Impostory/Zaoszczedzone trojkaty", static_cast<double>(savedTriangles));
+    stats.setValue("Impostory/Tworzenie atlasow [ms]", m_bakeMs);
+    stats.setValue("Impostory/Wywolania rysowania", 0.0);
+}
+
+/**
+ * @brief Rysuje impostory w aktywnym widoku
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(), więc kwadraty zwracają się do kamery
+ * każdego widoku. Poprzedni program jest przywracany.
+ */
+int ImpostorRenderer::draw() {
+    if (m_groups.empty()) return 0;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+
+    glActiveTexture(GL_TEXTURE0 + MultiViewRenderer::OBJECT_DATA_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_instanceTexture);
+    glBindVertexArray(m_emptyVAO);
+
+    for (const DrawGroup& group : m_groups) {
+        const Atlas& atlas = m_atlases[group.atlas];
+        glActiveTexture(GL_TEXTURE0 + ATLAS_COLOR_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, atlas.colorTexture);
+        glActiveTexture(GL_TEXTURE0 + ATLAS_NORMAL_DEPTH_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, atlas.normalDepthTexture);
+
+        glUniform1i(m_objectIndexLoc, group.first);
+        glUniform4f(m_boundsLoc, atlas.bounds.center.x, atlas.bounds.center.y, atlas.bounds.center.z,
+                    atlas.bounds.radius);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, group.count);
+    }
+
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0 + ATLAS_NORMAL_DEPTH_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0 + ATLAS_COLOR_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glUseProgram(previousProgram);
+
+    int draws = static_cast<int>(m_groups.size());
+    RenderStats::instance().addValue("Impostory/Wywolania rysowania", draws);
+    return draws;
+}
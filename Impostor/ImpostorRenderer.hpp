@@ -0,0 +1,216 @@
+// ImpostorRenderer.hpp
+#ifndef IMPOSTOR_RENDERER_HPP
+#define IMPOSTOR_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+#include "../Math/Bounds.hpp"
+
+class TransformableObject;
+
+/**
+ * @class ImpostorRenderer
+ * @brief Zastępowanie odległych obiektów impostorami z atlasu oktaedrycznego
+ *
+ * Przy pierwszym użyciu siatki renderowane są jej ujęcia z GRID_SIZE x GRID_SIZE
+ * kierunków rozłożonych na oktaedrze (pełna sfera kierunków) do atlasu
+ * złożonego z dwóch tekstur: koloru z pokryciem oraz normalnej z głębokością
+ * w przestrzeni siatki. Identyczne siatki współdzielą atlas. Co klatkę:
+ * - collect() dzieli obiekty według odległości od kamery głównej (w promieniach
+ *   sfery otaczającej): bliskie zostają siatką, dalekie stają się impostorami,
+ *   a w pasie przejścia rysowane są oba z uzupełniającym się ditheringiem,
+ * - prepare() odrzuca impostory niewidoczne w żadnym widoku i wysyła dane
+ *   instancji (układ danych obiektów MultiViewRenderer),
+ * - draw() rysuje każdy atlas jednym glDrawArraysInstanced: kwadrat zwrócony
+ *   do kamery (dwa trójkąty) miesza trzy najbliższe ujęcia wagami
+ *   barycentrycznymi, oświetla wynik normalną z atlasu i odtwarza głębokość.
+ */
+class ImpostorRenderer {
+public:
+    static const int GRID_SIZE = 8;                         /**< Liczba ujęć w wierszu i kolumnie atlasu */
+    static const int FRAME_RESOLUTION = 128;                /**< Rozdzielczość jednego ujęcia w pikselach */
+    static const int MIN_TRIANGLES = 256;                   /**< Najmniejsza siatka zastępowana impostorem */
+    static const int ATLAS_COLOR_TEXTURE_UNIT = 3;          /**< Jednostka teksturująca koloru atlasu */
+    static const int ATLAS_NORMAL_DEPTH_TEXTURE_UNIT = 4;   /**< Jednostka teksturująca normalnych i głębokości */
+
+private:
+    /**
+     * @struct Atlas
+     * @brief Ujęcia jednej siatki
+     */
+    struct Atlas {
+        GLuint colorTexture;        /**< Kolor bazowy (RGB) i pokrycie (A) */
+        GLuint normalDepthTexture;  /**< Normalna (RGB) i głębokość względem środka (A) */
+        BoundingSphere bounds;      /**< Sfera otaczająca w przestrzeni siatki */
+        uint64_t contentHash;       /**< Skrót wierzchołków i indeksów (wykrywanie identycznych siatek) */
+        size_t triangleCount;       /**< Liczba trójkątów zastępowanej siatki */
+    };
+
+    /**
+     * @struct CachedMesh
+     * @brief Atlas przypisany siatce
+     */
+    struct CachedMesh {
+        size_t atlas;               /**< Indeks w m_atlases */
+        size_t indexCount;          /**< Liczba indeksów siatki w chwili przypisania */
+    };
+
+    /**
+     * @struct Candidate
+     * @brief Obiekt rysowany w bieżącej klatce jako impostor
+     */
+    struct Candidate {
+        TransformableObject* object;    /**< Obiekt */
+        size_t atlas;                   /**< Indeks atlasu */
+        float fade;                     /**< Udział impostora (1 = obiekt w pełni zastąpiony) */
+    };
+
+    /**
+     * @struct DrawGroup
+     * @brief Instancje jednego atlasu
+     */
+    struct DrawGroup {
+        size_t atlas;               /**< Indeks atlasu */
+        GLsizei first;              /**< Pierwsza instancja */
+        GLsizei count;              /**< Liczba instancji */
+    };
+
+    std::vector<Atlas> m_atlases;                                   /**< Atlasy wszystkich siatek */
+    std::unordered_map<const MeshData*, CachedMesh> m_meshAtlas;    /**< Atlas przypisany adresowi siatki */
+    std::vector<Candidate> m_candidates;                            /**< Impostory wybrane w collect() */
+    std::vector<Candidate> m_visible;                               /**< Kandydaci widoczni w którymś widoku */
+    std::vector<DrawGroup> m_groups;                                /**< Grupy bieżącej klatki */
+    std::vector<glm::vec4> m_instanceData;                          /**< Dane instancji */
+
+    GLuint m_program;               /**< Program rysowania impostorów */
+    GLuint m_bakeProgram;           /**< Program renderowania ujęć */
+    GLuint m_emptyVAO;              /**< Pusty VAO (wierzchołki kwadratu z gl_VertexID) */
+    GLuint m_instanceBuffer;        /**< Bufor danych instancji */
+    GLuint m_instanceTexture;       /**< Tekstura buforowa nad m_instanceBuffer */
+    GLsizeiptr m_instanceCapacity;  /**< Pojemność bufora instancji w bajtach */
+    GLint m_objectIndexLoc;         /**< Lokalizacja uniformu pierwszej instancji */
+    GLint m_boundsLoc;              /**< Lokalizacja uniformu sfery otaczającej siatki */
+    GLint m_bakeViewProjectionLoc;  /**< Lokalizacja macierzy ujęcia */
+    GLint m_bakeBoundsLoc;          /**< Lokalizacja sfery otaczającej przy renderowaniu ujęć */
+    GLint m_bakeDirectionLoc;       /**< Lokalizacja kierunku ujęcia */
+    bool m_initialized;             /**< Czy obiekty OpenGL zostały utworzone */
+
+    bool m_enabled;                 /**< Czy impostory są włączone */
+    float m_startDistance;          /**< Początek przejścia (odległość w promieniach sfery otaczającej) */
+    float m_fadeDistance;           /**< Szerokość pasa przejścia (w promieniach) */
+    size_t m_fadingCount;           /**< Obiekty w pasie przejścia w bieżącej klatce */
+    double m_bakeMs;                /**< Łączny czas renderowania atlasów [ms] */
+
+    /**
+     * @brief Zwraca atlas siatki, renderując go przy pierwszym użyciu
+     * @param mesh Dane siatki
+     * @return Indeks atlasu lub m_atlases.size() gdy atlasu nie udało się utworzyć
+     */
+    size_t getAtlas(const MeshData* mesh);
+
+    /**
+     * @brief Renderuje ujęcia siatki do nowego atlasu
+     * @param mesh Dane siatki
+     * @param atlas Atlas do uzupełnienia (tekstury i sfera otaczająca)
+     * @return true jeśli się powiodło
+     */
+    bool bakeAtlas(const MeshData& mesh, Atlas& atlas);
+
+    /**
+     * @brief Grupuje widoczne impostory według atlasu i wysyła dane instancji
+     * @param lightList Globalna lista świateł
+     */
+    void prepareInstances(const glm::ivec2& lightList);
+
+public:
+    /**
+     * @brief Konstruktor ImpostorRenderer
+     */
+    ImpostorRenderer();
+
+    /**
+     * @brief Destruktor ImpostorRenderer
+     */
+    ~ImpostorRenderer();
+
+    /**
+     * @brief Kompiluje shadery i tworzy bufory
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia programy, bufory i atlasy
+     */
+    void release();
+
+    /**
+     * @brief Włącza lub wyłącza impostory
+     * @param enabled false = wszystkie obiekty rysowane siatką
+     */
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+
+    /**
+     * @brief Sprawdza, czy impostory są włączone
+     * @return true jeśli włączone
+     */
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Ustawia odległości przejścia
+     * @param start Odległość (w promieniach sfery otaczającej), od której zaczyna się przejście
+     * @param fade Szerokość pasa przenikania siatki z impostorem (w promieniach)
+     */
+    void setDistances(float start, float fade);
+
+    /**
+     * @brief Wybiera obiekty zastępowane impostorami
+     * @param objects Obiekty sceny do narysowania
+     * @param viewPosition Pozycja kamery głównej
+     * @param outRemaining Obiekty, które należy narysować siatką (także te w pasie przejścia)
+     */
+    void collect(const std::vector<TransformableObject*>& objects, const glm::vec3& viewPosition,
+                 std::vector<TransformableObject*>& outRemaining);
+
+    /**
+     * @brief Odrzuca niewidoczne impostory i wysyła dane klatki
+     * @param frustums Ostrosłupy wszystkich widoków
+     * @param lightList Globalna lista świateł
+     */
+    void prepare(const std::vector<Frustum>& frustums, const glm::ivec2& lightList);
+
+    /**
+     * @brief Rysuje impostory w aktywnym widoku
+     * @return Liczba wywołań rysowania
+     */
+    int draw();
+
+    /**
+     * @brief Zamienia punkt siatki ujęć na kierunek (oktaedr, biegun +Y w środku atlasu)
+     * @param grid Współrzędne ujęcia z przedziału [0, GRID_SIZE - 1]
+     * @return Znormalizowany kierunek od środka obiektu do kamery ujęcia
+     */
+    static glm::vec3 gridToDirection(const glm::vec2& grid);
+
+    /**
+     * @brief Zamienia kierunek na punkt siatki ujęć (odwrotność gridToDirection)
+     * @param direction Kierunek od środka obiektu do kamery
+     * @return Współrzędne z przedziału [0, GRID_SIZE - 1]
+     */
+    static glm::vec2 directionToGrid(const glm::vec3& direction);
+
+    /**
+     * @brief Wyznacza osie ekranu ujęcia patrzącego z kierunku direction
+     * @param direction Kierunek od środka obiektu do kamery
+     * @param right Wynikowa oś pozioma
+     * @param up Wynikowa oś pionowa
+     */
+    static void frameBasis(const glm::vec3& direction, glm::vec3& right, glm::vec3& up);
+};
+
+#endif // IMPOSTOR_RENDERER_HPP
@@ -0,0 +1,630 @@
+// RayCastRenderer.cpp
+#include "RayCastRenderer.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+/**
+ * @brief Wspólna część vertex shaderów: kamera i dane prymitywów
+ */
+static const char* rayCastVertexCommonSource = R"(
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+uniform samplerBuffer primitiveData;
+uniform samplerBuffer primitiveColors;
+
+out vec3 RayTarget; // punkt bryły otaczającej, przez który przechodzi promień fragmentu
+flat out vec3 Color;
+)";
+
+/**
+ * @brief Vertex shader sfer
+ *
+ * Trójkąt równoboczny opisany na okręgu leży w płaszczyźnie przez środek
+ * sfery, prostopadłej do kierunku do kamery. Stożek styczny do sfery
+ * przecina tę płaszczyznę w okręgu o promieniu r * d / sqrt(d^2 - r^2),
+ * więc trójkąt pokrywa cały obrys także w perspektywie.
+ */
+static const char* sphereVertexSource = R"(
+flat out vec4 Sphere;
+
+const vec2 corners[3] = vec2[3](vec2(0.0, 2.0), vec2(-1.7320508, -1.0), vec2(1.7320508, -1.0));
+
+void main()
+{
+    int index = gl_VertexID / 3;
+    vec4 sphere = texelFetch(primitiveData, index);
+    Sphere = sphere;
+    Color = texelFetch(primitiveColors, index).rgb;
+
+    vec3 toCamera = cameraPosition.xyz - sphere.xyz;
+    float distance2 = dot(toCamera, toCamera);
+    float radius2 = sphere.w * sphere.w;
+    if (distance2 <= radius2) {
+        // Kamera wewnątrz sfery: trójkąt zdegenerowany
+        RayTarget = sphere.xyz;
+        gl_Position = vec4(0.0);
+        return;
+    }
+
+    vec3 forward = toCamera * inversesqrt(distance2);
+    vec3 reference = abs(forward.y) < 0.999 ? vec3(0.0, 1.0, 0.0) : vec3(0.0, 0.0, -1.0);
+    vec3 right = normalize(cross(reference, forward));
+    vec3 up = cross(forward, right);
+    float expanded = sphere.w * sqrt(distance2 / (distance2 - radius2));
+    vec2 corner = corners[gl_VertexID - index * 3];
+    RayTarget = sphere.xyz + (right * corner.x + up * corner.y) * expanded;
+    gl_Position = projection * view * vec4(RayTarget, 1.0);
+}
+)";
+
+/**
+ * @brief Vertex shader cylindrów
+ *
+ * Prostopadłościan otaczający cylinder (osie u, v prostopadłe do osi w
+ * cylindra) ma najwyżej trzy ściany zwrócone do kamery; każdy cylinder
+ * generuje właśnie je (3 x 2 trójkąty) z kolejnością CCW od zewnątrz.
+ */
+static const char* cylinderVertexSource = R"(
+flat out vec4 CylinderStart; // xyz = środek pierwszej podstawy, w = promień
+flat out vec3 CylinderEnd;
+
+const vec2 quad[6] = vec2[6](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+                             vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+
+void main()
+{
+    int index = gl_VertexID / 18;
+    int local = gl_VertexID - index * 18;
+    int face = local / 6;
+    vec4 start = texelFetch(primitiveData, index * 2);
+    vec3 end = texelFetch(primitiveData, index * 2 + 1).xyz;
+    CylinderStart = start;
+    CylinderEnd = end;
+    Color = texelFetch(primitiveColors, index).rgb;
+
+    vec3 axis = end - start.xyz;
+    float len = length(axis);
+    vec3 w = len > 0.0 ? axis / len : vec3(0.0, 1.0, 0.0);
+    vec3 reference = abs(w.y) < 0.999 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
+    vec3 u = normalize(cross(reference, w));
+    mat3 axes = mat3(u, cross(w, u), w);
+    vec3 halfSize = vec3(start.w, start.w, len * 0.5);
+    vec3 center = (start.xyz + end) * 0.5;
+
+    // Ściana o normalnej +-axes[face]; krawędzie wzdłuż dwóch kolejnych osi (cyklicznie)
+    int i = (face + 1) % 3;
+    int j = (face + 2) % 3;
+    float side = dot(cameraPosition.xyz - center, axes[face]) >= 0.0 ? 1.0 : -1.0;
+    vec2 corner = quad[local - face * 6];
+    if (side < 0.0) corner = corner.yx; // odwrócona normalna: zamiana krawędzi zachowuje CCW
+    RayTarget = center + axes[face] * (side * halfSize[face]) +
+                axes[i] * (corner.x * halfSize[i]) + axes[j] * (corner.y * halfSize[j]);
+    gl_Position = projection * view * vec4(RayTarget, 1.0);
+}
+)";
+
+/**
+ * @brief Deklaracja zapisu głębokości we fragment shaderach
+ *
+ * Poprzedzona definicją DEPTH_LAYOUT: punkt powierzchni sfery leży przed
+ * trójkątem (depth_less), a cylindra za ścianą prostopadłościanu
+ * (depth_greater). Z rozszerzeniem GL_ARB_conservative_depth GPU może
+ * wtedy zachować wczesny test głębokości mimo zapisu gl_FragDepth.
+ * Dyrektywa #extension musi poprzedzać kod oświetlenia.
+ */
+static const char* rayCastFragmentDepthSource = R"(
+#ifdef GL_ARB_conservative_depth
+#extension GL_ARB_conservative_depth : enable
+layout (DEPTH_LAYOUT) out float gl_FragDepth;
+#endif
+)";
+
+/**
+ * @brief Wspólna część fragment shaderów: głębokość i oświetlenie
+ *
+ * Poprzedzona kodem z LightCuller::getShaderSource().
+ */
+static const char* rayCastFragmentCommonSource = R"(
+out vec4 FragColor;
+
+in vec3 RayTarget;
+flat in vec3 Color;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+uniform ivec2 lightList;
+uniform int materialIndex;
+
+// Zapisuje głębokość trafionego punktu i oświetla go
+void shadeSurface(vec3 position, vec3 normal) {
+    vec4 clipPos = projection * view * vec4(position, 1.0);
+    gl_FragDepth = clipPos.z / clipPos.w * 0.5 + 0.5;
+
+    vec3 viewDir = normalize(cameraPosition.xyz - position);
+    PackedMaterial material = materialData[materialIndex];
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < lightList.y; i++) {
+        int lightIndex = texelFetch(lightIndices, lightList.x + i).r;
+        result += calculatePhongLight(lightData[lightIndex], material, normal, position, viewDir);
+    }
+    FragColor = vec4(result * Color, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader sfer
+ *
+ * Promień startuje z punktu trójkąta (mniejsze liczby niż od kamery, więc
+ * lepsza precyzja dla odległych sfer); pierwsze przecięcie może leżeć
+ * przed nim (t < 0).
+ */
+static const char* sphereFragmentSource = R"(
+flat in vec4 Sphere;
+
+void main()
+{
+    vec3 direction = normalize(RayTarget - cameraPosition.xyz);
+    vec3 offset = RayTarget - Sphere.xyz;
+    float b = dot(offset, direction);
+    vec3 closest = offset - b * direction;
+    float h = Sphere.w * Sphere.w - dot(closest, closest);
+    if (h < 0.0) discard;
+
+    vec3 position = RayTarget + direction * (-b - sqrt(h));
+    shadeSurface(position, (position - Sphere.xyz) / Sphere.w);
+}
+)";
+
+/**
+ * @brief Fragment shader cylindrów
+ *
+ * Przecięcie z powierzchnią boczną (równanie kwadratowe w płaszczyźnie
+ * prostopadłej do osi), a gdy punkt wypada poza odcinek - z podstawą
+ * bliższą kamerze.
+ */
+static const char* cylinderFragmentSource = R"(
+flat in vec4 CylinderStart;
+flat in vec3 CylinderEnd;
+
+void main()
+{
+    vec3 direction = normalize(RayTarget - cameraPosition.xyz);
+    vec3 axis = CylinderEnd - CylinderStart.xyz;
+    vec3 offset = RayTarget - CylinderStart.xyz;
+    float radius = CylinderStart.w;
+    float axisAxis = dot(axis, axis);
+    float axisDirection = dot(axis, direction);
+    float axisOffset = dot(axis, offset);
+
+    float k2 = axisAxis - axisDirection * axisDirection;
+    if (k2 > 1.0e-6 * axisAxis) {
+        float k1 = axisAxis * dot(offset, direction) - axisOffset * axisDirection;
+        float k0 = axisAxis * dot(offset, offset) - axisOffset * axisOffset - radius * radius * axisAxis;
+        float h = k1 * k1 - k2 * k0;
+        if (h < 0.0) discard;
+        float t = (-k1 - sqrt(h)) / k2;
+        float y = axisOffset + t * axisDirection;
+        if (y > 0.0 && y < axisAxis) {
+            vec3 position = RayTarget + direction * t;
+            shadeSurface(position, (offset + direction * t - axis * (y / axisAxis)) / radius);
+            return;
+        }
+    }
+
+    if (abs(axisDirection) < 1.0e-6) discard;
+    float cap = axisDirection > 0.0 ? 0.0 : axisAxis;
+    float t = (cap - axisOffset) / axisDirection;
+    vec3 fromCapCenter = offset + direction * t - axis * (cap / axisAxis);
+    if (dot(fromCapCenter, fromCapCenter) > radius * radius) discard;
+    shadeSurface(RayTarget + direction * t, normalize(axis) * (axisDirection > 0.0 ? -1.0 : 1.0));
+}
+)";
+
+/**
+ * @brief Kompiluje i linkuje program jednego rodzaju prymitywów
+ * @param vertexSource Vertex shader prymitywu
+ * @param fragmentSource Fragment shader prymitywu
+ * @param depthLayout Kierunek zmiany głębokości względem bryły otaczającej
+ * @return ID programu lub 0 w przypadku błędu
+ */
+static GLuint linkRayCastProgram(const char* vertexSource, const char* fragmentSource, const char* depthLayout) {
+    const char* vertexSources[] = {"#version 330 core\n", rayCastVertexCommonSource, vertexSource};
+    const char* fragmentSources[] = {"#version 330 core\n",       depthLayout,
+                                     rayCastFragmentDepthSource,  LightCuller::getShaderSource(),
+                                     rayCastFragmentCommonSource, fragmentSource};
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, vertexSources, 3, "sfer i cylindrow");
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSources, 6, "sfer i cylindrow");
+    GLuint program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "sfer i cylindrow");
+    if (!program) return 0;
+
+    MultiViewRenderer::setupProgram(program);
+    LightCuller::setupProgram(program);
+    MaterialTable::setupProgram(program);
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "primitiveData"), RayCastRenderer::PRIMITIVE_DATA_TEXTURE_UNIT);
+    glUniform1i(glGetUniformLocation(program, "primitiveColors"), RayCastRenderer::PRIMITIVE_COLOR_TEXTURE_UNIT);
+    return program;
+}
+
+/**
+ * @brief Rozsuwa 10 najmłodszych bitów co trzy pozycje (kod Mortona)
+ * @param value Współrzędna z przedziału [0, 1023]
+ * @return Bity na pozycjach 0, 3, 6, ...
+ */
+static uint32_t spreadBits(uint32_t value) {
+    value &= 0x3ff;
+    value = (value | (value << 16)) & 0x030000ff;
+    value = (value | (value << 8)) & 0x0300f00f;
+    value = (value | (value << 4)) & 0x030c30c3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+/**
+ * @brief Pakuje kolor do RGBA8
+ * @param color Kolor z przedziału [0, 1]
+ * @return Kolor w kolejności bajtów R, G, B, A
+ */
+static uint32_t packColor(const glm::vec3& color) {
+    auto channel = [](float value) {
+        return static_cast<uint32_t>(std::lround(std::min(std::max(value, 0.0f), 1.0f) * 255.0f));
+    };
+    return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (255u << 24);
+}
+
+/**
+ * @brief Zwraca prostopadłościan otaczający prymityw
+ * @param data Teksele prymitywu (sfera: środek i promień, cylinder: dwie podstawy)
+ * @param texels Liczba tekseli prymitywu
+ * @return Prostopadłościan otaczający
+ */
+static BoundingBox primitiveBounds(const glm::vec4* data, int texels) {
+    float radius = data[0].w;
+    BoundingBox box = BoundingBox::empty();
+    for (int i = 0; i < texels; ++i) {
+        box.expand(glm::vec3(data[i]) - glm::vec3(radius));
+        box.expand(glm::vec3(data[i]) + glm::vec3(radius));
+    }
+    return box;
+}
+
+/**
+ * @brief Konstruktor RayCastRenderer
+ */
+RayCastRenderer::RayCastRenderer()
+    : m_emptyVAO(0), m_maxTexels(0), m_materialId(MaterialTable::DEFAULT_MATERIAL), m_dirty(false),
+      m_initialized(false), m_uploadMs(0.0) {
+    for (Batch* batch : {&m_spheres, &m_cylinders}) {
+        batch->program = 0;
+        batch->dataBuffer = 0;
+        batch->dataTexture = 0;
+        batch->colorBuffer = 0;
+        batch->colorTexture = 0;
+        batch->lightListLoc = -1;
+        batch->materialIndexLoc = -1;
+        batch->uploadedCount = 0;
+    }
+    m_spheres.texelsPerPrimitive = 1;
+    m_spheres.verticesPerPrimitive = 3;
+    m_cylinders.texelsPerPrimitive = 2;
+    m_cylinders.verticesPerPrimitive = 18;
+}
+
+/**
+ * @brief Destruktor RayCastRenderer
+ */
+RayCastRenderer::~RayCastRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery i tworzy bufory
+ * @return true jeśli inicjalizacja się powiodła
+ *
+ * @details Programy korzystają z tych samych bloków Camera, Lights
+ * i Materials co shader sceny, więc wiązane są z tymi samymi punktami.
+ */
+bool RayCastRenderer::initialize() {
+    if (m_initialized) return true;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+
+    m_spheres.program = linkRayCastProgram(sphereVertexSource, sphereFragmentSource,
+                                           "#define DEPTH_LAYOUT depth_less\n");
+    m_cylinders.program = linkRayCastProgram(cylinderVertexSource, cylinderFragmentSource,
+                                             "#define DEPTH_LAYOUT depth_greater\n");
+    glUseProgram(previousProgram);
+    glGenVertexArrays(1, &m_emptyVAO);
+
+    bool created = m_spheres.program != 0 && m_cylinders.program != 0 && m_emptyVAO != 0;
+    for (Batch* batch : {&m_spheres, &m_cylinders}) {
+        glGenBuffers(1, &batch->dataBuffer);
+        glGenTextures(1, &batch->dataTexture);
+        glGenBuffers(1, &batch->colorBuffer);
+        glGenTextures(1, &batch->colorTexture);
+        created = created && batch->dataBuffer && batch->dataTexture && batch->colorBuffer && batch->colorTexture;
+        batch->lightListLoc = glGetUniformLocation(batch->program, "lightList");
+        batch->materialIndexLoc = glGetUniformLocation(batch->program, "materialIndex");
+    }
+
+    if (!created) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow sfer i cylindrow" << std::endl;
+        release();
+        return false;
+    }
+
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &m_maxTexels);
+    m_dirty = true;
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zwalnia programy i bufory (dane CPU pozostają)
+ */
+void RayCastRenderer::release() {
+    for (Batch* batch : {&m_spheres, &m_cylinders}) {
+        if (batch->program) glDeleteProgram(batch->program);
+        if (batch->dataBuffer) glDeleteBuffers(1, &batch->dataBuffer);
+        if (batch->dataTexture) glDeleteTextures(1, &batch->dataTexture);
+        if (batch->colorBuffer) glDeleteBuffers(1, &batch->colorBuffer);
+        if (batch->colorTexture) glDeleteTextures(1, &batch->colorTexture);
+        batch->program = 0;
+        batch->dataBuffer = 0;
+        batch->dataTexture = 0;
+        batch->colorBuffer = 0;
+        batch->colorTexture = 0;
+        batch->uploadedCount = 0;
+        batch->chunks.clear();
+    }
+    if (m_emptyVAO) glDeleteVertexArrays(1, &m_emptyVAO);
+    m_emptyVAO = 0;
+    m_initialized = false;
+}
+
+/**
+ * @brief Usuwa wszystkie sfery i cylindry
+ */
+void RayCastRenderer::clear() {
+    for (Batch* batch : {&m_spheres, &m_cylinders}) {
+        batch->data.clear();
+        batch->data.shrink_to_fit();
+        batch->colors.clear();
+        batch->colors.shrink_to_fit();
+    }
+    m_dirty = true;
+}
+
+/**
+ * @brief Dodaje sferę
+ * @param center Środek w przestrzeni świata
+ * @param radius Promień
+ * @param color Kolor
+ */
+void RayCastRenderer::addSphere(const glm::vec3& center, float radius, const glm::vec3& color) {
+    m_spheres.data.push_back(glm::vec4(center, radius));
+    m_spheres.colors.push_back(packColor(color));
+    m_dirty = true;
+}
+
+/**
+ * @brief Dodaje cylinder z płaskimi podstawami
+ * @param start Środek pierwszej podstawy
+ * @param end Środek drugiej podstawy
+ * @param radius Promień
+ * @param color Kolor
+ */
+void RayCastRenderer::addCylinder(const glm::vec3& start, const glm::vec3& end, float radius, const glm::vec3& color) {
+    m_cylinders.data.push_back(glm::vec4(start, radius));
+    m_cylinders.data.push_back(glm::vec4(end, 0.0f));
+    m_cylinders.colors.push_back(packColor(color));
+    m_dirty = true;
+}
+
+/**
+ * @brief Sortuje prymitywy według kodu Mortona, dzieli na porcje i wysyła do GPU
+ * @param batch Prymitywy jednego rodzaju
+ *
+ * @details Kod Mortona środka (10 bitów na oś w prostopadłościanie całego
+ * zbioru) układa bliskie prymitywy obok siebie, więc porcje mają małe
+ * prostopadłościany otaczające i odrzucanie porcji jest skuteczne. Dane
+ * CPU zostają w nowej kolejności. Zbiór większy niż
+ * GL_MAX_TEXTURE_BUFFER_SIZE jest obcinany z komunikatem.
+ */
+void RayCastRenderer::uploadBatch(Batch& batch) {
+    const int texels = batch.texelsPerPrimitive;
+    size_t count = batch.colors.size();
+    batch.chunks.clear();
+    batch.uploadedCount = 0;
+    if (count == 0) return;
+
+    BoundingBox total = BoundingBox::empty();
+    std::vector<glm::vec3> centers(count);
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 center(0.0f);
+        for (int k = 0; k < texels; ++k) center += glm::vec3(batch.data[i * texels + k]);
+        centers[i] = center / static_cast<float>(texels);
+        total.expand(centers[i]);
+    }
+
+    glm::vec3 extent = glm::max(total.max - total.min, glm::vec3(1.0e-6f));
+    std::vector<std::pair<uint32_t, uint32_t>> order(count);
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 cell = (centers[i] - total.min) / extent * 1023.0f;
+        uint32_t key = spreadBits(static_cast<uint32_t>(cell.x)) |
+                       (spreadBits(static_cast<uint32_t>(cell.y)) << 1) |
+                       (spreadBits(static_cast<uint32_t>(cell.z)) << 2);
+        order[i] = {key, static_cast<uint32_t>(i)};
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<glm::vec4> data(batch.data.size());
+    std::vector<uint32_t> colors(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t source = order[i].second;
+        std::copy(batch.data.begin() + source * texels, batch.data.begin() + (source + 1) * texels,
+                  data.begin() + i * texels);
+        colors[i] = batch.colors[source];
+    }
+    batch.data.swap(data);
+    batch.colors.swap(colors);
+
+    size_t limit = m_maxTexels > 0 ? static_cast<size_t>(m_maxTexels) / texels : count;
+    if (count > limit) {
+        std::cerr << "Blad: " << count << " prymitywow przekracza GL_MAX_TEXTURE_BUFFER_SIZE, rysowane bedzie "
+                  << limit << std::endl;
+        count = limit;
+    }
+    batch.uploadedCount = count;
+
+    for (size_t first = 0; first < count; first += CHUNK_SIZE) {
+        size_t last = std::min(first + CHUNK_SIZE, count);
+        Chunk chunk;
+        chunk.first = static_cast<GLint>(first * batch.verticesPerPrimitive);
+        chunk.count = static_cast<GLsizei>((last - first) * batch.verticesPerPrimitive);
+        chunk.primitives = last - first;
+        chunk.bounds = BoundingBox::empty();
+        for (size_t i = first; i < last; ++i) {
+            BoundingBox box = primitiveBounds(&batch.data[i * texels], texels);
+            chunk.bounds.expand(box.min);
+            chunk.bounds.expand(box.max);
+        }
+        batch.chunks.push_back(chunk);
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, batch.dataBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(count * texels * sizeof(glm::vec4)),
+                 batch.data.data(), GL_STATIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, batch.dataTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, batch.dataBuffer);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, batch.colorBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(count * sizeof(uint32_t)),
+                 batch.colors.data(), GL_STATIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, batch.colorTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8, batch.colorBuffer);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+/**
+ * @brief Wysyła zmienione dane i ustawia listę świateł klatki
+ * @param lightList Globalna lista świateł
+ */
+void RayCastRenderer::prepare(const glm::ivec2& lightList) {
+    if (!m_initialized) return;
+
+    if (m_dirty) {
+        auto start = std::chrono::high_resolution_clock::now();
+        uploadBatch(m_spheres);
+        uploadBatch(m_cylinders);
+        auto end = std::chrono::high_resolution_clock::now();
+        m_uploadMs = std::chrono::duration<double, std::milli>(end - start).count();
+        m_dirty = false;
+    }
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    for (Batch* batch : {&m_spheres, &m_cylinders}) {
+        glUseProgram(batch->program);
+        glUniform2i(batch->lightListLoc, lightList.x, lightList.y);
+        glUniform1i(batch->materialIndexLoc, static_cast<GLint>(m_materialId));
+    }
+    glUseProgram(previousProgram);
+
+    double gpuBytes = static_cast<double>(m_spheres.uploadedCount) * (sizeof(glm::vec4) + sizeof(uint32_t)) +
+                      static_cast<double>(m_cylinders.uploadedCount) * (2 * sizeof(glm::vec4) + sizeof(uint32_t));
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Sfery i cylindry/Sfery", static_cast<double>(m_spheres.uploadedCount));
+    stats.setValue("Sfery i cylindry/Cylindry", static_cast<double>(m_cylinders.uploadedCount));
+    stats.setValue("Sfery i cylindry/Pamiec GPU [MB]", gpuBytes / (1024.0 * 1024.0));
+    stats.setValue("Sfery i cylindry/Wysylanie danych [ms]", m_uploadMs);
+    stats.setValue("Sfery i cylindry/Widoczne sfery", 0.0);
+    stats.setValue("Sfery i cylindry/Widoczne cylindry", 0.0);
+    stats.setValue("Sfery i cylindry/Wywolania rysowania", 0.0);
+}
+
+/**
+ * @brief Rysuje porcje prymitywów widoczne w ostrosłupie
+ * @param batch Prymitywy jednego rodzaju
+ * @param frustum Ostrosłup widoku
+ * @return Liczba narysowanych prymitywów
+ *
+ * @details Sąsiednie widoczne porcje łączone są w jeden zakres.
+ */
+size_t RayCastRenderer::drawBatch(const Batch& batch, const Frustum& frustum) {
+    m_drawFirst.clear();
+    m_drawCount.clear();
+    size_t primitives = 0;
+    for (const Chunk& chunk : batch.chunks) {
+        if (!frustum.intersects(chunk.bounds)) continue;
+        if (!m_drawFirst.empty() && m_drawFirst.back() + m_drawCount.back() == chunk.first) {
+            m_drawCount.back() += chunk.count;
+        } else {
+            m_drawFirst.push_back(chunk.first);
+            m_drawCount.push_back(chunk.count);
+        }
+        primitives += chunk.primitives;
+    }
+    if (m_drawFirst.empty()) return 0;
+
+    glUseProgram(batch.program);
+    glActiveTexture(GL_TEXTURE0 + PRIMITIVE_DATA_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, batch.dataTexture);
+    glActiveTexture(GL_TEXTURE0 + PRIMITIVE_COLOR_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, batch.colorTexture);
+    glMultiDrawArrays(GL_TRIANGLES, m_drawFirst.data(), m_drawCount.data(), static_cast<GLsizei>(m_drawFirst.size()));
+    return primitives;
+}
+
+/**
+ * @brief Rysuje sfery i cylindry w aktywnym widoku
+ * @param frustum Ostrosłup widoku
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(). Poprzedni program jest przywracany.
+ */
+int RayCastRenderer::draw(const Frustum& frustum) {
+    if (!m_initialized || (m_spheres.uploadedCount == 0 && m_cylinders.uploadedCount == 0)) return 0;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glBindVertexArray(m_emptyVAO);
+
+    size_t spheres = drawBatch(m_spheres, frustum);
+    size_t cylinders = drawBatch(m_cylinders, frustum);
+
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0 + PRIMITIVE_COLOR_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0 + PRIMITIVE_DATA_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glUseProgram(previousProgram);
+
+    int draws = (spheres > 0 ? 1 : 0) + (cylinders > 0 ? 1 : 0);
+    RenderStats& stats = RenderStats::instance();
+    stats.addValue("Sfery i cylindry/Widoczne sfery", static_cast<double>(spheres));
+    stats.addValue("Sfery i cylindry/Widoczne cylindry", static_cast<double>(cylinders));
+    stats.addValue("Sfery i cylindry/Wywolania rysowania", draws);
+    return draws;
+}
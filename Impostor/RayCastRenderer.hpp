@@ -0,0 +1,171 @@
+// RayCastRenderer.hpp
+#ifndef RAY_CAST_RENDERER_HPP
+#define RAY_CAST_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../Material/MaterialTable.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @class RayCastRenderer
+ * @brief Sfery i cylindry rysowane jako impostory ze śledzeniem promienia
+ *
+ * Przeznaczony dla zbiorów rzędu milionów sfer połączonych cylindrami
+ * (modele cząsteczek), dla których nawet uproszczona siatka sfery na
+ * instancję to za dużo geometrii. Każda sfera to jeden trójkąt (3
+ * wierzchołki) opisany na jej obrysie na ekranie, a każdy cylinder to trzy
+ * ściany prostopadłościanu otaczającego zwrócone do kamery (18
+ * wierzchołków). Fragment shader przecina promień kamery z dokładną
+ * powierzchnią, zapisuje gl_FragDepth i oświetla punkt modelem Phonga
+ * sceny (te same bloki świateł i materiałów).
+ *
+ * Wierzchołki pobierane są z tekstur buforowych według gl_VertexID, więc
+ * cały zbiór rysowany jest bez instancjonowania. Dane są statyczne:
+ * przy pierwszym rysowaniu po zmianie prymitywy sortowane są według kodu
+ * Mortona i dzielone na porcje po CHUNK_SIZE, a w każdym widoku porcje
+ * poza ostrosłupem pomijane są w jednym glMultiDrawArrays.
+ */
+class RayCastRenderer {
+public:
+    static const int CHUNK_SIZE = 16384;                /**< Liczba prymitywów w porcji odrzucania */
+    static const int PRIMITIVE_DATA_TEXTURE_UNIT = 5;   /**< Jednostka teksturująca położeń i promieni */
+    static const int PRIMITIVE_COLOR_TEXTURE_UNIT = 6;  /**< Jednostka teksturująca kolorów */
+
+private:
+    /**
+     * @struct Chunk
+     * @brief Porcja kolejnych prymitywów z prostopadłościanem otaczającym
+     */
+    struct Chunk {
+        GLint first;            /**< Pierwszy wierzchołek porcji */
+        GLsizei count;          /**< Liczba wierzchołków porcji */
+        size_t primitives;      /**< Liczba prymitywów porcji */
+        BoundingBox bounds;     /**< Prostopadłościan otaczający porcję */
+    };
+
+    /**
+     * @struct Batch
+     * @brief Prymitywy jednego rodzaju w buforach GPU
+     */
+    struct Batch {
+        std::vector<glm::vec4> data;        /**< Teksele prymitywów (sfera: 1, cylinder: 2) */
+        std::vector<uint32_t> colors;       /**< Kolory RGBA8 */
+        std::vector<Chunk> chunks;          /**< Porcje odrzucania */
+        GLuint program;                     /**< Program rysujący */
+        GLuint dataBuffer;                  /**< Bufor tekseli */
+        GLuint dataTexture;                 /**< Tekstura buforowa nad dataBuffer */
+        GLuint colorBuffer;                 /**< Bufor kolorów */
+        GLuint colorTexture;                /**< Tekstura buforowa nad colorBuffer */
+        GLint lightListLoc;                 /**< Lokalizacja uniformu listy świateł */
+        GLint materialIndexLoc;             /**< Lokalizacja uniformu materiału */
+        int texelsPerPrimitive;             /**< Teksele na prymityw */
+        int verticesPerPrimitive;           /**< Wierzchołki na prymityw */
+        size_t uploadedCount;               /**< Liczba prymitywów w buforach GPU */
+    };
+
+    Batch m_spheres;                    /**< Sfery */
+    Batch m_cylinders;                  /**< Cylindry */
+    std::vector<GLint> m_drawFirst;     /**< Początki zakresów bieżącego widoku */
+    std::vector<GLsizei> m_drawCount;   /**< Długości zakresów bieżącego widoku */
+    GLuint m_emptyVAO;                  /**< Pusty VAO (wierzchołki z gl_VertexID) */
+    GLint m_maxTexels;                  /**< GL_MAX_TEXTURE_BUFFER_SIZE */
+    MaterialId m_materialId;            /**< Materiał wszystkich prymitywów (kolor z instancji) */
+    bool m_dirty;                       /**< Czy dane CPU różnią się od buforów GPU */
+    bool m_initialized;                 /**< Czy obiekty OpenGL zostały utworzone */
+    double m_uploadMs;                  /**< Czas ostatniego sortowania i wysłania danych [ms] */
+
+    /**
+     * @brief Sortuje prymitywy według kodu Mortona, dzieli na porcje i wysyła do GPU
+     * @param batch Prymitywy jednego rodzaju
+     */
+    void uploadBatch(Batch& batch);
+
+    /**
+     * @brief Rysuje porcje prymitywów widoczne w ostrosłupie
+     * @param batch Prymitywy jednego rodzaju
+     * @param frustum Ostrosłup widoku
+     * @return Liczba narysowanych prymitywów
+     */
+    size_t drawBatch(const Batch& batch, const Frustum& frustum);
+
+public:
+    /**
+     * @brief Konstruktor RayCastRenderer
+     */
+    RayCastRenderer();
+
+    /**
+     * @brief Destruktor RayCastRenderer
+     */
+    ~RayCastRenderer();
+
+    /**
+     * @brief Kompiluje shadery i tworzy bufory
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia programy i bufory (dane CPU pozostają)
+     */
+    void release();
+
+    /**
+     * @brief Usuwa wszystkie sfery i cylindry
+     */
+    void clear();
+
+    /**
+     * @brief Dodaje sferę
+     * @param center Środek w przestrzeni świata
+     * @param radius Promień
+     * @param color Kolor
+     */
+    void addSphere(const glm::vec3& center, float radius, const glm::vec3& color);
+
+    /**
+     * @brief Dodaje cylinder z płaskimi podstawami
+     * @param start Środek pierwszej podstawy
+     * @param end Środek drugiej podstawy
+     * @param radius Promień
+     * @param color Kolor
+     */
+    void addCylinder(const glm::vec3& start, const glm::vec3& end, float radius, const glm::vec3& color);
+
+    /**
+     * @brief Ustawia materiał wszystkich prymitywów
+     * @param materialId Wpis tabeli materiałów (kolor prymitywu mnoży wynik oświetlenia)
+     */
+    void setMaterial(MaterialId materialId) { m_materialId = materialId; }
+
+    /**
+     * @brief Zwraca liczbę sfer
+     * @return Liczba sfer
+     */
+    size_t getSphereCount() const { return m_spheres.colors.size(); }
+
+    /**
+     * @brief Zwraca liczbę cylindrów
+     * @return Liczba cylindrów
+     */
+    size_t getCylinderCount() const { return m_cylinders.colors.size(); }
+
+    /**
+     * @brief Wysyła zmienione dane i ustawia listę świateł klatki
+     * @param lightList Globalna lista świateł
+     */
+    void prepare(const glm::ivec2& lightList);
+
+    /**
+     * @brief Rysuje sfery i cylindry w aktywnym widoku
+     * @param frustum Ostrosłup widoku
+     * @return Liczba wywołań rysowania
+     */
+    int draw(const Frustum& frustum);
+};
+
+#endif // RAY_CAST_RENDERER_HPP
@@ -0,0 +1,29 @@
+// Light.hpp
+#ifndef LIGHT_HPP
+#define LIGHT_HPP
+
+#include <glm/glm.hpp>
+
+/**
+ * @struct Light
+ * @brief Źródło światła w modelu Phonga
+ *
+ * Tłumienie świateł punktowych i stożkowych wynosi
+ * 1 / (constant + linear * d + quadratic * d^2).
+ */
+struct Light {
+    glm::vec3 position;           ///< Pozycja światła
+    glm::vec3 direction;          ///< Kierunek światła (dla kierunkowego i stożkowego)
+    glm::vec3 color;              ///< Kolor światła
+    float ambientIntensity;       ///< Intensywność składowej ambient
+    float diffuseIntensity;       ///< Intensywność składowej diffuse
+    float specularIntensity;      ///< Intensywność składowej specular
+    float constant;               ///< Stały współczynnik tłumienia
+    float linear;                 ///< Liniowy współczynnik tłumienia
+    float quadratic;              ///< Kwadratowy współczynnik tłumienia
+    float cutoff;                 ///< Kąt wewnętrzny stożka światła
+    float outerCutoff;            ///< Kąt zewnętrzny stożka światła
+    int type;                     ///< Typ światła (0 = punktowe, 1 = kierunkowe, 2 = stożkowe)
+};
+
+#endif // LIGHT_HPP
@@ -0,0 +1,423 @@
+// LightCuller.cpp
+#include "LightCuller.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Math/Bounds.hpp"
+#include "../Math/Simd.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include "../Transform/TransformableObject.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <utility>
+
+/**
+ * @struct GpuLight
+ * @brief Układ światła w bloku uniformów "Lights" zgodny z std140
+ */
+struct GpuLight {
+    glm::vec4 positionType;         /**< Pozycja (xyz) i typ (w) */
+    glm::vec4 directionCutoff;      /**< Kierunek (xyz) i cos kąta wewnętrznego (w) */
+    glm::vec4 colorOuterCutoff;     /**< Kolor (xyz) i cos kąta zewnętrznego (w) */
+    glm::vec4 intensities;          /**< Ambient, diffuse, specular */
+    glm::vec4 attenuation;          /**< Stały, liniowy i kwadratowy współczynnik tłumienia */
+};
+
+/**
+ * @brief Liczba obiektów przetwarzanych w jednej porcji zadania
+ */
+static const size_t OBJECT_BATCH = 64;
+
+/**
+ * @brief Zwraca największą jasność światła (przy tłumieniu równym 1)
+ * @param light Światło
+ * @return Jasność najjaśniejszej składowej koloru
+ */
+static float computeStrength(const Light& light) {
+    float maxChannel = std::max(light.color.r, std::max(light.color.g, light.color.b));
+    return maxChannel * (light.ambientIntensity + light.diffuseIntensity + light.specularIntensity);
+}
+
+/**
+ * @brief Konstruktor LightCuller
+ */
+LightCuller::LightCuller()
+    : m_globalList(0, 0), m_threshold(1.0f / 256.0f), m_lightUBO(0), m_indexBuffer(0),
+      m_indexTexture(0), m_indexCapacity(0), m_initialized(false) {
+}
+
+/**
+ * @brief Destruktor LightCuller
+ */
+LightCuller::~LightCuller() {
+    release();
+}
+
+/**
+ * @brief Tworzy bufory OpenGL
+ * @return true jeśli inicjalizacja się powiodła
+ */
+bool LightCuller::initialize() {
+    if (m_initialized) return true;
+
+    glGenBuffers(1, &m_lightUBO);
+    glGenBuffers(1, &m_indexBuffer);
+    glGenTextures(1, &m_indexTexture);
+
+    if (m_lightUBO == 0 || m_indexBuffer == 0 || m_indexTexture == 0) {
+        std::cerr << "Blad: Nie udalo sie utworzyc buforow swiatel" << std::endl;
+        release();
+        return false;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_lightUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(GpuLight) * MAX_LIGHTS, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zwalnia bufory OpenGL
+ */
+void LightCuller::release() {
+    if (m_lightUBO) glDeleteBuffers(1, &m_lightUBO);
+    if (m_indexBuffer) glDeleteBuffers(1, &m_indexBuffer);
+    if (m_indexTexture) glDeleteTextures(1, &m_indexTexture);
+    m_lightUBO = 0;
+    m_indexBuffer = 0;
+    m_indexTexture = 0;
+    m_indexCapacity = 0;
+    m_initialized = false;
+}
+
+/**
+ * @brief Przygotowuje program shaderowy do pracy z listami świateł
+ * @param program Program shaderowy
+ */
+void LightCuller::setupProgram(GLuint program) {
+    GLuint blockIndex = glGetUniformBlockIndex(program, "Lights");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, blockIndex, LIGHTS_UBO_BINDING);
+    }
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "lightIndices"), LIGHT_INDEX_TEXTURE_UNIT);
+}
+
+/**
+ * @brief Kod GLSL oświetlenia bez definicji rozmiarów tablic
+ *
+ * Układ PackedLight i PackedMaterial odpowiada strukturom GPU z
+ * LightCuller i MaterialTable.
+ */
+static const char* lightingShaderSource = R"(
+struct PackedLight {
+    vec4 positionType;      // xyz = pozycja, w = typ
+    vec4 directionCutoff;   // xyz = kierunek, w = cutoff
+    vec4 colorOuterCutoff;  // xyz = kolor, w = outerCutoff
+    vec4 intensities;       // ambient, diffuse, specular
+    vec4 attenuation;       // constant, linear, quadratic
+};
+
+layout (std140) uniform Lights {
+    PackedLight lightData[MAX_LIGHTS];
+};
+
+uniform isamplerBuffer lightIndices;
+
+struct PackedMaterial {
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specularShininess; // xyz = specular, w = shininess
+};
+
+layout (std140) uniform Materials {
+    PackedMaterial materialData[MAX_MATERIALS];
+};
+
+// Model Phonga (dane światła i materiału w postaci spakowanej)
+vec3 calculatePhongLight(PackedLight light, PackedMaterial material, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir;
+    float attenuation = 1.0;
+    int type = int(light.positionType.w);
+
+    if (type == 1) {
+        lightDir = normalize(-light.directionCutoff.xyz);
+    } else {
+        lightDir = normalize(light.positionType.xyz - fragPos);
+        float distance = length(light.positionType.xyz - fragPos);
+        attenuation = 1.0 / (light.attenuation.x + light.attenuation.y * distance +
+                             light.attenuation.z * (distance * distance));
+
+        if (type == 2) {
+            float theta = dot(lightDir, normalize(-light.directionCutoff.xyz));
+            float epsilon = light.directionCutoff.w - light.colorOuterCutoff.w;
+            attenuation *= clamp((theta - light.colorOuterCutoff.w) / epsilon, 0.0, 1.0);
+        }
+    }
+
+    vec3 color = light.colorOuterCutoff.xyz;
+    vec3 ambient = light.intensities.x * color * material.ambient.rgb;
+    vec3 diffuse = light.intensities.y * max(dot(normal, lightDir), 0.0) * color * material.diffuse.rgb;
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.specularShininess.w);
+    vec3 specular = light.intensities.z * spec * color * material.specularShininess.rgb;
+    return (ambient + diffuse + specular) * attenuation;
+}
+)";
+
+/**
+ * @brief Zwraca kod GLSL oświetlenia wspólny dla oświetlanych shaderów
+ * @return Źródło do wstawienia zaraz po wierszu #version
+ *
+ * @details Rozmiary tablic pochodzą z MAX_LIGHTS i MaterialTable::MAX_MATERIALS,
+ * więc shadery nie mogą się rozjechać z buforami po stronie CPU. Źródło
+ * składane jest raz, przy pierwszym wywołaniu.
+ */
+const char* LightCuller::getShaderSource() {
+    static const std::string source =
+        "#define MAX_LIGHTS " + std::to_string(MAX_LIGHTS) + "\n" +
+        "#define MAX_MATERIALS " + std::to_string(MaterialTable::MAX_MATERIALS) + "\n" +
+        lightingShaderSource;
+    return source.c_str();
+}
+
+/**
+ * @brief Wyznacza zasięg światła z jego współczynników tłumienia
+ * @param light Światło
+ * @param threshold Próg jasności
+ * @return Promień zasięgu, -1 dla zasięgu nieskończonego
+ *
+ * @details Zasięg to odległość d, w której jasność / tłumienie spada do
+ * progu, czyli pierwiastek równania quadratic * d^2 + linear * d + constant = K,
+ * gdzie K = jasność / próg. Bez członów zależnych od odległości światło
+ * działa wszędzie.
+ */
+float LightCuller::computeEffectiveRadius(const Light& light, float threshold) {
+    if (light.type == 1) return -1.0f;
+
+    float limit = computeStrength(light) / std::max(threshold, 1e-6f);
+    float c = light.constant - limit;
+    if (c >= 0.0f) return 0.0f; // światło nigdzie nie przekracza progu
+
+    if (light.quadratic > 0.0f) {
+        float discriminant = light.linear * light.linear - 4.0f * light.quadratic * c;
+        return (-light.linear + std::sqrt(discriminant)) / (2.0f * light.quadratic);
+    }
+    if (light.linear > 0.0f) {
+        return -c / light.linear;
+    }
+    return -1.0f;
+}
+
+/**
+ * @brief Dzieli światła na globalne i lokalne (SoA)
+ */
+void LightCuller::classifyLights() {
+    m_lightStrength.resize(m_lights.size());
+    m_globalLights.clear();
+    m_localLights.clear();
+    m_localX.clear();
+    m_localY.clear();
+    m_localZ.clear();
+    m_localRadius.clear();
+
+    for (size_t i = 0; i < m_lights.size(); ++i) {
+        const Light& light = m_lights[i];
+        m_lightStrength[i] = computeStrength(light);
+
+        float radius = computeEffectiveRadius(light, m_threshold);
+        if (radius < 0.0f) {
+            m_globalLights.push_back(static_cast<uint32_t>(i));
+        } else if (radius > 0.0f) {
+            m_localLights.push_back(static_cast<uint32_t>(i));
+            m_localX.push_back(light.position.x);
+            m_localY.push_back(light.position.y);
+            m_localZ.push_back(light.position.z);
+            m_localRadius.push_back(radius);
+        }
+    }
+}
+
+/**
+ * @brief Wybiera światła dla obiektów (równolegle)
+ * @param objects Obiekty sceny
+ * @param maxLightsPerObject Limit świateł na obiekt
+ *
+ * @details Ważność światła to jego jasność podzielona przez tłumienie
+ * w najbliższym punkcie sfery obiektu. Gdy kandydatów jest więcej niż
+ * limit, nth_element wybiera najważniejsze bez pełnego sortowania.
+ * Każdy obiekt zapisuje wyłącznie własne miejsca w m_candidates, więc
+ * porcje nie wymagają synchronizacji.
+ */
+void LightCuller::assignLights(const std::vector<TransformableObject*>& objects, int maxLightsPerObject) {
+    m_candidates.resize(objects.size() * MAX_LIGHTS_PER_OBJECT);
+    m_candidateCounts.assign(objects.size(), 0);
+
+    ThreadPool::instance().parallelFor(objects.size(), OBJECT_BATCH, [&](size_t begin, size_t end) {
+        std::vector<uint32_t> hits(m_localLights.size());
+        std::vector<std::pair<float, uint32_t>> scored;
+        scored.reserve(m_globalLights.size() + m_localLights.size());
+
+        for (size_t i = begin; i < end; ++i) {
+            if (!objects[i]) continue;
+            BoundingSphere sphere = objects[i]->getWorldBounds();
+
+            scored.clear();
+            for (uint32_t lightIndex : m_globalLights) {
+                const Light& light = m_lights[lightIndex];
+                float attenuation = light.type == 1 ? 1.0f : std::max(light.constant, 1e-6f);
+                scored.emplace_back(m_lightStrength[lightIndex] / attenuation, lightIndex);
+            }
+
+            size_t hitCount = Simd::findOverlappingSpheres(
+                m_localX.data(), m_localY.data(), m_localZ.data(), m_localRadius.data(), m_localLights.size(),
+                sphere.center.x, sphere.center.y, sphere.center.z, sphere.radius, hits.data());
+
+            for (size_t h = 0; h < hitCount; ++h) {
+                uint32_t lightIndex = m_localLights[hits[h]];
+                const Light& light = m_lights[lightIndex];
+                float distance = std::max(glm::length(light.position - sphere.center) - sphere.radius, 0.0f);
+                float attenuation = light.constant + light.linear * distance + light.quadratic * distance * distance;
+                scored.emplace_back(m_lightStrength[lightIndex] / std::max(attenuation, 1e-6f), lightIndex);
+            }
+
+            size_t count = std::min(scored.size(), static_cast<size_t>(maxLightsPerObject));
+            if (scored.size() > count) {
+                std::nth_element(scored.begin(), scored.begin() + count, scored.end(),
+                                 [](const auto& a, const auto& b) { return a.first > b.first; });
+            }
+
+            uint32_t* slots = &m_candidates[i * MAX_LIGHTS_PER_OBJECT];
+            for (size_t c = 0; c < count; ++c) {
+                slots[c] = scored[c].second;
+            }
+            m_candidateCounts[i] = static_cast<int>(count);
+        }
+    });
+}
+
+/**
+ * @brief Składa zwarte listy i wysyła dane do GPU
+ * @param maxLightsPerObject Limit świateł na obiekt
+ *
+ * @details Na początku bufora indeksów leży lista globalna - najjaśniejsze
+ * światła niezależnie od położenia - a za nią listy kolejnych obiektów.
+ */
+void LightCuller::upload(int maxLightsPerObject) {
+    m_indices.clear();
+
+    std::vector<uint32_t> byStrength;
+    for (size_t i = 0; i < m_lights.size(); ++i) {
+        if (m_lightStrength[i] > 0.0f) byStrength.push_back(static_cast<uint32_t>(i));
+    }
+    std::sort(byStrength.begin(), byStrength.end(),
+              [this](uint32_t a, uint32_t b) { return m_lightStrength[a] > m_lightStrength[b]; });
+    size_t globalCount = std::min(byStrength.size(), static_cast<size_t>(maxLightsPerObject));
+    for (size_t i = 0; i < globalCount; ++i) {
+        m_indices.push_back(static_cast<int32_t>(byStrength[i]));
+    }
+    m_globalList = glm::ivec2(0, static_cast<int>(globalCount));
+
+    m_objectLists.resize(m_candidateCounts.size());
+    for (size_t i = 0; i < m_candidateCounts.size(); ++i) {
+        m_objectLists[i] = glm::ivec2(static_cast<int>(m_indices.size()), m_candidateCounts[i]);
+        const uint32_t* slots = &m_candidates[i * MAX_LIGHTS_PER_OBJECT];
+        for (int c = 0; c < m_candidateCounts[i]; ++c) {
+            m_indices.push_back(static_cast<int32_t>(slots[c]));
+        }
+    }
+
+    if (!m_initialized) return;
+
+    std::vector<GpuLight> gpuLights(m_lights.size());
+    for (size_t i = 0; i < m_lights.size(); ++i) {
+        const Light& light = m_lights[i];
+        gpuLights[i].positionType = glm::vec4(light.position, static_cast<float>(light.type));
+        gpuLights[i].directionCutoff = glm::vec4(light.direction, light.cutoff);
+        gpuLights[i].colorOuterCutoff = glm::vec4(light.color, light.outerCutoff);
+        gpuLights[i].intensities = glm::vec4(light.ambientIntensity, light.diffuseIntensity,
+                                             light.specularIntensity, 0.0f);
+        gpuLights[i].attenuation = glm::vec4(light.constant, light.linear, light.quadratic, 0.0f);
+    }
+    if (!gpuLights.empty()) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_lightUBO);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(gpuLights.size() * sizeof(GpuLight)),
+                        gpuLights.data());
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_indices.size() * sizeof(int32_t));
+    if (size == 0) return;
+
+    glBindBuffer(GL_TEXTURE_BUFFER, m_indexBuffer);
+    if (size > m_indexCapacity) {
+        m_indexCapacity = size * 2;
+        glBufferData(GL_TEXTURE_BUFFER, m_indexCapacity, nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_indexTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_R32I, m_indexBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    } else {
+        glBufferData(GL_TEXTURE_BUFFER, m_indexCapacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, m_indices.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+/**
+ * @brief Przydziela światła obiektom i wysyła dane klatki
+ * @param lights Aktywne światła (nadmiar ponad MAX_LIGHTS jest pomijany)
+ * @param objects Obiekty sceny (ta sama kolejność co w MultiViewRenderer::beginFrame)
+ * @param maxLightsPerObject Limit świateł na obiekt (przycinany do MAX_LIGHTS_PER_OBJECT)
+ */
+void LightCuller::update(const std::vector<Light>& lights, const std::vector<TransformableObject*>& objects,
+                         int maxLightsPerObject) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    size_t lightCount = std::min(lights.size(), static_cast<size_t>(MAX_LIGHTS));
+    m_lights.assign(lights.begin(), lights.begin() + lightCount);
+    maxLightsPerObject = std::clamp(maxLightsPerObject, 0, MAX_LIGHTS_PER_OBJECT);
+
+    classifyLights();
+    assignLights(objects, maxLightsPerObject);
+    upload(maxLightsPerObject);
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    size_t assigned = 0;
+    for (int count : m_candidateCounts) assigned += count;
+
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Swiatla/Swiatla", static_cast<double>(m_lights.size()));
+    stats.setValue("Swiatla/Globalne", static_cast<double>(m_globalLights.size()));
+    stats.setValue("Swiatla/Lokalne", static_cast<double>(m_localLights.size()));
+    stats.setValue("Swiatla/Przypisania", static_cast<double>(assigned));
+    stats.setValue("Swiatla/Srednio na obiekt",
+                   objects.empty() ? 0.0 : static_cast<double>(assigned) / static_cast<double>(objects.size()));
+    stats.setValue("Swiatla/Czas CPU [ms]", std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+/**
+ * @brief Wiąże blok świateł i bufor indeksów
+ */
+void LightCuller::bind() const {
+    if (!m_initialized) return;
+    glBindBufferBase(GL_UNIFORM_BUFFER, LIGHTS_UBO_BINDING, m_lightUBO);
+    glActiveTexture(GL_TEXTURE0 + LIGHT_INDEX_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_indexTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+ * @brief Zwraca listę świateł obiektu
+ * @param objectIndex Indeks obiektu z ostatniego update()
+ * @return (początek, długość) w buforze indeksów
+ */
+glm::ivec2 LightCuller::getObjectList(size_t objectIndex) const {
+    if (objectIndex >= m_objectLists.size()) return glm::ivec2(0, 0);
+    return m_objectLists[objectIndex];
+}
@@ -0,0 +1,162 @@
+// LightCuller.hpp
+#ifndef LIGHT_CULLER_HPP
+#define LIGHT_CULLER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Light.hpp"
+
+class TransformableObject;
+
+/**
+ * @class LightCuller
+ * @brief Przydział świateł do obiektów według zasięgu i ważności
+ *
+ * Dla każdego światła punktowego i stożkowego wyznaczany jest promień,
+ * poza którym jego wkład spada poniżej progu jasności. Sfery świateł
+ * testowane są równolegle (pula wątków + SIMD) ze sferami otaczającymi
+ * obiektów, a każdy obiekt otrzymuje listę co najwyżej N najważniejszych
+ * świateł. Światła kierunkowe działają wszędzie, więc trafiają do każdej listy.
+ *
+ * Dane dla shaderów:
+ * - blok uniformów "Lights" ze wszystkimi światłami, wysyłany raz na klatkę,
+ * - bufor tekstury "lightIndices" (R32I) ze zwartymi listami indeksów świateł,
+ * - para (początek, długość) listy każdego obiektu, przekazywana
+ *   w danych obiektów MultiViewRenderer.
+ *
+ * Lista pod indeksem 0 (getGlobalList()) przeznaczona jest dla obiektów
+ * rysowanych poza rendererem widoków.
+ */
+class LightCuller {
+public:
+    static const int MAX_LIGHTS = 64;               /**< Pojemność bloku "Lights" */
+    static const int MAX_LIGHTS_PER_OBJECT = 8;     /**< Najdłuższa lista świateł obiektu */
+    static const GLuint LIGHTS_UBO_BINDING = 1;     /**< Punkt wiązania bloku Lights */
+    static const int LIGHT_INDEX_TEXTURE_UNIT = 2;  /**< Jednostka teksturująca bufora indeksów */
+
+private:
+    std::vector<Light> m_lights;                /**< Światła bieżącej klatki */
+    std::vector<float> m_lightStrength;         /**< Największa jasność każdego światła */
+    std::vector<uint32_t> m_globalLights;       /**< Światła o nieskończonym zasięgu */
+    std::vector<uint32_t> m_localLights;        /**< Indeksy świateł lokalnych w m_lights */
+    std::vector<float> m_localX;                /**< Pozycje X świateł lokalnych (SoA) */
+    std::vector<float> m_localY;                /**< Pozycje Y świateł lokalnych (SoA) */
+    std::vector<float> m_localZ;                /**< Pozycje Z świateł lokalnych (SoA) */
+    std::vector<float> m_localRadius;           /**< Promienie zasięgu świateł lokalnych (SoA) */
+
+    std::vector<uint32_t> m_candidates;         /**< Wybrane światła, MAX_LIGHTS_PER_OBJECT miejsc na obiekt */
+    std::vector<int> m_candidateCounts;         /**< Liczba wybranych świateł obiektu */
+    std::vector<int32_t> m_indices;             /**< Zwarte listy indeksów świateł */
+    std::vector<glm::ivec2> m_objectLists;      /**< (początek, długość) listy każdego obiektu */
+    glm::ivec2 m_globalList;                    /**< Lista dla obiektów spoza renderera widoków */
+    float m_threshold;                          /**< Próg jasności wyznaczający zasięg */
+
+    GLuint m_lightUBO;              /**< Bufor uniformów ze światłami */
+    GLuint m_indexBuffer;           /**< Bufor z listami indeksów */
+    GLuint m_indexTexture;          /**< Tekstura buforowa nad m_indexBuffer */
+    GLsizeiptr m_indexCapacity;     /**< Pojemność bufora indeksów w bajtach */
+    bool m_initialized;             /**< Czy obiekty OpenGL zostały utworzone */
+
+    /**
+     * @brief Dzieli światła na globalne i lokalne (SoA)
+     */
+    void classifyLights();
+
+    /**
+     * @brief Wybiera światła dla obiektów (równolegle)
+     * @param objects Obiekty sceny
+     * @param maxLightsPerObject Limit świateł na obiekt
+     */
+    void assignLights(const std::vector<TransformableObject*>& objects, int maxLightsPerObject);
+
+    /**
+     * @brief Składa zwarte listy i wysyła dane do GPU
+     * @param maxLightsPerObject Limit świateł na obiekt
+     */
+    void upload(int maxLightsPerObject);
+
+public:
+    /**
+     * @brief Konstruktor LightCuller
+     */
+    LightCuller();
+
+    /**
+     * @brief Destruktor LightCuller
+     */
+    ~LightCuller();
+
+    /**
+     * @brief Tworzy bufory OpenGL
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia bufory OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Przygotowuje program shaderowy do pracy z listami świateł
+     * @param program Program shaderowy
+     *
+     * Wiąże blok "Lights" z LIGHTS_UBO_BINDING oraz sampler "lightIndices"
+     * z LIGHT_INDEX_TEXTURE_UNIT.
+     */
+    static void setupProgram(GLuint program);
+
+    /**
+     * @brief Zwraca kod GLSL oświetlenia wspólny dla oświetlanych shaderów
+     * @return Źródło do wstawienia zaraz po wierszu #version
+     *
+     * Zawiera bloki "Lights" i "Materials", sampler "lightIndices" oraz
+     * funkcję calculatePhongLight() modelu Phonga.
+     */
+    static const char* getShaderSource();
+
+    /**
+     * @brief Ustawia próg jasności wyznaczający zasięg świateł
+     * @param threshold Próg (domyślnie 1/256 - poniżej kwantu 8-bitowego koloru)
+     */
+    void setThreshold(float threshold) { m_threshold = threshold; }
+
+    /**
+     * @brief Wyznacza zasięg światła z jego współczynników tłumienia
+     * @param light Światło
+     * @param threshold Próg jasności
+     * @return Promień zasięgu, -1 dla zasięgu nieskończonego
+     */
+    static float computeEffectiveRadius(const Light& light, float threshold);
+
+    /**
+     * @brief Przydziela światła obiektom i wysyła dane klatki
+     * @param lights Aktywne światła (nadmiar ponad MAX_LIGHTS jest pomijany)
+     * @param objects Obiekty sceny (ta sama kolejność co w MultiViewRenderer::beginFrame)
+     * @param maxLightsPerObject Limit świateł na obiekt (przycinany do MAX_LIGHTS_PER_OBJECT)
+     */
+    void update(const std::vector<Light>& lights, const std::vector<TransformableObject*>& objects,
+                int maxLightsPerObject);
+
+    /**
+     * @brief Wiąże blok świateł i bufor indeksów
+     */
+    void bind() const;
+
+    /**
+     * @brief Zwraca listę świateł obiektu
+     * @param objectIndex Indeks obiektu z ostatniego update()
+     * @return (początek, długość) w buforze indeksów
+     */
+    glm::ivec2 getObjectList(size_t objectIndex) const;
+
+    /**
+     * @brief Zwraca listę dla obiektów rysowanych poza rendererem widoków
+     * @return (początek, długość) w buforze indeksów
+     */
+    glm::ivec2 getGlobalList() const { return m_globalList; }
+};
+
+#endif // LIGHT_CULLER_HPP
@@ -0,0 +1,277 @@
+// MaterialTable.cpp
+#include "MaterialTable.hpp"
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @struct GpuMaterial
+ * @brief Układ materiału w bloku uniformów "Materials" zgodny z std140
+ */
+struct GpuMaterial {
+    glm::vec4 ambient;              /**< Składowa otoczenia */
+    glm::vec4 diffuse;              /**< Składowa rozproszenia */
+    glm::vec4 specularShininess;    /**< Składowa odbicia (xyz) i połysk (w) */
+};
+
+/**
+ * @brief Konstruktor MaterialTable - tworzy materiał neutralny
+ */
+MaterialTable::MaterialTable() : m_ubo(0), m_initialized(false) {
+    Material neutral;
+    neutral.ambient = glm::vec3(1.0f);
+    neutral.diffuse = glm::vec3(1.0f);
+    neutral.specular = glm::vec3(1.0f);
+    neutral.shininess = 32.0f;
+    allocate(neutral);
+}
+
+/**
+ * @brief Destruktor MaterialTable
+ */
+MaterialTable::~MaterialTable() {
+    release();
+}
+
+/**
+ * @brief Zwraca globalną tabelę materiałów
+ * @return Referencja do tabeli
+ */
+MaterialTable& MaterialTable::instance() {
+    static MaterialTable table;
+    return table;
+}
+
+/**
+ * @brief Tworzy bufor OpenGL i wysyła materiały utworzone wcześniej
+ * @return true jeśli inicjalizacja się powiodła
+ *
+ * @details Obiekty sceny mogą tworzyć materiały przed inicjalizacją
+ * OpenGL - są one wysyłane tutaj jednym zapisem.
+ */
+bool MaterialTable::initialize() {
+    if (m_initialized) return true;
+
+    glGenBuffers(1, &m_ubo);
+    if (m_ubo == 0) {
+        std::cerr << "Blad: Nie udalo sie utworzyc bufora materialow" << std::endl;
+        return false;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(GpuMaterial) * MAX_MATERIALS, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    m_initialized = true;
+    upload(0, static_cast<int>(m_materials.size()));
+    return true;
+}
+
+/**
+ * @brief Zwalnia bufor OpenGL
+ */
+void MaterialTable::release() {
+    if (m_ubo) glDeleteBuffers(1, &m_ubo);
+    m_ubo = 0;
+    m_initialized = false;
+}
+
+/**
+ * @brief Wiąże blok "Materials" programu z MATERIALS_UBO_BINDING
+ * @param program Program shaderowy
+ */
+void MaterialTable::setupProgram(GLuint program) {
+    GLuint blockIndex = glGetUniformBlockIndex(program, "Materials");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, blockIndex, MATERIALS_UBO_BINDING);
+    }
+}
+
+/**
+ * @brief Tworzy materiał z koloru bazowego
+ * @param color Kolor bazowy
+ * @return Materiał (ambient = 20%, diffuse = 100%, specular = 50% koloru)
+ */
+Material MaterialTable::fromColor(const glm::vec3& color) {
+    Material material;
+    material.ambient = color * 0.2f;
+    material.diffuse = color;
+    material.specular = color * 0.5f;
+    material.shininess = 32.0f;
+    return material;
+}
+
+/**
+ * @brief Porównuje właściwości dwóch materiałów
+ * @param a Pierwszy materiał
+ * @param b Drugi materiał
+ * @return true jeśli materiały są identyczne
+ *
+ * @details Służy do wyszukiwania wspólnych wpisów tabeli oraz do grupowania
+ * obiektów według wartości materiału.
+ */
+bool MaterialTable::isSameMaterial(const Material& a, const Material& b) {
+    return a.ambient == b.ambient && a.diffuse == b.diffuse &&
+           a.specular == b.specular && a.shininess == b.shininess;
+}
+
+/**
+ * @brief Wysyła zakres wpisów do bufora
+ * @param first Pierwszy wpis
+ * @param count Liczba wpisów
+ */
+void MaterialTable::upload(MaterialId first, int count) {
+    if (!m_initialized || count <= 0) return;
+
+    std::vector<GpuMaterial> data(count);
+    for (int i = 0; i < count; ++i) {
+        const Material& material = m_materials[first + i];
+        data[i].ambient = glm::vec4(material.ambient, 0.0f);
+        data[i].diffuse = glm::vec4(material.diffuse, 0.0f);
+        data[i].specularShininess = glm::vec4(material.specular, material.shininess);
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(first * sizeof(GpuMaterial)),
+                    static_cast<GLsizeiptr>(count * sizeof(GpuMaterial)), data.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+/**
+ * @brief Szuka zajętego wpisu o podanych właściwościach
+ * @param material Właściwości materiału
+ * @return Identyfikator lub INVALID_MATERIAL gdy takiego wpisu nie ma
+ *
+ * @details Tabela ma co najwyżej MAX_MATERIALS wpisów, więc wystarcza
+ * przeszukanie liniowe.
+ */
+MaterialId MaterialTable::findMaterial(const Material& material) const {
+    for (size_t id = 0; id < m_materials.size(); ++id) {
+        if (m_refCounts[id] > 0 && isSameMaterial(m_materials[id], material)) {
+            return static_cast<MaterialId>(id);
+        }
+    }
+    return INVALID_MATERIAL;
+}
+
+/**
+ * @brief Zajmuje nowy wpis z jednym odwołaniem
+ * @param material Właściwości materiału
+ * @return Identyfikator
+ *
+ * @details Pełna tabela nie ma bezpiecznego zastępstwa: oddanie materiału
+ * neutralnego cicho wyświetlałoby obiekt w złym kolorze, a późniejsza zmiana
+ * jego materiału nie mogłaby się powieść. Dlatego brak miejsca kończy się
+ * wyjątkiem.
+ */
+MaterialId MaterialTable::allocate(const Material& material) {
+    MaterialId id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    } else if (static_cast<int>(m_materials.size()) < MAX_MATERIALS) {
+        id = static_cast<MaterialId>(m_materials.size());
+        m_materials.push_back(material);
+        m_refCounts.push_back(0);
+    } else {
+        std::cerr << "Blad: Przekroczono maksymalna liczbe roznych materialow (" << MAX_MATERIALS << ")"
+                  << std::endl;
+        throw std::length_error("MaterialTable: przekroczono MAX_MATERIALS");
+    }
+
+    m_refCounts[id] = 1;
+    m_materials[id] = material;
+    upload(id, 1);
+    return id;
+}
+
+/**
+ * @brief Sprawdza, czy identyfikator wskazuje zajęty wpis
+ * @param id Identyfikator
+ * @return true jeśli wpis jest zajęty
+ */
+bool MaterialTable::isUsed(MaterialId id) const {
+    return id >= 0 && id < static_cast<int>(m_materials.size()) && m_refCounts[id] > 0;
+}
+
+/**
+ * @brief Dodaje odwołanie do materiału (wspólny wpis dla identycznych materiałów)
+ * @param material Właściwości materiału
+ * @return Identyfikator, zwalniany przez releaseMaterial()
+ *
+ * @details Materiał neutralny należy do tabeli i nie liczy odwołań.
+ */
+MaterialId MaterialTable::createMaterial(const Material& material) {
+    MaterialId id = findMaterial(material);
+    if (id == INVALID_MATERIAL) return allocate(material);
+
+    if (id != DEFAULT_MATERIAL) ++m_refCounts[id];
+    return id;
+}
+
+/**
+ * @brief Zmienia materiał odwołania
+ * @param id Identyfikator dotychczasowego materiału (nieznany = brak)
+ * @param material Nowe właściwości
+ * @return Identyfikator nowego materiału, zastępujący id
+ *
+ * @details Jedyny właściciel wpisu nowego materiału, którego nie ma jeszcze
+ * w tabeli, zmienia wpis w miejscu (jeden mały zapis do bufora). W pozostałych
+ * przypadkach odwołanie przenoszone jest do innego wpisu, więc zmiana nie
+ * przemalowuje obiektów współdzielących dotychczasowy materiał.
+ */
+MaterialId MaterialTable::updateMaterial(MaterialId id, const Material& material) {
+    if (!isUsed(id)) return createMaterial(material);
+    if (isSameMaterial(m_materials[id], material)) return id;
+
+    MaterialId newId = findMaterial(material);
+    if (newId != INVALID_MATERIAL) {
+        if (newId != DEFAULT_MATERIAL) ++m_refCounts[newId];
+    } else if (id != DEFAULT_MATERIAL && m_refCounts[id] == 1) {
+        m_materials[id] = material;
+        upload(id, 1);
+        return id;
+    } else {
+        newId = allocate(material);
+    }
+
+    releaseMaterial(id);
+    return newId;
+}
+
+/**
+ * @brief Zwalnia odwołanie do materiału
+ * @param id Identyfikator
+ *
+ * @details Wpis wraca do puli po zwolnieniu ostatniego odwołania. Materiału
+ * neutralnego nie można zwolnić.
+ */
+void MaterialTable::releaseMaterial(MaterialId id) {
+    if (id <= DEFAULT_MATERIAL || !isUsed(id)) return;
+    if (--m_refCounts[id] == 0) m_freeIds.push_back(id);
+}
+
+/**
+ * @brief Zwraca materiał
+ * @param id Identyfikator
+ * @return Właściwości materiału (materiał neutralny dla nieznanego identyfikatora)
+ */
+const Material& MaterialTable::getMaterial(MaterialId id) const {
+    if (!isUsed(id)) return m_materials[DEFAULT_MATERIAL];
+    return m_materials[id];
+}
+
+/**
+ * @brief Zwraca liczbę zajętych wpisów
+ * @return Liczba materiałów
+ */
+int MaterialTable::getMaterialCount() const {
+    return static_cast<int>(m_materials.size() - m_freeIds.size());
+}
+
+/**
+ * @brief Wiąże bufor materiałów z MATERIALS_UBO_BINDING
+ */
+void MaterialTable::bind() const {
+    if (!m_initialized) return;
+    glBindBufferBase(GL_UNIFORM_BUFFER, MATERIALS_UBO_BINDING, m_ubo);
+}
@@ -0,0 +1,169 @@
+// MaterialTable.hpp
+#ifndef MATERIAL_TABLE_HPP
+#define MATERIAL_TABLE_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+
+/**
+ * @brief Identyfikator materiału (indeks w tabeli materiałów)
+ */
+typedef int MaterialId;
+
+/**
+ * @brief Wartość oznaczająca brak materiału
+ */
+static const MaterialId INVALID_MATERIAL = -1;
+
+/**
+ * @class MaterialTable
+ * @brief Tabela materiałów w buforze uniformów indeksowana identyfikatorem
+ *
+ * Wszystkie materiały leżą w jednym bloku uniformów "Materials", a obiekt
+ * przekazuje do shadera jedynie identyfikator (w danych obiektu
+ * MultiViewRenderer lub w uniformie "materialIndex"). Zmiana materiału lub
+ * koloru obiektu to zapis jednego wpisu (48 bajtów) przez glBufferSubData,
+ * a obiekty o różnych materiałach mogą być rysowane tym samym wywołaniem.
+ *
+ * Wpis DEFAULT_MATERIAL jest biały i ma wszystkie składowe równe 1, więc
+ * obiekty bez własnego materiału oświetlane są jak przed wprowadzeniem tabeli.
+ *
+ * Obiekty o identycznych właściwościach współdzielą jeden wpis z licznikiem
+ * odwołań, więc pojemność ogranicza liczbę różnych materiałów, a nie obiektów.
+ * Brak miejsca na nowy materiał jest błędem krytycznym (std::length_error).
+ */
+class MaterialTable {
+public:
+    static const int MAX_MATERIALS = 256;               /**< Pojemność bloku "Materials" */
+    static const GLuint MATERIALS_UBO_BINDING = 2;      /**< Punkt wiązania bloku Materials */
+    static const MaterialId DEFAULT_MATERIAL = 0;       /**< Materiał neutralny */
+
+private:
+    std::vector<Material> m_materials;      /**< Materiały (indeks = identyfikator) */
+    std::vector<int> m_refCounts;           /**< Liczba odwołań do wpisu (0 = wolny) */
+    std::vector<MaterialId> m_freeIds;      /**< Zwolnione wpisy do ponownego użycia */
+    GLuint m_ubo;                           /**< Bufor uniformów z materiałami */
+    bool m_initialized;                     /**< Czy bufor został utworzony */
+
+    /**
+     * @brief Wysyła zakres wpisów do bufora
+     * @param first Pierwszy wpis
+     * @param count Liczba wpisów
+     */
+    void upload(MaterialId first, int count);
+
+    /**
+     * @brief Szuka zajętego wpisu o podanych właściwościach
+     * @param material Właściwości materiału
+     * @return Identyfikator lub INVALID_MATERIAL gdy takiego wpisu nie ma
+     */
+    MaterialId findMaterial(const Material& material) const;
+
+    /**
+     * @brief Zajmuje nowy wpis z jednym odwołaniem
+     * @param material Właściwości materiału
+     * @return Identyfikator
+     */
+    MaterialId allocate(const Material& material);
+
+    /**
+     * @brief Sprawdza, czy identyfikator wskazuje zajęty wpis
+     * @param id Identyfikator
+     * @return true jeśli wpis jest zajęty
+     */
+    bool isUsed(MaterialId id) const;
+
+public:
+    /**
+     * @brief Konstruktor MaterialTable - tworzy materiał neutralny
+     */
+    MaterialTable();
+
+    /**
+     * @brief Destruktor MaterialTable
+     */
+    ~MaterialTable();
+
+    /**
+     * @brief Zwraca globalną tabelę materiałów
+     * @return Referencja do tabeli
+     */
+    static MaterialTable& instance();
+
+    /**
+     * @brief Tworzy bufor OpenGL i wysyła materiały utworzone wcześniej
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia bufor OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Wiąże blok "Materials" programu z MATERIALS_UBO_BINDING
+     * @param program Program shaderowy
+     */
+    static void setupProgram(GLuint program);
+
+    /**
+     * @brief Tworzy materiał z koloru bazowego
+     * @param color Kolor bazowy
+     * @return Materiał (ambient = 20%, diffuse = 100%, specular = 50% koloru)
+     */
+    static Material fromColor(const glm::vec3& color);
+
+    /**
+     * @brief Porównuje właściwości dwóch materiałów
+     * @param a Pierwszy materiał
+     * @param b Drugi materiał
+     * @return true jeśli materiały są identyczne
+     */
+    static bool isSameMaterial(const Material& a, const Material& b);
+
+    /**
+     * @brief Dodaje odwołanie do materiału (wspólny wpis dla identycznych materiałów)
+     * @param material Właściwości materiału
+     * @return Identyfikator, zwalniany przez releaseMaterial()
+     * @throws std::length_error gdy brak miejsca na nowy materiał
+     */
+    MaterialId createMaterial(const Material& material);
+
+    /**
+     * @brief Zmienia materiał odwołania
+     * @param id Identyfikator dotychczasowego materiału (nieznany = brak)
+     * @param material Nowe właściwości
+     * @return Identyfikator nowego materiału, zastępujący id
+     * @throws std::length_error gdy brak miejsca na nowy materiał
+     */
+    MaterialId updateMaterial(MaterialId id, const Material& material);
+
+    /**
+     * @brief Zwalnia odwołanie do materiału
+     * @param id Identyfikator
+     */
+    void releaseMaterial(MaterialId id);
+
+    /**
+     * @brief Zwraca materiał
+     * @param id Identyfikator
+     * @return Właściwości materiału (materiał neutralny dla nieznanego identyfikatora)
+     */
+    const Material& getMaterial(MaterialId id) const;
+
+    /**
+     * @brief Zwraca liczbę zajętych wpisów
+     * @return Liczba różnych materiałów
+     */
+    int getMaterialCount() const;
+
+    /**
+     * @brief Wiąże bufor materiałów z MATERIALS_UBO_BINDING
+     */
+    void bind() const;
+};
+
+#endif // MATERIAL_TABLE_HPP
@@ -0,0 +1,169 @@
+// Bounds.cpp
+#include "Bounds.hpp"
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Przekształca sferę macierzą modelu
+ * @param matrix Macierz transformacji
+ * @return Sfera w przestrzeni docelowej
+ *
+ * @details Przy skalowaniu niejednorodnym promień mnożony jest przez
+ * największą długość kolumny macierzy, więc wynik jest zachowawczy.
+ */
+BoundingSphere BoundingSphere::transformed(const glm::mat4& matrix) const {
+    BoundingSphere result;
+    result.center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+
+    float scaleX = glm::length(glm::vec3(matrix[0]));
+    float scaleY = glm::length(glm::vec3(matrix[1]));
+    float scaleZ = glm::length(glm::vec3(matrix[2]));
+    result.radius = radius * std::max(scaleX, std::max(scaleY, scaleZ));
+    return result;
+}
+
+/**
+ * @brief Tworzy pusty prostopadłościan
+ * @return Pusty AABB
+ */
+BoundingBox BoundingBox::empty() {
+    float big = std::numeric_limits<float>::max();
+    return {glm::vec3(big), glm::vec3(-big)};
+}
+
+/**
+ * @brief Rozszerza prostopadłościan o punkt
+ * @param point Punkt
+ */
+void BoundingBox::expand(const glm::vec3& point) {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+}
+
+/**
+ * @brief Rozszerza prostopadłościan o inny prostopadłościan
+ * @param other Drugi AABB
+ */
+void BoundingBox::expand(const BoundingBox& other) {
+    if (other.isEmpty()) return;
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+}
+
+/**
+ * @brief Sprawdza, czy prostopadłościan jest pusty
+ * @return true jeśli nie zawiera żadnego punktu
+ */
+bool BoundingBox::isEmpty() const {
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+/**
+ * @brief Sprawdza przecięcie ze sferą
+ * @param sphere Sfera
+ * @return true jeśli sfera przecina prostopadłościan
+ */
+bool BoundingBox::intersects(const BoundingSphere& sphere) const {
+    glm::vec3 closest = glm::clamp(sphere.center, min, max);
+    glm::vec3 delta = sphere.center - closest;
+    return glm::dot(delta, delta) <= sphere.radius * sphere.radius;
+}
+
+/**
+ * @brief Przekształca prostopadłościan macierzą
+ * @param matrix Macierz transformacji
+ * @return AABB obejmujący przekształcony prostopadłościan
+ *
+ * @details Metoda Arvo: środek przekształcany jest pełną macierzą,
+ * a połowa rozmiaru - wartościami bezwzględnymi jej części 3x3.
+ */
+BoundingBox BoundingBox::transformed(const glm::mat4& matrix) const {
+    if (isEmpty()) return *this;
+
+    glm::vec3 center = glm::vec3(matrix * glm::vec4(getCenter(), 1.0f));
+    glm::vec3 extents = getExtents();
+    glm::vec3 newExtents(0.0f);
+    for (int i = 0; i < 3; ++i) {
+        newExtents += glm::abs(glm::vec3(matrix[i])) * extents[i];
+    }
+    return {center - newExtents, center + newExtents};
+}
+
+/**
+ * @brief Wyznacza ostrosłup z macierzy widoku i projekcji
+ * @param viewProjection Iloczyn projection * view
+ * @return Ostrosłup widzenia z znormalizowanymi płaszczyznami
+ */
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection) {
+    const glm::mat4& m = viewProjection;
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0;  // lewa
+    frustum.planes[1] = row3 - row0;  // prawa
+    frustum.planes[2] = row3 + row1;  // dolna
+    frustum.planes[3] = row3 - row1;  // górna
+    frustum.planes[4] = row3 + row2;  // bliska
+    frustum.planes[5] = row3 - row2;  // daleka
+
+    for (auto& plane : frustum.planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane = plane / length;
+        }
+    }
+    return frustum;
+}
+
+/**
+ * @brief Sprawdza, czy sfera jest (przynajmniej częściowo) wewnątrz ostrosłupa
+ * @param sphere Sfera
+ * @return true jeśli sfera może być widoczna
+ */
+bool Frustum::intersects(const BoundingSphere& sphere) const {
+    for (const auto& plane : planes) {
+        if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sprawdza, czy prostopadłościan jest (przynajmniej częściowo) wewnątrz ostrosłupa
+ * @param box Prostopadłościan
+ * @return true jeśli prostopadłościan może być widoczny
+ *
+ * @details Dla każdej płaszczyzny testowany jest narożnik najbardziej
+ * wysunięty w kierunku jej normalnej.
+ */
+bool Frustum::intersects(const BoundingBox& box) const {
+    for (const auto& plane : planes) {
+        glm::vec3 positive(plane.x >= 0.0f ? box.max.x : box.min.x,
+                           plane.y >= 0.0f ? box.max.y : box.min.y,
+                           plane.z >= 0.0f ? box.max.z : box.min.z);
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Wyznacza AABB narożników ostrosłupa
+ * @param viewProjection Iloczyn projection * view
+ * @return AABB w przestrzeni świata
+ */
+BoundingBox Frustum::computeBounds(const glm::mat4& viewProjection) {
+    glm::mat4 inverse = glm::inverse(viewProjection);
+    BoundingBox bounds = BoundingBox::empty();
+    for (int i = 0; i < 8; ++i) {
+        glm::vec4 corner(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f);
+        glm::vec4 world = inverse * corner;
+        bounds.expand(glm::vec3(world) / world.w);
+    }
+    return bounds;
+}
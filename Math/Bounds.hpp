@@ -0,0 +1,121 @@
+// Bounds.hpp
+#ifndef BOUNDS_HPP
+#define BOUNDS_HPP
+
+#include <glm/glm.hpp>
+
+/**
+ * @struct BoundingSphere
+ * @brief Sfera otaczająca obiekt
+ */
+struct BoundingSphere {
+    glm::vec3 center;   /**< Środek sfery */
+    float radius;       /**< Promień sfery */
+
+    /**
+     * @brief Przekształca sferę macierzą modelu
+     * @param matrix Macierz transformacji
+     * @return Sfera w przestrzeni docelowej (promień skalowany największą skalą osi)
+     */
+    BoundingSphere transformed(const glm::mat4& matrix) const;
+};
+
+/**
+ * @struct BoundingBox
+ * @brief Prostopadłościan otaczający wyrównany do osi (AABB)
+ */
+struct BoundingBox {
+    glm::vec3 min;      /**< Minimalny narożnik */
+    glm::vec3 max;      /**< Maksymalny narożnik */
+
+    /**
+     * @brief Tworzy pusty prostopadłościan (gotowy do rozszerzania)
+     * @return Pusty AABB
+     */
+    static BoundingBox empty();
+
+    /**
+     * @brief Rozszerza prostopadłościan o punkt
+     * @param point Punkt
+     */
+    void expand(const glm::vec3& point);
+
+    /**
+     * @brief Rozszerza prostopadłościan o inny prostopadłościan
+     * @param other Drugi AABB
+     */
+    void expand(const BoundingBox& other);
+
+    /**
+     * @brief Sprawdza, czy prostopadłościan jest pusty
+     * @return true jeśli nie zawiera żadnego punktu
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Zwraca środek prostopadłościanu
+     * @return Środek
+     */
+    glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+
+    /**
+     * @brief Zwraca połowę rozmiaru prostopadłościanu
+     * @return Połowa rozmiaru w każdej osi
+     */
+    glm::vec3 getExtents() const { return (max - min) * 0.5f; }
+
+    /**
+     * @brief Sprawdza przecięcie ze sferą
+     * @param sphere Sfera
+     * @return true jeśli sfera przecina lub zawiera się w prostopadłościanie
+     */
+    bool intersects(const BoundingSphere& sphere) const;
+
+    /**
+     * @brief Przekształca prostopadłościan macierzą (wynik znów jest AABB)
+     * @param matrix Macierz transformacji
+     * @return AABB obejmujący przekształcony prostopadłościan
+     */
+    BoundingBox transformed(const glm::mat4& matrix) const;
+};
+
+/**
+ * @struct Frustum
+ * @brief Ostrosłup widzenia opisany sześcioma płaszczyznami
+ *
+ * Płaszczyzny wyznaczane są z macierzy projection * view metodą
+ * Gribba-Hartmanna. Normalne płaszczyzn skierowane są do wnętrza.
+ */
+struct Frustum {
+    glm::vec4 planes[6];    /**< Płaszczyzny: lewa, prawa, dolna, górna, bliska, daleka */
+
+    /**
+     * @brief Wyznacza ostrosłup z macierzy widoku i projekcji
+     * @param viewProjection Iloczyn projection * view
+     * @return Ostrosłup widzenia
+     */
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    /**
+     * @brief Sprawdza, czy sfera jest (przynajmniej częściowo) wewnątrz ostrosłupa
+     * @param sphere Sfera
+     * @return true jeśli sfera może być widoczna
+     */
+    bool intersects(const BoundingSphere& sphere) const;
+
+    /**
+     * @brief Sprawdza, czy prostopadłościan jest (przynajmniej częściowo) wewnątrz ostrosłupa
+     * @param box Prostopadłościan
+     * @return true jeśli prostopadłościan może być widoczny
+     */
+    bool intersects(const BoundingBox& box) const;
+
+    /**
+     * @brief Wyznacza AABB narożników ostrosłupa
+     * @param viewProjection Iloczyn projection * view
+     * @return AABB w przestrzeni świata
+     */
+    static BoundingBox computeBounds(const glm::mat4& viewProjection);
+};
+
+#endif // BOUNDS_HPP
@@ -0,0 +1,819 @@
+// Simd.hpp
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SILNIK_SIMD_SSE 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * @namespace Simd
+ * @brief Funkcje przetwarzające dane w układzie SoA po 4 elementy naraz
+ *
+ * Przy kompilacji z SSE2 (domyślnie na x86-64) używane są instrukcje
+ * wektorowe, w przeciwnym razie równoważna pętla skalarna. Tablice
+ * wejściowe nie muszą być wyrównane ani mieć długości podzielnej przez 4.
+ */
+namespace Simd {
+
+/**
+ * @brief Wyszukuje sfery nachodzące na sferę testową
+ * @param xs Współrzędne X środków sfer
+ * @param ys Współrzędne Y środków sfer
+ * @param zs Współrzędne Z środków sfer
+ * @param radii Promienie sfer
+ * @param count Liczba sfer
+ * @param cx Środek sfery testowej (X)
+ * @param cy Środek sfery testowej (Y)
+ * @param cz Środek sfery testowej (Z)
+ * @param radius Promień sfery testowej
+ * @param outIndices Tablica na indeksy trafionych sfer (co najmniej count elementów)
+ * @return Liczba trafionych sfer
+ */
+inline size_t findOverlappingSpheres(const float* xs, const float* ys, const float* zs, const float* radii,
+                                     size_t count, float cx, float cy, float cz, float radius,
+                                     uint32_t* outIndices) {
+    size_t hits = 0;
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 centerX = _mm_set1_ps(cx);
+    const __m128 centerY = _mm_set1_ps(cy);
+    const __m128 centerZ = _mm_set1_ps(cz);
+    const __m128 testRadius = _mm_set1_ps(radius);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), centerX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), centerY);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(zs + i), centerZ);
+        __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(radii + i), testRadius);
+        int mask = _mm_movemask_ps(_mm_cmple_ps(distanceSq, _mm_mul_ps(sum, sum)));
+        for (int lane = 0; mask != 0 && lane < 4; ++lane) {
+            if (mask & (1 << lane)) outIndices[hits++] = static_cast<uint32_t>(i + lane);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        float dx = xs[i] - cx;
+        float dy = ys[i] - cy;
+        float dz = zs[i] - cz;
+        float sum = radii[i] + radius;
+        if (dx * dx + dy * dy + dz * dz <= sum * sum) {
+            outIndices[hits++] = static_cast<uint32_t>(i);
+        }
+    }
+    return hits;
+}
+
+/**
+ * @brief Przekształca wierzchołki macierzą modelu i macierzą normalnych
+ * @param model Macierz modelu 4x4 (kolumnami, 16 liczb)
+ * @param normalMatrix Macierz normalnych 3x3 (kolumnami, 9 liczb)
+ * @param input Wierzchołki wejściowe
+ * @param output Wierzchołki wyjściowe (nie mogą nachodzić na wejściowe)
+ * @param count Liczba wierzchołków
+ * @param stride Liczba floatów na wierzchołek (co najmniej 8)
+ *
+ * Wierzchołek zaczyna się od pozycji (3 floaty) i normalnej (3 floaty),
+ * pozostałe floaty są kopiowane bez zmian. Normalne nie są normalizowane.
+ * W wersji SSE każdy wierzchołek liczony jest jako suma kolumn macierzy
+ * przemnożonych przez jego współrzędne; zapis 4 floatów wychodzi o jeden
+ * za pozycję i normalną, dlatego stride musi wynosić co najmniej 8.
+ */
+inline void transformVertices(const float* model, const float* normalMatrix,
+                              const float* input, float* output, size_t count, size_t stride) {
+#ifdef SILNIK_SIMD_SSE
+    const __m128 c0 = _mm_loadu_ps(model);
+    const __m128 c1 = _mm_loadu_ps(model + 4);
+    const __m128 c2 = _mm_loadu_ps(model + 8);
+    const __m128 c3 = _mm_loadu_ps(model + 12);
+    const __m128 n0 = _mm_set_ps(0.0f, normalMatrix[2], normalMatrix[1], normalMatrix[0]);
+    const __m128 n1 = _mm_set_ps(0.0f, normalMatrix[5], normalMatrix[4], normalMatrix[3]);
+    const __m128 n2 = _mm_set_ps(0.0f, normalMatrix[8], normalMatrix[7], normalMatrix[6]);
+    for (size_t i = 0; i < count; ++i) {
+        const float* in = input + i * stride;
+        float* out = output + i * stride;
+        __m128 position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(in[0])), _mm_mul_ps(c1, _mm_set1_ps(in[1]))),
+                                     _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(in[2])), c3));
+        __m128 normal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n0, _mm_set1_ps(in[3])), _mm_mul_ps(n1, _mm_set1_ps(in[4]))),
+                                   _mm_mul_ps(n2, _mm_set1_ps(in[5])));
+        _mm_storeu_ps(out, position);
+        _mm_storeu_ps(out + 3, normal);
+        for (size_t k = 6; k < stride; ++k) out[k] = in[k];
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        const float* in = input + i * stride;
+        float* out = output + i * stride;
+        for (int r = 0; r < 3; ++r) {
+            out[r] = model[r] * in[0] + model[4 + r] * in[1] + model[8 + r] * in[2] + model[12 + r];
+            out[3 + r] = normalMatrix[r] * in[3] + normalMatrix[3 + r] * in[4] + normalMatrix[6 + r] * in[5];
+        }
+        for (size_t k = 6; k < stride; ++k) out[k] = in[k];
+    }
+#endif
+}
+
+#ifdef SILNIK_SIMD_SSE
+/**
+ * @brief Zapisuje 4 wierzchołki podane w układzie SoA jako przeplatane
+ * @param output Pierwszy wierzchołek
+ * @param stride Liczba floatów na wierzchołek (co najmniej 8)
+ * @param px Pozycje X
+ * @param py Pozycje Y
+ * @param pz Pozycje Z
+ * @param nx Normalne X
+ * @param ny Normalne Y
+ * @param nz Normalne Z
+ * @param u Współrzędne U
+ * @param v Współrzędne V
+ *
+ * Dwie transpozycje 4x4 zamieniają kolumny atrybutów na dwie połówki
+ * każdego wierzchołka (pozycja + nx oraz ny, nz, UV).
+ */
+inline void storeInterleaved4(float* output, size_t stride, __m128 px, __m128 py, __m128 pz, __m128 nx,
+                              __m128 ny, __m128 nz, __m128 u, __m128 v) {
+    _MM_TRANSPOSE4_PS(px, py, pz, nx);
+    _MM_TRANSPOSE4_PS(ny, nz, u, v);
+    _mm_storeu_ps(output, px);
+    _mm_storeu_ps(output + 4, ny);
+    _mm_storeu_ps(output + stride, py);
+    _mm_storeu_ps(output + stride + 4, nz);
+    _mm_storeu_ps(output + 2 * stride, pz);
+    _mm_storeu_ps(output + 2 * stride + 4, u);
+    _mm_storeu_ps(output + 3 * stride, nx);
+    _mm_storeu_ps(output + 3 * stride + 4, v);
+}
+#endif
+
+/**
+ * @brief Generuje jedną warstwę wierzchołków sfery o promieniu 1
+ * @param cosTable Cosinusy kątów sektorów (count elementów)
+ * @param sinTable Sinusy kątów sektorów (count elementów)
+ * @param count Liczba wierzchołków warstwy
+ * @param ringRadius Promień okręgu warstwy (cosinus kąta warstwy)
+ * @param z Wysokość warstwy (sinus kąta warstwy)
+ * @param v Współrzędna tekstury V warstwy
+ * @param uDivisor Dzielnik indeksu wierzchołka dający współrzędną U
+ * @param output Wierzchołki wyjściowe (pozycja, normalna, UV)
+ * @param stride Liczba floatów na wierzchołek (co najmniej 8)
+ *
+ * Normalna równa jest pozycji. Wynik jest identyczny z wersją skalarną
+ * (te same działania w tej samej kolejności).
+ */
+inline void generateSphereRow(const float* cosTable, const float* sinTable, size_t count, float ringRadius,
+                              float z, float v, float uDivisor, float* output, size_t stride) {
+    size_t j = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 radius = _mm_set1_ps(ringRadius);
+    const __m128 height = _mm_set1_ps(z);
+    const __m128 texV = _mm_set1_ps(v);
+    const __m128 divisor = _mm_set1_ps(uDivisor);
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    for (; j + 4 <= count; j += 4) {
+        __m128 x = _mm_mul_ps(radius, _mm_loadu_ps(cosTable + j));
+        __m128 y = _mm_mul_ps(radius, _mm_loadu_ps(sinTable + j));
+        __m128 u = _mm_div_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(j)), lanes), divisor);
+        storeInterleaved4(output + j * stride, stride, x, y, height, x, y, height, u, texV);
+    }
+#endif
+    for (; j < count; ++j) {
+        float* out = output + j * stride;
+        out[0] = out[3] = ringRadius * cosTable[j];
+        out[1] = out[4] = ringRadius * sinTable[j];
+        out[2] = out[5] = z;
+        out[6] = static_cast<float>(j) / uDivisor;
+        out[7] = v;
+    }
+}
+
+/**
+ * @brief Generuje jeden pierścień wierzchołków torusa
+ * @param cosTable Cosinusy kątów sektorów rury (count elementów)
+ * @param sinTable Sinusy kątów sektorów rury (count elementów)
+ * @param count Liczba wierzchołków pierścienia
+ * @param cosRing Cosinus kąta pierścienia
+ * @param sinRing Sinus kąta pierścienia
+ * @param radius Główny promień
+ * @param tubeRadius Promień rury
+ * @param v Współrzędna tekstury V pierścienia
+ * @param uDivisor Dzielnik indeksu wierzchołka dający współrzędną U
+ * @param output Wierzchołki wyjściowe (pozycja, normalna, UV)
+ * @param stride Liczba floatów na wierzchołek (co najmniej 8)
+ */
+inline void generateTorusRow(const float* cosTable, const float* sinTable, size_t count, float cosRing,
+                             float sinRing, float radius, float tubeRadius, float v, float uDivisor,
+                             float* output, size_t stride) {
+    size_t j = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 ringCos = _mm_set1_ps(cosRing);
+    const __m128 ringSin = _mm_set1_ps(sinRing);
+    const __m128 mainRadius = _mm_set1_ps(radius);
+    const __m128 tube = _mm_set1_ps(tubeRadius);
+    const __m128 texV = _mm_set1_ps(v);
+    const __m128 divisor = _mm_set1_ps(uDivisor);
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    for (; j + 4 <= count; j += 4) {
+        __m128 cosSector = _mm_loadu_ps(cosTable + j);
+        __m128 sinSector = _mm_loadu_ps(sinTable + j);
+        __m128 ring = _mm_add_ps(mainRadius, _mm_mul_ps(tube, cosSector));
+        __m128 u = _mm_div_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(j)), lanes), divisor);
+        storeInterleaved4(output + j * stride, stride,
+                          _mm_mul_ps(ring, ringCos), _mm_mul_ps(ring, ringSin), _mm_mul_ps(tube, sinSector),
+                          _mm_mul_ps(ringCos, cosSector), _mm_mul_ps(ringSin, cosSector), sinSector, u, texV);
+    }
+#endif
+    for (; j < count; ++j) {
+        float* out = output + j * stride;
+        float ring = radius + tubeRadius * cosTable[j];
+        out[0] = ring * cosRing;
+        out[1] = ring * sinRing;
+        out[2] = tubeRadius * sinTable[j];
+        out[3] = cosRing * cosTable[j];
+        out[4] = sinRing * cosTable[j];
+        out[5] = sinTable[j];
+        out[6] = static_cast<float>(j) / uDivisor;
+        out[7] = v;
+    }
+}
+
+/**
+ * @brief Przesuwa cząsteczki o jeden krok czasu
+ * @param xs Pozycje X
+ * @param ys Pozycje Y
+ * @param zs Pozycje Z
+ * @param vxs Prędkości X
+ * @param vys Prędkości Y
+ * @param vzs Prędkości Z
+ * @param ages Wieki cząsteczek
+ * @param count Liczba cząsteczek
+ * @param dt Krok czasu
+ * @param gx Przyspieszenie X
+ * @param gy Przyspieszenie Y
+ * @param gz Przyspieszenie Z
+ * @param damping Mnożnik prędkości w kroku (opór powietrza)
+ * @param floorHeight Wysokość podłoża
+ * @param restitution Część prędkości pionowej zachowana po odbiciu od podłoża
+ *
+ * Całkowanie półjawne Eulera: najpierw prędkość, potem pozycja nową
+ * prędkością. Cząsteczka poniżej podłoża jest na nie podnoszona i odbija
+ * się z odwróconą prędkością pionową. Dane zmieniane są w miejscu.
+ */
+inline void integrateParticles(float* xs, float* ys, float* zs, float* vxs, float* vys, float* vzs, float* ages,
+                               size_t count, float dt, float gx, float gy, float gz, float damping,
+                               float floorHeight, float restitution) {
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 step = _mm_set1_ps(dt);
+    const __m128 accelerationX = _mm_set1_ps(gx * dt);
+    const __m128 accelerationY = _mm_set1_ps(gy * dt);
+    const __m128 accelerationZ = _mm_set1_ps(gz * dt);
+    const __m128 damp = _mm_set1_ps(damping);
+    const __m128 ground = _mm_set1_ps(floorHeight);
+    const __m128 bounce = _mm_set1_ps(-restitution);
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vxs + i), damp), accelerationX);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vys + i), damp), accelerationY);
+        __m128 vz = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vzs + i), damp), accelerationZ);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(xs + i), _mm_mul_ps(vx, step));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(ys + i), _mm_mul_ps(vy, step));
+        __m128 z = _mm_add_ps(_mm_loadu_ps(zs + i), _mm_mul_ps(vz, step));
+        __m128 below = _mm_cmplt_ps(y, ground);
+        vy = _mm_or_ps(_mm_and_ps(below, _mm_mul_ps(vy, bounce)), _mm_andnot_ps(below, vy));
+        y = _mm_max_ps(y, ground);
+        _mm_storeu_ps(xs + i, x);
+        _mm_storeu_ps(ys + i, y);
+        _mm_storeu_ps(zs + i, z);
+        _mm_storeu_ps(vxs + i, vx);
+        _mm_storeu_ps(vys + i, vy);
+        _mm_storeu_ps(vzs + i, vz);
+        _mm_storeu_ps(ages + i, _mm_add_ps(_mm_loadu_ps(ages + i), step));
+    }
+#endif
+    for (; i < count; ++i) {
+        vxs[i] = vxs[i] * damping + gx * dt;
+        vys[i] = vys[i] * damping + gy * dt;
+        vzs[i] = vzs[i] * damping + gz * dt;
+        xs[i] += vxs[i] * dt;
+        ys[i] += vys[i] * dt;
+        zs[i] += vzs[i] * dt;
+        if (ys[i] < floorHeight) {
+            ys[i] = floorHeight;
+            vys[i] *= -restitution;
+        }
+        ages[i] += dt;
+    }
+}
+
+/**
+ * @brief Wyszukuje cząsteczki, których wiek osiągnął czas życia
+ * @param ages Wieki cząsteczek
+ * @param lifetimes Czasy życia cząsteczek
+ * @param count Liczba cząsteczek
+ * @param outIndices Tablica na indeksy martwych cząsteczek (co najmniej count elementów)
+ * @return Liczba martwych cząsteczek
+ *
+ * Indeksy zapisywane są rosnąco.
+ */
+inline size_t findExpiredParticles(const float* ages, const float* lifetimes, size_t count, uint32_t* outIndices) {
+    size_t expired = 0;
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    for (; i + 4 <= count; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(ages + i), _mm_loadu_ps(lifetimes + i)));
+        for (int lane = 0; mask != 0 && lane < 4; ++lane) {
+            if (mask & (1 << lane)) outIndices[expired++] = static_cast<uint32_t>(i + lane);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (ages[i] >= lifetimes[i]) outIndices[expired++] = static_cast<uint32_t>(i);
+    }
+    return expired;
+}
+
+/**
+ * @brief Zapisuje dane instancji cząsteczek do wysłania na GPU
+ * @param xs Pozycje X
+ * @param ys Pozycje Y
+ * @param zs Pozycje Z
+ * @param ages Wieki cząsteczek
+ * @param lifetimes Czasy życia cząsteczek
+ * @param count Liczba cząsteczek
+ * @param output Cztery floaty na cząsteczkę: pozycja i wiek / czas życia
+ *
+ * Transpozycja 4x4 zamienia cztery kolumny SoA na cztery kolejne
+ * instancje.
+ */
+inline void storeParticleInstances(const float* xs, const float* ys, const float* zs, const float* ages,
+                                   const float* lifetimes, size_t count, float* output) {
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 z = _mm_loadu_ps(zs + i);
+        __m128 life = _mm_div_ps(_mm_loadu_ps(ages + i), _mm_loadu_ps(lifetimes + i));
+        _MM_TRANSPOSE4_PS(x, y, z, life);
+        _mm_storeu_ps(output + i * 4, x);
+        _mm_storeu_ps(output + i * 4 + 4, y);
+        _mm_storeu_ps(output + i * 4 + 8, z);
+        _mm_storeu_ps(output + i * 4 + 12, life);
+    }
+#endif
+    for (; i < count; ++i) {
+        output[i * 4] = xs[i];
+        output[i * 4 + 1] = ys[i];
+        output[i * 4 + 2] = zs[i];
+        output[i * 4 + 3] = ages[i] / lifetimes[i];
+    }
+}
+
+/**
+ * @brief Interpoluje liniowo dwie tablice
+ * @param a Wartości dla t = 0
+ * @param b Wartości dla t = 1
+ * @param t Współczynnik interpolacji
+ * @param output Wynik (może być jedną z tablic wejściowych)
+ * @param count Liczba elementów
+ */
+inline void lerpArrays(const float* a, const float* b, float t, float* output, size_t count) {
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 factor = _mm_set1_ps(t);
+    for (; i + 4 <= count; i += 4) {
+        __m128 va = _mm_loadu_ps(a + i);
+        _mm_storeu_ps(output + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + i), va), factor)));
+    }
+#endif
+    for (; i < count; ++i) {
+        output[i] = a[i] + (b[i] - a[i]) * t;
+    }
+}
+
+/**
+ * @brief Normalizuje kwaterniony zapisane w układzie SoA
+ * @param xs Składowe X
+ * @param ys Składowe Y
+ * @param zs Składowe Z
+ * @param ws Składowe W
+ * @param count Liczba kwaternionów
+ *
+ * Razem z lerpArrays daje nlerp: wystarczający między sąsiednimi
+ * klatkami, o ile kwaterniony leżą w tej samej półsferze.
+ */
+inline void normalizeQuaternions(float* xs, float* ys, float* zs, float* ws, size_t count) {
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 epsilon = _mm_set1_ps(1e-12f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 z = _mm_loadu_ps(zs + i);
+        __m128 w = _mm_loadu_ps(ws + i);
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                          _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+        __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSquared, epsilon)));
+        _mm_storeu_ps(xs + i, _mm_mul_ps(x, inverse));
+        _mm_storeu_ps(ys + i, _mm_mul_ps(y, inverse));
+        _mm_storeu_ps(zs + i, _mm_mul_ps(z, inverse));
+        _mm_storeu_ps(ws + i, _mm_mul_ps(w, inverse));
+    }
+#endif
+    for (; i < count; ++i) {
+        float lengthSquared = xs[i] * xs[i] + ys[i] * ys[i] + zs[i] * zs[i] + ws[i] * ws[i];
+        float inverse = 1.0f / std::sqrt(lengthSquared > 1e-12f ? lengthSquared : 1e-12f);
+        xs[i] *= inverse;
+        ys[i] *= inverse;
+        zs[i] *= inverse;
+        ws[i] *= inverse;
+    }
+}
+
+/**
+ * @brief Składa macierze 4x4 z przesunięć, obrotów i skal w układzie SoA
+ * @param translations Przesunięcia: trzy tablice (X, Y, Z)
+ * @param rotations Obroty (kwaterniony jednostkowe): cztery tablice (X, Y, Z, W)
+ * @param scales Skale: trzy tablice (X, Y, Z)
+ * @param count Liczba przekształceń
+ * @param output Macierze T * R * S, kolumnami (16 floatów na macierz)
+ *
+ * Elementy macierzy obrotu liczone są dla czterech przekształceń naraz,
+ * a transpozycja 4x4 zamienia je na kolumny kolejnych macierzy.
+ */
+inline void composeTransforms(const float* const translations[3], const float* const rotations[4],
+                              const float* const scales[3], size_t count, float* output) {
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(rotations[0] + i);
+        __m128 y = _mm_loadu_ps(rotations[1] + i);
+        __m128 z = _mm_loadu_ps(rotations[2] + i);
+        __m128 w = _mm_loadu_ps(rotations[3] + i);
+        __m128 x2 = _mm_mul_ps(x, two), y2 = _mm_mul_ps(y, two), z2 = _mm_mul_ps(z, two);
+        __m128 xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+        __m128 xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+        __m128 wx = _mm_mul_ps(w, x2), wy = _mm_mul_ps(w, y2), wz = _mm_mul_ps(w, z2);
+        __m128 sx = _mm_loadu_ps(scales[0] + i);
+        __m128 sy = _mm_loadu_ps(scales[1] + i);
+        __m128 sz = _mm_loadu_ps(scales[2] + i);
+
+        __m128 columns[4][4] = {
+            {_mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx), _mm_mul_ps(_mm_add_ps(xy, wz), sx),
+             _mm_mul_ps(_mm_sub_ps(xz, wy), sx), _mm_setzero_ps()},
+            {_mm_mul_ps(_mm_sub_ps(xy, wz), sy), _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy),
+             _mm_mul_ps(_mm_add_ps(yz, wx), sy), _mm_setzero_ps()},
+            {_mm_mul_ps(_mm_add_ps(xz, wy), sz), _mm_mul_ps(_mm_sub_ps(yz, wx), sz),
+             _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz), _mm_setzero_ps()},
+            {_mm_loadu_ps(translations[0] + i), _mm_loadu_ps(translations[1] + i),
+             _mm_loadu_ps(translations[2] + i), one}};
+        for (int c = 0; c < 4; ++c) {
+            _MM_TRANSPOSE4_PS(columns[c][0], columns[c][1], columns[c][2], columns[c][3]);
+            for (int lane = 0; lane < 4; ++lane) {
+                _mm_storeu_ps(output + (i + lane) * 16 + c * 4, columns[c][lane]);
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        float x = rotations[0][i], y = rotations[1][i], z = rotations[2][i], w = rotations[3][i];
+        float sx = scales[0][i], sy = scales[1][i], sz = scales[2][i];
+        float* m = output + i * 16;
+        m[0] = (1.0f - 2.0f * (y * y + z * z)) * sx;
+        m[1] = 2.0f * (x * y + w * z) * sx;
+        m[2] = 2.0f * (x * z - w * y) * sx;
+        m[3] = 0.0f;
+        m[4] = 2.0f * (x * y - w * z) * sy;
+        m[5] = (1.0f - 2.0f * (x * x + z * z)) * sy;
+        m[6] = 2.0f * (y * z + w * x) * sy;
+        m[7] = 0.0f;
+        m[8] = 2.0f * (x * z + w * y) * sz;
+        m[9] = 2.0f * (y * z - w * x) * sz;
+        m[10] = (1.0f - 2.0f * (x * x + y * y)) * sz;
+        m[11] = 0.0f;
+        m[12] = translations[0][i];
+        m[13] = translations[1][i];
+        m[14] = translations[2][i];
+        m[15] = 1.0f;
+    }
+}
+
+/**
+ * @brief Mnoży dwie macierze 4x4
+ * @param a Lewa macierz (kolumnami)
+ * @param b Prawa macierz (kolumnami)
+ * @param output Iloczyn a * b (może być tą samą tablicą co b, ale nie a)
+ */
+inline void multiplyMatrices(const float* a, const float* b, float* output) {
+#ifdef SILNIK_SIMD_SSE
+    const __m128 a0 = _mm_loadu_ps(a);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+    for (int c = 0; c < 4; ++c) {
+        const float* column = b + c * 4;
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(column[0])), _mm_mul_ps(a1, _mm_set1_ps(column[1]))),
+                                   _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(column[2])), _mm_mul_ps(a3, _mm_set1_ps(column[3]))));
+        _mm_storeu_ps(output + c * 4, result);
+    }
+#else
+    for (int c = 0; c < 4; ++c) {
+        float column[4] = {b[c * 4], b[c * 4 + 1], b[c * 4 + 2], b[c * 4 + 3]};
+        for (int r = 0; r < 4; ++r) {
+            output[c * 4 + r] = a[r] * column[0] + a[4 + r] * column[1] + a[8 + r] * column[2] + a[12 + r] * column[3];
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Zapisuje trzy pierwsze wiersze macierzy 4x4
+ * @param matrix Macierz (kolumnami, ostatni wiersz 0, 0, 0, 1)
+ * @param rows Wynik: 12 floatów, wiersz po wierszu
+ *
+ * Układ wierszy pozwala przekształcić punkt trzema iloczynami
+ * skalarnymi i zajmuje trzy teksele RGBA zamiast czterech.
+ */
+inline void storeAffineRows(const float* matrix, float* rows) {
+#ifdef SILNIK_SIMD_SSE
+    __m128 c0 = _mm_loadu_ps(matrix);
+    __m128 c1 = _mm_loadu_ps(matrix + 4);
+    __m128 c2 = _mm_loadu_ps(matrix + 8);
+    __m128 c3 = _mm_loadu_ps(matrix + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(rows, c0);
+    _mm_storeu_ps(rows + 4, c1);
+    _mm_storeu_ps(rows + 8, c2);
+#else
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 4; ++c) rows[r * 4 + c] = matrix[c * 4 + r];
+    }
+#endif
+}
+
+/**
+ * @brief Przekształca wierzchołki ważoną sumą macierzy kości (skinning)
+ * @param boneRows Macierze kości w układzie storeAffineRows (12 floatów na kość)
+ * @param input Wierzchołki wejściowe
+ * @param inputStride Liczba floatów na wierzchołek wejściowy (co najmniej 10)
+ * @param output Wierzchołki wyjściowe w układzie Vertex (nie mogą nachodzić na wejściowe)
+ * @param outputStride Liczba floatów na wierzchołek wyjściowy (co najmniej 8)
+ * @param count Liczba wierzchołków
+ *
+ * Wierzchołek wejściowy to pozycja, normalna i współrzędne tekstury
+ * (8 floatów), po których leżą 4 bajty indeksów kości i 4 bajty wag
+ * (suma 255). Współrzędne tekstury są kopiowane, normalne nie są
+ * normalizowane. Dla każdego wierzchołka wiersze czterech macierzy
+ * sumowane są z wagami, a transpozycja daje kolumny do przekształcenia
+ * pozycji i normalnej jak w transformVertices.
+ */
+inline void skinVertices(const float* boneRows, const float* input, size_t inputStride, float* output,
+                         size_t outputStride, size_t count) {
+    const float weightScale = 1.0f / 255.0f;
+    for (size_t v = 0; v < count; ++v) {
+        const float* in = input + v * inputStride;
+        float* out = output + v * outputStride;
+        const uint8_t* bones = reinterpret_cast<const uint8_t*>(in + 8);
+        const uint8_t* weights = bones + 4;
+#ifdef SILNIK_SIMD_SSE
+        __m128 r0 = _mm_setzero_ps(), r1 = _mm_setzero_ps(), r2 = _mm_setzero_ps();
+        for (int k = 0; k < 4; ++k) {
+            if (weights[k] == 0) continue;
+            const float* bone = boneRows + bones[k] * 12;
+            __m128 weight = _mm_set1_ps(weights[k] * weightScale);
+            r0 = _mm_add_ps(r0, _mm_mul_ps(_mm_loadu_ps(bone), weight));
+            r1 = _mm_add_ps(r1, _mm_mul_ps(_mm_loadu_ps(bone + 4), weight));
+            r2 = _mm_add_ps(r2, _mm_mul_ps(_mm_loadu_ps(bone + 8), weight));
+        }
+        __m128 r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        __m128 position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_set1_ps(in[0])), _mm_mul_ps(r1, _mm_set1_ps(in[1]))),
+                                     _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(in[2])), r3));
+        __m128 normal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_set1_ps(in[3])), _mm_mul_ps(r1, _mm_set1_ps(in[4]))),
+                                   _mm_mul_ps(r2, _mm_set1_ps(in[5])));
+        _mm_storeu_ps(out, position);
+        _mm_storeu_ps(out + 3, normal);
+#else
+        float rows[12] = {};
+        for (int k = 0; k < 4; ++k) {
+            if (weights[k] == 0) continue;
+            const float* bone = boneRows + bones[k] * 12;
+            float weight = weights[k] * weightScale;
+            for (int e = 0; e < 12; ++e) rows[e] += bone[e] * weight;
+        }
+        for (int r = 0; r < 3; ++r) {
+            const float* row = rows + r * 4;
+            out[r] = row[0] * in[0] + row[1] * in[1] + row[2] * in[2] + row[3];
+            out[3 + r] = row[0] * in[3] + row[1] * in[4] + row[2] * in[5];
+        }
+#endif
+        out[6] = in[6];
+        out[7] = in[7];
+    }
+}
+
+/**
+ * @brief Kompresuje kwaternion jednostkowy do trzech słów 16-bitowych
+ * @param x Składowa X
+ * @param y Składowa Y
+ * @param z Składowa Z
+ * @param w Składowa W
+ * @param packed Wynik: słowa A, B i C
+ *
+ * Zapis "najmniejszych trzech": składowa o największym module jest
+ * pomijana (kwaternion jest wcześniej odwracany tak, by była dodatnia,
+ * i odtwarzana z normy), a pozostałe trzy, z przedziału
+ * [-1/sqrt(2), 1/sqrt(2)], zajmują po 15 bitów słów A, B i C
+ * w kolejności składowych. Najstarsze bity słów A i B to indeks
+ * pominiętej składowej. Błąd składowej nie przekracza 2.2e-5.
+ */
+inline void encodeQuaternion(float x, float y, float z, float w, uint16_t packed[3]) {
+    float components[4] = {x, y, z, w};
+    int largest = 0;
+    for (int c = 1; c < 4; ++c) {
+        if (std::fabs(components[c]) > std::fabs(components[largest])) largest = c;
+    }
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    int word = 0;
+    for (int c = 0; c < 4; ++c) {
+        if (c == largest) continue;
+        float value = (components[c] * sign + 0.70710678f) * (32767.0f / 1.41421356f);
+        value = value < 0.0f ? 0.0f : (value > 32767.0f ? 32767.0f : value);
+        packed[word++] = static_cast<uint16_t>(value + 0.5f);
+    }
+    packed[0] = static_cast<uint16_t>(packed[0] | ((largest & 1) << 15));
+    packed[1] = static_cast<uint16_t>(packed[1] | ((largest >> 1) << 15));
+}
+
+#ifdef SILNIK_SIMD_SSE
+/**
+ * @brief Wybiera składowe według maski
+ * @param mask Maska porównania (same jedynki albo same zera w każdej składowej)
+ * @param a Wartości dla jedynek
+ * @param b Wartości dla zer
+ * @return mask ? a : b
+ */
+inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+/**
+ * @brief Dekoduje kwaterniony zapisane przez encodeQuaternion do układu SoA
+ * @param packed Trzy tablice słów (A, B, C)
+ * @param count Liczba kwaternionów
+ * @param output Cztery tablice wyniku (X, Y, Z, W)
+ *
+ * Pominięta składowa wstawiana jest maskami porównań indeksu, bez
+ * rozgałęzień, więc cztery kwaterniony o różnych indeksach dekodowane
+ * są razem.
+ */
+inline void decodeQuaternions(const uint16_t* const packed[3], size_t count, float* const output[4]) {
+    const float scale = 1.41421356f / 32767.0f;
+    const float offset = 0.70710678f;
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i valueMask = _mm_set1_epi32(0x7FFF);
+    const __m128 valueScale = _mm_set1_ps(scale);
+    const __m128 valueOffset = _mm_set1_ps(offset);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128i a = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(packed[0] + i)), zero);
+        __m128i b = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(packed[1] + i)), zero);
+        __m128i c = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(packed[2] + i)), zero);
+        __m128i index = _mm_or_si128(_mm_srli_epi32(a, 15), _mm_slli_epi32(_mm_srli_epi32(b, 15), 1));
+        __m128 va = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(a, valueMask)), valueScale), valueOffset);
+        __m128 vb = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(b, valueMask)), valueScale), valueOffset);
+        __m128 vc = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), valueScale), valueOffset);
+        __m128 rest = _mm_sub_ps(one, _mm_add_ps(_mm_add_ps(_mm_mul_ps(va, va), _mm_mul_ps(vb, vb)), _mm_mul_ps(vc, vc)));
+        __m128 largest = _mm_sqrt_ps(_mm_max_ps(rest, _mm_setzero_ps()));
+        __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, zero));
+        __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+        __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)));
+        __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)));
+        _mm_storeu_ps(output[0] + i, select4(is0, largest, va));
+        _mm_storeu_ps(output[1] + i, select4(is1, largest, select4(is0, va, vb)));
+        _mm_storeu_ps(output[2] + i, select4(is2, largest, select4(is3, vc, vb)));
+        _mm_storeu_ps(output[3] + i, select4(is3, largest, vc));
+    }
+#endif
+    for (; i < count; ++i) {
+        int largest = (packed[0][i] >> 15) | ((packed[1][i] >> 15) << 1);
+        float values[3];
+        for (int word = 0; word < 3; ++word) {
+            values[word] = static_cast<float>(packed[word][i] & 0x7FFF) * scale - offset;
+        }
+        float rest = 1.0f - values[0] * values[0] - values[1] * values[1] - values[2] * values[2];
+        int word = 0;
+        for (int c = 0; c < 4; ++c) {
+            output[c][i] = c == largest ? std::sqrt(rest > 0.0f ? rest : 0.0f) : values[word++];
+        }
+    }
+}
+
+/**
+ * @brief Interpoluje wektory kluczy i dodaje je z wagą do wyniku
+ * @param from Wartości kluczy początkowych: trzy tablice (X, Y, Z)
+ * @param to Wartości kluczy końcowych: trzy tablice (X, Y, Z)
+ * @param factors Współczynniki interpolacji
+ * @param weight Waga wyniku
+ * @param accumulate false: wynik jest zastępowany, true: dodawany do obecnego
+ * @param output Trzy tablice wyniku (X, Y, Z)
+ * @param count Liczba wektorów
+ */
+inline void blendKeyVectors(const float* const from[3], const float* const to[3], const float* factors, float weight,
+                            bool accumulate, float* const output[3], size_t count) {
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 w = _mm_set1_ps(weight);
+    const __m128 keep = accumulate ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 factor = _mm_loadu_ps(factors + i);
+        for (int c = 0; c < 3; ++c) {
+            __m128 a = _mm_loadu_ps(from[c] + i);
+            __m128 value = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(to[c] + i), a), factor));
+            __m128 previous = _mm_and_ps(_mm_loadu_ps(output[c] + i), keep);
+            _mm_storeu_ps(output[c] + i, _mm_add_ps(previous, _mm_mul_ps(value, w)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            float value = (from[c][i] + (to[c][i] - from[c][i]) * factors[i]) * weight;
+            output[c][i] = accumulate ? output[c][i] + value : value;
+        }
+    }
+}
+
+/**
+ * @brief Interpoluje kwaterniony kluczy i dodaje je z wagą do wyniku
+ * @param from Kwaterniony kluczy początkowych: cztery tablice (X, Y, Z, W)
+ * @param to Kwaterniony kluczy końcowych: cztery tablice (X, Y, Z, W)
+ * @param factors Współczynniki interpolacji
+ * @param weight Waga wyniku
+ * @param accumulate false: wynik jest zastępowany, true: dodawany do obecnego
+ * @param output Cztery tablice wyniku (X, Y, Z, W), nieznormalizowane
+ * @param count Liczba kwaternionów
+ *
+ * Klucz końcowy odwracany jest do półsfery początkowego, a przy dodawaniu
+ * próbka do półsfery dotychczasowej sumy, więc interpolacja i mieszanie
+ * wybierają krótszą drogę. Po zsumowaniu wszystkich warstw wynik należy
+ * znormalizować (normalizeQuaternions), co razem daje nlerp.
+ */
+inline void blendKeyQuaternions(const float* const from[4], const float* const to[4], const float* factors,
+                                float weight, bool accumulate, float* const output[4], size_t count) {
+    size_t i = 0;
+#ifdef SILNIK_SIMD_SSE
+    const __m128 w = _mm_set1_ps(weight);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 keep = accumulate ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 a[4], b[4], previous[4];
+        for (int c = 0; c < 4; ++c) {
+            a[c] = _mm_loadu_ps(from[c] + i);
+            b[c] = _mm_loadu_ps(to[c] + i);
+            previous[c] = _mm_and_ps(_mm_loadu_ps(output[c] + i), keep);
+        }
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])),
+                                _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), signBit);
+        __m128 factor = _mm_loadu_ps(factors + i);
+        __m128 value[4];
+        for (int c = 0; c < 4; ++c) {
+            value[c] = _mm_add_ps(a[c], _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(b[c], flip), a[c]), factor));
+        }
+        dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(value[0], previous[0]), _mm_mul_ps(value[1], previous[1])),
+                         _mm_add_ps(_mm_mul_ps(value[2], previous[2]), _mm_mul_ps(value[3], previous[3])));
+        __m128 signedWeight = _mm_xor_ps(w, _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), signBit));
+        for (int c = 0; c < 4; ++c) {
+            _mm_storeu_ps(output[c] + i, _mm_add_ps(previous[c], _mm_mul_ps(value[c], signedWeight)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        float dot = 0.0f;
+        for (int c = 0; c < 4; ++c) dot += from[c][i] * to[c][i];
+        float flip = dot < 0.0f ? -1.0f : 1.0f;
+        float value[4];
+        float previousDot = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            value[c] = from[c][i] + (to[c][i] * flip - from[c][i]) * factors[i];
+            if (accumulate) previousDot += value[c] * output[c][i];
+        }
+        float signedWeight = previousDot < 0.0f ? -weight : weight;
+        for (int c = 0; c < 4; ++c) {
+            output[c][i] = (accumulate ? output[c][i] : 0.0f) + value[c] * signedWeight;
+        }
+    }
+}
+
+} // namespace Simd
+
+#endif // SIMD_HPP
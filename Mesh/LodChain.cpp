@@ -0,0 +1,105 @@
+// LodChain.cpp
+#include "LodChain.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Buduje poziomy uproszczone siatki
+ * @param mesh Siatka pełna (poziom 0, nie jest kopiowana do wyniku)
+ * @param settings Parametry łańcucha
+ * @return Poziomy 1..n od najdokładniejszego
+ *
+ * @details Cel każdego poziomu to reduction * liczba trójkątów poprzedniego
+ * (nie mniej niż minTriangles). Łańcuch kończy się, gdy krok usunie mniej
+ * niż 10% trójkątów (błąd maxError nie pozwala na więcej) lub gdy
+ * poprzedni poziom ma już minTriangles trójkątów.
+ */
+std::vector<LodLevel> LodChain::build(const MeshData& mesh, const LodChainSettings& settings) {
+    std::vector<LodLevel> levels;
+    levels.reserve(std::max(settings.maxLevels, 0));
+    float extent = MeshSimplifier::computeExtent(mesh);
+    float accumulatedError = 0.0f;
+
+    const MeshData* source = &mesh;
+    for (int level = 0; level < settings.maxLevels; ++level) {
+        size_t sourceTriangles = source->indices.size() / 3;
+        if (sourceTriangles <= settings.minTriangles) break;
+
+        SimplifyOptions options = settings.options;
+        options.targetTriangleCount = std::max(settings.minTriangles,
+            static_cast<size_t>(sourceTriangles * settings.reduction));
+        options.targetError = settings.maxError;
+
+        float stepError = 0.0f;
+        MeshData simplified = MeshSimplifier::simplify(*source, options, &stepError);
+        size_t triangles = simplified.indices.size() / 3;
+        if (triangles == 0 || triangles * 10 > sourceTriangles * 9) break;
+
+        accumulatedError += stepError * extent;
+        levels.push_back({std::move(simplified), accumulatedError});
+        source = &levels.back().data;
+    }
+
+    return levels;
+}
+
+/**
+ * @brief Konstruktor prywatny (singleton)
+ *
+ * Domyślnie dopuszczalna odchyłka to 1 piksel przy wysokości widoku 1080
+ * i kącie widzenia 45 stopni.
+ */
+LodSelector::LodSelector()
+    : m_viewPosition(0.0f), m_projectionScale(1303.6f), m_pixelThreshold(1.0f), m_bias(0.0f) {
+}
+
+/**
+ * @brief Zwraca globalną instancję wyboru poziomów
+ * @return Referencja do instancji
+ */
+LodSelector& LodSelector::instance() {
+    static LodSelector selector;
+    return selector;
+}
+
+/**
+ * @brief Ustawia bieżący widok
+ * @param position Pozycja obserwatora
+ * @param projection Macierz projekcji perspektywicznej
+ * @param viewportHeight Wysokość obszaru widoku w pikselach
+ *
+ * @details projection[1][1] = 1 / tan(fovY / 2), więc obiekt o wysokości h
+ * w odległości d zajmuje h * projection[1][1] * viewportHeight / (2 * d) pikseli.
+ */
+void LodSelector::setView(const glm::vec3& position, const glm::mat4& projection, int viewportHeight) {
+    m_viewPosition = position;
+    m_projectionScale = projection[1][1] * static_cast<float>(viewportHeight) * 0.5f;
+}
+
+/**
+ * @brief Wybiera poziom szczegółowości obiektu
+ * @param errors Błędy poziomów w przestrzeni lokalnej (indeks 0 = siatka pełna)
+ * @param worldBounds Sfera otaczająca obiekt w przestrzeni świata
+ * @param scale Skala przestrzeni lokalnej do świata
+ * @return Indeks poziomu (0 gdy brak poziomów uproszczonych)
+ *
+ * @details Odległość liczona jest do najbliższego punktu sfery otaczającej,
+ * więc obserwator wewnątrz obiektu zawsze dostaje siatkę pełną.
+ */
+int LodSelector::select(const std::vector<float>& errors, const BoundingSphere& worldBounds, float scale) const {
+    if (errors.size() < 2) return 0;
+
+    glm::vec3 offset = worldBounds.center - m_viewPosition;
+    float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z) - worldBounds.radius;
+    if (distance <= 0.0f) return 0;
+
+    float threshold = m_pixelThreshold * std::exp2(m_bias);
+    float pixelsPerUnit = scale * m_projectionScale / distance;
+
+    int level = 0;
+    for (size_t i = 1; i < errors.size(); ++i) {
+        if (errors[i] * pixelsPerUnit > threshold) break;
+        level = static_cast<int>(i);
+    }
+    return level;
+}
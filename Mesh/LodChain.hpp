@@ -0,0 +1,115 @@
+// LodChain.hpp
+#ifndef LOD_CHAIN_HPP
+#define LOD_CHAIN_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "MeshSimplifier.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @struct LodLevel
+ * @brief Uproszczony poziom szczegółowości siatki
+ */
+struct LodLevel {
+    MeshData data;      /**< Uproszczona siatka */
+    float error;        /**< Błąd względem siatki pełnej w jednostkach przestrzeni lokalnej */
+};
+
+/**
+ * @struct LodChainSettings
+ * @brief Parametry budowy łańcucha poziomów szczegółowości
+ */
+struct LodChainSettings {
+    int maxLevels = 4;              /**< Największa liczba poziomów uproszczonych */
+    float reduction = 0.5f;         /**< Docelowy stosunek liczby trójkątów kolejnych poziomów */
+    size_t minTriangles = 16;       /**< Poniżej tej liczby trójkątów łańcuch się kończy */
+    float maxError = 0.05f;         /**< Największy błąd względny jednego kroku upraszczania */
+    SimplifyOptions options;        /**< Wagi atrybutów i krawędzi (cel ustawiany dla każdego poziomu) */
+};
+
+/**
+ * @class LodChain
+ * @brief Budowa poziomów szczegółowości przy wczytywaniu siatki
+ *
+ * Każdy poziom upraszczany jest z poprzedniego (koszt maleje geometrycznie),
+ * a jego błąd to suma błędów kolejnych kroków, więc jest górnym
+ * ograniczeniem odchyłki od siatki pełnej.
+ */
+class LodChain {
+public:
+    /**
+     * @brief Buduje poziomy uproszczone siatki
+     * @param mesh Siatka pełna (poziom 0, nie jest kopiowana do wyniku)
+     * @param settings Parametry łańcucha
+     * @return Poziomy 1..n od najdokładniejszego
+     */
+    static std::vector<LodLevel> build(const MeshData& mesh, const LodChainSettings& settings = LodChainSettings());
+};
+
+/**
+ * @class LodSelector
+ * @brief Wybór poziomu szczegółowości według błędu rzutowanego na ekran
+ *
+ * Błąd poziomu (w jednostkach świata) dzielony przez odległość od
+ * obserwatora i mnożony przez skalę projekcji daje odchyłkę w pikselach.
+ * Wybierany jest najprostszy poziom, którego odchyłka nie przekracza
+ * progu; przesunięcie LOD z regulatora jakości podwaja próg co jednostkę.
+ * Widok ustawiany jest przed rysowaniem każdego widoku sceny.
+ */
+class LodSelector {
+private:
+    glm::vec3 m_viewPosition;   /**< Pozycja obserwatora bieżącego widoku */
+    float m_projectionScale;    /**< Piksele na jednostkę w odległości 1 */
+    float m_pixelThreshold;     /**< Dopuszczalna odchyłka w pikselach */
+    float m_bias;               /**< Przesunięcie LOD (0 = pełna jakość) */
+
+    /**
+     * @brief Konstruktor prywatny (singleton)
+     */
+    LodSelector();
+
+public:
+    /**
+     * @brief Zwraca globalną instancję wyboru poziomów
+     * @return Referencja do instancji
+     */
+    static LodSelector& instance();
+
+    /**
+     * @brief Ustawia bieżący widok
+     * @param position Pozycja obserwatora
+     * @param projection Macierz projekcji perspektywicznej
+     * @param viewportHeight Wysokość obszaru widoku w pikselach
+     */
+    void setView(const glm::vec3& position, const glm::mat4& projection, int viewportHeight);
+
+    /**
+     * @brief Ustawia przesunięcie LOD
+     * @param bias Przesunięcie (każda jednostka podwaja dopuszczalną odchyłkę)
+     */
+    void setBias(float bias) { m_bias = bias; }
+
+    /**
+     * @brief Ustawia dopuszczalną odchyłkę
+     * @param pixels Odchyłka w pikselach
+     */
+    void setPixelThreshold(float pixels) { m_pixelThreshold = pixels; }
+
+    /**
+     * @brief Zwraca dopuszczalną odchyłkę
+     * @return Odchyłka w pikselach
+     */
+    float getPixelThreshold() const { return m_pixelThreshold; }
+
+    /**
+     * @brief Wybiera poziom szczegółowości obiektu
+     * @param errors Błędy poziomów w przestrzeni lokalnej (indeks 0 = siatka pełna)
+     * @param worldBounds Sfera otaczająca obiekt w przestrzeni świata
+     * @param scale Skala przestrzeni lokalnej do świata
+     * @return Indeks poziomu (0 gdy brak poziomów uproszczonych)
+     */
+    int select(const std::vector<float>& errors, const BoundingSphere& worldBounds, float scale) const;
+};
+
+#endif // LOD_CHAIN_HPP
@@ -0,0 +1,500 @@
+// MeshBuilder.cpp
+#include "MeshBuilder.hpp"
+#include "PrimitiveData.hpp"
+#include "../Math/Simd.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#define PI 3.14159265358979323846f
+
+/**
+ * @brief Konstruktor MeshArena
+ * @param blockSize Rozmiar bloku w bajtach (większe żądania dostają własny blok)
+ */
+MeshArena::MeshArena(size_t blockSize) : m_current(0), m_blockSize(blockSize) {
+}
+
+/**
+ * @brief Przydziela pamięć
+ * @param bytes Liczba bajtów
+ * @param alignment Wyrównanie (potęga dwójki)
+ * @return Wskaźnik do pamięci
+ *
+ * @details Przeszukiwane są bloki od bieżącego; gdy żaden nie ma miejsca,
+ * dodawany jest nowy blok o rozmiarze co najmniej bytes + alignment.
+ */
+void* MeshArena::allocate(size_t bytes, size_t alignment) {
+    for (; m_current < m_blocks.size(); ++m_current) {
+        Block& block = m_blocks[m_current];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        uintptr_t aligned = (base + block.used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        size_t offset = static_cast<size_t>(aligned - base);
+        if (offset + bytes <= block.size) {
+            block.used = offset + bytes;
+            return block.data.get() + offset;
+        }
+    }
+
+    size_t size = std::max(m_blockSize, bytes + alignment);
+    m_blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]), size, 0});
+    m_current = m_blocks.size() - 1;
+    return allocate(bytes, alignment);
+}
+
+/**
+ * @brief Zwalnia wszystkie przydziały (bloki pozostają do ponownego użycia)
+ */
+void MeshArena::reset() {
+    for (auto& block : m_blocks) {
+        block.used = 0;
+    }
+    m_current = 0;
+}
+
+/**
+ * @brief Zwraca liczbę zajętych bajtów
+ * @return Suma zajętych bajtów we wszystkich blokach
+ */
+size_t MeshArena::getUsedBytes() const {
+    size_t used = 0;
+    for (const auto& block : m_blocks) {
+        used += block.used;
+    }
+    return used;
+}
+
+/**
+ * @brief Konstruktor MeshBuilder z pamięcią w std::vector
+ */
+MeshBuilder::MeshBuilder()
+    : m_storage(Storage::VECTOR), m_arena(nullptr), m_vertices(nullptr), m_indices(nullptr),
+      m_vertexCapacity(0), m_indexCapacity(0), m_vertexCount(0), m_indexCount(0),
+      m_parallelThreshold(DEFAULT_PARALLEL_THRESHOLD) {
+    m_transforms.push_back({glm::mat4(1.0f), glm::mat3(1.0f), true});
+}
+
+/**
+ * @brief Konstruktor MeshBuilder z pamięcią z areny
+ * @param arena Arena (musi żyć dłużej niż dane siatki)
+ */
+MeshBuilder::MeshBuilder(MeshArena& arena) : MeshBuilder() {
+    m_storage = Storage::ARENA;
+    m_arena = &arena;
+}
+
+/**
+ * @brief Konstruktor MeshBuilder zapisujący do zewnętrznego bufora
+ * @param vertices Bufor wierzchołków
+ * @param vertexCapacity Pojemność bufora wierzchołków
+ * @param indices Bufor indeksów
+ * @param indexCapacity Pojemność bufora indeksów
+ */
+MeshBuilder::MeshBuilder(Vertex* vertices, size_t vertexCapacity, unsigned int* indices, size_t indexCapacity)
+    : MeshBuilder() {
+    m_storage = Storage::EXTERNAL;
+    m_vertices = vertices;
+    m_indices = indices;
+    m_vertexCapacity = vertexCapacity;
+    m_indexCapacity = indexCapacity;
+}
+
+/**
+ * @brief Zapewnia miejsce na dodatkowe wierzchołki i indeksy
+ * @param counts Liczba dodatkowych wierzchołków i indeksów
+ * @return false gdy bufor zewnętrzny jest za mały
+ *
+ * @details Gdy pojemność nie wystarcza, std::vector i arena powiększane są
+ * co najmniej dwukrotnie, więc seria kształtów bez wcześniejszego reserve()
+ * nadal kopiuje dane tylko logarytmicznie wiele razy.
+ */
+bool MeshBuilder::reserve(const MeshCounts& counts) {
+    size_t neededVertices = m_vertexCount + counts.vertices;
+    size_t neededIndices = m_indexCount + counts.indices;
+    if (neededVertices <= m_vertexCapacity && neededIndices <= m_indexCapacity) return true;
+
+    if (m_storage == Storage::EXTERNAL) {
+        std::cerr << "Blad: Za maly bufor siatki (" << neededVertices << " wierzcholkow, "
+                  << neededIndices << " indeksow)" << std::endl;
+        return false;
+    }
+
+    // Pierwsze reserve() przydziela dokładnie tyle, ile potrzeba
+    size_t vertexCapacity = m_vertexCapacity == 0 ? neededVertices : std::max(neededVertices, m_vertexCapacity * 2);
+    size_t indexCapacity = m_indexCapacity == 0 ? neededIndices : std::max(neededIndices, m_indexCapacity * 2);
+
+    if (m_storage == Storage::VECTOR) {
+        if (neededVertices > m_vertexCapacity) m_ownedVertices.resize(vertexCapacity);
+        if (neededIndices > m_indexCapacity) m_ownedIndices.resize(indexCapacity);
+        m_vertexCapacity = m_ownedVertices.size();
+        m_indexCapacity = m_ownedIndices.size();
+        m_vertices = m_ownedVertices.data();
+        m_indices = m_ownedIndices.data();
+        return true;
+    }
+
+    if (neededVertices > m_vertexCapacity) {
+        Vertex* vertices = m_arena->allocateArray<Vertex>(vertexCapacity);
+        if (m_vertexCount > 0) std::memcpy(vertices, m_vertices, m_vertexCount * sizeof(Vertex));
+        m_vertices = vertices;
+        m_vertexCapacity = vertexCapacity;
+    }
+    if (neededIndices > m_indexCapacity) {
+        unsigned int* indices = m_arena->allocateArray<unsigned int>(indexCapacity);
+        if (m_indexCount > 0) std::memcpy(indices, m_indices, m_indexCount * sizeof(unsigned int));
+        m_indices = indices;
+        m_indexCapacity = indexCapacity;
+    }
+    return true;
+}
+
+/**
+ * @brief Usuwa zapisane dane (pamięć pozostaje przydzielona)
+ */
+void MeshBuilder::clear() {
+    m_vertexCount = 0;
+    m_indexCount = 0;
+}
+
+/**
+ * @brief Odkłada transformację złożoną z bieżącą na stos
+ * @param transform Macierz transformacji
+ */
+void MeshBuilder::pushTransform(const glm::mat4& transform) {
+    glm::mat4 model = m_transforms.back().model * transform;
+    glm::mat3 normal = glm::transpose(glm::inverse(glm::mat3(model)));
+    m_transforms.push_back({model, normal, model == glm::mat4(1.0f)});
+}
+
+/**
+ * @brief Zdejmuje transformację ze stosu
+ */
+void MeshBuilder::popTransform() {
+    if (m_transforms.size() > 1) {
+        m_transforms.pop_back();
+    }
+}
+
+/**
+ * @brief Rezerwuje miejsce na kształt i zwraca wskaźniki zapisu
+ * @param counts Liczba wierzchołków i indeksów kształtu
+ * @param outVertices Wskaźnik do pierwszego wolnego wierzchołka
+ * @param outIndices Wskaźnik do pierwszego wolnego indeksu
+ * @return Indeks pierwszego wierzchołka kształtu lub -1 przy braku miejsca
+ */
+long long MeshBuilder::beginShape(const MeshCounts& counts, Vertex*& outVertices, unsigned int*& outIndices) {
+    if (!reserve(counts)) return -1;
+
+    long long baseVertex = static_cast<long long>(m_vertexCount);
+    outVertices = m_vertices + m_vertexCount;
+    outIndices = m_indices + m_indexCount;
+    m_vertexCount += counts.vertices;
+    m_indexCount += counts.indices;
+    return baseVertex;
+}
+
+/**
+ * @brief Zapisuje wierzchołek z bieżącą transformacją
+ * @param out Miejsce zapisu
+ * @param position Pozycja lokalna
+ * @param normal Normalna lokalna
+ * @param texCoord Współrzędne tekstury
+ */
+void MeshBuilder::emitVertex(Vertex& out, const glm::vec3& position, const glm::vec3& normal,
+                             const glm::vec2& texCoord) const {
+    const TransformState& state = m_transforms.back();
+    if (state.identity) {
+        out.position = position;
+        out.normal = normal;
+    } else {
+        out.position = glm::vec3(state.model * glm::vec4(position, 1.0f));
+        out.normal = glm::normalize(state.normal * normal);
+    }
+    out.texCoord = texCoord;
+}
+
+/**
+ * @brief Wypełnia tablice sinusów i cosinusów kątów sektorów
+ * @param sectors Liczba sektorów (tablice mają sectors + 1 elementów)
+ *
+ * @details Kąty liczone są jak w pętli skalarnej (j * krok), więc wartości
+ * są identyczne z wywołaniami cosf/sinf dla każdego wierzchołka.
+ */
+void MeshBuilder::fillSectorTables(int sectors) {
+    float sectorStep = 2 * PI / sectors;
+    m_cosTable.resize(sectors + 1);
+    m_sinTable.resize(sectors + 1);
+    for (int j = 0; j <= sectors; ++j) {
+        float sectorAngle = j * sectorStep;
+        m_cosTable[j] = cosf(sectorAngle);
+        m_sinTable[j] = sinf(sectorAngle);
+    }
+}
+
+/**
+ * @brief Wywołuje funkcję dla zakresów wierszy, w razie potrzeby na wielu wątkach
+ * @param rows Liczba wierszy
+ * @param rowVertices Liczba wierzchołków w wierszu
+ * @param func Funkcja wywoływana dla wierszy [begin, end)
+ *
+ * @details Porcja obejmuje co najmniej 16k wierzchołków, aby koszt
+ * przekazania zadania był pomijalny względem generowania.
+ */
+void MeshBuilder::forEachRow(size_t rows, size_t rowVertices, const std::function<void(size_t, size_t)>& func) const {
+    if (rows * rowVertices < m_parallelThreshold) {
+        func(0, rows);
+        return;
+    }
+    size_t minRows = std::max<size_t>(1, (16 * 1024) / std::max<size_t>(rowVertices, 1));
+    ThreadPool::instance().parallelFor(rows, minRows, func);
+}
+
+/**
+ * @brief Dodaje prostopadłościan ze środkiem w (0,0,0)
+ * @param size Wymiary
+ */
+void MeshBuilder::addCuboid(const glm::vec3& size) {
+    Vertex* vertices = nullptr;
+    unsigned int* indices = nullptr;
+    long long base = beginShape(cuboidCounts(), vertices, indices);
+    if (base < 0) return;
+
+    const auto& cube = Primitives::CUBE;
+    for (size_t i = 0; i < cube.vertices.size(); ++i) {
+        const Primitives::PackedVertex& v = cube.vertices[i];
+        emitVertex(vertices[i], glm::vec3(v.position[0], v.position[1], v.position[2]) * size,
+                   glm::vec3(v.normal[0], v.normal[1], v.normal[2]), glm::vec2(v.texCoord[0], v.texCoord[1]));
+    }
+    for (size_t i = 0; i < cube.indices.size(); ++i) {
+        indices[i] = static_cast<unsigned int>(base) + cube.indices[i];
+    }
+}
+
+/**
+ * @brief Dodaje sferę o promieniu 1
+ * @param sectors Liczba sektorów (wokół osi Z)
+ * @param stacks Liczba warstw (wzdłuż osi Z)
+ *
+ * @details Metoda parametryczna: warstwy od bieguna +Z do -Z, w każdej
+ * sectors + 1 wierzchołków (szew tekstury ma zdublowane wierzchołki).
+ * Bez transformacji warstwy zapisuje Simd::generateSphereRow, z transformacją
+ * emitVertex(). Indeksy każdej warstwy mają znane położenie, więc warstwy
+ * mogą być generowane na wielu wątkach.
+ */
+void MeshBuilder::addSphere(int sectors, int stacks) {
+    Vertex* vertices = nullptr;
+    unsigned int* indices = nullptr;
+    long long base = beginShape(sphereCounts(sectors, stacks), vertices, indices);
+    if (base < 0) return;
+
+    fillSectorTables(sectors);
+    float stackStep = PI / stacks;
+    size_t rowVertices = static_cast<size_t>(sectors) + 1;
+    bool identity = m_transforms.back().identity;
+
+    forEachRow(stacks + 1, rowVertices, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float stackAngle = PI / 2 - i * stackStep;
+            float xy = cosf(stackAngle);
+            float z = sinf(stackAngle);
+            float v = (float)i / stacks;
+            Vertex* row = vertices + i * rowVertices;
+
+            if (identity) {
+                Simd::generateSphereRow(m_cosTable.data(), m_sinTable.data(), rowVertices, xy, z, v,
+                                        static_cast<float>(sectors), &row->position.x, sizeof(Vertex) / sizeof(float));
+                continue;
+            }
+            for (size_t j = 0; j < rowVertices; ++j) {
+                glm::vec3 point(xy * m_cosTable[j], xy * m_sinTable[j], z);
+                emitVertex(row[j], point, point, glm::vec2((float)j / sectors, v));
+            }
+        }
+    });
+
+    // Warstwa i zaczyna się po 1 + 2 * (i - 1) trójkątach na sektor (biegun ma jeden)
+    if (stacks < 2) return;
+    unsigned int first = static_cast<unsigned int>(base);
+    forEachRow(stacks, rowVertices, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            unsigned int* out = indices + (i == 0 ? 0 : (2 * i - 1) * 3 * static_cast<size_t>(sectors));
+            unsigned int k1 = first + static_cast<unsigned int>(i * rowVertices);
+            unsigned int k2 = k1 + sectors + 1;
+
+            for (int j = 0; j < sectors; ++j, ++k1, ++k2) {
+                if (i != 0) {
+                    *out++ = k1;
+                    *out++ = k2;
+                    *out++ = k1 + 1;
+                }
+
+                if (i != static_cast<size_t>(stacks - 1)) {
+                    *out++ = k1 + 1;
+                    *out++ = k2;
+                    *out++ = k2 + 1;
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief Dodaje cylinder o promieniu 1 i wysokości 1 wzdłuż osi Y
+ * @param sectors Liczba sektorów
+ *
+ * @details Wierzchołki 0 i 1 to środki podstaw, następnie dla każdego punktu
+ * obwodu: podstawa górna, podstawa dolna, ściana górna, ściana dolna.
+ * Wszystkie trójkąty mają kolejność CCW patrząc z zewnątrz.
+ */
+void MeshBuilder::addCylinder(int sectors) {
+    Vertex* vertices = nullptr;
+    unsigned int* indices = nullptr;
+    long long base = beginShape(cylinderCounts(sectors), vertices, indices);
+    if (base < 0) return;
+
+    float sectorStep = 2.0f * PI / sectors;
+
+    // Centra podstaw
+    emitVertex(*vertices++, glm::vec3(0.0f, 0.5f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.5f, 0.5f));
+    emitVertex(*vertices++, glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(0.5f, 0.5f));
+
+    // Wierzchołki obwodu
+    for (int i = 0; i <= sectors; ++i) {
+        float angle = i * sectorStep;
+        float x = cosf(angle);
+        float z = sinf(angle);
+
+        glm::vec3 sideNormal = glm::normalize(glm::vec3(x, 0.0f, z));
+        glm::vec2 capUV(x * 0.5f + 0.5f, z * 0.5f + 0.5f);
+
+        emitVertex(*vertices++, glm::vec3(x, 0.5f, z), glm::vec3(0.0f, 1.0f, 0.0f), capUV);
+        emitVertex(*vertices++, glm::vec3(x, -0.5f, z), glm::vec3(0.0f, -1.0f, 0.0f), capUV);
+        emitVertex(*vertices++, glm::vec3(x, 0.5f, z), sideNormal, glm::vec2((float)i / sectors, 1.0f));
+        emitVertex(*vertices++, glm::vec3(x, -0.5f, z), sideNormal, glm::vec2((float)i / sectors, 0.0f));
+    }
+
+    unsigned int first = static_cast<unsigned int>(base);
+
+    // Górna podstawa
+    for (int i = 0; i < sectors; ++i) {
+        *indices++ = first;
+        *indices++ = first + 2 + (i + 1) * 4;
+        *indices++ = first + 2 + i * 4;
+    }
+
+    // Dolna podstawa
+    for (int i = 0; i < sectors; ++i) {
+        *indices++ = first + 1;
+        *indices++ = first + 3 + i * 4;
+        *indices++ = first + 3 + (i + 1) * 4;
+    }
+
+    // Ściany boczne
+    for (int i = 0; i < sectors; ++i) {
+        unsigned int current = first + 2 + i * 4;
+        unsigned int next = first + 2 + (i + 1) * 4;
+
+        *indices++ = current + 2;
+        *indices++ = next + 2;
+        *indices++ = current + 3;
+
+        *indices++ = current + 3;
+        *indices++ = next + 2;
+        *indices++ = next + 3;
+    }
+}
+
+/**
+ * @brief Dodaje torus w płaszczyźnie XY
+ * @param radius Główny promień
+ * @param tubeRadius Promień rury
+ * @param sectors Liczba sektorów rury
+ * @param rings Liczba pierścieni
+ *
+ * @details Bez transformacji pierścienie zapisuje Simd::generateTorusRow,
+ * z transformacją emitVertex(). Pierścienie mogą być generowane na wielu wątkach.
+ */
+void MeshBuilder::addTorus(float radius, float tubeRadius, int sectors, int rings) {
+    Vertex* vertices = nullptr;
+    unsigned int* indices = nullptr;
+    long long base = beginShape(torusCounts(sectors, rings), vertices, indices);
+    if (base < 0) return;
+
+    fillSectorTables(sectors);
+    float ringStep = 2 * PI / rings;
+    size_t rowVertices = static_cast<size_t>(sectors) + 1;
+    bool identity = m_transforms.back().identity;
+
+    forEachRow(rings + 1, rowVertices, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float ringAngle = i * ringStep;
+            float cosRing = cosf(ringAngle);
+            float sinRing = sinf(ringAngle);
+            float v = static_cast<float>(i) / rings;
+            Vertex* row = vertices + i * rowVertices;
+
+            if (identity) {
+                Simd::generateTorusRow(m_cosTable.data(), m_sinTable.data(), rowVertices, cosRing, sinRing,
+                                       radius, tubeRadius, v, static_cast<float>(sectors),
+                                       &row->position.x, sizeof(Vertex) / sizeof(float));
+                continue;
+            }
+            for (size_t j = 0; j < rowVertices; ++j) {
+                float cosSector = m_cosTable[j];
+                float sinSector = m_sinTable[j];
+                glm::vec3 position((radius + tubeRadius * cosSector) * cosRing,
+                                   (radius + tubeRadius * cosSector) * sinRing,
+                                   tubeRadius * sinSector);
+                glm::vec3 normal(cosRing * cosSector, sinRing * cosSector, sinSector);
+                emitVertex(row[j], position, normal, glm::vec2(static_cast<float>(j) / sectors, v));
+            }
+        }
+    });
+
+    unsigned int start = static_cast<unsigned int>(base);
+    forEachRow(rings, rowVertices, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            unsigned int* out = indices + i * 6 * static_cast<size_t>(sectors);
+            for (int j = 0; j < sectors; ++j) {
+                unsigned int first = start + static_cast<unsigned int>(i * rowVertices) + j;
+                unsigned int second = first + sectors + 1;
+
+                *out++ = first;
+                *out++ = second;
+                *out++ = first + 1;
+
+                *out++ = second;
+                *out++ = second + 1;
+                *out++ = first + 1;
+            }
+        }
+    });
+}
+
+/**
+ * @brief Przekazuje dane jako MeshData
+ * @return Dane siatki (dla Storage::VECTOR bez kopiowania)
+ */
+MeshData MeshBuilder::takeMeshData() {
+    MeshData data;
+    if (m_storage == Storage::VECTOR) {
+        m_ownedVertices.resize(m_vertexCount);
+        m_ownedIndices.resize(m_indexCount);
+        data.vertices = std::move(m_ownedVertices);
+        data.indices = std::move(m_ownedIndices);
+        m_ownedVertices.clear();
+        m_ownedIndices.clear();
+        m_vertices = nullptr;
+        m_indices = nullptr;
+        m_vertexCapacity = 0;
+        m_indexCapacity = 0;
+    } else {
+        data.vertices.assign(m_vertices, m_vertices + m_vertexCount);
+        data.indices.assign(m_indices, m_indices + m_indexCount);
+    }
+    clear();
+    return data;
+}
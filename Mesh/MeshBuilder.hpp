@@ -0,0 +1,352 @@
+// MeshBuilder.hpp
+#ifndef MESH_BUILDER_HPP
+#define MESH_BUILDER_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+
+/**
+ * @struct MeshCounts
+ * @brief Dokładna liczba wierzchołków i indeksów siatki
+ */
+struct MeshCounts {
+    size_t vertices;    /**< Liczba wierzchołków */
+    size_t indices;     /**< Liczba indeksów */
+
+    /**
+     * @brief Sumuje liczniki dwóch siatek
+     * @param other Drugi licznik
+     * @return Suma
+     */
+    constexpr MeshCounts operator+(const MeshCounts& other) const { return {vertices + other.vertices, indices + other.indices}; }
+
+    /**
+     * @brief Mnoży liczniki przez liczbę kopii
+     * @param copies Liczba kopii
+     * @return Iloczyn
+     */
+    constexpr MeshCounts operator*(size_t copies) const { return {vertices * copies, indices * copies}; }
+};
+
+/**
+ * @class MeshArena
+ * @brief Prosty alokator liniowy dla tymczasowych danych siatek
+ *
+ * Pamięć przydzielana jest z dużych bloków przez przesunięcie wskaźnika,
+ * a zwalniana naraz przez reset(). Bloki nie są oddawane do systemu, więc
+ * kolejne generowanie siatek nie alokuje pamięci.
+ */
+class MeshArena {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 1 << 20;   /**< Domyślny rozmiar bloku w bajtach */
+
+private:
+    /**
+     * @struct Block
+     * @brief Blok pamięci areny
+     */
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;  /**< Pamięć bloku */
+        size_t size;                            /**< Rozmiar w bajtach */
+        size_t used;                            /**< Zajęte bajty */
+    };
+
+    std::vector<Block> m_blocks;    /**< Bloki */
+    size_t m_current;               /**< Indeks bloku, z którego przydzielana jest pamięć */
+    size_t m_blockSize;             /**< Rozmiar nowego bloku */
+
+public:
+    /**
+     * @brief Konstruktor MeshArena
+     * @param blockSize Rozmiar bloku w bajtach (większe żądania dostają własny blok)
+     */
+    explicit MeshArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    /**
+     * @brief Przydziela pamięć
+     * @param bytes Liczba bajtów
+     * @param alignment Wyrównanie (potęga dwójki)
+     * @return Wskaźnik do pamięci
+     */
+    void* allocate(size_t bytes, size_t alignment);
+
+    /**
+     * @brief Przydziela tablicę elementów
+     * @param count Liczba elementów
+     * @return Wskaźnik do pierwszego elementu
+     */
+    template <typename T>
+    T* allocateArray(size_t count) { return static_cast<T*>(allocate(count * sizeof(T), alignof(T))); }
+
+    /**
+     * @brief Zwalnia wszystkie przydziały (bloki pozostają do ponownego użycia)
+     */
+    void reset();
+
+    /**
+     * @brief Zwraca liczbę zajętych bajtów
+     * @return Suma zajętych bajtów we wszystkich blokach
+     */
+    size_t getUsedBytes() const;
+};
+
+/**
+ * @class MeshBuilder
+ * @brief Generowanie siatek bezpośrednio do przygotowanej pamięci
+ *
+ * Każdy kształt ma funkcję zwracającą dokładną liczbę wierzchołków
+ * i indeksów, więc całą siatkę można przydzielić jednym reserve(),
+ * a następnie zapisywać wierzchołki przez wskaźnik, bez push_back
+ * i bez tymczasowych tablic.
+ *
+ * Pamięć może pochodzić z:
+ * - wewnętrznych std::vector (konstruktor domyślny),
+ * - areny MeshArena (bez alokacji przy kolejnych siatkach),
+ * - zewnętrznego bufora, np. zmapowanego bufora GPU (glMapBufferRange) -
+ *   wtedy pojemność jest stała i reserve() zwraca false, gdy jej brakuje.
+ *
+ * Stos transformacji (pushTransform()/popTransform()) jest stosowany
+ * w chwili zapisu wierzchołka: pozycje przekształcane są macierzą,
+ * a normalne macierzą odwrotną transponowaną. Pozwala to składać modele
+ * z kształtów (prostopadłościanów, cylindrów) jak w ComplexObject.
+ *
+ * Sfera i torus liczą sinusy i cosinusy kątów sektorów raz na kształt,
+ * a wiersze wierzchołków (bez transformacji) generują po 4 naraz funkcjami
+ * Simd. Siatki od getParallelThreshold() wierzchołków dzielone są po
+ * wierszach między wątki ThreadPool.
+ */
+class MeshBuilder {
+public:
+    static const size_t DEFAULT_PARALLEL_THRESHOLD = 1 << 16;  /**< Domyślna liczba wierzchołków kształtu, od której generowanie jest wielowątkowe */
+
+private:
+    /**
+     * @enum Storage
+     * @brief Źródło pamięci wierzchołków i indeksów
+     */
+    enum class Storage {
+        VECTOR,     /**< Wewnętrzne std::vector */
+        ARENA,      /**< MeshArena */
+        EXTERNAL    /**< Bufor zewnętrzny o stałej pojemności */
+    };
+
+    /**
+     * @struct TransformState
+     * @brief Element stosu transformacji
+     */
+    struct TransformState {
+        glm::mat4 model;        /**< Macierz pozycji */
+        glm::mat3 normal;       /**< Macierz normalnych (odwrotna transponowana) */
+        bool identity;          /**< Czy transformacja jest jednostkowa */
+    };
+
+    Storage m_storage;                          /**< Źródło pamięci */
+    MeshArena* m_arena;                         /**< Arena (tylko Storage::ARENA) */
+    std::vector<Vertex> m_ownedVertices;        /**< Wierzchołki (tylko Storage::VECTOR) */
+    std::vector<unsigned int> m_ownedIndices;   /**< Indeksy (tylko Storage::VECTOR) */
+    Vertex* m_vertices;                         /**< Początek pamięci wierzchołków */
+    unsigned int* m_indices;                    /**< Początek pamięci indeksów */
+    size_t m_vertexCapacity;                    /**< Pojemność w wierzchołkach */
+    size_t m_indexCapacity;                     /**< Pojemność w indeksach */
+    size_t m_vertexCount;                       /**< Zapisane wierzchołki */
+    size_t m_indexCount;                        /**< Zapisane indeksy */
+    std::vector<TransformState> m_transforms;   /**< Stos transformacji */
+    std::vector<float> m_cosTable;              /**< Cosinusy kątów sektorów bieżącego kształtu */
+    std::vector<float> m_sinTable;              /**< Sinusy kątów sektorów bieżącego kształtu */
+    size_t m_parallelThreshold;                 /**< Liczba wierzchołków kształtu, od której używane są wątki */
+
+    /**
+     * @brief Rezerwuje miejsce na kształt i zwraca wskaźniki zapisu
+     * @param counts Liczba wierzchołków i indeksów kształtu
+     * @param outVertices Wskaźnik do pierwszego wolnego wierzchołka
+     * @param outIndices Wskaźnik do pierwszego wolnego indeksu
+     * @return Indeks pierwszego wierzchołka kształtu lub -1 przy braku miejsca
+     */
+    long long beginShape(const MeshCounts& counts, Vertex*& outVertices, unsigned int*& outIndices);
+
+    /**
+     * @brief Zapisuje wierzchołek z bieżącą transformacją
+     * @param out Miejsce zapisu
+     * @param position Pozycja lokalna
+     * @param normal Normalna lokalna
+     * @param texCoord Współrzędne tekstury
+     */
+    void emitVertex(Vertex& out, const glm::vec3& position, const glm::vec3& normal, const glm::vec2& texCoord) const;
+
+    /**
+     * @brief Wypełnia tablice sinusów i cosinusów kątów sektorów
+     * @param sectors Liczba sektorów (tablice mają sectors + 1 elementów)
+     */
+    void fillSectorTables(int sectors);
+
+    /**
+     * @brief Wywołuje funkcję dla zakresów wierszy, w razie potrzeby na wielu wątkach
+     * @param rows Liczba wierszy
+     * @param rowVertices Liczba wierzchołków w wierszu
+     * @param func Funkcja wywoływana dla wierszy [begin, end)
+     */
+    void forEachRow(size_t rows, size_t rowVertices, const std::function<void(size_t, size_t)>& func) const;
+
+public:
+    /**
+     * @brief Konstruktor MeshBuilder z pamięcią w std::vector
+     */
+    MeshBuilder();
+
+    /**
+     * @brief Konstruktor MeshBuilder z pamięcią z areny
+     * @param arena Arena (musi żyć dłużej niż dane siatki)
+     */
+    explicit MeshBuilder(MeshArena& arena);
+
+    /**
+     * @brief Konstruktor MeshBuilder zapisujący do zewnętrznego bufora
+     * @param vertices Bufor wierzchołków
+     * @param vertexCapacity Pojemność bufora wierzchołków
+     * @param indices Bufor indeksów
+     * @param indexCapacity Pojemność bufora indeksów
+     */
+    MeshBuilder(Vertex* vertices, size_t vertexCapacity, unsigned int* indices, size_t indexCapacity);
+
+    /**
+     * @brief Zwraca liczniki prostopadłościanu
+     * @return 24 wierzchołki, 36 indeksów
+     */
+    static constexpr MeshCounts cuboidCounts() { return {24, 36}; }
+
+    /**
+     * @brief Zwraca liczniki sfery
+     * @param sectors Liczba sektorów
+     * @param stacks Liczba warstw
+     * @return Liczniki siatki
+     *
+     * Warstwy przy biegunach mają po jednym trójkącie na sektor, pozostałe po dwa.
+     */
+    static constexpr MeshCounts sphereCounts(int sectors, int stacks) {
+        size_t triangles = stacks > 1 ? static_cast<size_t>(sectors) * (2 * stacks - 2) : 0;
+        return {static_cast<size_t>(sectors + 1) * (stacks + 1), triangles * 3};
+    }
+
+    /**
+     * @brief Zwraca liczniki cylindra
+     * @param sectors Liczba sektorów
+     * @return Liczniki siatki
+     *
+     * Dwa środki podstaw i po 4 wierzchołki na każdy z sectors + 1 punktów
+     * obwodu (podstawy i ściana mają osobne normalne).
+     */
+    static constexpr MeshCounts cylinderCounts(int sectors) {
+        return {2 + 4 * static_cast<size_t>(sectors + 1), 12 * static_cast<size_t>(sectors)};
+    }
+
+    /**
+     * @brief Zwraca liczniki torusa
+     * @param sectors Liczba sektorów
+     * @param rings Liczba pierścieni
+     * @return Liczniki siatki
+     */
+    static constexpr MeshCounts torusCounts(int sectors, int rings) {
+        return {static_cast<size_t>(sectors + 1) * (rings + 1), 6 * static_cast<size_t>(sectors) * rings};
+    }
+
+    /**
+     * @brief Zapewnia miejsce na dodatkowe wierzchołki i indeksy
+     * @param counts Liczba dodatkowych wierzchołków i indeksów
+     * @return false gdy bufor zewnętrzny jest za mały
+     */
+    bool reserve(const MeshCounts& counts);
+
+    /**
+     * @brief Usuwa zapisane dane (pamięć pozostaje przydzielona)
+     */
+    void clear();
+
+    /**
+     * @brief Ustawia próg generowania wielowątkowego
+     * @param vertices Liczba wierzchołków kształtu (SIZE_MAX wyłącza wątki)
+     */
+    void setParallelThreshold(size_t vertices) { m_parallelThreshold = vertices; }
+
+    /**
+     * @brief Zwraca próg generowania wielowątkowego
+     * @return Liczba wierzchołków kształtu
+     */
+    size_t getParallelThreshold() const { return m_parallelThreshold; }
+
+    /**
+     * @brief Odkłada transformację złożoną z bieżącą na stos
+     * @param transform Macierz transformacji
+     */
+    void pushTransform(const glm::mat4& transform);
+
+    /**
+     * @brief Zdejmuje transformację ze stosu
+     */
+    void popTransform();
+
+    /**
+     * @brief Dodaje prostopadłościan ze środkiem w (0,0,0)
+     * @param size Wymiary
+     */
+    void addCuboid(const glm::vec3& size = glm::vec3(1.0f));
+
+    /**
+     * @brief Dodaje sferę o promieniu 1
+     * @param sectors Liczba sektorów (wokół osi Z)
+     * @param stacks Liczba warstw (wzdłuż osi Z)
+     */
+    void addSphere(int sectors, int stacks);
+
+    /**
+     * @brief Dodaje cylinder o promieniu 1 i wysokości 1 wzdłuż osi Y
+     * @param sectors Liczba sektorów
+     */
+    void addCylinder(int sectors);
+
+    /**
+     * @brief Dodaje torus w płaszczyźnie XY
+     * @param radius Główny promień
+     * @param tubeRadius Promień rury
+     * @param sectors Liczba sektorów rury
+     * @param rings Liczba pierścieni
+     */
+    void addTorus(float radius, float tubeRadius, int sectors, int rings);
+
+    /**
+     * @brief Zwraca liczbę zapisanych wierzchołków
+     * @return Liczba wierzchołków
+     */
+    size_t getVertexCount() const { return m_vertexCount; }
+
+    /**
+     * @brief Zwraca liczbę zapisanych indeksów
+     * @return Liczba indeksów
+     */
+    size_t getIndexCount() const { return m_indexCount; }
+
+    /**
+     * @brief Zwraca zapisane wierzchołki
+     * @return Wskaźnik do pierwszego wierzchołka
+     */
+    const Vertex* getVertices() const { return m_vertices; }
+
+    /**
+     * @brief Zwraca zapisane indeksy
+     * @return Wskaźnik do pierwszego indeksu
+     */
+    const unsigned int* getIndices() const { return m_indices; }
+
+    /**
+     * @brief Przekazuje dane jako MeshData
+     * @return Dane siatki (dla Storage::VECTOR bez kopiowania)
+     *
+     * Po wywołaniu budowniczy jest pusty.
+     */
+    MeshData takeMeshData();
+};
+
+#endif // MESH_BUILDER_HPP
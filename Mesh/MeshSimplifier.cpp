@@ -0,0 +1,546 @@
+// MeshSimplifier.cpp
+#include "MeshSimplifier.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+static const double BORDER_WEIGHT = 10.0;   /**< Waga płaszczyzn prostopadłych do krawędzi otwartych */
+static const double SEAM_WEIGHT = 1.0;      /**< Waga płaszczyzn prostopadłych do szwów */
+static const int MAX_PASSES = 100;          /**< Największa liczba przejść */
+static const size_t PARALLEL_BATCH = 4096;  /**< Minimalna porcja pracy wątku */
+static const unsigned NO_EDGE = 0xffffffffu;            /**< Brak krawędzi przeciwnej */
+static const unsigned NON_MANIFOLD_EDGE = 0xfffffffeu;  /**< Krawędź powtórzona lub z wieloma przeciwnymi */
+static const unsigned INNER_EDGE = 0xfffffffdu;         /**< Kolejna krawędź w grupie o tym samym kluczu */
+
+/**
+ * @struct Quadric
+ * @brief Symetryczna kwadryka błędu (suma kwadratów odległości od płaszczyzn)
+ */
+struct Quadric {
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;   /**< Macierz n * n^T */
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;                                        /**< Wektor d * n */
+    double c = 0.0;                                                             /**< Wyraz wolny d^2 */
+    double weight = 0.0;                                                        /**< Suma wag płaszczyzn */
+};
+
+/**
+ * @enum VertexKind
+ * @brief Rodzaj wierzchołka topologii decydujący o dozwolonych ściągnięciach
+ */
+enum class VertexKind : unsigned char {
+    MANIFOLD,   /**< Wnętrze powierzchni, jeden wariant atrybutów */
+    BORDER,     /**< Na krawędzi otwartej */
+    SEAM,       /**< Na szwie, dwa warianty atrybutów */
+    LOCKED      /**< Nieruchomy */
+};
+
+/**
+ * @struct EdgeEntry
+ * @brief Krawędź skierowana trójkąta
+ */
+struct EdgeEntry {
+    uint64_t key;           /**< (wierzchołek początkowy << 32) | wierzchołek końcowy (topologia) */
+    unsigned wedgeA;        /**< Wierzchołek początkowy w buforze */
+    unsigned wedgeB;        /**< Wierzchołek końcowy w buforze */
+    unsigned triangle;      /**< Trójkąt */
+};
+
+/**
+ * @struct Collapse
+ * @brief Kandydat na ściągnięcie wierzchołka topologii do sąsiada
+ */
+struct Collapse {
+    unsigned from;          /**< Ściągany wierzchołek topologii */
+    unsigned to;            /**< Wierzchołek docelowy */
+    unsigned edge;          /**< Krawędź skierowana łącząca wierzchołki */
+    unsigned opposite;      /**< Krawędź przeciwna (NO_EDGE dla krawędzi otwartej) */
+    bool reversed;          /**< Czy ściągnięcie biegnie przeciwnie do krawędzi edge */
+    bool seam;              /**< Czy krawędź leży na szwie */
+    unsigned wedgeFrom[2];  /**< Warianty ściąganego wierzchołka */
+    unsigned wedgeTo[2];    /**< Odpowiadające warianty wierzchołka docelowego */
+    float cost;             /**< Błąd ściągnięcia z atrybutami (nieskończony gdy niedozwolone) */
+    float distance;         /**< Sam błąd geometryczny (kwadrat, względny) */
+};
+
+/**
+ * @brief Buduje klucz krawędzi skierowanej
+ * @param a Wierzchołek początkowy
+ * @param b Wierzchołek końcowy
+ * @return Klucz
+ */
+static uint64_t edgeKey(unsigned a, unsigned b) {
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+/**
+ * @brief Dodaje płaszczyznę n * p + d = 0 do kwadryki
+ */
+static void addPlane(Quadric& q, double nx, double ny, double nz, double d, double weight) {
+    q.a00 += weight * nx * nx;
+    q.a01 += weight * nx * ny;
+    q.a02 += weight * nx * nz;
+    q.a11 += weight * ny * ny;
+    q.a12 += weight * ny * nz;
+    q.a22 += weight * nz * nz;
+    q.b0 += weight * nx * d;
+    q.b1 += weight * ny * d;
+    q.b2 += weight * nz * d;
+    q.c += weight * d * d;
+    q.weight += weight;
+}
+
+/**
+ * @brief Dodaje kwadrykę do kwadryki
+ */
+static void addQuadric(Quadric& q, const Quadric& other) {
+    q.a00 += other.a00;
+    q.a01 += other.a01;
+    q.a02 += other.a02;
+    q.a11 += other.a11;
+    q.a12 += other.a12;
+    q.a22 += other.a22;
+    q.b0 += other.b0;
+    q.b1 += other.b1;
+    q.b2 += other.b2;
+    q.c += other.c;
+    q.weight += other.weight;
+}
+
+/**
+ * @brief Oblicza ważoną sumę kwadratów odległości punktu od płaszczyzn kwadryki
+ */
+static double evaluateQuadric(const Quadric& q, const glm::vec3& p) {
+    double x = p.x, y = p.y, z = p.z;
+    double result = x * (q.a00 * x + q.a01 * y + q.a02 * z) +
+                    y * (q.a01 * x + q.a11 * y + q.a12 * z) +
+                    z * (q.a02 * x + q.a12 * y + q.a22 * z) +
+                    2.0 * (q.b0 * x + q.b1 * y + q.b2 * z) + q.c;
+    return std::max(result, 0.0);
+}
+
+/**
+ * @brief Oblicza nieznormalizowaną normalną trójkąta (w double)
+ */
+static void triangleNormal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, double* out) {
+    double e1[3] = {static_cast<double>(p1.x) - p0.x, static_cast<double>(p1.y) - p0.y, static_cast<double>(p1.z) - p0.z};
+    double e2[3] = {static_cast<double>(p2.x) - p0.x, static_cast<double>(p2.y) - p0.y, static_cast<double>(p2.z) - p0.z};
+    out[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    out[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    out[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+/**
+ * @brief Łączy wierzchołki o identycznej pozycji
+ * @param mesh Siatka
+ * @return Dla każdego wierzchołka indeks reprezentanta jego pozycji
+ */
+static std::vector<unsigned> weldPositions(const MeshData& mesh) {
+    size_t count = mesh.vertices.size();
+    std::vector<unsigned> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    auto less = [&](unsigned a, unsigned b) {
+        const glm::vec3& pa = mesh.vertices[a].position;
+        const glm::vec3& pb = mesh.vertices[b].position;
+        if (pa.x != pb.x) return pa.x < pb.x;
+        if (pa.y != pb.y) return pa.y < pb.y;
+        if (pa.z != pb.z) return pa.z < pb.z;
+        return a < b;
+    };
+    std::sort(order.begin(), order.end(), less);
+
+    std::vector<unsigned> classOf(count);
+    for (size_t i = 0; i < count; ++i) {
+        unsigned vertex = order[i];
+        if (i > 0) {
+            const glm::vec3& previous = mesh.vertices[order[i - 1]].position;
+            const glm::vec3& current = mesh.vertices[vertex].position;
+            if (previous.x == current.x && previous.y == current.y && previous.z == current.z) {
+                classOf[vertex] = classOf[order[i - 1]];
+                continue;
+            }
+        }
+        classOf[vertex] = vertex;
+    }
+    return classOf;
+}
+
+/**
+ * @brief Zwraca rozmiar siatki, względem którego liczone są błędy
+ * @param mesh Siatka
+ * @return Długość przekątnej prostopadłościanu otaczającego
+ */
+float MeshSimplifier::computeExtent(const MeshData& mesh) {
+    if (mesh.vertices.empty()) return 0.0f;
+    glm::vec3 minimum = mesh.vertices[0].position;
+    glm::vec3 maximum = minimum;
+    for (const Vertex& vertex : mesh.vertices) {
+        minimum.x = std::min(minimum.x, vertex.position.x);
+        minimum.y = std::min(minimum.y, vertex.position.y);
+        minimum.z = std::min(minimum.z, vertex.position.z);
+        maximum.x = std::max(maximum.x, vertex.position.x);
+        maximum.y = std::max(maximum.y, vertex.position.y);
+        maximum.z = std::max(maximum.z, vertex.position.z);
+    }
+    float dx = maximum.x - minimum.x;
+    float dy = maximum.y - minimum.y;
+    float dz = maximum.z - minimum.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/**
+ * @brief Upraszcza siatkę
+ * @param mesh Siatka wejściowa (trójkąty)
+ * @param options Cel i wagi upraszczania
+ * @param outError Osiągnięty błąd geometryczny względny (opcjonalnie)
+ * @return Uproszczona siatka (tylko używane wierzchołki)
+ *
+ * @details Każde przejście:
+ * 1. buduje posortowaną listę krawędzi skierowanych i na jej podstawie
+ *    rodzaje wierzchołków (krawędź bez przeciwnej jest otwarta, krawędź,
+ *    której przeciwna łączy inne warianty wierzchołków, leży na szwie),
+ * 2. równolegle liczy koszt ściągnięcia wzdłuż każdej krawędzi wraz
+ *    z przyporządkowaniem wariantów (każdy wariant ściąganego wierzchołka
+ *    musi mieć dokładnie jeden sąsiedni wariant wierzchołka docelowego),
+ * 3. od najtańszych wykonuje ściągnięcia, blokując otoczenie ściąganego
+ *    wierzchołka do końca przejścia,
+ * 4. przepisuje indeksy i usuwa zdegenerowane trójkąty.
+ * Kończy się po osiągnięciu celu liczby trójkątów, przekroczeniu błędu
+ * lub gdy przejście nie wykonało żadnego ściągnięcia.
+ */
+MeshData MeshSimplifier::simplify(const MeshData& mesh, const SimplifyOptions& options, float* outError) {
+    const size_t vertexCount = mesh.vertices.size();
+    std::vector<unsigned> indices = mesh.indices;
+    indices.resize(indices.size() - indices.size() % 3);
+
+    double extent = computeExtent(mesh);
+    double extentSq = extent > 0.0 ? extent * extent : 1.0;
+    double maxCost = static_cast<double>(options.targetError) * options.targetError;
+    double reachedDistance = 0.0;
+
+    std::vector<unsigned> classOf = weldPositions(mesh);
+    std::vector<unsigned> wedgeRemap(vertexCount);
+    std::iota(wedgeRemap.begin(), wedgeRemap.end(), 0u);
+    std::vector<Quadric> quadrics(vertexCount);
+
+    auto position = [&](unsigned v) -> const glm::vec3& { return mesh.vertices[v].position; };
+
+    // Kwadryki płaszczyzn trójkątów (ważone polem)
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        unsigned a = classOf[indices[t]], b = classOf[indices[t + 1]], c = classOf[indices[t + 2]];
+        double n[3];
+        triangleNormal(position(a), position(b), position(c), n);
+        double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length <= 0.0) continue;
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+        double d = -(n[0] * position(a).x + n[1] * position(a).y + n[2] * position(a).z);
+        addPlane(quadrics[a], n[0], n[1], n[2], d, length * 0.5);
+        addPlane(quadrics[b], n[0], n[1], n[2], d, length * 0.5);
+        addPlane(quadrics[c], n[0], n[1], n[2], d, length * 0.5);
+    }
+
+    std::vector<EdgeEntry> edges;
+    std::vector<VertexKind> kinds(vertexCount);
+    std::vector<unsigned char> wedgeCounts(vertexCount);
+    std::vector<unsigned> wedges(vertexCount * 2);
+    std::vector<unsigned char> borderOut(vertexCount), borderIn(vertexCount), seamEdges(vertexCount);
+    std::vector<unsigned char> nonManifold(vertexCount), usedWedge(vertexCount), locked(vertexCount);
+    std::vector<unsigned> adjacencyOffsets(vertexCount + 1);
+    std::vector<unsigned> adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<unsigned> oppositeOf;
+    std::vector<std::pair<float, unsigned>> order;
+    ThreadPool& pool = ThreadPool::instance();
+
+    for (int pass = 0; pass < MAX_PASSES; ++pass) {
+        size_t triangleCount = indices.size() / 3;
+        if (triangleCount <= options.targetTriangleCount || triangleCount == 0) break;
+
+        // 1. Trójkąty i krawędzie skierowane każdego wierzchołka topologii
+        //    (z każdego narożnika wychodzi jedna krawędź, więc oba podziały są takie same)
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (unsigned wedge : indices) adjacencyOffsets[classOf[wedge] + 1]++;
+        for (size_t v = 0; v < vertexCount; ++v) adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        adjacency.resize(indices.size());
+        edges.resize(indices.size());
+        {
+            std::vector<unsigned> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t corner = 0; corner < indices.size(); ++corner) {
+                size_t triangle = corner / 3;
+                unsigned wa = indices[corner];
+                unsigned wb = indices[triangle * 3 + (corner + 1) % 3];
+                unsigned slot = fill[classOf[wa]]++;
+                adjacency[slot] = static_cast<unsigned>(triangle);
+                edges[slot] = {edgeKey(classOf[wa], classOf[wb]), wa, wb, static_cast<unsigned>(triangle)};
+            }
+        }
+        // Po posortowaniu krótkich grup cała lista jest uporządkowana według klucza
+        pool.parallelFor(vertexCount, PARALLEL_BATCH, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                std::sort(edges.begin() + adjacencyOffsets[v], edges.begin() + adjacencyOffsets[v + 1],
+                          [](const EdgeEntry& x, const EdgeEntry& y) {
+                              return x.key != y.key ? x.key < y.key : x.triangle < y.triangle;
+                          });
+            }
+        });
+
+        // Krawędź przeciwna dla pierwszej krawędzi każdej grupy o tym samym kluczu
+        oppositeOf.resize(edges.size());
+        pool.parallelFor(edges.size(), PARALLEL_BATCH, [&](size_t begin, size_t end) {
+            auto keyLess = [](const EdgeEntry& x, uint64_t key) { return x.key < key; };
+            for (size_t e = begin; e < end; ++e) {
+                uint64_t key = edges[e].key;
+                if (e > 0 && edges[e - 1].key == key) {
+                    oppositeOf[e] = INNER_EDGE;
+                    continue;
+                }
+                uint64_t reversedKey = (key << 32) | (key >> 32);
+                unsigned b = static_cast<unsigned>(key & 0xffffffffu);
+                auto last = edges.begin() + adjacencyOffsets[b + 1];
+                auto opposite = std::lower_bound(edges.begin() + adjacencyOffsets[b], last, reversedKey, keyLess);
+                bool repeated = e + 1 < edges.size() && edges[e + 1].key == key;
+                if (opposite == last || opposite->key != reversedKey) {
+                    oppositeOf[e] = repeated ? NON_MANIFOLD_EDGE : NO_EDGE;
+                } else {
+                    bool manyOpposite = opposite + 1 != last && (opposite + 1)->key == reversedKey;
+                    oppositeOf[e] = repeated || manyOpposite ? NON_MANIFOLD_EDGE : static_cast<unsigned>(opposite - edges.begin());
+                }
+            }
+        });
+
+        // Warianty atrybutów każdego wierzchołka topologii
+        std::fill(wedgeCounts.begin(), wedgeCounts.end(), 0);
+        std::fill(usedWedge.begin(), usedWedge.end(), 0);
+        for (unsigned wedge : indices) {
+            if (usedWedge[wedge]) continue;
+            usedWedge[wedge] = 1;
+            unsigned v = classOf[wedge];
+            if (wedgeCounts[v] < 2) wedges[v * 2 + wedgeCounts[v]] = wedge;
+            if (wedgeCounts[v] < 255) wedgeCounts[v]++;
+        }
+
+        // 2. Rodzaje wierzchołków i kandydaci
+        std::fill(borderOut.begin(), borderOut.end(), 0);
+        std::fill(borderIn.begin(), borderIn.end(), 0);
+        std::fill(seamEdges.begin(), seamEdges.end(), 0);
+        std::fill(nonManifold.begin(), nonManifold.end(), 0);
+        collapses.clear();
+
+        for (size_t i = 0; i < edges.size(); ++i) {
+            unsigned oppositeIndex = oppositeOf[i];
+            if (oppositeIndex == INNER_EDGE) continue;
+            const EdgeEntry& edge = edges[i];
+            unsigned a = static_cast<unsigned>(edge.key >> 32);
+            unsigned b = static_cast<unsigned>(edge.key & 0xffffffffu);
+
+            if (oppositeIndex == NON_MANIFOLD_EDGE) {
+                nonManifold[a] = nonManifold[b] = 1;
+                continue;
+            }
+
+            bool border = oppositeIndex == NO_EDGE;
+            bool seam = false;
+            if (border) {
+                borderOut[a] = static_cast<unsigned char>(std::min(borderOut[a] + 1, 255));
+                borderIn[b] = static_cast<unsigned char>(std::min(borderIn[b] + 1, 255));
+            } else {
+                const EdgeEntry& opposite = edges[oppositeIndex];
+                seam = opposite.wedgeA != edge.wedgeB || opposite.wedgeB != edge.wedgeA;
+                if (seam) seamEdges[a] = static_cast<unsigned char>(std::min(seamEdges[a] + 1, 255));
+            }
+
+            // Płaszczyzny prostopadłe do krawędzi otwartych i szwów (raz, przed pierwszym ściągnięciem)
+            if (pass == 0 && (border || seam)) {
+                const glm::vec3& pa = position(a);
+                const glm::vec3& pb = position(b);
+                unsigned third = a;
+                for (int corner = 0; corner < 3; ++corner) {
+                    unsigned v = classOf[indices[edge.triangle * 3 + corner]];
+                    if (v != a && v != b) third = v;
+                }
+                const glm::vec3& pc = position(third);
+                double n[3];
+                triangleNormal(pa, pb, pc, n);
+                double e[3] = {static_cast<double>(pb.x) - pa.x, static_cast<double>(pb.y) - pa.y, static_cast<double>(pb.z) - pa.z};
+                double m[3] = {e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0]};
+                double length = std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+                if (length > 0.0) {
+                    m[0] /= length;
+                    m[1] /= length;
+                    m[2] /= length;
+                    double d = -(m[0] * pa.x + m[1] * pa.y + m[2] * pa.z);
+                    double weight = (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]) * (border ? BORDER_WEIGHT : SEAM_WEIGHT);
+                    addPlane(quadrics[a], m[0], m[1], m[2], d, weight);
+                    addPlane(quadrics[b], m[0], m[1], m[2], d, weight);
+                }
+            }
+
+            unsigned edgeIndex = static_cast<unsigned>(i);
+            collapses.push_back({a, b, edgeIndex, oppositeIndex, false, seam, {0, 0}, {0, 0}, 0.0f, 0.0f});
+            if (border) collapses.push_back({b, a, edgeIndex, oppositeIndex, true, seam, {0, 0}, {0, 0}, 0.0f, 0.0f});
+        }
+
+        for (size_t v = 0; v < vertexCount; ++v) {
+            if (wedgeCounts[v] == 0) continue;
+            if (nonManifold[v]) {
+                kinds[v] = VertexKind::LOCKED;
+            } else if (borderOut[v] || borderIn[v]) {
+                bool simpleBorder = wedgeCounts[v] == 1 && borderOut[v] == 1 && borderIn[v] == 1;
+                kinds[v] = simpleBorder && !options.lockBorders ? VertexKind::BORDER : VertexKind::LOCKED;
+            } else if (wedgeCounts[v] == 1) {
+                kinds[v] = VertexKind::MANIFOLD;
+            } else if (wedgeCounts[v] == 2 && seamEdges[v] == 2) {
+                kinds[v] = VertexKind::SEAM;
+            } else {
+                kinds[v] = VertexKind::LOCKED;
+            }
+        }
+
+        // Koszty ściągnięć (równolegle)
+        const float infinity = std::numeric_limits<float>::infinity();
+        pool.parallelFor(collapses.size(), PARALLEL_BATCH, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                Collapse& collapse = collapses[c];
+                collapse.cost = infinity;
+                VertexKind kind = kinds[collapse.from];
+                if (kind == VertexKind::LOCKED) continue;
+                if (kind == VertexKind::BORDER && collapse.opposite != NO_EDGE) continue;
+                if (kind == VertexKind::SEAM && !collapse.seam) continue;
+
+                // Każdy wariant ściąganego wierzchołka musi mieć jeden sąsiedni wariant docelowego
+                const EdgeEntry& edge = edges[collapse.edge];
+                unsigned pairsFrom[2] = {collapse.reversed ? edge.wedgeB : edge.wedgeA, 0};
+                unsigned pairsTo[2] = {collapse.reversed ? edge.wedgeA : edge.wedgeB, 0};
+                int pairCount = 1;
+                if (collapse.opposite != NO_EDGE) {
+                    pairsFrom[1] = edges[collapse.opposite].wedgeB;
+                    pairsTo[1] = edges[collapse.opposite].wedgeA;
+                    pairCount = 2;
+                }
+
+                int count = wedgeCounts[collapse.from];
+                bool valid = true;
+                for (int w = 0; w < count && valid; ++w) {
+                    unsigned wedge = wedges[collapse.from * 2 + w];
+                    unsigned target = 0;
+                    bool found = false;
+                    for (int p = 0; p < pairCount; ++p) {
+                        if (pairsFrom[p] != wedge) continue;
+                        if (found && pairsTo[p] != target) valid = false;
+                        target = pairsTo[p];
+                        found = true;
+                    }
+                    valid = valid && found;
+                    collapse.wedgeFrom[w] = wedge;
+                    collapse.wedgeTo[w] = target;
+                }
+                if (!valid) continue;
+
+                // Błąd geometryczny (średni kwadrat odległości względem rozmiaru siatki)
+                Quadric q = quadrics[collapse.from];
+                addQuadric(q, quadrics[collapse.to]);
+                double cost = q.weight > 0.0 ? evaluateQuadric(q, position(collapse.to)) / q.weight / extentSq : 0.0;
+
+                // Błąd atrybutów (największy z wariantów)
+                double attributeCost = 0.0;
+                for (int w = 0; w < count; ++w) {
+                    const Vertex& from = mesh.vertices[collapse.wedgeFrom[w]];
+                    const Vertex& to = mesh.vertices[collapse.wedgeTo[w]];
+                    double dnx = from.normal.x - to.normal.x, dny = from.normal.y - to.normal.y, dnz = from.normal.z - to.normal.z;
+                    double du = from.texCoord.x - to.texCoord.x, dv = from.texCoord.y - to.texCoord.y;
+                    attributeCost = std::max(attributeCost, options.normalWeight * (dnx * dnx + dny * dny + dnz * dnz) +
+                                                            options.uvWeight * (du * du + dv * dv));
+                }
+                collapse.cost = static_cast<float>(cost + attributeCost);
+                collapse.distance = static_cast<float>(cost);
+            }
+        });
+
+        // 3. Ściągnięcia od najtańszych
+        order.clear();
+        for (size_t c = 0; c < collapses.size(); ++c) {
+            if (collapses[c].cost <= maxCost) order.push_back({collapses[c].cost, static_cast<unsigned>(c)});
+        }
+        std::sort(order.begin(), order.end());
+
+        std::fill(locked.begin(), locked.end(), 0);
+        size_t remaining = triangleCount;
+        size_t applied = 0;
+        for (const auto& [cost, c] : order) {
+            const Collapse& collapse = collapses[c];
+            if (remaining <= options.targetTriangleCount) break;
+            if (locked[collapse.from] || locked[collapse.to]) continue;
+
+            // Ściągnięcie nie może odwrócić żadnego z pozostałych trójkątów
+            size_t removed = 0;
+            bool flips = false;
+            for (unsigned k = adjacencyOffsets[collapse.from]; k < adjacencyOffsets[collapse.from + 1] && !flips; ++k) {
+                unsigned t = adjacency[k];
+                unsigned v[3] = {classOf[indices[t * 3]], classOf[indices[t * 3 + 1]], classOf[indices[t * 3 + 2]]};
+                if (v[0] == collapse.to || v[1] == collapse.to || v[2] == collapse.to) {
+                    removed++;
+                    continue;
+                }
+                double before[3], after[3];
+                triangleNormal(position(v[0]), position(v[1]), position(v[2]), before);
+                for (unsigned& corner : v) {
+                    if (corner == collapse.from) corner = collapse.to;
+                }
+                triangleNormal(position(v[0]), position(v[1]), position(v[2]), after);
+                flips = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0;
+            }
+            if (flips) continue;
+
+            for (int w = 0; w < wedgeCounts[collapse.from]; ++w) {
+                wedgeRemap[collapse.wedgeFrom[w]] = collapse.wedgeTo[w];
+            }
+            addQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+
+            // Otoczenie ściąganego wierzchołka nie zmienia się do końca przejścia
+            locked[collapse.from] = locked[collapse.to] = 1;
+            for (unsigned k = adjacencyOffsets[collapse.from]; k < adjacencyOffsets[collapse.from + 1]; ++k) {
+                unsigned t = adjacency[k];
+                for (int corner = 0; corner < 3; ++corner) locked[classOf[indices[t * 3 + corner]]] = 1;
+            }
+
+            remaining -= std::min(removed, remaining);
+            reachedDistance = std::max(reachedDistance, static_cast<double>(collapse.distance));
+            applied++;
+        }
+        if (applied == 0) break;
+
+        // 4. Nowe indeksy bez zdegenerowanych trójkątów
+        size_t write = 0;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            unsigned w0 = wedgeRemap[indices[t * 3]];
+            unsigned w1 = wedgeRemap[indices[t * 3 + 1]];
+            unsigned w2 = wedgeRemap[indices[t * 3 + 2]];
+            unsigned c0 = classOf[w0], c1 = classOf[w1], c2 = classOf[w2];
+            if (c0 == c1 || c1 == c2 || c0 == c2) continue;
+            indices[write++] = w0;
+            indices[write++] = w1;
+            indices[write++] = w2;
+        }
+        indices.resize(write);
+    }
+
+    // Tylko używane wierzchołki, w kolejności pierwszego użycia
+    MeshData result;
+    std::vector<unsigned> compact(vertexCount, std::numeric_limits<unsigned>::max());
+    result.indices.reserve(indices.size());
+    for (unsigned wedge : indices) {
+        if (compact[wedge] == std::numeric_limits<unsigned>::max()) {
+            compact[wedge] = static_cast<unsigned>(result.vertices.size());
+            result.vertices.push_back(mesh.vertices[wedge]);
+        }
+        result.indices.push_back(compact[wedge]);
+    }
+
+    if (outError) *outError = static_cast<float>(std::sqrt(reachedDistance));
+    return result;
+}
@@ -0,0 +1,66 @@
+// MeshSimplifier.hpp
+#ifndef MESH_SIMPLIFIER_HPP
+#define MESH_SIMPLIFIER_HPP
+
+#include <cstddef>
+#include "../GeometryRenderer.hpp"
+
+/**
+ * @struct SimplifyOptions
+ * @brief Parametry upraszczania siatki
+ *
+ * Błędy podawane są względem rozmiaru siatki (przekątnej prostopadłościanu
+ * otaczającego), więc te same wartości działają dla modeli w dowolnej skali.
+ */
+struct SimplifyOptions {
+    size_t targetTriangleCount = 0;     /**< Docelowa liczba trójkątów (upraszczanie kończy się po jej osiągnięciu) */
+    float targetError = 0.01f;          /**< Największy dopuszczalny błąd względny */
+    float normalWeight = 0.01f;         /**< Waga różnicy normalnych w błędzie */
+    float uvWeight = 0.01f;             /**< Waga różnicy współrzędnych tekstury w błędzie */
+    bool lockBorders = false;           /**< Czy wierzchołki krawędzi otwartych są nieruchome */
+};
+
+/**
+ * @class MeshSimplifier
+ * @brief Upraszczanie siatek przez ściąganie krawędzi z metryką kwadryk (QEM)
+ *
+ * Wierzchołki o tej samej pozycji (np. po obu stronach szwu tekstury lub
+ * krawędzi z różnymi normalnymi) łączone są w jeden wierzchołek topologii.
+ * Każdy z nich dostaje kwadrykę z płaszczyzn sąsiednich trójkątów
+ * (ważonych polem) oraz płaszczyzn prostopadłych do krawędzi otwartych
+ * i szwów, które utrzymują ich kształt.
+ *
+ * Wierzchołek ściągany jest do sąsiada (bez tworzenia nowych pozycji),
+ * więc atrybuty pozostają poprawne. Dozwolone ruchy zależą od rodzaju:
+ * - zwykły - do dowolnego sąsiada,
+ * - brzegowy - tylko wzdłuż krawędzi otwartej,
+ * - na szwie (dwa warianty atrybutów) - tylko wzdłuż szwu, oba warianty naraz,
+ * - pozostałe (narożniki szwów, krawędzie niemanifoldowe) są nieruchome.
+ * Błąd ściągnięcia to średni kwadrat odległości od płaszczyzn kwadryki
+ * powiększony o ważone różnice normalnych i UV.
+ *
+ * Praca przebiega w przejściach: koszty wszystkich krawędzi liczone są
+ * równolegle na wątkach ThreadPool, a następnie od najtańszych wykonywane
+ * są ściągnięcia, które nie dotykają otoczenia innych ściągnięć tego
+ * przejścia i nie odwracają trójkątów.
+ */
+class MeshSimplifier {
+public:
+    /**
+     * @brief Upraszcza siatkę
+     * @param mesh Siatka wejściowa (trójkąty)
+     * @param options Cel i wagi upraszczania
+     * @param outError Osiągnięty błąd geometryczny względny (opcjonalnie)
+     * @return Uproszczona siatka (tylko używane wierzchołki)
+     */
+    static MeshData simplify(const MeshData& mesh, const SimplifyOptions& options, float* outError = nullptr);
+
+    /**
+     * @brief Zwraca rozmiar siatki, względem którego liczone są błędy
+     * @param mesh Siatka
+     * @return Długość przekątnej prostopadłościanu otaczającego
+     */
+    static float computeExtent(const MeshData& mesh);
+};
+
+#endif // MESH_SIMPLIFIER_HPP
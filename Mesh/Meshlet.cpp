@@ -0,0 +1,175 @@
+// Meshlet.cpp
+#include "Meshlet.hpp"
+#include "../GeometryRenderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Wyznacza sferę otaczającą i stożek normalnych meshletu
+ * @param mesh Siatka
+ * @param indices Indeksy trójkątów meshletu
+ * @param indexCount Liczba indeksów
+ * @param meshlet Meshlet do uzupełnienia
+ *
+ * @details Oś stożka to znormalizowana suma normalnych trójkątów.
+ * Gdy któraś normalna odchyla się od osi o ponad ~84 stopnie, stożek
+ * jest zbyt szeroki, by cokolwiek odrzucić, i coneCutoff wynosi 1.
+ */
+static void computeMeshletBounds(const MeshData& mesh, const unsigned* indices, size_t indexCount, Meshlet& meshlet) {
+    glm::vec3 center(0.0f);
+    for (size_t i = 0; i < indexCount; ++i) {
+        center += mesh.vertices[indices[i]].position;
+    }
+    center /= static_cast<float>(indexCount);
+
+    float radiusSq = 0.0f;
+    for (size_t i = 0; i < indexCount; ++i) {
+        glm::vec3 offset = mesh.vertices[indices[i]].position - center;
+        radiusSq = std::max(radiusSq, offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+    }
+    meshlet.bounds = {center, std::sqrt(radiusSq)};
+
+    // Normalne trójkątów (zdegenerowane pomijane)
+    glm::vec3 normals[MeshletBuilder::MAX_TRIANGLES];
+    size_t normalCount = 0;
+    glm::vec3 axis(0.0f);
+    for (size_t i = 0; i + 2 < indexCount && normalCount < MeshletBuilder::MAX_TRIANGLES; i += 3) {
+        const glm::vec3& p0 = mesh.vertices[indices[i]].position;
+        glm::vec3 e1 = mesh.vertices[indices[i + 1]].position - p0;
+        glm::vec3 e2 = mesh.vertices[indices[i + 2]].position - p0;
+        glm::vec3 n(e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x);
+        float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        if (length <= 0.0f) continue;
+        n /= length;
+        normals[normalCount++] = n;
+        axis += n;
+    }
+
+    float axisLength = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    meshlet.coneAxis = axisLength > 0.0f ? axis / axisLength : glm::vec3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = 1.0f;
+    if (normalCount == 0 || axisLength <= 0.0f) return;
+
+    float minDot = 1.0f;
+    for (size_t i = 0; i < normalCount; ++i) {
+        const glm::vec3& n = normals[i];
+        minDot = std::min(minDot, n.x * meshlet.coneAxis.x + n.y * meshlet.coneAxis.y + n.z * meshlet.coneAxis.z);
+    }
+    if (minDot > 0.1f) {
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+}
+
+/**
+ * @brief Dzieli siatkę na meshlety
+ * @param mesh Siatka (indeksy są przestawiane w kolejności meshletów)
+ * @param maxVertices Limit wierzchołków meshletu
+ * @param maxTriangles Limit trójkątów meshletu
+ * @return Meshlety w kolejności bufora indeksów
+ *
+ * @details Dla każdego nieprzydzielonego trójkąta (w kolejności bufora)
+ * zaczyna nowy meshlet i dokłada do niego trójkąty z frontu - sąsiadów
+ * dodanych trójkątów - aż do wyczerpania limitów lub frontu.
+ */
+std::vector<Meshlet> MeshletBuilder::build(MeshData& mesh, size_t maxVertices, size_t maxTriangles) {
+    maxTriangles = std::min(std::max<size_t>(maxTriangles, 1), MAX_TRIANGLES);
+    maxVertices = std::max<size_t>(maxVertices, 3);
+
+    const size_t triangleCount = mesh.indices.size() / 3;
+    const size_t vertexCount = mesh.vertices.size();
+    std::vector<Meshlet> meshlets;
+    if (triangleCount == 0) return meshlets;
+
+    // Trójkąty każdego wierzchołka
+    std::vector<unsigned> offsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) offsets[mesh.indices[i] + 1]++;
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+    std::vector<unsigned> vertexTriangles(triangleCount * 3);
+    {
+        std::vector<unsigned> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            vertexTriangles[fill[mesh.indices[i]]++] = static_cast<unsigned>(i / 3);
+        }
+    }
+
+    std::vector<glm::vec3> centroids(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        centroids[t] = (mesh.vertices[mesh.indices[t * 3]].position +
+                        mesh.vertices[mesh.indices[t * 3 + 1]].position +
+                        mesh.vertices[mesh.indices[t * 3 + 2]].position) / 3.0f;
+    }
+
+    const unsigned NONE = std::numeric_limits<unsigned>::max();
+    std::vector<unsigned char> assigned(triangleCount, 0);
+    std::vector<unsigned> vertexMeshlet(vertexCount, NONE);     // Meshlet, do którego należy wierzchołek
+    std::vector<unsigned> candidateMeshlet(triangleCount, NONE); // Meshlet, na którego froncie jest trójkąt
+    std::vector<unsigned> candidates;
+    std::vector<unsigned> reordered;
+    reordered.reserve(triangleCount * 3);
+
+    for (size_t seed = 0; seed < triangleCount; ++seed) {
+        if (assigned[seed]) continue;
+
+        unsigned id = static_cast<unsigned>(meshlets.size());
+        Meshlet meshlet = {};
+        meshlet.indexOffset = static_cast<unsigned>(reordered.size());
+        glm::vec3 centroidSum(0.0f);
+        candidates.clear();
+        unsigned next = static_cast<unsigned>(seed);
+
+        while (next != NONE) {
+            // Dodanie trójkąta
+            assigned[next] = 1;
+            for (int k = 0; k < 3; ++k) {
+                unsigned v = mesh.indices[next * 3 + k];
+                reordered.push_back(v);
+                if (vertexMeshlet[v] != id) {
+                    vertexMeshlet[v] = id;
+                    meshlet.vertexCount++;
+                }
+                for (unsigned i = offsets[v]; i < offsets[v + 1]; ++i) {
+                    unsigned neighbour = vertexTriangles[i];
+                    if (!assigned[neighbour] && candidateMeshlet[neighbour] != id) {
+                        candidateMeshlet[neighbour] = id;
+                        candidates.push_back(neighbour);
+                    }
+                }
+            }
+            meshlet.triangleCount++;
+            centroidSum += centroids[next];
+            if (meshlet.triangleCount >= maxTriangles) break;
+
+            // Najlepszy trójkąt frontu: najmniej nowych wierzchołków, potem najbliższy środka
+            glm::vec3 center = centroidSum / static_cast<float>(meshlet.triangleCount);
+            next = NONE;
+            int bestNew = 4;
+            float bestDistance = 0.0f;
+            size_t write = 0;
+            for (unsigned candidate : candidates) {
+                if (assigned[candidate]) continue;
+                int newVertices = 0;
+                for (int k = 0; k < 3; ++k) {
+                    if (vertexMeshlet[mesh.indices[candidate * 3 + k]] != id) newVertices++;
+                }
+                if (meshlet.vertexCount + newVertices > maxVertices) continue;
+                candidates[write++] = candidate;
+
+                glm::vec3 offset = centroids[candidate] - center;
+                float distance = offset.x * offset.x + offset.y * offset.y + offset.z * offset.z;
+                if (newVertices < bestNew || (newVertices == bestNew && distance < bestDistance)) {
+                    next = candidate;
+                    bestNew = newVertices;
+                    bestDistance = distance;
+                }
+            }
+            candidates.resize(write);
+        }
+
+        computeMeshletBounds(mesh, reordered.data() + meshlet.indexOffset, meshlet.triangleCount * 3, meshlet);
+        meshlets.push_back(meshlet);
+    }
+
+    mesh.indices = std::move(reordered);
+    return meshlets;
+}
@@ -0,0 +1,54 @@
+// Meshlet.hpp
+#ifndef MESHLET_HPP
+#define MESHLET_HPP
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../Math/Bounds.hpp"
+
+struct MeshData;
+
+/**
+ * @struct Meshlet
+ * @brief Mały, zwarty fragment siatki z danymi do odrzucania
+ *
+ * Trójkąty meshletu zajmują ciągły zakres bufora indeksów, więc widoczne
+ * meshlety rysowane są jako zakresy jednego glMultiDrawElements.
+ */
+struct Meshlet {
+    unsigned indexOffset;       /**< Pierwszy indeks w buforze indeksów */
+    unsigned triangleCount;     /**< Liczba trójkątów */
+    unsigned vertexCount;       /**< Liczba różnych wierzchołków */
+    BoundingSphere bounds;      /**< Sfera otaczająca w przestrzeni lokalnej */
+    glm::vec3 coneAxis;         /**< Średnia normalna trójkątów */
+    float coneCutoff;           /**< Sinus połowy kąta stożka normalnych (1 = stożek nie pozwala odrzucać) */
+};
+
+/**
+ * @class MeshletBuilder
+ * @brief Podział siatki na meshlety
+ *
+ * Meshlet rośnie od trójkąta startowego przez sąsiadów (wspólne
+ * wierzchołki), wybierając trójkąty dodające najmniej nowych wierzchołków,
+ * a przy remisie najbliższe środkowi meshletu. Dzięki temu meshlety są
+ * zwarte i mają wąskie stożki normalnych, co pozwala odrzucać całe
+ * fragmenty odwrócone tyłem do obserwatora.
+ */
+class MeshletBuilder {
+public:
+    static const size_t MAX_VERTICES = 64;      /**< Domyślny limit wierzchołków meshletu */
+    static const size_t MAX_TRIANGLES = 124;    /**< Domyślny limit trójkątów meshletu */
+
+    /**
+     * @brief Dzieli siatkę na meshlety
+     * @param mesh Siatka (indeksy są przestawiane w kolejności meshletów)
+     * @param maxVertices Limit wierzchołków meshletu
+     * @param maxTriangles Limit trójkątów meshletu
+     * @return Meshlety w kolejności bufora indeksów
+     */
+    static std::vector<Meshlet> build(MeshData& mesh, size_t maxVertices = MAX_VERTICES,
+                                      size_t maxTriangles = MAX_TRIANGLES);
+};
+
+#endif // MESHLET_HPP
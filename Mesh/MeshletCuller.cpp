@@ -0,0 +1,135 @@
+// MeshletCuller.cpp
+#include "MeshletCuller.hpp"
+#include "../Stats/RenderStats.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Konstruktor prywatny (singleton)
+ *
+ * Bez ustawionego widoku ostrosłup nie odrzuca niczego.
+ */
+MeshletCuller::MeshletCuller()
+    : m_viewPosition(0.0f), m_enabled(true),
+      m_totalMeshlets(0), m_frustumCulled(0), m_coneCulled(0), m_drawRanges(0) {
+    for (glm::vec4& plane : m_frustum.planes) {
+        plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+}
+
+/**
+ * @brief Zwraca globalną instancję
+ * @return Referencja do instancji
+ */
+MeshletCuller& MeshletCuller::instance() {
+    static MeshletCuller culler;
+    return culler;
+}
+
+/**
+ * @brief Ustawia bieżący widok
+ * @param position Pozycja obserwatora
+ * @param viewProjection Iloczyn projection * view
+ */
+void MeshletCuller::setView(const glm::vec3& position, const glm::mat4& viewProjection) {
+    m_viewPosition = position;
+    m_frustum = Frustum::fromMatrix(viewProjection);
+}
+
+/**
+ * @brief Zeruje liczniki klatki
+ */
+void MeshletCuller::beginFrame() {
+    m_totalMeshlets = 0;
+    m_frustumCulled = 0;
+    m_coneCulled = 0;
+    m_drawRanges = 0;
+}
+
+/**
+ * @brief Wyznacza zakresy widocznych meshletów
+ * @param meshlets Meshlety siatki
+ * @param model Macierz modelu
+ * @param drawList Wynikowe zakresy (czyszczone)
+ * @return Liczba widocznych meshletów
+ *
+ * @details Test stożka (wersja zachowawcza ze sferą otaczającą):
+ * meshlet jest odwrócony tyłem, gdy
+ * dot(środek - obserwator, oś) >= cutoff * |środek - obserwator| + promień.
+ * Dla cutoff = 1 warunek nigdy nie zachodzi.
+ */
+size_t MeshletCuller::cull(const std::vector<Meshlet>& meshlets, const glm::mat4& model, MeshletDrawList& drawList) {
+    drawList.counts.clear();
+    drawList.offsets.clear();
+    m_totalMeshlets += meshlets.size();
+
+    // Oś stożka można przekształcić macierzą modelu tylko przy skali jednorodnej
+    float scaleX = glm::length(glm::vec3(model[0]));
+    float scaleY = glm::length(glm::vec3(model[1]));
+    float scaleZ = glm::length(glm::vec3(model[2]));
+    float maxScale = std::max(scaleX, std::max(scaleY, scaleZ));
+    float minScale = std::min(scaleX, std::min(scaleY, scaleZ));
+    bool coneTest = m_enabled && minScale > 0.0f && maxScale - minScale <= maxScale * 0.01f;
+    glm::mat3 rotation(model);
+    // Odbicie lustrzane zamienia kierunek nawijania trójkątów
+    bool mirrored = glm::dot(glm::cross(glm::vec3(model[0]), glm::vec3(model[1])), glm::vec3(model[2])) < 0.0f;
+
+    size_t visible = 0;
+    for (const Meshlet& meshlet : meshlets) {
+        if (m_enabled) {
+            BoundingSphere bounds = meshlet.bounds.transformed(model);
+            if (!m_frustum.intersects(bounds)) {
+                m_frustumCulled++;
+                continue;
+            }
+            if (coneTest && meshlet.coneCutoff < 1.0f) {
+                glm::vec3 axis = rotation * meshlet.coneAxis / maxScale;
+                if (mirrored) axis = -axis;
+                glm::vec3 offset = bounds.center - m_viewPosition;
+                if (glm::dot(offset, axis) >= meshlet.coneCutoff * glm::length(offset) + bounds.radius) {
+                    m_coneCulled++;
+                    continue;
+                }
+            }
+        }
+
+        visible++;
+        GLsizei count = static_cast<GLsizei>(meshlet.triangleCount * 3);
+        const char* offset = reinterpret_cast<const char*>(static_cast<size_t>(meshlet.indexOffset) * sizeof(unsigned int));
+        if (!drawList.counts.empty() &&
+            static_cast<const char*>(drawList.offsets.back()) + drawList.counts.back() * sizeof(unsigned int) == offset) {
+            drawList.counts.back() += count;
+        } else {
+            drawList.counts.push_back(count);
+            drawList.offsets.push_back(offset);
+        }
+    }
+    m_drawRanges += drawList.counts.size();
+    return visible;
+}
+
+/**
+ * @brief Rysuje widoczne meshlety siatki (VAO musi być związane)
+ * @param meshlets Meshlety siatki
+ * @param model Macierz modelu
+ * @param mode Tryb rysowania OpenGL
+ */
+void MeshletCuller::draw(const std::vector<Meshlet>& meshlets, const glm::mat4& model, GLenum mode) {
+    if (cull(meshlets, model, m_drawList) == 0) return;
+    glMultiDrawElements(mode, m_drawList.counts.data(), GL_UNSIGNED_INT, m_drawList.offsets.data(),
+                        static_cast<GLsizei>(m_drawList.counts.size()));
+}
+
+/**
+ * @brief Publikuje liczniki klatki w RenderStats
+ */
+void MeshletCuller::publishStats() const {
+    RenderStats& stats = RenderStats::instance();
+    size_t culled = m_frustumCulled + m_coneCulled;
+    stats.setValue("Meshlety/Sprawdzone", static_cast<double>(m_totalMeshlets));
+    stats.setValue("Meshlety/Odrzucone ostroslupem", static_cast<double>(m_frustumCulled));
+    stats.setValue("Meshlety/Odrzucone stozkiem", static_cast<double>(m_coneCulled));
+    stats.setValue("Meshlety/Odrzucone [%]",
+                   m_totalMeshlets > 0 ? 100.0 * static_cast<double>(culled) / m_totalMeshlets : 0.0);
+    stats.setValue("Meshlety/Zakresy rysowania", static_cast<double>(m_drawRanges));
+}
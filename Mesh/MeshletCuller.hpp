@@ -0,0 +1,104 @@
+// MeshletCuller.hpp
+#ifndef MESHLET_CULLER_HPP
+#define MESHLET_CULLER_HPP
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include <GL/glew.h>
+#include "Meshlet.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @struct MeshletDrawList
+ * @brief Zakresy indeksów widocznych meshletów dla glMultiDrawElements
+ *
+ * Sąsiednie widoczne meshlety łączone są w jeden zakres.
+ */
+struct MeshletDrawList {
+    std::vector<GLsizei> counts;            /**< Liczba indeksów zakresu */
+    std::vector<const void*> offsets;       /**< Przesunięcie zakresu w buforze indeksów (w bajtach) */
+};
+
+/**
+ * @class MeshletCuller
+ * @brief Odrzucanie meshletów na CPU dla bieżącego widoku
+ *
+ * Meshlet jest pomijany, gdy jego sfera otaczająca leży poza ostrosłupem
+ * widzenia albo gdy cały stożek normalnych jest odwrócony od obserwatora
+ * (wszystkie trójkąty byłyby odrzucone przez GL_CULL_FACE). Test stożka
+ * wymaga skali jednorodnej; przy niejednorodnej jest pomijany.
+ * Liczniki zbierane są w trakcie klatki i publikowane w RenderStats.
+ */
+class MeshletCuller {
+private:
+    glm::vec3 m_viewPosition;       /**< Pozycja obserwatora bieżącego widoku */
+    Frustum m_frustum;              /**< Ostrosłup bieżącego widoku */
+    bool m_enabled;                 /**< Czy odrzucanie jest włączone */
+    MeshletDrawList m_drawList;     /**< Bufor zakresów (wielokrotnego użytku) */
+
+    size_t m_totalMeshlets;         /**< Meshlety sprawdzone w klatce */
+    size_t m_frustumCulled;         /**< Odrzucone przez ostrosłup */
+    size_t m_coneCulled;            /**< Odrzucone przez stożek normalnych */
+    size_t m_drawRanges;            /**< Zakresy wysłane do glMultiDrawElements */
+
+    /**
+     * @brief Konstruktor prywatny (singleton)
+     */
+    MeshletCuller();
+
+public:
+    /**
+     * @brief Zwraca globalną instancję
+     * @return Referencja do instancji
+     */
+    static MeshletCuller& instance();
+
+    /**
+     * @brief Ustawia bieżący widok
+     * @param position Pozycja obserwatora
+     * @param viewProjection Iloczyn projection * view
+     */
+    void setView(const glm::vec3& position, const glm::mat4& viewProjection);
+
+    /**
+     * @brief Włącza lub wyłącza odrzucanie
+     * @param enabled true = odrzucanie meshletów, false = rysowanie całości
+     */
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+
+    /**
+     * @brief Sprawdza, czy odrzucanie jest włączone
+     * @return true jeśli włączone
+     */
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Zeruje liczniki klatki
+     */
+    void beginFrame();
+
+    /**
+     * @brief Wyznacza zakresy widocznych meshletów
+     * @param meshlets Meshlety siatki
+     * @param model Macierz modelu
+     * @param drawList Wynikowe zakresy (czyszczone)
+     * @return Liczba widocznych meshletów
+     */
+    size_t cull(const std::vector<Meshlet>& meshlets, const glm::mat4& model, MeshletDrawList& drawList);
+
+    /**
+     * @brief Rysuje widoczne meshlety siatki (VAO musi być związane)
+     * @param meshlets Meshlety siatki
+     * @param model Macierz modelu
+     * @param mode Tryb rysowania OpenGL
+     */
+    void draw(const std::vector<Meshlet>& meshlets, const glm::mat4& model, GLenum mode = GL_TRIANGLES);
+
+    /**
+     * @brief Publikuje liczniki klatki w RenderStats
+     */
+    void publishStats() const;
+};
+
+#endif // MESHLET_CULLER_HPP
@@ -0,0 +1,508 @@
+// PrimitiveData.hpp
+#ifndef PRIMITIVE_DATA_HPP
+#define PRIMITIVE_DATA_HPP
+
+#include <array>
+#include <cstddef>
+#include "MeshBuilder.hpp"
+
+/**
+ * @namespace Primitives
+ * @brief Siatki podstawowych kształtów generowane w czasie kompilacji
+ *
+ * Generatory są funkcjami consteval, a wyniki zmiennymi inline constexpr,
+ * więc wierzchołki i indeksy trafiają do danych tylko do odczytu pliku
+ * wykonywalnego. Utworzenie kształtu przy starcie to wyłącznie wysłanie
+ * gotowej tablicy do bufora GPU, bez funkcji trygonometrycznych i alokacji.
+ *
+ * Kształty o parametrach innych niż domyślne nadal tworzy MeshBuilder
+ * w czasie działania programu. Układ danych odpowiada MeshBuilder
+ * (ta sama kolejność wierzchołków i indeksów).
+ */
+namespace Primitives {
+
+/**
+ * @struct PackedVertex
+ * @brief Wierzchołek o układzie identycznym z Vertex, dostępny w constexpr
+ *
+ * Typy glm nie są konstruowalne w wyrażeniach stałych we wszystkich
+ * wersjach biblioteki, dlatego dane zapisywane są w zwykłych tablicach.
+ */
+struct PackedVertex {
+    float position[3];  /**< Pozycja */
+    float normal[3];    /**< Normalna */
+    float texCoord[2];  /**< Współrzędne tekstury */
+};
+
+static_assert(sizeof(PackedVertex) == sizeof(Vertex), "PackedVertex musi mieć układ Vertex");
+static_assert(offsetof(PackedVertex, normal) == offsetof(Vertex, normal), "PackedVertex musi mieć układ Vertex");
+static_assert(offsetof(PackedVertex, texCoord) == offsetof(Vertex, texCoord), "PackedVertex musi mieć układ Vertex");
+
+/**
+ * @struct PrimitiveArrays
+ * @brief Wierzchołki i indeksy siatki o rozmiarze znanym w czasie kompilacji
+ * @tparam VertexCount Liczba wierzchołków
+ * @tparam IndexCount Liczba indeksów
+ */
+template <size_t VertexCount, size_t IndexCount>
+struct PrimitiveArrays {
+    std::array<PackedVertex, VertexCount> vertices;     /**< Wierzchołki */
+    std::array<unsigned int, IndexCount> indices;       /**< Indeksy trójkątów */
+};
+
+/**
+ * @namespace Primitives::ConstMath
+ * @brief Funkcje matematyczne obliczane w czasie kompilacji
+ *
+ * std::sin, std::cos i std::sqrt nie są constexpr w C++20. Obliczenia
+ * wykonywane są w double, więc wynik po zaokrągleniu do float różni się
+ * od cosf/sinf co najwyżej o pojedyncze ULP.
+ */
+namespace ConstMath {
+
+constexpr double PI = 3.14159265358979323846;   /**< Liczba pi */
+
+/**
+ * @brief Sinus (szereg Taylora po redukcji do [-pi/2, pi/2])
+ * @param x Kąt w radianach
+ * @return sin(x)
+ */
+constexpr double sin(double x) {
+    long long turns = static_cast<long long>(x / (2.0 * PI));
+    x -= static_cast<double>(turns) * 2.0 * PI;
+    if (x > PI) x -= 2.0 * PI;
+    else if (x < -PI) x += 2.0 * PI;
+    if (x > PI / 2.0) x = PI - x;
+    else if (x < -PI / 2.0) x = -PI - x;
+
+    double x2 = x * x;
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; ++n) {
+        term *= -x2 / static_cast<double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Cosinus
+ * @param x Kąt w radianach
+ * @return cos(x)
+ */
+constexpr double cos(double x) {
+    return sin(x + PI / 2.0);
+}
+
+/**
+ * @brief Pierwiastek kwadratowy (metoda Newtona)
+ * @param value Liczba nieujemna
+ * @return sqrt(value)
+ */
+constexpr double sqrt(double value) {
+    if (value <= 0.0) return 0.0;
+    double x = value > 1.0 ? value : 1.0;
+    for (int i = 0; i < 64; ++i) {
+        double next = 0.5 * (x + value / x);
+        if (next == x) break;
+        x = next;
+    }
+    return x;
+}
+
+} // namespace ConstMath
+
+/**
+ * @brief Tworzy wierzchołek (pozycja i normalna obliczone w double)
+ * @return Wierzchołek
+ */
+constexpr PackedVertex makeVertex(double px, double py, double pz, double nx, double ny, double nz, double u, double v) {
+    return {{static_cast<float>(px), static_cast<float>(py), static_cast<float>(pz)},
+            {static_cast<float>(nx), static_cast<float>(ny), static_cast<float>(nz)},
+            {static_cast<float>(u), static_cast<float>(v)}};
+}
+
+/**
+ * @brief Zwraca liczniki stożka
+ * @param sectors Liczba sektorów
+ * @return Wierzchołek, środek podstawy i po 3 wierzchołki na punkt obwodu
+ */
+constexpr MeshCounts coneCounts(int sectors) {
+    return {2 + 3 * static_cast<size_t>(sectors + 1), 6 * static_cast<size_t>(sectors)};
+}
+
+/**
+ * @brief Sprawdza, czy wszystkie indeksy wskazują istniejące wierzchołki
+ * @param primitive Siatka
+ * @return true jeśli indeksy są poprawne
+ */
+template <size_t V, size_t I>
+constexpr bool indicesInRange(const PrimitiveArrays<V, I>& primitive) {
+    for (unsigned int index : primitive.indices) {
+        if (index >= V) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Generuje sześcian jednostkowy ze środkiem w (0,0,0)
+ * @return 24 wierzchołki (po 4 na ścianę), 36 indeksów
+ */
+consteval PrimitiveArrays<24, 36> makeCube() {
+    return {{{
+        // Front
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
+        {{-0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
+
+        // Back
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f}},
+        {{-0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 1.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
+
+        // Top
+        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}},
+        {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},
+
+        // Bottom
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 1.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
+
+        // Right
+        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
+
+        // Left
+        {{-0.5f, -0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+        {{-0.5f,  0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
+        {{-0.5f,  0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}}
+    }}, {{
+        0, 1, 2, 2, 3, 0,       // Front
+        4, 5, 6, 6, 7, 4,       // Back
+        8, 9, 10, 10, 11, 8,    // Top
+        12, 13, 14, 14, 15, 12, // Bottom
+        16, 17, 18, 18, 19, 16, // Right
+        20, 21, 22, 22, 23, 20  // Left
+    }}};
+}
+
+/**
+ * @brief Generuje płaszczyznę 1x1 w XZ z normalną +Y
+ * @return 4 wierzchołki, 6 indeksów
+ */
+consteval PrimitiveArrays<4, 6> makePlane() {
+    return {{{
+        {{-0.5f, 0.0f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{ 0.5f, 0.0f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f, 0.0f,  0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},
+        {{-0.5f, 0.0f,  0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}}
+    }}, {{
+        0, 1, 2, 2, 3, 0
+    }}};
+}
+
+/**
+ * @brief Generuje piramidę o podstawie 1x1 i wysokości 1
+ * @return 4 wierzchołki podstawy i po 3 na ścianę boczną, 12 indeksów
+ *
+ * Ściany boczne mają osobne wierzchołki z normalną płaszczyzny ściany.
+ * Jak w dotychczasowej wersji rysowane są tylko ściany boczne.
+ */
+consteval PrimitiveArrays<16, 12> makePyramid() {
+    PrimitiveArrays<16, 12> out{};
+    const double base[4][3] = {
+        {-0.5, -0.5, -0.5},
+        { 0.5, -0.5, -0.5},
+        { 0.5, -0.5,  0.5},
+        {-0.5, -0.5,  0.5}
+    };
+    const double apex[3] = {0.0, 0.5, 0.0};
+
+    for (int i = 0; i < 4; ++i) {
+        out.vertices[i] = makeVertex(base[i][0], base[i][1], base[i][2], 0.0, -1.0, 0.0, 0.0, 0.0);
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        int next = (i + 1) % 4;
+
+        // normal = normalize(cross(apex - base[i], base[next] - base[i]))
+        double e1[3] = {apex[0] - base[i][0], apex[1] - base[i][1], apex[2] - base[i][2]};
+        double e2[3] = {base[next][0] - base[i][0], base[next][1] - base[i][1], base[next][2] - base[i][2]};
+        double n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        double length = ConstMath::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+
+        int start = 4 + i * 3;
+        out.vertices[start + 0] = makeVertex(base[i][0], base[i][1], base[i][2], n[0], n[1], n[2], 0.0, 0.0);
+        out.vertices[start + 1] = makeVertex(apex[0], apex[1], apex[2], n[0], n[1], n[2], 0.5, 1.0);
+        out.vertices[start + 2] = makeVertex(base[next][0], base[next][1], base[next][2], n[0], n[1], n[2], 1.0, 0.0);
+
+        out.indices[i * 3 + 0] = start + 0;
+        out.indices[i * 3 + 1] = start + 1;
+        out.indices[i * 3 + 2] = start + 2;
+    }
+    return out;
+}
+
+/**
+ * @brief Generuje sferę o promieniu 1 (jak MeshBuilder::addSphere)
+ * @tparam Sectors Liczba sektorów (wokół osi Z)
+ * @tparam Stacks Liczba warstw (wzdłuż osi Z)
+ * @return Siatka sfery
+ */
+template <int Sectors, int Stacks>
+consteval auto makeSphere() {
+    constexpr MeshCounts counts = MeshBuilder::sphereCounts(Sectors, Stacks);
+    PrimitiveArrays<counts.vertices, counts.indices> out{};
+
+    size_t v = 0;
+    for (int i = 0; i <= Stacks; ++i) {
+        double stackAngle = ConstMath::PI / 2.0 - i * (ConstMath::PI / Stacks);
+        double xy = ConstMath::cos(stackAngle);
+        double z = ConstMath::sin(stackAngle);
+
+        for (int j = 0; j <= Sectors; ++j) {
+            double sectorAngle = j * (2.0 * ConstMath::PI / Sectors);
+            double x = xy * ConstMath::cos(sectorAngle);
+            double y = xy * ConstMath::sin(sectorAngle);
+            out.vertices[v++] = makeVertex(x, y, z, x, y, z, static_cast<double>(j) / Sectors, static_cast<double>(i) / Stacks);
+        }
+    }
+
+    size_t n = 0;
+    for (int i = 0; i < Stacks; ++i) {
+        unsigned int k1 = i * (Sectors + 1);
+        unsigned int k2 = k1 + Sectors + 1;
+
+        for (int j = 0; j < Sectors; ++j, ++k1, ++k2) {
+            if (i != 0) {
+                out.indices[n++] = k1;
+                out.indices[n++] = k2;
+                out.indices[n++] = k1 + 1;
+            }
+
+            if (i != (Stacks - 1)) {
+                out.indices[n++] = k1 + 1;
+                out.indices[n++] = k2;
+                out.indices[n++] = k2 + 1;
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Generuje cylinder o promieniu 1 i wysokości 1 (jak MeshBuilder::addCylinder)
+ * @tparam Sectors Liczba sektorów
+ * @return Siatka cylindra
+ */
+template <int Sectors>
+consteval auto makeCylinder() {
+    constexpr MeshCounts counts = MeshBuilder::cylinderCounts(Sectors);
+    PrimitiveArrays<counts.vertices, counts.indices> out{};
+
+    // Centra podstaw
+    out.vertices[0] = makeVertex(0.0, 0.5, 0.0, 0.0, 1.0, 0.0, 0.5, 0.5);
+    out.vertices[1] = makeVertex(0.0, -0.5, 0.0, 0.0, -1.0, 0.0, 0.5, 0.5);
+
+    // Wierzchołki obwodu (cos^2 + sin^2 = 1, więc normalna ściany nie wymaga normalizacji)
+    size_t v = 2;
+    for (int i = 0; i <= Sectors; ++i) {
+        double angle = i * (2.0 * ConstMath::PI / Sectors);
+        double x = ConstMath::cos(angle);
+        double z = ConstMath::sin(angle);
+        double u = static_cast<double>(i) / Sectors;
+
+        out.vertices[v++] = makeVertex(x, 0.5, z, 0.0, 1.0, 0.0, x * 0.5 + 0.5, z * 0.5 + 0.5);
+        out.vertices[v++] = makeVertex(x, -0.5, z, 0.0, -1.0, 0.0, x * 0.5 + 0.5, z * 0.5 + 0.5);
+        out.vertices[v++] = makeVertex(x, 0.5, z, x, 0.0, z, u, 1.0);
+        out.vertices[v++] = makeVertex(x, -0.5, z, x, 0.0, z, u, 0.0);
+    }
+
+    size_t n = 0;
+
+    // Górna podstawa
+    for (int i = 0; i < Sectors; ++i) {
+        out.indices[n++] = 0;
+        out.indices[n++] = 2 + (i + 1) * 4;
+        out.indices[n++] = 2 + i * 4;
+    }
+
+    // Dolna podstawa
+    for (int i = 0; i < Sectors; ++i) {
+        out.indices[n++] = 1;
+        out.indices[n++] = 3 + i * 4;
+        out.indices[n++] = 3 + (i + 1) * 4;
+    }
+
+    // Ściany boczne
+    for (int i = 0; i < Sectors; ++i) {
+        unsigned int current = 2 + i * 4;
+        unsigned int next = 2 + (i + 1) * 4;
+
+        out.indices[n++] = current + 2;
+        out.indices[n++] = next + 2;
+        out.indices[n++] = current + 3;
+
+        out.indices[n++] = current + 3;
+        out.indices[n++] = next + 2;
+        out.indices[n++] = next + 3;
+    }
+    return out;
+}
+
+/**
+ * @brief Generuje stożek o wysokości 1 i promieniu podstawy 1
+ * @tparam Sectors Liczba sektorów
+ * @return Siatka stożka
+ */
+template <int Sectors>
+consteval auto makeCone() {
+    constexpr MeshCounts counts = coneCounts(Sectors);
+    PrimitiveArrays<counts.vertices, counts.indices> out{};
+
+    // Wierzchołek stożka i środek podstawy
+    out.vertices[0] = makeVertex(0.0, 0.5, 0.0, 0.0, 1.0, 0.0, 0.5, 0.5);
+    out.vertices[1] = makeVertex(0.0, -0.5, 0.0, 0.0, -1.0, 0.0, 0.5, 0.5);
+
+    size_t v = 2;
+    for (int i = 0; i <= Sectors; ++i) {
+        double angle = i * (2.0 * ConstMath::PI / Sectors);
+        double x = ConstMath::cos(angle);
+        double z = ConstMath::sin(angle);
+        double u = static_cast<double>(i) / Sectors;
+
+        // normal = normalize(x, 0.25, z)
+        double length = ConstMath::sqrt(x * x + 0.0625 + z * z);
+        double nx = x / length;
+        double ny = 0.25 / length;
+        double nz = z / length;
+
+        out.vertices[v++] = makeVertex(x, -0.5, z, 0.0, -1.0, 0.0, x * 0.5 + 0.5, z * 0.5 + 0.5);
+        out.vertices[v++] = makeVertex(x, -0.5, z, nx, ny, nz, u, 0.0);
+        out.vertices[v++] = makeVertex(0.0, 0.5, 0.0, nx, ny, nz, u, 1.0);
+    }
+
+    size_t n = 0;
+
+    // Podstawa
+    for (int i = 0; i < Sectors; ++i) {
+        out.indices[n++] = 1;
+        out.indices[n++] = 2 + i * 3;
+        out.indices[n++] = 2 + (i + 1) * 3;
+    }
+
+    // Ściany
+    for (int i = 0; i < Sectors; ++i) {
+        out.indices[n++] = 3 + i * 3;
+        out.indices[n++] = 4 + i * 3;
+        out.indices[n++] = 3 + (i + 1) * 3;
+    }
+    return out;
+}
+
+/**
+ * @brief Generuje torus w płaszczyźnie XY (jak MeshBuilder::addTorus)
+ * @tparam Sectors Liczba sektorów rury
+ * @tparam Rings Liczba pierścieni
+ * @param radius Główny promień
+ * @param tubeRadius Promień rury
+ * @return Siatka torusa
+ */
+template <int Sectors, int Rings>
+consteval auto makeTorus(double radius, double tubeRadius) {
+    constexpr MeshCounts counts = MeshBuilder::torusCounts(Sectors, Rings);
+    PrimitiveArrays<counts.vertices, counts.indices> out{};
+
+    size_t v = 0;
+    for (int i = 0; i <= Rings; ++i) {
+        double ringAngle = i * (2.0 * ConstMath::PI / Rings);
+        double cosRing = ConstMath::cos(ringAngle);
+        double sinRing = ConstMath::sin(ringAngle);
+
+        for (int j = 0; j <= Sectors; ++j) {
+            double sectorAngle = j * (2.0 * ConstMath::PI / Sectors);
+            double cosSector = ConstMath::cos(sectorAngle);
+            double sinSector = ConstMath::sin(sectorAngle);
+            double ring = radius + tubeRadius * cosSector;
+
+            out.vertices[v++] = makeVertex(ring * cosRing, ring * sinRing, tubeRadius * sinSector,
+                                           cosRing * cosSector, sinRing * cosSector, sinSector,
+                                           static_cast<double>(j) / Sectors, static_cast<double>(i) / Rings);
+        }
+    }
+
+    size_t n = 0;
+    for (int i = 0; i < Rings; ++i) {
+        for (int j = 0; j < Sectors; ++j) {
+            unsigned int first = i * (Sectors + 1) + j;
+            unsigned int second = first + Sectors + 1;
+
+            out.indices[n++] = first;
+            out.indices[n++] = second;
+            out.indices[n++] = first + 1;
+
+            out.indices[n++] = second;
+            out.indices[n++] = second + 1;
+            out.indices[n++] = first + 1;
+        }
+    }
+    return out;
+}
+
+// Tesselacja kształtów tworzonych przez GeometryRenderer przy starcie
+constexpr int SPHERE_SECTORS = 32;      /**< Sektory sfery */
+constexpr int SPHERE_STACKS = 32;       /**< Warstwy sfery */
+constexpr int CYLINDER_SECTORS = 32;    /**< Sektory cylindra */
+constexpr int CONE_SECTORS = 32;        /**< Sektory stożka */
+constexpr int TORUS_SECTORS = 32;       /**< Sektory rury torusa */
+constexpr int TORUS_RINGS = 32;         /**< Pierścienie torusa */
+constexpr float TORUS_RADIUS = 0.5f;    /**< Główny promień torusa */
+constexpr float TORUS_TUBE_RADIUS = 0.2f;   /**< Promień rury torusa */
+
+inline constexpr auto CUBE = makeCube();                                        /**< Sześcian jednostkowy */
+inline constexpr auto PLANE = makePlane();                                      /**< Płaszczyzna 1x1 */
+inline constexpr auto PYRAMID = makePyramid();                                  /**< Piramida */
+inline constexpr auto SPHERE = makeSphere<SPHERE_SECTORS, SPHERE_STACKS>();     /**< Sfera */
+inline constexpr auto CYLINDER = makeCylinder<CYLINDER_SECTORS>();              /**< Cylinder */
+inline constexpr auto CONE = makeCone<CONE_SECTORS>();                          /**< Stożek */
+inline constexpr auto TORUS = makeTorus<TORUS_SECTORS, TORUS_RINGS>(TORUS_RADIUS, TORUS_TUBE_RADIUS); /**< Torus */
+
+// Liczniki zgodne z funkcjami MeshBuilder (te same siatki tworzone w czasie działania)
+static_assert(CUBE.vertices.size() == MeshBuilder::cuboidCounts().vertices);
+static_assert(CUBE.indices.size() == MeshBuilder::cuboidCounts().indices);
+static_assert(PLANE.vertices.size() == 4 && PLANE.indices.size() == 6);
+static_assert(PYRAMID.vertices.size() == 16 && PYRAMID.indices.size() == 12);
+static_assert(SPHERE.vertices.size() == (SPHERE_SECTORS + 1) * (SPHERE_STACKS + 1));
+static_assert(SPHERE.indices.size() == 6 * SPHERE_SECTORS * (SPHERE_STACKS - 1));
+static_assert(CYLINDER.indices.size() == 12 * CYLINDER_SECTORS);
+static_assert(CONE.indices.size() == 6 * CONE_SECTORS);
+static_assert(TORUS.indices.size() == 6 * TORUS_SECTORS * TORUS_RINGS);
+
+// Indeksy mieszczą się w zakresie wierzchołków
+static_assert(indicesInRange(CUBE));
+static_assert(indicesInRange(PLANE));
+static_assert(indicesInRange(PYRAMID));
+static_assert(indicesInRange(SPHERE));
+static_assert(indicesInRange(CYLINDER));
+static_assert(indicesInRange(CONE));
+static_assert(indicesInRange(TORUS));
+
+// Bieguny sfery leżą na osi Z
+static_assert(SPHERE.vertices[0].position[2] == 1.0f);
+static_assert(SPHERE.vertices[SPHERE.vertices.size() - 1].position[2] == -1.0f);
+
+} // namespace Primitives
+
+#endif // PRIMITIVE_DATA_HPP
@@ -0,0 +1,327 @@
+// MultiViewRenderer.cpp
+#include "MultiViewRenderer.hpp"
+#include "../Transform/TransformableObject.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @struct CameraBlock
+ * @brief Układ bloku uniformów "Camera" zgodny z std140
+ */
+struct CameraBlock {
+    glm::mat4 view;         /**< Macierz widoku */
+    glm::mat4 projection;   /**< Macierz projekcji */
+    glm::vec4 position;     /**< Pozycja obserwatora (w = 1) */
+};
+
+/**
+ * @brief Konstruktor MultiViewRenderer
+ */
+MultiViewRenderer::MultiViewRenderer()
+    : m_cameraUBO(0), m_cameraStride(sizeof(CameraBlock)), m_cameraCapacity(0),
+      m_objectBuffer(0), m_objectTexture(0), m_objectCapacity(0), m_initialized(false) {
+}
+
+/**
+ * @brief Destruktor MultiViewRenderer
+ */
+MultiViewRenderer::~MultiViewRenderer() {
+    release();
+}
+
+/**
+ * @brief Tworzy bufory OpenGL
+ * @return true jeśli inicjalizacja się powiodła
+ *
+ * @details Odstęp pomiędzy kamerami zaokrąglany jest do
+ * GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, aby każdy widok mógł być wskazany
+ * przez glBindBufferRange.
+ */
+bool MultiViewRenderer::initialize() {
+    if (m_initialized) return true;
+
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment <= 0) alignment = 256;
+    m_cameraStride = ((static_cast<GLsizeiptr>(sizeof(CameraBlock)) + alignment - 1) / alignment) * alignment;
+
+    glGenBuffers(1, &m_cameraUBO);
+    glGenBuffers(1, &m_objectBuffer);
+    glGenTextures(1, &m_objectTexture);
+
+    if (m_cameraUBO == 0 || m_objectBuffer == 0 || m_objectTexture == 0) {
+        std::cerr << "Blad: Nie udalo sie utworzyc buforow renderera widokow" << std::endl;
+        release();
+        return false;
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zwalnia bufory OpenGL
+ */
+void MultiViewRenderer::release() {
+    if (m_cameraUBO) glDeleteBuffers(1, &m_cameraUBO);
+    if (m_objectBuffer) glDeleteBuffers(1, &m_objectBuffer);
+    if (m_objectTexture) glDeleteTextures(1, &m_objectTexture);
+    m_cameraUBO = 0;
+    m_objectBuffer = 0;
+    m_objectTexture = 0;
+    m_cameraCapacity = 0;
+    m_objectCapacity = 0;
+    m_programUniforms.clear();
+    m_initialized = false;
+}
+
+/**
+ * @brief Przygotowuje program shaderowy do pracy z rendererem
+ * @param program Program shaderowy
+ */
+void MultiViewRenderer::setupProgram(GLuint program) {
+    GLuint blockIndex = glGetUniformBlockIndex(program, "Camera");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, blockIndex, CAMERA_UBO_BINDING);
+    }
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "objectData"), OBJECT_DATA_TEXTURE_UNIT);
+    glUniform1i(glGetUniformLocation(program, "useObjectData"), 0);
+}
+
+/**
+ * @brief Usuwa wszystkie widoki
+ */
+void MultiViewRenderer::clearViews() {
+    m_views.clear();
+}
+
+/**
+ * @brief Dodaje widok
+ * @param view Opis widoku
+ * @return Indeks widoku lub -1 gdy przekroczono MAX_VIEWS
+ */
+int MultiViewRenderer::addView(const RenderView& view) {
+    if (static_cast<int>(m_views.size()) >= MAX_VIEWS) {
+        std::cerr << "Blad: Przekroczono maksymalna liczbe widokow (" << MAX_VIEWS << ")" << std::endl;
+        return -1;
+    }
+    m_views.push_back(view);
+    return static_cast<int>(m_views.size() - 1);
+}
+
+/**
+ * @brief Testuje obiekty względem wszystkich widoków
+ *
+ * @details Sfera otaczająca każdego obiektu przekształcana jest tylko raz.
+ * Najpierw testowana jest względem AABB sumy wszystkich ostrosłupów - obiekty
+ * poza nią odpadają bez testów per widok. Pozostałe testowane są względem
+ * każdego ostrosłupa i otrzymują maskę bitową widoczności.
+ */
+void MultiViewRenderer::cullObjects() {
+    std::vector<Frustum> frustums;
+    frustums.reserve(m_views.size());
+    BoundingBox unionBounds = BoundingBox::empty();
+
+    for (const auto& view : m_views) {
+        glm::mat4 viewProjection = view.projection * view.view;
+        frustums.push_back(Frustum::fromMatrix(viewProjection));
+        unionBounds.expand(Frustum::computeBounds(viewProjection));
+    }
+
+    m_visibility.assign(m_objects.size(), 0u);
+    int culledByUnion = 0;
+
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        BoundingSphere sphere = m_objects[i]->getWorldBounds();
+        if (!unionBounds.intersects(sphere)) {
+            culledByUnion++;
+            continue;
+        }
+
+        uint32_t mask = 0;
+        for (size_t v = 0; v < frustums.size(); ++v) {
+            if (frustums[v].intersects(sphere)) {
+                mask |= 1u << v;
+            }
+        }
+        m_visibility[i] = mask;
+    }
+
+    RenderStats::instance().setValue("MultiView/Odrzucone przez sume ostroslupow", culledByUnion);
+}
+
+/**
+ * @brief Wysyła dane obiektów do bufora tekstury
+ * @param lightCuller Źródło list świateł obiektów (może być nullptr)
+ *
+ * @details Każdy obiekt zajmuje OBJECT_DATA_TEXELS tekseli RGBA32F:
+ * cztery kolumny macierzy modelu oraz początek i długość listy świateł
+ * z identyfikatorem materiału (liczby całkowite są dokładne w float)
+ * i stopniem przenikania w impostor.
+ * Kolor obiektu zawiera jego materiał w MaterialTable. Bufor jest osierocany
+ * (glBufferData z nullptr) przed zapisem, aby nie czekać na GPU
+ * rysujące jeszcze poprzednią klatkę.
+ */
+void MultiViewRenderer::uploadObjectData(const LightCuller* lightCuller) {
+    m_objectData.resize(m_objects.size() * OBJECT_DATA_TEXELS);
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        glm::mat4 model = m_objects[i]->getModelMatrix();
+        glm::vec4* texels = &m_objectData[i * OBJECT_DATA_TEXELS];
+        texels[0] = model[0];
+        texels[1] = model[1];
+        texels[2] = model[2];
+        texels[3] = model[3];
+        glm::ivec2 lights = lightCuller ? lightCuller->getObjectList(m_sourceIndices[i]) : glm::ivec2(0, 0);
+        texels[4] = glm::vec4(static_cast<float>(lights.x), static_cast<float>(lights.y),
+                              static_cast<float>(m_objects[i]->getMaterialId()), m_objects[i]->getDissolve());
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_objectData.size() * sizeof(glm::vec4));
+    if (size == 0) return;
+
+    glBindBuffer(GL_TEXTURE_BUFFER, m_objectBuffer);
+    if (size > m_objectCapacity) {
+        m_objectCapacity = size * 2;
+        glBufferData(GL_TEXTURE_BUFFER, m_objectCapacity, nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_objectTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_objectBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    } else {
+        glBufferData(GL_TEXTURE_BUFFER, m_objectCapacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, m_objectData.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+/**
+ * @brief Wysyła kamery wszystkich widoków do bufora uniformów
+ */
+void MultiViewRenderer::uploadCameras() {
+    GLsizeiptr size = m_cameraStride * static_cast<GLsizeiptr>(m_views.size());
+    if (size == 0) return;
+
+    std::vector<unsigned char> data(static_cast<size_t>(size), 0);
+    for (size_t v = 0; v < m_views.size(); ++v) {
+        CameraBlock block;
+        block.view = m_views[v].view;
+        block.projection = m_views[v].projection;
+        block.position = glm::vec4(m_views[v].position, 1.0f);
+        std::memcpy(&data[v * m_cameraStride], &block, sizeof(CameraBlock));
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_cameraUBO);
+    if (size > m_cameraCapacity) {
+        m_cameraCapacity = size;
+    }
+    glBufferData(GL_UNIFORM_BUFFER, m_cameraCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+/**
+ * @brief Zwraca lokalizacje uniformów programu (pobierane raz na program)
+ * @param program Program shaderowy
+ * @return Lokalizacje uniformów
+ */
+const MultiViewRenderer::ProgramUniforms& MultiViewRenderer::getProgramUniforms(GLuint program) {
+    auto it = m_programUniforms.find(program);
+    if (it == m_programUniforms.end()) {
+        ProgramUniforms uniforms;
+        uniforms.useObjectData = glGetUniformLocation(program, "useObjectData");
+        uniforms.objectIndex = glGetUniformLocation(program, "objectIndex");
+        it = m_programUniforms.emplace(program, uniforms).first;
+    }
+    return it->second;
+}
+
+/**
+ * @brief Odrzuca obiekty i wysyła dane klatki
+ * @param objects Obiekty sceny
+ * @param lightCuller Listy świateł obiektów (może być nullptr)
+ */
+void MultiViewRenderer::beginFrame(const std::vector<TransformableObject*>& objects, const LightCuller* lightCuller) {
+    if (!m_initialized) return;
+
+    m_objects.clear();
+    m_sourceIndices.clear();
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (!objects[i]) continue;
+        m_objects.push_back(objects[i]);
+        m_sourceIndices.push_back(i);
+    }
+
+    cullObjects();
+    uploadObjectData(lightCuller);
+    uploadCameras();
+
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("MultiView/Widoki", static_cast<double>(m_views.size()));
+    stats.setValue("MultiView/Obiekty", static_cast<double>(m_objects.size()));
+    stats.setValue("MultiView/Narysowane obiekty", 0.0);
+}
+
+/**
+ * @brief Aktywuje widok
+ * @param index Indeks widoku
+ *
+ * @details Jedyną zmianą stanu per widok jest obszar okna (z nożycami,
+ * aby czyszczenie nie wychodziło poza widok) i zakres bufora kamery.
+ */
+void MultiViewRenderer::bindView(int index) {
+    if (!m_initialized || index < 0 || index >= static_cast<int>(m_views.size())) return;
+    const RenderView& view = m_views[index];
+
+    glViewport(view.x, view.y, view.width, view.height);
+    if (view.clear) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(view.x, view.y, view.width, view.height);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING, m_cameraUBO,
+                      m_cameraStride * index, sizeof(CameraBlock));
+}
+
+/**
+ * @brief Rysuje obiekty widoczne w widoku
+ * @param index Indeks widoku
+ * @param program Aktywny program shaderowy
+ * @return Liczba narysowanych obiektów
+ *
+ * @details Macierz modelu, lista świateł i materiał pobierane są w shaderze
+ * z bufora danych obiektów, więc per obiekt ustawiany jest tylko jego indeks.
+ * Lokalizacje uniformów pobierane są przy pierwszym rysowaniu programem
+ * i zapamiętywane; programy usuwane w trakcie działania należy zgłosić
+ * przez forgetProgram(), bo OpenGL może ponownie użyć ich identyfikatora.
+ */
+int MultiViewRenderer::drawVisibleObjects(int index, GLuint program) {
+    if (!m_initialized || index < 0 || index >= static_cast<int>(m_views.size())) return 0;
+
+    const ProgramUniforms& uniforms = getProgramUniforms(program);
+    GLint useObjectDataLoc = uniforms.useObjectData;
+    GLint objectIndexLoc = uniforms.objectIndex;
+
+    glActiveTexture(GL_TEXTURE0 + OBJECT_DATA_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_objectTexture);
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(useObjectDataLoc, 1);
+
+    uint32_t bit = 1u << index;
+    int drawn = 0;
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        if (!(m_visibility[i] & bit)) continue;
+        glUniform1i(objectIndexLoc, static_cast<GLint>(i));
+        m_objects[i]->draw();
+        drawn++;
+    }
+
+    glUniform1i(useObjectDataLoc, 0);
+    RenderStats::instance().addValue("MultiView/Narysowane obiekty", drawn);
+    return drawn;
+}
@@ -0,0 +1,199 @@
+// MultiViewRenderer.hpp
+#ifndef MULTI_VIEW_RENDERER_HPP
+#define MULTI_VIEW_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "../Math/Bounds.hpp"
+
+class TransformableObject;
+class LightCuller;
+
+/**
+ * @struct RenderView
+ * @brief Pojedynczy widok sceny (kamera + obszar okna)
+ *
+ * Widokiem może być podział ekranu, obraz w obrazie, kaskada cienia
+ * lub okno edytora.
+ */
+struct RenderView {
+    std::string name;       /**< Nazwa widoku (używana w statystykach) */
+    int x;                  /**< Lewa krawędź obszaru w pikselach */
+    int y;                  /**< Dolna krawędź obszaru w pikselach */
+    int width;              /**< Szerokość obszaru w pikselach */
+    int height;             /**< Wysokość obszaru w pikselach */
+    glm::mat4 view;         /**< Macierz widoku */
+    glm::mat4 projection;   /**< Macierz projekcji */
+    glm::vec3 position;     /**< Pozycja obserwatora */
+    bool clear;             /**< Czy czyścić obszar widoku przed rysowaniem */
+};
+
+/**
+ * @class MultiViewRenderer
+ * @brief Renderowanie wielu widoków ze wspólnym odrzucaniem i danymi obiektów
+ *
+ * Każda klatka przebiega w trzech krokach:
+ * - beginFrame() w jednym przejściu po obiektach testuje ich sfery otaczające
+ *   względem wszystkich ostrosłupów i zapisuje maskę bitową widoczności
+ *   (bit i = widoczny w widoku i),
+ * - dane obiektów (macierz modelu, lista świateł i identyfikator materiału)
+ *   wysyłane są raz do bufora tekstury,
+ *   a kamery wszystkich widoków raz do jednego bufora uniformów,
+ * - dla każdego widoku bindView() przełącza jedynie zakres bufora kamery
+ *   i obszar okna, a drawVisibleObjects() rysuje obiekty z ustawionym bitem.
+ *
+ * Shadery korzystają z bloku uniformów "Camera" oraz bufora "objectData".
+ */
+class MultiViewRenderer {
+private:
+    /**
+     * @struct ProgramUniforms
+     * @brief Lokalizacje uniformów używanych przez drawVisibleObjects()
+     */
+    struct ProgramUniforms {
+        GLint useObjectData;    /**< Lokalizacja "useObjectData" */
+        GLint objectIndex;      /**< Lokalizacja "objectIndex" */
+    };
+
+public:
+    static const int MAX_VIEWS = 32;                /**< Maksymalna liczba widoków (bity maski) */
+    static const int OBJECT_DATA_TEXELS = 5;        /**< Teksele RGBA32F na obiekt (4 kolumny macierzy, lista świateł, materiał i przenikanie) */
+    static const GLuint CAMERA_UBO_BINDING = 0;     /**< Punkt wiązania bloku Camera */
+    static const int OBJECT_DATA_TEXTURE_UNIT = 1;  /**< Jednostka teksturująca bufora danych obiektów */
+
+private:
+    std::vector<RenderView> m_views;                /**< Widoki bieżącej klatki */
+    std::vector<TransformableObject*> m_objects;    /**< Obiekty bieżącej klatki */
+    std::vector<size_t> m_sourceIndices;            /**< Indeks obiektu na liście przekazanej do beginFrame() */
+    std::vector<uint32_t> m_visibility;             /**< Maska widoczności każdego obiektu */
+    std::vector<glm::vec4> m_objectData;            /**< Dane obiektów przygotowane do wysłania */
+
+    GLuint m_cameraUBO;             /**< Bufor uniformów z kamerami wszystkich widoków */
+    GLsizeiptr m_cameraStride;      /**< Odstęp pomiędzy kamerami w buforze (wyrównany) */
+    GLsizeiptr m_cameraCapacity;    /**< Pojemność bufora kamer w bajtach */
+    GLuint m_objectBuffer;          /**< Bufor z danymi obiektów */
+    GLuint m_objectTexture;         /**< Tekstura buforowa nad m_objectBuffer */
+    GLsizeiptr m_objectCapacity;    /**< Pojemność bufora obiektów w bajtach */
+    std::map<GLuint, ProgramUniforms> m_programUniforms;   /**< Lokalizacje uniformów według programu */
+    bool m_initialized;             /**< Czy obiekty OpenGL zostały utworzone */
+
+    /**
+     * @brief Testuje obiekty względem wszystkich widoków
+     */
+    void cullObjects();
+
+    /**
+     * @brief Wysyła dane obiektów do bufora tekstury
+     * @param lightCuller Źródło list świateł obiektów (może być nullptr)
+     */
+    void uploadObjectData(const LightCuller* lightCuller);
+
+    /**
+     * @brief Wysyła kamery wszystkich widoków do bufora uniformów
+     */
+    void uploadCameras();
+
+    /**
+     * @brief Zwraca lokalizacje uniformów programu (pobierane raz na program)
+     * @param program Program shaderowy
+     * @return Lokalizacje uniformów
+     */
+    const ProgramUniforms& getProgramUniforms(GLuint program);
+
+public:
+    /**
+     * @brief Konstruktor MultiViewRenderer
+     */
+    MultiViewRenderer();
+
+    /**
+     * @brief Destruktor MultiViewRenderer
+     */
+    ~MultiViewRenderer();
+
+    /**
+     * @brief Tworzy bufory OpenGL
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia bufory OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Przygotowuje program shaderowy do pracy z rendererem
+     * @param program Program shaderowy
+     *
+     * Wiąże blok "Camera" z CAMERA_UBO_BINDING oraz sampler "objectData"
+     * z OBJECT_DATA_TEXTURE_UNIT.
+     */
+    static void setupProgram(GLuint program);
+
+    /**
+     * @brief Usuwa wszystkie widoki
+     */
+    void clearViews();
+
+    /**
+     * @brief Dodaje widok
+     * @param view Opis widoku
+     * @return Indeks widoku lub -1 gdy przekroczono MAX_VIEWS
+     */
+    int addView(const RenderView& view);
+
+    /**
+     * @brief Zwraca liczbę widoków
+     * @return Liczba widoków
+     */
+    int getViewCount() const { return static_cast<int>(m_views.size()); }
+
+    /**
+     * @brief Zwraca widok
+     * @param index Indeks widoku
+     * @return Opis widoku
+     */
+    const RenderView& getView(int index) const { return m_views[index]; }
+
+    /**
+     * @brief Odrzuca obiekty i wysyła dane klatki (raz na klatkę, po dodaniu widoków)
+     * @param objects Obiekty sceny
+     * @param lightCuller Listy świateł obiektów z LightCuller::update() dla tych
+     *        samych obiektów (nullptr = obiekty bez świateł)
+     */
+    void beginFrame(const std::vector<TransformableObject*>& objects, const LightCuller* lightCuller = nullptr);
+
+    /**
+     * @brief Aktywuje widok (obszar okna i zakres bufora kamery)
+     * @param index Indeks widoku
+     */
+    void bindView(int index);
+
+    /**
+     * @brief Rysuje obiekty widoczne w widoku
+     * @param index Indeks widoku
+     * @param program Aktywny program shaderowy (przygotowany przez setupProgram)
+     * @return Liczba narysowanych obiektów
+     */
+    int drawVisibleObjects(int index, GLuint program);
+
+    /**
+     * @brief Usuwa zapamiętane lokalizacje uniformów programu
+     * @param program Program shaderowy (wywołać przed jego usunięciem)
+     */
+    void forgetProgram(GLuint program) { m_programUniforms.erase(program); }
+
+    /**
+     * @brief Zwraca maskę widoczności obiektu
+     * @param objectIndex Indeks obiektu z ostatniego beginFrame()
+     * @return Maska bitowa widoków, w których obiekt jest widoczny
+     */
+    uint32_t getVisibilityMask(size_t objectIndex) const { return m_visibility[objectIndex]; }
+};
+
+#endif // MULTI_VIEW_RENDERER_HPP
@@ -0,0 +1,211 @@
+// ParticleRenderer.cpp
+#include "ParticleRenderer.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+/**
+ * @brief Vertex shader cząsteczek
+ *
+ * Narożnik kwadratu (gl_VertexID 0-3, kolejność paska trójkątów CCW)
+ * przesuwany jest w przestrzeni widoku, więc kwadrat jest zawsze
+ * równoległy do ekranu.
+ */
+static const char* particleVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec4 aInstance; // xyz = pozycja, w = wiek / czas życia
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+uniform vec4 startColor;
+uniform vec4 endColor;
+uniform vec2 sizeRange;
+
+out vec2 Corner;
+out vec4 Color;
+
+void main()
+{
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1)) * 2.0 - 1.0;
+    float life = clamp(aInstance.w, 0.0, 1.0);
+    vec4 viewPosition = view * vec4(aInstance.xyz, 1.0);
+    viewPosition.xy += corner * (mix(sizeRange.x, sizeRange.y, life) * 0.5);
+    Corner = corner;
+    Color = mix(startColor, endColor, life);
+    gl_Position = projection * viewPosition;
+}
+)";
+
+/**
+ * @brief Fragment shader cząsteczek (miękki okrąg)
+ */
+static const char* particleFragmentSource = R"(
+#version 330 core
+in vec2 Corner;
+in vec4 Color;
+
+out vec4 FragColor;
+
+void main()
+{
+    float falloff = 1.0 - dot(Corner, Corner);
+    if (falloff <= 0.0) discard;
+    FragColor = vec4(Color.rgb, Color.a * falloff);
+}
+)";
+
+/**
+ * @brief Konstruktor ParticleRenderer
+ */
+ParticleRenderer::ParticleRenderer()
+    : m_system(nullptr), m_program(0), m_vao(0), m_instanceBuffer(0), m_startColorLoc(-1), m_endColorLoc(-1),
+      m_sizeRangeLoc(-1), m_bufferCapacity(0), m_uploadedCount(0), m_initialized(false) {}
+
+/**
+ * @brief Destruktor ParticleRenderer
+ */
+ParticleRenderer::~ParticleRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery i tworzy bufor instancji
+ * @return true jeśli inicjalizacja się powiodła
+ */
+bool ParticleRenderer::initialize() {
+    if (m_initialized) return true;
+
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, particleVertexSource, "czasteczek");
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, particleFragmentSource, "czasteczek");
+    m_program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "czasteczek");
+    if (!m_program) return false;
+
+    MultiViewRenderer::setupProgram(m_program);
+    m_startColorLoc = glGetUniformLocation(m_program, "startColor");
+    m_endColorLoc = glGetUniformLocation(m_program, "endColor");
+    m_sizeRangeLoc = glGetUniformLocation(m_program, "sizeRange");
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_instanceBuffer);
+    if (!m_vao || !m_instanceBuffer) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow czasteczek" << std::endl;
+        release();
+        return false;
+    }
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)0);
+    glVertexAttribDivisor(0, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zwalnia obiekty OpenGL
+ */
+void ParticleRenderer::release() {
+    if (m_program) glDeleteProgram(m_program);
+    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+    m_program = 0;
+    m_vao = 0;
+    m_instanceBuffer = 0;
+    m_bufferCapacity = 0;
+    m_uploadedCount = 0;
+    m_system = nullptr;
+    m_initialized = false;
+}
+
+/**
+ * @brief Wysyła dane instancji żywych cząsteczek
+ * @param system System cząsteczek po update()
+ *
+ * @details Bufor rośnie skokowo do 1.5 potrzebnego rozmiaru, a w każdej
+ * klatce jest porzucany i wypełniany od nowa. Czas wysłania mierzony jest
+ * osobno od czasu symulacji (Czasteczki/Symulacja [ms]).
+ */
+void ParticleRenderer::prepare(const ParticleSystem& system) {
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Czasteczki/Wywolania rysowania", 0.0);
+    m_system = &system;
+    m_uploadedCount = 0;
+    if (!m_initialized || system.getCount() == 0) {
+        stats.setValue("Czasteczki/Wysylanie [ms]", 0.0);
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t count = system.getCount();
+    if (count > m_bufferCapacity) {
+        m_bufferCapacity = std::min(std::max(count, m_bufferCapacity + m_bufferCapacity / 2), system.getCapacity());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_bufferCapacity * sizeof(glm::vec4)), nullptr,
+                 GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(count * sizeof(glm::vec4)), system.getInstances());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_uploadedCount = count;
+    auto end = std::chrono::high_resolution_clock::now();
+
+    stats.setValue("Czasteczki/Wysylanie [ms]", std::chrono::duration<double, std::milli>(end - start).count());
+    stats.setValue("Czasteczki/Pamiec GPU [MB]",
+                   static_cast<double>(m_bufferCapacity * sizeof(glm::vec4)) / (1024.0 * 1024.0));
+}
+
+/**
+ * @brief Rysuje cząsteczki w aktywnym widoku
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(). Test głębokości pozostaje włączony,
+ * więc nieprzezroczysta scena zasłania cząsteczki; poprzedni program,
+ * mieszanie i zapis głębokości są przywracane.
+ */
+int ParticleRenderer::draw() {
+    if (!m_initialized || m_uploadedCount == 0 || !m_system) return 0;
+
+    GLint previousProgram = 0;
+    GLint blendSrcRgb = GL_ONE, blendDstRgb = GL_ZERO, blendSrcAlpha = GL_ONE, blendDstAlpha = GL_ZERO;
+    GLboolean depthMask = GL_TRUE;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &blendSrcRgb);
+    glGetIntegerv(GL_BLEND_DST_RGB, &blendDstRgb);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcAlpha);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstAlpha);
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+
+    const ParticleEmitterSettings& settings = m_system->getSettings();
+    glUseProgram(m_program);
+    glUniform4f(m_startColorLoc, settings.startColor.r, settings.startColor.g, settings.startColor.b,
+                settings.startColor.a);
+    glUniform4f(m_endColorLoc, settings.endColor.r, settings.endColor.g, settings.endColor.b, settings.endColor.a);
+    glUniform2f(m_sizeRangeLoc, settings.startSize, settings.endSize);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+    glBindVertexArray(m_vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(m_uploadedCount));
+    glBindVertexArray(0);
+
+    glDepthMask(depthMask);
+    glBlendFuncSeparate(blendSrcRgb, blendDstRgb, blendSrcAlpha, blendDstAlpha);
+    if (!blend) glDisable(GL_BLEND);
+    glUseProgram(previousProgram);
+
+    RenderStats::instance().addValue("Czasteczki/Wywolania rysowania", 1.0);
+    return 1;
+}
@@ -0,0 +1,72 @@
+// ParticleRenderer.hpp
+#ifndef PARTICLE_RENDERER_HPP
+#define PARTICLE_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <cstddef>
+#include "ParticleSystem.hpp"
+
+/**
+ * @class ParticleRenderer
+ * @brief Rysowanie cząsteczek ParticleSystem jako instancjonowanych kwadratów
+ *
+ * Co klatkę prepare() wysyła dane instancji żywych cząsteczek (pozycja
+ * i część przeżytego życia, 16 B na cząsteczkę) do bufora strumieniowego:
+ * bufor jest porzucany (glBufferData bez danych) przed zapisem, więc
+ * sterownik nie czeka, aż GPU skończy rysowanie z poprzedniej klatki.
+ * Kwadrat zwrócony do kamery powstaje w vertex shaderze z gl_VertexID
+ * (4 wierzchołki paska trójkątów na instancję) i wektorów kamery z bloku
+ * Camera, więc każdy widok rysowany jest jednym glDrawArraysInstanced.
+ * Kolor i rozmiar interpolowane są według wieku z parametrów emitera.
+ * Cząsteczki mieszane są addytywnie bez zapisu głębokości, dzięki czemu
+ * nie wymagają sortowania.
+ */
+class ParticleRenderer {
+private:
+    const ParticleSystem* m_system;     /**< Rysowany system (z ostatniego prepare) */
+    GLuint m_program;                   /**< Program rysowania cząsteczek */
+    GLuint m_vao;                       /**< VAO z atrybutem instancji */
+    GLuint m_instanceBuffer;            /**< Strumieniowy bufor danych instancji */
+    GLint m_startColorLoc;              /**< Lokalizacja uniformu koloru początkowego */
+    GLint m_endColorLoc;                /**< Lokalizacja uniformu koloru końcowego */
+    GLint m_sizeRangeLoc;               /**< Lokalizacja uniformu rozmiaru początkowego i końcowego */
+    size_t m_bufferCapacity;            /**< Pojemność bufora [cząsteczki] */
+    size_t m_uploadedCount;             /**< Liczba cząsteczek w buforze */
+    bool m_initialized;                 /**< Czy obiekty OpenGL zostały utworzone */
+
+public:
+    /**
+     * @brief Konstruktor ParticleRenderer
+     */
+    ParticleRenderer();
+
+    /**
+     * @brief Destruktor ParticleRenderer
+     */
+    ~ParticleRenderer();
+
+    /**
+     * @brief Kompiluje shadery i tworzy bufor instancji
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia obiekty OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Wysyła dane instancji żywych cząsteczek
+     * @param system System cząsteczek po update()
+     */
+    void prepare(const ParticleSystem& system);
+
+    /**
+     * @brief Rysuje cząsteczki w aktywnym widoku
+     * @return Liczba wywołań rysowania
+     */
+    int draw();
+};
+
+#endif // PARTICLE_RENDERER_HPP
@@ -0,0 +1,241 @@
+// ParticleSystem.cpp
+#include "ParticleSystem.hpp"
+#include "../Math/Simd.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief Miesza bity liczby (splitmix64)
+ * @param value Wartość wejściowa
+ * @return Pseudolosowe 64 bity
+ */
+static uint64_t mixBits(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Zamienia 24 najstarsze bity na liczbę z przedziału [-1, 1)
+ * @param bits Pseudolosowe bity
+ * @return Liczba zmiennoprzecinkowa
+ */
+static float signedUnit(uint64_t bits) {
+    return static_cast<float>(bits >> 40) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+/**
+ * @brief Konstruktor ParticleSystem
+ * @param capacity Największa liczba cząsteczek
+ */
+ParticleSystem::ParticleSystem(size_t capacity)
+    : m_capacity(capacity), m_count(0), m_seed(0x5eed), m_emitAccumulator(0.0f), m_emitting(false) {}
+
+/**
+ * @brief Zwraca wszystkie tablice właściwości
+ * @param arrays Tablica na 8 wskaźników (x, y, z, vx, vy, vz, wiek, czas życia)
+ */
+void ParticleSystem::getArrays(std::vector<float>* arrays[8]) {
+    arrays[0] = &m_x;
+    arrays[1] = &m_y;
+    arrays[2] = &m_z;
+    arrays[3] = &m_vx;
+    arrays[4] = &m_vy;
+    arrays[5] = &m_vz;
+    arrays[6] = &m_age;
+    arrays[7] = &m_lifetime;
+}
+
+/**
+ * @brief Przydziela tablice dla pojemności
+ *
+ * @details Tablica indeksów martwych ma pełną pojemność, bo każda porcja
+ * zapisuje indeksy od swojego początku niezależnie od pozostałych.
+ */
+void ParticleSystem::allocate() {
+    if (m_instances.size() == m_capacity) return;
+    std::vector<float>* arrays[8];
+    getArrays(arrays);
+    for (std::vector<float>* array : arrays) array->resize(m_capacity);
+    m_instances.resize(m_capacity);
+    m_expired.resize(m_capacity);
+}
+
+/**
+ * @brief Usuwa wszystkie cząsteczki i zwalnia tablice
+ */
+void ParticleSystem::clear() {
+    std::vector<float>* arrays[8];
+    getArrays(arrays);
+    for (std::vector<float>* array : arrays) {
+        array->clear();
+        array->shrink_to_fit();
+    }
+    m_instances.clear();
+    m_instances.shrink_to_fit();
+    m_expired.clear();
+    m_expired.shrink_to_fit();
+    m_count = 0;
+    m_emitAccumulator = 0.0f;
+}
+
+/**
+ * @brief Usuwa martwe cząsteczki, przenosząc w ich miejsce żywe z końca
+ * @param expired Rosnące indeksy martwych cząsteczek
+ * @param expiredCount Liczba martwych cząsteczek
+ *
+ * @details Martwe cząsteczki na końcu tablic są po prostu odcinane;
+ * każda pozostała dziura zapełniana jest ostatnią żywą cząsteczką razem
+ * z jej danymi instancji.
+ */
+void ParticleSystem::removeExpired(const uint32_t* expired, size_t expiredCount) {
+    std::vector<float>* arrays[8];
+    getArrays(arrays);
+    size_t count = m_count;
+    size_t last = expiredCount;
+    for (size_t i = 0; i < expiredCount; ++i) {
+        while (last > i && expired[last - 1] == count - 1) {
+            --last;
+            --count;
+        }
+        size_t hole = expired[i];
+        if (hole >= count) break;
+
+        size_t source = --count;
+        for (std::vector<float>* array : arrays) (*array)[hole] = (*array)[source];
+        m_instances[hole] = m_instances[source];
+    }
+    m_count = count;
+}
+
+/**
+ * @brief Tworzy nowe cząsteczki na końcu tablic
+ * @param count Liczba nowych cząsteczek
+ *
+ * @details Losowanie zależy tylko od ziarna i numeru cząsteczki w emisji,
+ * więc porcje mogą być wypełniane równolegle w dowolnej kolejności.
+ * Czas życia jest ograniczany od dołu przez MIN_LIFETIME, bo wiek
+ * względny (wiek / czas życia) wyznacza rozmiar i kolor cząsteczki.
+ */
+void ParticleSystem::spawn(size_t count) {
+    if (count == 0) return;
+    allocate();
+
+    const ParticleEmitterSettings& settings = m_settings;
+    const size_t first = m_count;
+    const uint64_t seed = m_seed;
+    ThreadPool::instance().parallelFor(count, CHUNK_SIZE, [&](size_t begin, size_t end) {
+        float* x = m_x.data() + first;
+        float* y = m_y.data() + first;
+        float* z = m_z.data() + first;
+        float* vx = m_vx.data() + first;
+        float* vy = m_vy.data() + first;
+        float* vz = m_vz.data() + first;
+        float* age = m_age.data() + first;
+        float* lifetime = m_lifetime.data() + first;
+        glm::vec4* instances = m_instances.data() + first;
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t state = mixBits(seed + i * 8);
+            glm::vec3 position = settings.position;
+            glm::vec3 velocity = settings.velocity;
+            for (int axis = 0; axis < 3; ++axis) {
+                position[axis] += settings.positionSpread[axis] * signedUnit(state);
+                state = mixBits(state);
+                velocity[axis] += settings.velocitySpread[axis] * signedUnit(state);
+                state = mixBits(state);
+            }
+            float t = signedUnit(state) * 0.5f + 0.5f;
+            x[i] = position.x;
+            y[i] = position.y;
+            z[i] = position.z;
+            vx[i] = velocity.x;
+            vy[i] = velocity.y;
+            vz[i] = velocity.z;
+            age[i] = 0.0f;
+            lifetime[i] = std::max(settings.minLifetime + (settings.maxLifetime - settings.minLifetime) * t,
+                                   MIN_LIFETIME);
+            instances[i] = glm::vec4(position, 0.0f);
+        }
+    });
+    m_seed = mixBits(seed + count * 8);
+    m_count += count;
+}
+
+/**
+ * @brief Tworzy jednorazowo podaną liczbę cząsteczek
+ * @param count Liczba cząsteczek (obcinana do wolnego miejsca)
+ */
+void ParticleSystem::burst(size_t count) {
+    spawn(std::min(count, m_capacity - m_count));
+}
+
+/**
+ * @brief Wykonuje krok symulacji: ruch, usunięcie martwych, emisja
+ * @param deltaTime Czas od poprzedniego kroku [s]
+ *
+ * @details Jedyne przejście po wszystkich cząsteczkach (równolegle po
+ * porcjach CHUNK_SIZE) całkuje je w miejscu, zapisuje dane instancji
+ * i indeksy martwych w obrębie porcji. Indeksy porcji łączone są potem
+ * w jedną rosnącą listę dla kompaktacji, która działa na jednym wątku,
+ * bo dotyka tylko martwych cząsteczek. Krok czasu ograniczony jest do
+ * 0.1 s, żeby przycięcie okna nie wystrzeliło wszystkich cząsteczek
+ * przez podłoże.
+ */
+void ParticleSystem::update(float deltaTime) {
+    auto start = std::chrono::high_resolution_clock::now();
+    const float dt = std::min(std::max(deltaTime, 0.0f), 0.1f);
+    const ParticleEmitterSettings& settings = m_settings;
+
+    size_t expiredCount = 0;
+    if (m_count > 0) {
+        const size_t count = m_count;
+        const size_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        const float damping = std::max(0.0f, 1.0f - settings.drag * dt);
+        m_chunkExpired.assign(chunks, 0);
+
+        ThreadPool::instance().parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                size_t first = chunk * CHUNK_SIZE;
+                size_t size = std::min(CHUNK_SIZE, count - first);
+                Simd::integrateParticles(m_x.data() + first, m_y.data() + first, m_z.data() + first,
+                                         m_vx.data() + first, m_vy.data() + first, m_vz.data() + first,
+                                         m_age.data() + first, size, dt, settings.gravity.x, settings.gravity.y,
+                                         settings.gravity.z, damping, settings.floorHeight, settings.restitution);
+                Simd::storeParticleInstances(m_x.data() + first, m_y.data() + first, m_z.data() + first,
+                                             m_age.data() + first, m_lifetime.data() + first, size,
+                                             &m_instances[first].x);
+                uint32_t* expired = m_expired.data() + first;
+                size_t expiredInChunk = Simd::findExpiredParticles(m_age.data() + first, m_lifetime.data() + first,
+                                                                   size, expired);
+                for (size_t i = 0; i < expiredInChunk; ++i) expired[i] += static_cast<uint32_t>(first);
+                m_chunkExpired[chunk] = expiredInChunk;
+            }
+        });
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            const uint32_t* expired = m_expired.data() + chunk * CHUNK_SIZE;
+            std::copy(expired, expired + m_chunkExpired[chunk], m_expired.data() + expiredCount);
+            expiredCount += m_chunkExpired[chunk];
+        }
+        removeExpired(m_expired.data(), expiredCount);
+    }
+
+    size_t emitted = 0;
+    if (m_emitting) {
+        m_emitAccumulator += settings.rate * dt;
+        size_t requested = static_cast<size_t>(m_emitAccumulator);
+        m_emitAccumulator -= static_cast<float>(requested);
+        emitted = std::min(requested, m_capacity - m_count);
+        spawn(emitted);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Czasteczki/Zywe", static_cast<double>(m_count));
+    stats.setValue("Czasteczki/Emitowane", static_cast<double>(emitted));
+    stats.setValue("Czasteczki/Usuniete", static_cast<double>(expiredCount));
+    stats.setValue("Czasteczki/Symulacja [ms]", std::chrono::duration<double, std::milli>(end - start).count());
+}
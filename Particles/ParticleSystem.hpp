@@ -0,0 +1,168 @@
+// ParticleSystem.hpp
+#ifndef PARTICLE_SYSTEM_HPP
+#define PARTICLE_SYSTEM_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct ParticleEmitterSettings
+ * @brief Parametry emitera i wyglądu cząsteczek
+ */
+struct ParticleEmitterSettings {
+    glm::vec3 position = glm::vec3(0.0f);               /**< Środek emitera */
+    glm::vec3 positionSpread = glm::vec3(0.1f);         /**< Połowa boku prostopadłościanu narodzin */
+    glm::vec3 velocity = glm::vec3(0.0f, 8.0f, 0.0f);   /**< Średnia prędkość początkowa */
+    glm::vec3 velocitySpread = glm::vec3(2.0f);         /**< Największe odchylenie prędkości na osi */
+    glm::vec3 gravity = glm::vec3(0.0f, -9.81f, 0.0f);  /**< Przyspieszenie */
+    float rate = 1000.0f;                               /**< Nowe cząsteczki na sekundę */
+    float minLifetime = 2.0f;                           /**< Najkrótszy czas życia [s] (od dołu MIN_LIFETIME) */
+    float maxLifetime = 3.0f;                           /**< Najdłuższy czas życia [s] */
+    float drag = 0.1f;                                  /**< Opór powietrza [1/s] */
+    float floorHeight = -1.0e30f;                       /**< Wysokość podłoża odbijającego cząsteczki */
+    float restitution = 0.3f;                           /**< Część prędkości pionowej zachowana po odbiciu */
+    float startSize = 0.05f;                            /**< Bok cząsteczki przy narodzinach */
+    float endSize = 0.02f;                              /**< Bok cząsteczki na końcu życia */
+    glm::vec4 startColor = glm::vec4(1.0f, 0.8f, 0.3f, 1.0f);  /**< Kolor przy narodzinach */
+    glm::vec4 endColor = glm::vec4(0.8f, 0.1f, 0.0f, 0.0f);    /**< Kolor na końcu życia */
+};
+
+/**
+ * @class ParticleSystem
+ * @brief Symulacja dużej liczby cząsteczek na CPU w układzie SoA
+ *
+ * Każda właściwość cząsteczki leży w osobnej tablicy, więc przejścia
+ * całkowania, wyszukiwania martwych i zapisu danych instancji
+ * (Math/Simd.hpp) czytają kolejne floaty po cztery naraz. update() dzieli
+ * cząsteczki na porcje przetwarzane przez ThreadPool; każda porcja
+ * całkuje swoje cząsteczki, zapisuje ich dane instancji do wysłania na
+ * GPU i zbiera indeksy martwych. Kompaktacja przenosi w miejsce martwych
+ * żywe cząsteczki z końca tablic, więc kosztuje tyle, ile cząsteczek
+ * zginęło w kroku, a żywe zawsze zajmują początek tablic (kolejność nie
+ * jest zachowywana). Nowe cząsteczki dopisywane są na końcu, także
+ * równolegle.
+ *
+ * Klasa nie korzysta z OpenGL; bufory i rysowanie należą do
+ * ParticleRenderer.
+ */
+class ParticleSystem {
+public:
+    static const size_t DEFAULT_CAPACITY = 1000000;    /**< Domyślna największa liczba cząsteczek */
+    static const size_t CHUNK_SIZE = 16384;             /**< Liczba cząsteczek w porcji wątku */
+    static constexpr float MIN_LIFETIME = 1.0e-3f;      /**< Najkrótszy czas życia nadawany cząsteczce [s] */
+
+private:
+    ParticleEmitterSettings m_settings;     /**< Parametry emitera */
+    std::vector<float> m_x;                 /**< Pozycje X */
+    std::vector<float> m_y;                 /**< Pozycje Y */
+    std::vector<float> m_z;                 /**< Pozycje Z */
+    std::vector<float> m_vx;                /**< Prędkości X */
+    std::vector<float> m_vy;                /**< Prędkości Y */
+    std::vector<float> m_vz;                /**< Prędkości Z */
+    std::vector<float> m_age;               /**< Wiek [s] */
+    std::vector<float> m_lifetime;          /**< Czas życia [s] */
+    std::vector<glm::vec4> m_instances;     /**< Pozycja i część przeżytego życia żywych cząsteczek */
+    std::vector<uint32_t> m_expired;        /**< Indeksy martwych cząsteczek (każda porcja od swojego początku) */
+    std::vector<size_t> m_chunkExpired;     /**< Liczba martwych w porcji */
+    size_t m_capacity;                      /**< Największa liczba cząsteczek */
+    size_t m_count;                         /**< Liczba żywych cząsteczek */
+    uint64_t m_seed;                        /**< Ziarno losowania kolejnych emisji */
+    float m_emitAccumulator;                /**< Ułamek cząsteczki przeniesiony do następnej klatki */
+    bool m_emitting;                        /**< Czy emiter tworzy nowe cząsteczki */
+
+    /**
+     * @brief Zwraca wszystkie tablice właściwości
+     * @param arrays Tablica na 8 wskaźników (x, y, z, vx, vy, vz, wiek, czas życia)
+     */
+    void getArrays(std::vector<float>* arrays[8]);
+
+    /**
+     * @brief Usuwa martwe cząsteczki, przenosząc w ich miejsce żywe z końca
+     * @param expired Rosnące indeksy martwych cząsteczek
+     * @param expiredCount Liczba martwych cząsteczek
+     */
+    void removeExpired(const uint32_t* expired, size_t expiredCount);
+
+    /**
+     * @brief Przydziela tablice dla pojemności
+     */
+    void allocate();
+
+    /**
+     * @brief Tworzy nowe cząsteczki na końcu tablic
+     * @param count Liczba nowych cząsteczek
+     */
+    void spawn(size_t count);
+
+public:
+    /**
+     * @brief Konstruktor ParticleSystem
+     * @param capacity Największa liczba cząsteczek
+     *
+     * Tablice przydzielane są dopiero przy pierwszej emisji.
+     */
+    explicit ParticleSystem(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Ustawia parametry emitera
+     * @param settings Parametry
+     */
+    void setSettings(const ParticleEmitterSettings& settings) { m_settings = settings; }
+
+    /**
+     * @brief Zwraca parametry emitera
+     * @return Parametry
+     */
+    const ParticleEmitterSettings& getSettings() const { return m_settings; }
+
+    /**
+     * @brief Włącza lub wyłącza ciągłą emisję (żywe cząsteczki dożywają swojego czasu)
+     * @param emitting Czy emitować
+     */
+    void setEmitting(bool emitting) { m_emitting = emitting; }
+
+    /**
+     * @brief Sprawdza, czy emiter tworzy nowe cząsteczki
+     * @return true jeśli emisja jest włączona
+     */
+    bool isEmitting() const { return m_emitting; }
+
+    /**
+     * @brief Usuwa wszystkie cząsteczki i zwalnia tablice
+     */
+    void clear();
+
+    /**
+     * @brief Tworzy jednorazowo podaną liczbę cząsteczek
+     * @param count Liczba cząsteczek (obcinana do wolnego miejsca)
+     */
+    void burst(size_t count);
+
+    /**
+     * @brief Wykonuje krok symulacji: ruch, usunięcie martwych, emisja
+     * @param deltaTime Czas od poprzedniego kroku [s]
+     */
+    void update(float deltaTime);
+
+    /**
+     * @brief Zwraca liczbę żywych cząsteczek
+     * @return Liczba cząsteczek
+     */
+    size_t getCount() const { return m_count; }
+
+    /**
+     * @brief Zwraca największą liczbę cząsteczek
+     * @return Pojemność
+     */
+    size_t getCapacity() const { return m_capacity; }
+
+    /**
+     * @brief Zwraca dane instancji żywych cząsteczek
+     * @return getCount() wektorów (xyz = pozycja, w = wiek / czas życia)
+     */
+    const glm::vec4* getInstances() const { return m_instances.data(); }
+};
+
+#endif // PARTICLE_SYSTEM_HPP
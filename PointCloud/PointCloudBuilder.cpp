@@ -0,0 +1,781 @@
+// PointCloudBuilder.cpp
+#include "PointCloudBuilder.hpp"
+#include "PointCloudFormat.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+/** @brief Poziom siatki zliczania (64^3 komórek) */
+static const int COUNTING_LEVEL = 6;
+
+/** @brief Liczba komórek siatki zliczania na oś */
+static const int COUNTING_RESOLUTION = 1 << COUNTING_LEVEL;
+
+/** @brief Liczba punktów czytanych ze źródła naraz */
+static const size_t READ_BATCH = 1 << 20;
+
+/** @brief Łączny rozmiar buforów rozsyłania do porcji [B] */
+static const size_t DISTRIBUTION_BUFFER_BYTES = 64u << 20;
+
+/**
+ * @struct Cube
+ * @brief Sześcian węzła
+ */
+struct Cube {
+    glm::vec3 min;  /**< Minimalny narożnik */
+    float size;     /**< Bok */
+};
+
+/**
+ * @struct BuildNode
+ * @brief Węzeł drzewa w trakcie budowania
+ */
+struct BuildNode {
+    Cube cube;                                      /**< Sześcian węzła */
+    int level;                                      /**< Głębokość */
+    int children[8];                                /**< Indeksy dzieci (-1 = brak) */
+    uint32_t pointCount;                            /**< Liczba punktów */
+    int chunk;                                      /**< Porcja, w której pliku są punkty (-1 = w pamięci) */
+    uint64_t chunkOffset;                           /**< Położenie punktów w pliku porcji [B] */
+    std::vector<PointCloudInputPoint> points;       /**< Punkty trzymane w pamięci */
+};
+
+/**
+ * @struct BuildChunk
+ * @brief Porcja budowana niezależnie w jednym wątku
+ */
+struct BuildChunk {
+    Cube cube;                      /**< Sześcian porcji */
+    int level;                      /**< Głębokość korzenia porcji */
+    uint64_t pointCount;            /**< Liczba punktów */
+    std::string inputPath;          /**< Plik punktów rozesłanych do porcji */
+    std::string nodesPath;          /**< Plik skwantowanych punktów węzłów poddrzewa */
+    uint64_t nodesBytes;            /**< Rozmiar pliku węzłów [B] */
+    std::vector<BuildNode> nodes;   /**< Poddrzewo (korzeń pod indeksem 0) */
+    bool failed;                    /**< Czy przetwarzanie się nie powiodło */
+};
+
+/**
+ * @brief Sześcian dziecka w oktancie
+ * @param cube Sześcian rodzica
+ * @param octant Oktant (bit 0 = x, bit 1 = y, bit 2 = z)
+ * @return Sześcian dziecka
+ */
+static Cube childCube(const Cube& cube, int octant) {
+    float half = cube.size * 0.5f;
+    glm::vec3 offset(octant & 1, (octant >> 1) & 1, (octant >> 2) & 1);
+    return {cube.min + offset * half, half};
+}
+
+/**
+ * @brief Oktant sześcianu zawierający punkt
+ * @param cube Sześcian
+ * @param position Punkt
+ * @return Oktant (bit 0 = x, bit 1 = y, bit 2 = z)
+ */
+static int octantOf(const Cube& cube, const glm::vec3& position) {
+    glm::vec3 center = cube.min + glm::vec3(cube.size * 0.5f);
+    return (position.x >= center.x ? 1 : 0) | (position.y >= center.y ? 2 : 0) | (position.z >= center.z ? 4 : 0);
+}
+
+/**
+ * @brief Komórka siatki o danej rozdzielczości zawierająca punkt
+ * @param cube Sześcian siatki
+ * @param resolution Liczba komórek na oś
+ * @param position Punkt
+ * @return Współrzędne komórki
+ */
+static glm::ivec3 gridCell(const Cube& cube, int resolution, const glm::vec3& position) {
+    glm::vec3 local = (position - cube.min) / cube.size * static_cast<float>(resolution);
+    return glm::clamp(glm::ivec3(glm::floor(local)), glm::ivec3(0), glm::ivec3(resolution - 1));
+}
+
+/**
+ * @brief Kwantuje punkt względem sześcianu węzła
+ * @param point Punkt wejściowy
+ * @param cube Sześcian węzła
+ * @return Punkt w formacie pliku
+ */
+static PointCloudPoint quantizePoint(const PointCloudInputPoint& point, const Cube& cube) {
+    glm::vec3 local = glm::clamp((point.position - cube.min) / cube.size, 0.0f, 1.0f) * 65535.0f + 0.5f;
+    PointCloudPoint result;
+    for (int axis = 0; axis < 3; ++axis) result.position[axis] = static_cast<uint16_t>(local[axis]);
+    result.reserved = 0;
+    for (int channel = 0; channel < 4; ++channel) result.color[channel] = static_cast<uint8_t>(point.color >> (channel * 8));
+    return result;
+}
+
+/**
+ * @brief Tworzy pusty węzeł
+ * @param cube Sześcian węzła
+ * @param level Głębokość
+ * @return Węzeł bez punktów i dzieci
+ */
+static BuildNode makeNode(const Cube& cube, int level) {
+    BuildNode node;
+    node.cube = cube;
+    node.level = level;
+    std::fill(std::begin(node.children), std::end(node.children), -1);
+    node.pointCount = 0;
+    node.chunk = -1;
+    node.chunkOffset = 0;
+    return node;
+}
+
+/**
+ * @brief Próbkuje punkty na siatce węzła: pierwszy punkt komórki zostaje
+ * @param cube Sześcian węzła
+ * @param candidates Punkty do przejrzenia
+ * @param occupancy Bufor zajętości komórek (nadpisywany)
+ * @param kept Punkty przyjęte do węzła (dopisywane)
+ * @param rejected Punkty, których komórka była zajęta (dopisywane)
+ */
+static void sampleGrid(const Cube& cube, const std::vector<PointCloudInputPoint>& candidates,
+                       std::vector<uint64_t>& occupancy, std::vector<PointCloudInputPoint>& kept,
+                       std::vector<PointCloudInputPoint>& rejected) {
+    const int resolution = POINT_CLOUD_GRID_RESOLUTION;
+    for (const PointCloudInputPoint& point : candidates) {
+        glm::ivec3 cell = gridCell(cube, resolution, point.position);
+        size_t bit = static_cast<size_t>(cell.x) + resolution * (static_cast<size_t>(cell.y) + resolution * cell.z);
+        uint64_t mask = uint64_t(1) << (bit & 63);
+        if (occupancy[bit >> 6] & mask) {
+            rejected.push_back(point);
+        } else {
+            occupancy[bit >> 6] |= mask;
+            kept.push_back(point);
+        }
+    }
+}
+
+/**
+ * @brief Buduje poddrzewo z punktów w pamięci
+ * @param nodes Węzły poddrzewa (dopisywane)
+ * @param cube Sześcian węzła
+ * @param level Głębokość węzła
+ * @param points Punkty węzła i jego potomków (zwalniane)
+ * @param settings Parametry budowania
+ * @param occupancy Bufor zajętości komórek
+ * @return Indeks węzła w nodes
+ */
+static int buildSubtree(std::vector<BuildNode>& nodes, const Cube& cube, int level,
+                        std::vector<PointCloudInputPoint>&& points, const PointCloudBuildSettings& settings,
+                        std::vector<uint64_t>& occupancy) {
+    int index = static_cast<int>(nodes.size());
+    nodes.push_back(makeNode(cube, level));
+    if (points.size() <= settings.maxNodePoints || level >= settings.maxDepth) {
+        nodes[index].points = std::move(points);
+        return index;
+    }
+
+    const size_t cells = static_cast<size_t>(POINT_CLOUD_GRID_RESOLUTION) * POINT_CLOUD_GRID_RESOLUTION *
+                         POINT_CLOUD_GRID_RESOLUTION;
+    occupancy.assign(cells / 64, 0);
+    std::vector<PointCloudInputPoint> kept;
+    std::vector<PointCloudInputPoint> rest;
+    sampleGrid(cube, points, occupancy, kept, rest);
+    std::vector<PointCloudInputPoint>().swap(points);
+    nodes[index].points = std::move(kept);
+
+    std::vector<PointCloudInputPoint> childPoints[8];
+    for (const PointCloudInputPoint& point : rest) childPoints[octantOf(cube, point.position)].push_back(point);
+    std::vector<PointCloudInputPoint>().swap(rest);
+
+    for (int octant = 0; octant < 8; ++octant) {
+        if (childPoints[octant].empty()) continue;
+        int child = buildSubtree(nodes, childCube(cube, octant), level + 1, std::move(childPoints[octant]),
+                                 settings, occupancy);
+        nodes[index].children[octant] = child;
+    }
+    return index;
+}
+
+/**
+ * @brief Buduje poddrzewo porcji i zapisuje punkty węzłów poza korzeniem
+ * @param chunk Porcja
+ * @param settings Parametry budowania
+ *
+ * @details Korzeń zostaje w pamięci, bo przy budowaniu górnych poziomów
+ * część jego punktów przenoszona jest do przodków.
+ */
+static void processChunk(BuildChunk& chunk, const PointCloudBuildSettings& settings) {
+    std::vector<PointCloudInputPoint> points(chunk.pointCount);
+    {
+        std::ifstream input(chunk.inputPath, std::ios::binary);
+        input.read(reinterpret_cast<char*>(points.data()),
+                   static_cast<std::streamsize>(points.size() * sizeof(PointCloudInputPoint)));
+        if (!input) {
+            std::cerr << "Blad: Nie udalo sie odczytac pliku porcji " << chunk.inputPath << std::endl;
+            chunk.failed = true;
+            return;
+        }
+    }
+    std::filesystem::remove(chunk.inputPath);
+
+    std::vector<uint64_t> occupancy;
+    buildSubtree(chunk.nodes, chunk.cube, chunk.level, std::move(points), settings, occupancy);
+
+    std::ofstream output(chunk.nodesPath, std::ios::binary | std::ios::trunc);
+    std::vector<PointCloudPoint> quantized;
+    uint64_t offset = 0;
+    for (size_t i = 0; i < chunk.nodes.size(); ++i) {
+        BuildNode& node = chunk.nodes[i];
+        node.pointCount = static_cast<uint32_t>(node.points.size());
+        if (i == 0) continue;
+
+        quantized.clear();
+        for (const PointCloudInputPoint& point : node.points) quantized.push_back(quantizePoint(point, node.cube));
+        output.write(reinterpret_cast<const char*>(quantized.data()),
+                     static_cast<std::streamsize>(quantized.size() * sizeof(PointCloudPoint)));
+        node.chunkOffset = offset;
+        offset += quantized.size() * sizeof(PointCloudPoint);
+        std::vector<PointCloudInputPoint>().swap(node.points);
+    }
+    chunk.nodesBytes = offset;
+    if (!output) {
+        std::cerr << "Blad: Nie udalo sie zapisac pliku porcji " << chunk.nodesPath << std::endl;
+        chunk.failed = true;
+    }
+}
+
+/**
+ * @brief Dzieli przestrzeń na porcje według liczników siatki 64^3
+ * @param sums Liczniki kolejnych poziomów (sums[COUNTING_LEVEL] = siatka zliczania)
+ * @param root Sześcian korzenia
+ * @param level Poziom komórki
+ * @param cell Współrzędne komórki na poziomie
+ * @param maxChunkPoints Największa liczba punktów porcji
+ * @param chunks Porcje (dopisywane)
+ * @param cellToChunk Porcja każdej komórki siatki zliczania
+ */
+static void selectChunks(const std::vector<std::vector<uint64_t>>& sums, const Cube& root, int level,
+                         const glm::ivec3& cell, size_t maxChunkPoints, std::vector<BuildChunk>& chunks,
+                         std::vector<int>& cellToChunk) {
+    int resolution = 1 << level;
+    uint64_t count = sums[level][cell.x + resolution * (cell.y + resolution * static_cast<size_t>(cell.z))];
+    if (count == 0) return;
+
+    if (count <= maxChunkPoints || level == COUNTING_LEVEL) {
+        BuildChunk chunk;
+        float size = root.size / resolution;
+        chunk.cube = {root.min + glm::vec3(cell) * size, size};
+        chunk.level = level;
+        chunk.pointCount = 0;
+        chunk.nodesBytes = 0;
+        chunk.failed = false;
+        int shift = COUNTING_LEVEL - level;
+        for (int z = cell.z << shift; z < (cell.z + 1) << shift; ++z) {
+            for (int y = cell.y << shift; y < (cell.y + 1) << shift; ++y) {
+                for (int x = cell.x << shift; x < (cell.x + 1) << shift; ++x) {
+                    cellToChunk[x + COUNTING_RESOLUTION * (y + COUNTING_RESOLUTION * static_cast<size_t>(z))] =
+                        static_cast<int>(chunks.size());
+                }
+            }
+        }
+        chunks.push_back(std::move(chunk));
+        return;
+    }
+    for (int octant = 0; octant < 8; ++octant) {
+        glm::ivec3 child = cell * 2 + glm::ivec3(octant & 1, (octant >> 1) & 1, (octant >> 2) & 1);
+        selectChunks(sums, root, level + 1, child, maxChunkPoints, chunks, cellToChunk);
+    }
+}
+
+/**
+ * @brief Buduje węzły powyżej porcji, przenosząc do nich próbkę punktów dzieci
+ * @param nodes Wszystkie węzły (dopisywane)
+ * @param chunkRoots Indeks korzenia porcji w nodes
+ * @param sums Liczniki poziomów siatki zliczania
+ * @param cellToChunk Porcja każdej komórki siatki zliczania
+ * @param root Sześcian korzenia
+ * @param level Poziom węzła
+ * @param cell Współrzędne węzła na poziomie
+ * @param occupancy Bufor zajętości komórek
+ * @return Indeks węzła lub -1, gdy jest pusty
+ */
+static int buildUpperLevels(std::vector<BuildNode>& nodes, const std::vector<int>& chunkRoots,
+                            const std::vector<std::vector<uint64_t>>& sums, const std::vector<int>& cellToChunk,
+                            const Cube& root, int level, const glm::ivec3& cell, std::vector<uint64_t>& occupancy) {
+    int resolution = 1 << level;
+    if (sums[level][cell.x + resolution * (cell.y + resolution * static_cast<size_t>(cell.z))] == 0) return -1;
+
+    // Komórka będąca porcją ma już poddrzewo
+    int shift = COUNTING_LEVEL - level;
+    glm::ivec3 first(cell.x << shift, cell.y << shift, cell.z << shift);
+    int chunk = cellToChunk[first.x + COUNTING_RESOLUTION * (first.y + COUNTING_RESOLUTION * static_cast<size_t>(first.z))];
+    const BuildNode& chunkRoot = nodes[chunkRoots[chunk]];
+    if (chunkRoot.level == level) return chunkRoots[chunk];
+
+    float size = root.size / resolution;
+    Cube cube = {root.min + glm::vec3(cell) * size, size};
+    int children[8];
+    for (int octant = 0; octant < 8; ++octant) {
+        glm::ivec3 child = cell * 2 + glm::ivec3(octant & 1, (octant >> 1) & 1, (octant >> 2) & 1);
+        children[octant] = buildUpperLevels(nodes, chunkRoots, sums, cellToChunk, root, level + 1, child, occupancy);
+    }
+
+    int index = static_cast<int>(nodes.size());
+    nodes.push_back(makeNode(cube, level));
+    const size_t cells = static_cast<size_t>(POINT_CLOUD_GRID_RESOLUTION) * POINT_CLOUD_GRID_RESOLUTION *
+                         POINT_CLOUD_GRID_RESOLUTION;
+    occupancy.assign(cells / 64, 0);
+    std::vector<PointCloudInputPoint> kept;
+    for (int octant = 0; octant < 8; ++octant) {
+        if (children[octant] < 0) continue;
+        BuildNode& child = nodes[children[octant]];
+        std::vector<PointCloudInputPoint> remaining;
+        sampleGrid(cube, child.points, occupancy, kept, remaining);
+        child.points = std::move(remaining);
+        child.pointCount = static_cast<uint32_t>(child.points.size());
+
+        // Liść, którego wszystkie punkty przeszły wyżej, nie jest potrzebny
+        bool leaf = std::all_of(std::begin(child.children), std::end(child.children), [](int c) { return c < 0; });
+        if (child.pointCount == 0 && leaf) children[octant] = -1;
+    }
+    BuildNode& node = nodes[index];
+    node.points = std::move(kept);
+    node.pointCount = static_cast<uint32_t>(node.points.size());
+    std::copy(std::begin(children), std::end(children), std::begin(node.children));
+    return index;
+}
+
+/**
+ * @brief Dopisuje zawartość pliku do strumienia
+ * @param path Plik źródłowy
+ * @param output Strumień docelowy
+ * @return true jeśli kopiowanie się powiodło
+ */
+static bool appendFile(const std::string& path, std::ofstream& output) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return false;
+    std::vector<char> buffer(1 << 20);
+    while (input) {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        output.write(buffer.data(), input.gcount());
+    }
+    return static_cast<bool>(output);
+}
+
+/**
+ * @brief Czas od punktu startowego w sekundach
+ * @param start Punkt startowy
+ * @return Liczba sekund
+ */
+static double secondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+ * @brief Buduje plik drzewa
+ * @param source Źródło punktów
+ * @param outputPath Ścieżka pliku wynikowego
+ * @param settings Parametry budowania
+ * @return true jeśli plik został zapisany
+ *
+ * @details Źródło czytane jest trzy razy (sześcian, zliczanie, rozsyłanie).
+ * Pliki pośrednie porcji usuwane są po zapisie pliku wynikowego.
+ */
+bool PointCloudBuilder::build(PointCloudSource& source, const std::string& outputPath,
+                              const PointCloudBuildSettings& settings) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<PointCloudInputPoint> batch;
+
+    // 1. Sześcian otaczający
+    glm::vec3 low(FLT_MAX), high(-FLT_MAX);
+    uint64_t totalPoints = 0;
+    if (!source.rewind()) {
+        std::cerr << "Blad: Nie udalo sie przewinac zrodla punktow" << std::endl;
+        return false;
+    }
+    while (source.read(batch, READ_BATCH)) {
+        for (const PointCloudInputPoint& point : batch) {
+            low = glm::min(low, point.position);
+            high = glm::max(high, point.position);
+        }
+        totalPoints += batch.size();
+    }
+    if (totalPoints == 0) {
+        std::cerr << "Blad: Zrodlo nie zawiera punktow" << std::endl;
+        return false;
+    }
+    glm::vec3 extent = high - low;
+    float size = std::max(std::max(extent.x, extent.y), extent.z);
+    Cube root = {low, std::max(size * 1.0001f, 1.0e-3f)};
+    std::cout << "Chmura punktow: " << totalPoints << " punktow, bok " << root.size << " ("
+              << secondsSince(start) << " s)" << std::endl;
+
+    // 2. Zliczanie w siatce 64^3 i podział na porcje
+    ThreadPool& pool = ThreadPool::instance();
+    const size_t countingCells = static_cast<size_t>(COUNTING_RESOLUTION) * COUNTING_RESOLUTION * COUNTING_RESOLUTION;
+    std::vector<std::vector<uint64_t>> sums(COUNTING_LEVEL + 1);
+    sums[COUNTING_LEVEL].assign(countingCells, 0);
+    std::vector<uint32_t> cellIndices;
+    source.rewind();
+    while (source.read(batch, READ_BATCH)) {
+        cellIndices.resize(batch.size());
+        pool.parallelFor(batch.size(), 16384, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                glm::ivec3 cell = gridCell(root, COUNTING_RESOLUTION, batch[i].position);
+                cellIndices[i] = static_cast<uint32_t>(cell.x + COUNTING_RESOLUTION * (cell.y + COUNTING_RESOLUTION * cell.z));
+            }
+        });
+        for (uint32_t cell : cellIndices) sums[COUNTING_LEVEL][cell]++;
+    }
+    for (int level = COUNTING_LEVEL - 1; level >= 0; --level) {
+        int resolution = 1 << level;
+        int childResolution = resolution * 2;
+        sums[level].assign(static_cast<size_t>(resolution) * resolution * resolution, 0);
+        for (int z = 0; z < childResolution; ++z) {
+            for (int y = 0; y < childResolution; ++y) {
+                for (int x = 0; x < childResolution; ++x) {
+                    sums[level][(x / 2) + resolution * ((y / 2) + resolution * static_cast<size_t>(z / 2))] +=
+                        sums[level + 1][x + childResolution * (y + childResolution * static_cast<size_t>(z))];
+                }
+            }
+        }
+    }
+
+    std::vector<BuildChunk> chunks;
+    std::vector<int> cellToChunk(countingCells, -1);
+    selectChunks(sums, root, 0, glm::ivec3(0), settings.maxChunkPoints, chunks, cellToChunk);
+
+    std::filesystem::path temporary = settings.temporaryDirectory.empty()
+                                          ? std::filesystem::path(outputPath + ".tmp")
+                                          : std::filesystem::path(settings.temporaryDirectory);
+    std::error_code error;
+    std::filesystem::create_directories(temporary, error);
+    if (error) {
+        std::cerr << "Blad: Nie udalo sie utworzyc katalogu " << temporary.string() << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].inputPath = (temporary / ("porcja_" + std::to_string(i) + ".punkty")).string();
+        chunks[i].nodesPath = (temporary / ("porcja_" + std::to_string(i) + ".wezly")).string();
+        std::ofstream(chunks[i].inputPath, std::ios::binary | std::ios::trunc);
+    }
+    std::cout << "Chmura punktow: " << chunks.size() << " porcji (" << secondsSince(start) << " s)" << std::endl;
+
+    // 3. Rozsyłanie punktów do plików porcji
+    size_t flushPoints = std::max<size_t>(1024, DISTRIBUTION_BUFFER_BYTES / sizeof(PointCloudInputPoint) / chunks.size());
+    std::vector<std::vector<PointCloudInputPoint>> buffers(chunks.size());
+    bool written = true;
+    auto flush = [&](size_t chunk) {
+        std::ofstream output(chunks[chunk].inputPath, std::ios::binary | std::ios::app);
+        output.write(reinterpret_cast<const char*>(buffers[chunk].data()),
+                     static_cast<std::streamsize>(buffers[chunk].size() * sizeof(PointCloudInputPoint)));
+        written = written && static_cast<bool>(output);
+        chunks[chunk].pointCount += buffers[chunk].size();
+        buffers[chunk].clear();
+    };
+    source.rewind();
+    while (source.read(batch, READ_BATCH)) {
+        cellIndices.resize(batch.size());
+        pool.parallelFor(batch.size(), 16384, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                glm::ivec3 cell = gridCell(root, COUNTING_RESOLUTION, batch[i].position);
+                cellIndices[i] = static_cast<uint32_t>(cell.x + COUNTING_RESOLUTION * (cell.y + COUNTING_RESOLUTION * cell.z));
+            }
+        });
+        for (size_t i = 0; i < batch.size(); ++i) {
+            size_t chunk = static_cast<size_t>(cellToChunk[cellIndices[i]]);
+            buffers[chunk].push_back(batch[i]);
+            if (buffers[chunk].size() >= flushPoints) flush(chunk);
+        }
+    }
+    for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        if (!buffers[chunk].empty()) flush(chunk);
+        std::vector<PointCloudInputPoint>().swap(buffers[chunk]);
+    }
+    if (!written) {
+        std::cerr << "Blad: Nie udalo sie zapisac plikow porcji w " << temporary.string() << std::endl;
+        return false;
+    }
+    std::cout << "Chmura punktow: punkty rozeslane (" << secondsSince(start) << " s)" << std::endl;
+
+    // 4. Poddrzewa porcji równolegle
+    std::atomic<size_t> finishedChunks{0};
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            processChunk(chunks[i], settings);
+            finishedChunks++;
+        }
+    });
+    for (const BuildChunk& chunk : chunks) {
+        if (chunk.failed) return false;
+    }
+    std::cout << "Chmura punktow: " << finishedChunks.load() << " poddrzew zbudowanych (" << secondsSince(start)
+              << " s)" << std::endl;
+
+    // 5. Złączenie poddrzew i górne poziomy
+    std::vector<BuildNode> nodes;
+    std::vector<int> chunkRoots(chunks.size());
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        int base = static_cast<int>(nodes.size());
+        chunkRoots[c] = base;
+        for (size_t i = 0; i < chunks[c].nodes.size(); ++i) {
+            BuildNode node = std::move(chunks[c].nodes[i]);
+            for (int& child : node.children) {
+                if (child >= 0) child += base;
+            }
+            if (i > 0) node.chunk = static_cast<int>(c);
+            nodes.push_back(std::move(node));
+        }
+        std::vector<BuildNode>().swap(chunks[c].nodes);
+    }
+    std::vector<uint64_t> occupancy;
+    int rootIndex = buildUpperLevels(nodes, chunkRoots, sums, cellToChunk, root, 0, glm::ivec3(0), occupancy);
+
+    // Kolejność wszerz: dzieci każdego węzła zajmują kolejne rekordy
+    std::vector<int> order;
+    std::vector<uint32_t> firstChild;
+    std::deque<int> queue = {rootIndex};
+    std::vector<uint32_t> recordIndex(nodes.size(), 0);
+    while (!queue.empty()) {
+        int node = queue.front();
+        queue.pop_front();
+        recordIndex[node] = static_cast<uint32_t>(order.size());
+        order.push_back(node);
+        for (int child : nodes[node].children) {
+            if (child >= 0) queue.push_back(child);
+        }
+    }
+
+    uint64_t dataStart = sizeof(PointCloudFileHeader) + order.size() * sizeof(PointCloudNodeRecord);
+    uint64_t memoryBytes = 0;
+    for (int node : order) {
+        if (nodes[node].chunk < 0) memoryBytes += static_cast<uint64_t>(nodes[node].pointCount) * sizeof(PointCloudPoint);
+    }
+    std::vector<uint64_t> chunkBase(chunks.size());
+    uint64_t chunkOffset = dataStart + memoryBytes;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        chunkBase[c] = chunkOffset;
+        chunkOffset += chunks[c].nodesBytes;
+    }
+
+    std::vector<PointCloudNodeRecord> records(order.size());
+    uint64_t memoryOffset = dataStart;
+    uint64_t writtenPoints = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const BuildNode& node = nodes[order[i]];
+        PointCloudNodeRecord& record = records[i];
+        std::memset(&record, 0, sizeof(record));
+        record.pointCount = node.pointCount;
+        record.level = static_cast<uint8_t>(node.level);
+        for (int axis = 0; axis < 3; ++axis) record.min[axis] = node.cube.min[axis];
+        record.size = node.cube.size;
+        record.spacing = node.cube.size / POINT_CLOUD_GRID_RESOLUTION;
+        for (int octant = 0; octant < 8; ++octant) {
+            if (node.children[octant] < 0) continue;
+            if (record.childMask == 0) record.firstChild = recordIndex[node.children[octant]];
+            record.childMask |= static_cast<uint8_t>(1u << octant);
+        }
+        if (node.chunk < 0) {
+            record.offset = memoryOffset;
+            memoryOffset += static_cast<uint64_t>(node.pointCount) * sizeof(PointCloudPoint);
+        } else {
+            record.offset = chunkBase[node.chunk] + node.chunkOffset;
+        }
+        writtenPoints += node.pointCount;
+    }
+
+    // Zapis: nagłówek, węzły, punkty węzłów z pamięci, pliki porcji
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        std::cerr << "Blad: Nie udalo sie otworzyc pliku " << outputPath << std::endl;
+        return false;
+    }
+    PointCloudFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = POINT_CLOUD_MAGIC;
+    header.version = POINT_CLOUD_VERSION;
+    header.pointCount = writtenPoints;
+    header.nodeCount = static_cast<uint32_t>(records.size());
+    for (int axis = 0; axis < 3; ++axis) header.min[axis] = root.min[axis];
+    header.size = root.size;
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(records.data()),
+                 static_cast<std::streamsize>(records.size() * sizeof(PointCloudNodeRecord)));
+
+    std::vector<PointCloudPoint> quantized;
+    for (int index : order) {
+        BuildNode& node = nodes[index];
+        if (node.chunk >= 0) continue;
+        quantized.clear();
+        for (const PointCloudInputPoint& point : node.points) quantized.push_back(quantizePoint(point, node.cube));
+        output.write(reinterpret_cast<const char*>(quantized.data()),
+                     static_cast<std::streamsize>(quantized.size() * sizeof(PointCloudPoint)));
+        std::vector<PointCloudInputPoint>().swap(node.points);
+    }
+    bool copied = true;
+    for (const BuildChunk& chunk : chunks) {
+        copied = copied && appendFile(chunk.nodesPath, output);
+        std::filesystem::remove(chunk.nodesPath);
+    }
+    std::filesystem::remove(temporary, error);
+    if (!copied || !output) {
+        std::cerr << "Blad: Nie udalo sie zapisac pliku " << outputPath << std::endl;
+        return false;
+    }
+
+    std::cout << "Chmura punktow: zapisano " << outputPath << " (" << records.size() << " wezlow, "
+              << writtenPoints << " punktow, " << secondsSince(start) << " s)" << std::endl;
+    return true;
+}
+
+/**
+ * @brief Otwiera plik
+ * @param path Ścieżka pliku
+ */
+XyzPointCloudSource::XyzPointCloudSource(const std::string& path) : m_file(path) {}
+
+/**
+ * @brief Czyta kolejną porcję punktów
+ * @param points Bufor wyjściowy (czyszczony)
+ * @param maxCount Największa liczba punktów porcji
+ * @return false po końcu danych (bufor pusty)
+ *
+ * @details Wiersze, które nie zaczynają się od trzech liczb, są pomijane;
+ * brak koloru oznacza szarość.
+ */
+bool XyzPointCloudSource::read(std::vector<PointCloudInputPoint>& points, size_t maxCount) {
+    points.clear();
+    while (points.size() < maxCount && std::getline(m_file, m_line)) {
+        const char* cursor = m_line.c_str();
+        char* end = nullptr;
+        float values[6] = {0.0f, 0.0f, 0.0f, 180.0f, 180.0f, 180.0f};
+        int parsed = 0;
+        for (; parsed < 6; ++parsed) {
+            values[parsed] = std::strtof(cursor, &end);
+            if (end == cursor) break;
+            cursor = end;
+        }
+        if (parsed < 3) continue;
+        if (parsed < 6) values[3] = values[4] = values[5] = 180.0f;
+
+        PointCloudInputPoint point;
+        point.position = glm::vec3(values[0], values[1], values[2]);
+        point.color = 0xff000000u;
+        for (int channel = 0; channel < 3; ++channel) {
+            point.color |= static_cast<uint32_t>(std::clamp(values[3 + channel], 0.0f, 255.0f)) << (channel * 8);
+        }
+        points.push_back(point);
+    }
+    return !points.empty();
+}
+
+/**
+ * @brief Wraca na początek danych
+ * @return true jeśli się powiodło
+ */
+bool XyzPointCloudSource::rewind() {
+    m_file.clear();
+    m_file.seekg(0);
+    return static_cast<bool>(m_file);
+}
+
+/**
+ * @brief Otwiera plik
+ * @param path Ścieżka pliku
+ */
+RawPointCloudSource::RawPointCloudSource(const std::string& path) : m_file(path, std::ios::binary) {}
+
+/**
+ * @brief Czyta kolejną porcję punktów
+ * @param points Bufor wyjściowy (czyszczony)
+ * @param maxCount Największa liczba punktów porcji
+ * @return false po końcu danych (bufor pusty)
+ */
+bool RawPointCloudSource::read(std::vector<PointCloudInputPoint>& points, size_t maxCount) {
+    points.resize(maxCount);
+    m_file.read(reinterpret_cast<char*>(points.data()), static_cast<std::streamsize>(maxCount * sizeof(PointCloudInputPoint)));
+    points.resize(static_cast<size_t>(m_file.gcount()) / sizeof(PointCloudInputPoint));
+    return !points.empty();
+}
+
+/**
+ * @brief Wraca na początek danych
+ * @return true jeśli się powiodło
+ */
+bool RawPointCloudSource::rewind() {
+    m_file.clear();
+    m_file.seekg(0);
+    return static_cast<bool>(m_file);
+}
+
+/**
+ * @brief Miesza bity liczby (splitmix64)
+ * @param value Wartość wejściowa
+ * @return Pseudolosowe 64 bity
+ */
+static uint64_t mixBits(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Konstruktor SyntheticPointCloudSource
+ * @param count Liczba punktów
+ * @param extent Bok kwadratu terenu
+ */
+SyntheticPointCloudSource::SyntheticPointCloudSource(uint64_t count, float extent)
+    : m_count(count), m_next(0), m_extent(extent) {}
+
+/**
+ * @brief Czyta kolejną porcję punktów
+ * @param points Bufor wyjściowy (czyszczony)
+ * @param maxCount Największa liczba punktów porcji
+ * @return false po końcu danych (bufor pusty)
+ *
+ * @details Wysokość terenu to suma kilku fal; kolor zależy od wysokości
+ * (zieleń w dolinach, skały i śnieg na szczytach).
+ */
+bool SyntheticPointCloudSource::read(std::vector<PointCloudInputPoint>& points, size_t maxCount) {
+    size_t count = static_cast<size_t>(std::min<uint64_t>(maxCount, m_count - m_next));
+    points.resize(count);
+    uint64_t first = m_next;
+    float extent = m_extent;
+    ThreadPool::instance().parallelFor(count, 16384, [&points, first, extent](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t bits = mixBits(first + i);
+            float u = static_cast<float>(bits & 0xffffff) / 16777216.0f;
+            float v = static_cast<float>((bits >> 24) & 0xffffff) / 16777216.0f;
+            float noise = static_cast<float>((bits >> 48) & 0xffff) / 65536.0f;
+            float x = u * extent;
+            float z = v * extent;
+            float k = 6.2831853f / extent;
+            float height = extent * (0.04f * std::sin(x * k * 2.0f) * std::cos(z * k * 3.0f) +
+                                     0.015f * std::sin(x * k * 11.0f + z * k * 7.0f) +
+                                     0.004f * std::sin(x * k * 53.0f) * std::sin(z * k * 47.0f));
+            float t = glm::clamp(height / (extent * 0.05f) * 0.5f + 0.5f, 0.0f, 1.0f);
+            glm::vec3 low(0.25f, 0.45f, 0.2f), mid(0.45f, 0.4f, 0.35f), top(0.95f, 0.95f, 0.97f);
+            glm::vec3 color = t < 0.6f ? glm::mix(low, mid, t / 0.6f) : glm::mix(mid, top, (t - 0.6f) / 0.4f);
+            color *= 0.85f + 0.15f * noise;
+
+            PointCloudInputPoint& point = points[i];
+            point.position = glm::vec3(x, height + noise * extent * 0.0005f, z);
+            point.color = 0xff000000u | static_cast<uint32_t>(color.r * 255.0f) |
+                          (static_cast<uint32_t>(color.g * 255.0f) << 8) | (static_cast<uint32_t>(color.b * 255.0f) << 16);
+        }
+    });
+    m_next += count;
+    return count > 0;
+}
+
+/**
+ * @brief Wraca na początek danych
+ * @return true jeśli się powiodło
+ */
+bool SyntheticPointCloudSource::rewind() {
+    m_next = 0;
+    return true;
+}
@@ -0,0 +1,163 @@
+// PointCloudBuilder.hpp
+#ifndef POINT_CLOUD_BUILDER_HPP
+#define POINT_CLOUD_BUILDER_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct PointCloudInputPoint
+ * @brief Punkt wejściowy w przestrzeni świata
+ */
+struct PointCloudInputPoint {
+    glm::vec3 position;     /**< Położenie */
+    uint32_t color;         /**< Kolor RGBA8 (R w najmłodszym bajcie) */
+};
+
+/**
+ * @class PointCloudSource
+ * @brief Strumień punktów wejściowych czytany porcjami
+ *
+ * Budowanie przechodzi po danych kilka razy, więc źródło musi dać się
+ * przewinąć na początek; nie musi mieścić się w pamięci.
+ */
+class PointCloudSource {
+public:
+    virtual ~PointCloudSource() = default;
+
+    /**
+     * @brief Czyta kolejną porcję punktów
+     * @param points Bufor wyjściowy (czyszczony)
+     * @param maxCount Największa liczba punktów porcji
+     * @return false po końcu danych (bufor pusty)
+     */
+    virtual bool read(std::vector<PointCloudInputPoint>& points, size_t maxCount) = 0;
+
+    /**
+     * @brief Wraca na początek danych
+     * @return true jeśli się powiodło
+     */
+    virtual bool rewind() = 0;
+};
+
+/**
+ * @class XyzPointCloudSource
+ * @brief Plik tekstowy z wierszami "x y z [r g b]" (kolory 0-255)
+ */
+class XyzPointCloudSource : public PointCloudSource {
+private:
+    std::ifstream m_file;   /**< Plik wejściowy */
+    std::string m_line;     /**< Bufor wiersza */
+
+public:
+    /**
+     * @brief Otwiera plik
+     * @param path Ścieżka pliku
+     */
+    explicit XyzPointCloudSource(const std::string& path);
+
+    /**
+     * @brief Sprawdza, czy plik został otwarty
+     * @return true jeśli plik jest otwarty
+     */
+    bool isOpen() const { return m_file.is_open(); }
+
+    bool read(std::vector<PointCloudInputPoint>& points, size_t maxCount) override;
+    bool rewind() override;
+};
+
+/**
+ * @class RawPointCloudSource
+ * @brief Plik binarny z kolejnymi rekordami PointCloudInputPoint (16 B)
+ */
+class RawPointCloudSource : public PointCloudSource {
+private:
+    std::ifstream m_file;   /**< Plik wejściowy */
+
+public:
+    /**
+     * @brief Otwiera plik
+     * @param path Ścieżka pliku
+     */
+    explicit RawPointCloudSource(const std::string& path);
+
+    /**
+     * @brief Sprawdza, czy plik został otwarty
+     * @return true jeśli plik jest otwarty
+     */
+    bool isOpen() const { return m_file.is_open(); }
+
+    bool read(std::vector<PointCloudInputPoint>& points, size_t maxCount) override;
+    bool rewind() override;
+};
+
+/**
+ * @class SyntheticPointCloudSource
+ * @brief Generowany teren z punktami na powierzchni (do testów dużych zbiorów)
+ *
+ * Punkt i zależy tylko od i, więc zbiór dowolnej wielkości powstaje
+ * bez pamięci i jest taki sam po przewinięciu.
+ */
+class SyntheticPointCloudSource : public PointCloudSource {
+private:
+    uint64_t m_count;   /**< Liczba punktów */
+    uint64_t m_next;    /**< Indeks następnego punktu */
+    float m_extent;     /**< Bok kwadratu terenu */
+
+public:
+    /**
+     * @brief Konstruktor SyntheticPointCloudSource
+     * @param count Liczba punktów
+     * @param extent Bok kwadratu terenu
+     */
+    SyntheticPointCloudSource(uint64_t count, float extent);
+
+    bool read(std::vector<PointCloudInputPoint>& points, size_t maxCount) override;
+    bool rewind() override;
+};
+
+/**
+ * @struct PointCloudBuildSettings
+ * @brief Parametry budowania drzewa
+ */
+struct PointCloudBuildSettings {
+    size_t maxNodePoints = 20000;           /**< Węzeł z nie więcej punktami staje się liściem */
+    size_t maxChunkPoints = 2000000;        /**< Największa porcja budowana w pamięci jednego wątku */
+    int maxDepth = 20;                      /**< Największa głębokość drzewa */
+    std::string temporaryDirectory;         /**< Katalog plików pośrednich (pusty = obok wyjścia) */
+};
+
+/**
+ * @class PointCloudBuilder
+ * @brief Buduje plik oktalnego drzewa chmury punktów poza pamięcią
+ *
+ * Dane dowolnej wielkości przetwarzane są w pięciu przejściach:
+ * 1. wyznaczenie sześcianu otaczającego,
+ * 2. zliczenie punktów w siatce 64^3 i złączenie komórek w porcje
+ *    o co najwyżej maxChunkPoints punktach,
+ * 3. rozesłanie punktów do plików pośrednich porcji,
+ * 4. równoległe (ThreadPool) zbudowanie poddrzewa każdej porcji w pamięci,
+ * 5. zbudowanie górnych poziomów przez przeniesienie próbki punktów
+ *    z korzeni porcji do rodziców i zapis pliku wynikowego.
+ *
+ * W pamięci mieszczą się naraz najwyżej porcje przetwarzane przez wątki
+ * oraz korzenie porcji, niezależnie od rozmiaru zbioru.
+ */
+class PointCloudBuilder {
+public:
+    /**
+     * @brief Buduje plik drzewa
+     * @param source Źródło punktów
+     * @param outputPath Ścieżka pliku wynikowego
+     * @param settings Parametry budowania
+     * @return true jeśli plik został zapisany
+     */
+    static bool build(PointCloudSource& source, const std::string& outputPath,
+                      const PointCloudBuildSettings& settings = PointCloudBuildSettings());
+};
+
+#endif // POINT_CLOUD_BUILDER_HPP
@@ -0,0 +1,78 @@
+// PointCloudFormat.hpp
+#ifndef POINT_CLOUD_FORMAT_HPP
+#define POINT_CLOUD_FORMAT_HPP
+
+#include <cstdint>
+
+/**
+ * @file PointCloudFormat.hpp
+ * @brief Układ pliku oktalnego drzewa chmury punktów
+ *
+ * Plik składa się z nagłówka, tablicy węzłów i danych punktów:
+ *
+ *     PointCloudFileHeader
+ *     PointCloudNodeRecord[nodeCount]   (kolejność wszerz, dzieci węzła kolejno)
+ *     PointCloudPoint[...]              (punkty węzła pod record.offset)
+ *
+ * Drzewo jest addytywne: każdy punkt zapisany jest dokładnie raz, a węzeł
+ * zawiera rzadką próbkę swojego sześcianu, którą dzieci zagęszczają. Rysując
+ * węzeł, trzeba więc narysować też wszystkich jego przodków.
+ */
+
+/** @brief Znacznik pliku ("SPCO") */
+static const uint32_t POINT_CLOUD_MAGIC = 0x4f435053u;
+
+/** @brief Wersja układu pliku */
+static const uint32_t POINT_CLOUD_VERSION = 1;
+
+/** @brief Rozdzielczość siatki próbkowania węzła (odstęp punktów = rozmiar / rozdzielczość) */
+static const int POINT_CLOUD_GRID_RESOLUTION = 128;
+
+/**
+ * @struct PointCloudFileHeader
+ * @brief Nagłówek pliku chmury punktów
+ */
+struct PointCloudFileHeader {
+    uint32_t magic;         /**< POINT_CLOUD_MAGIC */
+    uint32_t version;       /**< POINT_CLOUD_VERSION */
+    uint64_t pointCount;    /**< Liczba wszystkich punktów */
+    uint32_t nodeCount;     /**< Liczba węzłów */
+    float min[3];           /**< Minimalny narożnik sześcianu korzenia */
+    float size;             /**< Bok sześcianu korzenia */
+    uint32_t reserved;      /**< Wyrównanie */
+};
+
+/**
+ * @struct PointCloudNodeRecord
+ * @brief Opis węzła w tablicy węzłów
+ */
+struct PointCloudNodeRecord {
+    uint64_t offset;        /**< Położenie punktów węzła od początku pliku [B] */
+    uint32_t pointCount;    /**< Liczba punktów węzła */
+    uint32_t firstChild;    /**< Indeks pierwszego dziecka (0 = liść) */
+    uint8_t childMask;      /**< Bit i ustawiony, gdy istnieje dziecko w oktancie i */
+    uint8_t level;          /**< Głębokość (korzeń = 0) */
+    uint16_t reserved;      /**< Wyrównanie */
+    float min[3];           /**< Minimalny narożnik sześcianu węzła */
+    float size;             /**< Bok sześcianu węzła */
+    float spacing;          /**< Najmniejszy odstęp punktów próbki węzła */
+};
+
+/**
+ * @struct PointCloudPoint
+ * @brief Punkt zapisany względem sześcianu swojego węzła
+ *
+ * Położenie to min + position / 65535 * size, więc w shaderze wystarcza
+ * znormalizowany atrybut GL_UNSIGNED_SHORT i przesunięcie węzła.
+ */
+struct PointCloudPoint {
+    uint16_t position[3];   /**< Położenie skwantowane w sześcianie węzła */
+    uint16_t reserved;      /**< Wyrównanie do 4 bajtów */
+    uint8_t color[4];       /**< Kolor RGBA8 */
+};
+
+static_assert(sizeof(PointCloudFileHeader) == 40, "Nieoczekiwany rozmiar naglowka chmury punktow");
+static_assert(sizeof(PointCloudNodeRecord) == 40, "Nieoczekiwany rozmiar rekordu wezla");
+static_assert(sizeof(PointCloudPoint) == 12, "Nieoczekiwany rozmiar punktu");
+
+#endif // POINT_CLOUD_FORMAT_HPP
@@ -0,0 +1,553 @@
+// PointCloudRenderer.cpp
+#include "PointCloudRenderer.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+/**
+ * @brief Vertex shader punktów: położenie względem węzła i rozmiar z głębokości drzewa
+ *
+ * Od wpisu węzła w visibleNodes shader schodzi do najgłębszego rysowanego
+ * potomka zawierającego punkt; każdy poziom niżej to dwa razy gęstsza próbka.
+ */
+static const char* pointCloudVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPosition;
+layout (location = 1) in vec4 aColor;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+uniform mat4 model;
+uniform vec3 nodeMin;
+uniform float nodeSize;
+uniform float spacing;
+uniform float viewportHeight;
+uniform int nodeIndex;
+uniform usamplerBuffer visibleNodes;
+
+out vec3 Color;
+
+int countBits(uint value) {
+    int bits = int(value);
+    bits = bits - ((bits >> 1) & 0x55);
+    bits = (bits & 0x33) + ((bits >> 2) & 0x33);
+    return (bits + (bits >> 4)) & 0x0f;
+}
+
+float visibleDepth(vec3 local) {
+    int index = nodeIndex;
+    float depth = 0.0;
+    for (int level = 0; level < 24; ++level) {
+        uvec2 entry = texelFetch(visibleNodes, index).xy;
+        ivec3 upper = ivec3(greaterThanEqual(local, vec3(0.5)));
+        uint bit = 1u << uint(upper.x | (upper.y << 1) | (upper.z << 2));
+        if ((entry.x & bit) == 0u) break;
+        index = int(entry.y) + countBits(entry.x & (bit - 1u));
+        local = local * 2.0 - vec3(upper);
+        depth += 1.0;
+    }
+    return depth;
+}
+
+void main() {
+    vec4 viewPosition = view * model * vec4(nodeMin + aPosition * nodeSize, 1.0);
+    gl_Position = projection * viewPosition;
+
+    float worldSpacing = spacing / exp2(visibleDepth(aPosition));
+    float pixels = worldSpacing * projection[1][1] * viewportHeight * 0.5 / max(-viewPosition.z, 1e-3);
+    gl_PointSize = clamp(pixels, 1.0, 64.0);
+    Color = aColor.rgb;
+}
+)";
+
+/**
+ * @brief Fragment shader punktów: okrągłe punkty bez oświetlenia
+ */
+static const char* pointCloudFragmentSource = R"(
+#version 330 core
+in vec3 Color;
+out vec4 FragColor;
+
+void main() {
+    vec2 offset = gl_PointCoord * 2.0 - 1.0;
+    if (dot(offset, offset) > 1.0) discard;
+    FragColor = vec4(Color, 1.0);
+}
+)";
+
+/**
+ * @struct PointCloudRenderer::LoadQueue
+ * @brief Punkty wczytane w tle, czekające na wysłanie do GPU
+ *
+ * Współdzielona z zadaniami wczytywania, więc zadania kończące się po
+ * zamknięciu pliku lub zniszczeniu renderera piszą do żywego obiektu,
+ * a ich wyniki odrzucane są po numerze pliku.
+ */
+struct PointCloudRenderer::LoadQueue {
+    /**
+     * @struct Result
+     * @brief Wynik wczytania jednego węzła
+     */
+    struct Result {
+        uint64_t generation;                    /**< Numer pliku w chwili zamówienia */
+        uint32_t node;                          /**< Indeks węzła */
+        bool success;                           /**< Czy odczyt się powiódł */
+        std::vector<PointCloudPoint> points;    /**< Punkty węzła */
+    };
+
+    std::mutex mutex;               /**< Blokada listy wyników */
+    std::vector<Result> results;    /**< Wyniki w kolejności ukończenia */
+};
+
+/**
+ * @brief Konstruktor PointCloudRenderer
+ */
+PointCloudRenderer::PointCloudRenderer()
+    : m_loads(std::make_shared<LoadQueue>()), m_transform(1.0f), m_transformScale(1.0f), m_program(0),
+      m_visibleBuffer(0), m_visibleTexture(0), m_nodeIndexLoc(-1), m_nodeMinLoc(-1), m_nodeSizeLoc(-1),
+      m_spacingLoc(-1), m_modelLoc(-1), m_viewportHeightLoc(-1), m_pointBudget(DEFAULT_POINT_BUDGET),
+      m_memoryBudget(DEFAULT_MEMORY_BUDGET), m_gpuBytes(0), m_selectedPoints(0), m_totalPoints(0), m_frame(0),
+      m_generation(0), m_minNodePixels(100.0f), m_pointSizeScale(1.0f), m_pendingLoads(0), m_initialized(false) {}
+
+/**
+ * @brief Destruktor PointCloudRenderer
+ */
+PointCloudRenderer::~PointCloudRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery
+ * @return true jeśli inicjalizacja się powiodła
+ */
+bool PointCloudRenderer::initialize() {
+    if (m_initialized) return true;
+
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, pointCloudVertexSource, "chmury punktow");
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, pointCloudFragmentSource, "chmury punktow");
+    m_program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "chmury punktow");
+    if (!m_program) return false;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    MultiViewRenderer::setupProgram(m_program);
+    glUseProgram(m_program);
+    glUniform1i(glGetUniformLocation(m_program, "visibleNodes"), VISIBLE_NODES_TEXTURE_UNIT);
+    glUseProgram(previousProgram);
+    m_nodeIndexLoc = glGetUniformLocation(m_program, "nodeIndex");
+    m_nodeMinLoc = glGetUniformLocation(m_program, "nodeMin");
+    m_nodeSizeLoc = glGetUniformLocation(m_program, "nodeSize");
+    m_spacingLoc = glGetUniformLocation(m_program, "spacing");
+    m_modelLoc = glGetUniformLocation(m_program, "model");
+    m_viewportHeightLoc = glGetUniformLocation(m_program, "viewportHeight");
+
+    glGenBuffers(1, &m_visibleBuffer);
+    glGenTextures(1, &m_visibleTexture);
+    if (!m_visibleBuffer || !m_visibleTexture) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow chmury punktow" << std::endl;
+        release();
+        return false;
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, m_visibleBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::uvec2), nullptr, GL_STREAM_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, m_visibleTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, m_visibleBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zamyka plik i zwalnia obiekty OpenGL
+ */
+void PointCloudRenderer::release() {
+    close();
+    if (m_program) glDeleteProgram(m_program);
+    if (m_visibleBuffer) glDeleteBuffers(1, &m_visibleBuffer);
+    if (m_visibleTexture) glDeleteTextures(1, &m_visibleTexture);
+    m_program = 0;
+    m_visibleBuffer = 0;
+    m_visibleTexture = 0;
+    m_initialized = false;
+}
+
+/**
+ * @brief Otwiera plik drzewa (wczytuje tylko tablicę węzłów)
+ * @param path Ścieżka pliku
+ * @return true jeśli plik został otwarty
+ *
+ * @details Tablica węzłów zajmuje 40 B na węzeł (około 2 MB na miliard
+ * punktów przy domyślnych parametrach budowania), punkty zostają w pliku.
+ */
+bool PointCloudRenderer::open(const std::string& path) {
+    close();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Blad: Nie udalo sie otworzyc chmury punktow " << path << std::endl;
+        return false;
+    }
+    PointCloudFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != POINT_CLOUD_MAGIC || header.version != POINT_CLOUD_VERSION || header.nodeCount == 0) {
+        std::cerr << "Blad: Plik " << path << " nie jest chmura punktow w obslugiwanej wersji" << std::endl;
+        return false;
+    }
+    std::vector<PointCloudNodeRecord> records(header.nodeCount);
+    file.read(reinterpret_cast<char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(PointCloudNodeRecord)));
+    if (!file) {
+        std::cerr << "Blad: Nie udalo sie odczytac wezlow chmury punktow " << path << std::endl;
+        return false;
+    }
+
+    m_nodes.resize(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        Node& node = m_nodes[i];
+        node.record = records[i];
+        node.state = NodeState::UNLOADED;
+        node.vao = 0;
+        node.vbo = 0;
+        node.lastUsedFrame = 0;
+    }
+    m_path = path;
+    m_totalPoints = header.pointCount;
+    updateBounds();
+
+    std::cout << "Chmura punktow: " << path << " (" << header.pointCount << " punktow, " << header.nodeCount
+              << " wezlow)" << std::endl;
+    return true;
+}
+
+/**
+ * @brief Zamyka plik i zwalnia bufory węzłów
+ *
+ * @details Zadania wczytywania w toku nie są przerywane; ich wyniki
+ * zostaną odrzucone, bo zmienia się numer pliku.
+ */
+void PointCloudRenderer::close() {
+    for (Node& node : m_nodes) evictNode(node);
+    m_nodes.clear();
+    m_drawList.clear();
+    m_visibleNodes.clear();
+    m_path.clear();
+    m_totalPoints = 0;
+    m_selectedPoints = 0;
+    m_pendingLoads = 0;
+    m_generation++;
+    std::lock_guard<std::mutex> lock(m_loads->mutex);
+    m_loads->results.clear();
+}
+
+/**
+ * @brief Ustawia położenie chmury w świecie
+ * @param transform Macierz modelu
+ */
+void PointCloudRenderer::setTransform(const glm::mat4& transform) {
+    m_transform = transform;
+    updateBounds();
+}
+
+/**
+ * @brief Przelicza prostopadłościany węzłów po zmianie położenia chmury
+ */
+void PointCloudRenderer::updateBounds() {
+    m_transformScale = std::max(std::max(glm::length(glm::vec3(m_transform[0])), glm::length(glm::vec3(m_transform[1]))),
+                                glm::length(glm::vec3(m_transform[2])));
+    for (Node& node : m_nodes) {
+        glm::vec3 min(node.record.min[0], node.record.min[1], node.record.min[2]);
+        node.bounds = BoundingBox::empty();
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec3 offset(corner & 1, (corner >> 1) & 1, (corner >> 2) & 1);
+            node.bounds.expand(glm::vec3(m_transform * glm::vec4(min + offset * node.record.size, 1.0f)));
+        }
+    }
+}
+
+/**
+ * @brief Zamawia wczytanie punktów węzła w tle
+ * @param index Indeks węzła
+ *
+ * @details Zadanie dostaje kopię ścieżki i wspólny wskaźnik kolejki
+ * wyników, więc nie odwołuje się do renderera.
+ */
+void PointCloudRenderer::requestLoad(uint32_t index) {
+    Node& node = m_nodes[index];
+    node.state = NodeState::LOADING;
+    m_pendingLoads++;
+
+    std::shared_ptr<LoadQueue> loads = m_loads;
+    std::string path = m_path;
+    uint64_t generation = m_generation;
+    uint64_t offset = node.record.offset;
+    uint32_t count = node.record.pointCount;
+    auto task = [loads, path, generation, index, offset, count]() {
+        LoadQueue::Result result;
+        result.generation = generation;
+        result.node = index;
+        result.points.resize(count);
+        std::ifstream file(path, std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char*>(result.points.data()),
+                  static_cast<std::streamsize>(count * sizeof(PointCloudPoint)));
+        result.success = static_cast<bool>(file);
+        if (!result.success) result.points.clear();
+
+        std::lock_guard<std::mutex> lock(loads->mutex);
+        loads->results.push_back(std::move(result));
+    };
+
+    // Bez wątków roboczych (jeden rdzeń) węzeł wczytywany jest od razu
+    ThreadPool& pool = ThreadPool::instance();
+    if (pool.getThreadCount() == 0) {
+        task();
+    } else {
+        pool.submit(task);
+    }
+}
+
+/**
+ * @brief Zwalnia bufory GPU węzła
+ * @param node Węzeł
+ */
+void PointCloudRenderer::evictNode(Node& node) {
+    if (node.state != NodeState::RESIDENT) return;
+    glDeleteVertexArrays(1, &node.vao);
+    glDeleteBuffers(1, &node.vbo);
+    node.vao = 0;
+    node.vbo = 0;
+    node.state = NodeState::UNLOADED;
+    m_gpuBytes -= static_cast<size_t>(node.record.pointCount) * sizeof(PointCloudPoint);
+}
+
+/**
+ * @brief Zwalnia najdawniej używane węzły spoza bieżącej klatki
+ * @param bytes Potrzebna wolna pamięć [B]
+ * @return true jeśli budżet pozwala przyjąć bytes
+ */
+bool PointCloudRenderer::makeRoom(size_t bytes) {
+    while (m_gpuBytes + bytes > m_memoryBudget) {
+        Node* oldest = nullptr;
+        for (Node& node : m_nodes) {
+            if (node.state != NodeState::RESIDENT || node.lastUsedFrame >= m_frame) continue;
+            if (!oldest || node.lastUsedFrame < oldest->lastUsedFrame) oldest = &node;
+        }
+        if (!oldest) return false;
+        evictNode(*oldest);
+    }
+    return true;
+}
+
+/**
+ * @brief Wysyła do GPU węzły wczytane w tle
+ *
+ * @details Najwyżej MAX_UPLOADS_PER_FRAME węzłów na klatkę; pozostałe
+ * czekają w kolejce. Węzeł, dla którego nie da się zwolnić pamięci bez
+ * usuwania węzłów bieżącej klatki, wraca do stanu niewczytanego.
+ */
+void PointCloudRenderer::uploadLoadedNodes() {
+    std::vector<LoadQueue::Result> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_loads->mutex);
+        std::vector<LoadQueue::Result>& results = m_loads->results;
+        size_t count = std::min<size_t>(results.size(), MAX_UPLOADS_PER_FRAME);
+        std::move(results.begin(), results.begin() + count, std::back_inserter(ready));
+        results.erase(results.begin(), results.begin() + count);
+    }
+
+    for (LoadQueue::Result& result : ready) {
+        if (result.generation != m_generation) continue;
+        Node& node = m_nodes[result.node];
+        m_pendingLoads--;
+        node.state = NodeState::UNLOADED;
+        size_t bytes = result.points.size() * sizeof(PointCloudPoint);
+        if (!result.success) {
+            std::cerr << "Blad: Nie udalo sie wczytac wezla " << result.node << " chmury punktow" << std::endl;
+            continue;
+        }
+        if (!makeRoom(bytes)) continue;
+
+        glGenVertexArrays(1, &node.vao);
+        glGenBuffers(1, &node.vbo);
+        glBindVertexArray(node.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, node.vbo);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), result.points.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PointCloudPoint),
+                              (void*)offsetof(PointCloudPoint, position));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PointCloudPoint),
+                              (void*)offsetof(PointCloudPoint, color));
+        glEnableVertexAttribArray(1);
+        glBindVertexArray(0);
+        node.state = NodeState::RESIDENT;
+        m_gpuBytes += bytes;
+    }
+}
+
+/**
+ * @brief Wybiera węzły dla kamery głównej, zamawia brakujące i wysyła wczytane
+ * @param cameraPosition Pozycja kamery
+ * @param viewProjection Macierz projekcji razy widoku
+ * @param projection Macierz projekcji
+ * @param viewportHeight Wysokość widoku w pikselach
+ *
+ * @details Priorytetem węzła jest promień jego sfery otaczającej na ekranie
+ * (nieskończony, gdy kamera jest w środku). Przejście kończy się na
+ * pierwszym węźle, który przekroczyłby budżet punktów, więc przy
+ * wyczerpanym budżecie odcinane są najmniejsze na ekranie części drzewa.
+ * Wybrane węzły sortowane są według indeksu z pliku (kolejność wszerz),
+ * dzięki czemu rysowane dzieci każdego węzła leżą obok siebie i drzewo
+ * dla vertex shadera to maska dzieci plus indeks pierwszego z nich.
+ */
+void PointCloudRenderer::update(const glm::vec3& cameraPosition, const glm::mat4& viewProjection,
+                                const glm::mat4& projection, float viewportHeight) {
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Chmura punktow/Narysowane punkty", 0.0);
+    stats.setValue("Chmura punktow/Wywolania rysowania", 0.0);
+    m_drawList.clear();
+    m_visibleNodes.clear();
+    m_selectedPoints = 0;
+    if (!m_initialized || m_nodes.empty()) return;
+
+    m_frame++;
+    Frustum frustum = Frustum::fromMatrix(viewProjection);
+    float pixelsPerUnit = projection[1][1] * viewportHeight * 0.5f;
+    auto priority = [&](const Node& node) {
+        glm::vec3 center = node.bounds.getCenter();
+        float radius = glm::length(node.bounds.getExtents());
+        float distance = glm::length(center - cameraPosition);
+        return distance <= radius ? FLT_MAX : radius / distance * pixelsPerUnit;
+    };
+
+    // Wybrane węzły nie mogą być usunięte, więc muszą się zmieścić w pamięci
+    size_t pointBudget = std::min(m_pointBudget, m_memoryBudget / sizeof(PointCloudPoint));
+    std::priority_queue<std::pair<float, uint32_t>> queue;
+    queue.push({FLT_MAX, 0});
+    int requests = 0;
+    while (!queue.empty()) {
+        auto [screenRadius, index] = queue.top();
+        queue.pop();
+        Node& node = m_nodes[index];
+        if (index != 0 && screenRadius < m_minNodePixels) continue;
+        if (!frustum.intersects(node.bounds)) continue;
+        if (m_selectedPoints + node.record.pointCount > pointBudget) break;
+
+        if (node.state == NodeState::UNLOADED && m_pendingLoads < MAX_PENDING_LOADS) {
+            requestLoad(index);
+            requests++;
+        }
+        if (node.state != NodeState::RESIDENT) continue;
+
+        node.lastUsedFrame = m_frame;
+        m_drawList.push_back(index);
+        m_selectedPoints += node.record.pointCount;
+        uint32_t child = node.record.firstChild;
+        for (int octant = 0; octant < 8; ++octant) {
+            if (!(node.record.childMask & (1u << octant))) continue;
+            queue.push({priority(m_nodes[child]), child});
+            child++;
+        }
+    }
+
+    // Drzewo rysowanych węzłów dla vertex shadera
+    std::sort(m_drawList.begin(), m_drawList.end());
+    m_visibleNodes.assign(m_drawList.size(), glm::uvec2(0));
+    for (size_t i = 0; i < m_drawList.size(); ++i) {
+        const PointCloudNodeRecord& record = m_nodes[m_drawList[i]].record;
+        if (record.childMask == 0) continue;
+        uint32_t child = record.firstChild;
+        for (int octant = 0; octant < 8; ++octant) {
+            if (!(record.childMask & (1u << octant))) continue;
+            auto found = std::lower_bound(m_drawList.begin() + i + 1, m_drawList.end(), child);
+            if (found != m_drawList.end() && *found == child) {
+                if (m_visibleNodes[i].x == 0) m_visibleNodes[i].y = static_cast<uint32_t>(found - m_drawList.begin());
+                m_visibleNodes[i].x |= 1u << octant;
+            }
+            child++;
+        }
+    }
+    if (!m_visibleNodes.empty()) {
+        glBindBuffer(GL_TEXTURE_BUFFER, m_visibleBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, m_visibleNodes.size() * sizeof(glm::uvec2), m_visibleNodes.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+    uploadLoadedNodes();
+    makeRoom(0);
+
+    stats.setValue("Chmura punktow/Wybrane wezly", static_cast<double>(m_drawList.size()));
+    stats.setValue("Chmura punktow/Wybrane punkty", static_cast<double>(m_selectedPoints));
+    stats.setValue("Chmura punktow/Wczytywane wezly", static_cast<double>(m_pendingLoads));
+    stats.setValue("Chmura punktow/Zamowione wezly", static_cast<double>(requests));
+    stats.setValue("Chmura punktow/Pamiec GPU [MB]", m_gpuBytes / (1024.0 * 1024.0));
+}
+
+/**
+ * @brief Rysuje wybrane węzły w aktywnym widoku
+ * @param frustum Ostrosłup widoku
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(). Poprzedni program i stan
+ * GL_PROGRAM_POINT_SIZE są przywracane.
+ */
+int PointCloudRenderer::draw(const Frustum& frustum) {
+    if (!m_initialized || m_drawList.empty()) return 0;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    GLboolean programPointSize = glIsEnabled(GL_PROGRAM_POINT_SIZE);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+
+    glUseProgram(m_program);
+    glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, glm::value_ptr(m_transform));
+    glUniform1f(m_viewportHeightLoc, static_cast<float>(viewport[3]));
+    glActiveTexture(GL_TEXTURE0 + VISIBLE_NODES_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_visibleTexture);
+
+    int draws = 0;
+    size_t points = 0;
+    for (size_t i = 0; i < m_drawList.size(); ++i) {
+        const Node& node = m_nodes[m_drawList[i]];
+        if (!frustum.intersects(node.bounds)) continue;
+        glUniform1i(m_nodeIndexLoc, static_cast<GLint>(i));
+        glUniform3f(m_nodeMinLoc, node.record.min[0], node.record.min[1], node.record.min[2]);
+        glUniform1f(m_nodeSizeLoc, node.record.size);
+        glUniform1f(m_spacingLoc, node.record.spacing * m_transformScale * m_pointSizeScale);
+        glBindVertexArray(node.vao);
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(node.record.pointCount));
+        points += node.record.pointCount;
+        draws++;
+    }
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    if (!programPointSize) glDisable(GL_PROGRAM_POINT_SIZE);
+    glUseProgram(previousProgram);
+
+    RenderStats& stats = RenderStats::instance();
+    stats.addValue("Chmura punktow/Narysowane punkty", static_cast<double>(points));
+    stats.addValue("Chmura punktow/Wywolania rysowania", draws);
+    return draws;
+}
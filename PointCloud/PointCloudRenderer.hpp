@@ -0,0 +1,221 @@
+// PointCloudRenderer.hpp
+#ifndef POINT_CLOUD_RENDERER_HPP
+#define POINT_CLOUD_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "PointCloudFormat.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @class PointCloudRenderer
+ * @brief Strumieniowe rysowanie chmury punktów z pliku oktalnego drzewa
+ *
+ * Plik budowany przez PointCloudBuilder (narzędzie PointCloudConverter)
+ * może być wielokrotnie większy niż pamięć: w pamięci trzymana jest tylko
+ * tablica węzłów, a punkty wczytywane są węzłami w tle (ThreadPool).
+ * Co klatkę update() przechodzi drzewo od korzenia w kolejności malejącego
+ * rozmiaru węzła na ekranie i wybiera węzły widoczne w ostrosłupie kamery
+ * głównej, dopóki suma punktów nie przekroczy budżetu. Brakujące węzły są
+ * zamawiane w tej samej kolejności, a wczytane trafiają do własnych buforów
+ * GPU, z których najdawniej używane usuwane są po przekroczeniu budżetu
+ * pamięci. Drzewo jest addytywne, więc węzeł rysowany jest dopiero, gdy
+ * rysowani są jego przodkowie.
+ *
+ * Każdy węzeł rysowany jest jednym glDrawArrays(GL_POINTS). Rozmiar punktu
+ * wynika z odstępu punktów najgłębszego rysowanego poziomu w danym miejscu
+ * (vertex shader schodzi po drzewie rysowanych węzłów zapisanym w teksturze
+ * buforowej) i odległości od kamery, więc chmura nie ma dziur tam, gdzie
+ * dzieci nie są wczytane, ani zbyt dużych punktów tam, gdzie są.
+ */
+class PointCloudRenderer {
+public:
+    static const size_t DEFAULT_POINT_BUDGET = 5000000;        /**< Domyślna liczba rysowanych punktów */
+    static const size_t DEFAULT_MEMORY_BUDGET = 512u << 20;    /**< Domyślna pamięć GPU węzłów [B] */
+    static const int MAX_PENDING_LOADS = 8;                     /**< Najwięcej węzłów wczytywanych naraz */
+    static const int MAX_UPLOADS_PER_FRAME = 16;                /**< Najwięcej węzłów wysyłanych do GPU w klatce */
+    static const int VISIBLE_NODES_TEXTURE_UNIT = 7;            /**< Jednostka teksturująca drzewa rysowanych węzłów */
+
+private:
+    /**
+     * @enum NodeState
+     * @brief Stan danych węzła
+     */
+    enum class NodeState {
+        UNLOADED,   /**< Punkty tylko w pliku */
+        LOADING,    /**< Wczytywany w tle */
+        RESIDENT    /**< W buforze GPU */
+    };
+
+    /**
+     * @struct Node
+     * @brief Węzeł drzewa z buforem GPU
+     */
+    struct Node {
+        PointCloudNodeRecord record;    /**< Rekord z pliku */
+        BoundingBox bounds;             /**< Prostopadłościan w przestrzeni świata */
+        NodeState state;                /**< Stan danych */
+        GLuint vao;                     /**< VAO węzła */
+        GLuint vbo;                     /**< Bufor punktów */
+        uint64_t lastUsedFrame;         /**< Ostatnia klatka, w której węzeł był wybrany */
+    };
+
+    struct LoadQueue;
+
+    std::vector<Node> m_nodes;                  /**< Węzły (indeksy z pliku) */
+    std::vector<uint32_t> m_drawList;           /**< Węzły wybrane w bieżącej klatce (rosnąco) */
+    std::vector<glm::uvec2> m_visibleNodes;     /**< Maska i pierwsze rysowane dziecko każdego węzła m_drawList */
+    std::shared_ptr<LoadQueue> m_loads;         /**< Wyniki wczytywania w tle (współdzielone z zadaniami) */
+    std::string m_path;                         /**< Ścieżka otwartego pliku */
+    glm::mat4 m_transform;                      /**< Położenie chmury w świecie */
+    float m_transformScale;                     /**< Największa skala m_transform */
+    GLuint m_program;                           /**< Program rysowania punktów */
+    GLuint m_visibleBuffer;                     /**< Bufor m_visibleNodes */
+    GLuint m_visibleTexture;                    /**< Tekstura buforowa nad m_visibleBuffer */
+    GLint m_nodeIndexLoc;                       /**< Lokalizacja uniformu indeksu węzła w m_drawList */
+    GLint m_nodeMinLoc;                         /**< Lokalizacja uniformu narożnika węzła */
+    GLint m_nodeSizeLoc;                        /**< Lokalizacja uniformu boku węzła */
+    GLint m_spacingLoc;                         /**< Lokalizacja uniformu odstępu punktów */
+    GLint m_modelLoc;                           /**< Lokalizacja uniformu macierzy modelu */
+    GLint m_viewportHeightLoc;                  /**< Lokalizacja uniformu wysokości widoku */
+    size_t m_pointBudget;                       /**< Budżet rysowanych punktów */
+    size_t m_memoryBudget;                      /**< Budżet pamięci GPU [B] */
+    size_t m_gpuBytes;                          /**< Zajęta pamięć GPU [B] */
+    size_t m_selectedPoints;                    /**< Punkty wybrane w bieżącej klatce */
+    uint64_t m_totalPoints;                     /**< Liczba punktów w pliku */
+    uint64_t m_frame;                           /**< Licznik klatek */
+    uint64_t m_generation;                      /**< Numer otwartego pliku (odrzucanie starych wyników) */
+    float m_minNodePixels;                      /**< Najmniejszy rysowany węzeł na ekranie [px] */
+    float m_pointSizeScale;                     /**< Mnożnik rozmiaru punktów */
+    int m_pendingLoads;                         /**< Węzły w stanie LOADING */
+    bool m_initialized;                         /**< Czy obiekty OpenGL zostały utworzone */
+
+    /**
+     * @brief Przelicza prostopadłościany węzłów po zmianie położenia chmury
+     */
+    void updateBounds();
+
+    /**
+     * @brief Zamawia wczytanie punktów węzła w tle
+     * @param index Indeks węzła
+     */
+    void requestLoad(uint32_t index);
+
+    /**
+     * @brief Wysyła do GPU węzły wczytane w tle
+     */
+    void uploadLoadedNodes();
+
+    /**
+     * @brief Zwalnia bufory GPU węzła
+     * @param node Węzeł
+     */
+    void evictNode(Node& node);
+
+    /**
+     * @brief Zwalnia najdawniej używane węzły spoza bieżącej klatki
+     * @param bytes Potrzebna wolna pamięć [B]
+     * @return true jeśli budżet pozwala przyjąć bytes
+     */
+    bool makeRoom(size_t bytes);
+
+public:
+    /**
+     * @brief Konstruktor PointCloudRenderer
+     */
+    PointCloudRenderer();
+
+    /**
+     * @brief Destruktor PointCloudRenderer
+     */
+    ~PointCloudRenderer();
+
+    /**
+     * @brief Kompiluje shadery
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zamyka plik i zwalnia obiekty OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Otwiera plik drzewa (wczytuje tylko tablicę węzłów)
+     * @param path Ścieżka pliku
+     * @return true jeśli plik został otwarty
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Zamyka plik i zwalnia bufory węzłów
+     */
+    void close();
+
+    /**
+     * @brief Sprawdza, czy plik jest otwarty
+     * @return true jeśli plik jest otwarty
+     */
+    bool isOpen() const { return !m_nodes.empty(); }
+
+    /**
+     * @brief Ustawia położenie chmury w świecie
+     * @param transform Macierz modelu
+     */
+    void setTransform(const glm::mat4& transform);
+
+    /**
+     * @brief Ustawia budżet rysowanych punktów
+     * @param points Liczba punktów
+     */
+    void setPointBudget(size_t points) { m_pointBudget = points; }
+
+    /**
+     * @brief Zwraca budżet rysowanych punktów
+     * @return Liczba punktów
+     */
+    size_t getPointBudget() const { return m_pointBudget; }
+
+    /**
+     * @brief Ustawia budżet pamięci GPU węzłów
+     * @param bytes Liczba bajtów
+     */
+    void setMemoryBudget(size_t bytes) { m_memoryBudget = bytes; }
+
+    /**
+     * @brief Ustawia mnożnik rozmiaru punktów
+     * @param scale Mnożnik (1 = punkty stykają się przy odstępie próbki)
+     */
+    void setPointSizeScale(float scale) { m_pointSizeScale = scale; }
+
+    /**
+     * @brief Zwraca liczbę punktów w pliku
+     * @return Liczba punktów
+     */
+    uint64_t getTotalPointCount() const { return m_totalPoints; }
+
+    /**
+     * @brief Wybiera węzły dla kamery głównej, zamawia brakujące i wysyła wczytane
+     * @param cameraPosition Pozycja kamery
+     * @param viewProjection Macierz projekcji razy widoku
+     * @param projection Macierz projekcji
+     * @param viewportHeight Wysokość widoku w pikselach
+     */
+    void update(const glm::vec3& cameraPosition, const glm::mat4& viewProjection, const glm::mat4& projection,
+                float viewportHeight);
+
+    /**
+     * @brief Rysuje wybrane węzły w aktywnym widoku
+     * @param frustum Ostrosłup widoku
+     * @return Liczba wywołań rysowania
+     */
+    int draw(const Frustum& frustum);
+};
+
+#endif // POINT_CLOUD_RENDERER_HPP
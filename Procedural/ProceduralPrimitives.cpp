@@ -0,0 +1,200 @@
+// ProceduralPrimitives.cpp
+#include "ProceduralPrimitives.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Funkcje GLSL generujące wierzchołki brył
+ *
+ * Numery kształtów odpowiadają wartościom PrimitiveType.
+ */
+static const char* proceduralShaderSource = R"(
+const float PROCEDURAL_PI = 3.14159265359;
+const int SHAPE_SPHERE = 1;
+const int SHAPE_CYLINDER = 2;
+const int SHAPE_CONE = 3;
+const int SHAPE_TORUS = 5;
+
+// Punkt siatki bryły w kolumnie column i wierszu row; segment to wiersz
+// czworokąta (podstawy i ściany mają osobne normalne)
+void proceduralPoint(int shape, ivec2 tessellation, float parameter, int column, int row, int segment,
+                     out vec3 position, out vec3 normal, out vec2 uv) {
+    float u = float(column) / float(tessellation.x);
+    float angle = u * 2.0 * PROCEDURAL_PI;
+    float c = cos(angle);
+    float s = sin(angle);
+
+    if (shape == SHAPE_SPHERE || shape == SHAPE_TORUS) {
+        float v = float(row) / float(tessellation.y);
+        if (shape == SHAPE_SPHERE) {
+            float stackAngle = PROCEDURAL_PI * 0.5 - v * PROCEDURAL_PI;
+            position = vec3(cos(stackAngle) * c, cos(stackAngle) * s, sin(stackAngle));
+            normal = position;
+        } else {
+            float ringAngle = v * 2.0 * PROCEDURAL_PI;
+            float ring = 1.0 + parameter * c;
+            position = vec3(ring * cos(ringAngle), ring * sin(ringAngle), parameter * s);
+            normal = vec3(cos(ringAngle) * c, sin(ringAngle) * c, s);
+        }
+        uv = vec2(u, v);
+        return;
+    }
+
+    // Profil (promień, wysokość) i normalne segmentów brył obrotowych wokół Y
+    vec2 profile;
+    bool side;
+    if (shape == SHAPE_CYLINDER) {
+        profile = row == 0 || row == 3 ? vec2(0.0, row == 0 ? 0.5 : -0.5) : vec2(1.0, row == 1 ? 0.5 : -0.5);
+        side = segment == 1;
+        normal = side ? vec3(c, 0.0, s) : vec3(0.0, segment == 0 ? 1.0 : -1.0, 0.0);
+    } else {
+        profile = row == 0 ? vec2(0.0, 0.5) : vec2(row == 1 ? 1.0 : 0.0, -0.5);
+        side = segment == 0;
+        normal = side ? normalize(vec3(c, 1.0, s)) : vec3(0.0, -1.0, 0.0);
+    }
+    position = vec3(profile.x * c, profile.y, profile.x * s);
+    uv = side ? vec2(u, profile.y + 0.5) : vec2(position.x, position.z) * 0.5 + 0.5;
+}
+
+// Wierzchołek vertexId listy trójkątów bryły o tessellation = (sektory, wiersze)
+void proceduralVertex(int shape, ivec2 tessellation, float parameter, int vertexId,
+                      out vec3 position, out vec3 normal, out vec2 uv) {
+    int triangle = vertexId / 3;
+    int corner = vertexId - triangle * 3;
+    int quad = triangle >> 1;
+    int column = quad % tessellation.x;
+    int row = quad / tessellation.x;
+
+    // Trójkąty (a, c, b) i (b, c, d) czworokąta a = (0, 0), b = (1, 0), c = (0, 1), d = (1, 1);
+    // bryły obrotowe wokół Y mają kolumny w przeciwną stronę, więc rogi 1 i 2 są zamienione
+    if ((shape == SHAPE_CYLINDER || shape == SHAPE_CONE) && corner != 0) corner = 3 - corner;
+    ivec2 offset;
+    if ((triangle & 1) == 0) {
+        offset = corner == 0 ? ivec2(0, 0) : (corner == 1 ? ivec2(0, 1) : ivec2(1, 0));
+    } else {
+        offset = corner == 0 ? ivec2(1, 0) : (corner == 1 ? ivec2(0, 1) : ivec2(1, 1));
+    }
+    proceduralPoint(shape, tessellation, parameter, column + offset.x, row + offset.y, row, position, normal, uv);
+}
+)";
+
+/**
+ * @brief Sprawdza, czy kształt można generować w shaderze
+ * @param shape Kształt
+ * @return true dla sfery, cylindra, stożka i torusa
+ */
+bool ProceduralPrimitives::isSupported(PrimitiveType shape) {
+    return shape == PrimitiveType::SPHERE || shape == PrimitiveType::CYLINDER ||
+           shape == PrimitiveType::CONE || shape == PrimitiveType::TORUS;
+}
+
+/**
+ * @brief Zwraca liczbę wierszy profilu bryły
+ * @param shape Kształt
+ * @param sectors Liczba sektorów
+ * @return Liczba wierszy czworokątów
+ *
+ * @details Sfera ma o połowę mniej warstw niż sektorów (czworokąty na
+ * równiku są wtedy w przybliżeniu kwadratowe), torus tyle pierścieni co
+ * sektorów rury.
+ */
+int ProceduralPrimitives::getRows(PrimitiveType shape, int sectors) {
+    switch (shape) {
+        case PrimitiveType::SPHERE: return std::max(sectors / 2, 2);
+        case PrimitiveType::CYLINDER: return 3;
+        case PrimitiveType::CONE: return 2;
+        case PrimitiveType::TORUS: return sectors;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Dobiera liczbę sektorów do rozmiaru bryły na ekranie
+ * @param pixelRadius Promień bryły w pikselach
+ * @param pixelThreshold Dopuszczalna odchyłka cięciwy od okręgu w pikselach
+ * @return Potęga dwójki z przedziału [MIN_SECTORS, MAX_SECTORS]
+ *
+ * @details Cięciwa n-kąta wpisanego w okrąg o promieniu r odstaje od
+ * okręgu o r * (1 - cos(pi / n)) ~ r * pi^2 / (2 * n^2), więc odchyłka
+ * nie przekracza progu dla n >= pi * sqrt(r / (2 * próg)).
+ */
+int ProceduralPrimitives::selectSectors(float pixelRadius, float pixelThreshold) {
+    const float pi = 3.14159265f;
+    float needed = pi * std::sqrt(std::max(pixelRadius, 0.0f) / (2.0f * std::max(pixelThreshold, 0.01f)));
+    int sectors = MIN_SECTORS;
+    while (sectors < MAX_SECTORS && static_cast<float>(sectors) < needed) {
+        sectors *= 2;
+    }
+    return sectors;
+}
+
+/**
+ * @brief Wyznacza wierzchołek bryły (odpowiednik funkcji GLSL)
+ * @param shape Kształt
+ * @param sectors Liczba sektorów
+ * @param rows Liczba wierszy
+ * @param parameter Parametr kształtu (promień rury torusa)
+ * @param vertexId Numer wierzchołka listy trójkątów
+ * @return Wierzchołek w przestrzeni lokalnej
+ */
+Vertex ProceduralPrimitives::generateVertex(PrimitiveType shape, int sectors, int rows, float parameter, int vertexId) {
+    const float pi = 3.14159265359f;
+    int triangle = vertexId / 3;
+    int corner = vertexId - triangle * 3;
+    int quad = triangle >> 1;
+    int segment = quad / sectors;
+
+    if ((shape == PrimitiveType::CYLINDER || shape == PrimitiveType::CONE) && corner != 0) corner = 3 - corner;
+    static const int offsets[2][3][2] = {{{0, 0}, {0, 1}, {1, 0}}, {{1, 0}, {0, 1}, {1, 1}}};
+    int column = quad % sectors + offsets[triangle & 1][corner][0];
+    int row = segment + offsets[triangle & 1][corner][1];
+
+    float u = static_cast<float>(column) / sectors;
+    float angle = u * 2.0f * pi;
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+
+    Vertex vertex;
+    if (shape == PrimitiveType::SPHERE || shape == PrimitiveType::TORUS) {
+        float v = static_cast<float>(row) / rows;
+        if (shape == PrimitiveType::SPHERE) {
+            float stackAngle = pi * 0.5f - v * pi;
+            vertex.position = glm::vec3(std::cos(stackAngle) * c, std::cos(stackAngle) * s, std::sin(stackAngle));
+            vertex.normal = vertex.position;
+        } else {
+            float ringAngle = v * 2.0f * pi;
+            float ring = 1.0f + parameter * c;
+            vertex.position = glm::vec3(ring * std::cos(ringAngle), ring * std::sin(ringAngle), parameter * s);
+            vertex.normal = glm::vec3(std::cos(ringAngle) * c, std::sin(ringAngle) * c, s);
+        }
+        vertex.texCoord = glm::vec2(u, v);
+        return vertex;
+    }
+
+    glm::vec2 profile;
+    bool side;
+    if (shape == PrimitiveType::CYLINDER) {
+        profile = row == 0 || row == 3 ? glm::vec2(0.0f, row == 0 ? 0.5f : -0.5f) : glm::vec2(1.0f, row == 1 ? 0.5f : -0.5f);
+        side = segment == 1;
+        vertex.normal = side ? glm::vec3(c, 0.0f, s) : glm::vec3(0.0f, segment == 0 ? 1.0f : -1.0f, 0.0f);
+    } else {
+        profile = row == 0 ? glm::vec2(0.0f, 0.5f) : glm::vec2(row == 1 ? 1.0f : 0.0f, -0.5f);
+        side = segment == 0;
+        vertex.normal = side ? glm::normalize(glm::vec3(c, 1.0f, s)) : glm::vec3(0.0f, -1.0f, 0.0f);
+    }
+    vertex.position = glm::vec3(profile.x * c, profile.y, profile.x * s);
+    vertex.texCoord = side ? glm::vec2(u, profile.y + 0.5f)
+                           : glm::vec2(vertex.position.x, vertex.position.z) * 0.5f + 0.5f;
+    return vertex;
+}
+
+/**
+ * @brief Zwraca kod GLSL funkcji proceduralVertex() (bez dyrektywy #version)
+ * @return Kod źródłowy
+ *
+ * @details Kod dołączany jest jako drugi fragment w glShaderSource, po
+ * wierszu #version i przed kodem shadera, który z niego korzysta.
+ */
+const char* ProceduralPrimitives::getShaderSource() {
+    return proceduralShaderSource;
+}
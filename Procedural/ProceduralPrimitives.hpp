@@ -0,0 +1,83 @@
+// ProceduralPrimitives.hpp
+#ifndef PROCEDURAL_PRIMITIVES_HPP
+#define PROCEDURAL_PRIMITIVES_HPP
+
+#include "../GeometryRenderer.hpp"
+
+/**
+ * @class ProceduralPrimitives
+ * @brief Wierzchołki brył parametrycznych wyznaczane z numeru wierzchołka
+ *
+ * Sfera, cylinder, stożek i torus opisane są siatką sectors x rows
+ * czworokątów (kolumny = kąt obrotu, wiersze = profil bryły). Wierzchołek
+ * numer k listy trójkątów (bez indeksów) należy do czworokąta k / 6,
+ * więc vertex shader odtwarza go z gl_VertexID i parametrów instancji,
+ * a bryły nie potrzebują buforów wierzchołków.
+ *
+ * - sfera: promień 1, bieguny na osi Z, rows warstw (jak MeshBuilder),
+ * - cylinder: promień 1, wysokość 1 wzdłuż Y, profil: podstawa górna,
+ *   ściana, podstawa dolna (rows = 3),
+ * - stożek: promień 1, wysokość 1 wzdłuż Y, profil: ściana, podstawa (rows = 2),
+ * - torus: promień główny 1 w płaszczyźnie XY, promień rury = parametr,
+ *   rows pierścieni.
+ *
+ * Trójkąty czworokątów przy biegunach i środkach podstaw są zdegenerowane
+ * (GPU odrzuca je przed rasteryzacją). Wszystkie trójkąty mają kolejność
+ * CCW patrząc z zewnątrz. Funkcja GLSL z getShaderSource() i
+ * generateVertex() liczą to samo.
+ */
+class ProceduralPrimitives {
+public:
+    static const int MIN_SECTORS = 8;       /**< Najmniejsza liczba sektorów */
+    static const int MAX_SECTORS = 128;     /**< Największa liczba sektorów */
+
+    /**
+     * @brief Sprawdza, czy kształt można generować w shaderze
+     * @param shape Kształt
+     * @return true dla sfery, cylindra, stożka i torusa
+     */
+    static bool isSupported(PrimitiveType shape);
+
+    /**
+     * @brief Zwraca liczbę wierszy profilu bryły
+     * @param shape Kształt
+     * @param sectors Liczba sektorów
+     * @return Liczba wierszy czworokątów
+     */
+    static int getRows(PrimitiveType shape, int sectors);
+
+    /**
+     * @brief Zwraca liczbę wierzchołków listy trójkątów bryły
+     * @param sectors Liczba sektorów
+     * @param rows Liczba wierszy
+     * @return 6 wierzchołków na czworokąt
+     */
+    static int getVertexCount(int sectors, int rows) { return sectors * rows * 6; }
+
+    /**
+     * @brief Dobiera liczbę sektorów do rozmiaru bryły na ekranie
+     * @param pixelRadius Promień bryły w pikselach
+     * @param pixelThreshold Dopuszczalna odchyłka cięciwy od okręgu w pikselach
+     * @return Potęga dwójki z przedziału [MIN_SECTORS, MAX_SECTORS]
+     */
+    static int selectSectors(float pixelRadius, float pixelThreshold);
+
+    /**
+     * @brief Wyznacza wierzchołek bryły (odpowiednik funkcji GLSL)
+     * @param shape Kształt
+     * @param sectors Liczba sektorów
+     * @param rows Liczba wierszy
+     * @param parameter Parametr kształtu (promień rury torusa)
+     * @param vertexId Numer wierzchołka listy trójkątów
+     * @return Wierzchołek w przestrzeni lokalnej
+     */
+    static Vertex generateVertex(PrimitiveType shape, int sectors, int rows, float parameter, int vertexId);
+
+    /**
+     * @brief Zwraca kod GLSL funkcji proceduralVertex() (bez dyrektywy #version)
+     * @return Kod źródłowy
+     */
+    static const char* getShaderSource();
+};
+
+#endif // PROCEDURAL_PRIMITIVES_HPP
@@ -0,0 +1,342 @@
+// ProceduralRenderer.cpp
+#include "ProceduralRenderer.hpp"
+#include "ProceduralPrimitives.hpp"
+#include "../Transform/TransformableObject.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <set>
+#include <utility>
+
+/**
+ * @brief Vertex shader brył proceduralnych
+ *
+ * Poprzedzony wierszem #version, definicją NORMAL_QUALIFIER (flat dla
+ * cieniowania płaskiego) i funkcjami ProceduralPrimitives. Wyjścia są
+ * takie same jak w vertex shaderach sceny.
+ */
+static const char* proceduralVertexSource = R"(
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+// Dane instancji: 4 kolumny macierzy modelu, lista świateł i materiał,
+// kształt z liczbą sektorów i wierszy oraz parametrem kształtu
+uniform samplerBuffer objectData;
+uniform int objectIndex;
+
+NORMAL_QUALIFIER out vec3 Normal;
+out vec3 FragPos;
+out vec2 TexCoord;
+flat out vec3 ObjectColor;
+flat out ivec2 LightList;
+flat out int MaterialIndex;
+flat out float Dissolve;
+
+void main()
+{
+    int base = (objectIndex + gl_InstanceID) * 6;
+    mat4 modelMatrix = mat4(texelFetch(objectData, base),
+                            texelFetch(objectData, base + 1),
+                            texelFetch(objectData, base + 2),
+                            texelFetch(objectData, base + 3));
+    vec4 lightsAndMaterial = texelFetch(objectData, base + 4);
+    vec4 shape = texelFetch(objectData, base + 5);
+    ObjectColor = vec3(1.0); // kolor obiektu zawiera jego materiał
+    LightList = ivec2(lightsAndMaterial.xy);
+    MaterialIndex = int(lightsAndMaterial.z);
+    Dissolve = 0.0;
+
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+    proceduralVertex(int(shape.x), ivec2(shape.yz), shape.w, gl_VertexID, position, normal, uv);
+
+    FragPos = vec3(modelMatrix * vec4(position, 1.0));
+    Normal = mat3(transpose(inverse(modelMatrix))) * normal;
+    TexCoord = uv;
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
+)";
+
+/**
+ * @brief Kompiluje i linkuje program brył proceduralnych
+ * @param flatShading true = normalne z kwalifikatorem flat
+ * @param fragmentSource Fragment shader sceny (bez wiersza #version i kodu oświetlenia)
+ * @return ID programu lub 0 w przypadku błędu
+ */
+static GLuint linkProceduralProgram(bool flatShading, const char* fragmentSource) {
+    const char* vertexSources[] = {
+        "#version 330 core\n",
+        flatShading ? "#define NORMAL_QUALIFIER flat\n" : "#define NORMAL_QUALIFIER\n",
+        ProceduralPrimitives::getShaderSource(),
+        proceduralVertexSource
+    };
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, vertexSources, 4, "bryl proceduralnych");
+    const char* fragmentSources[] = {"#version 330 core\n", LightCuller::getShaderSource(), fragmentSource};
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSources, 3, "bryl proceduralnych");
+    GLuint program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "bryl proceduralnych");
+    if (!program) return 0;
+
+    MultiViewRenderer::setupProgram(program);
+    LightCuller::setupProgram(program);
+    MaterialTable::setupProgram(program);
+    return program;
+}
+
+/**
+ * @brief Konstruktor ProceduralRenderer
+ */
+ProceduralRenderer::ProceduralRenderer()
+    : m_flatProgram(0), m_phongProgram(0), m_emptyVAO(0), m_instanceBuffer(0), m_instanceTexture(0),
+      m_instanceCapacity(0), m_flatObjectIndexLoc(-1), m_phongObjectIndexLoc(-1), m_initialized(false),
+      m_enabled(false), m_pixelThreshold(0.5f) {
+}
+
+/**
+ * @brief Destruktor ProceduralRenderer
+ */
+ProceduralRenderer::~ProceduralRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje programy i tworzy bufory
+ * @param flatFragmentSource Fragment shader sceny dla cieniowania płaskiego
+ * @param phongFragmentSource Fragment shader sceny dla cieniowania Phonga
+ * @return true jeśli inicjalizacja się powiodła
+ *
+ * @details Programy korzystają z tych samych bloków Camera, Lights
+ * i Materials co shader sceny, więc wiązane są z tymi samymi punktami.
+ */
+bool ProceduralRenderer::initialize(const char* flatFragmentSource, const char* phongFragmentSource) {
+    if (m_initialized) return true;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+
+    m_flatProgram = linkProceduralProgram(true, flatFragmentSource);
+    m_phongProgram = linkProceduralProgram(false, phongFragmentSource);
+    glGenVertexArrays(1, &m_emptyVAO);
+    glGenBuffers(1, &m_instanceBuffer);
+    glGenTextures(1, &m_instanceTexture);
+    glUseProgram(previousProgram);
+
+    if (m_flatProgram == 0 || m_phongProgram == 0 || m_emptyVAO == 0 ||
+        m_instanceBuffer == 0 || m_instanceTexture == 0) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow bryl proceduralnych" << std::endl;
+        release();
+        return false;
+    }
+
+    m_flatObjectIndexLoc = glGetUniformLocation(m_flatProgram, "objectIndex");
+    m_phongObjectIndexLoc = glGetUniformLocation(m_phongProgram, "objectIndex");
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zwalnia programy i bufory
+ */
+void ProceduralRenderer::release() {
+    if (m_flatProgram) glDeleteProgram(m_flatProgram);
+    if (m_phongProgram) glDeleteProgram(m_phongProgram);
+    if (m_emptyVAO) glDeleteVertexArrays(1, &m_emptyVAO);
+    if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+    if (m_instanceTexture) glDeleteTextures(1, &m_instanceTexture);
+    m_flatProgram = 0;
+    m_phongProgram = 0;
+    m_emptyVAO = 0;
+    m_instanceBuffer = 0;
+    m_instanceTexture = 0;
+    m_instanceCapacity = 0;
+
+    m_instances.clear();
+    m_visible.clear();
+    m_groups.clear();
+    m_initialized = false;
+}
+
+/**
+ * @brief Wybiera bryły parametryczne i dobiera ich podział
+ * @param objects Obiekty sceny do narysowania
+ * @param viewPosition Pozycja kamery głównej
+ * @param projection Macierz projekcji kamery głównej
+ * @param viewportHeight Wysokość widoku głównego w pikselach
+ * @param outRemaining Obiekty, które należy narysować siatką
+ *
+ * @details Promień sfery otaczającej rzutowany jest na ekran tak jak
+ * w LodSelector (odległość do najbliższego punktu sfery), a liczba
+ * sektorów dobierana jest przez ProceduralPrimitives::selectSectors().
+ * Podział zależy od kamery głównej i obowiązuje we wszystkich widokach.
+ */
+void ProceduralRenderer::collect(const std::vector<TransformableObject*>& objects, const glm::vec3& viewPosition,
+                                 const glm::mat4& projection, int viewportHeight,
+                                 std::vector<TransformableObject*>& outRemaining) {
+    m_instances.clear();
+    float projectionScale = projection[1][1] * static_cast<float>(viewportHeight) * 0.5f;
+
+    for (TransformableObject* object : objects) {
+        if (!object) continue;
+        PrimitiveType shape = m_initialized && m_enabled ? object->getPrimitiveType() : PrimitiveType::COUNT;
+        if (!ProceduralPrimitives::isSupported(shape)) {
+            outRemaining.push_back(object);
+            continue;
+        }
+
+        Instance instance;
+        instance.model = object->getModelMatrix();
+        instance.bounds = object->getWorldBounds();
+        instance.shape = shape;
+        instance.parameter = 0.0f;
+        instance.materialId = object->getMaterialId();
+
+        float distance = glm::length(instance.bounds.center - viewPosition) - instance.bounds.radius;
+        int sectors = ProceduralPrimitives::MAX_SECTORS;
+        if (distance > 0.0f) {
+            float pixelRadius = instance.bounds.radius * projectionScale / distance;
+            sectors = ProceduralPrimitives::selectSectors(pixelRadius, m_pixelThreshold);
+        }
+        instance.sectors = sectors;
+        instance.rows = ProceduralPrimitives::getRows(shape, sectors);
+        m_instances.push_back(instance);
+    }
+}
+
+/**
+ * @brief Grupuje widoczne instancje i wysyła dane instancji
+ * @param lightList Globalna lista świateł
+ *
+ * @details Instancje sortowane są według liczby wierzchołków; kształt nie
+ * dzieli grup, bo shader czyta go z danych instancji. Bufor jest
+ * osierocany przed zapisem, aby nie czekać na GPU.
+ */
+void ProceduralRenderer::prepareInstances(const glm::ivec2& lightList) {
+    std::stable_sort(m_visible.begin(), m_visible.end(), [](const Instance& a, const Instance& b) {
+        return a.sectors * a.rows < b.sectors * b.rows;
+    });
+
+    m_instanceData.resize(m_visible.size() * INSTANCE_TEXELS);
+    for (size_t i = 0; i < m_visible.size(); ++i) {
+        const Instance& instance = m_visible[i];
+        GLsizei vertexCount = ProceduralPrimitives::getVertexCount(instance.sectors, instance.rows);
+        if (m_groups.empty() || m_groups.back().vertexCount != vertexCount) {
+            m_groups.push_back({vertexCount, static_cast<GLsizei>(i), 0});
+        }
+        m_groups.back().count++;
+
+        glm::vec4* out = &m_instanceData[i * INSTANCE_TEXELS];
+        out[0] = instance.model[0];
+        out[1] = instance.model[1];
+        out[2] = instance.model[2];
+        out[3] = instance.model[3];
+        out[4] = glm::vec4(static_cast<float>(lightList.x), static_cast<float>(lightList.y),
+                           static_cast<float>(instance.materialId), 0.0f);
+        out[5] = glm::vec4(static_cast<float>(instance.shape), static_cast<float>(instance.sectors),
+                           static_cast<float>(instance.rows), instance.parameter);
+    }
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_instanceData.size() * sizeof(glm::vec4));
+    glBindBuffer(GL_TEXTURE_BUFFER, m_instanceBuffer);
+    if (size > m_instanceCapacity) {
+        m_instanceCapacity = size * 2;
+        glBufferData(GL_TEXTURE_BUFFER, m_instanceCapacity, nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_instanceTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_instanceBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    } else {
+        glBufferData(GL_TEXTURE_BUFFER, m_instanceCapacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, m_instanceData.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+/**
+ * @brief Odrzuca niewidoczne instancje i wysyła dane klatki
+ * @param frustums Ostrosłupy wszystkich widoków
+ * @param lightList Globalna lista świateł
+ *
+ * @details Statystyka "Odpowiednik buforow" to rozmiar indeksowanych siatek
+ * (wierzchołki i indeksy), które ścieżka buforowana musiałaby trzymać dla
+ * każdej użytej pary (kształt, podział).
+ */
+void ProceduralRenderer::prepare(const std::vector<Frustum>& frustums, const glm::ivec2& lightList) {
+    m_groups.clear();
+    m_visible.clear();
+
+    double generatedVertices = 0.0;
+    std::set<std::pair<int, int>> variants;
+    for (const Instance& instance : m_instances) {
+        for (const Frustum& frustum : frustums) {
+            if (frustum.intersects(instance.bounds)) {
+                m_visible.push_back(instance);
+                generatedVertices += ProceduralPrimitives::getVertexCount(instance.sectors, instance.rows);
+                variants.insert({static_cast<int>(instance.shape), instance.sectors});
+                break;
+            }
+        }
+    }
+
+    double bufferedBytes = 0.0;
+    for (const std::pair<int, int>& variant : variants) {
+        PrimitiveType shape = static_cast<PrimitiveType>(variant.first);
+        int rows = ProceduralPrimitives::getRows(shape, variant.second);
+        bufferedBytes += static_cast<double>(variant.second + 1) * (rows + 1) * sizeof(Vertex) +
+                         static_cast<double>(ProceduralPrimitives::getVertexCount(variant.second, rows)) *
+                             sizeof(unsigned int);
+    }
+
+    if (!m_visible.empty()) {
+        prepareInstances(lightList);
+    }
+
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Proceduralne/Instancje", static_cast<double>(m_visible.size()));
+    stats.setValue("Proceduralne/Warianty podzialu", static_cast<double>(variants.size()));
+    stats.setValue("Proceduralne/Wierzcholki generowane", generatedVertices);
+    stats.setValue("Proceduralne/Pamiec wierzcholkow [KB]", 0.0);
+    stats.setValue("Proceduralne/Odpowiednik buforow [KB]", bufferedBytes / 1024.0);
+    stats.setValue("Proceduralne/Wywolania rysowania", 0.0);
+}
+
+/**
+ * @brief Rysuje bryły w aktywnym widoku
+ * @param flatShading true = program cieniowania płaskiego
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(). Poprzedni program jest przywracany.
+ */
+int ProceduralRenderer::draw(bool flatShading) {
+    if (m_groups.empty()) return 0;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(flatShading ? m_flatProgram : m_phongProgram);
+    GLint objectIndexLoc = flatShading ? m_flatObjectIndexLoc : m_phongObjectIndexLoc;
+
+    glActiveTexture(GL_TEXTURE0 + MultiViewRenderer::OBJECT_DATA_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_instanceTexture);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(m_emptyVAO);
+
+    for (const DrawGroup& group : m_groups) {
+        glUniform1i(objectIndexLoc, group.first);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, group.vertexCount, group.count);
+    }
+
+    glBindVertexArray(0);
+    glUseProgram(previousProgram);
+
+    int draws = static_cast<int>(m_groups.size());
+    RenderStats::instance().addValue("Proceduralne/Wywolania rysowania", draws);
+    return draws;
+}
@@ -0,0 +1,154 @@
+// ProceduralRenderer.hpp
+#ifndef PROCEDURAL_RENDERER_HPP
+#define PROCEDURAL_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Math/Bounds.hpp"
+
+class TransformableObject;
+
+/**
+ * @class ProceduralRenderer
+ * @brief Rysowanie brył parametrycznych bez buforów wierzchołków
+ *
+ * Sfery, cylindry, stożki i torusy generowane są w vertex shaderze z
+ * gl_VertexID (ProceduralPrimitives) i danych instancji: macierzy modelu,
+ * listy świateł, materiału oraz kształtu z liczbą sektorów i wierszy.
+ * Liczba sektorów dobierana jest każdej instancji osobno z jej rozmiaru
+ * na ekranie, a pamięć wierzchołków wynosi zero niezależnie od liczby
+ * wariantów podziału. Co klatkę:
+ * - collect() zabiera obiekty będące bryłami parametrycznymi i dobiera im podział,
+ * - prepare() odrzuca instancje niewidoczne w żadnym widoku, grupuje je
+ *   według liczby wierzchołków i wysyła dane instancji,
+ * - draw() rysuje każdą grupę jednym glDrawArraysInstanced (kształt
+ *   i podział czytane są z danych instancji, więc grupa może mieszać kształty).
+ * Programy używają fragment shaderów sceny, więc oświetlenie i materiały
+ * są identyczne jak dla siatek.
+ */
+class ProceduralRenderer {
+public:
+    static const int INSTANCE_TEXELS = 6;   /**< Teksele danych jednej instancji */
+
+private:
+    /**
+     * @struct Instance
+     * @brief Bryła rysowana w bieżącej klatce
+     */
+    struct Instance {
+        glm::mat4 model;            /**< Macierz modelu */
+        BoundingSphere bounds;      /**< Sfera otaczająca w przestrzeni świata */
+        PrimitiveType shape;        /**< Kształt */
+        int sectors;                /**< Liczba sektorów */
+        int rows;                   /**< Liczba wierszy */
+        float parameter;            /**< Parametr kształtu (promień rury torusa) */
+        MaterialId materialId;      /**< Materiał */
+    };
+
+    /**
+     * @struct DrawGroup
+     * @brief Instancje o tej samej liczbie wierzchołków
+     */
+    struct DrawGroup {
+        GLsizei vertexCount;        /**< Liczba wierzchołków instancji */
+        GLsizei first;              /**< Pierwsza instancja */
+        GLsizei count;              /**< Liczba instancji */
+    };
+
+    std::vector<Instance> m_instances;          /**< Instancje wybrane w collect() */
+    std::vector<Instance> m_visible;            /**< Instancje widoczne w którymś widoku */
+    std::vector<DrawGroup> m_groups;            /**< Grupy bieżącej klatki */
+    std::vector<glm::vec4> m_instanceData;      /**< Dane instancji */
+
+    GLuint m_flatProgram;           /**< Program dla cieniowania płaskiego */
+    GLuint m_phongProgram;          /**< Program dla cieniowania Phonga */
+    GLuint m_emptyVAO;              /**< Pusty VAO (wierzchołki z gl_VertexID) */
+    GLuint m_instanceBuffer;        /**< Bufor danych instancji */
+    GLuint m_instanceTexture;       /**< Tekstura buforowa nad m_instanceBuffer */
+    GLsizeiptr m_instanceCapacity;  /**< Pojemność bufora instancji w bajtach */
+    GLint m_flatObjectIndexLoc;     /**< Lokalizacja pierwszej instancji (program płaski) */
+    GLint m_phongObjectIndexLoc;    /**< Lokalizacja pierwszej instancji (program Phonga) */
+    bool m_initialized;             /**< Czy obiekty OpenGL zostały utworzone */
+
+    bool m_enabled;                 /**< Czy bryły są generowane proceduralnie */
+    float m_pixelThreshold;         /**< Dopuszczalna odchyłka obrysu od okręgu w pikselach */
+
+    /**
+     * @brief Grupuje widoczne instancje i wysyła dane instancji
+     * @param lightList Globalna lista świateł
+     */
+    void prepareInstances(const glm::ivec2& lightList);
+
+public:
+    /**
+     * @brief Konstruktor ProceduralRenderer
+     */
+    ProceduralRenderer();
+
+    /**
+     * @brief Destruktor ProceduralRenderer
+     */
+    ~ProceduralRenderer();
+
+    /**
+     * @brief Kompiluje programy i tworzy bufory
+     * @param flatFragmentSource Fragment shader sceny dla cieniowania płaskiego
+     * @param phongFragmentSource Fragment shader sceny dla cieniowania Phonga
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize(const char* flatFragmentSource, const char* phongFragmentSource);
+
+    /**
+     * @brief Zwalnia programy i bufory
+     */
+    void release();
+
+    /**
+     * @brief Włącza lub wyłącza generowanie brył w shaderze
+     * @param enabled false = bryły rysowane siatkami z buforów
+     */
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+
+    /**
+     * @brief Sprawdza, czy generowanie brył jest włączone
+     * @return true jeśli włączone
+     */
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Ustawia dopuszczalną odchyłkę obrysu
+     * @param pixels Odchyłka w pikselach (mniejsza = więcej sektorów)
+     */
+    void setPixelThreshold(float pixels) { m_pixelThreshold = pixels; }
+
+    /**
+     * @brief Wybiera bryły parametryczne i dobiera ich podział
+     * @param objects Obiekty sceny do narysowania
+     * @param viewPosition Pozycja kamery głównej
+     * @param projection Macierz projekcji kamery głównej
+     * @param viewportHeight Wysokość widoku głównego w pikselach
+     * @param outRemaining Obiekty, które należy narysować siatką
+     */
+    void collect(const std::vector<TransformableObject*>& objects, const glm::vec3& viewPosition,
+                 const glm::mat4& projection, int viewportHeight, std::vector<TransformableObject*>& outRemaining);
+
+    /**
+     * @brief Odrzuca niewidoczne instancje i wysyła dane klatki
+     * @param frustums Ostrosłupy wszystkich widoków
+     * @param lightList Globalna lista świateł
+     */
+    void prepare(const std::vector<Frustum>& frustums, const glm::ivec2& lightList);
+
+    /**
+     * @brief Rysuje bryły w aktywnym widoku
+     * @param flatShading true = program cieniowania płaskiego
+     * @return Liczba wywołań rysowania
+     */
+    int draw(bool flatShading);
+};
+
+#endif // PROCEDURAL_RENDERER_HPP
@@ -0,0 +1,178 @@
+// QualityGovernor.cpp
+#include "QualityGovernor.hpp"
+#include "../Stats/RenderStats.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Konstruktor QualityGovernor
+ * @param targetFrameMs Docelowy czas klatki w milisekundach
+ * @param maxLights Limit świateł przy pełnej jakości
+ */
+QualityGovernor::QualityGovernor(double targetFrameMs, int maxLights)
+    : m_targetFrameMs(targetFrameMs), m_smoothedCpuMs(0.0), m_smoothedGpuMs(0.0),
+      m_smoothing(0.1), m_upperThreshold(1.05), m_lowerThreshold(0.8),
+      m_cooldownFrames(15), m_framesSinceChange(0), m_framesWithHeadroom(0),
+      m_hasSample(false), m_enabled(true), m_lastDecision(QualityDecision::NONE) {
+    m_maxQuality.resolutionScale = 1.0f;
+    m_maxQuality.lodBias = 0.0f;
+    m_maxQuality.maxLights = std::max(maxLights, MIN_LIGHTS);
+    m_settings = m_maxQuality;
+}
+
+/**
+ * @brief Włącza lub wyłącza regulator
+ * @param enabled true aby włączyć
+ */
+void QualityGovernor::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    reset();
+}
+
+/**
+ * @brief Przywraca pełną jakość i czyści historię pomiarów
+ */
+void QualityGovernor::reset() {
+    m_settings = m_maxQuality;
+    m_hasSample = false;
+    m_framesSinceChange = 0;
+    m_framesWithHeadroom = 0;
+    m_lastDecision = QualityDecision::NONE;
+}
+
+/**
+ * @brief Obniża jakość o jeden krok
+ * @param gpuBound Czy klatkę ogranicza GPU
+ * @return Podjęta decyzja
+ *
+ * @details Gdy ogranicza GPU, najpierw zmniejszana jest rozdzielczość.
+ * Koszt wypełniania rośnie z kwadratem skali, więc nowa skala to
+ * skala * sqrt(cel / czas), ograniczona do kroku 0.25 i zaokrąglona w dół do
+ * RESOLUTION_STEP. Gdy ogranicza CPU, zmiana rozdzielczości nic nie da, więc
+ * regulowane są tylko parametry wpływające na liczbę wywołań rysowania.
+ */
+QualityDecision QualityGovernor::degrade(bool gpuBound) {
+    if (gpuBound && m_settings.resolutionScale > MIN_RESOLUTION_SCALE) {
+        double frameMs = std::max(m_smoothedCpuMs, m_smoothedGpuMs);
+        float ideal = m_settings.resolutionScale * static_cast<float>(std::sqrt(m_targetFrameMs / frameMs));
+        float scale = std::max(ideal, m_settings.resolutionScale - 0.25f);
+        scale = std::floor(scale / RESOLUTION_STEP + 0.001f) * RESOLUTION_STEP;
+        scale = std::min(scale, m_settings.resolutionScale - RESOLUTION_STEP);
+        m_settings.resolutionScale = std::max(scale, MIN_RESOLUTION_SCALE);
+        return QualityDecision::LOWER_RESOLUTION;
+    }
+    if (m_settings.lodBias < MAX_LOD_BIAS) {
+        m_settings.lodBias = std::min(m_settings.lodBias + 0.5f, MAX_LOD_BIAS);
+        return QualityDecision::RAISE_LOD_BIAS;
+    }
+    if (m_settings.maxLights > MIN_LIGHTS) {
+        m_settings.maxLights--;
+        return QualityDecision::FEWER_LIGHTS;
+    }
+    return QualityDecision::NONE;
+}
+
+/**
+ * @brief Podnosi jakość o jeden krok
+ * @return Podjęta decyzja
+ *
+ * @details Parametry przywracane są w kolejności odwrotnej do obniżania,
+ * a rozdzielczość rośnie pojedynczym krokiem RESOLUTION_STEP.
+ */
+QualityDecision QualityGovernor::improve() {
+    if (m_settings.maxLights < m_maxQuality.maxLights) {
+        m_settings.maxLights++;
+        return QualityDecision::MORE_LIGHTS;
+    }
+    if (m_settings.lodBias > m_maxQuality.lodBias) {
+        m_settings.lodBias = std::max(m_settings.lodBias - 0.5f, m_maxQuality.lodBias);
+        return QualityDecision::LOWER_LOD_BIAS;
+    }
+    if (m_settings.resolutionScale < m_maxQuality.resolutionScale) {
+        m_settings.resolutionScale = std::min(m_settings.resolutionScale + RESOLUTION_STEP,
+                                              m_maxQuality.resolutionScale);
+        return QualityDecision::RAISE_RESOLUTION;
+    }
+    return QualityDecision::NONE;
+}
+
+/**
+ * @brief Przetwarza pomiar jednej klatki
+ * @param cpuMs Czas CPU klatki w milisekundach
+ * @param gpuMs Czas GPU klatki w milisekundach
+ * @return Ustawienia do zastosowania w następnej klatce
+ *
+ * @details Jakość obniżana jest, gdy wygładzony czas klatki przekracza cel
+ * o więcej niż 5%, a podnoszona dopiero po 2 okresach karencji z czasem
+ * poniżej 80% celu. Pomiędzy progami ustawienia się nie zmieniają.
+ */
+const QualitySettings& QualityGovernor::update(double cpuMs, double gpuMs) {
+    if (!m_enabled) return m_settings;
+
+    if (!m_hasSample) {
+        m_smoothedCpuMs = cpuMs;
+        m_smoothedGpuMs = gpuMs;
+        m_hasSample = true;
+    } else {
+        m_smoothedCpuMs += m_smoothing * (cpuMs - m_smoothedCpuMs);
+        m_smoothedGpuMs += m_smoothing * (gpuMs - m_smoothedGpuMs);
+    }
+
+    m_framesSinceChange++;
+    double frameMs = std::max(m_smoothedCpuMs, m_smoothedGpuMs);
+    double ratio = m_targetFrameMs > 0.0 ? frameMs / m_targetFrameMs : 0.0;
+
+    QualityDecision decision = QualityDecision::NONE;
+    if (ratio > m_upperThreshold) {
+        m_framesWithHeadroom = 0;
+        if (m_framesSinceChange >= m_cooldownFrames) {
+            decision = degrade(m_smoothedGpuMs >= m_smoothedCpuMs);
+        }
+    } else if (ratio < m_lowerThreshold) {
+        m_framesWithHeadroom++;
+        if (m_framesWithHeadroom >= 2 * m_cooldownFrames && m_framesSinceChange >= m_cooldownFrames) {
+            decision = improve();
+            m_framesWithHeadroom = 0;
+        }
+    } else {
+        m_framesWithHeadroom = 0;
+    }
+
+    if (decision != QualityDecision::NONE) {
+        m_lastDecision = decision;
+        m_framesSinceChange = 0;
+    }
+    return m_settings;
+}
+
+/**
+ * @brief Zwraca nazwę decyzji
+ * @param decision Decyzja
+ * @return Nazwa do wypisania
+ */
+std::string QualityGovernor::getDecisionName(QualityDecision decision) {
+    switch (decision) {
+        case QualityDecision::LOWER_RESOLUTION: return "Obnizono rozdzielczosc";
+        case QualityDecision::RAISE_RESOLUTION: return "Podniesiono rozdzielczosc";
+        case QualityDecision::RAISE_LOD_BIAS:   return "Uproszczono geometrie (LOD)";
+        case QualityDecision::LOWER_LOD_BIAS:   return "Przywrocono szczegoly geometrii (LOD)";
+        case QualityDecision::FEWER_LIGHTS:     return "Zmniejszono limit swiatel";
+        case QualityDecision::MORE_LIGHTS:      return "Zwiekszono limit swiatel";
+        default:                                return "Brak zmian";
+    }
+}
+
+/**
+ * @brief Publikuje ustawienia i decyzję w RenderStats
+ */
+void QualityGovernor::publishStats() const {
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Jakosc/Aktywny", m_enabled ? 1.0 : 0.0);
+    stats.setValue("Jakosc/Cel [ms]", m_targetFrameMs);
+    stats.setValue("Jakosc/Czas CPU wygladzony [ms]", m_smoothedCpuMs);
+    stats.setValue("Jakosc/Czas GPU wygladzony [ms]", m_smoothedGpuMs);
+    stats.setValue("Jakosc/Skala rozdzielczosci", m_settings.resolutionScale);
+    stats.setValue("Jakosc/Przesuniecie LOD", m_settings.lodBias);
+    stats.setValue("Jakosc/Limit swiatel", m_settings.maxLights);
+    stats.setValue("Jakosc/Ostatnia decyzja", static_cast<double>(m_lastDecision));
+}
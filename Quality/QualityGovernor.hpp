@@ -0,0 +1,162 @@
+// QualityGovernor.hpp
+#ifndef QUALITY_GOVERNOR_HPP
+#define QUALITY_GOVERNOR_HPP
+
+#include <string>
+
+/**
+ * @struct QualitySettings
+ * @brief Aktualne wartości regulowanych parametrów jakości
+ */
+struct QualitySettings {
+    float resolutionScale;      /**< Skala wewnętrznej rozdzielczości renderowania (0..1] */
+    float lodBias;              /**< Przesunięcie poziomu szczegółowości (0 = pełna jakość) */
+    int maxLights;              /**< Maksymalna liczba aktywnych świateł */
+};
+
+/**
+ * @enum QualityDecision
+ * @brief Ostatnia decyzja regulatora
+ */
+enum class QualityDecision {
+    NONE,                   /**< Brak zmian */
+    LOWER_RESOLUTION,       /**< Obniżono rozdzielczość */
+    RAISE_RESOLUTION,       /**< Podniesiono rozdzielczość */
+    RAISE_LOD_BIAS,         /**< Uproszczono geometrię */
+    LOWER_LOD_BIAS,         /**< Przywrócono szczegóły geometrii */
+    FEWER_LIGHTS,           /**< Zmniejszono limit świateł */
+    MORE_LIGHTS             /**< Zwiększono limit świateł */
+};
+
+/**
+ * @class QualityGovernor
+ * @brief Regulator jakości utrzymujący docelowy czas klatki
+ *
+ * Na podstawie zmierzonych czasów CPU i GPU regulator zmienia parametry
+ * jakości: rozdzielczość wewnętrzną, przesunięcie LOD i limit świateł.
+ *
+ * Aby uniknąć oscylacji:
+ * - czasy są wygładzane średnią wykładniczą,
+ * - decyzje podejmowane są tylko poza pasmem histerezy wokół celu,
+ * - po każdej zmianie następuje okres karencji,
+ * - podnoszenie jakości wymaga dłuższego zapasu i odbywa się mniejszymi krokami
+ *   niż jej obniżanie.
+ *
+ * Klasa nie korzysta z OpenGL ani zegara - update() przyjmuje czasy
+ * z zewnątrz, więc regulator można sprawdzić na symulowanych pomiarach.
+ */
+class QualityGovernor {
+public:
+    static constexpr float MIN_RESOLUTION_SCALE = 0.5f;  /**< Najniższa skala rozdzielczości */
+    static constexpr float RESOLUTION_STEP = 0.05f;      /**< Kwant skali (ogranicza liczbę rozmiarów FBO) */
+    static constexpr float MAX_LOD_BIAS = 2.0f;          /**< Największe przesunięcie LOD */
+    static const int MIN_LIGHTS = 1;                     /**< Najmniejszy limit świateł */
+
+private:
+    QualitySettings m_settings;     /**< Aktualne ustawienia */
+    QualitySettings m_maxQuality;   /**< Ustawienia pełnej jakości */
+    double m_targetFrameMs;         /**< Docelowy czas klatki */
+    double m_smoothedCpuMs;         /**< Wygładzony czas CPU */
+    double m_smoothedGpuMs;         /**< Wygładzony czas GPU */
+    double m_smoothing;             /**< Współczynnik średniej wykładniczej */
+    double m_upperThreshold;        /**< Próg przekroczenia budżetu (ułamek celu) */
+    double m_lowerThreshold;        /**< Próg zapasu pozwalający podnieść jakość */
+    int m_cooldownFrames;           /**< Długość okresu karencji po zmianie */
+    int m_framesSinceChange;        /**< Klatki od ostatniej zmiany */
+    int m_framesWithHeadroom;       /**< Kolejne klatki z zapasem czasu */
+    bool m_hasSample;               /**< Czy otrzymano już pomiar */
+    bool m_enabled;                 /**< Czy regulator jest aktywny */
+    QualityDecision m_lastDecision; /**< Ostatnia decyzja */
+
+    /**
+     * @brief Obniża jakość o jeden krok
+     * @param gpuBound Czy klatkę ogranicza GPU
+     * @return Podjęta decyzja
+     */
+    QualityDecision degrade(bool gpuBound);
+
+    /**
+     * @brief Podnosi jakość o jeden krok
+     * @return Podjęta decyzja
+     */
+    QualityDecision improve();
+
+public:
+    /**
+     * @brief Konstruktor QualityGovernor
+     * @param targetFrameMs Docelowy czas klatki w milisekundach
+     * @param maxLights Limit świateł przy pełnej jakości
+     */
+    explicit QualityGovernor(double targetFrameMs = 1000.0 / 60.0, int maxLights = 8);
+
+    /**
+     * @brief Ustawia docelowy czas klatki
+     * @param targetFrameMs Czas w milisekundach
+     */
+    void setTargetFrameTime(double targetFrameMs) { m_targetFrameMs = targetFrameMs; }
+
+    /**
+     * @brief Zwraca docelowy czas klatki
+     * @return Czas w milisekundach
+     */
+    double getTargetFrameTime() const { return m_targetFrameMs; }
+
+    /**
+     * @brief Ustawia długość okresu karencji po każdej zmianie
+     * @param frames Liczba klatek
+     */
+    void setCooldown(int frames) { m_cooldownFrames = frames; }
+
+    /**
+     * @brief Włącza lub wyłącza regulator
+     * @param enabled true aby włączyć
+     *
+     * Wyłączenie przywraca pełną jakość.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Sprawdza, czy regulator jest aktywny
+     * @return true jeśli aktywny
+     */
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Przetwarza pomiar jednej klatki
+     * @param cpuMs Czas CPU klatki w milisekundach
+     * @param gpuMs Czas GPU klatki w milisekundach
+     * @return Ustawienia do zastosowania w następnej klatce
+     */
+    const QualitySettings& update(double cpuMs, double gpuMs);
+
+    /**
+     * @brief Przywraca pełną jakość i czyści historię pomiarów
+     */
+    void reset();
+
+    /**
+     * @brief Zwraca aktualne ustawienia
+     * @return Ustawienia jakości
+     */
+    const QualitySettings& getSettings() const { return m_settings; }
+
+    /**
+     * @brief Zwraca ostatnią decyzję
+     * @return Decyzja
+     */
+    QualityDecision getLastDecision() const { return m_lastDecision; }
+
+    /**
+     * @brief Zwraca nazwę decyzji
+     * @param decision Decyzja
+     * @return Nazwa do wypisania
+     */
+    static std::string getDecisionName(QualityDecision decision);
+
+    /**
+     * @brief Publikuje ustawienia i decyzję w RenderStats
+     */
+    void publishStats() const;
+};
+
+#endif // QUALITY_GOVERNOR_HPP
@@ -0,0 +1,134 @@
+// SharpenUpscaler.cpp
+#include "SharpenUpscaler.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <iostream>
+
+/**
+ * @brief Vertex shader trójkąta pełnoekranowego
+ */
+static const char* upscaleVertexSource = R"(
+#version 330 core
+out vec2 TexCoord;
+
+void main()
+{
+    // Trójkąt (-1,-1), (3,-1), (-1,3) pokrywa cały ekran
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    TexCoord = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader skalowania z wyostrzaniem
+ */
+static const char* upscaleFragmentSource = R"(
+#version 330 core
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D sourceTexture;
+uniform vec2 texelSize;
+uniform float sharpness;
+
+void main()
+{
+    vec3 center = texture(sourceTexture, TexCoord).rgb;
+    vec3 north = texture(sourceTexture, TexCoord + vec2(0.0, texelSize.y)).rgb;
+    vec3 south = texture(sourceTexture, TexCoord - vec2(0.0, texelSize.y)).rgb;
+    vec3 east = texture(sourceTexture, TexCoord + vec2(texelSize.x, 0.0)).rgb;
+    vec3 west = texture(sourceTexture, TexCoord - vec2(texelSize.x, 0.0)).rgb;
+
+    // Ogranicz wyostrzanie tam, gdzie kontrast jest już wysoki
+    vec3 minColor = min(center, min(min(north, south), min(east, west)));
+    vec3 maxColor = max(center, max(max(north, south), max(east, west)));
+    float contrast = dot(maxColor - minColor, vec3(0.299, 0.587, 0.114));
+    float amount = sharpness * (1.0 - clamp(contrast * 2.0, 0.0, 1.0));
+
+    vec3 sharpened = center + amount * (4.0 * center - north - south - east - west);
+    FragColor = vec4(clamp(sharpened, minColor, maxColor), 1.0);
+}
+)";
+
+/**
+ * @brief Konstruktor SharpenUpscaler
+ */
+SharpenUpscaler::SharpenUpscaler()
+    : m_program(0), m_emptyVAO(0), m_sourceLoc(-1), m_texelSizeLoc(-1), m_sharpnessLoc(-1) {
+}
+
+/**
+ * @brief Destruktor SharpenUpscaler
+ */
+SharpenUpscaler::~SharpenUpscaler() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery i tworzy VAO
+ * @return true jeśli inicjalizacja się powiodła
+ */
+bool SharpenUpscaler::initialize() {
+    if (m_program) return true;
+
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, upscaleVertexSource, "skalowania");
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, upscaleFragmentSource, "skalowania");
+    m_program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "skalowania");
+    if (!m_program) return false;
+
+    m_sourceLoc = glGetUniformLocation(m_program, "sourceTexture");
+    m_texelSizeLoc = glGetUniformLocation(m_program, "texelSize");
+    m_sharpnessLoc = glGetUniformLocation(m_program, "sharpness");
+
+    glGenVertexArrays(1, &m_emptyVAO);
+    return true;
+}
+
+/**
+ * @brief Zwalnia obiekty OpenGL
+ */
+void SharpenUpscaler::release() {
+    if (m_program) glDeleteProgram(m_program);
+    if (m_emptyVAO) glDeleteVertexArrays(1, &m_emptyVAO);
+    m_program = 0;
+    m_emptyVAO = 0;
+}
+
+/**
+ * @brief Rysuje przeskalowaną teksturę do aktualnego bufora ramki
+ * @param texture Tekstura źródłowa
+ * @param sourceWidth Szerokość tekstury źródłowej
+ * @param sourceHeight Wysokość tekstury źródłowej
+ * @param sharpness Siła wyostrzania
+ *
+ * @details Tryb wielokątów, test głębokości i aktywny program są
+ * przywracane po rysowaniu, bo scena może być w trybie siatki lub punktów.
+ */
+void SharpenUpscaler::draw(GLuint texture, int sourceWidth, int sourceHeight, float sharpness) {
+    if (!m_program || sourceWidth <= 0 || sourceHeight <= 0) return;
+
+    GLint previousProgram = 0;
+    GLint polygonMode[2] = {GL_FILL, GL_FILL};
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+
+    glDisable(GL_DEPTH_TEST);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    glUseProgram(m_program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glUniform1i(m_sourceLoc, 0);
+    glUniform2f(m_texelSizeLoc, 1.0f / sourceWidth, 1.0f / sourceHeight);
+    glUniform1f(m_sharpnessLoc, sharpness);
+
+    glBindVertexArray(m_emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPolygonMode(GL_FRONT_AND_BACK, polygonMode[0]);
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+    glUseProgram(previousProgram);
+}
@@ -0,0 +1,56 @@
+// SharpenUpscaler.hpp
+#ifndef SHARPEN_UPSCALER_HPP
+#define SHARPEN_UPSCALER_HPP
+
+#include <GL/glew.h>
+
+/**
+ * @class SharpenUpscaler
+ * @brief Skalowanie obrazu do rozdzielczości okna z wyostrzaniem
+ *
+ * Rysuje trójkąt pokrywający cały ekran (wierzchołki z gl_VertexID),
+ * próbkując teksturę biliniowo i wyostrzając wynik maską nieostrą
+ * z czterech sąsiednich tekseli. Siła wyostrzania ograniczona jest
+ * lokalnym kontrastem, aby nie wzmacniać szumu na krawędziach.
+ */
+class SharpenUpscaler {
+private:
+    GLuint m_program;           /**< Program shaderowy skalowania */
+    GLuint m_emptyVAO;          /**< Pusty VAO dla rysowania bez atrybutów */
+    GLint m_sourceLoc;          /**< Lokalizacja uniformu tekstury źródłowej */
+    GLint m_texelSizeLoc;       /**< Lokalizacja uniformu rozmiaru teksela */
+    GLint m_sharpnessLoc;       /**< Lokalizacja uniformu siły wyostrzania */
+
+public:
+    /**
+     * @brief Konstruktor SharpenUpscaler
+     */
+    SharpenUpscaler();
+
+    /**
+     * @brief Destruktor SharpenUpscaler
+     */
+    ~SharpenUpscaler();
+
+    /**
+     * @brief Kompiluje shadery i tworzy VAO
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zwalnia obiekty OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Rysuje przeskalowaną teksturę do aktualnego bufora ramki
+     * @param texture Tekstura źródłowa
+     * @param sourceWidth Szerokość tekstury źródłowej
+     * @param sourceHeight Wysokość tekstury źródłowej
+     * @param sharpness Siła wyostrzania (0 = tylko filtr biliniowy)
+     */
+    void draw(GLuint texture, int sourceWidth, int sourceHeight, float sharpness);
+};
+
+#endif // SHARPEN_UPSCALER_HPP
@@ -0,0 +1,849 @@
+// RenderGraph.cpp
+#include "RenderGraph.hpp"
+#include "../Stats/RenderStats.hpp"
+#include <algorithm>
+#include <iostream>
+
+// ==================== RenderPassBuilder ====================
+
+/**
+ * @brief Konstruktor RenderPassBuilder
+ * @param graph Graf renderowania
+ * @param passIndex Indeks przebiegu
+ */
+RenderPassBuilder::RenderPassBuilder(RenderGraph& graph, int passIndex)
+    : m_graph(graph), m_passIndex(passIndex) {
+}
+
+/**
+ * @brief Tworzy teksturę tymczasową żyjącą tylko w bieżącej klatce
+ * @param name Nazwa tekstury
+ * @param desc Opis tekstury
+ * @return Uchwyt nowej tekstury
+ *
+ * @details Utworzenie zasobu nie jest zapisem - przebieg musi dodatkowo
+ * wywołać write(), aby zasób otrzymał zawartość.
+ */
+RenderResourceHandle RenderPassBuilder::createTexture(const std::string& name, const RenderTextureDesc& desc) {
+    RenderResourceHandle handle = m_graph.addResource(name, RenderResourceType::TEXTURE);
+    m_graph.m_resources[handle].textureDesc = desc;
+    m_graph.m_passes[m_passIndex].creates.push_back(handle);
+    return handle;
+}
+
+/**
+ * @brief Tworzy bufor tymczasowy żyjący tylko w bieżącej klatce
+ * @param name Nazwa bufora
+ * @param desc Opis bufora
+ * @return Uchwyt nowego bufora
+ */
+RenderResourceHandle RenderPassBuilder::createBuffer(const std::string& name, const RenderBufferDesc& desc) {
+    RenderResourceHandle handle = m_graph.addResource(name, RenderResourceType::BUFFER);
+    m_graph.m_resources[handle].bufferDesc = desc;
+    m_graph.m_passes[m_passIndex].creates.push_back(handle);
+    return handle;
+}
+
+/**
+ * @brief Deklaruje odczyt zasobu
+ * @param resource Uchwyt zasobu
+ * @param usage Sposób odczytu
+ * @return Uchwyt zasobu
+ */
+RenderResourceHandle RenderPassBuilder::read(RenderResourceHandle resource, RenderResourceUsage usage) {
+    if (resource < 0 || resource >= static_cast<int>(m_graph.m_resources.size())) {
+        std::cerr << "RenderGraph: Nieprawidlowy zasob odczytywany przez przebieg "
+                  << m_graph.m_passes[m_passIndex].name << std::endl;
+        return INVALID_RENDER_RESOURCE;
+    }
+    m_graph.m_passes[m_passIndex].reads.push_back({resource, usage});
+    return resource;
+}
+
+/**
+ * @brief Deklaruje zapis zasobu
+ * @param resource Uchwyt zasobu
+ * @param usage Sposób zapisu
+ * @return Uchwyt zasobu
+ */
+RenderResourceHandle RenderPassBuilder::write(RenderResourceHandle resource, RenderResourceUsage usage) {
+    if (resource < 0 || resource >= static_cast<int>(m_graph.m_resources.size())) {
+        std::cerr << "RenderGraph: Nieprawidlowy zasob zapisywany przez przebieg "
+                  << m_graph.m_passes[m_passIndex].name << std::endl;
+        return INVALID_RENDER_RESOURCE;
+    }
+    m_graph.m_passes[m_passIndex].writes.push_back({resource, usage});
+    return resource;
+}
+
+/**
+ * @brief Oznacza przebieg jako posiadający efekty uboczne
+ */
+void RenderPassBuilder::setSideEffect() {
+    m_graph.m_passes[m_passIndex].sideEffect = true;
+}
+
+// ==================== RenderPassResources ====================
+
+/**
+ * @brief Zwraca identyfikator tekstury OpenGL
+ * @param resource Uchwyt zasobu
+ * @return ID tekstury (0 dla bufora ramki okna)
+ */
+GLuint RenderPassResources::getTexture(RenderResourceHandle resource) const {
+    if (resource < 0 || resource >= static_cast<int>(m_graph.m_resources.size())) return 0;
+    return m_graph.m_resources[resource].glObject;
+}
+
+/**
+ * @brief Zwraca identyfikator bufora OpenGL
+ * @param resource Uchwyt zasobu
+ * @return ID bufora
+ */
+GLuint RenderPassResources::getBuffer(RenderResourceHandle resource) const {
+    if (resource < 0 || resource >= static_cast<int>(m_graph.m_resources.size())) return 0;
+    return m_graph.m_resources[resource].glObject;
+}
+
+/**
+ * @brief Zwraca opis tekstury
+ * @param resource Uchwyt zasobu
+ * @return Opis tekstury
+ */
+const RenderTextureDesc& RenderPassResources::getTextureDesc(RenderResourceHandle resource) const {
+    return m_graph.m_resources[resource].textureDesc;
+}
+
+// ==================== RenderGraph ====================
+
+/**
+ * @brief Konstruktor RenderGraph
+ */
+RenderGraph::RenderGraph()
+    : m_compiled(false), m_virtualMemory(0), m_physicalMemory(0) {
+}
+
+/**
+ * @brief Destruktor RenderGraph
+ */
+RenderGraph::~RenderGraph() {
+    release();
+}
+
+/**
+ * @brief Czyści graf przed budową nowej klatki
+ */
+void RenderGraph::reset() {
+    m_passes.clear();
+    m_resources.clear();
+    m_executionOrder.clear();
+    m_compiled = false;
+}
+
+/**
+ * @brief Dodaje węzeł zasobu
+ * @param name Nazwa zasobu
+ * @param type Rodzaj zasobu
+ * @return Uchwyt nowego zasobu
+ */
+RenderResourceHandle RenderGraph::addResource(const std::string& name, RenderResourceType type) {
+    ResourceNode node;
+    node.name = name;
+    node.type = type;
+    node.textureDesc = {0, 0, GL_RGBA8};
+    node.bufferDesc = {0};
+    node.imported = false;
+    node.output = false;
+    node.glObject = 0;
+    node.physicalIndex = -1;
+    node.refCount = 0;
+    node.firstUse = -1;
+    node.lastUse = -1;
+    m_resources.push_back(node);
+    return static_cast<RenderResourceHandle>(m_resources.size() - 1);
+}
+
+/**
+ * @brief Importuje istniejącą teksturę OpenGL
+ * @param name Nazwa zasobu
+ * @param texture ID tekstury
+ * @param desc Opis tekstury
+ * @return Uchwyt zasobu
+ */
+RenderResourceHandle RenderGraph::importTexture(const std::string& name, GLuint texture, const RenderTextureDesc& desc) {
+    RenderResourceHandle handle = addResource(name, RenderResourceType::TEXTURE);
+    m_resources[handle].textureDesc = desc;
+    m_resources[handle].imported = true;
+    m_resources[handle].glObject = texture;
+    return handle;
+}
+
+/**
+ * @brief Importuje domyślny bufor ramki okna
+ * @param name Nazwa zasobu
+ * @param width Szerokość bufora ramki
+ * @param height Wysokość bufora ramki
+ * @return Uchwyt zasobu
+ *
+ * @details Bufor ramki okna reprezentowany jest jako importowana tekstura
+ * o identyfikatorze 0. Przebieg zapisujący go renderuje do FBO 0.
+ */
+RenderResourceHandle RenderGraph::importBackbuffer(const std::string& name, int width, int height) {
+    RenderResourceHandle handle = importTexture(name, 0, {width, height, GL_RGBA8});
+    m_resources[handle].output = true;
+    return handle;
+}
+
+/**
+ * @brief Importuje istniejący bufor OpenGL
+ * @param name Nazwa zasobu
+ * @param buffer ID bufora
+ * @param size Rozmiar bufora w bajtach
+ * @return Uchwyt zasobu
+ */
+RenderResourceHandle RenderGraph::importBuffer(const std::string& name, GLuint buffer, GLsizeiptr size) {
+    RenderResourceHandle handle = addResource(name, RenderResourceType::BUFFER);
+    m_resources[handle].bufferDesc = {size};
+    m_resources[handle].imported = true;
+    m_resources[handle].glObject = buffer;
+    return handle;
+}
+
+/**
+ * @brief Oznacza zasób jako wynik grafu
+ * @param resource Uchwyt zasobu
+ */
+void RenderGraph::markOutput(RenderResourceHandle resource) {
+    if (resource >= 0 && resource < static_cast<int>(m_resources.size())) {
+        m_resources[resource].output = true;
+    }
+}
+
+/**
+ * @brief Dodaje przebieg do grafu
+ * @param name Nazwa przebiegu
+ * @param setup Funkcja deklarująca zasoby przebiegu
+ * @param execute Funkcja wykonująca polecenia OpenGL
+ *
+ * @details Funkcja konfiguracji wywoływana jest natychmiast, więc uchwyty
+ * zasobów utworzonych przez przebieg są od razu dostępne dla kolejnych przebiegów.
+ */
+void RenderGraph::addPass(const std::string& name, const SetupFunction& setup, const ExecuteFunction& execute) {
+    PassNode pass;
+    pass.name = name;
+    pass.execute = execute;
+    pass.sideEffect = false;
+    pass.culled = false;
+    pass.refCount = 0;
+    pass.barriers = 0;
+    m_passes.push_back(pass);
+    m_compiled = false;
+
+    RenderPassBuilder builder(*this, static_cast<int>(m_passes.size() - 1));
+    if (setup) {
+        setup(builder);
+    }
+}
+
+/**
+ * @brief Usuwa przebiegi, których wyniki nie są używane
+ *
+ * @details Licznik referencji przebiegu to liczba zapisywanych zasobów,
+ * a licznik zasobu to liczba przebiegów, które go czytają. Zasoby z zerowym
+ * licznikiem trafiają na stos; zdjęcie zasobu ze stosu zmniejsza licznik jego
+ * producentów, a usunięty producent zwalnia z kolei swoje wejścia.
+ * Wyniki grafu i przebiegi z efektami ubocznymi nigdy nie są usuwane.
+ */
+void RenderGraph::cullPasses() {
+    std::vector<std::vector<int>> producers(m_resources.size());
+
+    for (auto& resource : m_resources) {
+        resource.refCount = resource.output ? 1 : 0;
+    }
+    for (size_t p = 0; p < m_passes.size(); ++p) {
+        PassNode& pass = m_passes[p];
+        pass.culled = false;
+        pass.refCount = static_cast<int>(pass.writes.size());
+        for (const auto& access : pass.reads) {
+            m_resources[access.resource].refCount++;
+        }
+        for (const auto& access : pass.writes) {
+            producers[access.resource].push_back(static_cast<int>(p));
+        }
+    }
+
+    std::vector<RenderResourceHandle> unreferenced;
+    for (size_t r = 0; r < m_resources.size(); ++r) {
+        if (m_resources[r].refCount == 0) {
+            unreferenced.push_back(static_cast<RenderResourceHandle>(r));
+        }
+    }
+
+    // Przebiegi bez zapisów i bez efektów ubocznych nic nie wnoszą
+    auto cullPass = [&](PassNode& pass) {
+        pass.culled = true;
+        for (const auto& access : pass.reads) {
+            if (--m_resources[access.resource].refCount == 0) {
+                unreferenced.push_back(access.resource);
+            }
+        }
+    };
+    for (auto& pass : m_passes) {
+        if (pass.refCount == 0 && !pass.sideEffect) {
+            cullPass(pass);
+        }
+    }
+
+    while (!unreferenced.empty()) {
+        RenderResourceHandle resource = unreferenced.back();
+        unreferenced.pop_back();
+
+        for (int p : producers[resource]) {
+            PassNode& pass = m_passes[p];
+            if (pass.culled || pass.sideEffect) continue;
+            if (--pass.refCount == 0) {
+                cullPass(pass);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sortuje topologicznie przebiegi, które pozostały po usuwaniu
+ * @return true jeśli graf jest acykliczny
+ *
+ * @details Krawędzie zależności:
+ * - kolejni producenci zasobu wykonują się w kolejności deklaracji,
+ * - odczyt zależy od ostatniego wcześniej zadeklarowanego zapisu, a jeśli go
+ *   nie ma - od wszystkich producentów zasobu,
+ * - zapis zależy od odczytów poprzedniej wersji zasobu.
+ *
+ * Algorytm Kahna wybiera spośród gotowych przebiegów ten zadeklarowany
+ * najwcześniej, więc przy braku ograniczeń kolejność deklaracji jest zachowana.
+ * W przypadku cyklu zwracana jest kolejność deklaracji.
+ */
+bool RenderGraph::sortPasses() {
+    const int passCount = static_cast<int>(m_passes.size());
+    std::vector<std::vector<int>> edges(passCount);
+    std::vector<int> inDegree(passCount, 0);
+
+    auto addEdge = [&](int from, int to) {
+        if (from == to) return;
+        if (std::find(edges[from].begin(), edges[from].end(), to) != edges[from].end()) return;
+        edges[from].push_back(to);
+        inDegree[to]++;
+    };
+
+    std::vector<std::vector<int>> producers(m_resources.size());
+    for (int p = 0; p < passCount; ++p) {
+        if (m_passes[p].culled) continue;
+        for (const auto& access : m_passes[p].writes) {
+            producers[access.resource].push_back(p);
+        }
+    }
+
+    std::vector<int> lastWriter(m_resources.size(), -1);
+    std::vector<std::vector<int>> readersSinceWrite(m_resources.size());
+
+    for (int p = 0; p < passCount; ++p) {
+        const PassNode& pass = m_passes[p];
+        if (pass.culled) continue;
+
+        for (const auto& access : pass.reads) {
+            int writer = lastWriter[access.resource];
+            if (writer >= 0) {
+                addEdge(writer, p);
+            } else {
+                for (int producer : producers[access.resource]) {
+                    addEdge(producer, p);
+                }
+            }
+            readersSinceWrite[access.resource].push_back(p);
+        }
+        for (const auto& access : pass.writes) {
+            if (lastWriter[access.resource] >= 0) {
+                addEdge(lastWriter[access.resource], p);
+            }
+            for (int reader : readersSinceWrite[access.resource]) {
+                if (lastWriter[access.resource] >= 0) {
+                    addEdge(reader, p);
+                }
+            }
+            lastWriter[access.resource] = p;
+            readersSinceWrite[access.resource].clear();
+        }
+    }
+
+    m_executionOrder.clear();
+    std::vector<int> ready;
+    for (int p = 0; p < passCount; ++p) {
+        if (!m_passes[p].culled && inDegree[p] == 0) {
+            ready.push_back(p);
+        }
+    }
+
+    while (!ready.empty()) {
+        auto next = std::min_element(ready.begin(), ready.end());
+        int p = *next;
+        ready.erase(next);
+        m_executionOrder.push_back(p);
+
+        for (int to : edges[p]) {
+            if (--inDegree[to] == 0) {
+                ready.push_back(to);
+            }
+        }
+    }
+
+    int activeCount = 0;
+    for (const auto& pass : m_passes) {
+        if (!pass.culled) activeCount++;
+    }
+
+    if (static_cast<int>(m_executionOrder.size()) != activeCount) {
+        std::cerr << "RenderGraph: Wykryto cykl zaleznosci, uzyto kolejnosci deklaracji" << std::endl;
+        m_executionOrder.clear();
+        for (int p = 0; p < passCount; ++p) {
+            if (!m_passes[p].culled) m_executionOrder.push_back(p);
+        }
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Zwraca bit bariery wymagany przed danym użyciem zasobu
+ * @param usage Sposób użycia
+ * @return Bit glMemoryBarrier
+ */
+static GLbitfield barrierForUsage(RenderResourceUsage usage) {
+    switch (usage) {
+        case RenderResourceUsage::SAMPLED:          return GL_TEXTURE_FETCH_BARRIER_BIT;
+        case RenderResourceUsage::COLOR_ATTACHMENT:
+        case RenderResourceUsage::DEPTH_ATTACHMENT: return GL_FRAMEBUFFER_BARRIER_BIT;
+        case RenderResourceUsage::IMAGE_LOAD:
+        case RenderResourceUsage::IMAGE_STORE:      return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        case RenderResourceUsage::STORAGE_READ:
+        case RenderResourceUsage::STORAGE_WRITE:    return GL_SHADER_STORAGE_BARRIER_BIT;
+        case RenderResourceUsage::UNIFORM:          return GL_UNIFORM_BARRIER_BIT;
+        case RenderResourceUsage::VERTEX:           return GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+        case RenderResourceUsage::INDEX:            return GL_ELEMENT_ARRAY_BARRIER_BIT;
+        case RenderResourceUsage::INDIRECT:         return GL_COMMAND_BARRIER_BIT;
+        case RenderResourceUsage::TRANSFER:         return GL_BUFFER_UPDATE_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT;
+    }
+    return 0;
+}
+
+/**
+ * @brief Wyznacza bariery pamięci dla przebiegów
+ *
+ * @details Bariera potrzebna jest tylko po zapisach niekoherentnych
+ * (imageStore, zapis SSBO). Zapisy przez FBO są synchronizowane niejawnie
+ * przez sterownik. Dla każdego zasobu pamiętane są bity już wydanych barier,
+ * aby kilka kolejnych odczytów nie powtarzało tej samej bariery.
+ */
+void RenderGraph::computeBarriers() {
+    std::vector<bool> incoherent(m_resources.size(), false);
+    std::vector<GLbitfield> issued(m_resources.size(), 0);
+
+    for (int p : m_executionOrder) {
+        PassNode& pass = m_passes[p];
+        pass.barriers = 0;
+
+        auto require = [&](const ResourceAccess& access) {
+            if (!incoherent[access.resource]) return;
+            GLbitfield bit = barrierForUsage(access.usage);
+            if (bit & ~issued[access.resource]) {
+                pass.barriers |= bit;
+                issued[access.resource] |= bit;
+            }
+        };
+
+        for (const auto& access : pass.reads) require(access);
+        for (const auto& access : pass.writes) require(access);
+
+        for (const auto& access : pass.writes) {
+            bool shaderWrite = access.usage == RenderResourceUsage::IMAGE_STORE ||
+                               access.usage == RenderResourceUsage::STORAGE_WRITE;
+            incoherent[access.resource] = shaderWrite;
+            issued[access.resource] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Zwraca rozmiar tekstury w bajtach
+ * @param desc Opis tekstury
+ * @return Rozmiar w bajtach
+ */
+size_t RenderGraph::textureSize(const RenderTextureDesc& desc) {
+    size_t bytesPerPixel = 4;
+    switch (desc.internalFormat) {
+        case GL_R8:             bytesPerPixel = 1; break;
+        case GL_RG8:            bytesPerPixel = 2; break;
+        case GL_R16F:           bytesPerPixel = 2; break;
+        case GL_RGBA16F:        bytesPerPixel = 8; break;
+        case GL_RGBA32F:        bytesPerPixel = 16; break;
+        case GL_RGB32F:         bytesPerPixel = 12; break;
+        default:                bytesPerPixel = 4; break;
+    }
+    return static_cast<size_t>(desc.width) * static_cast<size_t>(desc.height) * bytesPerPixel;
+}
+
+/**
+ * @brief Sprawdza, czy format tekstury jest formatem głębokości
+ * @param internalFormat Format wewnętrzny
+ * @return true dla formatów głębokości
+ */
+static bool isDepthFormat(GLenum internalFormat) {
+    return internalFormat == GL_DEPTH_COMPONENT16 || internalFormat == GL_DEPTH_COMPONENT24 ||
+           internalFormat == GL_DEPTH_COMPONENT32F || internalFormat == GL_DEPTH24_STENCIL8;
+}
+
+/**
+ * @brief Tworzy obiekt OpenGL dla fizycznego zasobu
+ * @param resource Fizyczny zasób
+ */
+void RenderGraph::createPhysical(PhysicalResource& resource) {
+    if (resource.type == RenderResourceType::TEXTURE) {
+        const RenderTextureDesc& desc = resource.textureDesc;
+        GLenum format = GL_RGBA;
+        GLenum type = GL_FLOAT;
+        if (desc.internalFormat == GL_DEPTH24_STENCIL8) {
+            format = GL_DEPTH_STENCIL;
+            type = GL_UNSIGNED_INT_24_8;
+        } else if (isDepthFormat(desc.internalFormat)) {
+            format = GL_DEPTH_COMPONENT;
+        }
+
+        glGenTextures(1, &resource.glObject);
+        glBindTexture(GL_TEXTURE_2D, resource.glObject);
+        glTexImage2D(GL_TEXTURE_2D, 0, desc.internalFormat, desc.width, desc.height, 0, format, type, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    } else {
+        glGenBuffers(1, &resource.glObject);
+        glBindBuffer(GL_ARRAY_BUFFER, resource.glObject);
+        glBufferData(GL_ARRAY_BUFFER, resource.bufferDesc.size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
+
+/**
+ * @brief Przydziela obiekty fizyczne zasobom tymczasowym
+ *
+ * @details Czas życia zasobu to przedział pozycji w kolejności wykonania
+ * od pierwszego do ostatniego użycia. Zasoby przetwarzane są według początku
+ * czasu życia; każdy dostaje pierwszy obiekt z puli o identycznym opisie,
+ * którego poprzedni użytkownik zakończył życie wcześniej.
+ *
+ * OpenGL 3.3 nie pozwala umieścić dwóch tekstur o różnych formatach w tej
+ * samej pamięci, dlatego aliasowanie polega na ponownym użyciu całego
+ * obiektu tekstury lub bufora o takim samym opisie.
+ */
+void RenderGraph::allocateResources() {
+    for (auto& resource : m_resources) {
+        resource.firstUse = -1;
+        resource.lastUse = -1;
+        resource.physicalIndex = -1;
+    }
+
+    for (int position = 0; position < static_cast<int>(m_executionOrder.size()); ++position) {
+        const PassNode& pass = m_passes[m_executionOrder[position]];
+        auto touch = [&](RenderResourceHandle handle) {
+            ResourceNode& resource = m_resources[handle];
+            if (resource.firstUse < 0) resource.firstUse = position;
+            resource.lastUse = position;
+        };
+        for (const auto& access : pass.reads) touch(access.resource);
+        for (const auto& access : pass.writes) touch(access.resource);
+    }
+
+    for (auto& physical : m_physical) {
+        physical.busyUntil = -1;
+        physical.usedThisFrame = false;
+    }
+
+    std::vector<RenderResourceHandle> transients;
+    for (size_t r = 0; r < m_resources.size(); ++r) {
+        if (!m_resources[r].imported && m_resources[r].firstUse >= 0) {
+            transients.push_back(static_cast<RenderResourceHandle>(r));
+        }
+    }
+    std::sort(transients.begin(), transients.end(), [this](RenderResourceHandle a, RenderResourceHandle b) {
+        return m_resources[a].firstUse < m_resources[b].firstUse;
+    });
+
+    m_virtualMemory = 0;
+    m_physicalMemory = 0;
+
+    for (RenderResourceHandle handle : transients) {
+        ResourceNode& resource = m_resources[handle];
+        size_t size = resource.type == RenderResourceType::TEXTURE
+            ? textureSize(resource.textureDesc)
+            : static_cast<size_t>(resource.bufferDesc.size);
+        m_virtualMemory += size;
+
+        int chosen = -1;
+        for (size_t i = 0; i < m_physical.size(); ++i) {
+            const PhysicalResource& physical = m_physical[i];
+            if (physical.type != resource.type) continue;
+            if (physical.busyUntil >= resource.firstUse) continue;
+
+            bool compatible = resource.type == RenderResourceType::TEXTURE
+                ? physical.textureDesc.width == resource.textureDesc.width &&
+                  physical.textureDesc.height == resource.textureDesc.height &&
+                  physical.textureDesc.internalFormat == resource.textureDesc.internalFormat
+                : physical.bufferDesc.size == resource.bufferDesc.size;
+            if (compatible) {
+                chosen = static_cast<int>(i);
+                break;
+            }
+        }
+
+        if (chosen < 0) {
+            PhysicalResource physical;
+            physical.type = resource.type;
+            physical.textureDesc = resource.textureDesc;
+            physical.bufferDesc = resource.bufferDesc;
+            physical.glObject = 0;
+            physical.busyUntil = -1;
+            physical.usedThisFrame = false;
+            physical.unusedFrames = 0;
+            createPhysical(physical);
+            m_physical.push_back(physical);
+            chosen = static_cast<int>(m_physical.size() - 1);
+        }
+
+        PhysicalResource& physical = m_physical[chosen];
+        if (!physical.usedThisFrame) {
+            m_physicalMemory += size;
+        }
+        physical.busyUntil = resource.lastUse;
+        physical.usedThisFrame = true;
+        physical.unusedFrames = 0;
+        resource.physicalIndex = chosen;
+        resource.glObject = physical.glObject;
+    }
+
+    // Zwolnij obiekty, które od dłuższego czasu nie są potrzebne
+    bool texturesReleased = false;
+    for (size_t i = 0; i < m_physical.size(); ) {
+        PhysicalResource& physical = m_physical[i];
+        if (!physical.usedThisFrame && ++physical.unusedFrames > MAX_UNUSED_FRAMES) {
+            if (physical.type == RenderResourceType::TEXTURE) {
+                glDeleteTextures(1, &physical.glObject);
+                texturesReleased = true;
+            } else {
+                glDeleteBuffers(1, &physical.glObject);
+            }
+            m_physical.erase(m_physical.begin() + i);
+            for (auto& resource : m_resources) {
+                if (resource.physicalIndex > static_cast<int>(i)) resource.physicalIndex--;
+            }
+        } else {
+            ++i;
+        }
+    }
+
+    // FBO mogłyby wskazywać na usunięte tekstury
+    if (texturesReleased) {
+        for (auto& entry : m_framebuffers) {
+            glDeleteFramebuffers(1, &entry.second);
+        }
+        m_framebuffers.clear();
+    }
+}
+
+/**
+ * @brief Kompiluje graf
+ * @return true jeśli kompilacja się powiodła
+ */
+bool RenderGraph::compile() {
+    cullPasses();
+    bool acyclic = sortPasses();
+    computeBarriers();
+    allocateResources();
+    m_compiled = true;
+    return acyclic;
+}
+
+/**
+ * @brief Wiąże FBO z załącznikami zapisywanymi przez przebieg
+ * @param pass Przebieg
+ *
+ * @details Przebieg zapisujący bufor ramki okna renderuje do FBO 0.
+ * Dla pozostałych zestawów załączników FBO tworzone jest raz i trzymane
+ * w pamięci podręcznej według identyfikatorów tekstur. Przebiegi bez
+ * załączników (np. obliczeniowe) nie zmieniają powiązanego FBO.
+ */
+void RenderGraph::bindFramebuffer(const PassNode& pass) {
+    std::vector<const ResourceNode*> colors;
+    const ResourceNode* depth = nullptr;
+
+    for (const auto& access : pass.writes) {
+        const ResourceNode& resource = m_resources[access.resource];
+        if (access.usage == RenderResourceUsage::COLOR_ATTACHMENT) {
+            colors.push_back(&resource);
+        } else if (access.usage == RenderResourceUsage::DEPTH_ATTACHMENT) {
+            depth = &resource;
+        }
+    }
+    if (colors.empty() && !depth) return;
+
+    const ResourceNode* first = colors.empty() ? depth : colors[0];
+    if (first->imported && first->glObject == 0) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, first->textureDesc.width, first->textureDesc.height);
+        return;
+    }
+
+    std::string key;
+    for (const ResourceNode* color : colors) {
+        key += "c" + std::to_string(color->glObject) + ";";
+    }
+    if (depth) {
+        key += "d" + std::to_string(depth->glObject);
+    }
+
+    auto it = m_framebuffers.find(key);
+    if (it != m_framebuffers.end()) {
+        glBindFramebuffer(GL_FRAMEBUFFER, it->second);
+    } else {
+        GLuint fbo = 0;
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+        std::vector<GLenum> drawBuffers;
+        for (size_t i = 0; i < colors.size(); ++i) {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i),
+                                   GL_TEXTURE_2D, colors[i]->glObject, 0);
+            drawBuffers.push_back(GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i));
+        }
+        if (depth) {
+            GLenum attachment = depth->textureDesc.internalFormat == GL_DEPTH24_STENCIL8
+                ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, depth->glObject, 0);
+        }
+        if (drawBuffers.empty()) {
+            glDrawBuffer(GL_NONE);
+        } else {
+            glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+        }
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "RenderGraph: Niekompletny framebuffer dla przebiegu " << pass.name << std::endl;
+        }
+        m_framebuffers[key] = fbo;
+    }
+
+    glViewport(0, 0, first->textureDesc.width, first->textureDesc.height);
+}
+
+/**
+ * @brief Wykonuje skompilowany graf i publikuje statystyki
+ *
+ * @details Przed każdym przebiegiem wydawane są wyliczone bariery pamięci
+ * (tylko gdy dostępne jest glMemoryBarrier, czyli OpenGL 4.2) i wiązane jest
+ * FBO. Czas każdego przebiegu mierzony jest zapytaniami GL_TIME_ELAPSED.
+ */
+void RenderGraph::execute() {
+    if (!m_compiled) {
+        compile();
+    }
+
+    bool memoryBarrierSupported = GLEW_VERSION_4_2 || GLEW_ARB_shader_image_load_store;
+    RenderPassResources resources(*this);
+
+    for (int p : m_executionOrder) {
+        const PassNode& pass = m_passes[p];
+
+        if (pass.barriers != 0 && memoryBarrierSupported) {
+            glMemoryBarrier(pass.barriers);
+        }
+        bindFramebuffer(pass);
+
+        m_gpuTimer.begin(pass.name);
+        if (pass.execute) {
+            pass.execute(resources);
+        }
+        m_gpuTimer.end();
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    m_gpuTimer.nextFrame();
+
+    RenderStats& stats = RenderStats::instance();
+    stats.clearPrefix("RenderGraph/");
+    stats.setValue("RenderGraph/Przebiegi", static_cast<double>(m_executionOrder.size()));
+    stats.setValue("RenderGraph/Usuniete przebiegi", static_cast<double>(getCulledPassCount()));
+    stats.setValue("RenderGraph/Obiekty w puli", static_cast<double>(m_physical.size()));
+    stats.setValue("RenderGraph/Pamiec tymczasowa [MB]", m_physicalMemory / (1024.0 * 1024.0));
+    stats.setValue("RenderGraph/Pamiec zaoszczedzona [MB]", getAliasingSavings() / (1024.0 * 1024.0));
+    for (int p : m_executionOrder) {
+        stats.setValue("RenderGraph/Czas GPU [ms]/" + m_passes[p].name, m_gpuTimer.getTimeMs(m_passes[p].name));
+    }
+}
+
+/**
+ * @brief Zwraca kolejność wykonania przebiegów
+ * @return Nazwy przebiegów w kolejności wykonania
+ */
+std::vector<std::string> RenderGraph::getExecutionOrder() const {
+    std::vector<std::string> names;
+    for (int p : m_executionOrder) {
+        names.push_back(m_passes[p].name);
+    }
+    return names;
+}
+
+/**
+ * @brief Zwraca liczbę usuniętych przebiegów
+ * @return Liczba przebiegów, których wyniki nie były używane
+ */
+int RenderGraph::getCulledPassCount() const {
+    int count = 0;
+    for (const auto& pass : m_passes) {
+        if (pass.culled) count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Zwraca łączny czas GPU przebiegów ostatnio wykonanego grafu
+ * @return Czas w milisekundach
+ */
+double RenderGraph::getTotalGpuTimeMs() const {
+    double total = 0.0;
+    for (int p : m_executionOrder) {
+        total += m_gpuTimer.getTimeMs(m_passes[p].name);
+    }
+    return total;
+}
+
+/**
+ * @brief Zwalnia wszystkie obiekty OpenGL puli
+ */
+void RenderGraph::release() {
+    for (auto& entry : m_framebuffers) {
+        glDeleteFramebuffers(1, &entry.second);
+    }
+    m_framebuffers.clear();
+
+    for (auto& physical : m_physical) {
+        if (physical.type == RenderResourceType::TEXTURE) {
+            glDeleteTextures(1, &physical.glObject);
+        } else {
+            glDeleteBuffers(1, &physical.glObject);
+        }
+    }
+    m_physical.clear();
+
+    for (auto& resource : m_resources) {
+        if (!resource.imported) resource.glObject = 0;
+    }
+    m_gpuTimer.release();
+}
@@ -0,0 +1,422 @@
+// RenderGraph.hpp
+#ifndef RENDER_GRAPH_HPP
+#define RENDER_GRAPH_HPP
+
+#include <GL/glew.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <map>
+#include "../Stats/GpuTimer.hpp"
+
+/**
+ * @brief Uchwyt zasobu grafu renderowania (indeks zasobu w bieżącej klatce)
+ */
+typedef int RenderResourceHandle;
+
+/**
+ * @brief Wartość oznaczająca nieprawidłowy uchwyt zasobu
+ */
+const RenderResourceHandle INVALID_RENDER_RESOURCE = -1;
+
+/**
+ * @enum RenderResourceType
+ * @brief Rodzaj zasobu zarządzanego przez graf renderowania
+ */
+enum class RenderResourceType {
+    TEXTURE,    /**< Tekstura 2D (cel renderowania, bufor głębokości) */
+    BUFFER      /**< Bufor OpenGL (SSBO, UBO, bufor wierzchołków) */
+};
+
+/**
+ * @enum RenderResourceUsage
+ * @brief Sposób użycia zasobu przez przebieg
+ *
+ * Na podstawie par zapis -> odczyt wyznaczane są bariery pamięci.
+ */
+enum class RenderResourceUsage {
+    SAMPLED,            /**< Odczyt tekstury przez sampler */
+    COLOR_ATTACHMENT,   /**< Zapis jako załącznik koloru FBO */
+    DEPTH_ATTACHMENT,   /**< Zapis jako załącznik głębokości FBO */
+    IMAGE_LOAD,         /**< Odczyt przez imageLoad */
+    IMAGE_STORE,        /**< Zapis przez imageStore */
+    STORAGE_READ,       /**< Odczyt bufora SSBO */
+    STORAGE_WRITE,      /**< Zapis bufora SSBO */
+    UNIFORM,            /**< Odczyt jako bufor uniformów */
+    VERTEX,             /**< Odczyt jako bufor wierzchołków */
+    INDEX,              /**< Odczyt jako bufor indeksów */
+    INDIRECT,           /**< Odczyt jako bufor komend pośrednich */
+    TRANSFER            /**< Kopiowanie / aktualizacja z CPU */
+};
+
+/**
+ * @struct RenderTextureDesc
+ * @brief Opis tekstury zarządzanej przez graf
+ */
+struct RenderTextureDesc {
+    int width;              /**< Szerokość w pikselach */
+    int height;             /**< Wysokość w pikselach */
+    GLenum internalFormat;  /**< Format wewnętrzny (GL_RGBA8, GL_DEPTH_COMPONENT24 itp.) */
+};
+
+/**
+ * @struct RenderBufferDesc
+ * @brief Opis bufora zarządzanego przez graf
+ */
+struct RenderBufferDesc {
+    GLsizeiptr size;        /**< Rozmiar w bajtach */
+};
+
+class RenderGraph;
+
+/**
+ * @class RenderPassBuilder
+ * @brief Interfejs deklarowania zasobów używanych przez przebieg
+ *
+ * Przekazywany do funkcji konfiguracji przebiegu. Przebieg deklaruje tu
+ * tworzone zasoby tymczasowe oraz wszystkie odczyty i zapisy.
+ */
+class RenderPassBuilder {
+private:
+    RenderGraph& m_graph;   /**< Graf, do którego należy przebieg */
+    int m_passIndex;        /**< Indeks konfigurowanego przebiegu */
+
+public:
+    /**
+     * @brief Konstruktor RenderPassBuilder
+     * @param graph Graf renderowania
+     * @param passIndex Indeks przebiegu
+     */
+    RenderPassBuilder(RenderGraph& graph, int passIndex);
+
+    /**
+     * @brief Tworzy teksturę tymczasową żyjącą tylko w bieżącej klatce
+     * @param name Nazwa tekstury
+     * @param desc Opis tekstury
+     * @return Uchwyt nowej tekstury
+     */
+    RenderResourceHandle createTexture(const std::string& name, const RenderTextureDesc& desc);
+
+    /**
+     * @brief Tworzy bufor tymczasowy żyjący tylko w bieżącej klatce
+     * @param name Nazwa bufora
+     * @param desc Opis bufora
+     * @return Uchwyt nowego bufora
+     */
+    RenderResourceHandle createBuffer(const std::string& name, const RenderBufferDesc& desc);
+
+    /**
+     * @brief Deklaruje odczyt zasobu
+     * @param resource Uchwyt zasobu
+     * @param usage Sposób odczytu (domyślnie próbkowanie tekstury)
+     * @return Uchwyt zasobu
+     */
+    RenderResourceHandle read(RenderResourceHandle resource,
+                              RenderResourceUsage usage = RenderResourceUsage::SAMPLED);
+
+    /**
+     * @brief Deklaruje zapis zasobu
+     * @param resource Uchwyt zasobu
+     * @param usage Sposób zapisu (domyślnie załącznik koloru)
+     * @return Uchwyt zasobu
+     */
+    RenderResourceHandle write(RenderResourceHandle resource,
+                               RenderResourceUsage usage = RenderResourceUsage::COLOR_ATTACHMENT);
+
+    /**
+     * @brief Oznacza przebieg jako posiadający efekty uboczne
+     *
+     * Takie przebiegi nigdy nie są usuwane (np. odczyt do CPU, picking).
+     */
+    void setSideEffect();
+};
+
+/**
+ * @class RenderPassResources
+ * @brief Dostęp do fizycznych zasobów OpenGL podczas wykonywania przebiegu
+ */
+class RenderPassResources {
+private:
+    const RenderGraph& m_graph; /**< Graf renderowania */
+
+public:
+    /**
+     * @brief Konstruktor RenderPassResources
+     * @param graph Graf renderowania
+     */
+    explicit RenderPassResources(const RenderGraph& graph) : m_graph(graph) {}
+
+    /**
+     * @brief Zwraca identyfikator tekstury OpenGL
+     * @param resource Uchwyt zasobu
+     * @return ID tekstury (0 dla bufora ramki okna)
+     */
+    GLuint getTexture(RenderResourceHandle resource) const;
+
+    /**
+     * @brief Zwraca identyfikator bufora OpenGL
+     * @param resource Uchwyt zasobu
+     * @return ID bufora
+     */
+    GLuint getBuffer(RenderResourceHandle resource) const;
+
+    /**
+     * @brief Zwraca opis tekstury
+     * @param resource Uchwyt zasobu
+     * @return Opis tekstury
+     */
+    const RenderTextureDesc& getTextureDesc(RenderResourceHandle resource) const;
+};
+
+/**
+ * @class RenderGraph
+ * @brief Graf renderowania z usuwaniem zbędnych przebiegów i aliasowaniem zasobów
+ *
+ * Graf budowany jest od nowa w każdej klatce. Przebiegi deklarują odczyty
+ * i zapisy tekstur oraz buforów, a kompilacja grafu:
+ * - usuwa przebiegi, których wyniki nie są nigdzie używane,
+ * - ustala kolejność wykonania na podstawie zależności,
+ * - wyznacza bariery pamięci pomiędzy zapisem a odczytem,
+ * - przydziela zasobom tymczasowym fizyczne obiekty OpenGL, współdzieląc je
+ *   pomiędzy zasobami o rozłącznych czasach życia.
+ *
+ * Fizyczne obiekty trzymane są w puli pomiędzy klatkami, więc w stanie
+ * ustalonym graf nie tworzy nowych obiektów OpenGL.
+ */
+class RenderGraph {
+public:
+    /**
+     * @brief Funkcja konfiguracji przebiegu (deklaracja zasobów)
+     */
+    typedef std::function<void(RenderPassBuilder&)> SetupFunction;
+
+    /**
+     * @brief Funkcja wykonania przebiegu (polecenia OpenGL)
+     */
+    typedef std::function<void(const RenderPassResources&)> ExecuteFunction;
+
+private:
+    /**
+     * @struct ResourceAccess
+     * @brief Pojedynczy odczyt lub zapis zasobu przez przebieg
+     */
+    struct ResourceAccess {
+        RenderResourceHandle resource;  /**< Uchwyt zasobu */
+        RenderResourceUsage usage;      /**< Sposób użycia */
+    };
+
+    /**
+     * @struct PassNode
+     * @brief Węzeł przebiegu w grafie
+     */
+    struct PassNode {
+        std::string name;                   /**< Nazwa przebiegu */
+        ExecuteFunction execute;            /**< Funkcja wykonania */
+        std::vector<ResourceAccess> reads;  /**< Odczytywane zasoby */
+        std::vector<ResourceAccess> writes; /**< Zapisywane zasoby */
+        std::vector<RenderResourceHandle> creates; /**< Tworzone zasoby tymczasowe */
+        bool sideEffect;                    /**< Czy przebieg ma efekty uboczne */
+        bool culled;                        /**< Czy przebieg został usunięty */
+        int refCount;                       /**< Licznik referencji używany przy usuwaniu */
+        GLbitfield barriers;                /**< Bariery pamięci przed wykonaniem */
+    };
+
+    /**
+     * @struct ResourceNode
+     * @brief Węzeł zasobu w grafie
+     */
+    struct ResourceNode {
+        std::string name;           /**< Nazwa zasobu */
+        RenderResourceType type;    /**< Rodzaj zasobu */
+        RenderTextureDesc textureDesc; /**< Opis tekstury */
+        RenderBufferDesc bufferDesc;   /**< Opis bufora */
+        bool imported;              /**< Czy zasób pochodzi spoza grafu */
+        bool output;                /**< Czy zasób jest wynikiem grafu */
+        GLuint glObject;            /**< Fizyczny obiekt OpenGL */
+        int physicalIndex;          /**< Indeks w puli obiektów fizycznych (-1 dla importowanych) */
+        int refCount;               /**< Liczba przebiegów czytających zasób */
+        int firstUse;               /**< Pierwsza pozycja użycia w kolejności wykonania */
+        int lastUse;                /**< Ostatnia pozycja użycia w kolejności wykonania */
+    };
+
+    /**
+     * @struct PhysicalResource
+     * @brief Fizyczny obiekt OpenGL w puli współdzielonej pomiędzy klatkami
+     */
+    struct PhysicalResource {
+        RenderResourceType type;    /**< Rodzaj zasobu */
+        RenderTextureDesc textureDesc; /**< Opis tekstury */
+        RenderBufferDesc bufferDesc;   /**< Opis bufora */
+        GLuint glObject;            /**< Obiekt OpenGL (0 przed pierwszym użyciem) */
+        int busyUntil;              /**< Ostatnia pozycja użycia w bieżącej klatce (-1 = wolny) */
+        bool usedThisFrame;         /**< Czy obiekt został przydzielony w bieżącej klatce */
+        int unusedFrames;           /**< Liczba kolejnych klatek bez użycia */
+    };
+
+    static const int MAX_UNUSED_FRAMES = 120; /**< Po tylu klatkach bez użycia obiekt jest zwalniany */
+
+    std::vector<PassNode> m_passes;                 /**< Przebiegi bieżącej klatki */
+    std::vector<ResourceNode> m_resources;          /**< Zasoby bieżącej klatki */
+    std::vector<int> m_executionOrder;              /**< Kolejność wykonania przebiegów */
+    std::vector<PhysicalResource> m_physical;       /**< Pula obiektów fizycznych */
+    std::map<std::string, GLuint> m_framebuffers;   /**< Pamięć podręczna FBO według zestawu załączników */
+    bool m_compiled;                                /**< Czy graf został skompilowany */
+    GpuTimer m_gpuTimer;                            /**< Pomiar czasu przebiegów na GPU */
+
+    size_t m_virtualMemory;     /**< Suma rozmiarów zasobów tymczasowych bez aliasowania */
+    size_t m_physicalMemory;    /**< Suma rozmiarów obiektów fizycznych użytych w klatce */
+
+    friend class RenderPassBuilder;
+    friend class RenderPassResources;
+
+    /**
+     * @brief Dodaje węzeł zasobu
+     * @param name Nazwa zasobu
+     * @param type Rodzaj zasobu
+     * @return Uchwyt nowego zasobu
+     */
+    RenderResourceHandle addResource(const std::string& name, RenderResourceType type);
+
+    /**
+     * @brief Usuwa przebiegi, których wyniki nie są używane
+     */
+    void cullPasses();
+
+    /**
+     * @brief Sortuje topologicznie przebiegi, które pozostały po usuwaniu
+     * @return true jeśli graf jest acykliczny
+     */
+    bool sortPasses();
+
+    /**
+     * @brief Wyznacza bariery pamięci dla przebiegów
+     */
+    void computeBarriers();
+
+    /**
+     * @brief Przydziela obiekty fizyczne zasobom tymczasowym
+     */
+    void allocateResources();
+
+    /**
+     * @brief Tworzy obiekt OpenGL dla fizycznego zasobu
+     * @param resource Fizyczny zasób
+     */
+    void createPhysical(PhysicalResource& resource);
+
+    /**
+     * @brief Wiąże FBO z załącznikami zapisywanymi przez przebieg
+     * @param pass Przebieg
+     */
+    void bindFramebuffer(const PassNode& pass);
+
+public:
+    /**
+     * @brief Konstruktor RenderGraph
+     */
+    RenderGraph();
+
+    /**
+     * @brief Destruktor RenderGraph
+     *
+     * Zwalnia pulę tekstur, buforów i FBO
+     */
+    ~RenderGraph();
+
+    /**
+     * @brief Czyści graf przed budową nowej klatki
+     *
+     * Pula obiektów fizycznych jest zachowywana.
+     */
+    void reset();
+
+    /**
+     * @brief Importuje istniejącą teksturę OpenGL
+     * @param name Nazwa zasobu
+     * @param texture ID tekstury
+     * @param desc Opis tekstury
+     * @return Uchwyt zasobu
+     */
+    RenderResourceHandle importTexture(const std::string& name, GLuint texture, const RenderTextureDesc& desc);
+
+    /**
+     * @brief Importuje domyślny bufor ramki okna
+     * @param name Nazwa zasobu
+     * @param width Szerokość bufora ramki
+     * @param height Wysokość bufora ramki
+     * @return Uchwyt zasobu (automatycznie oznaczony jako wynik grafu)
+     */
+    RenderResourceHandle importBackbuffer(const std::string& name, int width, int height);
+
+    /**
+     * @brief Importuje istniejący bufor OpenGL
+     * @param name Nazwa zasobu
+     * @param buffer ID bufora
+     * @param size Rozmiar bufora w bajtach
+     * @return Uchwyt zasobu
+     */
+    RenderResourceHandle importBuffer(const std::string& name, GLuint buffer, GLsizeiptr size);
+
+    /**
+     * @brief Oznacza zasób jako wynik grafu (chroni go przed usunięciem)
+     * @param resource Uchwyt zasobu
+     */
+    void markOutput(RenderResourceHandle resource);
+
+    /**
+     * @brief Dodaje przebieg do grafu
+     * @param name Nazwa przebiegu
+     * @param setup Funkcja deklarująca zasoby przebiegu
+     * @param execute Funkcja wykonująca polecenia OpenGL
+     */
+    void addPass(const std::string& name, const SetupFunction& setup, const ExecuteFunction& execute);
+
+    /**
+     * @brief Kompiluje graf (usuwanie, sortowanie, bariery, aliasowanie)
+     * @return true jeśli kompilacja się powiodła
+     */
+    bool compile();
+
+    /**
+     * @brief Wykonuje skompilowany graf i publikuje statystyki
+     */
+    void execute();
+
+    /**
+     * @brief Zwraca kolejność wykonania przebiegów
+     * @return Nazwy przebiegów w kolejności wykonania
+     */
+    std::vector<std::string> getExecutionOrder() const;
+
+    /**
+     * @brief Zwraca liczbę usuniętych przebiegów
+     * @return Liczba przebiegów, których wyniki nie były używane
+     */
+    int getCulledPassCount() const;
+
+    /**
+     * @brief Zwraca łączny czas GPU przebiegów ostatnio wykonanego grafu
+     * @return Czas w milisekundach (z opóźnieniem kilku klatek)
+     */
+    double getTotalGpuTimeMs() const;
+
+    /**
+     * @brief Zwraca pamięć zaoszczędzoną dzięki aliasowaniu
+     * @return Liczba bajtów
+     */
+    size_t getAliasingSavings() const { return m_virtualMemory - m_physicalMemory; }
+
+    /**
+     * @brief Zwalnia wszystkie obiekty OpenGL puli
+     */
+    void release();
+
+    /**
+     * @brief Zwraca rozmiar tekstury w bajtach
+     * @param desc Opis tekstury
+     * @return Rozmiar w bajtach
+     */
+    static size_t textureSize(const RenderTextureDesc& desc);
+};
+
+#endif // RENDER_GRAPH_HPP
@@ -113,6 +113,27 @@ ComplexObjectWithTransform* SceneManager::createLetterH(const std::string& name,
     return result;
 }
 
+/**
+ * @brief Creates a plane object with specified parameters.
+ */
+TransformableObject* SceneManager::createPlane(const std::string& name,
+                                               const glm::vec3& position,
+                                               const glm::vec2& size,
+                                               const glm::vec3& color) {
+    auto plane = std::make_unique<PlaneObject>(color);
+    plane->setPosition(position);
+    plane->setScale(glm::vec3(size.x, 1.0f, size.y));
+    plane->setRenderer(m_renderer);
+
+    std::string objName = name.empty() ? generateUniqueName("Plane") : name;
+
+    TransformableObject* result = plane.get();
+    m_objects.push_back(std::move(plane));
+    m_namedObjects[objName] = result;
+
+    return result;
+}
+
 /**
  * @brief Retrieves object by name.
  */
@@ -102,6 +102,19 @@ public:
                                              float depth = 0.5f,
                                              const glm::vec3& color = glm::vec3(0.9f, 0.2f, 0.2f));
 
+    /**
+     * @brief Creates a plane object (e.g. a floor).
+     * @param name Optional name for the object (default: auto-generated)
+     * @param position Initial position (default: (0,0,0))
+     * @param size Plane size along X and Z (default: (1,1))
+     * @param color RGB color (default: gray)
+     * @return Pointer to the created TransformableObject
+     */
+    TransformableObject* createPlane(const std::string& name = "",
+                                     const glm::vec3& position = glm::vec3(0.0f),
+                                     const glm::vec2& size = glm::vec2(1.0f),
+                                     const glm::vec3& color = glm::vec3(0.3f, 0.3f, 0.3f));
+
     // Object retrieval methods
 
     /**
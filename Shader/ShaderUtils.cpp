@@ -0,0 +1,80 @@
+// ShaderUtils.cpp
+#include "ShaderUtils.hpp"
+#include <iostream>
+
+/**
+ * @brief Kompiluje shader
+ * @param type Typ shadera
+ * @param source Kod źródłowy
+ * @param label Etykieta do komunikatu o błędzie
+ * @return ID shadera lub 0 w przypadku błędu
+ */
+GLuint ShaderUtils::compileShader(GLenum type, const char* source, const char* label) {
+    return compileShader(type, &source, 1, label);
+}
+
+/**
+ * @brief Kompiluje shader złożony z kilku fragmentów
+ * @param type Typ shadera
+ * @param sources Fragmenty kodu źródłowego
+ * @param count Liczba fragmentów
+ * @param label Etykieta do komunikatu o błędzie
+ * @return ID shadera lub 0 w przypadku błędu
+ *
+ * @details Shader, który się nie skompilował, jest usuwany, więc wywołujący
+ * sprawdza tylko wynik 0.
+ */
+GLuint ShaderUtils::compileShader(GLenum type, const char* const* sources, GLsizei count, const char* label) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, count, sources, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    GLchar infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "Blad kompilacji shadera " << label << ":\n" << infoLog << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+/**
+ * @brief Linkuje program z vertex i fragment shadera
+ * @param vertexShader Vertex shader z compileShader (0 = błąd kompilacji)
+ * @param fragmentShader Fragment shader z compileShader (0 = błąd kompilacji)
+ * @param label Etykieta do komunikatu o błędzie
+ * @return ID programu lub 0 w przypadku błędu
+ *
+ * @details Przyjmowanie wyników compileShader bez sprawdzania pozwala
+ * wywołującemu skompilować oba shadery i obsłużyć każdy błąd jednym
+ * sprawdzeniem wyniku. Shadery są usuwane także po udanym linkowaniu -
+ * program zachowuje je do czasu swojego usunięcia.
+ */
+GLuint ShaderUtils::linkProgram(GLuint vertexShader, GLuint fragmentShader, const char* label) {
+    if (!vertexShader || !fragmentShader) {
+        if (vertexShader) glDeleteShader(vertexShader);
+        if (fragmentShader) glDeleteShader(fragmentShader);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Blad linkowania shadera " << label << ":\n" << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
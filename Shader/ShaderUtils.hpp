@@ -0,0 +1,49 @@
+// ShaderUtils.hpp
+#ifndef SHADER_UTILS_HPP
+#define SHADER_UTILS_HPP
+
+#include <GL/glew.h>
+
+/**
+ * @namespace ShaderUtils
+ * @brief Kompilacja i linkowanie shaderów wspólne dla rendererów
+ *
+ * Błędy wypisywane są jako "Blad kompilacji shadera <etykieta>" lub
+ * "Blad linkowania shadera <etykieta>", gdzie etykieta wskazuje renderer
+ * (np. "terenu", "czasteczek").
+ */
+namespace ShaderUtils {
+
+/**
+ * @brief Kompiluje shader
+ * @param type Typ shadera
+ * @param source Kod źródłowy
+ * @param label Etykieta do komunikatu o błędzie
+ * @return ID shadera lub 0 w przypadku błędu
+ */
+GLuint compileShader(GLenum type, const char* source, const char* label);
+
+/**
+ * @brief Kompiluje shader złożony z kilku fragmentów
+ * @param type Typ shadera
+ * @param sources Fragmenty kodu źródłowego
+ * @param count Liczba fragmentów
+ * @param label Etykieta do komunikatu o błędzie
+ * @return ID shadera lub 0 w przypadku błędu
+ */
+GLuint compileShader(GLenum type, const char* const* sources, GLsizei count, const char* label);
+
+/**
+ * @brief Linkuje program z vertex i fragment shadera
+ * @param vertexShader Vertex shader z compileShader (0 = błąd kompilacji)
+ * @param fragmentShader Fragment shader z compileShader (0 = błąd kompilacji)
+ * @param label Etykieta do komunikatu o błędzie
+ * @return ID programu lub 0 w przypadku błędu
+ *
+ * Oba shadery są usuwane niezależnie od wyniku.
+ */
+GLuint linkProgram(GLuint vertexShader, GLuint fragmentShader, const char* label);
+
+} // namespace ShaderUtils
+
+#endif // SHADER_UTILS_HPP
@@ -0,0 +1,145 @@
+// GpuTimer.cpp
+#include "GpuTimer.hpp"
+#include <iostream>
+
+/**
+ * @brief Konstruktor GpuTimer
+ */
+GpuTimer::GpuTimer() : m_frameIndex(0), m_active(false) {
+}
+
+/**
+ * @brief Destruktor GpuTimer
+ */
+GpuTimer::~GpuTimer() {
+    release();
+}
+
+/**
+ * @brief Odczytuje wynik zapytania jeśli jest dostępny
+ * @param scope Zakres
+ * @param slot Indeks zapytania w pierścieniu
+ */
+void GpuTimer::collect(Scope& scope, int slot) {
+    if (!scope.pending[slot]) return;
+
+    GLint available = 0;
+    glGetQueryObjectiv(scope.queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(scope.queries[slot], GL_QUERY_RESULT, &elapsed);
+    scope.lastTimeMs = static_cast<double>(elapsed) / 1000000.0;
+    scope.pending[slot] = false;
+}
+
+/**
+ * @brief Rozpoczyna pomiar nazwanego zakresu
+ * @param name Nazwa zakresu
+ *
+ * @details Przy pierwszym użyciu nazwy tworzony jest pierścień zapytań.
+ * Wynik zapytania sprzed QUERY_LATENCY klatek jest odczytywany przed
+ * ponownym użyciem obiektu zapytania.
+ *
+ * Każdy zakres ma jedno zapytanie na klatkę, więc drugie otwarcie tej
+ * samej nazwy w klatce nadpisałoby pierwsze. Takie otwarcie jest pomijane
+ * (czas obejmuje tylko pierwsze wystąpienie), a błąd zgłaszany jest raz.
+ */
+void GpuTimer::begin(const std::string& name) {
+    if (m_active) end();
+
+    auto it = m_scopes.find(name);
+    if (it == m_scopes.end()) {
+        Scope scope;
+        glGenQueries(QUERY_LATENCY, scope.queries);
+        for (int i = 0; i < QUERY_LATENCY; ++i) {
+            scope.pending[i] = false;
+        }
+        scope.lastTimeMs = 0.0;
+        scope.lastFrame = 0;
+        scope.used = false;
+        scope.reported = false;
+        it = m_scopes.emplace(name, scope).first;
+    }
+
+    Scope& scope = it->second;
+    if (scope.used && scope.lastFrame == m_frameIndex) {
+        if (!scope.reported) {
+            std::cerr << "Blad: Zakres GPU \"" << name << "\" otwarty wiecej niz raz w klatce - "
+                      << "pomiar kolejnych wystapien pominiety" << std::endl;
+            scope.reported = true;
+        }
+        return;
+    }
+    scope.lastFrame = m_frameIndex;
+    scope.used = true;
+
+    int slot = m_frameIndex % QUERY_LATENCY;
+    collect(scope, slot);
+
+    glBeginQuery(GL_TIME_ELAPSED, scope.queries[slot]);
+    scope.pending[slot] = true;
+    m_active = true;
+}
+
+/**
+ * @brief Kończy pomiar aktualnego zakresu
+ */
+void GpuTimer::end() {
+    if (!m_active) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_active = false;
+}
+
+/**
+ * @brief Przechodzi do następnej klatki
+ *
+ * @details Odczytuje wszystkie dostępne wyniki, tak aby czasy były aktualne
+ * także dla zakresów, które w danej klatce nie zostały użyte.
+ */
+void GpuTimer::nextFrame() {
+    if (m_active) end();
+
+    for (auto& entry : m_scopes) {
+        for (int i = 0; i < QUERY_LATENCY; ++i) {
+            collect(entry.second, i);
+        }
+    }
+    ++m_frameIndex;
+}
+
+/**
+ * @brief Zwraca ostatni zmierzony czas zakresu
+ * @param name Nazwa zakresu
+ * @return Czas w milisekundach lub 0 jeśli brak pomiaru
+ */
+double GpuTimer::getTimeMs(const std::string& name) const {
+    auto it = m_scopes.find(name);
+    if (it != m_scopes.end()) {
+        return it->second.lastTimeMs;
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Zwraca wszystkie zmierzone czasy
+ * @return Mapa nazwa zakresu -> czas w milisekundach
+ */
+std::map<std::string, double> GpuTimer::getTimesMs() const {
+    std::map<std::string, double> result;
+    for (const auto& entry : m_scopes) {
+        result[entry.first] = entry.second.lastTimeMs;
+    }
+    return result;
+}
+
+/**
+ * @brief Zwalnia wszystkie zapytania
+ */
+void GpuTimer::release() {
+    if (m_active) end();
+    for (auto& entry : m_scopes) {
+        glDeleteQueries(QUERY_LATENCY, entry.second.queries);
+    }
+    m_scopes.clear();
+}
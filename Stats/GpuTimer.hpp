@@ -0,0 +1,100 @@
+// GpuTimer.hpp
+#ifndef GPU_TIMER_HPP
+#define GPU_TIMER_HPP
+
+#include <GL/glew.h>
+#include <map>
+#include <string>
+
+/**
+ * @class GpuTimer
+ * @brief Pomiar czasu wykonania fragmentów klatki na GPU
+ *
+ * Wykorzystuje zapytania GL_TIME_ELAPSED. Każdy nazwany zakres posiada
+ * pierścień kilku zapytań, dzięki czemu wynik odczytywany jest z opóźnieniem
+ * kilku klatek i nie blokuje potoku w oczekiwaniu na GPU.
+ *
+ * @note Zapytania GL_TIME_ELAPSED nie mogą być zagnieżdżane - w danej chwili
+ * aktywny może być tylko jeden zakres. Nazwa może zostać otwarta raz na
+ * klatkę; kolejne otwarcia tej samej nazwy w klatce są pomijane.
+ */
+class GpuTimer {
+public:
+    static const int QUERY_LATENCY = 4; /**< Liczba klatek opóźnienia odczytu wyników */
+
+private:
+    /**
+     * @struct Scope
+     * @brief Pierścień zapytań dla jednego nazwanego zakresu
+     */
+    struct Scope {
+        GLuint queries[QUERY_LATENCY];  /**< Obiekty zapytań OpenGL */
+        bool pending[QUERY_LATENCY];    /**< Czy zapytanie czeka na odczyt */
+        double lastTimeMs;              /**< Ostatni odczytany czas w milisekundach */
+        unsigned int lastFrame;         /**< Klatka ostatniego otwarcia */
+        bool used;                      /**< Czy zakres był już otwierany */
+        bool reported;                  /**< Czy zgłoszono powtórne otwarcie w klatce */
+    };
+
+    std::map<std::string, Scope> m_scopes; /**< Zakresy według nazwy */
+    unsigned int m_frameIndex;             /**< Numer aktualnej klatki */
+    bool m_active;                         /**< Czy zakres jest aktualnie otwarty */
+
+    /**
+     * @brief Odczytuje wynik zapytania jeśli jest dostępny
+     * @param scope Zakres
+     * @param slot Indeks zapytania w pierścieniu
+     */
+    void collect(Scope& scope, int slot);
+
+public:
+    /**
+     * @brief Konstruktor GpuTimer
+     */
+    GpuTimer();
+
+    /**
+     * @brief Destruktor GpuTimer
+     *
+     * Zwalnia obiekty zapytań OpenGL
+     */
+    ~GpuTimer();
+
+    /**
+     * @brief Rozpoczyna pomiar nazwanego zakresu
+     * @param name Nazwa zakresu
+     */
+    void begin(const std::string& name);
+
+    /**
+     * @brief Kończy pomiar aktualnego zakresu
+     */
+    void end();
+
+    /**
+     * @brief Przechodzi do następnej klatki
+     *
+     * Wywoływane raz na klatkę, po zakończeniu wszystkich pomiarów.
+     */
+    void nextFrame();
+
+    /**
+     * @brief Zwraca ostatni zmierzony czas zakresu
+     * @param name Nazwa zakresu
+     * @return Czas w milisekundach lub 0 jeśli brak pomiaru
+     */
+    double getTimeMs(const std::string& name) const;
+
+    /**
+     * @brief Zwraca wszystkie zmierzone czasy
+     * @return Mapa nazwa zakresu -> czas w milisekundach
+     */
+    std::map<std::string, double> getTimesMs() const;
+
+    /**
+     * @brief Zwalnia wszystkie zapytania
+     */
+    void release();
+};
+
+#endif // GPU_TIMER_HPP
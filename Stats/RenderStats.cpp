@@ -0,0 +1,70 @@
+// RenderStats.cpp
+#include "RenderStats.hpp"
+#include <iomanip>
+
+/**
+ * @brief Zwraca globalną instancję rejestru statystyk
+ * @return Referencja do rejestru statystyk
+ */
+RenderStats& RenderStats::instance() {
+    static RenderStats stats;
+    return stats;
+}
+
+/**
+ * @brief Ustawia wartość statystyki
+ * @param name Nazwa statystyki
+ * @param value Nowa wartość
+ */
+void RenderStats::setValue(const std::string& name, double value) {
+    m_values[name] = value;
+}
+
+/**
+ * @brief Dodaje wartość do statystyki
+ * @param name Nazwa statystyki
+ * @param delta Wartość do dodania
+ */
+void RenderStats::addValue(const std::string& name, double delta) {
+    m_values[name] += delta;
+}
+
+/**
+ * @brief Zwraca wartość statystyki
+ * @param name Nazwa statystyki
+ * @return Wartość statystyki lub 0 jeśli nie istnieje
+ */
+double RenderStats::getValue(const std::string& name) const {
+    auto it = m_values.find(name);
+    if (it != m_values.end()) {
+        return it->second;
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Usuwa wszystkie statystyki o podanym prefiksie
+ * @param prefix Prefiks nazwy
+ */
+void RenderStats::clearPrefix(const std::string& prefix) {
+    auto it = m_values.lower_bound(prefix);
+    while (it != m_values.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+        it = m_values.erase(it);
+    }
+}
+
+/**
+ * @brief Wypisuje wszystkie statystyki
+ * @param out Strumień wyjściowy
+ *
+ * @details Statystyki są wypisywane w kolejności alfabetycznej, więc wartości
+ * jednego podsystemu znajdują się obok siebie.
+ */
+void RenderStats::print(std::ostream& out) const {
+    out << "\n=== STATYSTYKI RENDEROWANIA ===" << std::endl;
+    for (const auto& entry : m_values) {
+        out << std::left << std::setw(48) << entry.first << " "
+            << std::fixed << std::setprecision(3) << entry.second << std::endl;
+    }
+    out << "===============================" << std::endl;
+}
@@ -0,0 +1,69 @@
+// RenderStats.hpp
+#ifndef RENDER_STATS_HPP
+#define RENDER_STATS_HPP
+
+#include <map>
+#include <string>
+#include <ostream>
+
+/**
+ * @class RenderStats
+ * @brief Rejestr statystyk renderowania zbieranych w trakcie klatki
+ *
+ * Przechowuje nazwane wartości liczbowe (czasy przebiegów, liczby wywołań
+ * rysowania, zużycie pamięci itp.) publikowane przez poszczególne podsystemy.
+ * Nazwy mają postać "Podsystem/Wartość", dzięki czemu wypisane statystyki
+ * są pogrupowane według podsystemu.
+ */
+class RenderStats {
+private:
+    std::map<std::string, double> m_values; /**< Wartości statystyk posortowane według nazwy */
+
+public:
+    /**
+     * @brief Zwraca globalną instancję rejestru statystyk
+     * @return Referencja do rejestru statystyk
+     */
+    static RenderStats& instance();
+
+    /**
+     * @brief Ustawia wartość statystyki
+     * @param name Nazwa statystyki (np. "RenderGraph/Przebiegi")
+     * @param value Nowa wartość
+     */
+    void setValue(const std::string& name, double value);
+
+    /**
+     * @brief Dodaje wartość do statystyki
+     * @param name Nazwa statystyki
+     * @param delta Wartość do dodania
+     */
+    void addValue(const std::string& name, double delta);
+
+    /**
+     * @brief Zwraca wartość statystyki
+     * @param name Nazwa statystyki
+     * @return Wartość statystyki lub 0 jeśli nie istnieje
+     */
+    double getValue(const std::string& name) const;
+
+    /**
+     * @brief Zwraca wszystkie statystyki
+     * @return Mapa nazwa -> wartość
+     */
+    const std::map<std::string, double>& getValues() const { return m_values; }
+
+    /**
+     * @brief Usuwa wszystkie statystyki o podanym prefiksie
+     * @param prefix Prefiks nazwy (np. "RenderGraph/")
+     */
+    void clearPrefix(const std::string& prefix);
+
+    /**
+     * @brief Wypisuje wszystkie statystyki
+     * @param out Strumień wyjściowy
+     */
+    void print(std::ostream& out) const;
+};
+
+#endif // RENDER_STATS_HPP
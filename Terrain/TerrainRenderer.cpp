@@ -0,0 +1,763 @@
+// TerrainRenderer.cpp
+#include "TerrainRenderer.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+
+/**
+ * @brief Vertex shader terenu: wspólna siatka przesunięta o wysokość z kafelka
+ *
+ * Wierzchołek siatki wynika z gl_VertexID. Pod koniec zasięgu poziomu
+ * wierzchołki nieparzyste przesuwane są na sąsiednie parzyste (siatka
+ * rodzica), zanim zostanie odczytana ich wysokość.
+ */
+static const char* terrainVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec4 aNode;    // xy = narożnik obszaru, z = bok węzła, w = poziom
+layout (location = 1) in vec4 aTile;    // xy = narożnik siatki kafelka, z = odstęp próbek, w = warstwa
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+#define GRID_RESOLUTION 32
+#define TILE_SAMPLES 35.0
+#define MAX_LEVELS 16
+
+uniform sampler2DArray heights;
+uniform vec3 terrainOrigin;
+uniform vec3 lodCamera;                 // kamera, dla której wybrano węzły (wspólna dla widoków)
+uniform vec2 morphParams[MAX_LEVELS];   // x = początek przejścia, y = 1 / długość przejścia
+
+out vec3 FragPos;
+out vec3 Normal;
+
+float sampleHeight(vec2 local) {
+    vec2 grid = (local - aTile.xy) / aTile.z;
+    return textureLod(heights, vec3((grid + 1.5) / TILE_SAMPLES, aTile.w), 0.0).r;
+}
+
+void main()
+{
+    vec2 grid = vec2(gl_VertexID % (GRID_RESOLUTION + 1), gl_VertexID / (GRID_RESOLUTION + 1));
+    float cellSize = aNode.z / float(GRID_RESOLUTION);
+    vec2 local = aNode.xy + grid * cellSize;
+
+    // Przejście w siatkę rodzica według odległości wierzchołka od kamery wyboru
+    vec2 morph = morphParams[int(aNode.w)];
+    vec3 unmorphed = terrainOrigin + vec3(local.x, sampleHeight(local), local.y);
+    float morphK = clamp((distance(unmorphed, lodCamera) - morph.x) * morph.y, 0.0, 1.0);
+    grid -= fract(grid * 0.5) * 2.0 * morphK;
+    local = aNode.xy + grid * cellSize;
+
+    float height = sampleHeight(local);
+    float texel = aTile.z;
+    float left = sampleHeight(local - vec2(texel, 0.0));
+    float right = sampleHeight(local + vec2(texel, 0.0));
+    float back = sampleHeight(local - vec2(0.0, texel));
+    float front = sampleHeight(local + vec2(0.0, texel));
+    Normal = normalize(vec3(left - right, 2.0 * texel, back - front));
+
+    FragPos = terrainOrigin + vec3(local.x, height, local.y);
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader terenu
+ *
+ * Kolor (trawa, skała, śnieg) zależy od nachylenia i wysokości; oświetlenie
+ * jak w shaderze sceny (ta sama tabela materiałów i lista świateł).
+ * Kompilowany po wierszu #version i LightCuller::getShaderSource().
+ */
+static const char* terrainFragmentSource = R"(
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+
+uniform float snowLine;
+uniform ivec2 lightList;
+uniform int materialIndex;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+void main()
+{
+    vec3 normal = normalize(Normal);
+    float slope = 1.0 - normal.y;
+    vec3 albedo = mix(vec3(0.28, 0.42, 0.18), vec3(0.42, 0.40, 0.37), smoothstep(0.2, 0.4, slope));
+    float snow = smoothstep(snowLine - 2.0, snowLine + 2.0, FragPos.y) * (1.0 - smoothstep(0.4, 0.6, slope));
+    albedo = mix(albedo, vec3(0.92, 0.93, 0.95), snow);
+
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
+    PackedMaterial material = materialData[materialIndex];
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < lightList.y; i++) {
+        int lightIndex = texelFetch(lightIndices, lightList.x + i).r;
+        result += calculatePhongLight(lightData[lightIndex], material, normal, FragPos, viewDir);
+    }
+    FragColor = vec4(result * albedo, 1.0);
+}
+)";
+
+/**
+ * @struct TerrainRenderer::LoadQueue
+ * @brief Kafelki spróbkowane w tle, czekające na wysłanie do tekstury
+ *
+ * Współdzielona z zadaniami próbkowania, więc zadania kończące się po
+ * zamknięciu terenu lub zniszczeniu renderera piszą do żywego obiektu,
+ * a ich wyniki odrzucane są po numerze terenu.
+ */
+struct TerrainRenderer::LoadQueue {
+    /**
+     * @struct Result
+     * @brief Wynik próbkowania jednego kafelka
+     */
+    struct Result {
+        uint64_t generation;            /**< Numer terenu w chwili zamówienia */
+        uint64_t key;                   /**< Klucz kafelka */
+        bool success;                   /**< Czy próbkowanie się powiodło */
+        float minHeight;                /**< Najmniejsza wysokość */
+        float maxHeight;                /**< Największa wysokość */
+        std::vector<float> heights;     /**< Próbki kafelka */
+    };
+
+    std::mutex mutex;               /**< Blokada listy wyników */
+    std::vector<Result> results;    /**< Wyniki w kolejności ukończenia */
+};
+
+/**
+ * @brief Próbkuje kafelek węzła (siatka węzła z brzegiem jednej próbki)
+ * @param source Źródło wysokości
+ * @param depth Głębokość węzła
+ * @param x Kolumna węzła
+ * @param z Wiersz węzła
+ * @param size Bok terenu
+ * @param heights Próbki kafelka
+ * @param minHeight Najmniejsza wysokość kafelka
+ * @param maxHeight Największa wysokość kafelka
+ * @return true jeśli próbkowanie się powiodło
+ */
+static bool sampleNodeTile(const TerrainSource& source, int depth, uint32_t x, uint32_t z, float size,
+                           std::vector<float>& heights, float& minHeight, float& maxHeight) {
+    const int samples = TerrainRenderer::TILE_SAMPLES;
+    float nodeSize = size / static_cast<float>(1u << depth);
+    float spacing = nodeSize / TerrainRenderer::GRID_RESOLUTION;
+    heights.resize(static_cast<size_t>(samples) * samples);
+    if (!source.sampleTile(x * nodeSize - spacing, z * nodeSize - spacing, spacing, samples, heights.data())) {
+        return false;
+    }
+    minHeight = FLT_MAX;
+    maxHeight = -FLT_MAX;
+    for (float height : heights) {
+        minHeight = std::min(minHeight, height);
+        maxHeight = std::max(maxHeight, height);
+    }
+    return true;
+}
+
+/**
+ * @brief Konstruktor TerrainRenderer
+ */
+TerrainRenderer::TerrainRenderer()
+    : m_loads(std::make_shared<LoadQueue>()), m_cameraPosition(0.0f), m_sourceRange(0.0f), m_lightList(0),
+      m_program(0), m_vao(0), m_indexBuffer(0), m_instanceBuffer(0), m_heightTexture(0), m_morphLoc(-1),
+      m_originLoc(-1), m_snowLineLoc(-1), m_lodCameraLoc(-1), m_lightListLoc(-1), m_materialIndexLoc(-1),
+      m_instanceCapacity(0), m_frame(0), m_generation(0), m_pendingLoads(0), m_initialized(false) {
+    std::fill(m_ranges, m_ranges + MAX_LEVELS, 0.0f);
+}
+
+/**
+ * @brief Destruktor TerrainRenderer
+ */
+TerrainRenderer::~TerrainRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery i tworzy siatkę, bufory i tablicę tekstur
+ * @return true jeśli inicjalizacja się powiodła
+ *
+ * @details Indeksy pierwszej ćwiartki siatki leżą na początku bufora, więc
+ * ćwiartki rysowane są tą samą siatką z krótszym zakresem indeksów.
+ */
+bool TerrainRenderer::initialize() {
+    if (m_initialized) return true;
+
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, terrainVertexSource, "terenu");
+    const char* fragmentSources[] = {"#version 330 core\n", LightCuller::getShaderSource(), terrainFragmentSource};
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSources, 3, "terenu");
+    m_program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "terenu");
+    if (!m_program) return false;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    MultiViewRenderer::setupProgram(m_program);
+    LightCuller::setupProgram(m_program);
+    MaterialTable::setupProgram(m_program);
+    glUseProgram(m_program);
+    glUniform1i(glGetUniformLocation(m_program, "heights"), HEIGHT_TEXTURE_UNIT);
+    glUseProgram(previousProgram);
+    m_morphLoc = glGetUniformLocation(m_program, "morphParams");
+    m_originLoc = glGetUniformLocation(m_program, "terrainOrigin");
+    m_snowLineLoc = glGetUniformLocation(m_program, "snowLine");
+    m_lodCameraLoc = glGetUniformLocation(m_program, "lodCamera");
+    m_lightListLoc = glGetUniformLocation(m_program, "lightList");
+    m_materialIndexLoc = glGetUniformLocation(m_program, "materialIndex");
+
+    // Wspólna siatka: najpierw kwadraty pierwszej ćwiartki, potem pozostałe
+    const int half = GRID_RESOLUTION / 2;
+    std::vector<GLuint> indices;
+    indices.reserve(GRID_RESOLUTION * GRID_RESOLUTION * 6);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int z = 0; z < GRID_RESOLUTION; ++z) {
+            for (int x = 0; x < GRID_RESOLUTION; ++x) {
+                if ((x < half && z < half) != (pass == 0)) continue;
+                GLuint a = z * (GRID_RESOLUTION + 1) + x;
+                GLuint b = a + 1;
+                GLuint c = a + GRID_RESOLUTION + 1;
+                GLuint d = c + 1;
+                indices.insert(indices.end(), {a, c, b, b, c, d});
+            }
+        }
+    }
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_indexBuffer);
+    glGenBuffers(1, &m_instanceBuffer);
+    glGenTextures(1, &m_heightTexture);
+    if (!m_vao || !m_indexBuffer || !m_instanceBuffer || !m_heightTexture) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow terenu" << std::endl;
+        release();
+        return false;
+    }
+
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(NodeInstance), (void*)offsetof(NodeInstance, node));
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(NodeInstance), (void*)offsetof(NodeInstance, tile));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_heightTexture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R32F, TILE_SAMPLES, TILE_SAMPLES, MAX_TILES, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    m_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Zamyka teren i zwalnia obiekty OpenGL
+ */
+void TerrainRenderer::release() {
+    close();
+    if (m_program) glDeleteProgram(m_program);
+    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    if (m_indexBuffer) glDeleteBuffers(1, &m_indexBuffer);
+    if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+    if (m_heightTexture) glDeleteTextures(1, &m_heightTexture);
+    m_program = 0;
+    m_vao = 0;
+    m_indexBuffer = 0;
+    m_instanceBuffer = 0;
+    m_heightTexture = 0;
+    m_instanceCapacity = 0;
+    m_initialized = false;
+}
+
+/**
+ * @brief Otwiera teren (kafelek korzenia próbkowany jest od razu)
+ * @param source Źródło wysokości
+ * @param settings Położenie i parametry szczegółowości
+ * @return true jeśli teren został otwarty
+ *
+ * @details Kafelek korzenia nigdy nie jest zwalniany, więc każdy węzeł ma
+ * wczytanego przodka. Zasięg poziomu L to rangeScale * bok liścia * 2^L;
+ * przejście w siatkę rodzica zajmuje ostatnią część morphRatio pasa między
+ * zasięgiem poprzedniego poziomu a własnym i kończy się dokładnie na
+ * granicy zasięgu. Poziom korzenia nie ma rodzica, więc nie przechodzi.
+ */
+bool TerrainRenderer::open(std::shared_ptr<TerrainSource> source, const TerrainSettings& settings) {
+    close();
+    if (!m_initialized || !source || settings.size <= 0.0f) return false;
+
+    m_settings = settings;
+    m_settings.levels = std::min(std::max(settings.levels, 1), static_cast<int>(MAX_LEVELS));
+    m_settings.morphRatio = std::min(std::max(settings.morphRatio, 0.01f), 1.0f);
+    m_sourceRange = source->getHeightRange();
+
+    TerrainSettings& s = m_settings;
+    float leafSize = nodeSize(s.levels - 1);
+    glm::vec2 morphParams[MAX_LEVELS];
+    for (int level = 0; level < MAX_LEVELS; ++level) {
+        m_ranges[level] = leafSize * s.rangeScale * static_cast<float>(1u << level);
+        float previous = level > 0 ? m_ranges[level - 1] : 0.0f;
+        float length = (m_ranges[level] - previous) * s.morphRatio;
+        morphParams[level] = glm::vec2(m_ranges[level] - length, 1.0f / length);
+    }
+    morphParams[s.levels - 1] = glm::vec2(FLT_MAX, 0.0f);
+
+    LoadQueue::Result root;
+    if (!sampleNodeTile(*source, 0, 0, 0, s.size, root.heights, root.minHeight, root.maxHeight)) {
+        std::cerr << "Blad: Nie udalo sie sprobkowac terenu" << std::endl;
+        return false;
+    }
+
+    m_freeLayers.clear();
+    for (int layer = MAX_TILES - 1; layer > 0; --layer) m_freeLayers.push_back(layer);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_heightTexture);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, TILE_SAMPLES, TILE_SAMPLES, 1, GL_RED, GL_FLOAT,
+                    root.heights.data());
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    m_tiles[tileKey(0, 0, 0)] = Tile{TileState::RESIDENT, 0, root.minHeight, root.maxHeight, 0};
+    m_source = std::move(source);
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform2fv(m_morphLoc, MAX_LEVELS, glm::value_ptr(morphParams[0]));
+    glUniform3f(m_originLoc, s.origin.x, s.origin.y, s.origin.z);
+    glUniform1f(m_snowLineLoc, s.origin.y + m_sourceRange.x + (m_sourceRange.y - m_sourceRange.x) * 0.7f);
+    glUniform1i(m_materialIndexLoc, MaterialTable::DEFAULT_MATERIAL);
+    glUseProgram(previousProgram);
+
+    std::cout << "Teren: bok " << s.size << " m, " << s.levels << " poziomow, liscie " << leafSize << " m" << std::endl;
+    return true;
+}
+
+/**
+ * @brief Zamyka teren i zwalnia kafelki
+ *
+ * @details Zadania próbkowania w toku nie są przerywane; ich wyniki
+ * zostaną odrzucone, bo zmienia się numer terenu.
+ */
+void TerrainRenderer::close() {
+    m_source.reset();
+    m_tiles.clear();
+    m_freeLayers.clear();
+    m_drawItems.clear();
+    m_missingTiles.clear();
+    m_instances.clear();
+    m_viewRanges.clear();
+    m_pendingLoads = 0;
+    m_generation++;
+    std::lock_guard<std::mutex> lock(m_loads->mutex);
+    m_loads->results.clear();
+}
+
+/**
+ * @brief Tworzy klucz kafelka węzła
+ * @param depth Głębokość węzła (0 = korzeń)
+ * @param x Kolumna węzła na jego głębokości
+ * @param z Wiersz węzła na jego głębokości
+ * @return Klucz mapy kafelków
+ */
+uint64_t TerrainRenderer::tileKey(int depth, uint32_t x, uint32_t z) {
+    return (static_cast<uint64_t>(depth) << 48) | (static_cast<uint64_t>(x) << 24) | z;
+}
+
+/**
+ * @brief Szuka najbliższego wczytanego kafelka węzła lub jego przodka
+ * @param depth Głębokość węzła
+ * @param x Kolumna węzła
+ * @param z Wiersz węzła
+ * @param foundDepth Głębokość znalezionego kafelka
+ * @return Kafelek lub nullptr (przed wczytaniem korzenia)
+ */
+TerrainRenderer::Tile* TerrainRenderer::findResidentTile(int depth, uint32_t x, uint32_t z, int& foundDepth) {
+    for (int d = depth; d >= 0; --d) {
+        int shift = depth - d;
+        auto found = m_tiles.find(tileKey(d, x >> shift, z >> shift));
+        if (found != m_tiles.end() && found->second.state == TileState::RESIDENT) {
+            foundDepth = d;
+            return &found->second;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Zwraca prostopadłościan węzła z wysokościami najbliższego wczytanego kafelka
+ * @param depth Głębokość węzła
+ * @param x Kolumna węzła
+ * @param z Wiersz węzła
+ * @return Prostopadłościan w przestrzeni świata
+ *
+ * @details Kafelek przodka próbkuje teren rzadziej, więc może pominąć
+ * szczyty węzła; jego zakres poszerzany jest o połowę (w granicach zakresu
+ * źródła), dopóki węzeł nie ma własnego kafelka.
+ */
+BoundingBox TerrainRenderer::nodeBounds(int depth, uint32_t x, uint32_t z) {
+    glm::vec2 range = m_sourceRange;
+    int foundDepth = 0;
+    if (const Tile* tile = findResidentTile(depth, x, z, foundDepth)) {
+        range = glm::vec2(tile->minHeight, tile->maxHeight);
+        if (foundDepth != depth) {
+            float margin = (range.y - range.x) * 0.25f + (m_sourceRange.y - m_sourceRange.x) * 0.02f;
+            range.x = std::max(range.x - margin, m_sourceRange.x);
+            range.y = std::min(range.y + margin, m_sourceRange.y);
+        }
+    }
+    float size = nodeSize(depth);
+    BoundingBox box;
+    box.min = m_settings.origin + glm::vec3(x * size, range.x, z * size);
+    box.max = m_settings.origin + glm::vec3((x + 1) * size, range.y, (z + 1) * size);
+    return box;
+}
+
+/**
+ * @brief Wybiera węzły poddrzewa (dzieci poza zasięgiem zastępowane są ćwiartkami)
+ * @param depth Głębokość węzła
+ * @param x Kolumna węzła
+ * @param z Wiersz węzła
+ * @return false jeśli węzeł jest poza zasięgiem swojego poziomu (rysuje go rodzic)
+ *
+ * @details Węzeł poza wszystkimi ostrosłupami jest obsłużony (nic nie
+ * rysuje), żeby rodzic nie zastąpił go swoją ćwiartką.
+ */
+bool TerrainRenderer::selectNode(int depth, uint32_t x, uint32_t z) {
+    BoundingBox box = nodeBounds(depth, x, z);
+    int level = m_settings.levels - 1 - depth;
+    if (depth > 0 && !box.intersects(BoundingSphere{m_cameraPosition, m_ranges[level]})) return false;
+
+    bool visible = false;
+    for (const Frustum& frustum : m_frustums) visible = visible || frustum.intersects(box);
+    if (!visible) return true;
+
+    if (level == 0 || !box.intersects(BoundingSphere{m_cameraPosition, m_ranges[level - 1]})) {
+        addDrawItem(depth, x, z, -1, box);
+        return true;
+    }
+    for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        uint32_t childX = x * 2 + (quadrant & 1);
+        uint32_t childZ = z * 2 + (quadrant >> 1);
+        if (!selectNode(depth + 1, childX, childZ)) {
+            addDrawItem(depth, x, z, quadrant, nodeBounds(depth + 1, childX, childZ));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Dodaje obszar do rysowania z najbliższym wczytanym kafelkiem
+ * @param depth Głębokość węzła, którego siatką rysowany jest obszar
+ * @param x Kolumna węzła
+ * @param z Wiersz węzła
+ * @param quadrant Ćwiartka (0-3) lub -1 dla całego węzła
+ * @param bounds Prostopadłościan obszaru
+ *
+ * @details Gdy węzeł nie ma własnego kafelka, zamawiany jest kafelek
+ * o jeden poziom drobniejszy od używanego przodka, więc teren wyostrza
+ * się od poziomów grubych; bliższe węzły mają pierwszeństwo w poziomie.
+ */
+void TerrainRenderer::addDrawItem(int depth, uint32_t x, uint32_t z, int quadrant, const BoundingBox& bounds) {
+    uint32_t viewMask = 0;
+    for (size_t view = 0; view < m_frustums.size(); ++view) {
+        if (m_frustums[view].intersects(bounds)) viewMask |= 1u << view;
+    }
+    if (viewMask == 0) return;
+
+    int tileDepth = 0;
+    Tile* tile = findResidentTile(depth, x, z, tileDepth);
+    if (!tile) return;
+    tile->lastUsedFrame = m_frame;
+    if (tileDepth != depth) {
+        int shift = depth - tileDepth - 1;
+        uint64_t key = tileKey(tileDepth + 1, x >> shift, z >> shift);
+        float distance = glm::length(bounds.getCenter() - m_cameraPosition);
+        m_missingTiles.push_back({(tileDepth + 1) * m_settings.size * 4.0f + distance, key});
+    }
+
+    float size = nodeSize(depth);
+    float tileSize = nodeSize(tileDepth);
+    int shift = depth - tileDepth;
+    DrawItem item;
+    item.instance.node = glm::vec4(x * size, z * size, size, static_cast<float>(m_settings.levels - 1 - depth));
+    if (quadrant >= 0) {
+        item.instance.node.x += (quadrant & 1) * size * 0.5f;
+        item.instance.node.y += (quadrant >> 1) * size * 0.5f;
+    }
+    item.instance.tile = glm::vec4((x >> shift) * tileSize, (z >> shift) * tileSize, tileSize / GRID_RESOLUTION,
+                                   static_cast<float>(tile->layer));
+    item.viewMask = viewMask;
+    item.quarter = quadrant >= 0;
+    m_drawItems.push_back(item);
+}
+
+/**
+ * @brief Zamawia próbkowanie kafelka w tle
+ * @param key Klucz kafelka
+ *
+ * @details Zadanie dostaje wspólne wskaźniki źródła i kolejki wyników,
+ * więc nie odwołuje się do renderera.
+ */
+void TerrainRenderer::requestLoad(uint64_t key) {
+    m_tiles[key] = Tile{TileState::LOADING, -1, 0.0f, 0.0f, m_frame};
+    m_pendingLoads++;
+
+    std::shared_ptr<LoadQueue> loads = m_loads;
+    std::shared_ptr<TerrainSource> source = m_source;
+    uint64_t generation = m_generation;
+    float size = m_settings.size;
+    auto task = [loads, source, generation, key, size]() {
+        LoadQueue::Result result;
+        result.generation = generation;
+        result.key = key;
+        int depth = static_cast<int>(key >> 48);
+        uint32_t x = static_cast<uint32_t>(key >> 24) & 0xffffff;
+        uint32_t z = static_cast<uint32_t>(key) & 0xffffff;
+        result.success = sampleNodeTile(*source, depth, x, z, size, result.heights, result.minHeight, result.maxHeight);
+
+        std::lock_guard<std::mutex> lock(loads->mutex);
+        loads->results.push_back(std::move(result));
+    };
+
+    // Bez wątków roboczych (jeden rdzeń) kafelek próbkowany jest od razu
+    ThreadPool& pool = ThreadPool::instance();
+    if (pool.getThreadCount() == 0) {
+        task();
+    } else {
+        pool.submit(task);
+    }
+}
+
+/**
+ * @brief Zwalnia najdawniej używany kafelek spoza bieżącej klatki
+ * @return Zwolniona warstwa lub -1
+ */
+int TerrainRenderer::evictOldestTile() {
+    const uint64_t rootKey = tileKey(0, 0, 0);
+    auto oldest = m_tiles.end();
+    for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+        const Tile& tile = it->second;
+        if (it->first == rootKey || tile.state != TileState::RESIDENT || tile.lastUsedFrame >= m_frame) continue;
+        if (oldest == m_tiles.end() || tile.lastUsedFrame < oldest->second.lastUsedFrame) oldest = it;
+    }
+    if (oldest == m_tiles.end()) return -1;
+    int layer = oldest->second.layer;
+    m_tiles.erase(oldest);
+    return layer;
+}
+
+/**
+ * @brief Wysyła do tekstury kafelki spróbkowane w tle
+ *
+ * @details Najwyżej MAX_UPLOADS_PER_FRAME kafelków na klatkę; pozostałe
+ * czekają w kolejce. Kafelek, dla którego nie ma wolnej warstwy nawet po
+ * zwolnieniu kafelków spoza bieżącej klatki, jest porzucany i zostanie
+ * zamówiony ponownie.
+ */
+void TerrainRenderer::uploadLoadedTiles() {
+    std::vector<LoadQueue::Result> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_loads->mutex);
+        std::vector<LoadQueue::Result>& results = m_loads->results;
+        size_t count = std::min<size_t>(results.size(), MAX_UPLOADS_PER_FRAME);
+        std::move(results.begin(), results.begin() + count, std::back_inserter(ready));
+        results.erase(results.begin(), results.begin() + count);
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_heightTexture);
+    for (LoadQueue::Result& result : ready) {
+        if (result.generation != m_generation) continue;
+        auto found = m_tiles.find(result.key);
+        if (found == m_tiles.end()) continue;
+        m_pendingLoads--;
+        if (!result.success) {
+            std::cerr << "Blad: Nie udalo sie sprobkowac kafelka terenu " << result.key << std::endl;
+            m_tiles.erase(found);
+            continue;
+        }
+
+        int layer = -1;
+        if (!m_freeLayers.empty()) {
+            layer = m_freeLayers.back();
+            m_freeLayers.pop_back();
+        } else {
+            layer = evictOldestTile();
+            found = m_tiles.find(result.key);
+        }
+        if (layer < 0) {
+            m_tiles.erase(found);
+            continue;
+        }
+
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, TILE_SAMPLES, TILE_SAMPLES, 1, GL_RED, GL_FLOAT,
+                        result.heights.data());
+        Tile& tile = found->second;
+        tile.state = TileState::RESIDENT;
+        tile.layer = layer;
+        tile.minHeight = result.minHeight;
+        tile.maxHeight = result.maxHeight;
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+/**
+ * @brief Wybiera węzły dla kamery głównej, zamawia brakujące kafelki i wysyła wczytane
+ * @param cameraPosition Pozycja kamery głównej (decyduje o szczegółowości)
+ * @param frustums Ostrosłupy wszystkich widoków
+ * @param lightList Globalna lista świateł
+ *
+ * @details Wybór jest jeden dla wszystkich widoków (szczegółowość
+ * i przejścia liczone od kamery głównej, więc siatka jest taka sama
+ * w każdym widoku), a węzły odrzucane są przez sumę ostrosłupów. Bufor
+ * instancji zawiera potem dla każdego widoku jego całe węzły i ćwiartki
+ * (najwyżej 32 widoki).
+ */
+void TerrainRenderer::update(const glm::vec3& cameraPosition, const std::vector<Frustum>& frustums,
+                             const glm::ivec2& lightList) {
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Teren/Trojkaty", 0.0);
+    stats.setValue("Teren/Wywolania rysowania", 0.0);
+    m_drawItems.clear();
+    m_instances.clear();
+    m_viewRanges.clear();
+    if (!m_initialized || !m_source) return;
+
+    m_frame++;
+    m_cameraPosition = cameraPosition;
+    m_lightList = lightList;
+    m_frustums.assign(frustums.begin(), frustums.begin() + std::min<size_t>(frustums.size(), 32));
+
+    m_missingTiles.clear();
+    selectNode(0, 0, 0);
+
+    std::sort(m_missingTiles.begin(), m_missingTiles.end());
+    int requests = 0;
+    for (const auto& missing : m_missingTiles) {
+        if (m_pendingLoads >= MAX_PENDING_LOADS) break;
+        if (m_tiles.count(missing.second)) continue;
+        requestLoad(missing.second);
+        requests++;
+    }
+    uploadLoadedTiles();
+
+    m_viewRanges.resize(m_frustums.size());
+    for (size_t view = 0; view < m_frustums.size(); ++view) {
+        ViewRange& range = m_viewRanges[view];
+        for (int pass = 0; pass < 2; ++pass) {
+            size_t first = m_instances.size();
+            for (const DrawItem& item : m_drawItems) {
+                if (item.quarter == (pass == 1) && (item.viewMask & (1u << view))) m_instances.push_back(item.instance);
+            }
+            size_t count = m_instances.size() - first;
+            if (pass == 0) {
+                range.firstNode = first;
+                range.nodeCount = count;
+            } else {
+                range.firstQuarter = first;
+                range.quarterCount = count;
+            }
+        }
+    }
+
+    if (!m_instances.empty()) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+        if (m_instances.size() > m_instanceCapacity) {
+            m_instanceCapacity = std::max(m_instances.size(), m_instanceCapacity + m_instanceCapacity / 2);
+        }
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_instanceCapacity * sizeof(NodeInstance)), nullptr,
+                     GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(m_instances.size() * sizeof(NodeInstance)),
+                        m_instances.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform3f(m_lodCameraLoc, cameraPosition.x, cameraPosition.y, cameraPosition.z);
+    glUniform2i(m_lightListLoc, lightList.x, lightList.y);
+    glUseProgram(previousProgram);
+
+    size_t residentTiles = m_tiles.size() - static_cast<size_t>(m_pendingLoads);
+    size_t textureBytes = static_cast<size_t>(MAX_TILES) * TILE_SAMPLES * TILE_SAMPLES * sizeof(float);
+    size_t bufferBytes = GRID_RESOLUTION * GRID_RESOLUTION * 6 * sizeof(GLuint) + m_instanceCapacity * sizeof(NodeInstance);
+    stats.setValue("Teren/Wybrane obszary", static_cast<double>(m_drawItems.size()));
+    stats.setValue("Teren/Kafelki w pamieci", static_cast<double>(residentTiles));
+    stats.setValue("Teren/Wczytywane kafelki", static_cast<double>(m_pendingLoads));
+    stats.setValue("Teren/Zamowione kafelki", static_cast<double>(requests));
+    stats.setValue("Teren/Pamiec GPU [MB]", (textureBytes + bufferBytes) / (1024.0 * 1024.0));
+}
+
+/**
+ * @brief Rysuje węzły widoczne w widoku
+ * @param viewIndex Indeks widoku z update()
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(). Całe węzły i ćwiartki rysowane są
+ * osobnym glDrawElementsInstanced; ćwiartki używają pierwszej ćwiartki
+ * indeksów, a atrybuty instancji przestawiane są na zakres widoku.
+ */
+int TerrainRenderer::draw(int viewIndex) {
+    if (!m_initialized || viewIndex < 0 || viewIndex >= static_cast<int>(m_viewRanges.size())) return 0;
+    const ViewRange& range = m_viewRanges[viewIndex];
+    if (range.nodeCount == 0 && range.quarterCount == 0) return 0;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glActiveTexture(GL_TEXTURE0 + HEIGHT_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_heightTexture);
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+    const GLsizei fullIndices = GRID_RESOLUTION * GRID_RESOLUTION * 6;
+    int drawCalls = 0;
+    double triangles = 0.0;
+    for (int pass = 0; pass < 2; ++pass) {
+        size_t first = pass == 0 ? range.firstNode : range.firstQuarter;
+        size_t count = pass == 0 ? range.nodeCount : range.quarterCount;
+        GLsizei indices = pass == 0 ? fullIndices : fullIndices / 4;
+        if (count == 0) continue;
+        size_t offset = first * sizeof(NodeInstance);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(NodeInstance),
+                              (void*)(offset + offsetof(NodeInstance, node)));
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(NodeInstance),
+                              (void*)(offset + offsetof(NodeInstance, tile)));
+        glDrawElementsInstanced(GL_TRIANGLES, indices, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(count));
+        triangles += static_cast<double>(indices / 3) * count;
+        drawCalls++;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glUseProgram(previousProgram);
+
+    RenderStats& stats = RenderStats::instance();
+    stats.addValue("Teren/Trojkaty", triangles);
+    stats.addValue("Teren/Wywolania rysowania", drawCalls);
+    return drawCalls;
+}
@@ -0,0 +1,272 @@
+// TerrainRenderer.hpp
+#ifndef TERRAIN_RENDERER_HPP
+#define TERRAIN_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "TerrainSource.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @struct TerrainSettings
+ * @brief Położenie i parametry szczegółowości terenu
+ */
+struct TerrainSettings {
+    glm::vec3 origin = glm::vec3(0.0f);     /**< Narożnik terenu (wysokości dodawane są do y) */
+    float size = 1024.0f;                   /**< Bok terenu [m] */
+    int levels = 8;                         /**< Liczba poziomów drzewa (liść ma bok size / 2^(levels-1)) */
+    float rangeScale = 2.5f;                /**< Zasięg poziomu w bokach jego węzła */
+    float morphRatio = 0.3f;                /**< Część pasa poziomu, w której wierzchołki przechodzą w rzadszą siatkę */
+};
+
+/**
+ * @class TerrainRenderer
+ * @brief Teren z mapy wysokości z ciągłą szczegółowością zależną od odległości (CDLOD)
+ *
+ * Teren dzielony jest drzewem czwórkowym; każdy wybrany węzeł rysowany jest
+ * tą samą siatką GRID_RESOLUTION x GRID_RESOLUTION, przesuwaną w vertex
+ * shaderze o wysokość z tekstury. Poziom L (0 = liście) obejmuje kulę
+ * o promieniu rangeScale * bok węzła wokół kamery głównej; węzeł, którego
+ * dzieci nie mieszczą się w zasięgu swojego poziomu, rysowany jest
+ * ćwiartkami. Pod koniec zasięgu poziomu wierzchołki nieparzyste przesuwają
+ * się płynnie na rzadszą siatkę rodzica, więc na granicach poziomów nie ma
+ * pęknięć ani przeskoków.
+ *
+ * Każdy węzeł ma własny kafelek wysokości (siatka węzła z brzegiem jednej
+ * próbki) wczytywany w tle z TerrainSource (ThreadPool) do warstwy tablicy
+ * tekstur. Dopóki kafelek nie jest wczytany, węzeł próbkuje najbliższego
+ * wczytanego przodka; najdawniej używane kafelki zwalniane są, gdy brakuje
+ * warstw. Wybrane węzły trafiają do jednego bufora instancji, więc każdy
+ * widok rysowany jest dwoma wywołaniami (całe węzły i ćwiartki), a liczba
+ * trójkątów zależy od zasięgów, nie od wielkości terenu.
+ */
+class TerrainRenderer {
+public:
+    static const int GRID_RESOLUTION = 32;                  /**< Liczba kwadratów siatki węzła na bok */
+    static const int TILE_SAMPLES = GRID_RESOLUTION + 3;    /**< Próbki kafelka na bok (z brzegiem) */
+    static const int MAX_TILES = 512;                       /**< Warstwy tablicy tekstur wysokości */
+    static const int MAX_LEVELS = 16;                       /**< Największa liczba poziomów drzewa */
+    static const int MAX_PENDING_LOADS = 16;                /**< Najwięcej kafelków wczytywanych naraz */
+    static const int MAX_UPLOADS_PER_FRAME = 16;            /**< Najwięcej kafelków wysyłanych do GPU w klatce */
+    static const int HEIGHT_TEXTURE_UNIT = 8;               /**< Jednostka teksturująca wysokości */
+
+private:
+    /**
+     * @enum TileState
+     * @brief Stan kafelka wysokości
+     */
+    enum class TileState {
+        LOADING,    /**< Próbkowany w tle */
+        RESIDENT    /**< W warstwie tekstury */
+    };
+
+    /**
+     * @struct Tile
+     * @brief Kafelek wysokości węzła drzewa
+     */
+    struct Tile {
+        TileState state;            /**< Stan danych */
+        int layer;                  /**< Warstwa tablicy tekstur (-1 gdy brak) */
+        float minHeight;            /**< Najmniejsza wysokość kafelka */
+        float maxHeight;            /**< Największa wysokość kafelka */
+        uint64_t lastUsedFrame;     /**< Ostatnia klatka, w której kafelek był próbkowany */
+    };
+
+    /**
+     * @struct NodeInstance
+     * @brief Dane instancji rysowanego obszaru (układ bufora instancji)
+     */
+    struct NodeInstance {
+        glm::vec4 node;     /**< xy = narożnik obszaru, z = bok węzła, w = poziom */
+        glm::vec4 tile;     /**< xy = narożnik siatki kafelka, z = odstęp próbek, w = warstwa */
+    };
+
+    /**
+     * @struct DrawItem
+     * @brief Wybrany obszar z maską widoków, w których jest widoczny
+     */
+    struct DrawItem {
+        NodeInstance instance;  /**< Dane instancji */
+        uint32_t viewMask;      /**< Bit na widok przecinający prostopadłościan obszaru */
+        bool quarter;           /**< Czy to ćwiartka węzła */
+    };
+
+    /**
+     * @struct ViewRange
+     * @brief Zakresy bufora instancji jednego widoku
+     */
+    struct ViewRange {
+        size_t firstNode;       /**< Pierwsza instancja całych węzłów */
+        size_t nodeCount;       /**< Liczba całych węzłów */
+        size_t firstQuarter;    /**< Pierwsza instancja ćwiartek */
+        size_t quarterCount;    /**< Liczba ćwiartek */
+    };
+
+    struct LoadQueue;
+
+    std::shared_ptr<TerrainSource> m_source;            /**< Źródło wysokości */
+    TerrainSettings m_settings;                         /**< Parametry terenu */
+    std::unordered_map<uint64_t, Tile> m_tiles;         /**< Kafelki wczytywane i wczytane */
+    std::vector<int> m_freeLayers;                      /**< Wolne warstwy tablicy tekstur */
+    std::vector<DrawItem> m_drawItems;                  /**< Obszary wybrane w bieżącej klatce */
+    std::vector<std::pair<float, uint64_t>> m_missingTiles; /**< Brakujące kafelki klatki z priorytetem (mniejszy = pilniejszy) */
+    std::vector<NodeInstance> m_instances;              /**< Instancje wszystkich widoków */
+    std::vector<ViewRange> m_viewRanges;                /**< Zakresy instancji widoków */
+    std::vector<Frustum> m_frustums;                    /**< Ostrosłupy widoków bieżącej klatki */
+    std::shared_ptr<LoadQueue> m_loads;                 /**< Wyniki próbkowania w tle (współdzielone z zadaniami) */
+    glm::vec3 m_cameraPosition;                         /**< Pozycja kamery głównej */
+    glm::vec2 m_sourceRange;                            /**< Zakres wysokości źródła */
+    glm::ivec2 m_lightList;                             /**< Globalna lista świateł */
+    float m_ranges[MAX_LEVELS];                         /**< Zasięgi poziomów (0 = liście) */
+    GLuint m_program;                                   /**< Program rysujący teren */
+    GLuint m_vao;                                       /**< VAO siatki i instancji */
+    GLuint m_indexBuffer;                               /**< Indeksy wspólnej siatki */
+    GLuint m_instanceBuffer;                            /**< Bufor instancji (strumieniowy) */
+    GLuint m_heightTexture;                             /**< Tablica tekstur kafelków */
+    GLint m_morphLoc;                                   /**< Lokalizacja uniformu parametrów przejścia poziomów */
+    GLint m_originLoc;                                  /**< Lokalizacja uniformu narożnika terenu */
+    GLint m_snowLineLoc;                                /**< Lokalizacja uniformu wysokości granicy śniegu */
+    GLint m_lodCameraLoc;                               /**< Lokalizacja uniformu pozycji kamery głównej */
+    GLint m_lightListLoc;                               /**< Lokalizacja uniformu listy świateł */
+    GLint m_materialIndexLoc;                           /**< Lokalizacja uniformu materiału */
+    size_t m_instanceCapacity;                          /**< Pojemność bufora instancji */
+    uint64_t m_frame;                                   /**< Licznik klatek */
+    uint64_t m_generation;                              /**< Numer otwartego terenu (odrzucanie starych wyników) */
+    int m_pendingLoads;                                 /**< Kafelki w stanie LOADING */
+    bool m_initialized;                                 /**< Czy obiekty OpenGL zostały utworzone */
+
+    /**
+     * @brief Tworzy klucz kafelka węzła
+     * @param depth Głębokość węzła (0 = korzeń)
+     * @param x Kolumna węzła na jego głębokości
+     * @param z Wiersz węzła na jego głębokości
+     * @return Klucz mapy kafelków
+     */
+    static uint64_t tileKey(int depth, uint32_t x, uint32_t z);
+
+    /**
+     * @brief Zwraca bok węzła na głębokości
+     * @param depth Głębokość węzła
+     * @return Bok [m]
+     */
+    float nodeSize(int depth) const { return m_settings.size / static_cast<float>(1u << depth); }
+
+    /**
+     * @brief Szuka najbliższego wczytanego kafelka węzła lub jego przodka
+     * @param depth Głębokość węzła
+     * @param x Kolumna węzła
+     * @param z Wiersz węzła
+     * @param foundDepth Głębokość znalezionego kafelka
+     * @return Kafelek lub nullptr (przed wczytaniem korzenia)
+     */
+    Tile* findResidentTile(int depth, uint32_t x, uint32_t z, int& foundDepth);
+
+    /**
+     * @brief Zwraca prostopadłościan węzła z wysokościami najbliższego wczytanego kafelka
+     * @param depth Głębokość węzła
+     * @param x Kolumna węzła
+     * @param z Wiersz węzła
+     * @return Prostopadłościan w przestrzeni świata
+     */
+    BoundingBox nodeBounds(int depth, uint32_t x, uint32_t z);
+
+    /**
+     * @brief Wybiera węzły poddrzewa (dzieci poza zasięgiem zastępowane są ćwiartkami)
+     * @param depth Głębokość węzła
+     * @param x Kolumna węzła
+     * @param z Wiersz węzła
+     * @return false jeśli węzeł jest poza zasięgiem swojego poziomu (rysuje go rodzic)
+     */
+    bool selectNode(int depth, uint32_t x, uint32_t z);
+
+    /**
+     * @brief Dodaje obszar do rysowania z najbliższym wczytanym kafelkiem
+     * @param depth Głębokość węzła, którego siatką rysowany jest obszar
+     * @param x Kolumna węzła
+     * @param z Wiersz węzła
+     * @param quadrant Ćwiartka (0-3) lub -1 dla całego węzła
+     * @param bounds Prostopadłościan obszaru
+     */
+    void addDrawItem(int depth, uint32_t x, uint32_t z, int quadrant, const BoundingBox& bounds);
+
+    /**
+     * @brief Zamawia próbkowanie kafelka w tle
+     * @param key Klucz kafelka
+     */
+    void requestLoad(uint64_t key);
+
+    /**
+     * @brief Wysyła do tekstury kafelki spróbkowane w tle
+     */
+    void uploadLoadedTiles();
+
+    /**
+     * @brief Zwalnia najdawniej używany kafelek spoza bieżącej klatki
+     * @return Zwolniona warstwa lub -1
+     */
+    int evictOldestTile();
+
+public:
+    /**
+     * @brief Konstruktor TerrainRenderer
+     */
+    TerrainRenderer();
+
+    /**
+     * @brief Destruktor TerrainRenderer
+     */
+    ~TerrainRenderer();
+
+    /**
+     * @brief Kompiluje shadery i tworzy siatkę, bufory i tablicę tekstur
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Zamyka teren i zwalnia obiekty OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Otwiera teren (kafelek korzenia próbkowany jest od razu)
+     * @param source Źródło wysokości
+     * @param settings Położenie i parametry szczegółowości
+     * @return true jeśli teren został otwarty
+     */
+    bool open(std::shared_ptr<TerrainSource> source, const TerrainSettings& settings);
+
+    /**
+     * @brief Zamyka teren i zwalnia kafelki
+     */
+    void close();
+
+    /**
+     * @brief Sprawdza, czy teren jest otwarty
+     * @return true jeśli teren jest otwarty
+     */
+    bool isOpen() const { return m_source != nullptr; }
+
+    /**
+     * @brief Wybiera węzły dla kamery głównej, zamawia brakujące kafelki i wysyła wczytane
+     * @param cameraPosition Pozycja kamery głównej (decyduje o szczegółowości)
+     * @param frustums Ostrosłupy wszystkich widoków
+     * @param lightList Globalna lista świateł
+     */
+    void update(const glm::vec3& cameraPosition, const std::vector<Frustum>& frustums, const glm::ivec2& lightList);
+
+    /**
+     * @brief Rysuje węzły widoczne w widoku
+     * @param viewIndex Indeks widoku z update()
+     * @return Liczba wywołań rysowania
+     */
+    int draw(int viewIndex);
+};
+
+#endif // TERRAIN_RENDERER_HPP
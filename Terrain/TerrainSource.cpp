@@ -0,0 +1,221 @@
+// TerrainSource.cpp
+#include "TerrainSource.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Zwraca pseudolosową wartość węzła siatki szumu
+ * @param x Kolumna węzła
+ * @param z Wiersz węzła
+ * @param seed Ziarno oktawy
+ * @return Wartość z przedziału [-1, 1]
+ */
+static float latticeValue(int32_t x, int32_t z, uint32_t seed) {
+    uint32_t hash = static_cast<uint32_t>(x) * 0x8da6b343u ^ static_cast<uint32_t>(z) * 0xd8163841u ^ seed * 0xcb1ab31fu;
+    hash ^= hash >> 16;
+    hash *= 0x7feb352du;
+    hash ^= hash >> 15;
+    hash *= 0x846ca68bu;
+    hash ^= hash >> 16;
+    return static_cast<float>(hash & 0xffffff) * (2.0f / 16777215.0f) - 1.0f;
+}
+
+/**
+ * @brief Szum wartości z interpolacją piątego stopnia (ciągłe pochodne)
+ * @param x Współrzędna X w jednostkach siatki szumu
+ * @param z Współrzędna Z w jednostkach siatki szumu
+ * @param seed Ziarno oktawy
+ * @return Wartość z przedziału [-1, 1]
+ */
+static float valueNoise(float x, float z, uint32_t seed) {
+    float floorX = std::floor(x);
+    float floorZ = std::floor(z);
+    int32_t ix = static_cast<int32_t>(floorX);
+    int32_t iz = static_cast<int32_t>(floorZ);
+    float tx = x - floorX;
+    float tz = z - floorZ;
+    float ux = tx * tx * tx * (tx * (tx * 6.0f - 15.0f) + 10.0f);
+    float uz = tz * tz * tz * (tz * (tz * 6.0f - 15.0f) + 10.0f);
+    float a = latticeValue(ix, iz, seed);
+    float b = latticeValue(ix + 1, iz, seed);
+    float c = latticeValue(ix, iz + 1, seed);
+    float d = latticeValue(ix + 1, iz + 1, seed);
+    return a + (b - a) * ux + (c - a) * uz + (a - b - c + d) * ux * uz;
+}
+
+/**
+ * @brief Konstruktor ProceduralTerrainSource
+ * @param settings Parametry szumu
+ */
+ProceduralTerrainSource::ProceduralTerrainSource(const ProceduralTerrainSettings& settings)
+    : m_settings(settings) {}
+
+/**
+ * @brief Zwraca wysokość w punkcie
+ * @param x Współrzędna X
+ * @param z Współrzędna Z
+ * @return Wysokość
+ *
+ * @details Każda kolejna oktawa ma około dwa razy większą częstotliwość
+ * (2.03, żeby węzły siatek nie pokrywały się) i o połowę mniejszą
+ * amplitudę.
+ */
+float ProceduralTerrainSource::heightAt(float x, float z) const {
+    float height = 0.0f;
+    float frequency = m_settings.frequency;
+    float amplitude = m_settings.amplitude;
+    for (int octave = 0; octave < m_settings.octaves; ++octave) {
+        height += amplitude * valueNoise(x * frequency, z * frequency, m_settings.seed + octave * 1013u);
+        frequency *= 2.03f;
+        amplitude *= 0.5f;
+    }
+
+    if (m_settings.flatRadius > 0.0f) {
+        float distance = glm::length(glm::vec2(x, z) - m_settings.flatCenter);
+        float t = std::min(std::max((distance - m_settings.flatRadius) / m_settings.flatRadius, 0.0f), 1.0f);
+        float blend = t * t * (3.0f - 2.0f * t);
+        height = m_settings.flatHeight + (height - m_settings.flatHeight) * blend;
+    }
+    return height;
+}
+
+/**
+ * @brief Próbkuje kwadratową siatkę wysokości
+ * @param originX Współrzędna X pierwszej próbki
+ * @param originZ Współrzędna Z pierwszej próbki
+ * @param spacing Odstęp próbek
+ * @param samples Liczba próbek na bok
+ * @param output Wysokości (samples * samples, wierszami wzdłuż X)
+ * @return true
+ */
+bool ProceduralTerrainSource::sampleTile(float originX, float originZ, float spacing, int samples,
+                                         float* output) const {
+    for (int row = 0; row < samples; ++row) {
+        float z = originZ + row * spacing;
+        for (int column = 0; column < samples; ++column) {
+            output[row * samples + column] = heightAt(originX + column * spacing, z);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Zwraca zakres wysokości całego terenu
+ * @return Najmniejsza (x) i największa (y) możliwa wysokość
+ */
+glm::vec2 ProceduralTerrainSource::getHeightRange() const {
+    float total = 0.0f;
+    float amplitude = m_settings.amplitude;
+    for (int octave = 0; octave < m_settings.octaves; ++octave) {
+        total += amplitude;
+        amplitude *= 0.5f;
+    }
+    return glm::vec2(std::min(-total, m_settings.flatHeight), std::max(total, m_settings.flatHeight));
+}
+
+/**
+ * @brief Konstruktor RawTerrainSource
+ * @param path Ścieżka pliku
+ * @param width Liczba próbek w wierszu
+ * @param depth Liczba wierszy
+ * @param sampleSpacing Odstęp próbek [m]
+ * @param heightScale Wysokość jednostki próbki [m]
+ * @param heightOffset Wysokość próbki 0 [m]
+ */
+RawTerrainSource::RawTerrainSource(const std::string& path, int width, int depth, float sampleSpacing,
+                                   float heightScale, float heightOffset)
+    : m_path(path), m_width(width), m_depth(depth), m_sampleSpacing(sampleSpacing), m_heightScale(heightScale),
+      m_heightOffset(heightOffset), m_valid(false) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    m_valid = file && width > 0 && depth > 0 && sampleSpacing > 0.0f &&
+              static_cast<uint64_t>(file.tellg()) == static_cast<uint64_t>(width) * depth * 2;
+}
+
+/**
+ * @brief Zwraca bok mapy w metrach (wzdłuż dłuższej osi)
+ * @return Bok terenu
+ */
+float RawTerrainSource::getSize() const {
+    return (std::max(m_width, m_depth) - 1) * m_sampleSpacing;
+}
+
+/**
+ * @brief Próbkuje kwadratową siatkę wysokości
+ * @param originX Współrzędna X pierwszej próbki
+ * @param originZ Współrzędna Z pierwszej próbki
+ * @param spacing Odstęp próbek
+ * @param samples Liczba próbek na bok
+ * @param output Wysokości (samples * samples, wierszami wzdłuż X)
+ * @return true jeśli odczyt się powiódł
+ *
+ * @details Każdy potrzebny wiersz pliku czytany jest raz, tylko w zakresie
+ * kolumn kafelka. Dla kafelków grubych poziomów, których próbki leżą
+ * daleko od siebie, to niewielka część pliku.
+ */
+bool RawTerrainSource::sampleTile(float originX, float originZ, float spacing, int samples, float* output) const {
+    if (!m_valid) return false;
+    std::ifstream file(m_path, std::ios::binary);
+    if (!file) return false;
+
+    // Pierwsza z dwóch interpolowanych próbek pliku i waga drugiej, osobno dla kolumn i wierszy
+    auto locate = [&](float origin, int count, int limit, std::vector<int>& first, std::vector<float>& weight) {
+        first.resize(count);
+        weight.resize(count);
+        for (int i = 0; i < count; ++i) {
+            float position = std::min(std::max((origin + i * spacing) / m_sampleSpacing, 0.0f),
+                                      static_cast<float>(limit - 1));
+            first[i] = std::max(std::min(static_cast<int>(position), limit - 2), 0);
+            weight[i] = std::min(position - first[i], 1.0f);
+        }
+    };
+    std::vector<int> columns, rows;
+    std::vector<float> columnWeights, rowWeights;
+    locate(originX, samples, m_width, columns, columnWeights);
+    locate(originZ, samples, m_depth, rows, rowWeights);
+    int firstColumn = columns.front();
+    int lastColumn = std::min(columns.back() + 1, m_width - 1);
+    size_t span = static_cast<size_t>(lastColumn - firstColumn + 1);
+
+    std::unordered_map<int, std::vector<float>> cache;
+    auto readRow = [&](int row) -> const float* {
+        auto found = cache.find(row);
+        if (found != cache.end()) return found->second.data();
+        std::vector<unsigned char> bytes(span * 2);
+        file.seekg(static_cast<std::streamoff>((static_cast<uint64_t>(row) * m_width + firstColumn) * 2));
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        std::vector<float>& heights = cache[row];
+        heights.resize(span);
+        for (size_t i = 0; i < span; ++i) {
+            heights[i] = m_heightOffset + m_heightScale * static_cast<float>(bytes[i * 2] | (bytes[i * 2 + 1] << 8));
+        }
+        return heights.data();
+    };
+
+    for (int row = 0; row < samples; ++row) {
+        const float* upper = readRow(rows[row]);
+        const float* lower = readRow(std::min(rows[row] + 1, m_depth - 1));
+        float rowWeight = rowWeights[row];
+        for (int column = 0; column < samples; ++column) {
+            int left = columns[column] - firstColumn;
+            int right = std::min(columns[column] + 1, m_width - 1) - firstColumn;
+            float t = columnWeights[column];
+            float top = upper[left] + (upper[right] - upper[left]) * t;
+            float bottom = lower[left] + (lower[right] - lower[left]) * t;
+            output[row * samples + column] = top + (bottom - top) * rowWeight;
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Zwraca zakres wysokości całego terenu
+ * @return Zakres wartości próbki 16-bitowej po przeskalowaniu
+ */
+glm::vec2 RawTerrainSource::getHeightRange() const {
+    float a = m_heightOffset;
+    float b = m_heightOffset + 65535.0f * m_heightScale;
+    return glm::vec2(std::min(a, b), std::max(a, b));
+}
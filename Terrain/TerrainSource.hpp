@@ -0,0 +1,133 @@
+// TerrainSource.hpp
+#ifndef TERRAIN_SOURCE_HPP
+#define TERRAIN_SOURCE_HPP
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class TerrainSource
+ * @brief Źródło wysokości terenu próbkowane kafelkami
+ *
+ * Kafelki zamawiane są z wątków roboczych, więc sampleTile() musi być
+ * bezpieczne przy wywołaniach równoległych. Współrzędne są lokalne dla
+ * terenu (od 0 do jego boku); próbki poza terenem też muszą mieć
+ * wartość, bo kafelki mają brzeg szerokości jednej próbki.
+ */
+class TerrainSource {
+public:
+    virtual ~TerrainSource() = default;
+
+    /**
+     * @brief Próbkuje kwadratową siatkę wysokości
+     * @param originX Współrzędna X pierwszej próbki
+     * @param originZ Współrzędna Z pierwszej próbki
+     * @param spacing Odstęp próbek
+     * @param samples Liczba próbek na bok
+     * @param output Wysokości (samples * samples, wierszami wzdłuż X)
+     * @return true jeśli się powiodło
+     */
+    virtual bool sampleTile(float originX, float originZ, float spacing, int samples, float* output) const = 0;
+
+    /**
+     * @brief Zwraca zakres wysokości całego terenu
+     * @return Najmniejsza (x) i największa (y) możliwa wysokość
+     */
+    virtual glm::vec2 getHeightRange() const = 0;
+};
+
+/**
+ * @struct ProceduralTerrainSettings
+ * @brief Parametry terenu z szumu fraktalnego
+ */
+struct ProceduralTerrainSettings {
+    uint32_t seed = 1;                          /**< Ziarno szumu */
+    int octaves = 8;                            /**< Liczba oktaw szumu */
+    float frequency = 1.0f / 400.0f;            /**< Częstotliwość pierwszej oktawy [1/m] */
+    float amplitude = 40.0f;                    /**< Amplituda pierwszej oktawy [m] */
+    glm::vec2 flatCenter = glm::vec2(0.0f);     /**< Środek płaskiego placu */
+    float flatRadius = 0.0f;                    /**< Promień placu (0 = bez placu) */
+    float flatHeight = 0.0f;                    /**< Wysokość placu */
+};
+
+/**
+ * @class ProceduralTerrainSource
+ * @brief Teren z szumu wartości sumowanego w oktawach (fBm)
+ *
+ * Wysokość zależy tylko od położenia, więc teren dowolnej wielkości nie
+ * zajmuje pamięci. Wokół flatCenter teren przechodzi łagodnie w płaski
+ * plac (np. pod scenę).
+ */
+class ProceduralTerrainSource : public TerrainSource {
+private:
+    ProceduralTerrainSettings m_settings;   /**< Parametry szumu */
+
+    /**
+     * @brief Zwraca wysokość w punkcie
+     * @param x Współrzędna X
+     * @param z Współrzędna Z
+     * @return Wysokość
+     */
+    float heightAt(float x, float z) const;
+
+public:
+    /**
+     * @brief Konstruktor ProceduralTerrainSource
+     * @param settings Parametry szumu
+     */
+    explicit ProceduralTerrainSource(const ProceduralTerrainSettings& settings);
+
+    bool sampleTile(float originX, float originZ, float spacing, int samples, float* output) const override;
+    glm::vec2 getHeightRange() const override;
+};
+
+/**
+ * @class RawTerrainSource
+ * @brief Mapa wysokości z pliku RAW (16 bitów bez znaku, little endian)
+ *
+ * Plik nie jest wczytywany w całości: każdy kafelek czyta z dysku tylko
+ * potrzebne wiersze (i ich potrzebny fragment), więc mapa może być
+ * większa niż pamięć. Między próbkami pliku wysokość interpolowana jest
+ * dwuliniowo, poza mapą powtarzana jest próbka brzegowa.
+ */
+class RawTerrainSource : public TerrainSource {
+private:
+    std::string m_path;         /**< Ścieżka pliku */
+    int m_width;                /**< Liczba próbek w wierszu (oś X) */
+    int m_depth;                /**< Liczba wierszy (oś Z) */
+    float m_sampleSpacing;      /**< Odstęp próbek pliku [m] */
+    float m_heightScale;        /**< Wysokość jednostki próbki [m] */
+    float m_heightOffset;       /**< Wysokość próbki 0 [m] */
+    bool m_valid;               /**< Czy plik ma oczekiwany rozmiar */
+
+public:
+    /**
+     * @brief Konstruktor RawTerrainSource
+     * @param path Ścieżka pliku
+     * @param width Liczba próbek w wierszu
+     * @param depth Liczba wierszy
+     * @param sampleSpacing Odstęp próbek [m]
+     * @param heightScale Wysokość jednostki próbki [m]
+     * @param heightOffset Wysokość próbki 0 [m]
+     */
+    RawTerrainSource(const std::string& path, int width, int depth, float sampleSpacing, float heightScale,
+                     float heightOffset);
+
+    /**
+     * @brief Sprawdza, czy plik istnieje i ma rozmiar width * depth * 2 B
+     * @return true jeśli plik jest poprawny
+     */
+    bool isValid() const { return m_valid; }
+
+    /**
+     * @brief Zwraca bok mapy w metrach (wzdłuż dłuższej osi)
+     * @return Bok terenu
+     */
+    float getSize() const;
+
+    bool sampleTile(float originX, float originZ, float spacing, int samples, float* output) const override;
+    glm::vec2 getHeightRange() const override;
+};
+
+#endif // TERRAIN_SOURCE_HPP
@@ -1,4 +1,6 @@
 #include "TexturedObject.hpp"
+#include "Mesh/PrimitiveData.hpp"
+#include <array>
 #include <vector>
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
@@ -159,56 +161,22 @@ TexturedCube::~TexturedCube() {}
  *
  * Tworzy 24 wierzchołki (4 na każdą ścianę) i 36 indeksów (12 trójkątów).
  * Każdy wierzchołek zawiera pozycję, normalną i koordynaty tekstury.
+ * Dane pochodzą z Primitives::CUBE, indeksy wysyłane są bez kopiowania.
  */
 void TexturedCube::create(float size) {
-    float halfSize = size / 2.0f;
-
-    std::vector<Vertex> vertices = {
-        // Front
-        {{-halfSize, -halfSize,  halfSize}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
-        {{ halfSize, -halfSize,  halfSize}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
-        {{ halfSize,  halfSize,  halfSize}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
-        {{-halfSize,  halfSize,  halfSize}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
-
-        // Back
-        {{-halfSize, -halfSize, -halfSize}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f}},
-        {{-halfSize,  halfSize, -halfSize}, {0.0f, 0.0f, -1.0f}, {1.0f, 1.0f}},
-        {{ halfSize,  halfSize, -halfSize}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f}},
-        {{ halfSize, -halfSize, -halfSize}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
-
-        // Top
-        {{-halfSize,  halfSize, -halfSize}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}},
-        {{-halfSize,  halfSize,  halfSize}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
-        {{ halfSize,  halfSize,  halfSize}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-        {{ halfSize,  halfSize, -halfSize}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},
-
-        // Bottom
-        {{-halfSize, -halfSize, -halfSize}, {0.0f, -1.0f, 0.0f}, {1.0f, 1.0f}},
-        {{ halfSize, -halfSize, -halfSize}, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
-        {{ halfSize, -halfSize,  halfSize}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
-        {{-halfSize, -halfSize,  halfSize}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
-
-        // Right
-        {{ halfSize, -halfSize, -halfSize}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
-        {{ halfSize,  halfSize, -halfSize}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-        {{ halfSize,  halfSize,  halfSize}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
-        {{ halfSize, -halfSize,  halfSize}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
-
-        // Left
-        {{-halfSize, -halfSize, -halfSize}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
-        {{-halfSize, -halfSize,  halfSize}, {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
-        {{-halfSize,  halfSize,  halfSize}, {-1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-        {{-halfSize,  halfSize, -halfSize}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}}
-    };
-
-    std::vector<unsigned int> indices = {
-        0, 1, 2, 2, 3, 0,    // Front
-        4, 5, 6, 6, 7, 4,    // Back
-        8, 9, 10, 10, 11, 8, // Top
-        12, 13, 14, 14, 15, 12, // Bottom
-        16, 17, 18, 18, 19, 16, // Right
-        20, 21, 22, 22, 23, 20  // Left
-    };
+    static_assert(sizeof(Vertex) == sizeof(Primitives::PackedVertex), "TexturedCube::Vertex musi mieć układ PackedVertex");
+
+    // Sześcian jednostkowy z danych czasu kompilacji, przeskalowany na stosie
+    std::array<Primitives::PackedVertex, Primitives::CUBE.vertices.size()> vertices = Primitives::CUBE.vertices;
+    if (size != 1.0f) {
+        for (Primitives::PackedVertex& vertex : vertices) {
+            vertex.position[0] *= size;
+            vertex.position[1] *= size;
+            vertex.position[2] *= size;
+        }
+    }
+
+    const auto& indices = Primitives::CUBE.indices;
 
     m_vertexCount = static_cast<int>(vertices.size());
     m_indexCount = static_cast<int>(indices.size());
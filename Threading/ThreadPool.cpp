@@ -0,0 +1,144 @@
+// ThreadPool.cpp
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+/**
+ * @struct ParallelJob
+ * @brief Stan jednego wywołania parallelFor współdzielony przez wątki
+ */
+struct ParallelJob {
+    const std::function<void(size_t, size_t)>* func;    /**< Przetwarzana funkcja */
+    size_t count;                                       /**< Liczba elementów */
+    size_t batchSize;                                   /**< Rozmiar porcji */
+    size_t batchCount;                                  /**< Liczba porcji */
+    std::atomic<size_t> nextBatch{0};                   /**< Następna porcja do pobrania */
+    size_t finishedBatches = 0;                         /**< Liczba ukończonych porcji */
+    std::mutex mutex;                                   /**< Blokada licznika ukończonych */
+    std::condition_variable finished;                   /**< Sygnał ukończenia */
+
+    /**
+     * @brief Pobiera i przetwarza porcje do wyczerpania zakresu
+     */
+    void run() {
+        size_t done = 0;
+        for (;;) {
+            size_t batch = nextBatch.fetch_add(1);
+            if (batch >= batchCount) break;
+            size_t begin = batch * batchSize;
+            size_t end = std::min(begin + batchSize, count);
+            (*func)(begin, end);
+            done++;
+        }
+        if (done == 0) return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        finishedBatches += done;
+        if (finishedBatches == batchCount) finished.notify_all();
+    }
+};
+
+/**
+ * @brief Konstruktor ThreadPool
+ * @param threadCount Liczba wątków roboczych (0 = liczba rdzeni - 1)
+ */
+ThreadPool::ThreadPool(unsigned threadCount) : m_stopping(false) {
+    if (threadCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 0;
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/**
+ * @brief Destruktor ThreadPool - kończy wszystkie wątki
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+/**
+ * @brief Zwraca globalną pulę wątków
+ * @return Referencja do puli
+ */
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * @brief Pętla wątku roboczego
+ */
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping && m_tasks.empty()) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+/**
+ * @brief Dodaje zadanie do kolejki
+ * @param task Zadanie
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+/**
+ * @brief Wykonuje funkcję równolegle na zakresie [0, count)
+ * @param count Liczba elementów
+ * @param minBatch Minimalna liczba elementów w porcji
+ * @param func Funkcja wywoływana dla porcji [begin, end)
+ *
+ * @details Zakres dzielony jest na około 4 porcje na wątek, aby wyrównać
+ * obciążenie, lecz nie mniejsze niż minBatch. Małe zakresy wykonywane są
+ * od razu w wątku wywołującym. Stan zadania trzymany jest we wspólnym
+ * wskaźniku, bo wątek może pobrać zadanie już po powrocie parallelFor -
+ * zastaje wtedy wyczerpany licznik porcji i nie dotyka funkcji.
+ */
+void ThreadPool::parallelFor(size_t count, size_t minBatch, const std::function<void(size_t, size_t)>& func) {
+    if (count == 0) return;
+    minBatch = std::max<size_t>(minBatch, 1);
+
+    size_t threads = m_workers.size() + 1;
+    if (threads == 1 || count <= minBatch) {
+        func(0, count);
+        return;
+    }
+
+    auto job = std::make_shared<ParallelJob>();
+    job->func = &func;
+    job->count = count;
+    job->batchSize = std::max(minBatch, (count + threads * 4 - 1) / (threads * 4));
+    job->batchCount = (count + job->batchSize - 1) / job->batchSize;
+
+    size_t helpers = std::min(m_workers.size(), job->batchCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        submit([job] { job->run(); });
+    }
+    job->run();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&job] { return job->finishedBatches == job->batchCount; });
+}
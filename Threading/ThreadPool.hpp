@@ -0,0 +1,79 @@
+// ThreadPool.hpp
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Pula wątków roboczych do równoległego przetwarzania danych klatki
+ *
+ * Wątki tworzone są raz i czekają na zadania, więc podział pracy w klatce
+ * nie kosztuje tworzenia wątków. parallelFor() dzieli zakres na porcje
+ * pobierane przez wątki z licznika atomowego; wątek wywołujący także
+ * przetwarza porcje, dlatego wywołania mogą być zagnieżdżone.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> m_workers;             /**< Wątki robocze */
+    std::deque<std::function<void()>> m_tasks;     /**< Kolejka zadań */
+    std::mutex m_mutex;                             /**< Blokada kolejki */
+    std::condition_variable m_condition;            /**< Sygnał nowego zadania */
+    bool m_stopping;                                /**< Czy pula jest zamykana */
+
+    /**
+     * @brief Pętla wątku roboczego
+     */
+    void workerLoop();
+
+public:
+    /**
+     * @brief Konstruktor ThreadPool
+     * @param threadCount Liczba wątków roboczych (0 = liczba rdzeni - 1)
+     */
+    explicit ThreadPool(unsigned threadCount = 0);
+
+    /**
+     * @brief Destruktor ThreadPool - kończy wszystkie wątki
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Zwraca globalną pulę wątków
+     * @return Referencja do puli
+     */
+    static ThreadPool& instance();
+
+    /**
+     * @brief Zwraca liczbę wątków roboczych
+     * @return Liczba wątków (bez wątku wywołującego)
+     */
+    unsigned getThreadCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+    /**
+     * @brief Dodaje zadanie do kolejki
+     * @param task Zadanie
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Wykonuje funkcję równolegle na zakresie [0, count)
+     * @param count Liczba elementów
+     * @param minBatch Minimalna liczba elementów w porcji
+     * @param func Funkcja wywoływana dla porcji [begin, end)
+     *
+     * Funkcja wraca dopiero po przetworzeniu całego zakresu.
+     */
+    void parallelFor(size_t count, size_t minBatch, const std::function<void(size_t, size_t)>& func);
+};
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,91 @@
+// PointCloudConverter.cpp
+// Budowanie pliku oktalnego drzewa chmury punktów dla PointCloudRenderer.
+// Budowany z opcją SILNIK_BUILD_TOOLS (nie wymaga kontekstu OpenGL).
+#include "../PointCloud/PointCloudBuilder.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Wypisuje sposób użycia
+ */
+static void printUsage() {
+    std::cout << "Uzycie: PointCloudConverter <wejscie> <wyjscie.octree> [opcje]\n"
+              << "  <wejscie>             plik .xyz (tekst: x y z [r g b]), plik binarny\n"
+              << "                        (x y z float + RGBA8, 16 B na punkt)\n"
+              << "                        lub --synthetic <liczba> (syntetyczny teren)\n"
+              << "  --extent <bok>        bok terenu syntetycznego (domyslnie 100)\n"
+              << "  --max-node <punkty>   najwiecej punktow w lisciu (domyslnie 20000)\n"
+              << "  --max-chunk <punkty>  najwieksza porcja budowana w pamieci (domyslnie 2000000)\n"
+              << "  --temp <katalog>      katalog plikow posrednich" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    std::string input = argv[1];
+    int argument = 2;
+    uint64_t syntheticCount = 0;
+    if (input == "--synthetic") {
+        if (argc < 4) {
+            printUsage();
+            return 1;
+        }
+        syntheticCount = std::strtoull(argv[2], nullptr, 10);
+        argument = 3;
+    }
+    std::string output = argv[argument++];
+
+    PointCloudBuildSettings settings;
+    float extent = 100.0f;
+    for (; argument + 1 < argc; argument += 2) {
+        std::string option = argv[argument];
+        const char* value = argv[argument + 1];
+        if (option == "--extent") {
+            extent = std::strtof(value, nullptr);
+        } else if (option == "--max-node") {
+            settings.maxNodePoints = std::strtoull(value, nullptr, 10);
+        } else if (option == "--max-chunk") {
+            settings.maxChunkPoints = std::strtoull(value, nullptr, 10);
+        } else if (option == "--temp") {
+            settings.temporaryDirectory = value;
+        } else {
+            std::cerr << "Blad: Nieznana opcja " << option << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+    if (argument < argc) {
+        std::cerr << "Blad: Brak wartosci opcji " << argv[argument] << std::endl;
+        return 1;
+    }
+    if (settings.maxNodePoints == 0 || settings.maxChunkPoints < settings.maxNodePoints) {
+        std::cerr << "Blad: Porcja musi miescic co najmniej jeden lisc" << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<PointCloudSource> source;
+    if (syntheticCount > 0) {
+        source = std::make_unique<SyntheticPointCloudSource>(syntheticCount, extent);
+    } else if (input.size() >= 4 && input.compare(input.size() - 4, 4, ".xyz") == 0) {
+        auto xyz = std::make_unique<XyzPointCloudSource>(input);
+        if (!xyz->isOpen()) {
+            std::cerr << "Blad: Nie udalo sie otworzyc " << input << std::endl;
+            return 1;
+        }
+        source = std::move(xyz);
+    } else {
+        auto raw = std::make_unique<RawPointCloudSource>(input);
+        if (!raw->isOpen()) {
+            std::cerr << "Blad: Nie udalo sie otworzyc " << input << std::endl;
+            return 1;
+        }
+        source = std::move(raw);
+    }
+
+    return PointCloudBuilder::build(*source, output, settings) ? 0 : 1;
+}
@@ -2,6 +2,7 @@
 #include "TransformableGeometry.hpp"
 #include "../ComplexObject.hpp"
 #include "../GeometryRenderer.hpp"
+#include "../Mesh/LodChain.hpp"
 #include <iostream>
 
 /**
@@ -9,24 +10,30 @@
  * @param color Kolor sześcianu
  */
 CubeObject::CubeObject(const glm::vec3& color) : m_color(color) {
+    setMaterial(MaterialTable::fromColor(m_color));
 }
 
 /**
  * @brief Rysuje sześcian
  *
- * Jeśli renderer jest dostępny, ustawia kolor i rysuje jednostkowy sześcian
- * z uwzględnieniem skali w macierzy modelu
+ * Jeśli renderer jest dostępny, rysuje jednostkowy sześcian z uwzględnieniem
+ * skali w macierzy modelu. Materiał shader pobiera z tabeli materiałów.
  */
 void CubeObject::draw() const {
     if (!m_renderer) return;
 
-    // Ustaw kolor
-    m_renderer->setColor(m_color);
-
     // Rysuj jednostkowy sześcian (scale jest uwzględniony w macierzy modelu)
     m_renderer->drawCube(glm::vec3(0.0f), glm::vec3(1.0f), getEulerAngles());
 }
 
+/**
+ * @brief Zwraca siatkę jednostkowego sześcianu
+ * @return Siatka z renderera lub nullptr bez renderera
+ */
+const MeshData* CubeObject::getMeshData() const {
+    return m_renderer ? &m_renderer->getMeshData(PrimitiveType::CUBE) : nullptr;
+}
+
 /**
  * @brief Konstruktor SphereObject
  * @param radius Promień sfery
@@ -34,22 +41,34 @@ void CubeObject::draw() const {
  */
 SphereObject::SphereObject(float radius, const glm::vec3& color)
     : m_radius(radius), m_color(color) {
+    setMaterial(MaterialTable::fromColor(m_color));
 }
 
 /**
  * @brief Rysuje sferę
  *
- * Jeśli renderer jest dostępny, ustawia kolor i rysuje sferę
- * z aktualną pozycją i promieniem
+ * Jeśli renderer jest dostępny, rysuje sferę z aktualną pozycją i promieniem
  */
 void SphereObject::draw() const {
     if (!m_renderer) return;
 
-    // Ustaw kolor
-    m_renderer->setColor(m_color);
+    // Rysuj sferę w poziomie szczegółowości dobranym do odległości (siatka ma promień 1)
+    BoundingSphere bounds = getWorldBounds();
+    int lod = LodSelector::instance().select(m_renderer->getSphereLodErrors(), bounds, bounds.radius);
+    if (lod == 0) {
+        // Pełna siatka: meshlety poza widokiem lub odwrócone tyłem są pomijane
+        m_renderer->drawSphereMeshlets(getModelMatrix());
+    } else {
+        m_renderer->drawSphere(getPosition(), m_radius, lod);
+    }
+}
 
-    // Rysuj sferę
-    m_renderer->drawSphere(getPosition(), m_radius);
+/**
+ * @brief Zwraca siatkę sfery
+ * @return Siatka z renderera lub nullptr bez renderera
+ */
+const MeshData* SphereObject::getMeshData() const {
+    return m_renderer ? &m_renderer->getMeshData(PrimitiveType::SPHERE) : nullptr;
 }
 
 /**
@@ -60,24 +79,58 @@ void SphereObject::draw() const {
  */
 CylinderObject::CylinderObject(float height, float radius, const glm::vec3& color)
     : m_height(height), m_radius(radius), m_color(color) {
+    setMaterial(MaterialTable::fromColor(m_color));
 }
 
 /**
  * @brief Rysuje cylinder
  *
- * Jeśli renderer jest dostępny, ustawia kolor i rysuje cylinder
- * z aktualną pozycją, wysokością i promieniem
+ * Jeśli renderer jest dostępny, rysuje cylinder z aktualną pozycją,
+ * wysokością i promieniem
  */
 void CylinderObject::draw() const {
     if (!m_renderer) return;
 
-    // Ustaw kolor
-    m_renderer->setColor(m_color);
-
     // Rysuj cylinder
     m_renderer->drawCylinder(getPosition(), m_height, m_radius);
 }
 
+/**
+ * @brief Zwraca siatkę jednostkowego cylindra
+ * @return Siatka z renderera lub nullptr bez renderera
+ */
+const MeshData* CylinderObject::getMeshData() const {
+    return m_renderer ? &m_renderer->getMeshData(PrimitiveType::CYLINDER) : nullptr;
+}
+
+/**
+ * @brief Konstruktor PlaneObject
+ * @param color Kolor płaszczyzny
+ */
+PlaneObject::PlaneObject(const glm::vec3& color) : m_color(color) {
+    setMaterial(MaterialTable::fromColor(m_color));
+}
+
+/**
+ * @brief Rysuje płaszczyznę
+ *
+ * Jeśli renderer jest dostępny, rysuje jednostkową płaszczyznę
+ * (wymiary i pozycja pochodzą z macierzy modelu)
+ */
+void PlaneObject::draw() const {
+    if (!m_renderer) return;
+
+    m_renderer->drawPlane(glm::vec3(0.0f), glm::vec2(1.0f));
+}
+
+/**
+ * @brief Zwraca siatkę jednostkowej płaszczyzny
+ * @return Siatka z renderera lub nullptr bez renderera
+ */
+const MeshData* PlaneObject::getMeshData() const {
+    return m_renderer ? &m_renderer->getMeshData(PrimitiveType::PLANE) : nullptr;
+}
+
 /**
  * @brief Konstruktor ComplexObjectWithTransform
  * @param width Szerokość litery H
@@ -87,9 +140,10 @@ void CylinderObject::draw() const {
  */
 ComplexObjectWithTransform::ComplexObjectWithTransform(float width, float height, float depth,
                                                        const glm::vec3& color)
-    : m_color(color) {
+    : m_localRadius(0.0f), m_color(color) {
+    setMaterial(MaterialTable::fromColor(m_color));
     m_complexObject = std::make_unique<ComplexObject>();
-    m_complexObject->createLetterH(width, height, depth, color);
+    createLetterH(width, height, depth);
 }
 
 /**
@@ -109,32 +163,46 @@ void ComplexObjectWithTransform::createLetterH(float width, float height, float
     if (m_complexObject) {
         m_complexObject->createLetterH(width, height, depth, m_color);
     }
+
+    // Pionowe belki sięgają ±width/2 i ±height/2, grubość belek to 0.2 * width
+    m_localRadius = glm::length(glm::vec3(width * 0.5f, height * 0.5f, width * 0.1f));
 }
 
 /**
  * @brief Rysuje złożony obiekt
  *
- * Jeśli complexObject i renderer są dostępne, ustawia kolor i rysuje obiekt
+ * Jeśli complexObject i renderer są dostępne, rysuje obiekt
  */
 void ComplexObjectWithTransform::draw() const {
     if (!m_complexObject || !m_renderer) return;
 
-    // Ustaw kolor
-    m_renderer->setColor(m_color);
-
-    // Rysuj obiekt złożony
-    m_complexObject->draw();
+    // Rysuj obiekt złożony w poziomie szczegółowości dobranym do odległości
+    BoundingSphere bounds = getWorldBounds();
+    float scale = m_localRadius > 0.0f ? bounds.radius / m_localRadius : 1.0f;
+    int lod = LodSelector::instance().select(m_complexObject->getLodErrors(), bounds, scale);
+    if (lod == 0) {
+        m_complexObject->drawMeshlets(getModelMatrix());
+    } else {
+        m_complexObject->draw(lod);
+    }
 }
 
 /**
  * @brief Ustawia nowy kolor obiektu
  * @param color Nowy kolor
  *
- * @note W tej implementacji kolor jest ustawiany tylko podczas tworzenia,
- * zmiana koloru wymagałaby przerobienia tworzenia obiektu
+ * @details Siatka litery nie przechowuje koloru, więc wystarczy
+ * zaktualizować wpis materiału.
  */
 void ComplexObjectWithTransform::setColor(const glm::vec3& color) {
     m_color = color;
-    // Aby zmienić kolor, trzeba by przerobić tworzenie obiektu
-    // W tej implementacji kolor jest ustawiany tylko podczas tworzenia
-}
\ No newline at end of file
+    setMaterial(MaterialTable::fromColor(color));
+}
+
+/**
+ * @brief Zwraca siatkę litery H
+ * @return Siatka obiektu złożonego
+ */
+const MeshData* ComplexObjectWithTransform::getMeshData() const {
+    return m_complexObject ? &m_complexObject->getMeshData() : nullptr;
+}
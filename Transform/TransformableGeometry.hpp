@@ -41,8 +41,22 @@ public:
     /**
      * @brief Ustawia nowy kolor sześcianu
      * @param color Nowy kolor
+     *
+     * Kolor trafia do materiału obiektu w MaterialTable.
+     */
+    void setColor(const glm::vec3& color) override { m_color = color; setMaterial(MaterialTable::fromColor(color)); }
+
+    /**
+     * @brief Zwraca sferę otaczającą jednostkowy sześcian
+     * @return Sfera o promieniu połowy przekątnej sześcianu
      */
-    void setColor(const glm::vec3& color) override { m_color = color; }
+    BoundingSphere getLocalBounds() const override { return {glm::vec3(0.0f), 0.8660254f}; }
+
+    /**
+     * @brief Zwraca siatkę jednostkowego sześcianu
+     * @return Siatka z renderera lub nullptr bez renderera
+     */
+    const MeshData* getMeshData() const override;
 };
 
 /**
@@ -91,8 +105,22 @@ public:
     /**
      * @brief Ustawia nowy kolor sfery
      * @param color Nowy kolor
+     *
+     * Kolor trafia do materiału obiektu w MaterialTable.
      */
-    void setColor(const glm::vec3& color) override { m_color = color; }
+    void setColor(const glm::vec3& color) override { m_color = color; setMaterial(MaterialTable::fromColor(color)); }
+
+    /**
+     * @brief Zwraca siatkę sfery
+     * @return Siatka z renderera lub nullptr bez renderera
+     */
+    const MeshData* getMeshData() const override;
+
+    /**
+     * @brief Zwraca kształt parametryczny sfery
+     * @return PrimitiveType::SPHERE
+     */
+    PrimitiveType getPrimitiveType() const override { return PrimitiveType::SPHERE; }
 };
 
 /**
@@ -156,8 +184,78 @@ public:
     /**
      * @brief Ustawia nowy kolor cylindra
      * @param color Nowy kolor
+     *
+     * Kolor trafia do materiału obiektu w MaterialTable.
+     */
+    void setColor(const glm::vec3& color) override { m_color = color; setMaterial(MaterialTable::fromColor(color)); }
+
+    /**
+     * @brief Zwraca sferę otaczającą jednostkowy cylinder
+     * @return Sfera obejmująca cylinder o promieniu 1 i wysokości 1
+     */
+    BoundingSphere getLocalBounds() const override { return {glm::vec3(0.0f), 1.1180340f}; }
+
+    /**
+     * @brief Zwraca siatkę jednostkowego cylindra
+     * @return Siatka z renderera lub nullptr bez renderera
+     */
+    const MeshData* getMeshData() const override;
+
+    /**
+     * @brief Zwraca kształt parametryczny cylindra
+     * @return PrimitiveType::CYLINDER
+     */
+    PrimitiveType getPrimitiveType() const override { return PrimitiveType::CYLINDER; }
+};
+
+/**
+ * @class PlaneObject
+ * @brief Klasa reprezentująca płaszczyznę (np. podłogę) jako transformowalny obiekt
+ *
+ * Rysuje jednostkową płaszczyznę XZ - wymiary nadaje skala obiektu
+ */
+class PlaneObject : public TransformableObject {
+private:
+    glm::vec3 m_color;
+
+public:
+    /**
+     * @brief Konstruktor PlaneObject
+     * @param color Kolor płaszczyzny (domyślnie szary)
+     */
+    PlaneObject(const glm::vec3& color = glm::vec3(0.3f, 0.3f, 0.3f));
+
+    /**
+     * @brief Rysuje płaszczyznę
+     * @override
+     */
+    void draw() const override;
+
+    /**
+     * @brief Zwraca kolor płaszczyzny
+     * @return Aktualny kolor obiektu
+     */
+    glm::vec3 getColor() const override { return m_color; }
+
+    /**
+     * @brief Ustawia nowy kolor płaszczyzny
+     * @param color Nowy kolor
+     *
+     * Kolor trafia do materiału obiektu w MaterialTable.
+     */
+    void setColor(const glm::vec3& color) override { m_color = color; setMaterial(MaterialTable::fromColor(color)); }
+
+    /**
+     * @brief Zwraca sferę otaczającą jednostkową płaszczyznę
+     * @return Sfera o promieniu połowy przekątnej kwadratu
      */
-    void setColor(const glm::vec3& color) override { m_color = color; }
+    BoundingSphere getLocalBounds() const override { return {glm::vec3(0.0f), 0.7071068f}; }
+
+    /**
+     * @brief Zwraca siatkę jednostkowej płaszczyzny
+     * @return Siatka z renderera lub nullptr bez renderera
+     */
+    const MeshData* getMeshData() const override;
 };
 
 /**
@@ -169,6 +267,7 @@ public:
 class ComplexObjectWithTransform : public TransformableObject {
 private:
     std::unique_ptr<ComplexObject> m_complexObject;
+    float m_localRadius;                /**< Promień sfery otaczającej w przestrzeni lokalnej */
     glm::vec3 m_color;
 
 public:
@@ -213,10 +312,22 @@ public:
      * @brief Ustawia nowy kolor obiektu
      * @param color Nowy kolor
      *
-     * @note W tej implementacji kolor jest ustawiany tylko podczas tworzenia,
-     * zmiana koloru wymagałaby przerobienia tworzenia obiektu
+     * Kolor trafia do materiału obiektu w MaterialTable, więc siatka
+     * nie musi być tworzona ponownie.
      */
     void setColor(const glm::vec3& color) override;
+
+    /**
+     * @brief Zwraca sferę otaczającą literę H
+     * @return Sfera wyznaczona z wymiarów litery
+     */
+    BoundingSphere getLocalBounds() const override { return {glm::vec3(0.0f), m_localRadius}; }
+
+    /**
+     * @brief Zwraca siatkę litery H
+     * @return Siatka obiektu złożonego
+     */
+    const MeshData* getMeshData() const override;
 };
 
 #endif // TRANSFORMABLE_GEOMETRY_HPP
\ No newline at end of file
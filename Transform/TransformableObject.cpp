@@ -4,16 +4,20 @@
 /**
  * @brief Konstruktor TransformableObject
  *
- * Inicjalizuje transformację i ustawia renderer na nullptr
+ * Inicjalizuje transformację, ustawia renderer na nullptr i pobiera
+ * odwołanie do wspólnego białego materiału (do czasu ustawienia koloru)
  */
 TransformableObject::TransformableObject()
-    : m_transform(std::make_unique<Transform>()), m_renderer(nullptr) {
+    : m_transform(std::make_unique<Transform>()), m_renderer(nullptr),
+      m_materialId(MaterialTable::instance().createMaterial(MaterialTable::fromColor(glm::vec3(1.0f)))),
+      m_static(false), m_dissolve(0.0f) {
 }
 
 /**
- * @brief Destruktor TransformableObject
+ * @brief Destruktor TransformableObject - zwalnia odwołanie do materiału
  */
 TransformableObject::~TransformableObject() {
+    MaterialTable::instance().releaseMaterial(m_materialId);
 }
 
 /**
@@ -174,4 +178,43 @@ void TransformableObject::setRenderer(GeometryRenderer* renderer) {
  */
 GeometryRenderer* TransformableObject::getRenderer() const {
     return m_renderer;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Zwraca sferę otaczającą obiekt w przestrzeni lokalnej
+ * @return Sfera otaczająca siatkę przed zastosowaniem macierzy modelu
+ *
+ * @details Domyślnie jednostkowa sfera w początku układu, odpowiadająca
+ * siatkom jednostkowym z GeometryRenderer. Klasy pochodne o innej geometrii
+ * nadpisują tę metodę.
+ */
+BoundingSphere TransformableObject::getLocalBounds() const {
+    return {glm::vec3(0.0f), 1.0f};
+}
+
+/**
+ * @brief Zwraca sferę otaczającą obiekt w przestrzeni świata
+ * @return Sfera otaczająca przekształcona macierzą modelu
+ */
+BoundingSphere TransformableObject::getWorldBounds() const {
+    return getLocalBounds().transformed(getModelMatrix());
+}
+
+/**
+ * @brief Zwraca materiał obiektu
+ * @return Właściwości materiału
+ */
+const Material& TransformableObject::getMaterial() const {
+    return MaterialTable::instance().getMaterial(m_materialId);
+}
+
+/**
+ * @brief Ustawia materiał obiektu (może zmienić identyfikator materiału)
+ * @param material Nowe właściwości materiału
+ *
+ * @details Obiekty o tym samym kolorze współdzielą wpis tabeli, więc zmiana
+ * przenosi obiekt do wpisu nowego materiału zamiast nadpisywać wspólny.
+ */
+void TransformableObject::setMaterial(const Material& material) {
+    m_materialId = MaterialTable::instance().updateMaterial(m_materialId, material);
+}
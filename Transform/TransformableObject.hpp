@@ -4,6 +4,8 @@
 
 #include "Transform.hpp"
 #include "../GeometryRenderer.hpp"
+#include "../Math/Bounds.hpp"
+#include "../Material/MaterialTable.hpp"
 #include <memory>
 
 /**
@@ -17,12 +19,16 @@ class TransformableObject {
 protected:
     std::unique_ptr<Transform> m_transform;  /**< Transformacja obiektu */
     GeometryRenderer* m_renderer;            /**< Wskaźnik do renderera */
+    MaterialId m_materialId;                 /**< Wpis w tabeli materiałów (wspólny dla identycznych materiałów) */
+    bool m_static;                           /**< Czy obiekt może trafić do statycznych paczek */
+    float m_dissolve;                        /**< Udział pikseli pomijanych przy przenikaniu z impostorem */
 
 public:
     /**
      * @brief Konstruktor TransformableObject
      *
-     * Inicjalizuje transformację i ustawia renderer na nullptr
+     * Inicjalizuje transformację, ustawia renderer na nullptr i rezerwuje
+     * wpis w tabeli materiałów
      */
     TransformableObject();
 
@@ -165,6 +171,81 @@ public:
      */
     virtual void setColor(const glm::vec3& color) = 0;
 
+    /**
+     * @brief Zwraca identyfikator materiału obiektu
+     * @return Indeks w MaterialTable
+     */
+    MaterialId getMaterialId() const { return m_materialId; }
+
+    /**
+     * @brief Zwraca materiał obiektu
+     * @return Właściwości materiału
+     */
+    const Material& getMaterial() const;
+
+    /**
+     * @brief Ustawia materiał obiektu (może zmienić identyfikator materiału)
+     * @param material Nowe właściwości materiału
+     */
+    void setMaterial(const Material& material);
+
+    /**
+     * @brief Zwraca sferę otaczającą obiekt w przestrzeni lokalnej
+     * @return Sfera otaczająca siatkę przed zastosowaniem macierzy modelu
+     */
+    virtual BoundingSphere getLocalBounds() const;
+
+    /**
+     * @brief Zwraca sferę otaczającą obiekt w przestrzeni świata
+     * @return Sfera otaczająca przekształcona macierzą modelu
+     */
+    BoundingSphere getWorldBounds() const;
+
+    /**
+     * @brief Zwraca kopię CPU siatki obiektu
+     * @return Siatka w przestrzeni lokalnej lub nullptr gdy obiekt nie ma
+     *         siatki trójkątów (nie może być scalany)
+     */
+    virtual const MeshData* getMeshData() const { return nullptr; }
+
+    /**
+     * @brief Zwraca kształt parametryczny obiektu
+     * @return Kształt siatki jednostkowej obiektu lub PrimitiveType::COUNT,
+     *         gdy obiekt nie jest bryłą parametryczną (nie może być
+     *         generowany proceduralnie)
+     */
+    virtual PrimitiveType getPrimitiveType() const { return PrimitiveType::COUNT; }
+
+    /**
+     * @brief Oznacza obiekt jako statyczny
+     * @param isStatic true jeśli obiekt się nie porusza
+     *
+     * Obiekty statyczne scalane są przez StaticBatcher. Poruszenie takiego
+     * obiektu wyjmuje go z paczki - flaga jest jedynie wskazówką.
+     */
+    void setStatic(bool isStatic) { m_static = isStatic; }
+
+    /**
+     * @brief Sprawdza, czy obiekt jest oznaczony jako statyczny
+     * @return true jeśli statyczny
+     */
+    bool isStatic() const { return m_static; }
+
+    /**
+     * @brief Ustawia stopień przenikania siatki w impostor
+     * @param dissolve 0 = siatka w pełni widoczna, 1 = siatka całkowicie zastąpiona
+     *
+     * Wartość ustawiana co klatkę przez ImpostorRenderer; shader pomija
+     * piksele według uporządkowanego ditheringu.
+     */
+    void setDissolve(float dissolve) { m_dissolve = dissolve; }
+
+    /**
+     * @brief Zwraca stopień przenikania siatki w impostor
+     * @return Wartość z przedziału [0, 1]
+     */
+    float getDissolve() const { return m_dissolve; }
+
 protected:
     /**
      * @brief Zwraca wskaźnik do renderera
@@ -0,0 +1,295 @@
+// MarchingCubes.cpp
+#include "MarchingCubes.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/**
+ * @struct TriangleTable
+ * @brief Triangulacja 256 konfiguracji narożników komórki
+ */
+struct TriangleTable {
+    int8_t edges[256][MarchingCubes::MAX_CELL_TRIANGLES * 3];  /**< Krawędzie trójkątów */
+    int8_t counts[256];                                         /**< Liczba trójkątów */
+};
+
+/**
+ * @brief Zwraca indeks krawędzi łączącej dwa narożniki różniące się jednym bitem
+ * @param a Pierwszy narożnik
+ * @param b Drugi narożnik
+ * @return Indeks krawędzi (4 * oś + k)
+ */
+constexpr int edgeBetween(int a, int b) {
+    int axis = (a ^ b) == 1 ? 0 : (a ^ b) == 2 ? 1 : 2;
+    int base = a & b;
+    int u = (axis + 1) % 3, v = (axis + 2) % 3;
+    return axis * 4 + ((base >> u) & 1) + (((base >> v) & 1) << 1);
+}
+
+/**
+ * @brief Buduje tablicę triangulacji
+ * @return Tablica dla wszystkich konfiguracji
+ *
+ * @details Ściany komórki obchodzone są przeciwnie do ruchu wskazówek
+ * zegara patrząc z zewnątrz. Krawędź, na której obchód wchodzi do
+ * narożnika wewnętrznego, rozpoczyna odcinek kończący się na następnej
+ * przeciętej krawędzi ściany; przy dwóch narożnikach wewnętrznych na
+ * przekątnej daje to dwa odcinki odcinające je osobno. Każda przecięta
+ * krawędź jest początkiem jednego odcinka (na jednej ze swoich ścian)
+ * i końcem innego (na drugiej), więc odcinki tworzą zamknięte pętle
+ * zgodnie skierowane, dzielone następnie wachlarzem na trójkąty.
+ */
+constexpr TriangleTable buildTriangleTable() {
+    TriangleTable table{};
+    for (int config = 0; config < 256; ++config) {
+        int next[12] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+        for (int face = 0; face < 6; ++face) {
+            const int axis = face / 2, side = face & 1;
+            const int u = (axis + 1) % 3, v = (axis + 2) % 3;
+            const int square[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+            int cycle[4] = {};
+            for (int i = 0; i < 4; ++i) {
+                const int* uv = square[side ? i : 3 - i];
+                cycle[i] = (side << axis) | (uv[0] << u) | (uv[1] << v);
+            }
+            for (int i = 0; i < 4; ++i) {
+                bool from = (config >> cycle[i]) & 1, to = (config >> cycle[(i + 1) % 4]) & 1;
+                if (from || !to) continue;
+                for (int j = 1; j < 4; ++j) {
+                    int a = cycle[(i + j) % 4], b = cycle[(i + j + 1) % 4];
+                    if (((config >> a) & 1) != ((config >> b) & 1)) {
+                        next[edgeBetween(cycle[i], cycle[(i + 1) % 4])] = edgeBetween(a, b);
+                        break;
+                    }
+                }
+            }
+        }
+
+        int count = 0;
+        bool visited[12] = {};
+        for (int start = 0; start < 12; ++start) {
+            if (next[start] < 0 || visited[start]) continue;
+            int loop[12] = {};
+            int length = 0;
+            for (int edge = start; !visited[edge]; edge = next[edge]) {
+                visited[edge] = true;
+                loop[length++] = edge;
+            }
+            for (int k = 1; k + 1 < length; ++k) {
+                table.edges[config][count * 3 + 0] = static_cast<int8_t>(loop[0]);
+                table.edges[config][count * 3 + 1] = static_cast<int8_t>(loop[k]);
+                table.edges[config][count * 3 + 2] = static_cast<int8_t>(loop[k + 1]);
+                ++count;
+            }
+        }
+        table.counts[config] = static_cast<int8_t>(count);
+    }
+    return table;
+}
+
+constexpr TriangleTable TRIANGLES = buildTriangleTable();
+
+/**
+ * @brief Sprawdza, czy tablica zgadza się z ograniczeniami klasycznej metody
+ * @return true jeśli konfiguracje puste i pełne nie mają trójkątów, a pozostałe od 1 do 5
+ */
+constexpr bool tableIsValid() {
+    if (TRIANGLES.counts[0] != 0 || TRIANGLES.counts[255] != 0) return false;
+    for (int config = 1; config < 255; ++config) {
+        if (TRIANGLES.counts[config] < 1 || TRIANGLES.counts[config] > 5) return false;
+    }
+    return true;
+}
+
+static_assert(tableIsValid(), "Tablica triangulacji ma nieoczekiwana liczbe trojkatow");
+static_assert(TRIANGLES.counts[1] == 1 && TRIANGLES.counts[0x0F] == 2 && TRIANGLES.counts[0x69] == 4,
+              "Tablica triangulacji nie zgadza sie z przypadkami podstawowymi");
+
+/**
+ * @struct CellEdge
+ * @brief Położenie krawędzi komórki względem jej narożnika (0, 0, 0)
+ */
+struct CellEdge {
+    int offset[3];  /**< Przesunięcie początku krawędzi */
+    int axis;       /**< Oś krawędzi */
+};
+
+/**
+ * @brief Buduje położenia krawędzi komórki
+ * @return 12 krawędzi w kolejności indeksów tablicy triangulacji
+ */
+constexpr std::array<CellEdge, 12> buildCellEdges() {
+    std::array<CellEdge, 12> edges{};
+    for (int axis = 0; axis < 3; ++axis) {
+        for (int k = 0; k < 4; ++k) {
+            CellEdge& edge = edges[axis * 4 + k];
+            edge.offset[axis] = 0;
+            edge.offset[(axis + 1) % 3] = k & 1;
+            edge.offset[(axis + 2) % 3] = (k >> 1) & 1;
+            edge.axis = axis;
+        }
+    }
+    return edges;
+}
+
+constexpr std::array<CellEdge, 12> CELL_EDGES = buildCellEdges();
+
+} // namespace
+
+/**
+ * @brief Konstruktor MarchingCubes
+ */
+MarchingCubes::MarchingCubes() : m_stats{0, 0, 0, 0, 0.0} {}
+
+/**
+ * @brief Zwraca liczbę trójkątów konfiguracji narożników
+ * @param config Maska narożników wewnątrz (bit i = narożnik i)
+ * @return Liczba trójkątów
+ */
+int MarchingCubes::getTriangleCount(int config) {
+    return TRIANGLES.counts[config & 255];
+}
+
+/**
+ * @brief Zwraca krawędzie trójkątów konfiguracji narożników
+ * @param config Maska narożników wewnątrz (bit i = narożnik i)
+ * @return Indeksy krawędzi komórki, po trzy na trójkąt
+ */
+const int8_t* MarchingCubes::getTriangleEdges(int config) {
+    return TRIANGLES.edges[config & 255];
+}
+
+/**
+ * @brief Tworzy siatkę jednego bloku
+ * @param volume Siatka wartości
+ * @param isoValue Izowartość
+ * @param brick Indeks bloku
+ * @param out Siatka bloku
+ * @param inside Bufor roboczy: czy próbka bloku jest wewnątrz
+ * @param edgeVertices Bufor roboczy: wierzchołek krawędzi bloku
+ *
+ * @details Najpierw dla każdej próbki bloku zapisywany jest jeden bit
+ * (wnętrze), z którego składane są konfiguracje komórek; próbki i gradienty
+ * czytane są tylko dla przeciętych krawędzi. Krawędź identyfikowana jest
+ * przez próbkę początkową w bloku i oś, więc wierzchołek powstaje raz,
+ * choć krawędź należy do czterech komórek.
+ */
+void MarchingCubes::extractBrick(const ScalarVolume& volume, float isoValue, int brick, BrickMesh& out,
+                                 std::vector<uint8_t>& inside, std::vector<uint32_t>& edgeVertices) {
+    const int N = ScalarVolume::BRICK_CELLS + 1;
+    const glm::ivec3 lo = volume.brickCoord(brick) * ScalarVolume::BRICK_CELLS;
+    const glm::ivec3 cells = glm::min(lo + ScalarVolume::BRICK_CELLS, volume.getSize() - 1) - lo;
+    const float* values = volume.getValues().data();
+    const glm::vec3 origin = volume.getOrigin();
+    const glm::vec3 spacing = volume.getSpacing();
+
+    out.vertices.clear();
+    out.indices.clear();
+    inside.resize(static_cast<size_t>(N) * N * N);
+    edgeVertices.assign(static_cast<size_t>(N) * N * N * 3, UINT32_MAX);
+
+    for (int z = 0; z <= cells.z; ++z) {
+        for (int y = 0; y <= cells.y; ++y) {
+            const float* row = values + volume.index(lo.x, lo.y + y, lo.z + z);
+            uint8_t* target = inside.data() + (z * N + y) * N;
+            for (int x = 0; x <= cells.x; ++x) target[x] = row[x] >= isoValue ? 1 : 0;
+        }
+    }
+
+    const int cornerOffsets[8] = {0, 1, N, N + 1, N * N, N * N + 1, N * N + N, N * N + N + 1};
+    for (int z = 0; z < cells.z; ++z) {
+        for (int y = 0; y < cells.y; ++y) {
+            for (int x = 0; x < cells.x; ++x) {
+                const int cell = (z * N + y) * N + x;
+                int config = 0;
+                for (int corner = 0; corner < 8; ++corner) config |= inside[cell + cornerOffsets[corner]] << corner;
+                const int triangles = TRIANGLES.counts[config];
+                if (triangles == 0) continue;
+
+                const int8_t* edges = TRIANGLES.edges[config];
+                for (int k = 0; k < triangles * 3; ++k) {
+                    const CellEdge& edge = CELL_EDGES[edges[k]];
+                    const int sx = x + edge.offset[0], sy = y + edge.offset[1], sz = z + edge.offset[2];
+                    uint32_t& cached = edgeVertices[((sz * N + sy) * N + sx) * 3 + edge.axis];
+                    if (cached == UINT32_MAX) {
+                        glm::ivec3 a = lo + glm::ivec3(sx, sy, sz);
+                        glm::ivec3 b = a;
+                        b[edge.axis] += 1;
+                        float va = values[volume.index(a.x, a.y, a.z)];
+                        float vb = values[volume.index(b.x, b.y, b.z)];
+                        float t = glm::clamp((isoValue - va) / (vb - va), 0.0f, 1.0f);
+
+                        glm::vec3 gradient = glm::mix(volume.gradient(a.x, a.y, a.z), volume.gradient(b.x, b.y, b.z), t);
+                        float length = glm::length(gradient);
+                        glm::vec3 normal(0.0f, 1.0f, 0.0f);
+                        if (length > 1e-12f) normal = -gradient / length;
+
+                        glm::vec3 position = origin + glm::mix(glm::vec3(a), glm::vec3(b), t) * spacing;
+                        cached = static_cast<uint32_t>(out.vertices.size());
+                        out.vertices.push_back({position, normal, glm::vec2(0.0f)});
+                    }
+                    out.indices.push_back(cached);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tworzy izopowierzchnię
+ * @param volume Siatka wartości (z aktualnymi zakresami bloków)
+ * @param isoValue Izowartość
+ * @param mesh Wynik (poprzednia zawartość jest zastępowana)
+ *
+ * @details Bloki aktywne dzielone są między wątki; każda porcja ma własne
+ * bufory robocze. Siatki bloków łączone są równolegle po policzeniu
+ * przesunięć (sumy prefiksowe), z indeksami przesuniętymi o początek bloku.
+ */
+void MarchingCubes::extract(const ScalarVolume& volume, float isoValue, MeshData& mesh) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    m_activeBricks.clear();
+    for (int brick = 0; brick < volume.getBrickCount(); ++brick) {
+        if (volume.brickMayContain(brick, isoValue)) m_activeBricks.push_back(brick);
+    }
+    if (m_brickMeshes.size() < m_activeBricks.size()) m_brickMeshes.resize(m_activeBricks.size());
+
+    ThreadPool::instance().parallelFor(m_activeBricks.size(), 1, [&](size_t begin, size_t end) {
+        std::vector<uint8_t> inside;
+        std::vector<uint32_t> edgeVertices;
+        for (size_t i = begin; i < end; ++i) {
+            extractBrick(volume, isoValue, m_activeBricks[i], m_brickMeshes[i], inside, edgeVertices);
+        }
+    });
+
+    std::vector<size_t> vertexOffsets(m_activeBricks.size() + 1, 0);
+    std::vector<size_t> indexOffsets(m_activeBricks.size() + 1, 0);
+    for (size_t i = 0; i < m_activeBricks.size(); ++i) {
+        vertexOffsets[i + 1] = vertexOffsets[i] + m_brickMeshes[i].vertices.size();
+        indexOffsets[i + 1] = indexOffsets[i] + m_brickMeshes[i].indices.size();
+    }
+    mesh.vertices.resize(vertexOffsets.back());
+    mesh.indices.resize(indexOffsets.back());
+
+    ThreadPool::instance().parallelFor(m_activeBricks.size(), 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const BrickMesh& brickMesh = m_brickMeshes[i];
+            std::copy(brickMesh.vertices.begin(), brickMesh.vertices.end(), mesh.vertices.begin() + vertexOffsets[i]);
+            const unsigned int base = static_cast<unsigned int>(vertexOffsets[i]);
+            unsigned int* target = mesh.indices.data() + indexOffsets[i];
+            for (size_t k = 0; k < brickMesh.indices.size(); ++k) target[k] = brickMesh.indices[k] + base;
+        }
+    });
+
+    m_stats.bricks = volume.getBrickCount();
+    m_stats.activeBricks = static_cast<int>(m_activeBricks.size());
+    m_stats.vertices = mesh.vertices.size();
+    m_stats.triangles = mesh.indices.size() / 3;
+    m_stats.milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
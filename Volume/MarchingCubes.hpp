@@ -0,0 +1,116 @@
+// MarchingCubes.hpp
+#ifndef MARCHING_CUBES_HPP
+#define MARCHING_CUBES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../GeometryRenderer.hpp"
+#include "ScalarVolume.hpp"
+
+/**
+ * @struct MarchingCubesStats
+ * @brief Wyniki ostatniej ekstrakcji izopowierzchni
+ */
+struct MarchingCubesStats {
+    int bricks;             /**< Bloki siatki */
+    int activeBricks;       /**< Bloki, przez które może przechodzić powierzchnia */
+    size_t vertices;        /**< Wierzchołki siatki wynikowej */
+    size_t triangles;       /**< Trójkąty siatki wynikowej */
+    double milliseconds;    /**< Czas ekstrakcji [ms] */
+};
+
+/**
+ * @class MarchingCubes
+ * @brief Równoległa ekstrakcja izopowierzchni metodą maszerujących sześcianów
+ *
+ * Powierzchnia oddziela próbki o wartości >= izowartości (wnętrze) od
+ * pozostałych; normalne liczone są z gradientu pola i skierowane na
+ * zewnątrz. Każdy blok ScalarVolume, którego zakres wartości obejmuje
+ * izowartość, przetwarzany jest osobnym zadaniem ThreadPool: wierzchołki
+ * na krawędziach komórek są wspólne w obrębie bloku (pamięć podręczna
+ * krawędzi bloku), a na granicy bloków powtarzane. Bloki bez przejścia
+ * pomijane są bez czytania próbek.
+ *
+ * Tablica triangulacji budowana jest w czasie kompilacji z konfiguracji
+ * narożników: odcinki na ścianach komórki łączone są w pętle, a niejasne
+ * ściany (dwa przeciwległe narożniki wewnątrz) rozstrzygane zawsze tak
+ * samo, z rozdzielonymi narożnikami wewnętrznymi. Rozstrzygnięcie zależy
+ * tylko od ściany, więc sąsiednie komórki dają te same krawędzie
+ * i powierzchnia jest szczelna.
+ *
+ * Wynik to MeshData w układzie Vertex (pozycje w przestrzeni świata),
+ * gotowy dla GeometryRenderer::setupMesh(). Obiekt zachowuje bufory
+ * bloków, więc ponowna ekstrakcja dla innej izowartości nie alokuje
+ * pamięci, o ile siatka nie rośnie.
+ */
+class MarchingCubes {
+public:
+    static const int MAX_CELL_TRIANGLES = 12;  /**< Górne ograniczenie trójkątów komórki w tablicy */
+
+private:
+    /**
+     * @struct BrickMesh
+     * @brief Siatka jednego bloku
+     */
+    struct BrickMesh {
+        std::vector<Vertex> vertices;       /**< Wierzchołki bloku */
+        std::vector<unsigned int> indices;  /**< Indeksy lokalne bloku */
+    };
+
+    std::vector<BrickMesh> m_brickMeshes;   /**< Siatki aktywnych bloków (bufory używane ponownie) */
+    std::vector<int> m_activeBricks;        /**< Bloki przetwarzane w bieżącej ekstrakcji */
+    MarchingCubesStats m_stats;             /**< Wyniki ostatniej ekstrakcji */
+
+    /**
+     * @brief Tworzy siatkę jednego bloku
+     * @param volume Siatka wartości
+     * @param isoValue Izowartość
+     * @param brick Indeks bloku
+     * @param out Siatka bloku
+     * @param inside Bufor roboczy: czy próbka bloku jest wewnątrz
+     * @param edgeVertices Bufor roboczy: wierzchołek krawędzi bloku
+     */
+    static void extractBrick(const ScalarVolume& volume, float isoValue, int brick, BrickMesh& out,
+                             std::vector<uint8_t>& inside, std::vector<uint32_t>& edgeVertices);
+
+public:
+    /**
+     * @brief Konstruktor MarchingCubes
+     */
+    MarchingCubes();
+
+    /**
+     * @brief Tworzy izopowierzchnię
+     * @param volume Siatka wartości (z aktualnymi zakresami bloków)
+     * @param isoValue Izowartość
+     * @param mesh Wynik (poprzednia zawartość jest zastępowana)
+     */
+    void extract(const ScalarVolume& volume, float isoValue, MeshData& mesh);
+
+    /**
+     * @brief Zwraca wyniki ostatniej ekstrakcji
+     * @return Statystyki
+     */
+    const MarchingCubesStats& getStats() const { return m_stats; }
+
+    /**
+     * @brief Zwraca liczbę trójkątów konfiguracji narożników
+     * @param config Maska narożników wewnątrz (bit i = narożnik i)
+     * @return Liczba trójkątów
+     */
+    static int getTriangleCount(int config);
+
+    /**
+     * @brief Zwraca krawędzie trójkątów konfiguracji narożników
+     * @param config Maska narożników wewnątrz (bit i = narożnik i)
+     * @return Indeksy krawędzi komórki, po trzy na trójkąt
+     *
+     * Narożnik i leży w (i & 1, (i >> 1) & 1, (i >> 2) & 1). Krawędź
+     * 4 * a + k biegnie wzdłuż osi a z narożnika, którego bity osi
+     * (a + 1) % 3 i (a + 2) % 3 to bity 0 i 1 liczby k.
+     */
+    static const int8_t* getTriangleEdges(int config);
+};
+
+#endif // MARCHING_CUBES_HPP
@@ -0,0 +1,108 @@
+// ScalarVolume.cpp
+#include "ScalarVolume.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+
+/**
+ * @brief Konstruktor ScalarVolume - siatka wypełniona zerami
+ * @param size Liczba próbek w osiach (co najmniej 2)
+ * @param origin Pozycja próbki (0, 0, 0)
+ * @param spacing Odstęp próbek w osiach
+ */
+ScalarVolume::ScalarVolume(const glm::ivec3& size, const glm::vec3& origin, const glm::vec3& spacing)
+    : m_size(glm::max(size, glm::ivec3(2))), m_origin(origin), m_spacing(spacing) {
+    m_values.assign(static_cast<size_t>(m_size.x) * m_size.y * m_size.z, 0.0f);
+    glm::ivec3 cells = m_size - 1;
+    m_brickCounts = (cells + (BRICK_CELLS - 1)) / BRICK_CELLS;
+    m_brickRanges.assign(static_cast<size_t>(m_brickCounts.x) * m_brickCounts.y * m_brickCounts.z,
+                         glm::vec2(0.0f));
+}
+
+/**
+ * @brief Zwraca prostopadłościan otaczający siatkę
+ * @return AABB w przestrzeni świata
+ */
+BoundingBox ScalarVolume::getBounds() const {
+    return {m_origin, m_origin + glm::vec3(m_size - 1) * m_spacing};
+}
+
+/**
+ * @brief Zwraca gradient w węźle (różnice centralne, na brzegu jednostronne)
+ * @param x Kolumna
+ * @param y Wiersz
+ * @param z Warstwa
+ * @return Gradient w przestrzeni świata
+ */
+glm::vec3 ScalarVolume::gradient(int x, int y, int z) const {
+    int x0 = std::max(x - 1, 0), x1 = std::min(x + 1, m_size.x - 1);
+    int y0 = std::max(y - 1, 0), y1 = std::min(y + 1, m_size.y - 1);
+    int z0 = std::max(z - 1, 0), z1 = std::min(z + 1, m_size.z - 1);
+    return glm::vec3((value(x1, y, z) - value(x0, y, z)) / (static_cast<float>(x1 - x0) * m_spacing.x),
+                     (value(x, y1, z) - value(x, y0, z)) / (static_cast<float>(y1 - y0) * m_spacing.y),
+                     (value(x, y, z1) - value(x, y, z0)) / (static_cast<float>(z1 - z0) * m_spacing.z));
+}
+
+/**
+ * @brief Wypełnia siatkę funkcją pozycji, równolegle po warstwach
+ * @param function Wartość w punkcie przestrzeni świata
+ *
+ * @details Funkcja wywoływana jest jednocześnie z wielu wątków.
+ */
+void ScalarVolume::generate(const std::function<float(const glm::vec3& position)>& function) {
+    ThreadPool::instance().parallelFor(static_cast<size_t>(m_size.z), 1, [&](size_t begin, size_t end) {
+        for (int z = static_cast<int>(begin); z < static_cast<int>(end); ++z) {
+            for (int y = 0; y < m_size.y; ++y) {
+                float* row = m_values.data() + index(0, y, z);
+                for (int x = 0; x < m_size.x; ++x) {
+                    row[x] = function(m_origin + glm::vec3(x, y, z) * m_spacing);
+                }
+            }
+        }
+    });
+    updateBrickRanges();
+}
+
+/**
+ * @brief Przelicza minimum i maksimum próbek wszystkich bloków
+ *
+ * @details Blok obejmuje próbki od swojego pierwszego węzła do pierwszego
+ * węzła następnego bloku włącznie, bo tyle potrzebują jego komórki.
+ */
+void ScalarVolume::updateBrickRanges() {
+    ThreadPool::instance().parallelFor(m_brickRanges.size(), 16, [this](size_t begin, size_t end) {
+        for (size_t brick = begin; brick < end; ++brick) {
+            glm::ivec3 lo = brickCoord(static_cast<int>(brick)) * BRICK_CELLS;
+            glm::ivec3 hi = glm::min(lo + BRICK_CELLS, m_size - 1);
+            float minValue = value(lo.x, lo.y, lo.z);
+            float maxValue = minValue;
+            for (int z = lo.z; z <= hi.z; ++z) {
+                for (int y = lo.y; y <= hi.y; ++y) {
+                    const float* row = m_values.data() + index(0, y, z);
+                    for (int x = lo.x; x <= hi.x; ++x) {
+                        minValue = std::min(minValue, row[x]);
+                        maxValue = std::max(maxValue, row[x]);
+                    }
+                }
+            }
+            m_brickRanges[brick] = glm::vec2(minValue, maxValue);
+        }
+    });
+}
+
+/**
+ * @brief Zwraca współrzędne bloku
+ * @param brick Indeks bloku
+ * @return Współrzędne bloku
+ */
+glm::ivec3 ScalarVolume::brickCoord(int brick) const {
+    return glm::ivec3(brick % m_brickCounts.x, (brick / m_brickCounts.x) % m_brickCounts.y,
+                      brick / (m_brickCounts.x * m_brickCounts.y));
+}
+
+/**
+ * @brief Zwraca zajmowaną pamięć
+ * @return Liczba bajtów
+ */
+size_t ScalarVolume::getMemoryUsage() const {
+    return m_values.capacity() * sizeof(float) + m_brickRanges.capacity() * sizeof(glm::vec2);
+}
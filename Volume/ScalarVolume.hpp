@@ -0,0 +1,166 @@
+// ScalarVolume.hpp
+#ifndef SCALAR_VOLUME_HPP
+#define SCALAR_VOLUME_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "../Math/Bounds.hpp"
+
+/**
+ * @class ScalarVolume
+ * @brief Regularna siatka 3D wartości skalarnych z zakresami wartości bloków
+ *
+ * Próbki leżą w węzłach siatki (x zmienia się najszybciej, potem y, potem
+ * z); komórka to sześcian między ośmioma sąsiednimi próbkami. Komórki
+ * podzielone są na bloki BRICK_CELLS^3, a dla każdego bloku zapamiętywane
+ * jest minimum i maksimum jego próbek (razem z brzegiem wspólnym
+ * z następnym blokiem). Zakresy nie zależą od wartości izopowierzchni,
+ * więc liczone są raz po zmianie danych, a każda kolejna ekstrakcja
+ * pomija bloki, przez które powierzchnia na pewno nie przechodzi.
+ */
+class ScalarVolume {
+public:
+    static const int BRICK_CELLS = 16;     /**< Bok bloku w komórkach */
+
+private:
+    glm::ivec3 m_size;                  /**< Liczba próbek w osiach */
+    glm::vec3 m_origin;                 /**< Pozycja próbki (0, 0, 0) */
+    glm::vec3 m_spacing;                /**< Odstęp próbek w osiach */
+    std::vector<float> m_values;        /**< Próbki */
+    glm::ivec3 m_brickCounts;           /**< Liczba bloków w osiach */
+    std::vector<glm::vec2> m_brickRanges;   /**< Minimum i maksimum próbek bloków */
+
+public:
+    /**
+     * @brief Konstruktor ScalarVolume - siatka wypełniona zerami
+     * @param size Liczba próbek w osiach (co najmniej 2)
+     * @param origin Pozycja próbki (0, 0, 0)
+     * @param spacing Odstęp próbek w osiach
+     */
+    explicit ScalarVolume(const glm::ivec3& size, const glm::vec3& origin = glm::vec3(0.0f),
+                          const glm::vec3& spacing = glm::vec3(1.0f));
+
+    /**
+     * @brief Zwraca liczbę próbek w osiach
+     * @return Liczba próbek
+     */
+    const glm::ivec3& getSize() const { return m_size; }
+
+    /**
+     * @brief Zwraca pozycję próbki (0, 0, 0)
+     * @return Pozycja w przestrzeni świata
+     */
+    const glm::vec3& getOrigin() const { return m_origin; }
+
+    /**
+     * @brief Zwraca odstęp próbek
+     * @return Odstęp w osiach
+     */
+    const glm::vec3& getSpacing() const { return m_spacing; }
+
+    /**
+     * @brief Zwraca prostopadłościan otaczający siatkę
+     * @return AABB w przestrzeni świata
+     */
+    BoundingBox getBounds() const;
+
+    /**
+     * @brief Zwraca indeks próbki
+     * @param x Kolumna
+     * @param y Wiersz
+     * @param z Warstwa
+     * @return Indeks w tablicy próbek
+     */
+    size_t index(int x, int y, int z) const {
+        return (static_cast<size_t>(z) * m_size.y + y) * m_size.x + x;
+    }
+
+    /**
+     * @brief Zwraca próbkę
+     * @param x Kolumna
+     * @param y Wiersz
+     * @param z Warstwa
+     * @return Wartość
+     */
+    float value(int x, int y, int z) const { return m_values[index(x, y, z)]; }
+
+    /**
+     * @brief Zwraca gradient w węźle (różnice centralne, na brzegu jednostronne)
+     * @param x Kolumna
+     * @param y Wiersz
+     * @param z Warstwa
+     * @return Gradient w przestrzeni świata
+     */
+    glm::vec3 gradient(int x, int y, int z) const;
+
+    /**
+     * @brief Zwraca próbki do zapisu
+     * @return Tablica próbek (po zmianie wywołać updateBrickRanges())
+     */
+    std::vector<float>& getValues() { return m_values; }
+
+    /**
+     * @brief Zwraca próbki
+     * @return Tablica próbek
+     */
+    const std::vector<float>& getValues() const { return m_values; }
+
+    /**
+     * @brief Wypełnia siatkę funkcją pozycji, równolegle po warstwach
+     * @param function Wartość w punkcie przestrzeni świata
+     *
+     * Zakresy bloków są liczone od nowa.
+     */
+    void generate(const std::function<float(const glm::vec3& position)>& function);
+
+    /**
+     * @brief Przelicza minimum i maksimum próbek wszystkich bloków
+     */
+    void updateBrickRanges();
+
+    /**
+     * @brief Zwraca liczbę bloków w osiach
+     * @return Liczba bloków
+     */
+    const glm::ivec3& getBrickCounts() const { return m_brickCounts; }
+
+    /**
+     * @brief Zwraca łączną liczbę bloków
+     * @return Liczba bloków
+     */
+    int getBrickCount() const { return static_cast<int>(m_brickRanges.size()); }
+
+    /**
+     * @brief Zwraca współrzędne bloku
+     * @param brick Indeks bloku
+     * @return Współrzędne bloku
+     */
+    glm::ivec3 brickCoord(int brick) const;
+
+    /**
+     * @brief Zwraca zakres wartości bloku
+     * @param brick Indeks bloku
+     * @return Minimum (x) i maksimum (y) próbek bloku
+     */
+    const glm::vec2& getBrickRange(int brick) const { return m_brickRanges[brick]; }
+
+    /**
+     * @brief Sprawdza, czy izopowierzchnia może przechodzić przez blok
+     * @param brick Indeks bloku
+     * @param isoValue Wartość izopowierzchni
+     * @return true jeśli blok ma próbki po obu stronach wartości
+     */
+    bool brickMayContain(int brick, float isoValue) const {
+        return m_brickRanges[brick].x < isoValue && m_brickRanges[brick].y >= isoValue;
+    }
+
+    /**
+     * @brief Zwraca zajmowaną pamięć
+     * @return Liczba bajtów
+     */
+    size_t getMemoryUsage() const;
+};
+
+#endif // SCALAR_VOLUME_HPP
@@ -0,0 +1,169 @@
+// VoxelMesher.cpp
+#include "VoxelMesher.hpp"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Konstruktor VoxelMesher
+ */
+VoxelMesher::VoxelMesher()
+    : m_voxels(static_cast<size_t>(PADDED) * PADDED * PADDED), m_dense(VoxelChunk::VOLUME),
+      m_mask(VoxelChunk::SIZE * VoxelChunk::SIZE) {}
+
+/**
+ * @brief Sprawdza bez siatkowania, czy fragment na pewno nie ma widocznych ścianek
+ * @param chunk Fragment (nullptr = powietrze)
+ * @param neighbors Sąsiedzi w kolejności FACE_* (nullptr = powietrze)
+ * @return true dla fragmentu pustego lub bez powietrza i otoczonego sąsiadami bez powietrza
+ *
+ * @details Wystarczają palety, więc pozwala to pominąć zadanie dla
+ * większości fragmentów terenu (powietrze nad powierzchnią i wnętrze pod
+ * nią, także z kilkoma materiałami).
+ */
+bool VoxelMesher::isTriviallyEmpty(const VoxelChunk* chunk, const VoxelChunk* const neighbors[6]) {
+    if (!chunk || (chunk->isUniform() && chunk->getUniformValue() == 0)) return true;
+    if (chunk->mayContain(0)) return false;
+    for (int face = 0; face < 6; ++face) {
+        const VoxelChunk* neighbor = neighbors[face];
+        if (!neighbor || neighbor->mayContain(0)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Rozpakowuje fragment i brzegi sąsiadów do tablicy roboczej
+ * @param chunk Fragment (nullptr = powietrze)
+ * @param neighbors Sąsiedzi w kolejności FACE_* (nullptr = powietrze)
+ *
+ * @details Z sąsiada potrzebna jest tylko warstwa przylegająca do
+ * fragmentu; narożniki i krawędzie brzegu zostają puste, bo ścianki
+ * zależą wyłącznie od sąsiadów w osiach.
+ */
+void VoxelMesher::gather(const VoxelChunk* chunk, const VoxelChunk* const neighbors[6]) {
+    const int S = VoxelChunk::SIZE;
+    const int stride[3] = {1, PADDED * PADDED, PADDED};
+    uint8_t* voxels = m_voxels.data();
+    std::memset(voxels, 0, m_voxels.size());
+
+    if (chunk) {
+        const uint8_t* source = m_dense.data();
+        if (!chunk->isUniform()) chunk->decode(m_dense.data());
+        for (int y = 0; y < S; ++y) {
+            for (int z = 0; z < S; ++z) {
+                uint8_t* row = voxels + (y + 1) * stride[1] + (z + 1) * stride[2] + 1;
+                if (chunk->isUniform()) {
+                    std::memset(row, chunk->getUniformValue(), S);
+                } else {
+                    std::memcpy(row, source + VoxelChunk::index(0, y, z), S);
+                }
+            }
+        }
+    }
+
+    for (int face = 0; face < 6; ++face) {
+        const VoxelChunk* neighbor = neighbors[face];
+        if (!neighbor || (neighbor->isUniform() && neighbor->getUniformValue() == 0)) continue;
+        const int d = face / 2, u = (d + 1) % 3, v = (d + 2) % 3;
+        const bool positive = (face & 1) != 0;
+        int local[3];
+        local[d] = positive ? 0 : S - 1;
+        const int layer = (positive ? S + 1 : 0) * stride[d];
+        for (int b = 0; b < S; ++b) {
+            local[v] = b;
+            for (int a = 0; a < S; ++a) {
+                local[u] = a;
+                voxels[layer + (a + 1) * stride[u] + (b + 1) * stride[v]] = neighbor->get(local[0], local[1], local[2]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tworzy siatkę fragmentu
+ * @param chunk Fragment (nullptr = powietrze)
+ * @param neighbors Sąsiedzi w kolejności FACE_* (nullptr = powietrze, także poza światem)
+ * @param mesh Wynik (poprzednia zawartość jest zastępowana)
+ *
+ * @details Dla kierunku o osi d ścianki warstwy c leżą na płaszczyźnie
+ * c (kierunek ujemny) lub c + 1 (dodatni); osie u i v maski są kolejnymi
+ * osiami po d, więc e_u x e_v = e_d i kolejność wierzchołków daje
+ * trójkąty przeciwne do ruchu wskazówek zegara patrząc od strony normalnej.
+ */
+void VoxelMesher::mesh(const VoxelChunk* chunk, const VoxelChunk* const neighbors[6], VoxelMeshData& mesh) {
+    const int S = VoxelChunk::SIZE;
+    mesh.vertices.clear();
+    mesh.faceCount = 0;
+    mesh.boundsMin = glm::ivec3(S);
+    mesh.boundsMax = glm::ivec3(0);
+    if (isTriviallyEmpty(chunk, neighbors)) {
+        mesh.boundsMin = glm::ivec3(0);
+        return;
+    }
+    gather(chunk, neighbors);
+
+    const int stride[3] = {1, PADDED * PADDED, PADDED};
+    const uint8_t* voxels = m_voxels.data();
+    uint8_t* mask = m_mask.data();
+    for (int face = 0; face < 6; ++face) {
+        const int d = face / 2, u = (d + 1) % 3, v = (d + 2) % 3;
+        const bool positive = (face & 1) != 0;
+        const int neighborStep = positive ? stride[d] : -stride[d];
+
+        for (int c = 0; c < S; ++c) {
+            // Maska widocznych ścianek warstwy: wartość woksela lub 0
+            size_t faces = 0;
+            for (int j = 0; j < S; ++j) {
+                const uint8_t* cell = voxels + (c + 1) * stride[d] + (j + 1) * stride[v] + stride[u];
+                uint8_t* maskRow = mask + j * S;
+                for (int i = 0; i < S; ++i, cell += stride[u]) {
+                    uint8_t value = cell[0] != 0 && cell[neighborStep] == 0 ? cell[0] : 0;
+                    maskRow[i] = value;
+                    faces += value != 0;
+                }
+            }
+            if (faces == 0) continue;
+            mesh.faceCount += faces;
+
+            // Zachłanne łączenie: szerokość wzdłuż wiersza, potem kolejne wiersze
+            for (int j = 0; j < S; ++j) {
+                for (int i = 0; i < S;) {
+                    uint8_t value = mask[j * S + i];
+                    if (value == 0) {
+                        ++i;
+                        continue;
+                    }
+                    int w = 1;
+                    while (i + w < S && mask[j * S + i + w] == value) ++w;
+                    int h = 1;
+                    for (; j + h < S; ++h) {
+                        const uint8_t* row = mask + (j + h) * S + i;
+                        if (std::find_if(row, row + w, [value](uint8_t m) { return m != value; }) != row + w) break;
+                    }
+                    for (int k = 0; k < h; ++k) std::memset(mask + (j + k) * S + i, 0, w);
+
+                    int p[3], du[3] = {0, 0, 0}, dv[3] = {0, 0, 0};
+                    p[d] = c + (positive ? 1 : 0);
+                    p[u] = i;
+                    p[v] = j;
+                    du[u] = w;
+                    dv[v] = h;
+                    const int corners[4][3] = {
+                        {p[0], p[1], p[2]},
+                        {p[0] + du[0], p[1] + du[1], p[2] + du[2]},
+                        {p[0] + du[0] + dv[0], p[1] + du[1] + dv[1], p[2] + du[2] + dv[2]},
+                        {p[0] + dv[0], p[1] + dv[1], p[2] + dv[2]},
+                    };
+                    static const int order[2][4] = {{0, 3, 2, 1}, {0, 1, 2, 3}};
+                    for (int k = 0; k < 4; ++k) {
+                        const int* corner = corners[order[positive][k]];
+                        mesh.vertices.push_back(packVertex(corner[0], corner[1], corner[2], face, value));
+                    }
+                    mesh.boundsMin = glm::min(mesh.boundsMin, glm::ivec3(corners[0][0], corners[0][1], corners[0][2]));
+                    mesh.boundsMax = glm::max(mesh.boundsMax, glm::ivec3(corners[2][0], corners[2][1], corners[2][2]));
+                    i += w;
+                }
+            }
+        }
+    }
+    if (mesh.vertices.empty()) mesh.boundsMin = glm::ivec3(0);
+}
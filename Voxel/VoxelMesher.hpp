@@ -0,0 +1,109 @@
+// VoxelMesher.hpp
+#ifndef VOXEL_MESHER_HPP
+#define VOXEL_MESHER_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "VoxelWorld.hpp"
+
+/**
+ * @struct VoxelMeshData
+ * @brief Siatka fragmentu wokseli (czworokąty po cztery wierzchołki)
+ *
+ * Wierzchołek to jedno słowo 32-bitowe: bity 0-17 to pozycja x, y, z
+ * w fragmencie (po 6 bitów, 0-32), bity 18-20 kierunek ścianki (jak
+ * VoxelMesher::FACE_*), bity 21-28 wartość woksela (identyfikator
+ * materiału). Trójkąty wynikają z kolejnych czwórek wierzchołków, więc
+ * indeksy są wspólne dla wszystkich fragmentów.
+ */
+struct VoxelMeshData {
+    std::vector<uint32_t> vertices;     /**< Spakowane wierzchołki (4 na czworokąt) */
+    glm::ivec3 boundsMin;               /**< Najmniejszy narożnik czworokątów w fragmencie */
+    glm::ivec3 boundsMax;               /**< Największy narożnik czworokątów w fragmencie */
+    size_t faceCount;                   /**< Ścianki wokseli przed scaleniem */
+
+    /**
+     * @brief Zwraca liczbę czworokątów
+     * @return Liczba czworokątów
+     */
+    size_t getQuadCount() const { return vertices.size() / 4; }
+};
+
+/**
+ * @class VoxelMesher
+ * @brief Siatkowanie zachłanne fragmentów wokseli
+ *
+ * Fragment rozpakowywany jest do tablicy z brzegiem jednego woksela
+ * wziętym z sześciu sąsiadów, więc ścianki między fragmentami wynikają
+ * z tych samych danych co wewnątrz. Dla każdego z sześciu kierunków
+ * i każdej warstwy fragmentu powstaje maska widocznych ścianek (woksel
+ * pełny, sąsiad w kierunku ścianki pusty), a sąsiednie ścianki o tej
+ * samej wartości łączone są zachłannie w prostokąty: najpierw wzdłuż
+ * wiersza, potem przez kolejne wiersze. Płaski teren fragmentu to kilka
+ * czworokątów zamiast tysiąca ścianek.
+ *
+ * Obiekt trzyma tylko bufory robocze; jeden obiekt na wątek.
+ */
+class VoxelMesher {
+public:
+    static const int PADDED = VoxelChunk::SIZE + 2;    /**< Bok tablicy roboczej z brzegiem */
+
+    static const int FACE_NEG_X = 0;    /**< Ścianka skierowana w -X */
+    static const int FACE_POS_X = 1;    /**< Ścianka skierowana w +X */
+    static const int FACE_NEG_Y = 2;    /**< Ścianka skierowana w -Y */
+    static const int FACE_POS_Y = 3;    /**< Ścianka skierowana w +Y */
+    static const int FACE_NEG_Z = 4;    /**< Ścianka skierowana w -Z */
+    static const int FACE_POS_Z = 5;    /**< Ścianka skierowana w +Z */
+
+private:
+    std::vector<uint8_t> m_voxels;      /**< Fragment z brzegiem (PADDED^3, x najszybciej) */
+    std::vector<uint8_t> m_dense;       /**< Rozpakowany fragment */
+    std::vector<uint8_t> m_mask;        /**< Maska ścianek warstwy */
+
+    /**
+     * @brief Rozpakowuje fragment i brzegi sąsiadów do tablicy roboczej
+     * @param chunk Fragment (nullptr = powietrze)
+     * @param neighbors Sąsiedzi w kolejności FACE_* (nullptr = powietrze)
+     */
+    void gather(const VoxelChunk* chunk, const VoxelChunk* const neighbors[6]);
+
+public:
+    /**
+     * @brief Konstruktor VoxelMesher
+     */
+    VoxelMesher();
+
+    /**
+     * @brief Pakuje wierzchołek
+     * @param x Pozycja x w fragmencie (0-32)
+     * @param y Pozycja y w fragmencie (0-32)
+     * @param z Pozycja z w fragmencie (0-32)
+     * @param face Kierunek ścianki
+     * @param value Wartość woksela
+     * @return Spakowany wierzchołek
+     */
+    static uint32_t packVertex(int x, int y, int z, int face, uint8_t value) {
+        return static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 6) | (static_cast<uint32_t>(z) << 12) |
+               (static_cast<uint32_t>(face) << 18) | (static_cast<uint32_t>(value) << 21);
+    }
+
+    /**
+     * @brief Sprawdza bez siatkowania, czy fragment na pewno nie ma widocznych ścianek
+     * @param chunk Fragment (nullptr = powietrze)
+     * @param neighbors Sąsiedzi w kolejności FACE_* (nullptr = powietrze)
+     * @return true dla fragmentu pustego lub bez powietrza i otoczonego sąsiadami bez powietrza
+     */
+    static bool isTriviallyEmpty(const VoxelChunk* chunk, const VoxelChunk* const neighbors[6]);
+
+    /**
+     * @brief Tworzy siatkę fragmentu
+     * @param chunk Fragment (nullptr = powietrze)
+     * @param neighbors Sąsiedzi w kolejności FACE_* (nullptr = powietrze, także poza światem)
+     * @param mesh Wynik (poprzednia zawartość jest zastępowana)
+     */
+    void mesh(const VoxelChunk* chunk, const VoxelChunk* const neighbors[6], VoxelMeshData& mesh);
+};
+
+#endif // VOXEL_MESHER_HPP
@@ -0,0 +1,548 @@
+// VoxelRenderer.cpp
+#include "VoxelRenderer.hpp"
+#include "VoxelMesher.hpp"
+#include "../MultiView/MultiViewRenderer.hpp"
+#include "../Lighting/LightCuller.hpp"
+#include "../Material/MaterialTable.hpp"
+#include "../Stats/RenderStats.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include "../Shader/ShaderUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Vertex shader wokseli: rozpakowanie wierzchołka z jednego słowa
+ *
+ * Pozycja w fragmencie, kierunek ścianki i materiał zapisane są jak
+ * w VoxelMeshData; narożnik fragmentu przychodzi w uniformie.
+ */
+static const char* voxelVertexSource = R"(
+#version 330 core
+layout (location = 0) in uint aPacked;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+uniform vec3 chunkOrigin;
+uniform float voxelSize;
+
+out vec3 FragPos;
+flat out vec3 Normal;
+flat out int MaterialIndex;
+
+const vec3 faceNormals[6] = vec3[6](
+    vec3(-1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0),
+    vec3(0.0, -1.0, 0.0), vec3(0.0, 1.0, 0.0),
+    vec3(0.0, 0.0, -1.0), vec3(0.0, 0.0, 1.0)
+);
+
+void main()
+{
+    vec3 local = vec3(float(aPacked & 63u), float((aPacked >> 6) & 63u), float((aPacked >> 12) & 63u));
+    Normal = faceNormals[int((aPacked >> 18) & 7u)];
+    MaterialIndex = int((aPacked >> 21) & 255u);
+    FragPos = chunkOrigin + local * voxelSize;
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
+)";
+
+/**
+ * @brief Fragment shader wokseli
+ *
+ * Oświetlenie jak w shaderze sceny (ta sama tabela materiałów i lista
+ * świateł); wartość woksela jest identyfikatorem materiału. Bloki świateł
+ * i materiałów dokleja przed nim LightCuller::getShaderSource().
+ */
+static const char* voxelFragmentSource = R"(
+out vec4 FragColor;
+
+in vec3 FragPos;
+flat in vec3 Normal;
+flat in int MaterialIndex;
+
+uniform ivec2 lightList;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+void main()
+{
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
+    PackedMaterial material = materialData[MaterialIndex];
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < lightList.y; i++) {
+        int lightIndex = texelFetch(lightIndices, lightList.x + i).r;
+        result += calculatePhongLight(lightData[lightIndex], material, Normal, FragPos, viewDir);
+    }
+    FragColor = vec4(result, 1.0);
+}
+)";
+
+/**
+ * @struct VoxelRenderer::MeshQueue
+ * @brief Siatki ukończone w tle, czekające na wysłanie do GPU
+ *
+ * Współdzielona z zadaniami siatkowania, więc zadania kończące się po
+ * zmianie świata lub zniszczeniu renderera piszą do żywego obiektu,
+ * a ich wyniki odrzucane są po numerze świata.
+ */
+struct VoxelRenderer::MeshQueue {
+    /**
+     * @struct Result
+     * @brief Siatka jednego fragmentu
+     */
+    struct Result {
+        uint64_t generation;    /**< Numer świata w chwili zlecenia */
+        int index;              /**< Indeks fragmentu */
+        uint32_t version;       /**< Wersja fragmentu w chwili zlecenia */
+        double milliseconds;    /**< Czas siatkowania */
+        VoxelMeshData mesh;     /**< Siatka */
+    };
+
+    std::mutex mutex;               /**< Blokada listy wyników */
+    std::vector<Result> results;    /**< Wyniki w kolejności ukończenia */
+};
+
+/**
+ * @brief Konstruktor VoxelRenderer
+ */
+VoxelRenderer::VoxelRenderer()
+    : m_results(std::make_shared<MeshQueue>()), m_program(0), m_vao(0), m_indexBuffer(0), m_indexQuads(0),
+      m_chunkOriginLoc(-1), m_voxelSizeLoc(-1), m_lightListLoc(-1), m_generation(0), m_pendingMeshes(0),
+      m_vertexBytes(0), m_worldBytes(0), m_drawableDirty(false), m_initialized(false) {}
+
+/**
+ * @brief Destruktor VoxelRenderer
+ */
+VoxelRenderer::~VoxelRenderer() {
+    release();
+}
+
+/**
+ * @brief Kompiluje shadery i tworzy wspólne indeksy
+ * @return true jeśli inicjalizacja się powiodła
+ */
+bool VoxelRenderer::initialize() {
+    if (m_initialized) return true;
+
+    GLuint vertexShader = ShaderUtils::compileShader(GL_VERTEX_SHADER, voxelVertexSource, "wokseli");
+    const char* fragmentSources[] = {"#version 330 core\n", LightCuller::getShaderSource(), voxelFragmentSource};
+    GLuint fragmentShader = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSources, 3, "wokseli");
+    m_program = ShaderUtils::linkProgram(vertexShader, fragmentShader, "wokseli");
+    if (!m_program) return false;
+
+    MultiViewRenderer::setupProgram(m_program);
+    LightCuller::setupProgram(m_program);
+    MaterialTable::setupProgram(m_program);
+    m_chunkOriginLoc = glGetUniformLocation(m_program, "chunkOrigin");
+    m_voxelSizeLoc = glGetUniformLocation(m_program, "voxelSize");
+    m_lightListLoc = glGetUniformLocation(m_program, "lightList");
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_indexBuffer);
+    if (!m_vao || !m_indexBuffer) {
+        std::cerr << "Blad: Nie udalo sie utworzyc zasobow wokseli" << std::endl;
+        release();
+        return false;
+    }
+    glBindVertexArray(m_vao);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+
+    m_initialized = true;
+    ensureIndexCapacity(INITIAL_INDEX_QUADS);
+    return true;
+}
+
+/**
+ * @brief Odłącza świat i zwalnia obiekty OpenGL
+ */
+void VoxelRenderer::release() {
+    clearWorld();
+    if (m_program) glDeleteProgram(m_program);
+    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    if (m_indexBuffer) glDeleteBuffers(1, &m_indexBuffer);
+    m_program = 0;
+    m_vao = 0;
+    m_indexBuffer = 0;
+    m_indexQuads = 0;
+    m_initialized = false;
+}
+
+/**
+ * @brief Ustawia rysowany świat (wszystkie fragmenty zostaną siatkowane)
+ * @param world Świat
+ *
+ * @details Lista zmienionych fragmentów świata jest opróżniana, bo do
+ * kolejki trafiają od razu wszystkie fragmenty.
+ */
+void VoxelRenderer::setWorld(std::shared_ptr<VoxelWorld> world) {
+    clearWorld();
+    if (!m_initialized || !world) return;
+
+    m_world = std::move(world);
+    std::vector<int> dirty;
+    m_world->takeDirtyChunks(dirty);
+    m_meshes.resize(m_world->getChunkCount());
+    m_queue.reserve(m_meshes.size());
+    for (int index = 0; index < m_world->getChunkCount(); ++index) {
+        m_meshes[index].queued = true;
+        m_meshes[index].origin = m_world->getOrigin() +
+                                 glm::vec3(m_world->chunkCoord(index) * VoxelChunk::SIZE) * m_world->getVoxelSize();
+        m_queue.push_back(index);
+    }
+    m_worldBytes = m_world->getMemoryUsage();
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform1f(m_voxelSizeLoc, m_world->getVoxelSize());
+    glUseProgram(previousProgram);
+
+    glm::ivec3 size = m_world->getSize();
+    std::cout << "Woksele: swiat " << size.x << "x" << size.y << "x" << size.z << ", "
+              << m_world->getChunkCount() << " fragmentow" << std::endl;
+}
+
+/**
+ * @brief Odłącza świat i zwalnia siatki fragmentów
+ *
+ * @details Zadania w toku nie są przerywane; ich wyniki zostaną
+ * odrzucone, bo zmienia się numer świata.
+ */
+void VoxelRenderer::clearWorld() {
+    for (ChunkMesh& mesh : m_meshes) {
+        if (mesh.vertexBuffer) glDeleteBuffers(1, &mesh.vertexBuffer);
+    }
+    m_world.reset();
+    m_meshes.clear();
+    m_queue.clear();
+    m_drawable.clear();
+    m_visible.clear();
+    m_pendingMeshes = 0;
+    m_vertexBytes = 0;
+    m_worldBytes = 0;
+    m_drawableDirty = false;
+    m_generation++;
+    std::lock_guard<std::mutex> lock(m_results->mutex);
+    m_results->results.clear();
+}
+
+/**
+ * @brief Powiększa wspólne indeksy do podanej liczby czworokątów
+ * @param quads Wymagana liczba czworokątów
+ *
+ * @details Pojemność rośnie co najmniej dwukrotnie. Najgorszy fragment
+ * (szachownica) ma SIZE^3 / 2 * 6 czworokątów, czyli 2,4 MB indeksów.
+ */
+void VoxelRenderer::ensureIndexCapacity(size_t quads) {
+    if (!m_initialized || quads <= m_indexQuads) return;
+    m_indexQuads = std::max(quads, m_indexQuads * 2);
+
+    std::vector<GLuint> indices(m_indexQuads * 6);
+    for (size_t quad = 0; quad < m_indexQuads; ++quad) {
+        GLuint first = static_cast<GLuint>(quad * 4);
+        GLuint* target = &indices[quad * 6];
+        target[0] = first;
+        target[1] = first + 1;
+        target[2] = first + 2;
+        target[3] = first;
+        target[4] = first + 2;
+        target[5] = first + 3;
+    }
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(GLuint)), indices.data(),
+                 GL_STATIC_DRAW);
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Zbiera fragment i jego sześciu sąsiadów
+ * @param index Indeks fragmentu
+ * @param chunks Fragment (element 0) i sąsiedzi w kolejności VoxelMesher::FACE_* (nullptr = powietrze)
+ */
+void VoxelRenderer::collectChunks(int index, std::array<std::shared_ptr<const VoxelChunk>, 7>& chunks) const {
+    glm::ivec3 coord = m_world->chunkCoord(index);
+    chunks[0] = m_world->getChunk(index);
+    for (int face = 0; face < 6; ++face) {
+        glm::ivec3 neighbor = coord;
+        neighbor[face / 2] += (face & 1) ? 1 : -1;
+        int neighborIndex = m_world->chunkIndex(neighbor);
+        chunks[face + 1] = neighborIndex >= 0 ? m_world->getChunk(neighborIndex) : nullptr;
+    }
+}
+
+/**
+ * @brief Zleca siatkowanie fragmentu w tle
+ * @param index Indeks fragmentu
+ * @param chunks Fragment i sąsiedzi z collectChunks()
+ *
+ * @details Zadanie dostaje wskaźniki do fragmentów i kolejki wyników,
+ * więc nie odwołuje się ani do renderera, ani do świata.
+ */
+void VoxelRenderer::requestMesh(int index, const std::array<std::shared_ptr<const VoxelChunk>, 7>& chunks) {
+    m_meshes[index].pending = true;
+    m_pendingMeshes++;
+
+    std::shared_ptr<MeshQueue> results = m_results;
+    uint64_t generation = m_generation;
+    uint32_t version = m_world->getChunkVersion(index);
+    auto task = [results, chunks, generation, version, index]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        const VoxelChunk* neighbors[6];
+        for (int face = 0; face < 6; ++face) neighbors[face] = chunks[face + 1].get();
+
+        MeshQueue::Result result;
+        result.generation = generation;
+        result.index = index;
+        result.version = version;
+        VoxelMesher mesher;
+        mesher.mesh(chunks[0].get(), neighbors, result.mesh);
+        result.milliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(results->mutex);
+        results->results.push_back(std::move(result));
+    };
+
+    // Bez wątków roboczych (jeden rdzeń) fragment siatkowany jest od razu
+    ThreadPool& pool = ThreadPool::instance();
+    if (pool.getThreadCount() == 0) {
+        task();
+    } else {
+        pool.submit(task);
+    }
+}
+
+/**
+ * @brief Zapisuje siatkę fragmentu w jego buforze
+ * @param index Indeks fragmentu
+ * @param vertices Spakowane wierzchołki (4 na czworokąt)
+ * @param boundsMin Najmniejszy narożnik czworokątów w fragmencie
+ * @param boundsMax Największy narożnik czworokątów w fragmencie
+ *
+ * @details Bufor jest przydzielany na nowo tylko, gdy siatka się w nim
+ * nie mieści albo zajmuje mniej niż jego ćwierć; pusta siatka zwalnia bufor.
+ */
+void VoxelRenderer::storeMesh(int index, const std::vector<uint32_t>& vertices, const glm::ivec3& boundsMin,
+                              const glm::ivec3& boundsMax) {
+    ChunkMesh& mesh = m_meshes[index];
+    bool wasDrawable = mesh.quadCount > 0;
+    if (vertices.empty()) {
+        if (mesh.vertexBuffer) glDeleteBuffers(1, &mesh.vertexBuffer);
+        m_vertexBytes -= mesh.capacity * sizeof(uint32_t);
+        mesh.vertexBuffer = 0;
+        mesh.capacity = 0;
+        mesh.quadCount = 0;
+    } else {
+        if (!mesh.vertexBuffer) glGenBuffers(1, &mesh.vertexBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+        GLsizeiptr bytes = static_cast<GLsizeiptr>(vertices.size() * sizeof(uint32_t));
+        if (vertices.size() > mesh.capacity || vertices.size() < mesh.capacity / 4) {
+            m_vertexBytes = m_vertexBytes - mesh.capacity * sizeof(uint32_t) + vertices.size() * sizeof(uint32_t);
+            mesh.capacity = vertices.size();
+            glBufferData(GL_ARRAY_BUFFER, bytes, vertices.data(), GL_DYNAMIC_DRAW);
+        } else {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices.data());
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        mesh.quadCount = static_cast<GLsizei>(vertices.size() / 4);
+        ensureIndexCapacity(static_cast<size_t>(mesh.quadCount));
+
+        float voxelSize = m_world->getVoxelSize();
+        mesh.bounds.min = mesh.origin + glm::vec3(boundsMin) * voxelSize;
+        mesh.bounds.max = mesh.origin + glm::vec3(boundsMax) * voxelSize;
+    }
+    if (wasDrawable != (mesh.quadCount > 0)) m_drawableDirty = true;
+}
+
+/**
+ * @brief Wysyła do GPU siatki ukończone w tle
+ * @return Liczba wysłanych siatek
+ *
+ * @details W klatce wysyłane jest najwyżej MAX_UPLOAD_BYTES_PER_FRAME
+ * bajtów (zawsze co najmniej jedna siatka); pozostałe czekają w kolejce.
+ * Siatka fragmentu zmienionego w czasie siatkowania jest odrzucana -
+ * fragment czeka już w kolejce na ponowne siatkowanie.
+ */
+int VoxelRenderer::uploadMeshes() {
+    std::vector<MeshQueue::Result> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_results->mutex);
+        std::vector<MeshQueue::Result>& results = m_results->results;
+        size_t count = 0, bytes = 0;
+        while (count < results.size() && (count == 0 || bytes < MAX_UPLOAD_BYTES_PER_FRAME)) {
+            bytes += results[count].mesh.vertices.size() * sizeof(uint32_t);
+            count++;
+        }
+        std::move(results.begin(), results.begin() + count, std::back_inserter(ready));
+        results.erase(results.begin(), results.begin() + count);
+    }
+
+    int uploaded = 0;
+    double milliseconds = 0.0;
+    for (MeshQueue::Result& result : ready) {
+        if (result.generation != m_generation) continue;
+        m_meshes[result.index].pending = false;
+        m_pendingMeshes--;
+        if (result.version != m_world->getChunkVersion(result.index)) continue;
+        storeMesh(result.index, result.mesh.vertices, result.mesh.boundsMin, result.mesh.boundsMax);
+        milliseconds += result.milliseconds;
+        uploaded++;
+    }
+    if (uploaded > 0) {
+        RenderStats::instance().setValue("Woksele/Siatkowanie fragmentu [ms]", milliseconds / uploaded);
+    }
+    return uploaded;
+}
+
+/**
+ * @brief Zleca siatkowanie zmienionych fragmentów, wysyła gotowe siatki i odrzuca fragmenty
+ * @param cameraPosition Pozycja kamery głównej (kolejność siatkowania i rysowania)
+ * @param frustums Ostrosłupy wszystkich widoków
+ * @param lightList Globalna lista świateł
+ *
+ * @details Fragmenty bez widocznych ścianek (powietrze i jednorodne
+ * wnętrze) obsługiwane są od razu, bez zadania i bez limitu; pozostałe
+ * zlecane są od najbliższego kamerze, najwyżej MAX_PENDING_MESHES naraz.
+ */
+void VoxelRenderer::update(const glm::vec3& cameraPosition, const std::vector<Frustum>& frustums,
+                           const glm::ivec2& lightList) {
+    RenderStats& stats = RenderStats::instance();
+    stats.setValue("Woksele/Czworokaty", 0.0);
+    stats.setValue("Woksele/Wywolania rysowania", 0.0);
+    m_visible.clear();
+    if (!m_initialized || !m_world) return;
+
+    std::vector<int> dirty;
+    m_world->takeDirtyChunks(dirty);
+    for (int index : dirty) {
+        if (m_meshes[index].queued) continue;
+        m_meshes[index].queued = true;
+        m_queue.push_back(index);
+    }
+    if (!dirty.empty()) m_worldBytes = m_world->getMemoryUsage();
+
+    int uploaded = uploadMeshes();
+
+    // Fragmenty do siatkowania: puste od razu, pozostałe od najbliższego
+    std::vector<std::pair<float, int>> candidates;
+    std::array<std::shared_ptr<const VoxelChunk>, 7> chunks;
+    for (int index : m_queue) {
+        ChunkMesh& mesh = m_meshes[index];
+        if (mesh.pending) continue;
+        collectChunks(index, chunks);
+        const VoxelChunk* neighbors[6];
+        for (int face = 0; face < 6; ++face) neighbors[face] = chunks[face + 1].get();
+        if (VoxelMesher::isTriviallyEmpty(chunks[0].get(), neighbors)) {
+            storeMesh(index, {}, glm::ivec3(0), glm::ivec3(0));
+            mesh.queued = false;
+            continue;
+        }
+        glm::vec3 center = mesh.origin + glm::vec3(VoxelChunk::SIZE * 0.5f * m_world->getVoxelSize());
+        glm::vec3 offset = center - cameraPosition;
+        candidates.push_back({glm::dot(offset, offset), index});
+    }
+    size_t slots = static_cast<size_t>(std::max(MAX_PENDING_MESHES - m_pendingMeshes, 0));
+    if (candidates.size() > slots) {
+        std::nth_element(candidates.begin(), candidates.begin() + slots, candidates.end());
+        candidates.resize(slots);
+    }
+    for (const auto& candidate : candidates) {
+        collectChunks(candidate.second, chunks);
+        m_meshes[candidate.second].queued = false;
+        requestMesh(candidate.second, chunks);
+    }
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(), [this](int index) { return !m_meshes[index].queued; }),
+                  m_queue.end());
+
+    // Odrzucanie: fragmenty z siatką od najbliższego, osobno dla każdego widoku
+    if (m_drawableDirty) {
+        m_drawable.clear();
+        for (int index = 0; index < static_cast<int>(m_meshes.size()); ++index) {
+            if (m_meshes[index].quadCount > 0) m_drawable.push_back(index);
+        }
+        m_drawableDirty = false;
+    }
+    std::vector<std::pair<float, int>> sorted;
+    sorted.reserve(m_drawable.size());
+    for (int index : m_drawable) {
+        glm::vec3 offset = m_meshes[index].bounds.getCenter() - cameraPosition;
+        sorted.push_back({glm::dot(offset, offset), index});
+    }
+    std::sort(sorted.begin(), sorted.end());
+    m_visible.resize(frustums.size());
+    size_t visibleChunks = 0;
+    for (size_t view = 0; view < frustums.size(); ++view) {
+        for (const auto& entry : sorted) {
+            if (frustums[view].intersects(m_meshes[entry.second].bounds)) m_visible[view].push_back(entry.second);
+        }
+        visibleChunks += m_visible[view].size();
+    }
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glUniform2i(m_lightListLoc, lightList.x, lightList.y);
+    glUseProgram(previousProgram);
+
+    size_t indexBytes = m_indexQuads * 6 * sizeof(GLuint);
+    stats.setValue("Woksele/Fragmenty z siatka", static_cast<double>(m_drawable.size()));
+    stats.setValue("Woksele/Widoczne fragmenty", static_cast<double>(visibleChunks));
+    stats.setValue("Woksele/Fragmenty w kolejce", static_cast<double>(m_queue.size()));
+    stats.setValue("Woksele/Siatkowane w tle", static_cast<double>(m_pendingMeshes));
+    stats.setValue("Woksele/Wyslane siatki", static_cast<double>(uploaded));
+    stats.setValue("Woksele/Pamiec wokseli [MB]", m_worldBytes / (1024.0 * 1024.0));
+    stats.setValue("Woksele/Pamiec GPU [MB]", (m_vertexBytes + indexBytes) / (1024.0 * 1024.0));
+}
+
+/**
+ * @brief Rysuje fragmenty widoczne w widoku
+ * @param viewIndex Indeks widoku z update()
+ * @return Liczba wywołań rysowania
+ *
+ * @details Kamera widoku pochodzi z bloku Camera ustawionego przez
+ * MultiViewRenderer::bindView(). Dla każdego fragmentu przestawiany jest
+ * tylko bufor atrybutu i uniform narożnika; indeksy są wspólne.
+ */
+int VoxelRenderer::draw(int viewIndex) {
+    if (!m_initialized || viewIndex < 0 || viewIndex >= static_cast<int>(m_visible.size())) return 0;
+    const std::vector<int>& visible = m_visible[viewIndex];
+    if (visible.empty()) return 0;
+
+    GLint previousProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(m_program);
+    glBindVertexArray(m_vao);
+
+    double quads = 0.0;
+    for (int index : visible) {
+        const ChunkMesh& mesh = m_meshes[index];
+        glUniform3f(m_chunkOriginLoc, mesh.origin.x, mesh.origin.y, mesh.origin.z);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+        glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(uint32_t), nullptr);
+        glDrawElements(GL_TRIANGLES, mesh.quadCount * 6, GL_UNSIGNED_INT, nullptr);
+        quads += mesh.quadCount;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glUseProgram(previousProgram);
+
+    int drawCalls = static_cast<int>(visible.size());
+    RenderStats& stats = RenderStats::instance();
+    stats.addValue("Woksele/Czworokaty", quads);
+    stats.addValue("Woksele/Wywolania rysowania", drawCalls);
+    return drawCalls;
+}
@@ -0,0 +1,167 @@
+// VoxelRenderer.hpp
+#ifndef VOXEL_RENDERER_HPP
+#define VOXEL_RENDERER_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "VoxelWorld.hpp"
+#include "../Math/Bounds.hpp"
+
+/**
+ * @class VoxelRenderer
+ * @brief Siatkowanie fragmentów świata wokseli w tle i rysowanie ich z odrzucaniem
+ *
+ * Każdy fragment świata ma własny bufor spakowanych wierzchołków
+ * (VoxelMeshData, 4 bajty na wierzchołek); indeksy czworokątów są wspólne.
+ * Fragmenty zmienione od poprzedniej klatki (VoxelWorld::takeDirtyChunks)
+ * trafiają do kolejki, z której najbliższe kamerze siatkowane są
+ * zachłannie (VoxelMesher) przez ThreadPool, więc edycja woksela
+ * przebudowuje tylko jego fragment i ewentualnie sąsiadów na granicy.
+ * Zadania dostają wskaźniki do fragmentów, nie do świata, a wyniki
+ * nieaktualne (fragment zmieniony w czasie siatkowania) są odrzucane
+ * po wersji fragmentu.
+ *
+ * Fragmenty z niepustą siatką odrzucane są prostopadłościanem swoich
+ * czworokątów przez ostrosłup każdego widoku i rysowane od najbliższego;
+ * jeden fragment to jedno glDrawElements.
+ */
+class VoxelRenderer {
+public:
+    static const int MAX_PENDING_MESHES = 64;                       /**< Najwięcej fragmentów siatkowanych naraz */
+    static const size_t MAX_UPLOAD_BYTES_PER_FRAME = 8u << 20;      /**< Najwięcej bajtów siatek wysyłanych w klatce */
+    static const size_t INITIAL_INDEX_QUADS = 16384;                /**< Początkowa pojemność wspólnych indeksów */
+
+private:
+    /**
+     * @struct ChunkMesh
+     * @brief Siatka fragmentu na GPU i jej stan
+     */
+    struct ChunkMesh {
+        GLuint vertexBuffer = 0;        /**< Bufor wierzchołków (0 gdy siatka pusta) */
+        size_t capacity = 0;            /**< Pojemność bufora w wierzchołkach */
+        GLsizei quadCount = 0;          /**< Liczba czworokątów */
+        glm::vec3 origin = glm::vec3(0.0f); /**< Narożnik fragmentu w przestrzeni świata */
+        BoundingBox bounds;             /**< Prostopadłościan czworokątów w przestrzeni świata */
+        bool queued = false;            /**< Czy fragment czeka w kolejce */
+        bool pending = false;           /**< Czy fragment jest siatkowany w tle */
+    };
+
+    struct MeshQueue;
+
+    std::shared_ptr<VoxelWorld> m_world;            /**< Rysowany świat */
+    std::vector<ChunkMesh> m_meshes;                /**< Siatki fragmentów (indeks jak w świecie) */
+    std::vector<int> m_queue;                       /**< Fragmenty czekające na siatkowanie */
+    std::vector<int> m_drawable;                    /**< Fragmenty z niepustą siatką */
+    std::vector<std::vector<int>> m_visible;        /**< Widoczne fragmenty każdego widoku */
+    std::shared_ptr<MeshQueue> m_results;           /**< Siatki z zadań w tle (współdzielone z zadaniami) */
+    GLuint m_program;                               /**< Program rysujący woksele */
+    GLuint m_vao;                                   /**< VAO wspólnych indeksów i atrybutu wierzchołka */
+    GLuint m_indexBuffer;                           /**< Indeksy czworokątów (wspólne) */
+    size_t m_indexQuads;                            /**< Pojemność indeksów w czworokątach */
+    GLint m_chunkOriginLoc;                         /**< Lokalizacja uniformu narożnika fragmentu */
+    GLint m_voxelSizeLoc;                           /**< Lokalizacja uniformu boku woksela */
+    GLint m_lightListLoc;                           /**< Lokalizacja uniformu listy świateł */
+    uint64_t m_generation;                          /**< Numer świata (odrzucanie starych wyników) */
+    int m_pendingMeshes;                            /**< Fragmenty siatkowane w tle */
+    size_t m_vertexBytes;                           /**< Bajty buforów wierzchołków */
+    size_t m_worldBytes;                            /**< Pamięć wokseli świata */
+    bool m_drawableDirty;                           /**< Czy lista fragmentów z siatką wymaga odbudowy */
+    bool m_initialized;                             /**< Czy obiekty OpenGL zostały utworzone */
+
+    /**
+     * @brief Zbiera fragment i jego sześciu sąsiadów
+     * @param index Indeks fragmentu
+     * @param chunks Fragment (element 0) i sąsiedzi w kolejności VoxelMesher::FACE_* (nullptr = powietrze)
+     */
+    void collectChunks(int index, std::array<std::shared_ptr<const VoxelChunk>, 7>& chunks) const;
+
+    /**
+     * @brief Zleca siatkowanie fragmentu w tle
+     * @param index Indeks fragmentu
+     * @param chunks Fragment i sąsiedzi z collectChunks()
+     */
+    void requestMesh(int index, const std::array<std::shared_ptr<const VoxelChunk>, 7>& chunks);
+
+    /**
+     * @brief Wysyła do GPU siatki ukończone w tle
+     * @return Liczba wysłanych siatek
+     */
+    int uploadMeshes();
+
+    /**
+     * @brief Zapisuje siatkę fragmentu w jego buforze
+     * @param index Indeks fragmentu
+     * @param vertices Spakowane wierzchołki (4 na czworokąt)
+     * @param boundsMin Najmniejszy narożnik czworokątów w fragmencie
+     * @param boundsMax Największy narożnik czworokątów w fragmencie
+     */
+    void storeMesh(int index, const std::vector<uint32_t>& vertices, const glm::ivec3& boundsMin,
+                   const glm::ivec3& boundsMax);
+
+    /**
+     * @brief Powiększa wspólne indeksy do podanej liczby czworokątów
+     * @param quads Wymagana liczba czworokątów
+     */
+    void ensureIndexCapacity(size_t quads);
+
+public:
+    /**
+     * @brief Konstruktor VoxelRenderer
+     */
+    VoxelRenderer();
+
+    /**
+     * @brief Destruktor VoxelRenderer
+     */
+    ~VoxelRenderer();
+
+    /**
+     * @brief Kompiluje shadery i tworzy wspólne indeksy
+     * @return true jeśli inicjalizacja się powiodła
+     */
+    bool initialize();
+
+    /**
+     * @brief Odłącza świat i zwalnia obiekty OpenGL
+     */
+    void release();
+
+    /**
+     * @brief Ustawia rysowany świat (wszystkie fragmenty zostaną siatkowane)
+     * @param world Świat
+     */
+    void setWorld(std::shared_ptr<VoxelWorld> world);
+
+    /**
+     * @brief Odłącza świat i zwalnia siatki fragmentów
+     */
+    void clearWorld();
+
+    /**
+     * @brief Sprawdza, czy świat jest ustawiony
+     * @return true jeśli świat jest rysowany
+     */
+    bool hasWorld() const { return m_world != nullptr; }
+
+    /**
+     * @brief Zleca siatkowanie zmienionych fragmentów, wysyła gotowe siatki i odrzuca fragmenty
+     * @param cameraPosition Pozycja kamery głównej (kolejność siatkowania i rysowania)
+     * @param frustums Ostrosłupy wszystkich widoków
+     * @param lightList Globalna lista świateł
+     */
+    void update(const glm::vec3& cameraPosition, const std::vector<Frustum>& frustums, const glm::ivec2& lightList);
+
+    /**
+     * @brief Rysuje fragmenty widoczne w widoku
+     * @param viewIndex Indeks widoku z update()
+     * @return Liczba wywołań rysowania
+     */
+    int draw(int viewIndex);
+};
+
+#endif // VOXEL_RENDERER_HPP
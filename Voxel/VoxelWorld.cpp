@@ -0,0 +1,422 @@
+// VoxelWorld.cpp
+#include "VoxelWorld.hpp"
+#include "../Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief Konstruktor VoxelChunk - fragment jednorodny
+ * @param value Wartość wszystkich wokseli
+ */
+VoxelChunk::VoxelChunk(uint8_t value) : m_palette(1, value), m_bits(0) {}
+
+/**
+ * @brief Zapisuje indeks palety woksela
+ * @param index Indeks woksela
+ * @param paletteIndex Indeks palety
+ */
+void VoxelChunk::storeIndex(int index, uint32_t paletteIndex) {
+    uint32_t bit = static_cast<uint32_t>(index) * m_bits;
+    uint64_t mask = ((uint64_t(1) << m_bits) - 1) << (bit & 63);
+    uint64_t& word = m_indices[bit >> 6];
+    word = (word & ~mask) | (static_cast<uint64_t>(paletteIndex) << (bit & 63));
+}
+
+/**
+ * @brief Zmienia szerokość indeksów z zachowaniem zawartości
+ * @param bits Nowa liczba bitów na woksel (1, 2, 4 lub 8)
+ *
+ * @details Szerokości są dzielnikami 64, więc indeks nigdy nie przechodzi
+ * przez granicę słowa.
+ */
+void VoxelChunk::repack(int bits) {
+    std::vector<uint8_t> indices(VOLUME, 0);
+    if (m_bits > 0) {
+        for (int i = 0; i < VOLUME; ++i) {
+            uint32_t bit = static_cast<uint32_t>(i) * m_bits;
+            indices[i] = static_cast<uint8_t>((m_indices[bit >> 6] >> (bit & 63)) & ((1u << m_bits) - 1));
+        }
+    }
+    m_bits = bits;
+    m_indices.assign(static_cast<size_t>(VOLUME) * bits / 64, 0);
+    for (int i = 0; i < VOLUME; ++i) {
+        if (indices[i]) storeIndex(i, indices[i]);
+    }
+}
+
+/**
+ * @brief Ustawia wartość woksela (paleta i szerokość indeksów rosną w razie potrzeby)
+ * @param x Kolumna
+ * @param y Warstwa
+ * @param z Wiersz
+ * @param value Wartość
+ *
+ * @details Paleta nie jest zmniejszana, gdy wartość znika z fragmentu;
+ * robi to dopiero encode() lub fill().
+ */
+void VoxelChunk::set(int x, int y, int z, uint8_t value) {
+    if (m_bits == 0 && m_palette[0] == value) return;
+
+    auto found = std::find(m_palette.begin(), m_palette.end(), value);
+    uint32_t paletteIndex = static_cast<uint32_t>(found - m_palette.begin());
+    if (found == m_palette.end()) {
+        if (m_palette.size() >= (size_t(1) << m_bits)) repack(m_bits == 0 ? 1 : m_bits * 2);
+        m_palette.push_back(value);
+    }
+    storeIndex(index(x, y, z), paletteIndex);
+}
+
+/**
+ * @brief Wypełnia fragment jedną wartością
+ * @param value Wartość
+ */
+void VoxelChunk::fill(uint8_t value) {
+    m_palette.assign(1, value);
+    std::vector<uint64_t>().swap(m_indices);
+    m_bits = 0;
+}
+
+/**
+ * @brief Zapisuje fragment z tablicy bajtów z najmniejszą paletą
+ * @param voxels VOLUME wartości w układzie index()
+ */
+void VoxelChunk::encode(const uint8_t* voxels) {
+    int lookup[256];
+    std::fill(lookup, lookup + 256, -1);
+    m_palette.clear();
+    for (int i = 0; i < VOLUME; ++i) {
+        if (lookup[voxels[i]] < 0) {
+            lookup[voxels[i]] = static_cast<int>(m_palette.size());
+            m_palette.push_back(voxels[i]);
+        }
+    }
+
+    size_t count = m_palette.size();
+    m_bits = count == 1 ? 0 : count <= 2 ? 1 : count <= 4 ? 2 : count <= 16 ? 4 : 8;
+    if (m_bits == 0) {
+        std::vector<uint64_t>().swap(m_indices);
+        return;
+    }
+
+    const int perWord = 64 / m_bits;
+    m_indices.assign(VOLUME / perWord, 0);
+    for (size_t word = 0; word < m_indices.size(); ++word) {
+        const uint8_t* source = voxels + word * perWord;
+        uint64_t packed = 0;
+        for (int k = 0; k < perWord; ++k) packed |= static_cast<uint64_t>(lookup[source[k]]) << (k * m_bits);
+        m_indices[word] = packed;
+    }
+}
+
+/**
+ * @brief Rozpakowuje fragment do tablicy bajtów
+ * @param voxels Tablica VOLUME wartości w układzie index()
+ */
+void VoxelChunk::decode(uint8_t* voxels) const {
+    if (m_bits == 0) {
+        std::memset(voxels, m_palette[0], VOLUME);
+        return;
+    }
+    const int perWord = 64 / m_bits;
+    const uint64_t mask = (uint64_t(1) << m_bits) - 1;
+    for (size_t word = 0; word < m_indices.size(); ++word) {
+        uint64_t packed = m_indices[word];
+        uint8_t* target = voxels + word * perWord;
+        for (int k = 0; k < perWord; ++k) {
+            target[k] = m_palette[packed & mask];
+            packed >>= m_bits;
+        }
+    }
+}
+
+/**
+ * @brief Sprawdza, czy wartość jest w palecie fragmentu
+ * @param value Wartość
+ * @return false jeśli żaden woksel nie ma tej wartości
+ */
+bool VoxelChunk::mayContain(uint8_t value) const {
+    return std::find(m_palette.begin(), m_palette.end(), value) != m_palette.end();
+}
+
+/**
+ * @brief Zwraca zajmowaną pamięć
+ * @return Liczba bajtów
+ */
+size_t VoxelChunk::getMemoryUsage() const {
+    return sizeof(VoxelChunk) + m_palette.capacity() + m_indices.capacity() * sizeof(uint64_t);
+}
+
+/**
+ * @brief Konstruktor VoxelWorld - świat wypełniony powietrzem
+ * @param chunkCounts Liczba fragmentów w osiach
+ * @param origin Narożnik świata
+ * @param voxelSize Bok woksela [m]
+ */
+VoxelWorld::VoxelWorld(const glm::ivec3& chunkCounts, const glm::vec3& origin, float voxelSize)
+    : m_chunkCounts(glm::max(chunkCounts, glm::ivec3(1))), m_origin(origin), m_voxelSize(voxelSize) {
+    size_t count = static_cast<size_t>(m_chunkCounts.x) * m_chunkCounts.y * m_chunkCounts.z;
+    m_chunks.resize(count);
+    m_versions.assign(count, 0);
+    m_dirtyFlags.assign(count, 0);
+}
+
+/**
+ * @brief Zwraca indeks fragmentu
+ * @param chunk Współrzędne fragmentu
+ * @return Indeks lub -1 poza światem
+ */
+int VoxelWorld::chunkIndex(const glm::ivec3& chunk) const {
+    if (glm::any(glm::lessThan(chunk, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(chunk, m_chunkCounts))) {
+        return -1;
+    }
+    return (chunk.y * m_chunkCounts.z + chunk.z) * m_chunkCounts.x + chunk.x;
+}
+
+/**
+ * @brief Zwraca współrzędne fragmentu
+ * @param index Indeks fragmentu
+ * @return Współrzędne fragmentu
+ */
+glm::ivec3 VoxelWorld::chunkCoord(int index) const {
+    return glm::ivec3(index % m_chunkCounts.x, index / (m_chunkCounts.x * m_chunkCounts.z),
+                      (index / m_chunkCounts.x) % m_chunkCounts.z);
+}
+
+/**
+ * @brief Sprawdza, czy woksel leży w świecie
+ * @param voxel Współrzędne woksela
+ * @return true jeśli woksel leży w świecie
+ */
+bool VoxelWorld::contains(const glm::ivec3& voxel) const {
+    return glm::all(glm::greaterThanEqual(voxel, glm::ivec3(0))) && glm::all(glm::lessThan(voxel, getSize()));
+}
+
+/**
+ * @brief Zamienia pozycję w przestrzeni świata na współrzędne woksela
+ * @param position Pozycja
+ * @return Współrzędne woksela zawierającego pozycję
+ */
+glm::ivec3 VoxelWorld::voxelAt(const glm::vec3& position) const {
+    return glm::ivec3(glm::floor((position - m_origin) / m_voxelSize));
+}
+
+/**
+ * @brief Zwraca wartość woksela
+ * @param voxel Współrzędne woksela
+ * @return Wartość (0 = powietrze, także poza światem)
+ */
+uint8_t VoxelWorld::getVoxel(const glm::ivec3& voxel) const {
+    if (!contains(voxel)) return 0;
+    const VoxelChunk* chunk = m_chunks[chunkIndex(voxel / VoxelChunk::SIZE)].get();
+    if (!chunk) return 0;
+    glm::ivec3 local = voxel % VoxelChunk::SIZE;
+    return chunk->get(local.x, local.y, local.z);
+}
+
+/**
+ * @brief Ustawia wartość woksela
+ * @param voxel Współrzędne woksela (poza światem ignorowane)
+ * @param value Wartość
+ */
+void VoxelWorld::setVoxel(const glm::ivec3& voxel, uint8_t value) {
+    if (!contains(voxel) || getVoxel(voxel) == value) return;
+    glm::ivec3 local = voxel % VoxelChunk::SIZE;
+    mutableChunk(chunkIndex(voxel / VoxelChunk::SIZE)).set(local.x, local.y, local.z, value);
+    markEdited(voxel, voxel + 1);
+}
+
+/**
+ * @brief Wypełnia prostopadłościan wokseli
+ * @param min Najmniejszy woksel (włącznie)
+ * @param max Największy woksel (wyłącznie)
+ * @param value Wartość
+ *
+ * @details Fragmenty pokryte w całości zastępowane są fragmentem
+ * jednorodnym (lub usuwane, gdy wartością jest powietrze).
+ */
+void VoxelWorld::fillBox(const glm::ivec3& min, const glm::ivec3& max, uint8_t value) {
+    glm::ivec3 lo = glm::max(min, glm::ivec3(0));
+    glm::ivec3 hi = glm::min(max, getSize());
+    if (glm::any(glm::greaterThanEqual(lo, hi))) return;
+
+    const int S = VoxelChunk::SIZE;
+    glm::ivec3 firstChunk = lo / S;
+    glm::ivec3 lastChunk = (hi - 1) / S;
+    for (int cy = firstChunk.y; cy <= lastChunk.y; ++cy) {
+        for (int cz = firstChunk.z; cz <= lastChunk.z; ++cz) {
+            for (int cx = firstChunk.x; cx <= lastChunk.x; ++cx) {
+                glm::ivec3 chunkOrigin = glm::ivec3(cx, cy, cz) * S;
+                glm::ivec3 a = glm::max(lo, chunkOrigin) - chunkOrigin;
+                glm::ivec3 b = glm::min(hi, chunkOrigin + S) - chunkOrigin;
+                int index = chunkIndex(glm::ivec3(cx, cy, cz));
+                std::shared_ptr<VoxelChunk>& chunk = m_chunks[index];
+
+                if (a == glm::ivec3(0) && b == glm::ivec3(S)) {
+                    chunk = value == 0 ? nullptr : std::make_shared<VoxelChunk>(value);
+                    continue;
+                }
+                if (chunk ? chunk->isUniform() && chunk->getUniformValue() == value : value == 0) continue;
+
+                VoxelChunk& target = mutableChunk(index);
+                for (int y = a.y; y < b.y; ++y) {
+                    for (int z = a.z; z < b.z; ++z) {
+                        for (int x = a.x; x < b.x; ++x) target.set(x, y, z, value);
+                    }
+                }
+            }
+        }
+    }
+    markEdited(lo, hi);
+}
+
+/**
+ * @brief Wypełnia kulę wokseli
+ * @param center Środek we współrzędnych wokseli
+ * @param radius Promień w wokselach
+ * @param value Wartość
+ *
+ * @details Woksel należy do kuli, gdy jego środek leży w kuli. Fragmenty,
+ * których wszystkie narożniki leżą w kuli, zastępowane są w całości.
+ */
+void VoxelWorld::fillSphere(const glm::vec3& center, float radius, uint8_t value) {
+    if (radius <= 0.0f) return;
+    glm::ivec3 lo = glm::max(glm::ivec3(glm::floor(center - radius)), glm::ivec3(0));
+    glm::ivec3 hi = glm::min(glm::ivec3(glm::floor(center + radius)) + 1, getSize());
+    if (glm::any(glm::greaterThanEqual(lo, hi))) return;
+
+    const int S = VoxelChunk::SIZE;
+    const float radiusSquared = radius * radius;
+    glm::ivec3 firstChunk = lo / S;
+    glm::ivec3 lastChunk = (hi - 1) / S;
+    for (int cy = firstChunk.y; cy <= lastChunk.y; ++cy) {
+        for (int cz = firstChunk.z; cz <= lastChunk.z; ++cz) {
+            for (int cx = firstChunk.x; cx <= lastChunk.x; ++cx) {
+                glm::ivec3 chunkOrigin = glm::ivec3(cx, cy, cz) * S;
+                int index = chunkIndex(glm::ivec3(cx, cy, cz));
+                std::shared_ptr<VoxelChunk>& chunk = m_chunks[index];
+                if (chunk ? chunk->isUniform() && chunk->getUniformValue() == value : value == 0) continue;
+
+                bool inside = true;
+                for (int corner = 0; corner < 8 && inside; ++corner) {
+                    glm::vec3 offset(corner & 1 ? S - 0.5f : 0.5f, corner & 2 ? S - 0.5f : 0.5f,
+                                     corner & 4 ? S - 0.5f : 0.5f);
+                    glm::vec3 d = glm::vec3(chunkOrigin) + offset - center;
+                    inside = glm::dot(d, d) <= radiusSquared;
+                }
+                if (inside) {
+                    chunk = value == 0 ? nullptr : std::make_shared<VoxelChunk>(value);
+                    continue;
+                }
+
+                glm::ivec3 a = glm::max(lo, chunkOrigin) - chunkOrigin;
+                glm::ivec3 b = glm::min(hi, chunkOrigin + S) - chunkOrigin;
+                VoxelChunk* target = nullptr;
+                for (int y = a.y; y < b.y; ++y) {
+                    for (int z = a.z; z < b.z; ++z) {
+                        for (int x = a.x; x < b.x; ++x) {
+                            glm::vec3 d = glm::vec3(chunkOrigin + glm::ivec3(x, y, z)) + 0.5f - center;
+                            if (glm::dot(d, d) > radiusSquared) continue;
+                            if (!target) target = &mutableChunk(index);
+                            target->set(x, y, z, value);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    markEdited(lo, hi);
+}
+
+/**
+ * @brief Wypełnia cały świat funkcją wywoływaną równolegle dla fragmentów
+ * @param generator Funkcja zapisująca VOLUME wartości fragmentu o danym
+ *                  narożniku (we współrzędnych wokseli) w układzie VoxelChunk::index()
+ *
+ * @details Fragmenty z samego powietrza nie zajmują pamięci, a pozostałe
+ * zapisywane są z najmniejszą paletą. Wszystkie fragmenty oznaczane są
+ * jako zmienione.
+ */
+void VoxelWorld::generate(const std::function<void(const glm::ivec3& chunkOrigin, uint8_t* voxels)>& generator) {
+    ThreadPool::instance().parallelFor(m_chunks.size(), 4, [&](size_t begin, size_t end) {
+        std::vector<uint8_t> voxels(VoxelChunk::VOLUME);
+        for (size_t i = begin; i < end; ++i) {
+            generator(chunkCoord(static_cast<int>(i)) * VoxelChunk::SIZE, voxels.data());
+            VoxelChunk chunk;
+            chunk.encode(voxels.data());
+            bool empty = chunk.isUniform() && chunk.getUniformValue() == 0;
+            m_chunks[i] = empty ? nullptr : std::make_shared<VoxelChunk>(std::move(chunk));
+        }
+    });
+    for (int i = 0; i < getChunkCount(); ++i) markDirty(i);
+}
+
+/**
+ * @brief Zwraca fragment do zapisu (tworzy go lub kopiuje, jeśli jest współdzielony)
+ * @param index Indeks fragmentu
+ * @return Fragment należący tylko do świata
+ *
+ * @details Nowe wskaźniki do fragmentów powstają tylko w wątku głównym,
+ * więc use_count() == 1 oznacza, że żadne zadanie nie czyta fragmentu.
+ */
+VoxelChunk& VoxelWorld::mutableChunk(int index) {
+    std::shared_ptr<VoxelChunk>& chunk = m_chunks[index];
+    if (!chunk) {
+        chunk = std::make_shared<VoxelChunk>(0);
+    } else if (chunk.use_count() > 1) {
+        chunk = std::make_shared<VoxelChunk>(*chunk);
+    }
+    return *chunk;
+}
+
+/**
+ * @brief Oznacza fragmenty zależne od wokseli prostopadłościanu jako zmienione
+ * @param min Najmniejszy woksel (włącznie)
+ * @param max Największy woksel (wyłącznie)
+ *
+ * @details Prostopadłościan poszerzany jest o jeden woksel, bo ścianki
+ * woksela zależą od jego sześciu sąsiadów.
+ */
+void VoxelWorld::markEdited(const glm::ivec3& min, const glm::ivec3& max) {
+    glm::ivec3 firstChunk = glm::max(min - 1, glm::ivec3(0)) / VoxelChunk::SIZE;
+    glm::ivec3 lastChunk = glm::min(max, getSize() - 1) / VoxelChunk::SIZE;
+    for (int cy = firstChunk.y; cy <= lastChunk.y; ++cy) {
+        for (int cz = firstChunk.z; cz <= lastChunk.z; ++cz) {
+            for (int cx = firstChunk.x; cx <= lastChunk.x; ++cx) markDirty(chunkIndex(glm::ivec3(cx, cy, cz)));
+        }
+    }
+}
+
+/**
+ * @brief Oznacza fragment jako zmieniony
+ * @param index Indeks fragmentu
+ */
+void VoxelWorld::markDirty(int index) {
+    m_versions[index]++;
+    if (m_dirtyFlags[index]) return;
+    m_dirtyFlags[index] = 1;
+    m_dirtyChunks.push_back(index);
+}
+
+/**
+ * @brief Odbiera listę fragmentów zmienionych od ostatniego wywołania
+ * @param chunks Lista, do której dopisywane są indeksy
+ */
+void VoxelWorld::takeDirtyChunks(std::vector<int>& chunks) {
+    for (int index : m_dirtyChunks) m_dirtyFlags[index] = 0;
+    chunks.insert(chunks.end(), m_dirtyChunks.begin(), m_dirtyChunks.end());
+    m_dirtyChunks.clear();
+}
+
+/**
+ * @brief Zwraca pamięć zajmowaną przez fragmenty
+ * @return Liczba bajtów
+ */
+size_t VoxelWorld::getMemoryUsage() const {
+    size_t bytes = m_chunks.capacity() * sizeof(std::shared_ptr<VoxelChunk>) + m_versions.capacity() * sizeof(uint32_t) +
+                   m_dirtyFlags.capacity();
+    for (const std::shared_ptr<VoxelChunk>& chunk : m_chunks) {
+        if (chunk) bytes += chunk->getMemoryUsage();
+    }
+    return bytes;
+}
@@ -0,0 +1,318 @@
+// VoxelWorld.hpp
+#ifndef VOXEL_WORLD_HPP
+#define VOXEL_WORLD_HPP
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @class VoxelChunk
+ * @brief Fragment SIZE^3 wokseli zapisany paletą i upakowanymi indeksami
+ *
+ * Woksel to jeden bajt (0 = powietrze). Fragment przechowuje paletę
+ * występujących wartości i indeks palety na woksel zapisany 0, 1, 2, 4 lub
+ * 8 bitami, zależnie od liczby wartości. Fragment jednorodny (np. sama
+ * skała) nie ma tablicy indeksów, a typowy fragment z kilkoma materiałami
+ * zajmuje 2-4 razy mniej niż tablica bajtów.
+ */
+class VoxelChunk {
+public:
+    static const int SIZE = 32;                     /**< Bok fragmentu w wokselach */
+    static const int VOLUME = SIZE * SIZE * SIZE;   /**< Liczba wokseli fragmentu */
+
+private:
+    std::vector<uint8_t> m_palette;     /**< Wartości wokseli występujące we fragmencie */
+    std::vector<uint64_t> m_indices;    /**< Indeksy palety upakowane po m_bits bitów */
+    int m_bits;                         /**< Bity na woksel (0 = fragment jednorodny) */
+
+    /**
+     * @brief Zmienia szerokość indeksów z zachowaniem zawartości
+     * @param bits Nowa liczba bitów na woksel (1, 2, 4 lub 8)
+     */
+    void repack(int bits);
+
+    /**
+     * @brief Zapisuje indeks palety woksela
+     * @param index Indeks woksela
+     * @param paletteIndex Indeks palety
+     */
+    void storeIndex(int index, uint32_t paletteIndex);
+
+public:
+    /**
+     * @brief Konstruktor VoxelChunk - fragment jednorodny
+     * @param value Wartość wszystkich wokseli
+     */
+    explicit VoxelChunk(uint8_t value = 0);
+
+    /**
+     * @brief Zwraca indeks woksela w układzie fragmentu (x zmienia się najszybciej)
+     * @param x Kolumna
+     * @param y Warstwa
+     * @param z Wiersz
+     * @return Indeks w [0, VOLUME)
+     */
+    static int index(int x, int y, int z) { return (y * SIZE + z) * SIZE + x; }
+
+    /**
+     * @brief Zwraca wartość woksela
+     * @param index Indeks woksela
+     * @return Wartość (0 = powietrze)
+     */
+    uint8_t getAt(int index) const {
+        if (m_bits == 0) return m_palette[0];
+        uint32_t bit = static_cast<uint32_t>(index) * m_bits;
+        return m_palette[(m_indices[bit >> 6] >> (bit & 63)) & ((1u << m_bits) - 1)];
+    }
+
+    /**
+     * @brief Zwraca wartość woksela
+     * @param x Kolumna
+     * @param y Warstwa
+     * @param z Wiersz
+     * @return Wartość (0 = powietrze)
+     */
+    uint8_t get(int x, int y, int z) const { return getAt(index(x, y, z)); }
+
+    /**
+     * @brief Ustawia wartość woksela (paleta i szerokość indeksów rosną w razie potrzeby)
+     * @param x Kolumna
+     * @param y Warstwa
+     * @param z Wiersz
+     * @param value Wartość
+     */
+    void set(int x, int y, int z, uint8_t value);
+
+    /**
+     * @brief Wypełnia fragment jedną wartością
+     * @param value Wartość
+     */
+    void fill(uint8_t value);
+
+    /**
+     * @brief Zapisuje fragment z tablicy bajtów z najmniejszą paletą
+     * @param voxels VOLUME wartości w układzie index()
+     */
+    void encode(const uint8_t* voxels);
+
+    /**
+     * @brief Rozpakowuje fragment do tablicy bajtów
+     * @param voxels Tablica VOLUME wartości w układzie index()
+     */
+    void decode(uint8_t* voxels) const;
+
+    /**
+     * @brief Sprawdza, czy wszystkie woksele mają tę samą wartość
+     * @return true dla fragmentu jednorodnego
+     */
+    bool isUniform() const { return m_bits == 0; }
+
+    /**
+     * @brief Zwraca wartość fragmentu jednorodnego
+     * @return Wartość pierwszego wpisu palety
+     */
+    uint8_t getUniformValue() const { return m_palette[0]; }
+
+    /**
+     * @brief Sprawdza, czy wartość jest w palecie fragmentu
+     * @param value Wartość
+     * @return false jeśli żaden woksel nie ma tej wartości (true nie daje
+     *         pewności, bo set() nie usuwa wartości z palety)
+     */
+    bool mayContain(uint8_t value) const;
+
+    /**
+     * @brief Zwraca liczbę bitów na woksel
+     * @return 0, 1, 2, 4 lub 8
+     */
+    int getBitsPerVoxel() const { return m_bits; }
+
+    /**
+     * @brief Zwraca zajmowaną pamięć
+     * @return Liczba bajtów
+     */
+    size_t getMemoryUsage() const;
+};
+
+/**
+ * @class VoxelWorld
+ * @brief Ograniczony świat wokseli podzielony na fragmenty
+ *
+ * Fragmenty trzymane są przez std::shared_ptr, a fragment bez wskaźnika
+ * to samo powietrze. Zadania w tle (siatkowanie) dostają wskaźniki do
+ * fragmentów, więc nie blokują edycji: zmiana fragmentu, do którego
+ * odwołuje się zadanie, zapisuje jego kopię (kopiowanie przy zapisie).
+ * Świat edytowany jest tylko z wątku głównego.
+ *
+ * Każda edycja zwiększa wersję dotkniętych fragmentów i dopisuje je do
+ * listy zmienionych - także sąsiadów, gdy zmieniony woksel leży na
+ * granicy, bo od niego zależą ich ścianki. Listę odbiera jeden odbiorca
+ * (VoxelRenderer) przez takeDirtyChunks().
+ */
+class VoxelWorld {
+private:
+    glm::ivec3 m_chunkCounts;                           /**< Liczba fragmentów w osiach */
+    glm::vec3 m_origin;                                 /**< Narożnik świata */
+    float m_voxelSize;                                  /**< Bok woksela [m] */
+    std::vector<std::shared_ptr<VoxelChunk>> m_chunks;  /**< Fragmenty (nullptr = powietrze) */
+    std::vector<uint32_t> m_versions;                   /**< Wersje fragmentów */
+    std::vector<int> m_dirtyChunks;                     /**< Fragmenty zmienione od ostatniego odbioru */
+    std::vector<uint8_t> m_dirtyFlags;                  /**< Czy fragment jest na liście zmienionych */
+
+    /**
+     * @brief Zwraca fragment do zapisu (tworzy go lub kopiuje, jeśli jest współdzielony)
+     * @param index Indeks fragmentu
+     * @return Fragment należący tylko do świata
+     */
+    VoxelChunk& mutableChunk(int index);
+
+    /**
+     * @brief Oznacza fragmenty zależne od wokseli prostopadłościanu jako zmienione
+     * @param min Najmniejszy woksel (włącznie)
+     * @param max Największy woksel (wyłącznie)
+     */
+    void markEdited(const glm::ivec3& min, const glm::ivec3& max);
+
+public:
+    /**
+     * @brief Konstruktor VoxelWorld - świat wypełniony powietrzem
+     * @param chunkCounts Liczba fragmentów w osiach
+     * @param origin Narożnik świata
+     * @param voxelSize Bok woksela [m]
+     */
+    explicit VoxelWorld(const glm::ivec3& chunkCounts, const glm::vec3& origin = glm::vec3(0.0f),
+                        float voxelSize = 1.0f);
+
+    /**
+     * @brief Zwraca liczbę fragmentów w osiach
+     * @return Liczba fragmentów
+     */
+    const glm::ivec3& getChunkCounts() const { return m_chunkCounts; }
+
+    /**
+     * @brief Zwraca łączną liczbę fragmentów
+     * @return Liczba fragmentów
+     */
+    int getChunkCount() const { return static_cast<int>(m_chunks.size()); }
+
+    /**
+     * @brief Zwraca rozmiar świata w wokselach
+     * @return Liczba wokseli w osiach
+     */
+    glm::ivec3 getSize() const { return m_chunkCounts * VoxelChunk::SIZE; }
+
+    /**
+     * @brief Zwraca narożnik świata
+     * @return Pozycja w przestrzeni świata
+     */
+    const glm::vec3& getOrigin() const { return m_origin; }
+
+    /**
+     * @brief Zwraca bok woksela
+     * @return Bok [m]
+     */
+    float getVoxelSize() const { return m_voxelSize; }
+
+    /**
+     * @brief Zwraca indeks fragmentu
+     * @param chunk Współrzędne fragmentu
+     * @return Indeks lub -1 poza światem
+     */
+    int chunkIndex(const glm::ivec3& chunk) const;
+
+    /**
+     * @brief Zwraca współrzędne fragmentu
+     * @param index Indeks fragmentu
+     * @return Współrzędne fragmentu
+     */
+    glm::ivec3 chunkCoord(int index) const;
+
+    /**
+     * @brief Sprawdza, czy woksel leży w świecie
+     * @param voxel Współrzędne woksela
+     * @return true jeśli woksel leży w świecie
+     */
+    bool contains(const glm::ivec3& voxel) const;
+
+    /**
+     * @brief Zamienia pozycję w przestrzeni świata na współrzędne woksela
+     * @param position Pozycja
+     * @return Współrzędne woksela zawierającego pozycję
+     */
+    glm::ivec3 voxelAt(const glm::vec3& position) const;
+
+    /**
+     * @brief Zwraca wartość woksela
+     * @param voxel Współrzędne woksela
+     * @return Wartość (0 = powietrze, także poza światem)
+     */
+    uint8_t getVoxel(const glm::ivec3& voxel) const;
+
+    /**
+     * @brief Ustawia wartość woksela
+     * @param voxel Współrzędne woksela (poza światem ignorowane)
+     * @param value Wartość
+     */
+    void setVoxel(const glm::ivec3& voxel, uint8_t value);
+
+    /**
+     * @brief Wypełnia prostopadłościan wokseli
+     * @param min Najmniejszy woksel (włącznie)
+     * @param max Największy woksel (wyłącznie)
+     * @param value Wartość
+     */
+    void fillBox(const glm::ivec3& min, const glm::ivec3& max, uint8_t value);
+
+    /**
+     * @brief Wypełnia kulę wokseli
+     * @param center Środek we współrzędnych wokseli
+     * @param radius Promień w wokselach
+     * @param value Wartość
+     */
+    void fillSphere(const glm::vec3& center, float radius, uint8_t value);
+
+    /**
+     * @brief Wypełnia cały świat funkcją wywoływaną równolegle dla fragmentów
+     * @param generator Funkcja zapisująca VOLUME wartości fragmentu o danym
+     *                  narożniku (we współrzędnych wokseli) w układzie VoxelChunk::index()
+     */
+    void generate(const std::function<void(const glm::ivec3& chunkOrigin, uint8_t* voxels)>& generator);
+
+    /**
+     * @brief Zwraca fragment do odczytu
+     * @param index Indeks fragmentu
+     * @return Fragment lub nullptr (samo powietrze)
+     */
+    std::shared_ptr<const VoxelChunk> getChunk(int index) const { return m_chunks[index]; }
+
+    /**
+     * @brief Zwraca wersję fragmentu (zwiększaną przy każdej zmianie)
+     * @param index Indeks fragmentu
+     * @return Wersja
+     */
+    uint32_t getChunkVersion(int index) const { return m_versions[index]; }
+
+    /**
+     * @brief Oznacza fragment jako zmieniony
+     * @param index Indeks fragmentu
+     */
+    void markDirty(int index);
+
+    /**
+     * @brief Odbiera listę fragmentów zmienionych od ostatniego wywołania
+     * @param chunks Lista, do której dopisywane są indeksy
+     */
+    void takeDirtyChunks(std::vector<int>& chunks);
+
+    /**
+     * @brief Zwraca pamięć zajmowaną przez fragmenty
+     * @return Liczba bajtów
+     */
+    size_t getMemoryUsage() const;
+};
+
+#endif // VOXEL_WORLD_HPP
@@ -13,6 +13,34 @@
 #include "Transform/TransformableGeometry.hpp"
 #include "BitmapHandler.hpp"
 #include "TexturedObject.hpp"
+#include "RenderGraph/RenderGraph.hpp"
+#include "MultiView/MultiViewRenderer.hpp"
+#include "Lighting/LightCuller.hpp"
+#include "Batching/StaticBatcher.hpp"
+#include "Batching/DynamicBatcher.hpp"
+#include "Material/MaterialTable.hpp"
+#include "Mesh/LodChain.hpp"
+#include "Mesh/MeshletCuller.hpp"
+#include "Impostor/ImpostorRenderer.hpp"
+#include "Procedural/ProceduralRenderer.hpp"
+#include "Impostor/RayCastRenderer.hpp"
+#include "PointCloud/PointCloudBuilder.hpp"
+#include "PointCloud/PointCloudRenderer.hpp"
+#include "Particles/ParticleSystem.hpp"
+#include "Particles/ParticleRenderer.hpp"
+#include "Terrain/TerrainRenderer.hpp"
+#include "Grid/GridRenderer.hpp"
+#include "Voxel/VoxelRenderer.hpp"
+#include "Volume/MarchingCubes.hpp"
+#include "Animation/KeyframeAnimator.hpp"
+#include "Animation/ProceduralCharacter.hpp"
+#include "Animation/SkinnedRenderer.hpp"
+#include "Animation/VertexAnimationRenderer.hpp"
+#include "Quality/QualityGovernor.hpp"
+#include "Quality/SharpenUpscaler.hpp"
+#include "Shader/ShaderUtils.hpp"
+#include "Stats/RenderStats.hpp"
+#include <fstream>
 #include <iostream>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -84,18 +112,53 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform vec3 objectColor;
+
+// Kamera aktualnego widoku (jeden zakres bufora uniformów na widok)
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+// Dane obiektów wysyłane raz na klatkę: 4 kolumny macierzy modelu + lista świateł, materiał i przenikanie
+uniform samplerBuffer objectData;
+uniform bool useObjectData;
+uniform int objectIndex;
+uniform ivec2 lightList; // lista świateł obiektów rysowanych bez objectData
+uniform int materialIndex; // materiał obiektów rysowanych bez objectData
 
 flat out vec3 Normal;  // Kwalifikator 'flat' dla płaskiego cieniowania
 out vec3 FragPos;
 out vec2 TexCoord;
+flat out vec3 ObjectColor;
+flat out ivec2 LightList;
+flat out int MaterialIndex;
+flat out float Dissolve;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    mat4 modelMatrix = model;
+    ObjectColor = objectColor;
+    LightList = lightList;
+    MaterialIndex = materialIndex;
+    Dissolve = 0.0;
+    if (useObjectData) {
+        int base = (objectIndex + gl_InstanceID) * 5;
+        modelMatrix = mat4(texelFetch(objectData, base),
+                           texelFetch(objectData, base + 1),
+                           texelFetch(objectData, base + 2),
+                           texelFetch(objectData, base + 3));
+        vec4 lightsAndMaterial = texelFetch(objectData, base + 4);
+        ObjectColor = vec3(1.0); // kolor obiektu zawiera jego materiał
+        LightList = ivec2(lightsAndMaterial.xy);
+        MaterialIndex = int(lightsAndMaterial.z);
+        Dissolve = lightsAndMaterial.w;
+    }
+
+    gl_Position = projection * view * modelMatrix * vec4(aPos, 1.0);
+    FragPos = vec3(modelMatrix * vec4(aPos, 1.0));
+    Normal = mat3(transpose(inverse(modelMatrix))) * aNormal;
     TexCoord = aTexCoord;
 }
 )";
@@ -105,6 +168,7 @@ void main()
  *
  * Shader implementujący model oświetlenia Phonga z obsługą wielu świateł.
  * Wykorzystuje płaskie cieniowanie dzięki kwalifikatorowi 'flat' dla normalnych.
+ * Kompilowany po wierszu #version i LightCuller::getShaderSource().
  */
 /**
  * @struct Light
@@ -153,104 +217,55 @@ void main()
  * - 2 = stożkowe (spot light)
  */
 const char* fragmentShaderSourceFlat = R"(
-#version 330 core
 out vec4 FragColor;
 
 flat in vec3 Normal;  // Płaskie interpolowane normalne
 in vec3 FragPos;
 in vec2 TexCoord;
 
+flat in vec3 ObjectColor;
+flat in ivec2 LightList; // początek i długość listy świateł obiektu
+flat in int MaterialIndex;
+flat in float Dissolve; // udział pikseli zastąpionych impostorem
+
 uniform sampler2D texture1;
-uniform vec3 objectColor;
-uniform vec3 viewPos;
 uniform bool useTexture;
 
-// Struktura dla światła
-struct Light {
-    vec3 position;
-    vec3 direction;
-    vec3 color;
-    float ambientIntensity;
-    float diffuseIntensity;
-    float specularIntensity;
-    float constant;
-    float linear;
-    float quadratic;
-    float cutoff; // dla światła stożkowego
-    float outerCutoff; // dla światła stożkowego
-    int type; // 0 = punktowe, 1 = kierunkowe, 2 = stożkowe
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
 };
 
-#define MAX_LIGHTS 8
-uniform Light lights[MAX_LIGHTS];
-uniform int activeLightCount;
-uniform int currentLightMode; // 0 = tylko pierwsze światło, 1 = tylko drugie światło, 2 = wszystkie
-
-// Funkcja obliczająca oświetlenie Phonga dla danego światła
-vec3 calculatePhongLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 objectColor) {
-    vec3 lightDir;
-    float attenuation = 1.0;
-
-    // Obliczenie kierunku światła i tłumienia w zależności od typu
-    if (light.type == 1) { // światło kierunkowe
-        lightDir = normalize(-light.direction);
-        attenuation = 1.0; // brak tłumienia dla światła kierunkowego
-    } else { // światło punktowe lub stożkowe
-        lightDir = normalize(light.position - fragPos);
-        float distance = length(light.position - fragPos);
-        attenuation = 1.0 / (light.constant + light.linear * distance +
-                           light.quadratic * (distance * distance));
-
-        // Sprawdzenie dla światła stożkowego
-        if (light.type == 2) {
-            float theta = dot(lightDir, normalize(-light.direction));
-            float epsilon = light.cutoff - light.outerCutoff;
-            float intensity = clamp((theta - light.outerCutoff) / epsilon, 0.0, 1.0);
-            attenuation *= intensity;
-        }
-    }
-
-    // Ambient
-    vec3 ambient = light.ambientIntensity * light.color;
-
-    // Diffuse
-    float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = light.diffuseIntensity * diff * light.color;
-
-    // Specular
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
-    vec3 specular = light.specularIntensity * spec * light.color;
-
-    // Połącz wszystkie składowe
-    return (ambient + diffuse + specular) * attenuation;
+// Próg z macierzy Bayera 4x4 (ten sam wzór w shaderze impostorów)
+float ditherThreshold() {
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,
+                                      3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+    return (bayer[pixel.y * 4 + pixel.x] + 0.5) / 16.0;
 }
 
 void main()
 {
+    // Przenikanie z impostorem: siatka oddaje piksele o progu poniżej Dissolve
+    if (Dissolve > 0.0 && ditherThreshold() < Dissolve) discard;
+
     vec3 color;
     if (useTexture) {
         color = texture(texture1, TexCoord).rgb;
     } else {
-        color = objectColor;
+        color = ObjectColor;
     }
 
     vec3 normal = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
     vec3 result = vec3(0.0);
+    PackedMaterial material = materialData[MaterialIndex];
 
-    // Oblicz oświetlenie dla aktywnych świateł
-    if (currentLightMode == 0) {
-        // Tylko pierwsze światło
-        result += calculatePhongLight(lights[0], normal, FragPos, viewDir, color);
-    } else if (currentLightMode == 1) {
-        // Tylko drugie światło
-        result += calculatePhongLight(lights[1], normal, FragPos, viewDir, color);
-    } else if (currentLightMode == 2) {
-        // Wszystkie światła
-        for (int i = 0; i < min(activeLightCount, 2); i++) {
-            result += calculatePhongLight(lights[i], normal, FragPos, viewDir, color);
-        }
+    // Oblicz oświetlenie tylko dla świateł przydzielonych obiektowi
+    for (int i = 0; i < LightList.y; i++) {
+        int lightIndex = texelFetch(lightIndices, LightList.x + i).r;
+        result += calculatePhongLight(lightData[lightIndex], material, normal, FragPos, viewDir);
     }
 
     // Mieszanie z kolorem obiektu
@@ -272,18 +287,53 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform vec3 objectColor;
+
+// Kamera aktualnego widoku (jeden zakres bufora uniformów na widok)
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
+};
+
+// Dane obiektów wysyłane raz na klatkę: 4 kolumny macierzy modelu + lista świateł, materiał i przenikanie
+uniform samplerBuffer objectData;
+uniform bool useObjectData;
+uniform int objectIndex;
+uniform ivec2 lightList; // lista świateł obiektów rysowanych bez objectData
+uniform int materialIndex; // materiał obiektów rysowanych bez objectData
 
 out vec3 Normal;  // Normalne interpolowane przez rasterizer
 out vec3 FragPos;
 out vec2 TexCoord;
+flat out vec3 ObjectColor;
+flat out ivec2 LightList;
+flat out int MaterialIndex;
+flat out float Dissolve;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    mat4 modelMatrix = model;
+    ObjectColor = objectColor;
+    LightList = lightList;
+    MaterialIndex = materialIndex;
+    Dissolve = 0.0;
+    if (useObjectData) {
+        int base = (objectIndex + gl_InstanceID) * 5;
+        modelMatrix = mat4(texelFetch(objectData, base),
+                           texelFetch(objectData, base + 1),
+                           texelFetch(objectData, base + 2),
+                           texelFetch(objectData, base + 3));
+        vec4 lightsAndMaterial = texelFetch(objectData, base + 4);
+        ObjectColor = vec3(1.0); // kolor obiektu zawiera jego materiał
+        LightList = ivec2(lightsAndMaterial.xy);
+        MaterialIndex = int(lightsAndMaterial.z);
+        Dissolve = lightsAndMaterial.w;
+    }
+
+    gl_Position = projection * view * modelMatrix * vec4(aPos, 1.0);
+    FragPos = vec3(modelMatrix * vec4(aPos, 1.0));
+    Normal = mat3(transpose(inverse(modelMatrix))) * aNormal;
     TexCoord = aTexCoord;
 }
 )";
@@ -292,106 +342,58 @@ void main()
  * @brief Fragment shader source for Phong shading
  *
  * Shader implementujący model oświetlenia Phonga z gładko interpolowanymi normalnymi.
+ * Kompilowany po wierszu #version i LightCuller::getShaderSource().
  */
 const char* fragmentShaderSourcePhong = R"(
-#version 330 core
 out vec4 FragColor;
 
 in vec3 Normal;  // Gładko interpolowane normalne
 in vec3 FragPos;
 in vec2 TexCoord;
 
+flat in vec3 ObjectColor;
+flat in ivec2 LightList; // początek i długość listy świateł obiektu
+flat in int MaterialIndex;
+flat in float Dissolve; // udział pikseli zastąpionych impostorem
+
 uniform sampler2D texture1;
-uniform vec3 objectColor;
-uniform vec3 viewPos;
 uniform bool useTexture;
 
-// Struktura dla światła
-struct Light {
-    vec3 position;
-    vec3 direction;
-    vec3 color;
-    float ambientIntensity;
-    float diffuseIntensity;
-    float specularIntensity;
-    float constant;
-    float linear;
-    float quadratic;
-    float cutoff; // dla światła stożkowego
-    float outerCutoff; // dla światła stożkowego
-    int type; // 0 = punktowe, 1 = kierunkowe, 2 = stożkowe
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition;
 };
 
-#define MAX_LIGHTS 8
-uniform Light lights[MAX_LIGHTS];
-uniform int activeLightCount;
-uniform int currentLightMode; // 0 = tylko pierwsze światło, 1 = tylko drugie światło, 2 = wszystkie
-
-// Funkcja obliczająca oświetlenie Phonga dla danego światła
-vec3 calculatePhongLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 objectColor) {
-    vec3 lightDir;
-    float attenuation = 1.0;
-
-    // Obliczenie kierunku światła i tłumienia w zależności od typu
-    if (light.type == 1) { // światło kierunkowe
-        lightDir = normalize(-light.direction);
-        attenuation = 1.0; // brak tłumienia dla światła kierunkowego
-    } else { // światło punktowe lub stożkowe
-        lightDir = normalize(light.position - fragPos);
-        float distance = length(light.position - fragPos);
-        attenuation = 1.0 / (light.constant + light.linear * distance +
-                           light.quadratic * (distance * distance));
-
-        // Sprawdzenie dla światła stożkowego
-        if (light.type == 2) {
-            float theta = dot(lightDir, normalize(-light.direction));
-            float epsilon = light.cutoff - light.outerCutoff;
-            float intensity = clamp((theta - light.outerCutoff) / epsilon, 0.0, 1.0);
-            attenuation *= intensity;
-        }
-    }
-
-    // Ambient
-    vec3 ambient = light.ambientIntensity * light.color;
-
-    // Diffuse
-    float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = light.diffuseIntensity * diff * light.color;
-
-    // Specular
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
-    vec3 specular = light.specularIntensity * spec * light.color;
-
-    // Połącz wszystkie składowe
-    return (ambient + diffuse + specular) * attenuation;
+// Próg z macierzy Bayera 4x4 (ten sam wzór w shaderze impostorów)
+float ditherThreshold() {
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,
+                                      3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+    return (bayer[pixel.y * 4 + pixel.x] + 0.5) / 16.0;
 }
 
 void main()
 {
+    // Przenikanie z impostorem: siatka oddaje piksele o progu poniżej Dissolve
+    if (Dissolve > 0.0 && ditherThreshold() < Dissolve) discard;
+
     vec3 color;
     if (useTexture) {
         color = texture(texture1, TexCoord).rgb;
     } else {
-        color = objectColor;
+        color = ObjectColor;
     }
 
     vec3 normal = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
     vec3 result = vec3(0.0);
+    PackedMaterial material = materialData[MaterialIndex];
 
-    // Oblicz oświetlenie dla aktywnych świateł
-    if (currentLightMode == 0) {
-        // Tylko pierwsze światło
-        result += calculatePhongLight(lights[0], normal, FragPos, viewDir, color);
-    } else if (currentLightMode == 1) {
-        // Tylko drugie światło
-        result += calculatePhongLight(lights[1], normal, FragPos, viewDir, color);
-    } else if (currentLightMode == 2) {
-        // Wszystkie światła
-        for (int i = 0; i < min(activeLightCount, 2); i++) {
-            result += calculatePhongLight(lights[i], normal, FragPos, viewDir, color);
-        }
+    // Oblicz oświetlenie tylko dla świateł przydzielonych obiektowi
+    for (int i = 0; i < LightList.y; i++) {
+        int lightIndex = texelFetch(lightIndices, LightList.x + i).r;
+        result += calculatePhongLight(lightData[lightIndex], material, normal, FragPos, viewDir);
     }
 
     // Mieszanie z kolorem obiektu
@@ -431,33 +433,48 @@ float lastX = 400, lastY = 300; ///< Poprzednie pozycje myszy
 bool cameraEnabled = true;    ///< Flaga włączenia sterowania kamerą
 Camera::CameraType cameraType = Camera::FPS; ///< Typ kamery
 
-// Zmienne globalne dla animacji
-float rotationAngle = 0.0f;   ///< Kąt rotacji dla animacji
-float cubeRotation = 0.0f;    ///< Rotacja sześcianu
+// Animacja obiektów sceny: ścieżki klipu sceny
+enum SceneTrack { SCENE_TRACK_CYLINDER, SCENE_TRACK_SPHERE, SCENE_TRACK_LETTER_H, SCENE_TRACK_WAGON, SCENE_TRACK_COUNT };
+KeyframeAnimator sceneAnimator(SCENE_TRACK_COUNT); ///< Odtwarzanie klipu sceny
+SkeletonPose scenePose;       ///< Przekształcenia obiektów z klipu sceny
 GeometryRenderer* geometryRenderer = nullptr; ///< Wskaźnik do renderera geometrii
 int renderMode = 0; ///< Tryb renderowania (0 = wszystkie kształty, 1 = tylko zadania z instrukcji)
+RenderGraph renderGraph; ///< Graf renderowania budowany co klatkę
+MultiViewRenderer multiViewRenderer; ///< Renderer wielu widoków ze wspólnym odrzucaniem
+bool pictureInPictureEnabled = false; ///< Flaga widoku z góry (obraz w obrazie)
+QualityGovernor qualityGovernor; ///< Regulator jakości (dynamiczna rozdzielczość)
+SharpenUpscaler upscaler;        ///< Skalowanie obrazu z wyostrzaniem
+LightCuller lightCuller;         ///< Przydział świateł do obiektów
+StaticBatcher staticBatcher;     ///< Scalone paczki obiektów statycznych
+DynamicBatcher dynamicBatcher;   ///< Łączenie małych ruchomych obiektów co klatkę
+ImpostorRenderer impostorRenderer; ///< Impostory odległych obiektów
+bool impostorCrowdEnabled = false; ///< Flaga tłumu liter H (demonstracja impostorów)
+ProceduralRenderer proceduralRenderer; ///< Bryły parametryczne generowane w vertex shaderze
+RayCastRenderer rayCastRenderer; ///< Sfery i cylindry rysowane śledzeniem promienia
+bool crystalLatticeEnabled = false; ///< Flaga sieci krystalicznej (demonstracja sfer i cylindrów)
+PointCloudRenderer pointCloudRenderer; ///< Strumieniowana chmura punktów z oktalnego drzewa
+ParticleSystem particleSystem;   ///< Cząsteczki fontanny (symulacja na CPU)
+ParticleRenderer particleRenderer; ///< Rysowanie cząsteczek z bufora strumieniowego
+TerrainRenderer terrainRenderer;  ///< Teren z mapy wysokości z ciągłym LOD
+GridRenderer gridRenderer;        ///< Nieskończona siatka pomocnicza podłogi
+VoxelRenderer voxelRenderer;      ///< Świat wokseli z siatkowaniem w tle
+std::shared_ptr<VoxelWorld> voxelWorld;  ///< Edytowalny świat wokseli (nullptr = wyłączony)
+std::unique_ptr<ScalarVolume> isoVolume; ///< Pole skalarne izopowierzchni (nullptr = wyłączona)
+MarchingCubes marchingCubes;      ///< Ekstrakcja izopowierzchni (bufory bloków używane ponownie)
+Mesh isoMesh = {0, 0, 0, 0};      ///< Siatka izopowierzchni na GPU
+float isoValue = 0.0f;            ///< Bieżąca izowartość
+MaterialId isoMaterial = MaterialTable::DEFAULT_MATERIAL; ///< Materiał izopowierzchni
+SkinnedRenderer skinnedRenderer;  ///< Tłum postaci ze szkieletem (skinning na GPU lub CPU)
+std::shared_ptr<Crowd> crowd;     ///< Animowany tłum (nullptr = wyłączony)
+VertexAnimationRenderer vertexAnimationRenderer; ///< Tłum z animacją wypaloną do tekstury wierzchołków
+std::shared_ptr<VertexAnimationCrowd> bakedCrowd; ///< Tłum z wypaloną animacją (nullptr = wyłączony)
+double frameCpuStart = 0.0;      ///< Czas rozpoczęcia pracy CPU nad klatką
 
 // Macierze transformacji
 glm::mat4 projection; ///< Macierz projekcji
 glm::mat4 view;       ///< Macierz widoku
 glm::mat4 model;      ///< Macierz modelu
 
-// Struktura reprezentująca światło
-struct Light {
-    glm::vec3 position;           ///< Pozycja światła
-    glm::vec3 direction;          ///< Kierunek światła (dla kierunkowego i stożkowego)
-    glm::vec3 color;              ///< Kolor światła
-    float ambientIntensity;       ///< Intensywność składowej ambient
-    float diffuseIntensity;       ///< Intensywność składowej diffuse
-    float specularIntensity;      ///< Intensywność składowej specular
-    float constant;               ///< Stały współczynnik tłumienia
-    float linear;                 ///< Liniowy współczynnik tłumienia
-    float quadratic;              ///< Kwadratowy współczynnik tłumienia
-    float cutoff;                 ///< Kąt wewnętrzny stożka światła
-    float outerCutoff;            ///< Kąt zewnętrzny stożka światła
-    int type;                     ///< Typ światła (0 = punktowe, 1 = kierunkowe, 2 = stożkowe)
-};
-
 Light lights[8];                 ///< Tablica świateł (maksymalnie 8)
 int activeLightCount = 2;        ///< Liczba aktywnych świateł
 int currentLightMode = 2;        ///< Tryb oświetlenia (0 = tylko pierwsze, 1 = tylko drugie, 2 = wszystkie)
@@ -474,6 +491,446 @@ TransformableObject* wagonik2 = nullptr; ///< Drugi wagonik (dziecko)
 TransformableObject* wagonik3 = nullptr; ///< Trzeci wagonik (dziecko)
 TransformableObject* wagonik4 = nullptr; ///< Czwarty wagonik (dziecko)
 
+/**
+ * @brief Buduje od nowa paczki obiektów statycznych sceny
+ *
+ * Ponownie scala także obiekty, które wcześniej wypadły z paczek po przesunięciu.
+ */
+void rebuildStaticBatches() {
+    std::vector<TransformableObject*> objects;
+    if (sceneManager) {
+        for (size_t i = 0; i < sceneManager->getObjectCount(); ++i) {
+            objects.push_back(sceneManager->getObject(i));
+        }
+    }
+    staticBatcher.build(objects);
+}
+
+/**
+ * @brief Dodaje lub usuwa tłum liter H w oddali
+ *
+ * Litery ustawione są w siatce 10 x 10 za sceną, więc z domyślnej pozycji
+ * kamery większość z nich rysowana jest jako impostory.
+ */
+void toggleImpostorCrowd() {
+    if (!sceneManager) return;
+    const int crowdSize = 10;
+    impostorCrowdEnabled = !impostorCrowdEnabled;
+    for (int i = 0; i < crowdSize * crowdSize; ++i) {
+        std::string name = "TlumH_" + std::to_string(i);
+        if (impostorCrowdEnabled) {
+            int row = i / crowdSize;
+            int column = i % crowdSize;
+            float hue = static_cast<float>(i) / (crowdSize * crowdSize);
+            TransformableObject* letter = sceneManager->createLetterH(name,
+                glm::vec3((column - crowdSize / 2) * 4.0f, 1.5f, -40.0f - row * 6.0f),
+                2.0f, 3.0f, 0.5f,
+                glm::vec3(0.3f + 0.6f * hue, 0.4f, 0.9f - 0.6f * hue));
+            letter->setRotation(glm::vec3(0.0f, column * 20.0f, 0.0f));
+        } else {
+            sceneManager->removeObject(name);
+        }
+    }
+    std::cout << "Tlum liter H: " << (impostorCrowdEnabled ? "WLACZONY" : "WYLACZONY") << std::endl;
+}
+
+/**
+ * @brief Dodaje lub usuwa sieć krystaliczną za sceną
+ *
+ * Sieć regularna 64 x 16 x 64 atomów (na przemian dwa rodzaje) z wiązaniami
+ * do sąsiadów wzdłuż osi - ok. 65 tys. sfer i 190 tys. cylindrów rysowanych
+ * przez RayCastRenderer.
+ */
+void toggleCrystalLattice() {
+    const int sizeX = 64, sizeY = 16, sizeZ = 64;
+    const float spacing = 0.8f;
+    crystalLatticeEnabled = !crystalLatticeEnabled;
+    rayCastRenderer.clear();
+    if (crystalLatticeEnabled) {
+        glm::vec3 origin(-0.5f * spacing * (sizeX - 1), 2.0f, -30.0f);
+        auto atom = [&](int x, int y, int z) { return origin + glm::vec3(x, y, -z) * spacing; };
+        for (int z = 0; z < sizeZ; ++z) {
+            for (int y = 0; y < sizeY; ++y) {
+                for (int x = 0; x < sizeX; ++x) {
+                    bool metal = (x + y + z) % 2 == 0;
+                    rayCastRenderer.addSphere(atom(x, y, z), metal ? 0.22f : 0.3f,
+                                              metal ? glm::vec3(0.6f, 0.4f, 0.9f) : glm::vec3(0.3f, 0.9f, 0.4f));
+                    glm::vec3 bondColor(0.7f, 0.7f, 0.7f);
+                    if (x + 1 < sizeX) rayCastRenderer.addCylinder(atom(x, y, z), atom(x + 1, y, z), 0.06f, bondColor);
+                    if (y + 1 < sizeY) rayCastRenderer.addCylinder(atom(x, y, z), atom(x, y + 1, z), 0.06f, bondColor);
+                    if (z + 1 < sizeZ) rayCastRenderer.addCylinder(atom(x, y, z), atom(x, y, z + 1), 0.06f, bondColor);
+                }
+            }
+        }
+    }
+    std::cout << "Siec krystaliczna: " << (crystalLatticeEnabled ? "WLACZONA" : "WYLACZONA") << " ("
+              << rayCastRenderer.getSphereCount() << " sfer, " << rayCastRenderer.getCylinderCount()
+              << " cylindrow)" << std::endl;
+}
+
+/**
+ * @brief Otwiera lub zamyka chmurę punktów przed sceną
+ *
+ * Przy pierwszym użyciu plik drzewa budowany jest z syntetycznego terenu
+ * (10 mln punktów na kwadracie 100 x 100); większe zbiory przygotowuje
+ * narzędzie PointCloudConverter.
+ */
+void togglePointCloud() {
+    const char* path = "chmura_punktow.octree";
+    if (pointCloudRenderer.isOpen()) {
+        pointCloudRenderer.close();
+        std::cout << "Chmura punktow: WYLACZONA" << std::endl;
+        return;
+    }
+    if (!std::ifstream(path).good()) {
+        std::cout << "Chmura punktow: budowanie " << path << " z syntetycznego terenu (jednorazowo)..." << std::endl;
+        SyntheticPointCloudSource source(10000000, 100.0f);
+        if (!PointCloudBuilder::build(source, path)) return;
+    }
+    if (pointCloudRenderer.open(path)) {
+        pointCloudRenderer.setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-50.0f, -8.0f, -110.0f)));
+        std::cout << "Chmura punktow: WLACZONA (budzet " << pointCloudRenderer.getPointBudget() << " punktow)" << std::endl;
+    }
+}
+
+/**
+ * @brief Włącza lub wygasza fontannę cząsteczek
+ *
+ * Emiter tworzy 250 tys. cząsteczek na sekundę żyjących 3-5 s, więc po
+ * kilku sekundach żyje ich około miliona. Po wyłączeniu emisji żywe
+ * cząsteczki dożywają swojego czasu.
+ */
+void toggleParticleFountain() {
+    if (particleSystem.isEmitting()) {
+        particleSystem.setEmitting(false);
+        std::cout << "Fontanna czasteczek: WYLACZONA" << std::endl;
+        return;
+    }
+    ParticleEmitterSettings settings;
+    settings.position = glm::vec3(8.0f, -1.8f, -6.0f);
+    settings.positionSpread = glm::vec3(0.2f, 0.05f, 0.2f);
+    settings.velocity = glm::vec3(0.0f, 9.0f, 0.0f);
+    settings.velocitySpread = glm::vec3(2.0f, 1.5f, 2.0f);
+    settings.rate = 250000.0f;
+    settings.minLifetime = 3.0f;
+    settings.maxLifetime = 5.0f;
+    settings.drag = 0.2f;
+    settings.floorHeight = -2.0f;
+    settings.restitution = 0.3f;
+    settings.startSize = 0.04f;
+    settings.endSize = 0.02f;
+    settings.startColor = glm::vec4(0.5f, 0.8f, 1.0f, 0.25f);
+    settings.endColor = glm::vec4(0.1f, 0.3f, 0.9f, 0.0f);
+    particleSystem.setSettings(settings);
+    particleSystem.setEmitting(true);
+    std::cout << "Fontanna czasteczek: WLACZONA (do " << particleSystem.getCapacity() << " czasteczek)" << std::endl;
+}
+
+/**
+ * @brief Włącza lub wyłącza teren wokół sceny
+ *
+ * Teren proceduralny ma bok 1024 m i wysokości do około 80 m; wokół sceny
+ * przechodzi w płaski plac tuż pod podłogą, więc jej nie przesłania.
+ */
+void toggleTerrain() {
+    if (terrainRenderer.isOpen()) {
+        terrainRenderer.close();
+        std::cout << "Teren: WYLACZONY" << std::endl;
+        return;
+    }
+    TerrainSettings settings;
+    settings.size = 1024.0f;
+    settings.levels = 8;
+    settings.origin = glm::vec3(-settings.size * 0.5f, 0.0f, -settings.size * 0.5f);
+
+    ProceduralTerrainSettings noise;
+    noise.flatCenter = glm::vec2(settings.size * 0.5f);
+    noise.flatRadius = 30.0f;
+    noise.flatHeight = -2.05f;
+    if (terrainRenderer.open(std::make_shared<ProceduralTerrainSource>(noise), settings)) {
+        std::cout << "Teren: WLACZONY" << std::endl;
+    }
+}
+
+/**
+ * @brief Włącza lub wyłącza świat wokseli obok sceny
+ *
+ * Świat ma 8x3x8 fragmentów po 32^3 woksele o boku 25 cm (64 x 24 x 64 m)
+ * i pagórkowaty teren z trawy, ziemi i skały. Wartości wokseli to
+ * identyfikatory materiałów z MaterialTable, tworzonych przy pierwszym
+ * włączeniu.
+ */
+void toggleVoxelWorld() {
+    if (voxelWorld) {
+        voxelRenderer.clearWorld();
+        voxelWorld.reset();
+        std::cout << "Swiat wokseli: WYLACZONY" << std::endl;
+        return;
+    }
+    static MaterialId grass = MaterialTable::DEFAULT_MATERIAL;
+    static MaterialId dirt = MaterialTable::DEFAULT_MATERIAL;
+    static MaterialId stone = MaterialTable::DEFAULT_MATERIAL;
+    if (grass == MaterialTable::DEFAULT_MATERIAL) {
+        grass = MaterialTable::instance().createMaterial(MaterialTable::fromColor(glm::vec3(0.30f, 0.60f, 0.20f)));
+        dirt = MaterialTable::instance().createMaterial(MaterialTable::fromColor(glm::vec3(0.45f, 0.32f, 0.20f)));
+        stone = MaterialTable::instance().createMaterial(MaterialTable::fromColor(glm::vec3(0.50f, 0.50f, 0.52f)));
+    }
+
+    voxelWorld = std::make_shared<VoxelWorld>(glm::ivec3(8, 3, 8), glm::vec3(40.0f, -2.0f, -32.0f), 0.25f);
+    const uint8_t grassValue = static_cast<uint8_t>(grass);
+    const uint8_t dirtValue = static_cast<uint8_t>(dirt);
+    const uint8_t stoneValue = static_cast<uint8_t>(stone);
+    voxelWorld->generate([=](const glm::ivec3& chunkOrigin, uint8_t* voxels) {
+        const int S = VoxelChunk::SIZE;
+        for (int z = 0; z < S; ++z) {
+            for (int x = 0; x < S; ++x) {
+                float wx = static_cast<float>(chunkOrigin.x + x);
+                float wz = static_cast<float>(chunkOrigin.z + z);
+                int height = static_cast<int>(24.0f + 10.0f * std::sin(wx * 0.045f) * std::cos(wz * 0.05f) +
+                                              4.0f * std::sin((wx + wz) * 0.13f));
+                for (int y = 0; y < S; ++y) {
+                    int wy = chunkOrigin.y + y;
+                    uint8_t value = 0;
+                    if (wy < height - 4) value = stoneValue;
+                    else if (wy < height - 1) value = dirtValue;
+                    else if (wy < height) value = grassValue;
+                    voxels[VoxelChunk::index(x, y, z)] = value;
+                }
+            }
+        }
+    });
+    voxelRenderer.setWorld(voxelWorld);
+    std::cout << "Swiat wokseli: WLACZONY (" << voxelWorld->getMemoryUsage() / 1024 << " KB)" << std::endl;
+}
+
+/**
+ * @brief Wykopuje kulę wokseli przed kamerą
+ *
+ * Przebudowywane są tylko fragmenty dotknięte zmianą (i sąsiedzi, gdy
+ * kula sięga ich granicy).
+ */
+void digVoxels() {
+    if (!voxelWorld) return;
+    glm::vec3 target = camera.getPosition() + camera.getFront() * 6.0f;
+    glm::vec3 center = (target - voxelWorld->getOrigin()) / voxelWorld->getVoxelSize();
+    voxelWorld->fillSphere(center, 2.0f / voxelWorld->getVoxelSize(), 0);
+}
+
+/**
+ * @brief Tworzy izopowierzchnię dla bieżącej izowartości i wysyła ją na GPU
+ */
+void extractIsosurface() {
+    if (!isoVolume || !geometryRenderer) return;
+    MeshData data;
+    marchingCubes.extract(*isoVolume, isoValue, data);
+    if (isoMesh.VAO) geometryRenderer->deleteMesh(isoMesh);
+    isoMesh = {0, 0, 0, 0};
+    if (!data.indices.empty()) geometryRenderer->setupMesh(isoMesh, data.vertices, data.indices);
+
+    const MarchingCubesStats& stats = marchingCubes.getStats();
+    std::cout << "Izopowierzchnia " << isoValue << ": " << stats.triangles << " trojkatow, bloki "
+              << stats.activeBricks << "/" << stats.bricks << ", " << stats.milliseconds << " ms" << std::endl;
+}
+
+/**
+ * @brief Włącza lub wyłącza izopowierzchnię pola skalarnego obok sceny
+ *
+ * Pole 192^3 próbek w sześcianie o boku 6 m to kula zaburzona żyroidą,
+ * podobna do wyników symulacji z wieloma warstwami.
+ */
+void toggleIsosurface() {
+    if (isoVolume) {
+        if (isoMesh.VAO && geometryRenderer) geometryRenderer->deleteMesh(isoMesh);
+        isoMesh = {0, 0, 0, 0};
+        isoVolume.reset();
+        std::cout << "Izopowierzchnia: WYLACZONA" << std::endl;
+        return;
+    }
+    if (isoMaterial == MaterialTable::DEFAULT_MATERIAL) {
+        isoMaterial = MaterialTable::instance().createMaterial(MaterialTable::fromColor(glm::vec3(0.85f, 0.55f, 0.2f)));
+    }
+    const int samples = 192;
+    const glm::vec3 center(-14.0f, 2.0f, -10.0f);
+    const float halfSize = 3.0f;
+    isoVolume = std::make_unique<ScalarVolume>(glm::ivec3(samples), center - halfSize,
+                                               glm::vec3(2.0f * halfSize / (samples - 1)));
+    isoVolume->generate([center, halfSize](const glm::vec3& position) {
+        glm::vec3 p = (position - center) / halfSize;
+        const float k = 10.0f;
+        float gyroid = std::sin(p.x * k) * std::cos(p.y * k) + std::sin(p.y * k) * std::cos(p.z * k) +
+                       std::sin(p.z * k) * std::cos(p.x * k);
+        return 0.8f - glm::length(p) + 0.12f * gyroid;
+    });
+    extractIsosurface();
+}
+
+/**
+ * @brief Tworzy klip ruchu obiektów sceny
+ * @return Klip z jedną ścieżką na SceneTrack
+ *
+ * Ruch jest wypalany do kluczy co 1/30 s przez jeden wspólny okres 20 pi
+ * sekund: kula krąży po orbicie z wahaniem wysokości (tempo 0.7), walec
+ * obraca się wokół X i Y (10 i 7 obrotów), litera H wokół Y (3 obroty),
+ * a pierwszy wagonik wokół X (8 obrotów), więc pętla klipu jest płynna.
+ */
+std::shared_ptr<KeyframeClip> createSceneClip() {
+    const float duration = 20.0f * 3.14159265f;
+    const int keyCount = static_cast<int>(duration * 30.0f) + 1;
+    KeyframeTrack tracks[SCENE_TRACK_COUNT];
+    for (int k = 0; k < keyCount; ++k) {
+        float time = duration * static_cast<float>(k) / static_cast<float>(keyCount - 1);
+        for (KeyframeTrack& track : tracks) track.rotationTimes.push_back(time);
+        tracks[SCENE_TRACK_CYLINDER].rotations.push_back(glm::quat(glm::vec3(time, time * 0.7f, 0.0f)));
+        tracks[SCENE_TRACK_SPHERE].rotations.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        tracks[SCENE_TRACK_LETTER_H].rotations.push_back(glm::quat(glm::vec3(0.0f, time * 0.3f, 0.0f)));
+        tracks[SCENE_TRACK_WAGON].rotations.push_back(glm::quat(glm::vec3(time * 0.8f, 0.0f, 0.0f)));
+
+        const float orbitRadius = 3.0f;
+        tracks[SCENE_TRACK_SPHERE].translationTimes.push_back(time);
+        tracks[SCENE_TRACK_SPHERE].translations.push_back(
+            glm::vec3(std::sin(time) * orbitRadius, 1.0f + std::cos(time * 0.7f) * 0.5f, std::cos(time) * orbitRadius));
+    }
+
+    auto clip = std::make_shared<KeyframeClip>("scena");
+    for (const KeyframeTrack& track : tracks) clip->addTrack(track);
+    return clip;
+}
+
+/**
+ * @struct CrowdPlacement
+ * @brief Parametry postaci w siatce tłumu demonstracyjnego
+ */
+struct CrowdPlacement {
+    glm::vec3 position;     /**< Pozycja stóp */
+    float yaw;              /**< Obrót wokół osi Y [rad] */
+    bool walking;           /**< true = chód, false = machanie ręką */
+    float time;             /**< Przesunięcie czasu klipu [s] */
+    float speed;            /**< Mnożnik tempa */
+    float scale;            /**< Skala postaci */
+};
+
+/**
+ * @brief Wylicza parametry postaci w kwadratowej siatce tłumu (co 1 m)
+ * @param x Kolumna siatki (rośnie w +X)
+ * @param z Wiersz siatki (rośnie w -Z)
+ * @param corner Pozycja postaci (0, 0)
+ * @return Parametry postaci
+ *
+ * Rozrzut jest deterministyczny (hash kolumny i wiersza): 70% postaci
+ * chodzi, reszta macha ręką, każda z innym obrotem, czasem i tempem.
+ */
+static CrowdPlacement placeCrowdCharacter(int x, int z, const glm::vec3& corner) {
+    unsigned int hash = static_cast<unsigned int>(x * 73856093) ^ static_cast<unsigned int>(z * 19349663);
+    hash = hash * 1103515245u + 12345u;
+    float random = static_cast<float>((hash >> 8) & 0xFFFF) / 65535.0f;
+    CrowdPlacement placement;
+    placement.position = corner + glm::vec3(static_cast<float>(x), 0.0f, -static_cast<float>(z));
+    placement.yaw = random * 6.2831853f;
+    placement.walking = random < 0.7f;
+    placement.time = random * 7.0f;
+    placement.speed = 0.8f + 0.4f * random;
+    placement.scale = 0.9f + 0.2f * static_cast<float>((hash >> 4) & 0xF) / 15.0f;
+    return placement;
+}
+
+/**
+ * @brief Włącza lub wyłącza tłum animowanych postaci obok sceny
+ *
+ * 2025 postaci (siatka 45 x 45 co 1 m) na placu za sceną; 70% chodzi
+ * w miejscu, reszta macha ręką, każda z innym przesunięciem czasu
+ * i tempem. Klawisz F2 przełącza skinning między GPU a CPU.
+ */
+void toggleCrowd() {
+    if (crowd) {
+        skinnedRenderer.clearCrowd();
+        crowd.reset();
+        std::cout << "Tlum postaci: WYLACZONY" << std::endl;
+        return;
+    }
+    static MaterialId crowdMaterial = MaterialTable::DEFAULT_MATERIAL;
+    if (crowdMaterial == MaterialTable::DEFAULT_MATERIAL) {
+        crowdMaterial = MaterialTable::instance().createMaterial(MaterialTable::fromColor(glm::vec3(0.25f, 0.45f, 0.8f)));
+    }
+
+    std::shared_ptr<Skeleton> skeleton = ProceduralCharacter::createSkeleton();
+    crowd = std::make_shared<Crowd>(skeleton);
+    int walk = crowd->addClip(ProceduralCharacter::createWalkClip(*skeleton));
+    int wave = crowd->addClip(ProceduralCharacter::createWaveClip(*skeleton));
+    crowd->setLocalBounds(ProceduralCharacter::getBounds());
+
+    const int side = 45;
+    for (int z = 0; z < side; ++z) {
+        for (int x = 0; x < side; ++x) {
+            CrowdPlacement placement = placeCrowdCharacter(x, z, glm::vec3(-22.0f, -2.0f, -16.0f));
+            CrowdCharacter character;
+            character.position = placement.position;
+            character.yaw = placement.yaw;
+            character.clip = placement.walking ? walk : wave;
+            character.time = placement.time;
+            character.speed = placement.speed;
+            crowd->addCharacter(character);
+        }
+    }
+    skinnedRenderer.setCrowd(crowd, ProceduralCharacter::createMesh(*skeleton), crowdMaterial);
+    std::cout << "Tlum postaci: WLACZONY (" << side * side << " postaci, " << skeleton->getBoneCount()
+              << " kosci)" << std::endl;
+}
+
+/**
+ * @brief Włącza lub wyłącza tłum z animacją wypaloną do tekstury
+ *
+ * 250 000 postaci (siatka 500 x 500 co 1 m) za placem tłumu ze
+ * szkieletem. Klipy chodu i machania wypalane są przy pierwszym
+ * włączeniu dla trzech poziomów szczegółów; potem CPU nie animuje
+ * postaci wcale - zostaje odrzucanie komórek siatki tłumu.
+ */
+void toggleBakedCrowd() {
+    if (bakedCrowd) {
+        vertexAnimationRenderer.clearCrowd();
+        bakedCrowd.reset();
+        std::cout << "Tlum z wypalona animacja: WYLACZONY" << std::endl;
+        return;
+    }
+    static std::shared_ptr<VertexAnimation> animation;
+    static MaterialId bakedMaterial = MaterialTable::DEFAULT_MATERIAL;
+    if (!animation) {
+        std::shared_ptr<Skeleton> skeleton = ProceduralCharacter::createSkeleton();
+        std::vector<SkinnedMeshData> lods = {ProceduralCharacter::createMesh(*skeleton, 8),
+                                             ProceduralCharacter::createMesh(*skeleton, 5),
+                                             ProceduralCharacter::createMesh(*skeleton, 3)};
+        std::vector<std::shared_ptr<const AnimationClip>> clips = {ProceduralCharacter::createWalkClip(*skeleton),
+                                                                   ProceduralCharacter::createWaveClip(*skeleton)};
+        auto baked = std::make_shared<VertexAnimation>();
+        double bakeStart = glfwGetTime();
+        if (!baked->bake(*skeleton, lods, clips, ProceduralCharacter::FRAME_RATE)) return;
+        std::cout << "Wypalono animacje wierzcholkow: " << baked->getFrameCount() << " klatek, "
+                  << baked->getMemoryUsage() / 1024 << " KB, " << (glfwGetTime() - bakeStart) * 1000.0 << " ms"
+                  << std::endl;
+        animation = baked;
+        bakedMaterial = MaterialTable::instance().createMaterial(MaterialTable::fromColor(glm::vec3(0.85f, 0.5f, 0.2f)));
+    }
+
+    bakedCrowd = std::make_shared<VertexAnimationCrowd>(animation);
+    bakedCrowd->setLodDistances({20.0f, 50.0f});
+    const int side = 500;
+    for (int z = 0; z < side; ++z) {
+        for (int x = 0; x < side; ++x) {
+            CrowdPlacement placement = placeCrowdCharacter(x, z, glm::vec3(-250.0f, -2.0f, -64.0f));
+            VertexAnimationInstance instance;
+            instance.position = placement.position;
+            instance.yaw = placement.yaw;
+            instance.clip = placement.walking ? 0 : 1;
+            instance.timeOffset = placement.time;
+            instance.speed = placement.speed;
+            instance.scale = placement.scale;
+            bakedCrowd->addInstance(instance);
+        }
+    }
+    vertexAnimationRenderer.setCrowd(bakedCrowd, bakedMaterial);
+    std::cout << "Tlum z wypalona animacja: WLACZONY (" << side * side << " postaci, "
+              << bakedCrowd->getCells().size() << " komorek)" << std::endl;
+}
+
 /**
  * @brief Callback klawiatury
  *
@@ -742,6 +1199,96 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
         }
         std::cout << "Drugie swiatlo: " << typeName << std::endl;
     }
+
+    if (key == GLFW_KEY_K && action == GLFW_PRESS) {
+        RenderStats::instance().print(std::cout);
+    }
+
+    if (key == GLFW_KEY_Q && action == GLFW_PRESS) {
+        qualityGovernor.setEnabled(!qualityGovernor.isEnabled());
+        std::cout << "Dynamiczna jakosc: " << (qualityGovernor.isEnabled() ? "WLACZONA" : "WYLACZONA") << std::endl;
+    }
+
+    if (key == GLFW_KEY_U && action == GLFW_PRESS) {
+        MeshletCuller& meshletCuller = MeshletCuller::instance();
+        meshletCuller.setEnabled(!meshletCuller.isEnabled());
+        std::cout << "Odrzucanie meshletow: " << (meshletCuller.isEnabled() ? "WLACZONE" : "WYLACZONE") << std::endl;
+    }
+
+    if (key == GLFW_KEY_I && action == GLFW_PRESS) {
+        impostorRenderer.setEnabled(!impostorRenderer.isEnabled());
+        std::cout << "Impostory: " << (impostorRenderer.isEnabled() ? "WLACZONE" : "WYLACZONE") << std::endl;
+    }
+
+    if (key == GLFW_KEY_Y && action == GLFW_PRESS) {
+        toggleImpostorCrowd();
+    }
+
+    if (key == GLFW_KEY_Z && action == GLFW_PRESS) {
+        toggleCrystalLattice();
+    }
+
+    if (key == GLFW_KEY_4 && action == GLFW_PRESS) {
+        togglePointCloud();
+    }
+
+    if (key == GLFW_KEY_5 && action == GLFW_PRESS) {
+        toggleParticleFountain();
+    }
+
+    if (key == GLFW_KEY_6 && action == GLFW_PRESS) {
+        toggleTerrain();
+    }
+
+    if (key == GLFW_KEY_7 && action == GLFW_PRESS) {
+        gridRenderer.setEnabled(!gridRenderer.isEnabled());
+        std::cout << "Siatka: " << (gridRenderer.isEnabled() ? "WLACZONA" : "WYLACZONA") << std::endl;
+    }
+
+    if (key == GLFW_KEY_8 && action == GLFW_PRESS) {
+        toggleVoxelWorld();
+    }
+
+    if (key == GLFW_KEY_9 && (action == GLFW_PRESS || action == GLFW_REPEAT)) {
+        digVoxels();
+    }
+
+    if (key == GLFW_KEY_0 && action == GLFW_PRESS) {
+        toggleIsosurface();
+    }
+
+    if ((key == GLFW_KEY_LEFT_BRACKET || key == GLFW_KEY_RIGHT_BRACKET) && action != GLFW_RELEASE && isoVolume) {
+        isoValue += key == GLFW_KEY_RIGHT_BRACKET ? 0.02f : -0.02f;
+        extractIsosurface();
+    }
+
+    if (key == GLFW_KEY_F1 && action == GLFW_PRESS) {
+        toggleCrowd();
+    }
+
+    if (key == GLFW_KEY_F2 && action == GLFW_PRESS) {
+        bool gpu = skinnedRenderer.getMode() == SkinningMode::CPU;
+        skinnedRenderer.setMode(gpu ? SkinningMode::GPU : SkinningMode::CPU);
+        std::cout << "Skinning postaci: " << (gpu ? "GPU (bufor tekstury kosci)" : "CPU (SIMD w puli watkow)") << std::endl;
+    }
+
+    if (key == GLFW_KEY_F3 && action == GLFW_PRESS) {
+        toggleBakedCrowd();
+    }
+
+    if (key == GLFW_KEY_E && action == GLFW_PRESS) {
+        proceduralRenderer.setEnabled(!proceduralRenderer.isEnabled());
+        std::cout << "Bryly proceduralne: " << (proceduralRenderer.isEnabled() ? "WLACZONE" : "WYLACZONE") << std::endl;
+    }
+
+    if (key == GLFW_KEY_N && action == GLFW_PRESS) {
+        rebuildStaticBatches();
+    }
+
+    if (key == GLFW_KEY_J && action == GLFW_PRESS) {
+        pictureInPictureEnabled = !pictureInPictureEnabled;
+        std::cout << "Widok z gory (obraz w obrazie): " << (pictureInPictureEnabled ? "WLACZONY" : "WYLACZONY") << std::endl;
+    }
 }
 
 /**
@@ -841,63 +1388,35 @@ void resizeCallback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
 
-/**
- * @brief Kompiluje shader OpenGL
- *
- * @param type Typ shadera (GL_VERTEX_SHADER lub GL_FRAGMENT_SHADER)
- * @param source Kod źródłowy shadera
- * @return GLuint ID skompilowanego shadera
- */
-GLuint compileShader(GLenum type, const char* source) {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
-
-    // Sprawdz bledy kompilacji
-    GLint success;
-    GLchar infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
-        std::cerr << "Blad kompilacji shadera:\n" << infoLog << std::endl;
-    }
-
-    return shader;
-}
-
 /**
  * @brief Tworzy i linkuje programy shaderowe
  *
  * Tworzy dwa programy shaderowe: dla trybu FLAT i PHONG.
  */
 void createShaderProgram() {
-    // Kompilacja shaderów dla trybu FLAT
-    GLuint vertexShaderFlat = compileShader(GL_VERTEX_SHADER, vertexShaderSourceFlat);
-    GLuint fragmentShaderFlat = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSourceFlat);
-
-    shaderProgramFlat = glCreateProgram();
-    glAttachShader(shaderProgramFlat, vertexShaderFlat);
-    glAttachShader(shaderProgramFlat, fragmentShaderFlat);
-    glLinkProgram(shaderProgramFlat);
-
-    // Kompilacja shaderów dla trybu PHONG
-    GLuint vertexShaderPhong = compileShader(GL_VERTEX_SHADER, vertexShaderSourcePhong);
-    GLuint fragmentShaderPhong = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSourcePhong);
-
-    shaderProgramPhong = glCreateProgram();
-    glAttachShader(shaderProgramPhong, vertexShaderPhong);
-    glAttachShader(shaderProgramPhong, fragmentShaderPhong);
-    glLinkProgram(shaderProgramPhong);
+    // Kompilacja i linkowanie programu dla trybu FLAT
+    GLuint vertexShaderFlat = ShaderUtils::compileShader(GL_VERTEX_SHADER, vertexShaderSourceFlat, "sceny (FLAT)");
+    const char* fragmentSourcesFlat[] = {"#version 330 core\n", LightCuller::getShaderSource(), fragmentShaderSourceFlat};
+    GLuint fragmentShaderFlat = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSourcesFlat, 3, "sceny (FLAT)");
+    shaderProgramFlat = ShaderUtils::linkProgram(vertexShaderFlat, fragmentShaderFlat, "sceny (FLAT)");
+
+    // Kompilacja i linkowanie programu dla trybu PHONG
+    GLuint vertexShaderPhong = ShaderUtils::compileShader(GL_VERTEX_SHADER, vertexShaderSourcePhong, "sceny (PHONG)");
+    const char* fragmentSourcesPhong[] = {"#version 330 core\n", LightCuller::getShaderSource(), fragmentShaderSourcePhong};
+    GLuint fragmentShaderPhong = ShaderUtils::compileShader(GL_FRAGMENT_SHADER, fragmentSourcesPhong, 3, "sceny (PHONG)");
+    shaderProgramPhong = ShaderUtils::linkProgram(vertexShaderPhong, fragmentShaderPhong, "sceny (PHONG)");
+
+    // Powiąż blok kamery i bufor danych obiektów renderera widoków
+    MultiViewRenderer::setupProgram(shaderProgramFlat);
+    MultiViewRenderer::setupProgram(shaderProgramPhong);
+    LightCuller::setupProgram(shaderProgramFlat);
+    LightCuller::setupProgram(shaderProgramPhong);
+    MaterialTable::setupProgram(shaderProgramFlat);
+    MaterialTable::setupProgram(shaderProgramPhong);
 
     // Ustaw domyślny program na PHONG
     currentShaderProgram = shaderProgramPhong;
     flatShading = false;
-
-    // Usuń shadery (już niepotrzebne po linkowaniu)
-    glDeleteShader(vertexShaderFlat);
-    glDeleteShader(fragmentShaderFlat);
-    glDeleteShader(vertexShaderPhong);
-    glDeleteShader(fragmentShaderPhong);
 }
 
 /**
@@ -960,13 +1479,6 @@ void update(Engine& engine) {
                            currentBackgroundColor.b, currentBackgroundColor.a);
     }
 
-    // Aktualizacja kątów obrotu
-    rotationAngle += 0.5f;
-    if (rotationAngle > 360.0f) rotationAngle -= 360.0f;
-
-    cubeRotation += 1.0f;
-    if (cubeRotation > 360.0f) cubeRotation -= 360.0f;
-
     // Oświetlenie krąży wokół sceny (pierwsze światło)
     float lightX = sin(glfwGetTime()) * 5.0f;
     float lightZ = cos(glfwGetTime()) * 5.0f;
@@ -999,46 +1511,48 @@ void update(Engine& engine) {
             camera.setMovementSpeed(2.5f);
     }
 
-    // Animacja obracającego się krążka
+    // Animacja obiektów sceny z klipu kluczowego (walec, kula, litera H, wagonik)
+    sceneAnimator.update(engine.getDeltaTime());
+    sceneAnimator.evaluate(scenePose);
     if (rotatecylinder) {
-        rotatecylinder->setRotation(glm::vec3(cubeRotation, cubeRotation * 0.7f, 0.0f));
+        rotatecylinder->setRotation(scenePose.getRotation(SCENE_TRACK_CYLINDER));
     }
-
-    // Animacja orbitującej kuli
     if (orbitingSphere) {
-        float time = glfwGetTime();
-        float orbitRadius = 3.0f;
-        glm::vec3 orbitPosition(
-            sin(time) * orbitRadius,
-            1.0f + cos(time * 0.7f) * 0.5f,
-            cos(time) * orbitRadius
-        );
-        orbitingSphere->setPosition(orbitPosition);
+        orbitingSphere->setPosition(scenePose.getTranslation(SCENE_TRACK_SPHERE));
     }
-
-    // Animacja litery H
     if (letterHObject) {
-        letterHObject->setRotation(glm::vec3(0.0f, rotationAngle * 0.5f, 0.0f));
+        letterHObject->setRotation(scenePose.getRotation(SCENE_TRACK_LETTER_H));
     }
-
-    // Animacja obiektu z hierarchią
     if (wagonik1) {
         float time = glfwGetTime();
-        wagonik1->setRotation(glm::vec3(rotationAngle * 1.5f, 0.0f, 0.0f));
+        wagonik1->setRotation(scenePose.getRotation(SCENE_TRACK_WAGON));
         wagonik1->translate(glm::vec3(sin(time * 0.8f) * 0.2f, 0.0f, 0.0f));
     }
+
+    // Symulacja cząsteczek (tablice zwalniane, gdy wygaszona fontanna nie ma już cząsteczek)
+    if (particleSystem.isEmitting() || particleSystem.getCount() > 0) {
+        particleSystem.update(engine.getDeltaTime());
+        if (!particleSystem.isEmitting() && particleSystem.getCount() == 0) {
+            particleSystem.clear();
+        }
+    }
+
+    // Animacja tłumu postaci (próbkowanie klipów i macierze kości w puli wątków)
+    if (crowd) {
+        crowd->update(engine.getDeltaTime());
+    }
 }
 
 /**
- * @brief Funkcja renderowania sceny
+ * @brief Rysuje wszystkie obiekty sceny do aktualnie powiązanego bufora ramki
  *
- * Wywoływana co klatkę, renderuje wszystkie obiekty w scenie.
+ * Wywoływana przez przebieg "Scena" grafu renderowania.
  */
-void render() {
+void renderScene(int width, int height) {
     if (!geometryRenderer) return;
 
-    // Ustaw macierze
-    float aspectRatio = 800.0f / 600.0f;
+    // Widok główny na całe okno, proporcje z rzeczywistego rozmiaru bufora ramki
+    float aspectRatio = height > 0 ? static_cast<float>(width) / static_cast<float>(height) : 1.0f;
     projection = glm::perspective(glm::radians(camera.getZoom()), aspectRatio, 0.1f, 100.0f);
 
     // Użyj widoku z kamery
@@ -1048,171 +1562,326 @@ void render() {
     geometryRenderer->setProjectionMatrix(projection);
     geometryRenderer->setViewMatrix(view);
 
+    multiViewRenderer.clearViews();
+    multiViewRenderer.addView({"Glowny", 0, 0, width, height, view, projection, viewPos, false});
+
+    // Obraz w obrazie: widok sceny z góry w prawym górnym rogu
+    if (pictureInPictureEnabled) {
+        int pipWidth = width / 3;
+        int pipHeight = height / 3;
+        glm::vec3 pipPosition(0.0f, 25.0f, 0.01f);
+        glm::mat4 pipView = glm::lookAt(pipPosition, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+        glm::mat4 pipProjection = glm::perspective(glm::radians(45.0f),
+            pipHeight > 0 ? static_cast<float>(pipWidth) / static_cast<float>(pipHeight) : 1.0f, 0.1f, 100.0f);
+        multiViewRenderer.addView({"Z gory", width - pipWidth - 10, height - pipHeight - 10,
+                                   pipWidth, pipHeight, pipView, pipProjection, pipPosition, true});
+    }
+
     // Uzywaj shadera
     glUseProgram(currentShaderProgram);
 
     // Pobierz lokalizacje uniformow z AKTUALNEGO programu shaderowego
     GLint modelLoc = glGetUniformLocation(currentShaderProgram, "model");
-    GLint viewLoc = glGetUniformLocation(currentShaderProgram, "view");
-    GLint projLoc = glGetUniformLocation(currentShaderProgram, "projection");
     GLint objectColorLoc = glGetUniformLocation(currentShaderProgram, "objectColor");
-    GLint viewPosLoc = glGetUniformLocation(currentShaderProgram, "viewPos");
     GLint useTextureLoc = glGetUniformLocation(currentShaderProgram, "useTexture");
     GLint texture1Loc = glGetUniformLocation(currentShaderProgram, "texture1");
-    GLint activeLightCountLoc = glGetUniformLocation(currentShaderProgram, "activeLightCount");
-    GLint currentLightModeLoc = glGetUniformLocation(currentShaderProgram, "currentLightMode");
-
-    // Ustaw uniformy wspolne dla wszystkich obiektow
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-    glUniform3fv(viewPosLoc, 1, glm::value_ptr(viewPos));
-    glUniform1i(activeLightCountLoc, activeLightCount);
-    glUniform1i(currentLightModeLoc, currentLightMode);
-
-    // Ustawienia tekstury dla teksturowanego sześcianu
-    glUniform1i(useTextureLoc, useTextures ? 1 : 0);
+    GLint lightListLoc = glGetUniformLocation(currentShaderProgram, "lightList");
+    GLint materialIndexLoc = glGetUniformLocation(currentShaderProgram, "materialIndex");
+
     glUniform1i(texture1Loc, 0); // Jednostka teksturująca 0
 
-    // Ustaw uniformy dla świateł - UWAGA: też z currentShaderProgram!
-    for (int i = 0; i < activeLightCount; i++) {
-        std::string lightStr = "lights[" + std::to_string(i) + "].";
-
-        glUniform3fv(glGetUniformLocation(currentShaderProgram, (lightStr + "position").c_str()), 1, glm::value_ptr(lights[i].position));
-        glUniform3fv(glGetUniformLocation(currentShaderProgram, (lightStr + "direction").c_str()), 1, glm::value_ptr(lights[i].direction));
-        glUniform3fv(glGetUniformLocation(currentShaderProgram, (lightStr + "color").c_str()), 1, glm::value_ptr(lights[i].color));
-        glUniform1f(glGetUniformLocation(currentShaderProgram, (lightStr + "ambientIntensity").c_str()), lights[i].ambientIntensity);
-        glUniform1f(glGetUniformLocation(currentShaderProgram, (lightStr + "diffuseIntensity").c_str()), lights[i].diffuseIntensity);
-        glUniform1f(glGetUniformLocation(currentShaderProgram, (lightStr + "specularIntensity").c_str()), lights[i].specularIntensity);
-        glUniform1f(glGetUniformLocation(currentShaderProgram, (lightStr + "constant").c_str()), lights[i].constant);
-        glUniform1f(glGetUniformLocation(currentShaderProgram, (lightStr + "linear").c_str()), lights[i].linear);
-        glUniform1f(glGetUniformLocation(currentShaderProgram, (lightStr + "quadratic").c_str()), lights[i].quadratic);
-        glUniform1f(glGetUniformLocation(currentShaderProgram, (lightStr + "cutoff").c_str()), lights[i].cutoff);
-        glUniform1f(glGetUniformLocation(currentShaderProgram, (lightStr + "outerCutoff").c_str()), lights[i].outerCutoff);
-        glUniform1i(glGetUniformLocation(currentShaderProgram, (lightStr + "type").c_str()), lights[i].type);
-    }
-
-    // Rysowanie teksturowanego sześcianu
-    model = texturedCube.getModelMatrix();
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
-
-    if (useTextures) {
-        glEnable(GL_TEXTURE_2D);
-        glActiveTexture(GL_TEXTURE0);
-        texturedCube.drawWithTexture();
+    // Światła włączone w bieżącym trybie oświetlenia
+    std::vector<Light> sceneLights;
+    if (currentLightMode == 0) {
+        sceneLights.push_back(lights[0]);
+    } else if (currentLightMode == 1) {
+        sceneLights.push_back(lights[1]);
     } else {
-        texturedCube.draw();
+        sceneLights.assign(lights, lights + activeLightCount);
     }
 
-    // Rysowanie teksturowanej kuli
-    model = texturedSphere.getModelMatrix();
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
+    std::vector<TransformableObject*> sceneObjects;
+    if (sceneManager && renderMode == 0) {
+        for (size_t i = 0; i < sceneManager->getObjectCount(); ++i) {
+            sceneObjects.push_back(sceneManager->getObject(i));
+        }
+    }
 
-    if (useTextures) {
-        glEnable(GL_TEXTURE_2D);
-        glActiveTexture(GL_TEXTURE0);
-        texturedSphere.drawWithTexture();
-    } else {
-        texturedSphere.draw();
+    // Obiekty statyczne rysowane są z paczek; pozostałe idą zwykłą ścieżką
+    std::vector<TransformableObject*> dynamicObjects;
+    if (renderMode == 0) {
+        staticBatcher.update(sceneObjects, dynamicObjects);
     }
 
-    // Rysowanie teksturowanego cylindra
-    model = texturedCylinder.getModelMatrix();
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
+    // Małe ruchome obiekty łączone są w kilka wywołań; pozostałe rysowane osobno
+    std::vector<TransformableObject*> batchRemaining;
+    dynamicBatcher.collect(dynamicObjects, batchRemaining);
 
-    if (useTextures) {
-        glEnable(GL_TEXTURE_2D);
-        glActiveTexture(GL_TEXTURE0);
-        texturedCylinder.drawWithTexture();
-    } else {
-        texturedCylinder.draw();
-    }
+    // Sfery i cylindry generowane są w vertex shaderze z podziałem dobranym do rozmiaru na ekranie
+    std::vector<TransformableObject*> meshObjects;
+    proceduralRenderer.collect(batchRemaining, viewPos, projection, height, meshObjects);
 
-    // Dla pozostałych obiektów wyłącz tekstury i używaj kolorów
-    glUniform1i(useTextureLoc, 0);
-    glDisable(GL_TEXTURE_2D);
+    // Odległe duże obiekty zastępowane są impostorami (w pasie przejścia rysowane oba)
+    std::vector<TransformableObject*> regularObjects;
+    impostorRenderer.collect(meshObjects, viewPos, regularObjects);
 
-    // Przełączanie między trybami renderowania
-    if (renderMode == 0) {
-        // Tryb domyślny: wszystkie kształty używając nowego systemu
-
-        // Renderowanie wszystkich obiektów w scenie
-        if (sceneManager) {
-            // Musimy ustawić macierz modelu dla każdego obiektu
-            // W klasach TransformableObject to robią wewnętrznie,
-            // ale tu musimy przekazać ją do shadera
-            for (size_t i = 0; i < sceneManager->getObjectCount(); ++i) {
-                TransformableObject* obj = sceneManager->getObject(i);
-                if (obj) {
-                    glm::mat4 modelMatrix = obj->getModelMatrix();
-                    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(modelMatrix));
-
-                    // Ustaw kolor obiektu
-                    glm::vec3 color = obj->getColor();
-                    glUniform3f(objectColorLoc, color.r, color.g, color.b);
-
-                    // Rysuj obiekt
-                    obj->draw();
-                }
-            }
+    // Przydział najważniejszych świateł do obiektów (limit z regulatora jakości)
+    lightCuller.update(sceneLights, regularObjects, qualityGovernor.getSettings().maxLights);
+
+    // Przesunięcie LOD z regulatora jakości (wybór poziomów sfer i litery H)
+    LodSelector::instance().setBias(qualityGovernor.getSettings().lodBias);
+    lightCuller.bind();
+    glm::ivec2 globalLightList = lightCuller.getGlobalList();
+    glUniform2i(lightListLoc, globalLightList.x, globalLightList.y);
+
+    // Obiekty rysowane bez danych obiektów używają materiału neutralnego i koloru z objectColor
+    MaterialTable::instance().bind();
+    glUniform1i(materialIndexLoc, MaterialTable::DEFAULT_MATERIAL);
+
+    // Odrzucanie obiektów dla wszystkich widoków naraz i wysłanie danych klatki
+    multiViewRenderer.beginFrame(regularObjects, &lightCuller);
+
+    std::vector<Frustum> viewFrustums;
+    for (int viewIndex = 0; viewIndex < multiViewRenderer.getViewCount(); ++viewIndex) {
+        const RenderView& renderView = multiViewRenderer.getView(viewIndex);
+        viewFrustums.push_back(Frustum::fromMatrix(renderView.projection * renderView.view));
+    }
+    dynamicBatcher.prepare(viewFrustums, globalLightList);
+    proceduralRenderer.prepare(viewFrustums, globalLightList);
+    impostorRenderer.prepare(viewFrustums, globalLightList);
+    rayCastRenderer.prepare(globalLightList);
+    pointCloudRenderer.update(viewPos, projection * view, projection, static_cast<float>(height));
+    terrainRenderer.update(viewPos, viewFrustums, globalLightList);
+    voxelRenderer.update(viewPos, viewFrustums, globalLightList);
+    skinnedRenderer.prepare(viewFrustums, globalLightList);
+    vertexAnimationRenderer.prepare(viewFrustums, viewPos, globalLightList, static_cast<float>(glfwGetTime()));
+    particleRenderer.prepare(particleSystem);
+    MeshletCuller::instance().beginFrame();
+
+    for (int viewIndex = 0; viewIndex < multiViewRenderer.getViewCount(); ++viewIndex) {
+        multiViewRenderer.bindView(viewIndex);
+        const RenderView& renderView = multiViewRenderer.getView(viewIndex);
+        LodSelector::instance().setView(renderView.position, renderView.projection, renderView.height);
+        MeshletCuller::instance().setView(renderView.position, renderView.projection * renderView.view);
+
+        // Ustawienia tekstury dla teksturowanego sześcianu
+        glUniform1i(useTextureLoc, useTextures ? 1 : 0);
+
+        // Rysowanie teksturowanego sześcianu
+        model = texturedCube.getModelMatrix();
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+        glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
+
+        if (useTextures) {
+            glEnable(GL_TEXTURE_2D);
+            glActiveTexture(GL_TEXTURE0);
+            texturedCube.drawWithTexture();
+        } else {
+            texturedCube.draw();
         }
 
-        // Rysowanie podłogi (płaszczyzny) starym systemem dla zachowania kompatybilności
-        model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(0.0f, -2.0f, 0.0f));
+        // Rysowanie teksturowanej kuli
+        model = texturedSphere.getModelMatrix();
         glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-        glUniform3f(objectColorLoc, 0.3f, 0.3f, 0.3f); // Szary
-        geometryRenderer->drawPlane(glm::vec3(0.0f, -2.0f, 0.0f), glm::vec2(20.0f, 20.0f));
+        glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
+
+        if (useTextures) {
+            glEnable(GL_TEXTURE_2D);
+            glActiveTexture(GL_TEXTURE0);
+            texturedSphere.drawWithTexture();
+        } else {
+            texturedSphere.draw();
+        }
 
-        // Rysowanie siatki
-        model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(0.0f, -2.0f, 0.0f));
+        // Rysowanie teksturowanego cylindra
+        model = texturedCylinder.getModelMatrix();
         glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-        glUniform3f(objectColorLoc, 0.5f, 0.5f, 0.5f); // Szary
+        glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
+
+        if (useTextures) {
+            glEnable(GL_TEXTURE_2D);
+            glActiveTexture(GL_TEXTURE0);
+            texturedCylinder.drawWithTexture();
+        } else {
+            texturedCylinder.draw();
+        }
+
+        // Dla pozostałych obiektów wyłącz tekstury i używaj kolorów
+        glUniform1i(useTextureLoc, 0);
+        glDisable(GL_TEXTURE_2D);
+
+        // Przełączanie między trybami renderowania
+        if (renderMode == 0) {
+            // Tryb domyślny: wszystkie kształty używając nowego systemu
+
+            // Renderowanie obiektów sceny widocznych w tym widoku
+            // (macierz modelu i materiał shader pobiera z bufora danych obiektów)
+            multiViewRenderer.drawVisibleObjects(viewIndex, currentShaderProgram);
+
+            // Rysowanie paczek obiektów statycznych (w tym podłogi)
+            staticBatcher.draw(viewFrustums[viewIndex], currentShaderProgram);
+
+            // Rysowanie małych ruchomych obiektów (scalonych lub instancjonowanych)
+            dynamicBatcher.draw(currentShaderProgram);
+
+            // Rysowanie brył parametrycznych bez buforów wierzchołków
+            proceduralRenderer.draw(flatShading);
+
+            // Rysowanie impostorów odległych obiektów
+            impostorRenderer.draw();
+
+            // Rysowanie sfer i cylindrów śledzeniem promienia
+            rayCastRenderer.draw(viewFrustums[viewIndex]);
+
+            // Rysowanie węzłów chmury punktów wybranych dla kamery głównej
+            pointCloudRenderer.draw(viewFrustums[viewIndex]);
+
+            // Rysowanie terenu (węzły wybrane dla kamery głównej)
+            terrainRenderer.draw(viewIndex);
+
+            // Rysowanie świata wokseli (fragmenty od najbliższych)
+            voxelRenderer.draw(viewIndex);
+
+            // Rysowanie izopowierzchni (pozycje wierzchołków w przestrzeni świata)
+            if (isoMesh.indexCount > 0 && viewFrustums[viewIndex].intersects(isoVolume->getBounds())) {
+                glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(glm::mat4(1.0f)));
+                glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
+                glUniform1i(materialIndexLoc, isoMaterial);
+                geometryRenderer->drawMesh(isoMesh);
+                glUniform1i(materialIndexLoc, MaterialTable::DEFAULT_MATERIAL);
+            }
+
+            // Rysowanie tłumu postaci ze szkieletem
+            skinnedRenderer.draw();
+
+            // Rysowanie tłumu z animacją z tekstury wierzchołków (komórka = jedno wywołanie)
+            vertexAnimationRenderer.draw();
+
+            // Rysowanie nieskończonej siatki (jeden trójkąt na ekran, po obiektach nieprzezroczystych)
+            gridRenderer.draw();
+
+            // Cząsteczki na końcu: mieszane addytywnie bez zapisu głębokości
+            particleRenderer.draw();
+
+        } else {
+            // Tryb zadań z instrukcji (stary system)
+            // Tu można dodać kod dla trybu zadań z instrukcji
+        }
+
+        // Rysowanie linii (układ współrzędnych)
         geometryRenderer->setDrawMode(GL_LINES);
-        geometryRenderer->drawGrid(glm::vec3(0.0f, -2.0f, 0.0f), 20, 1.0f);
-        geometryRenderer->setDrawMode(GL_TRIANGLES);
 
-    } else {
-        // Tryb zadań z instrukcji (stary system)
-        // Tu można dodać kod dla trybu zadań z instrukcji
-    }
+        // Oś X - czerwona
+        glUniform3f(objectColorLoc, 1.0f, 0.0f, 0.0f);
+        geometryRenderer->drawLine(glm::vec3(0.0f), glm::vec3(3.0f, 0.0f, 0.0f));
+
+        // Oś Y - zielona
+        glUniform3f(objectColorLoc, 0.0f, 1.0f, 0.0f);
+        geometryRenderer->drawLine(glm::vec3(0.0f), glm::vec3(0.0f, 3.0f, 0.0f));
+
+        // Oś Z - niebieska
+        glUniform3f(objectColorLoc, 0.0f, 0.0f, 1.0f);
+        geometryRenderer->drawLine(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 3.0f));
 
-    // Rysowanie linii (układ współrzędnych)
-    geometryRenderer->setDrawMode(GL_LINES);
+        // Rysowanie punktów (źródła światła)
+        geometryRenderer->setDrawMode(GL_POINTS);
 
-    // Oś X - czerwona
-    glUniform3f(objectColorLoc, 1.0f, 0.0f, 0.0f);
-    geometryRenderer->drawLine(glm::vec3(0.0f), glm::vec3(3.0f, 0.0f, 0.0f));
+        // Pierwsze światło (białe)
+        glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
+        geometryRenderer->drawPoint(lights[0].position, 10.0f, glm::vec3(1.0f, 1.0f, 1.0f));
 
-    // Oś Y - zielona
-    glUniform3f(objectColorLoc, 0.0f, 1.0f, 0.0f);
-    geometryRenderer->drawLine(glm::vec3(0.0f), glm::vec3(0.0f, 3.0f, 0.0f));
+        // Drugie światło (niebieskawe)
+        glUniform3f(objectColorLoc, 0.8f, 0.8f, 1.0f);
+        geometryRenderer->drawPoint(lights[1].position, 10.0f, glm::vec3(0.8f, 0.8f, 1.0f));
 
-    // Oś Z - niebieska
-    glUniform3f(objectColorLoc, 0.0f, 0.0f, 1.0f);
-    geometryRenderer->drawLine(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 3.0f));
+        // Rysowanie pozycji kamery (opcjonalnie, dla debugowania)
+        geometryRenderer->setDrawMode(GL_POINTS);
+        glUniform3f(objectColorLoc, 0.0f, 1.0f, 1.0f); // Cyjan
+        geometryRenderer->drawPoint(camera.getPosition(), 5.0f, glm::vec3(0.0f, 1.0f, 1.0f));
 
-    // Rysowanie punktów (źródła światła)
-    geometryRenderer->setDrawMode(GL_POINTS);
+        // Przywróć tryb rysowania
+        geometryRenderer->setDrawMode(GL_TRIANGLES);
+    }
+    MeshletCuller::instance().publishStats();
 
-    // Pierwsze światło (białe)
-    glUniform3f(objectColorLoc, 1.0f, 1.0f, 1.0f);
-    geometryRenderer->drawPoint(lights[0].position, 10.0f, glm::vec3(1.0f, 1.0f, 1.0f));
+    glViewport(0, 0, width, height);
+}
 
-    // Drugie światło (niebieskawe)
-    glUniform3f(objectColorLoc, 0.8f, 0.8f, 1.0f);
-    geometryRenderer->drawPoint(lights[1].position, 10.0f, glm::vec3(0.8f, 0.8f, 1.0f));
+/**
+ * @brief Funkcja renderowania sceny
+ *
+ * Wywoływana co klatkę. Buduje graf renderowania z przebiegów klatki,
+ * kompiluje go (usuwanie zbędnych przebiegów, kolejność, aliasowanie zasobów)
+ * i wykonuje.
+ */
+void render() {
+    if (!geometryRenderer) return;
 
-    // Rysowanie pozycji kamery (opcjonalnie, dla debugowania)
-    geometryRenderer->setDrawMode(GL_POINTS);
-    glUniform3f(objectColorLoc, 0.0f, 1.0f, 1.0f); // Cyjan
-    geometryRenderer->drawPoint(camera.getPosition(), 5.0f, glm::vec3(0.0f, 1.0f, 1.0f));
+    int framebufferWidth = 800, framebufferHeight = 600;
+    GLFWwindow* window = glfwGetCurrentContext();
+    if (window) {
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    }
 
-    // Przywróć tryb rysowania
-    geometryRenderer->setDrawMode(GL_TRIANGLES);
+    renderGraph.reset();
+    RenderResourceHandle backbuffer = renderGraph.importBackbuffer("Okno", framebufferWidth, framebufferHeight);
+
+    // Wewnętrzna rozdzielczość sceny wybierana przez regulator jakości
+    QualitySettings quality = qualityGovernor.getSettings();
+    int sceneWidth = std::max(1, static_cast<int>(framebufferWidth * quality.resolutionScale + 0.5f));
+    int sceneHeight = std::max(1, static_cast<int>(framebufferHeight * quality.resolutionScale + 0.5f));
+
+    if (sceneWidth == framebufferWidth && sceneHeight == framebufferHeight) {
+        renderGraph.addPass("Scena",
+            [backbuffer](RenderPassBuilder& builder) {
+                builder.write(backbuffer, RenderResourceUsage::COLOR_ATTACHMENT);
+            },
+            [backbuffer](const RenderPassResources& resources) {
+                const RenderTextureDesc& desc = resources.getTextureDesc(backbuffer);
+                renderScene(desc.width, desc.height);
+            });
+    } else {
+        // Scena w zmniejszonej rozdzielczości, następnie skalowanie do okna
+        RenderResourceHandle sceneColor = INVALID_RENDER_RESOURCE;
+        RenderResourceHandle sceneDepth = INVALID_RENDER_RESOURCE;
+
+        renderGraph.addPass("Scena",
+            [&](RenderPassBuilder& builder) {
+                sceneColor = builder.createTexture("Scena kolor", {sceneWidth, sceneHeight, GL_RGBA8});
+                sceneDepth = builder.createTexture("Scena glebokosc", {sceneWidth, sceneHeight, GL_DEPTH_COMPONENT24});
+                builder.write(sceneColor, RenderResourceUsage::COLOR_ATTACHMENT);
+                builder.write(sceneDepth, RenderResourceUsage::DEPTH_ATTACHMENT);
+            },
+            [&](const RenderPassResources&) {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                renderScene(sceneWidth, sceneHeight);
+            });
+
+        renderGraph.addPass("Skalowanie",
+            [&](RenderPassBuilder& builder) {
+                builder.read(sceneColor, RenderResourceUsage::SAMPLED);
+                builder.write(backbuffer, RenderResourceUsage::COLOR_ATTACHMENT);
+            },
+            [&](const RenderPassResources& resources) {
+                // Im mniejsza skala, tym mocniejsze wyostrzanie
+                float sharpness = (1.0f - quality.resolutionScale) * 0.8f;
+                upscaler.draw(resources.getTexture(sceneColor), sceneWidth, sceneHeight, sharpness);
+            });
+    }
+
+    renderGraph.compile();
+    renderGraph.execute();
+
+    // Pomiar klatki dla regulatora jakości (czas GPU z opóźnieniem kilku klatek)
+    double cpuMs = (glfwGetTime() - frameCpuStart) * 1000.0;
+    qualityGovernor.update(cpuMs, renderGraph.getTotalGpuTimeMs());
+    const QualitySettings& updated = qualityGovernor.getSettings();
+    if (updated.resolutionScale != quality.resolutionScale || updated.lodBias != quality.lodBias ||
+        updated.maxLights != quality.maxLights) {
+        std::cout << "Jakosc: " << QualityGovernor::getDecisionName(qualityGovernor.getLastDecision())
+                  << " (skala " << updated.resolutionScale << ")" << std::endl;
+    }
+    qualityGovernor.publishStats();
 }
 
 /**
@@ -1308,7 +1977,15 @@ int main() {
                              glm::vec3(-4.0f, 0.5f, 3.0f),
                              glm::vec3(45.0f, 30.0f, 0.0f),
                              glm::vec3(1.2f, 0.8f, 0.8f),
-                             glm::vec3(0.8f, 0.6f, 0.2f));
+                             glm::vec3(0.8f, 0.6f, 0.2f))->setStatic(true);
+
+    sceneAnimator.addLayer(createSceneClip());
+
+    // Podłoga jako obiekt statyczny sceny
+    sceneManager->createPlane("Floor",
+                              glm::vec3(0.0f, -2.0f, 0.0f),
+                              glm::vec2(20.0f, 20.0f),
+                              glm::vec3(0.3f, 0.3f, 0.3f))->setStatic(true);
 
     // Inicjalizacja teksturowanego sześcianu
     texturedCube.create(1.0f);
@@ -1340,6 +2017,87 @@ int main() {
     // Utworz shadery
     createShaderProgram();
 
+    if (!multiViewRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac renderera widokow" << std::endl;
+        return -1;
+    }
+
+    if (!upscaler.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac skalowania obrazu" << std::endl;
+        return -1;
+    }
+
+    if (!lightCuller.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac przydzialu swiatel" << std::endl;
+        return -1;
+    }
+
+    if (!MaterialTable::instance().initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac tabeli materialow" << std::endl;
+        return -1;
+    }
+
+    if (!dynamicBatcher.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac dynamicznych paczek" << std::endl;
+        return -1;
+    }
+
+    if (!impostorRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac impostorow" << std::endl;
+        return -1;
+    }
+
+    if (!proceduralRenderer.initialize(fragmentShaderSourceFlat, fragmentShaderSourcePhong)) {
+        std::cerr << "Nie udalo sie zainicjalizowac bryl proceduralnych" << std::endl;
+        return -1;
+    }
+
+    if (!rayCastRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac sfer i cylindrow" << std::endl;
+        return -1;
+    }
+
+    if (!pointCloudRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac chmury punktow" << std::endl;
+        return -1;
+    }
+
+    if (!particleRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac czasteczek" << std::endl;
+        return -1;
+    }
+
+    if (!terrainRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac terenu" << std::endl;
+        return -1;
+    }
+
+    if (!voxelRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac wokseli" << std::endl;
+        return -1;
+    }
+
+    if (!skinnedRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac postaci" << std::endl;
+        return -1;
+    }
+
+    if (!vertexAnimationRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac animacji wierzcholkow" << std::endl;
+        return -1;
+    }
+
+    // Siatka tuż nad podłogą (y = -2), żeby nie walczyła z nią o głębokość
+    if (!gridRenderer.initialize()) {
+        std::cerr << "Nie udalo sie zainicjalizowac siatki" << std::endl;
+        return -1;
+    }
+    GridSettings gridSettings;
+    gridSettings.height = -1.99f;
+    gridRenderer.setSettings(gridSettings);
+    rebuildStaticBatches();
+    qualityGovernor.setTargetFrameTime(1000.0 / engine.getFPS());
+
     // Ustawienie callbackow
     engine.setKeyCallback(keyCallback);
     engine.setMouseMoveCallback(mouseCallback);
@@ -1380,6 +2138,25 @@ int main() {
     std::cout << "M: Zmien tryb renderowania" << std::endl;
     std::cout << "B: Zmien kolor tla (5 opcji)" << std::endl;
     std::cout << "V: Wlacz/wylacz automatyczna zmiane tla" << std::endl;
+    std::cout << "K: Wypisz statystyki renderowania" << std::endl;
+    std::cout << "J: Wlacz/wylacz widok z gory (obraz w obrazie)" << std::endl;
+    std::cout << "N: Zbuduj od nowa paczki obiektow statycznych" << std::endl;
+    std::cout << "Q: Wlacz/wylacz dynamiczna jakosc (rozdzielczosc, LOD, swiatla)" << std::endl;
+    std::cout << "U: Wlacz/wylacz odrzucanie meshletow (ostroslup, stozek normalnych)" << std::endl;
+    std::cout << "I: Wlacz/wylacz impostory odleglych obiektow" << std::endl;
+    std::cout << "Y: Dodaj/usun tlum liter H w oddali" << std::endl;
+    std::cout << "E: Wlacz/wylacz bryly proceduralne (bez buforow wierzcholkow)" << std::endl;
+    std::cout << "Z: Dodaj/usun siec krystaliczna (sfery i cylindry sledzone promieniem)" << std::endl;
+    std::cout << "4: Wlacz/wylacz chmure punktow (drzewo oktalne wczytywane w tle)" << std::endl;
+    std::cout << "5: Wlacz/wygas fontanne czasteczek (okolo miliona czasteczek)" << std::endl;
+    std::cout << "6: Wlacz/wylacz teren (drzewo czworkowe z ciaglym LOD, kafelki wczytywane w tle)" << std::endl;
+    std::cout << "7: Wlacz/wylacz nieskonczona siatke podlogi" << std::endl;
+    std::cout << "8: Wlacz/wylacz swiat wokseli (siatkowanie zachlanne w tle)" << std::endl;
+    std::cout << "9: Wykop kule wokseli przed kamera" << std::endl;
+    std::cout << "0: Wlacz/wylacz izopowierzchnie pola skalarnego ([ i ]: zmien izowartosc)" << std::endl;
+    std::cout << "F1: Dodaj/usun tlum animowanych postaci ze szkieletem" << std::endl;
+    std::cout << "F2: Przelacz skinning postaci (GPU/CPU)" << std::endl;
+    std::cout << "F3: Dodaj/usun tlum 250 000 postaci z animacja wypalona do tekstury" << std::endl;
     std::cout << "Lewy przycisk myszy: Zmien kolor kuli na czerwony" << std::endl;
     std::cout << "Prawy przycisk myszy: Przywroc kolor kuli" << std::endl;
     std::cout << "\n=== OSWIETLENIE ===" << std::endl;
@@ -1403,6 +2180,7 @@ int main() {
 
     // Lambda dla aktualizacji z referencją do silnika
     auto updateWrapper = [&engine]() {
+        frameCpuStart = glfwGetTime();
         update(engine);
     };
 
@@ -1415,6 +2193,28 @@ int main() {
     engine.run(updateWrapper, renderWrapper);
 
     // Sprzątanie
+    renderGraph.release();
+    multiViewRenderer.release();
+    upscaler.release();
+    lightCuller.release();
+    staticBatcher.release();
+    dynamicBatcher.release();
+    impostorRenderer.release();
+    proceduralRenderer.release();
+    rayCastRenderer.release();
+    pointCloudRenderer.release();
+    particleRenderer.release();
+    terrainRenderer.release();
+    gridRenderer.release();
+    voxelRenderer.release();
+    voxelWorld.reset();
+    if (isoMesh.VAO && geometryRenderer) geometryRenderer->deleteMesh(isoMesh);
+    isoVolume.reset();
+    skinnedRenderer.release();
+    crowd.reset();
+    vertexAnimationRenderer.release();
+    bakedCrowd.reset();
+    MaterialTable::instance().release();
     delete sceneManager;
     sceneManager = nullptr;
 